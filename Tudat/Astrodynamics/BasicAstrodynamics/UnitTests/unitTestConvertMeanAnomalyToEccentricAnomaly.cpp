@@ -43,6 +43,7 @@
  *      130123    K. Kumar          Updated test tolerance for near-parabolic cases in Test 5 to
  *                                  deal with conversion failure on some systems.
  *      150417    D. Dirkx          Made modifications for templated element conversions.
+ *      261018                      Added test of conversion partials with dual numbers.
  *
  *    References
  *      GTOP, http://www.esa.int/gsp/ACT/doc/INF/Code/globopt/GTOPtoolbox.rar
@@ -69,6 +70,7 @@
 #include "Tudat/Astrodynamics/BasicAstrodynamics/convertMeanToEccentricAnomalies.h"
 #include "Tudat/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
 #include "Tudat/Astrodynamics/BasicAstrodynamics/unitConversions.h"
+#include "Tudat/Mathematics/BasicMathematics/dualNumber.h"
 #include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
 #include "Tudat/InputOutput/basicInputOutput.h"
 
@@ -466,6 +468,39 @@ BOOST_AUTO_TEST_CASE( test_convertMeanAnomalyToEccentricAnomaly_specificInitialG
                        1.0E-13 );
 }
 
+//! Test 8: Test partials of eccentric anomaly, computed with dual numbers.
+BOOST_AUTO_TEST_CASE( test_convertMeanAnomalyToEccentricAnomaly_dualNumbers )
+{
+    using basic_mathematics::DualNumber;
+
+    // Set test values for eccentricity and mean anomaly.
+    const double testEccentricity = 0.1;
+    const double testMeanAnomaly = 1.0;
+
+    // Compute eccentric anomaly, with eccentricity and mean anomaly as independent variables.
+    const DualNumber< 2 > dualEccentricAnomaly = convertMeanAnomalyToEccentricAnomaly(
+                DualNumber< 2 >( testEccentricity, 0 ), DualNumber< 2 >( testMeanAnomaly, 1 ) );
+    const double eccentricAnomaly = convertMeanAnomalyToEccentricAnomaly(
+                testEccentricity, testMeanAnomaly );
+    BOOST_CHECK_EQUAL( dualEccentricAnomaly.getValue( ), eccentricAnomaly );
+
+    // Compute analytical partials from implicit differentiation of Kepler's equation.
+    const double keplersFunctionDerivative
+            = 1.0 - testEccentricity * std::cos( eccentricAnomaly );
+    const double expectedPartialWrtEccentricity
+            = std::sin( eccentricAnomaly ) / keplersFunctionDerivative;
+    const double expectedPartialWrtMeanAnomaly = 1.0 / keplersFunctionDerivative;
+
+    BOOST_CHECK_CLOSE_FRACTION( dualEccentricAnomaly.getDerivative( 0 ),
+                                expectedPartialWrtEccentricity, 1.0E-13 );
+    BOOST_CHECK_CLOSE_FRACTION( dualEccentricAnomaly.getDerivative( 1 ),
+                                expectedPartialWrtMeanAnomaly, 1.0E-13 );
+
+    // Check against rounded values of partials.
+    BOOST_CHECK_CLOSE_FRACTION( dualEccentricAnomaly.getDerivative( 0 ), 0.929061, 1.0E-6 );
+    BOOST_CHECK_CLOSE_FRACTION( dualEccentricAnomaly.getDerivative( 1 ), 1.04863, 1.0E-5 );
+}
+
 // End Boost test suite.
 BOOST_AUTO_TEST_SUITE_END( )
 
@@ -33,6 +33,7 @@
  *      130123    K. Kumar          Added separated test tolerance for near-parabolic cases in
  *                                  Test 4 to deal with conversion failure on some systems.
  *      150417    D. Dirkx          Made modifications for templated element conversions.
+ *      261018                      Added test of conversion partials with dual numbers.
  *
  *    References
  *      GTOP, http://www.esa.int/gsp/ACT/doc/INF/Code/globopt/GTOPtoolbox.rar.
@@ -58,6 +59,7 @@
 #include "Tudat/Astrodynamics/BasicAstrodynamics/convertMeanToEccentricAnomalies.h"
 #include "Tudat/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
 #include "Tudat/Astrodynamics/BasicAstrodynamics/unitConversions.h"
+#include "Tudat/Mathematics/BasicMathematics/dualNumber.h"
 #include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
 #include "Tudat/InputOutput/basicInputOutput.h"
 
@@ -422,6 +424,38 @@ BOOST_AUTO_TEST_CASE( test_convertMeanAnomalyToHyperbolicEccentricAnomaly_specif
                                 1.0E-14 );
 }
 
+//! Test 6: Test partials of hyperbolic eccentric anomaly, computed with dual numbers.
+BOOST_AUTO_TEST_CASE( test_convertMeanAnomalyToHyperbolicEccentricAnomaly_dualNumbers )
+{
+    using basic_mathematics::DualNumber;
+
+    // Set test values for eccentricity and mean anomaly. (Similar case as in Test 5.)
+    const double testEccentricity = 1.97;
+    const double testHyperbolicMeanAnomaly = 0.5;
+
+    // Compute hyperbolic eccentric anomaly, with eccentricity and mean anomaly as independent
+    // variables.
+    const DualNumber< 2 > dualHyperbolicEccentricAnomaly
+            = convertMeanAnomalyToHyperbolicEccentricAnomaly(
+                DualNumber< 2 >( testEccentricity, 0 ),
+                DualNumber< 2 >( testHyperbolicMeanAnomaly, 1 ) );
+    const double hyperbolicEccentricAnomaly = convertMeanAnomalyToHyperbolicEccentricAnomaly(
+                testEccentricity, testHyperbolicMeanAnomaly );
+    BOOST_CHECK_EQUAL( dualHyperbolicEccentricAnomaly.getValue( ), hyperbolicEccentricAnomaly );
+
+    // Compute analytical partials from implicit differentiation of Kepler's equation.
+    const double keplersFunctionDerivative
+            = testEccentricity * std::cosh( hyperbolicEccentricAnomaly ) - 1.0;
+    const double expectedPartialWrtEccentricity
+            = -std::sinh( hyperbolicEccentricAnomaly ) / keplersFunctionDerivative;
+    const double expectedPartialWrtMeanAnomaly = 1.0 / keplersFunctionDerivative;
+
+    BOOST_CHECK_CLOSE_FRACTION( dualHyperbolicEccentricAnomaly.getDerivative( 0 ),
+                                expectedPartialWrtEccentricity, 1.0E-13 );
+    BOOST_CHECK_CLOSE_FRACTION( dualHyperbolicEccentricAnomaly.getDerivative( 1 ),
+                                expectedPartialWrtMeanAnomaly, 1.0E-13 );
+}
+
 // End Boost test suite.
 BOOST_AUTO_TEST_SUITE_END( )
 
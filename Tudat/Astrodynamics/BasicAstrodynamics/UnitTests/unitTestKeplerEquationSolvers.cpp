@@ -0,0 +1,287 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      Unit test created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Basics/testMacros.h"
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/convertMeanToEccentricAnomalies.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/keplerEquationSolvers.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/keplerPropagator.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/stateVectorIndices.h"
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_kepler_equation_solvers )
+
+//! Test elliptical solver against long double solution and root-finder based conversion.
+BOOST_AUTO_TEST_CASE( testEllipticalKeplerEquationSolver )
+{
+    using namespace orbital_element_conversions;
+    using mathematical_constants::PI;
+
+    boost::mt19937 randomNumberGenerator( 42 );
+    boost::random::uniform_real_distribution< > uniformDistribution( 0.0, 1.0 );
+
+    const int numberOfSamples = 20000;
+    Eigen::ArrayXd eccentricities( numberOfSamples ), meanAnomalies( numberOfSamples );
+    for ( int i = 0; i < numberOfSamples; i++ )
+    {
+        // Sample eccentricities up to near-parabolic, and mean anomalies close to pericenter.
+        eccentricities( i ) = ( i % 3 == 0 )
+                ? 1.0 - std::pow( 10.0, -15.0 * uniformDistribution( randomNumberGenerator ) )
+                : uniformDistribution( randomNumberGenerator );
+        meanAnomalies( i ) = ( i % 5 == 0 )
+                ? 1.0E-3 * ( uniformDistribution( randomNumberGenerator ) - 0.5 )
+                : 2.0 * PI * ( uniformDistribution( randomNumberGenerator ) - 0.5 );
+    }
+
+    // Check that eccentric anomaly is accurate to machine precision, for mean anomalies that
+    // need no reduction (reduction introduces an error in PI, amplified for near-parabolic orbits).
+    const Eigen::ArrayXd batchEccentricAnomalies
+            = solveKeplersEquationForEllipticalOrbitBatch( eccentricities, meanAnomalies );
+    for ( int i = 0; i < numberOfSamples; i++ )
+    {
+        const double eccentricAnomaly = solveKeplersEquationForEllipticalOrbits(
+                    eccentricities( i ), meanAnomalies( i ) );
+        const long double expectedEccentricAnomaly
+                = solveKeplersEquationForEllipticalOrbits< long double >(
+                    eccentricities( i ), meanAnomalies( i ) );
+
+        BOOST_CHECK_SMALL( static_cast< double >( eccentricAnomaly - expectedEccentricAnomaly ),
+                           4.0 * std::numeric_limits< double >::epsilon( )
+                           * std::max( 1.0, std::fabs( eccentricAnomaly ) ) );
+        BOOST_CHECK_SMALL( batchEccentricAnomalies( i ) - eccentricAnomaly,
+                           4.0 * std::numeric_limits< double >::epsilon( )
+                           * std::max( 1.0, std::fabs( eccentricAnomaly ) ) );
+    }
+
+    // Check that long double solution solves Kepler's equation.
+    for ( int i = 0; i < numberOfSamples; i += 10 )
+    {
+        const long double eccentricity = eccentricities( i );
+        const long double eccentricAnomaly
+                = solveKeplersEquationForEllipticalOrbits< long double >(
+                    eccentricity, static_cast< long double >( meanAnomalies( i ) ) );
+        BOOST_CHECK_SMALL( static_cast< double >( eccentricAnomaly
+                                                  - eccentricity * std::sin( eccentricAnomaly )
+                                                  - meanAnomalies( i ) ),
+                           4.0 * static_cast< double >(
+                               std::numeric_limits< long double >::epsilon( ) ) );
+    }
+
+    // Check that eccentric anomaly is in same revolution as mean anomaly, and matches
+    // root-finder based conversion otherwise.
+    for ( int revolution = -3; revolution <= 3; revolution++ )
+    {
+        for ( int i = 1; i < numberOfSamples; i += 3 )
+        {
+            const double meanAnomaly = meanAnomalies( i ) + 2.0 * PI * revolution;
+            const double eccentricAnomaly
+                    = solveKeplersEquationForEllipticalOrbits( eccentricities( i ), meanAnomaly );
+            const double expectedEccentricAnomaly = convertMeanAnomalyToEccentricAnomaly(
+                        eccentricities( i ), meanAnomaly );
+
+            BOOST_CHECK_SMALL( std::sin( eccentricAnomaly - expectedEccentricAnomaly ), 1.0E-12 );
+            BOOST_CHECK_SMALL( eccentricAnomaly - eccentricities( i ) * std::sin( eccentricAnomaly )
+                               - meanAnomaly, 1.0E-13 * std::max( 1.0, std::fabs( meanAnomaly ) ) );
+        }
+    }
+}
+
+//! Test hyperbolic solver against long double solution and root-finder based conversion.
+BOOST_AUTO_TEST_CASE( testHyperbolicKeplerEquationSolver )
+{
+    using namespace orbital_element_conversions;
+
+    boost::mt19937 randomNumberGenerator( 42 );
+    boost::random::uniform_real_distribution< > uniformDistribution( 0.0, 1.0 );
+
+    const int numberOfSamples = 20000;
+    Eigen::ArrayXd eccentricities( numberOfSamples ), meanAnomalies( numberOfSamples );
+    for ( int i = 0; i < numberOfSamples; i++ )
+    {
+        // Sample eccentricities from near-parabolic to 1.0E6, and mean anomalies from 1.0E-2 to
+        // 1.0E6 (either sign).
+        eccentricities( i ) = 1.0 + ( ( i % 3 == 0 )
+                ? std::pow( 10.0, -12.0 * uniformDistribution( randomNumberGenerator ) )
+                : std::pow( 10.0, 6.0 * uniformDistribution( randomNumberGenerator ) ) );
+        meanAnomalies( i ) = ( uniformDistribution( randomNumberGenerator ) - 0.5 ) * 2.0
+                * std::pow( 10.0, 8.0 * uniformDistribution( randomNumberGenerator ) - 2.0 );
+    }
+
+    const Eigen::ArrayXd batchEccentricAnomalies
+            = solveKeplersEquationForHyperbolicOrbitBatch( eccentricities, meanAnomalies );
+    for ( int i = 0; i < numberOfSamples; i++ )
+    {
+        const double hyperbolicEccentricAnomaly = solveKeplersEquationForHyperbolicOrbits(
+                    eccentricities( i ), meanAnomalies( i ) );
+        const long double expectedHyperbolicEccentricAnomaly
+                = solveKeplersEquationForHyperbolicOrbits< long double >(
+                    eccentricities( i ), meanAnomalies( i ) );
+        const double tolerance = 4.0 * std::numeric_limits< double >::epsilon( )
+                * std::max( 1.0, std::fabs( hyperbolicEccentricAnomaly ) );
+
+        BOOST_CHECK_SMALL( static_cast< double >( hyperbolicEccentricAnomaly
+                                                  - expectedHyperbolicEccentricAnomaly ),
+                           tolerance );
+        BOOST_CHECK_SMALL( batchEccentricAnomalies( i ) - hyperbolicEccentricAnomaly, tolerance );
+    }
+
+    // Compare with root-finder based conversion, for orbits that are not near-parabolic.
+    for ( int i = 1; i < numberOfSamples; i += 3 )
+    {
+        BOOST_CHECK_SMALL( solveKeplersEquationForHyperbolicOrbits( eccentricities( i ),
+                                                                    meanAnomalies( i ) )
+                           - convertMeanAnomalyToHyperbolicEccentricAnomaly(
+                               eccentricities( i ), meanAnomalies( i ) ),
+                           1.0E-13 * std::max( 1.0, std::fabs( batchEccentricAnomalies( i ) ) ) );
+    }
+}
+
+//! Test whether invalid input is rejected.
+BOOST_AUTO_TEST_CASE( testKeplerEquationSolverInvalidInput )
+{
+    using namespace orbital_element_conversions;
+
+    bool isExceptionThrown[ 5 ] = { false, false, false, false, false };
+    try
+    {
+        solveKeplersEquationForEllipticalOrbits( 1.0, 0.3 );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown[ 0 ] = true;
+    }
+
+    try
+    {
+        solveKeplersEquationForHyperbolicOrbits( 0.9, 0.3 );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown[ 1 ] = true;
+    }
+
+    try
+    {
+        solveKeplersEquationForEllipticalOrbitBatch( Eigen::ArrayXd::Constant( 3, 0.1 ),
+                                                     Eigen::ArrayXd::Constant( 4, 0.3 ) );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown[ 2 ] = true;
+    }
+
+    try
+    {
+        solveKeplersEquationForEllipticalOrbitBatch( Eigen::ArrayXd::LinSpaced( 3, -0.1, 0.5 ),
+                                                     Eigen::ArrayXd::Constant( 3, 0.3 ) );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown[ 3 ] = true;
+    }
+
+    try
+    {
+        solveKeplersEquationForHyperbolicOrbitBatch( Eigen::ArrayXd::LinSpaced( 3, 0.9, 3.0 ),
+                                                     Eigen::ArrayXd::Constant( 3, 0.3 ) );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown[ 4 ] = true;
+    }
+
+    for ( int i = 0; i < 5; i++ )
+    {
+        BOOST_CHECK( isExceptionThrown[ i ] );
+    }
+}
+
+//! Test batch propagation of Kepler orbits against single-orbit propagation.
+BOOST_AUTO_TEST_CASE( testBatchKeplerPropagation )
+{
+    using namespace orbital_element_conversions;
+
+    const double gravitationalParameter = 3.986004415E14;
+    const double propagationTime = 7.3E4;
+
+    // Set mix of elliptical and hyperbolic orbits.
+    const int numberOfOrbits = 50;
+    Eigen::Matrix< double, 6, Eigen::Dynamic > initialStates( 6, numberOfOrbits );
+    for ( int i = 0; i < numberOfOrbits; i++ )
+    {
+        const double eccentricity = ( i % 2 == 0 ) ? 0.019 * i : 1.0 + 0.1 * i;
+        const double semiMajorAxis = ( eccentricity < 1.0 ) ? 7.0E6 + 4.0E5 * i : -2.0E7;
+        initialStates.col( i ) << semiMajorAxis, eccentricity, 0.01 * i, 0.1 * i, 0.2 * i,
+                ( eccentricity < 1.0 ) ? 0.12 * i - 3.0 : 0.02 * i - 0.5;
+    }
+
+    const Eigen::Matrix< double, 6, Eigen::Dynamic > finalStates
+            = propagateKeplerOrbits( initialStates, propagationTime, gravitationalParameter );
+
+    for ( int i = 0; i < numberOfOrbits; i++ )
+    {
+        const Eigen::Matrix< double, 6, 1 > initialState = initialStates.col( i );
+        const Eigen::Matrix< double, 6, 1 > expectedFinalState = propagateKeplerOrbit(
+                    initialState, propagationTime, gravitationalParameter );
+        const Eigen::Matrix< double, 6, 1 > finalState = finalStates.col( i );
+
+        BOOST_CHECK( finalState.segment( 0, 5 ) == initialState.segment( 0, 5 ) );
+        BOOST_CHECK_SMALL( finalState( trueAnomalyIndex ) - expectedFinalState( trueAnomalyIndex ),
+                           1.0E-13 );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
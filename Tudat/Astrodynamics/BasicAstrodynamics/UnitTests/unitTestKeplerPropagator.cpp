@@ -44,6 +44,7 @@
  *                                  unit test.
  *      121205    P. Musegaas       Updated code to final version of rootfinders.
  *      150417    D. Dirkx          Made modifications for templated element conversions.
+ *      261018                      Added test of propagation partials with dual numbers.
  *
  *    References
  *      Melman, J. Propagate software, J.C.P.Melman@tudelft.nl, 2010.
@@ -73,6 +74,7 @@
 #include "Tudat/Basics/testMacros.h"
 
 #include "Tudat/Mathematics/BasicMathematics/basicMathematicsFunctions.h"
+#include "Tudat/Mathematics/BasicMathematics/dualNumber.h"
 #include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
 #include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
 
@@ -453,5 +455,73 @@ BOOST_AUTO_TEST_CASE( testMeanAnomalyAgainstMeanMotion )
         }
     }
 }
+
+//! Test 7: Partials of propagated true anomaly, computed with dual numbers.
+BOOST_AUTO_TEST_CASE( testPropagateKeplerOrbitPartialsWithDualNumbers )
+{
+    using basic_mathematics::DualNumber;
+    typedef DualNumber< 2 > PropagationDualNumber;
+
+    // Set elliptical (ODTBX) and hyperbolic test orbits around the Earth.
+    const double gravitationalParameter = 398600.4415e9;
+    std::vector< basic_mathematics::Vector6d > initialStatesInKeplerianElements( 2 );
+    initialStatesInKeplerianElements[ 0 ] << 42165.3431351313e3, 0.26248354351331,
+            0.30281462522101, 4.71463172847351, 4.85569272927819, 2.37248926702153;
+    initialStatesInKeplerianElements[ 1 ] << -12000.0e3, 1.5, 0.4, 1.2, 0.7, 0.3;
+    const double propagationTimes[ 2 ] = { 3000.0, 1800.0 };
+
+    for ( unsigned int i = 0; i < initialStatesInKeplerianElements.size( ); i++ )
+    {
+        const basic_mathematics::Vector6d initialState = initialStatesInKeplerianElements[ i ];
+        const double eccentricity = initialState( eccentricityIndex );
+
+        // Propagate with initial true anomaly and propagation time as independent variables.
+        Eigen::Matrix< PropagationDualNumber, 6, 1 > dualInitialState;
+        for ( int j = 0; j < 6; j++ )
+        {
+            dualInitialState( j ) = PropagationDualNumber( initialState( j ) );
+        }
+        dualInitialState( trueAnomalyIndex )
+                = PropagationDualNumber( initialState( trueAnomalyIndex ), 0 );
+        const Eigen::Matrix< PropagationDualNumber, 6, 1 > dualPropagatedState
+                = propagateKeplerOrbit< PropagationDualNumber >(
+                    dualInitialState, PropagationDualNumber( propagationTimes[ i ], 1 ),
+                    PropagationDualNumber( gravitationalParameter ) );
+
+        // Check values against propagation with doubles.
+        const basic_mathematics::Vector6d propagatedState = propagateKeplerOrbit(
+                    initialState, propagationTimes[ i ], gravitationalParameter );
+        BOOST_CHECK( basic_mathematics::getDualNumberValues( dualPropagatedState )
+                     == propagatedState );
+
+        // Compute analytical partials of propagated true anomaly, from conservation of angular
+        // momentum: d(theta)/dt = sqrt( mu / p^3 ) * ( 1 + e cos( theta ) )^2.
+        const double semiLatusRectum = initialState( semiMajorAxisIndex )
+                * ( 1.0 - eccentricity * eccentricity );
+        const double initialRadiusFactor
+                = 1.0 + eccentricity * std::cos( initialState( trueAnomalyIndex ) );
+        const double propagatedRadiusFactor
+                = 1.0 + eccentricity * std::cos( propagatedState( trueAnomalyIndex ) );
+        const double expectedPartialWrtInitialTrueAnomaly
+                = propagatedRadiusFactor * propagatedRadiusFactor
+                / ( initialRadiusFactor * initialRadiusFactor );
+        const double expectedPartialWrtPropagationTime
+                = std::sqrt( gravitationalParameter
+                             / ( semiLatusRectum * semiLatusRectum * semiLatusRectum ) )
+                * propagatedRadiusFactor * propagatedRadiusFactor;
+
+        BOOST_CHECK_CLOSE_FRACTION( dualPropagatedState( trueAnomalyIndex ).getDerivative( 0 ),
+                                    expectedPartialWrtInitialTrueAnomaly, 1.0E-12 );
+        BOOST_CHECK_CLOSE_FRACTION( dualPropagatedState( trueAnomalyIndex ).getDerivative( 1 ),
+                                    expectedPartialWrtPropagationTime, 1.0E-12 );
+
+        // Check that other elements do not depend on independent variables.
+        for ( int j = 0; j < 5; j++ )
+        {
+            BOOST_CHECK( dualPropagatedState( j ).getDerivatives( ).isZero( ) );
+        }
+    }
+}
+
 } // namespace unit_tests
 } // namespace tudat
@@ -68,6 +68,7 @@
  *                                  under Windows. Added check for zero-valued angles in
  *                                  testCartesianToKeplerianElementConversion.
  *      150417    D. Dirkx          Made modifications for templated element conversions.
+ *      261018                      Added tests of element conversion partials with dual numbers.
  *
  *    References
  *      NASA, Goddard Spaceflight Center. Orbit Determination Toolbox (ODTBX), NASA - GSFC Open
@@ -98,6 +99,8 @@
 #include <cmath>
 #include <limits>
 
+#include <boost/bind.hpp>
+#include <boost/function.hpp>
 #include <boost/test/floating_point_comparison.hpp>
 #include <boost/test/unit_test.hpp>
 
@@ -105,7 +108,9 @@
 
 #include "Tudat/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
 #include "Tudat/Basics/testMacros.h"
+#include "Tudat/Mathematics/BasicMathematics/dualNumber.h"
 #include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+#include "Tudat/Mathematics/BasicMathematics/numericalDerivative.h"
 
 namespace tudat
 {
@@ -1621,6 +1626,104 @@ BOOST_AUTO_TEST_CASE( testSemiMajorAxisToMeanMotionConversion )
     }
 }
 
+//! Convert Keplerian to Cartesian elements, with dynamic-size input and output.
+Eigen::VectorXd convertKeplerianToCartesianElementVector( const Eigen::VectorXd& keplerianElements,
+                                                          const double gravitationalParameter )
+{
+    return orbital_element_conversions::convertKeplerianToCartesianElements< double >(
+                keplerianElements, gravitationalParameter );
+}
+
+//! Test if partials of element conversions are correctly computed with dual numbers.
+BOOST_AUTO_TEST_CASE( testElementConversionPartialsWithDualNumbers )
+{
+    using namespace orbital_element_conversions;
+    using basic_mathematics::DualNumber;
+    typedef DualNumber< 6 > ElementDualNumber;
+
+    // Earth gravitational parameter [m^3 s^-2].
+    const double earthGravitationalParameter = 3.986004418e14;
+
+    // Set Keplerian elements of elliptical, inclined orbit.
+    Eigen::Matrix< double, 6, 1 > keplerianElements;
+    keplerianElements << 7.5e6, 0.15, 0.9, 1.1, 5.9, 2.3;
+
+    // Convert Keplerian elements, with partials w.r.t. Keplerian elements, to Cartesian elements.
+    const Eigen::Matrix< ElementDualNumber, 6, 1 > dualCartesianElements
+            = convertKeplerianToCartesianElements< ElementDualNumber >(
+                basic_mathematics::createIndependentDualNumbers( keplerianElements ),
+                earthGravitationalParameter );
+    const Eigen::Matrix< double, 6, 1 > cartesianElements
+            = convertKeplerianToCartesianElements( keplerianElements,
+                                                   earthGravitationalParameter );
+
+    // Check that values are identical to those computed without partials.
+    BOOST_CHECK( basic_mathematics::getDualNumberValues( dualCartesianElements )
+                 == cartesianElements );
+
+    // Check partials against central differences.
+    const Eigen::Matrix< double, 6, 6 > cartesianElementPartials
+            = basic_mathematics::getDualNumberJacobian( dualCartesianElements );
+    const Eigen::MatrixXd numericalCartesianElementPartials
+            = numerical_derivatives::computeCentralDifference(
+                keplerianElements,
+                boost::function< Eigen::VectorXd( const Eigen::VectorXd& ) >(
+                    boost::bind( &convertKeplerianToCartesianElementVector, _1,
+                                 earthGravitationalParameter ) ),
+                0.0, 0.0, numerical_derivatives::order8 );
+
+    for ( int i = 0; i < 6; i++ )
+    {
+        for ( int j = 0; j < 6; j++ )
+        {
+            BOOST_CHECK_SMALL( cartesianElementPartials( i, j )
+                               - numericalCartesianElementPartials( i, j ),
+                               1.0E-8 * numericalCartesianElementPartials.row( i ).norm( ) );
+        }
+    }
+
+    // Convert Cartesian elements, with partials w.r.t. Cartesian elements, to Keplerian elements.
+    const Eigen::Matrix< ElementDualNumber, 6, 1 > dualKeplerianElements
+            = convertCartesianToKeplerianElements< ElementDualNumber >(
+                basic_mathematics::createIndependentDualNumbers( cartesianElements ),
+                earthGravitationalParameter );
+    BOOST_CHECK( basic_mathematics::getDualNumberValues( dualKeplerianElements )
+                 == convertCartesianToKeplerianElements( cartesianElements,
+                                                         earthGravitationalParameter ) );
+
+    // Check that partials of both conversions are each other's inverse.
+    const Eigen::Matrix< double, 6, 6 > keplerianElementPartials
+            = basic_mathematics::getDualNumberJacobian( dualKeplerianElements );
+    const Eigen::Matrix< double, 6, 6 > partialsProduct
+            = keplerianElementPartials * cartesianElementPartials;
+    const Eigen::Matrix< double, 6, 6 > identityMatrix = Eigen::Matrix< double, 6, 6 >::Identity( );
+    TUDAT_CHECK_MATRIX_BASE( partialsProduct, identityMatrix )
+            BOOST_CHECK_SMALL( partialsProduct( row, col ) - identityMatrix( row, col ),
+                               1.0E-13 * keplerianElementPartials.row( row ).norm( )
+                               * cartesianElementPartials.col( col ).norm( ) );
+
+    // Check partials of anomaly conversions against analytical derivative of mean anomaly w.r.t.
+    // eccentric anomaly and eccentricity.
+    const double eccentricAnomaly = 2.1;
+    const double eccentricity = keplerianElements( eccentricityIndex );
+    const ElementDualNumber dualMeanAnomaly = convertEccentricAnomalyToMeanAnomaly(
+                ElementDualNumber( eccentricAnomaly, 0 ), ElementDualNumber( eccentricity, 1 ) );
+    BOOST_CHECK_CLOSE_FRACTION( dualMeanAnomaly.getDerivative( 0 ),
+                                1.0 - eccentricity * std::cos( eccentricAnomaly ),
+                                std::numeric_limits< double >::epsilon( ) );
+    BOOST_CHECK_CLOSE_FRACTION( dualMeanAnomaly.getDerivative( 1 ),
+                                -std::sin( eccentricAnomaly ),
+                                std::numeric_limits< double >::epsilon( ) );
+
+    // Check that chain of anomaly conversions gives unit partial w.r.t. input anomaly.
+    const ElementDualNumber dualTrueAnomaly = convertEccentricAnomalyToTrueAnomaly(
+                ElementDualNumber( eccentricAnomaly, 0 ), ElementDualNumber( eccentricity, 1 ) );
+    const ElementDualNumber recomputedEccentricAnomaly = convertTrueAnomalyToEccentricAnomaly(
+                dualTrueAnomaly, ElementDualNumber( eccentricity, 1 ) );
+    BOOST_CHECK_CLOSE_FRACTION( recomputedEccentricAnomaly.getDerivative( 0 ), 1.0, 1.0E-14 );
+    BOOST_CHECK_SMALL( recomputedEccentricAnomaly.getDerivative( 1 ), 1.0E-14 );
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
@@ -41,6 +41,7 @@
  *      130123    K. Kumar          Added note about near-parabolic cases.
  *      140110    E. Brandon        Fixed Doxygen comments.
  *      150417    D. Dirkx          Made modifications for templated element conversions.
+ *      261018                      Made functions usable with dual numbers.
  *
  *    References
  *      Regarding method in general:
@@ -105,7 +106,9 @@ ScalarType computeKeplersFunctionForEllipticalOrbits( const ScalarType eccentric
                                                       const ScalarType eccentricity,
                                                       const ScalarType meanAnomaly )
 {
-    return eccentricAnomaly - eccentricity * std::sin( eccentricAnomaly ) - meanAnomaly;
+    using std::sin;
+
+    return eccentricAnomaly - eccentricity * sin( eccentricAnomaly ) - meanAnomaly;
 }
 
 //! Compute first-derivative of Kepler's function for elliptical orbits.
@@ -125,8 +128,10 @@ ScalarType computeFirstDerivativeKeplersFunctionForEllipticalOrbits(
         const ScalarType eccentricAnomaly,
         const ScalarType eccentricity )
 {
+    using std::cos;
+
     return mathematical_constants::getFloatingInteger< ScalarType >( 1 )-
-            eccentricity * std::cos( eccentricAnomaly );
+            eccentricity * cos( eccentricAnomaly );
 }
 
 //! Compute Kepler's function for hyperbolic orbits.
@@ -147,7 +152,9 @@ ScalarType computeKeplersFunctionForHyperbolicOrbits( const ScalarType hyperboli
                                                       const ScalarType eccentricity,
                                                       const ScalarType hyperbolicMeanAnomaly )
 {
-    return eccentricity * std::sinh( hyperbolicEccentricAnomaly )
+    using std::sinh;
+
+    return eccentricity * sinh( hyperbolicEccentricAnomaly )
             - hyperbolicEccentricAnomaly - hyperbolicMeanAnomaly;
 }
 
@@ -168,7 +175,9 @@ ScalarType computeFirstDerivativeKeplersFunctionForHyperbolicOrbits(
         const ScalarType hyperbolicEccentricAnomaly,
         const ScalarType eccentricity)
 {
-    return eccentricity * std::cosh( hyperbolicEccentricAnomaly ) - 1.0;
+    using std::cosh;
+
+    return eccentricity * cosh( hyperbolicEccentricAnomaly ) - 1.0;
 }
 
 //! Convert mean anomaly to eccentric anomaly.
@@ -198,6 +207,7 @@ ScalarType convertMeanAnomalyToEccentricAnomaly(
         boost::shared_ptr< root_finders::RootFinderCore< ScalarType > > aRootFinder =
         boost::shared_ptr< root_finders::RootFinderCore< ScalarType > >( ) )
 {
+    using std::fabs;
     using namespace mathematical_constants;
     using namespace root_finders;
     using namespace root_finders::termination_conditions;
@@ -215,7 +225,7 @@ ScalarType convertMeanAnomalyToEccentricAnomaly(
         ScalarType tolerance = 200.0 * std::numeric_limits< ScalarType >::epsilon( );
 
         // Loosen tolerance for near-parabolic orbits
-        if( std::fabs( eccentricity - getFloatingInteger< ScalarType >( 1 ) ) <
+        if( fabs( eccentricity - getFloatingInteger< ScalarType >( 1 ) ) <
                 1.0E5 * std::numeric_limits< ScalarType >::epsilon( ) )
         {
             tolerance *= 2.5;
@@ -319,6 +329,11 @@ ScalarType convertMeanAnomalyToHyperbolicEccentricAnomaly(
         boost::shared_ptr< root_finders::RootFinderCore< ScalarType > > aRootFinder =
         boost::shared_ptr< root_finders::RootFinderCore< ScalarType > >( ) )
 {
+    using boost::math::asinh;
+    using std::abs;
+    using std::log;
+    using std::sinh;
+    using std::sqrt;
     using namespace mathematical_constants;
     using namespace root_finders;
     using namespace root_finders::termination_conditions;
@@ -369,32 +384,32 @@ ScalarType convertMeanAnomalyToHyperbolicEccentricAnomaly(
         // functionality of this one. [Musegaas,2012]
         if ( useDefaultInitialGuess )
         {
-            if ( std::abs( hyperbolicMeanAnomaly ) <
+            if ( abs( hyperbolicMeanAnomaly ) <
                  getFloatingInteger< ScalarType >( 6 ) * eccentricity )
             {
                 initialGuess =
-                        std::sqrt( getFloatingInteger< ScalarType >( 8 ) *
-                                   ( eccentricity - getFloatingInteger< ScalarType >( 1 ) ) /
-                                   eccentricity ) *
-                        std::sinh( getFloatingFraction< ScalarType >( 1, 3 ) * boost::math::asinh(
-                                       getFloatingInteger< ScalarType >( 3 ) *
-                                       hyperbolicMeanAnomaly /
-                                       ( std::sqrt( getFloatingInteger< ScalarType >( 8 ) *
-                                                    ( eccentricity -
-                                                      getFloatingInteger< ScalarType >( 1 ) ) /
-                                                    eccentricity ) *
-                                         ( eccentricity - getFloatingInteger< ScalarType >( 1 )
-                                           ) ) ) );
+                        sqrt( getFloatingInteger< ScalarType >( 8 ) *
+                              ( eccentricity - getFloatingInteger< ScalarType >( 1 ) ) /
+                              eccentricity ) *
+                        sinh( getFloatingFraction< ScalarType >( 1, 3 ) * asinh(
+                                  getFloatingInteger< ScalarType >( 3 ) *
+                                  hyperbolicMeanAnomaly /
+                                  ( sqrt( getFloatingInteger< ScalarType >( 8 ) *
+                                          ( eccentricity -
+                                            getFloatingInteger< ScalarType >( 1 ) ) /
+                                          eccentricity ) *
+                                    ( eccentricity - getFloatingInteger< ScalarType >( 1 )
+                                      ) ) ) );
             }
             else if ( hyperbolicMeanAnomaly > getFloatingInteger< ScalarType >( 6 ) * eccentricity )
             {
-                initialGuess = ( std::log( getFloatingInteger< ScalarType >( 2 ) *
-                                           hyperbolicMeanAnomaly / eccentricity ) );
+                initialGuess = ( log( getFloatingInteger< ScalarType >( 2 ) *
+                                      hyperbolicMeanAnomaly / eccentricity ) );
             }
             else
             {
-                initialGuess = ( - std::log( -getFloatingInteger< ScalarType >( 2 ) *
-                                             hyperbolicMeanAnomaly / eccentricity ) );
+                initialGuess = ( - log( -getFloatingInteger< ScalarType >( 2 ) *
+                                        hyperbolicMeanAnomaly / eccentricity ) );
             }
         }
         else
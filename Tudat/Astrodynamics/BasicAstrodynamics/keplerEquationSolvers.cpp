@@ -0,0 +1,240 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Only correct unconverged anomalies in hyperbolic batch solver.
+ *
+ *    References
+ *      Markley, F.L. Kepler equation solver, Celestial Mechanics and Dynamical Astronomy, 63,
+ *          101-111, 1995.
+ *      Musegaas, P., Optimization of Space Trajectories Including Multiple Gravity Assists and
+ *          Deep Space Maneuvers, MSc thesis report, Delft University of Technology, 2012.
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/keplerEquationSolvers.h"
+
+namespace tudat
+{
+
+namespace orbital_element_conversions
+{
+
+//! Check sizes of batch of eccentricities and mean anomalies.
+void checkKeplerEquationBatchSizes( const Eigen::ArrayXd& eccentricities,
+                                    const Eigen::ArrayXd& meanAnomalies )
+{
+    if ( eccentricities.rows( ) != meanAnomalies.rows( ) )
+    {
+        std::stringstream errorMessage;
+        errorMessage << "Error, number of eccentricities (" << eccentricities.rows( )
+                     << ") does not match number of mean anomalies (" << meanAnomalies.rows( )
+                     << ")." << std::endl;
+        boost::throw_exception( boost::enable_error_info( std::runtime_error(
+                                                              errorMessage.str( ) ) ) );
+    }
+}
+
+//! Solve Kepler's equation for a batch of elliptical orbits.
+Eigen::ArrayXd solveKeplersEquationForEllipticalOrbitBatch( const Eigen::ArrayXd& eccentricities,
+                                                           const Eigen::ArrayXd& meanAnomalies )
+{
+    using mathematical_constants::PI;
+
+    checkKeplerEquationBatchSizes( eccentricities, meanAnomalies );
+    if ( !( ( eccentricities >= 0.0 ).all( ) && ( eccentricities < 1.0 ).all( ) ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Invalid eccentricity. Valid range is "
+                                            "0.0 <= e < 1.0." ) ) );
+    }
+
+    // Reduce mean anomalies to -PI to PI spectrum.
+    const Eigen::ArrayXd revolutionAngles
+            = 2.0 * PI * ( ( meanAnomalies + PI ) / ( 2.0 * PI ) ).floor( );
+    const Eigen::ArrayXd reducedMeanAnomalies = meanAnomalies - revolutionAngles;
+
+    // Compute starters from cubic equation (Markley, 1995).
+    const Eigen::ArrayXd oneMinusEccentricities = 1.0 - eccentricities;
+    const Eigen::ArrayXd alpha
+            = ( 3.0 * PI * PI + 1.6 * PI * ( PI - reducedMeanAnomalies.abs( ) )
+                / ( 1.0 + eccentricities ) ) / ( PI * PI - 6.0 );
+    const Eigen::ArrayXd d = 3.0 * oneMinusEccentricities + alpha * eccentricities;
+    const Eigen::ArrayXd q = 2.0 * alpha * d * oneMinusEccentricities
+            - reducedMeanAnomalies.square( );
+    const Eigen::ArrayXd r = 3.0 * alpha * d * ( d - oneMinusEccentricities )
+            * reducedMeanAnomalies + reducedMeanAnomalies.cube( );
+    const Eigen::ArrayXd w = ( r.abs( ) + ( q.cube( ) + r.square( ) ).sqrt( ) ).pow( 2.0 / 3.0 );
+    Eigen::ArrayXd eccentricAnomalies
+            = ( 2.0 * r * w / ( w.square( ) + w * q + q.square( ) ) + reducedMeanAnomalies ) / d;
+
+    // Compute E - sin( E ), using series expansion for small eccentric anomalies.
+    const Eigen::ArrayXd eccentricAnomaliesSquared = eccentricAnomalies.square( );
+    const double seriesDenominators[ 10 ]
+            = { 20.0, 42.0, 72.0, 110.0, 156.0, 210.0, 272.0, 342.0, 420.0, 506.0 };
+    Eigen::ArrayXd series = Eigen::ArrayXd::Ones( eccentricAnomalies.rows( ) );
+    for ( int i = 9; i >= 0; i-- )
+    {
+        series = 1.0 - eccentricAnomaliesSquared / seriesDenominators[ i ] * series;
+    }
+    const Eigen::ArrayXd sinesOfEccentricAnomalies = eccentricAnomalies.sin( );
+    const Eigen::ArrayXd eccentricAnomaliesMinusSines = ( eccentricAnomalies.abs( ) < 1.0 ).select(
+                eccentricAnomaliesSquared * eccentricAnomalies / 6.0 * series,
+                eccentricAnomalies - sinesOfEccentricAnomalies );
+
+    // Apply fifth-order correction.
+    const Eigen::ArrayXd keplersFunctions = oneMinusEccentricities * eccentricAnomalies
+            + eccentricities * eccentricAnomaliesMinusSines - reducedMeanAnomalies;
+    const Eigen::ArrayXd secondDerivatives = eccentricities * sinesOfEccentricAnomalies;
+    const Eigen::ArrayXd thirdDerivatives = eccentricities * eccentricAnomalies.cos( );
+    const Eigen::ArrayXd firstDerivatives = 1.0 - thirdDerivatives;
+
+    const Eigen::ArrayXd thirdOrderCorrections = -keplersFunctions
+            / ( firstDerivatives - keplersFunctions * secondDerivatives
+                / ( 2.0 * firstDerivatives ) );
+    const Eigen::ArrayXd fourthOrderCorrections = -keplersFunctions
+            / ( firstDerivatives + thirdOrderCorrections * secondDerivatives / 2.0
+                + thirdOrderCorrections.square( ) * thirdDerivatives / 6.0 );
+    eccentricAnomalies -= keplersFunctions
+            / ( firstDerivatives + fourthOrderCorrections * secondDerivatives / 2.0
+                + fourthOrderCorrections.square( ) * thirdDerivatives / 6.0
+                - fourthOrderCorrections.cube( ) * secondDerivatives / 24.0 );
+
+    return eccentricAnomalies + revolutionAngles;
+}
+
+//! Solve Kepler's equation for a batch of hyperbolic orbits.
+Eigen::ArrayXd solveKeplersEquationForHyperbolicOrbitBatch(
+        const Eigen::ArrayXd& eccentricities, const Eigen::ArrayXd& hyperbolicMeanAnomalies,
+        const int maximumNumberOfIterations )
+{
+    checkKeplerEquationBatchSizes( eccentricities, hyperbolicMeanAnomalies );
+    if ( !( eccentricities > 1.0 ).all( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Invalid eccentricity. Valid range is e > 1.0." ) ) );
+    }
+
+    // Compute starters (Musegaas, 2012).
+    const Eigen::ArrayXd eccentricitiesMinusOne = eccentricities - 1.0;
+    const Eigen::ArrayXd scaleFactors = ( 8.0 * eccentricitiesMinusOne / eccentricities ).sqrt( );
+    Eigen::ArrayXd hyperbolicEccentricAnomalies
+            = ( hyperbolicMeanAnomalies.abs( ) < 6.0 * eccentricities ).select(
+                scaleFactors * ( ( 3.0 * hyperbolicMeanAnomalies
+                                   / ( scaleFactors * eccentricitiesMinusOne ) ).asinh( )
+                                 / 3.0 ).sinh( ),
+                hyperbolicMeanAnomalies.sign( )
+                * ( 2.0 * hyperbolicMeanAnomalies.abs( ) / eccentricities ).log( ) );
+
+    // Apply Halley corrections to the anomalies that have not yet converged. The active
+    // anomalies are gathered in the leading entries of the work arrays, such that converged
+    // anomalies are no longer evaluated.
+    const double seriesDenominators[ 10 ]
+            = { 20.0, 42.0, 72.0, 110.0, 156.0, 210.0, 272.0, 342.0, 420.0, 506.0 };
+    const double tolerance = 10.0 * std::numeric_limits< double >::epsilon( );
+
+    const int batchSize = hyperbolicEccentricAnomalies.rows( );
+    Eigen::ArrayXi activeIndices = Eigen::ArrayXi::LinSpaced( batchSize, 0, batchSize - 1 );
+    Eigen::ArrayXd activeAnomalies( batchSize ), activeEccentricities( batchSize ),
+            activeMeanAnomalies( batchSize );
+    int numberOfActiveAnomalies = batchSize;
+
+    for ( int iteration = 0; iteration < maximumNumberOfIterations; iteration++ )
+    {
+        if ( numberOfActiveAnomalies == 0 )
+        {
+            return hyperbolicEccentricAnomalies;
+        }
+
+        // Gather active anomalies.
+        for ( int i = 0; i < numberOfActiveAnomalies; i++ )
+        {
+            activeAnomalies( i ) = hyperbolicEccentricAnomalies( activeIndices( i ) );
+            activeEccentricities( i ) = eccentricities( activeIndices( i ) );
+            activeMeanAnomalies( i ) = hyperbolicMeanAnomalies( activeIndices( i ) );
+        }
+        const Eigen::ArrayXd anomalies = activeAnomalies.head( numberOfActiveAnomalies );
+        const Eigen::ArrayXd orbitEccentricities
+                = activeEccentricities.head( numberOfActiveAnomalies );
+
+        // Compute sinh( F ) - F, using series expansion for small anomalies.
+        const Eigen::ArrayXd anomaliesSquared = anomalies.square( );
+        Eigen::ArrayXd series = Eigen::ArrayXd::Ones( numberOfActiveAnomalies );
+        for ( int i = 9; i >= 0; i-- )
+        {
+            series = 1.0 + anomaliesSquared / seriesDenominators[ i ] * series;
+        }
+        const Eigen::ArrayXd hyperbolicSines = anomalies.sinh( );
+        const Eigen::ArrayXd hyperbolicSinesMinusAnomalies = ( anomalies.abs( ) < 1.0 ).select(
+                    anomaliesSquared * anomalies / 6.0 * series, hyperbolicSines - anomalies );
+
+        const Eigen::ArrayXd keplersFunctions = ( orbitEccentricities - 1.0 ) * anomalies
+                + orbitEccentricities * hyperbolicSinesMinusAnomalies
+                - activeMeanAnomalies.head( numberOfActiveAnomalies );
+        const Eigen::ArrayXd firstDerivatives = orbitEccentricities * anomalies.cosh( ) - 1.0;
+        const Eigen::ArrayXd secondDerivatives = orbitEccentricities * hyperbolicSines;
+
+        const Eigen::ArrayXd corrections = -keplersFunctions
+                / ( firstDerivatives - keplersFunctions * secondDerivatives
+                    / ( 2.0 * firstDerivatives ) );
+
+        // Scatter corrected anomalies, and keep only those that have not converged active.
+        int numberOfUnconvergedAnomalies = 0;
+        for ( int i = 0; i < numberOfActiveAnomalies; i++ )
+        {
+            const double correctedAnomaly = anomalies( i ) + corrections( i );
+            hyperbolicEccentricAnomalies( activeIndices( i ) ) = correctedAnomaly;
+            if ( !( std::fabs( corrections( i ) )
+                    <= tolerance * std::max( 1.0, std::fabs( correctedAnomaly ) ) ) )
+            {
+                activeIndices( numberOfUnconvergedAnomalies ) = activeIndices( i );
+                numberOfUnconvergedAnomalies++;
+            }
+        }
+        numberOfActiveAnomalies = numberOfUnconvergedAnomalies;
+    }
+
+    if ( numberOfActiveAnomalies == 0 )
+    {
+        return hyperbolicEccentricAnomalies;
+    }
+
+    boost::throw_exception(
+                boost::enable_error_info(
+                    std::runtime_error( "Hyperbolic Kepler equation solver did not converge." ) ) );
+}
+
+} // namespace orbital_element_conversions
+
+} // namespace tudat
@@ -0,0 +1,359 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Made functions usable with dual numbers.
+ *      261018                      Only correct unconverged anomalies in hyperbolic batch solver.
+ *
+ *    References
+ *      Markley, F.L. Kepler equation solver, Celestial Mechanics and Dynamical Astronomy, 63,
+ *          101-111, 1995.
+ *      Odell, A.W., Gooding, R.H. Procedures for solving Kepler's equation, Celestial Mechanics,
+ *          38, 307-334, 1986.
+ *      Musegaas, P., Optimization of Space Trajectories Including Multiple Gravity Assists and
+ *          Deep Space Maneuvers, MSc thesis report, Delft University of Technology, 2012.
+ *
+ *    Notes
+ *      The solvers in this file are intended for cases where Kepler's equation has to be solved
+ *      many times, e.g., when propagating a large catalog of objects. Contrary to
+ *      convertMeanAnomalyToEccentricAnomaly() and
+ *      convertMeanAnomalyToHyperbolicEccentricAnomaly(), they do not allocate any memory and do
+ *      not use the (generic) root-finders, but they cannot be customized with a user-specified
+ *      root-finder or initial guess.
+ *
+ */
+
+#ifndef TUDAT_KEPLER_EQUATION_SOLVERS_H
+#define TUDAT_KEPLER_EQUATION_SOLVERS_H
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+#include <boost/math/special_functions/asinh.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+
+namespace orbital_element_conversions
+{
+
+//! Compute difference between eccentric anomaly and its sine.
+/*!
+ * Computes \f$ E - sin( E ) \f$ without cancellation for small eccentric anomalies, for which a
+ * series expansion is used (Odell & Gooding, 1986). This term dominates Kepler's function for
+ * near-parabolic orbits close to pericenter.
+ * \param eccentricAnomaly Eccentric anomaly [rad].
+ * \return Eccentric anomaly minus its sine [rad].
+ */
+template< typename ScalarType = double >
+ScalarType computeEccentricAnomalyMinusSine( const ScalarType eccentricAnomaly )
+{
+    using std::fabs;
+    using std::sin;
+
+    if ( fabs( eccentricAnomaly )
+         >= mathematical_constants::getFloatingInteger< ScalarType >( 1 ) )
+    {
+        return eccentricAnomaly - sin( eccentricAnomaly );
+    }
+
+    // Evaluate E^3/3! - E^5/5! + ... in nested form, up to E^23/23!.
+    const int seriesDenominators[ 10 ] = { 20, 42, 72, 110, 156, 210, 272, 342, 420, 506 };
+    const ScalarType eccentricAnomalySquared = eccentricAnomaly * eccentricAnomaly;
+    ScalarType series = mathematical_constants::getFloatingInteger< ScalarType >( 1 );
+    for ( int i = 9; i >= 0; i-- )
+    {
+        series = mathematical_constants::getFloatingInteger< ScalarType >( 1 )
+                - eccentricAnomalySquared / static_cast< ScalarType >( seriesDenominators[ i ] )
+                * series;
+    }
+
+    return eccentricAnomalySquared * eccentricAnomaly
+            / mathematical_constants::getFloatingInteger< ScalarType >( 6 ) * series;
+}
+
+//! Compute difference between hyperbolic sine of hyperbolic eccentric anomaly and the anomaly.
+/*!
+ * Computes \f$ sinh( F ) - F \f$ without cancellation for small hyperbolic eccentric anomalies,
+ * for which a series expansion is used. This term dominates Kepler's function for
+ * near-parabolic orbits close to pericenter.
+ * \param hyperbolicEccentricAnomaly Hyperbolic eccentric anomaly [rad].
+ * \return Hyperbolic sine of hyperbolic eccentric anomaly minus the anomaly [rad].
+ */
+template< typename ScalarType = double >
+ScalarType computeHyperbolicSineMinusAnomaly( const ScalarType hyperbolicEccentricAnomaly )
+{
+    using std::fabs;
+    using std::sinh;
+
+    if ( fabs( hyperbolicEccentricAnomaly )
+         >= mathematical_constants::getFloatingInteger< ScalarType >( 1 ) )
+    {
+        return sinh( hyperbolicEccentricAnomaly ) - hyperbolicEccentricAnomaly;
+    }
+
+    // Evaluate F^3/3! + F^5/5! + ... in nested form, up to F^23/23!.
+    const int seriesDenominators[ 10 ] = { 20, 42, 72, 110, 156, 210, 272, 342, 420, 506 };
+    const ScalarType anomalySquared = hyperbolicEccentricAnomaly * hyperbolicEccentricAnomaly;
+    ScalarType series = mathematical_constants::getFloatingInteger< ScalarType >( 1 );
+    for ( int i = 9; i >= 0; i-- )
+    {
+        series = mathematical_constants::getFloatingInteger< ScalarType >( 1 )
+                + anomalySquared / static_cast< ScalarType >( seriesDenominators[ i ] ) * series;
+    }
+
+    return anomalySquared * hyperbolicEccentricAnomaly
+            / mathematical_constants::getFloatingInteger< ScalarType >( 6 ) * series;
+}
+
+//! Solve Kepler's equation for elliptical orbits.
+/*!
+ * Solves Kepler's equation \f$ M = E - e sin( E ) \f$ for the eccentric anomaly, for all
+ * eccentricities >= 0.0 and < 1.0, using the method of (Markley, 1995): a starter that is
+ * accurate to about 1.0e-4 rad (obtained from a cubic equation), followed by a single
+ * fifth-order correction. For types with a higher precision than double, a second correction is
+ * applied. No iteration, root-finder or memory allocation is required. Contrary to
+ * convertMeanAnomalyToEccentricAnomaly(), the returned eccentric anomaly is in the same
+ * revolution as the mean anomaly, i.e., the mean anomaly is not reduced to the 0 to 2.0*PI
+ * spectrum.
+ * \param eccentricity Eccentricity of the orbit [-].
+ * \param meanAnomaly Mean anomaly [rad].
+ * \return Eccentric anomaly [rad].
+ */
+template< typename ScalarType = double >
+ScalarType solveKeplersEquationForEllipticalOrbits( const ScalarType eccentricity,
+                                                    const ScalarType meanAnomaly )
+{
+    using std::cos;
+    using std::fabs;
+    using std::floor;
+    using std::pow;
+    using std::sin;
+    using std::sqrt;
+    using mathematical_constants::getFloatingInteger;
+
+    if ( !( eccentricity >= getFloatingInteger< ScalarType >( 0 )
+            && eccentricity < getFloatingInteger< ScalarType >( 1 ) ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Invalid eccentricity. Valid range is "
+                                            "0.0 <= e < 1.0." ) ) );
+    }
+
+    // Reduce mean anomaly to -PI to PI spectrum.
+    const ScalarType pi = mathematical_constants::getPi< ScalarType >( );
+    const ScalarType revolutionAngle = getFloatingInteger< ScalarType >( 2 ) * pi
+            * floor( ( meanAnomaly + pi ) / ( getFloatingInteger< ScalarType >( 2 ) * pi ) );
+    const ScalarType reducedMeanAnomaly = meanAnomaly - revolutionAngle;
+
+    // Compute starter from cubic equation (Markley, 1995).
+    const ScalarType oneMinusEccentricity = getFloatingInteger< ScalarType >( 1 ) - eccentricity;
+    const ScalarType alpha = ( getFloatingInteger< ScalarType >( 3 ) * pi * pi
+                               + static_cast< ScalarType >( 1.6 ) * pi
+                               * ( pi - fabs( reducedMeanAnomaly ) )
+                               / ( getFloatingInteger< ScalarType >( 1 ) + eccentricity ) )
+            / ( pi * pi - getFloatingInteger< ScalarType >( 6 ) );
+    const ScalarType d = getFloatingInteger< ScalarType >( 3 ) * oneMinusEccentricity
+            + alpha * eccentricity;
+    const ScalarType q = getFloatingInteger< ScalarType >( 2 ) * alpha * d * oneMinusEccentricity
+            - reducedMeanAnomaly * reducedMeanAnomaly;
+    const ScalarType r = getFloatingInteger< ScalarType >( 3 ) * alpha * d
+            * ( d - oneMinusEccentricity ) * reducedMeanAnomaly
+            + reducedMeanAnomaly * reducedMeanAnomaly * reducedMeanAnomaly;
+    const ScalarType w = pow( fabs( r ) + sqrt( q * q * q + r * r ),
+                              mathematical_constants::getFloatingFraction< ScalarType >(
+                                  2, 3 ) );
+    ScalarType eccentricAnomaly
+            = ( getFloatingInteger< ScalarType >( 2 ) * r * w / ( w * w + w * q + q * q )
+                + reducedMeanAnomaly ) / d;
+
+    // Apply fifth-order correction(s).
+    const int numberOfCorrections = ( std::numeric_limits< ScalarType >::digits > 53 ) ? 2 : 1;
+    for ( int i = 0; i < numberOfCorrections; i++ )
+    {
+        const ScalarType keplersFunction = oneMinusEccentricity * eccentricAnomaly
+                + eccentricity * computeEccentricAnomalyMinusSine( eccentricAnomaly )
+                - reducedMeanAnomaly;
+        const ScalarType secondDerivative = eccentricity * sin( eccentricAnomaly );
+        const ScalarType thirdDerivative = eccentricity * cos( eccentricAnomaly );
+        const ScalarType firstDerivative = getFloatingInteger< ScalarType >( 1 )
+                - thirdDerivative;
+
+        const ScalarType thirdOrderCorrection = -keplersFunction
+                / ( firstDerivative - keplersFunction * secondDerivative
+                    / ( getFloatingInteger< ScalarType >( 2 ) * firstDerivative ) );
+        const ScalarType fourthOrderCorrection = -keplersFunction
+                / ( firstDerivative
+                    + thirdOrderCorrection * secondDerivative
+                    / getFloatingInteger< ScalarType >( 2 )
+                    + thirdOrderCorrection * thirdOrderCorrection * thirdDerivative
+                    / getFloatingInteger< ScalarType >( 6 ) );
+        const ScalarType fifthOrderCorrection = -keplersFunction
+                / ( firstDerivative
+                    + fourthOrderCorrection * secondDerivative
+                    / getFloatingInteger< ScalarType >( 2 )
+                    + fourthOrderCorrection * fourthOrderCorrection * thirdDerivative
+                    / getFloatingInteger< ScalarType >( 6 )
+                    - fourthOrderCorrection * fourthOrderCorrection * fourthOrderCorrection
+                    * secondDerivative / getFloatingInteger< ScalarType >( 24 ) );
+
+        eccentricAnomaly += fifthOrderCorrection;
+    }
+
+    return eccentricAnomaly + revolutionAngle;
+}
+
+//! Solve Kepler's equation for hyperbolic orbits.
+/*!
+ * Solves Kepler's equation \f$ M = e sinh( F ) - F \f$ for the hyperbolic eccentric anomaly, for
+ * all eccentricities > 1.0. The starter of (Musegaas, 2012) is refined with Halley corrections
+ * until the correction is below ten times the resolution of ScalarType (relative to the
+ * anomaly, for anomalies larger than one). No root-finder or memory allocation is required.
+ * \param eccentricity Eccentricity of the orbit [-].
+ * \param hyperbolicMeanAnomaly Hyperbolic mean anomaly [rad].
+ * \param maximumNumberOfIterations Maximum number of Halley corrections (default = 50).
+ * \return Hyperbolic eccentric anomaly [rad].
+ */
+template< typename ScalarType = double >
+ScalarType solveKeplersEquationForHyperbolicOrbits( const ScalarType eccentricity,
+                                                    const ScalarType hyperbolicMeanAnomaly,
+                                                    const int maximumNumberOfIterations = 50 )
+{
+    using boost::math::asinh;
+    using std::cosh;
+    using std::fabs;
+    using std::log;
+    using std::sinh;
+    using std::sqrt;
+    using mathematical_constants::getFloatingInteger;
+
+    if ( !( eccentricity > getFloatingInteger< ScalarType >( 1 ) ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Invalid eccentricity. Valid range is e > 1.0." ) ) );
+    }
+
+    // Compute starter (Musegaas, 2012).
+    const ScalarType eccentricityMinusOne = eccentricity - getFloatingInteger< ScalarType >( 1 );
+    ScalarType hyperbolicEccentricAnomaly;
+    if ( fabs( hyperbolicMeanAnomaly ) < getFloatingInteger< ScalarType >( 6 ) * eccentricity )
+    {
+        const ScalarType scaleFactor = sqrt( getFloatingInteger< ScalarType >( 8 )
+                                             * eccentricityMinusOne / eccentricity );
+        hyperbolicEccentricAnomaly = scaleFactor * sinh(
+                    asinh( getFloatingInteger< ScalarType >( 3 )
+                           * hyperbolicMeanAnomaly
+                           / ( scaleFactor * eccentricityMinusOne ) )
+                    / getFloatingInteger< ScalarType >( 3 ) );
+    }
+    else
+    {
+        hyperbolicEccentricAnomaly = ( hyperbolicMeanAnomaly > 0 ? 1 : -1 )
+                * log( getFloatingInteger< ScalarType >( 2 )
+                       * fabs( hyperbolicMeanAnomaly ) / eccentricity );
+    }
+
+    // Apply Halley corrections.
+    const ScalarType tolerance = getFloatingInteger< ScalarType >( 10 )
+            * std::numeric_limits< ScalarType >::epsilon( );
+    for ( int i = 0; i < maximumNumberOfIterations; i++ )
+    {
+        const ScalarType keplersFunction = eccentricityMinusOne * hyperbolicEccentricAnomaly
+                + eccentricity * computeHyperbolicSineMinusAnomaly( hyperbolicEccentricAnomaly )
+                - hyperbolicMeanAnomaly;
+        const ScalarType firstDerivative = eccentricity * cosh( hyperbolicEccentricAnomaly )
+                - getFloatingInteger< ScalarType >( 1 );
+        const ScalarType secondDerivative
+                = eccentricity * sinh( hyperbolicEccentricAnomaly );
+
+        const ScalarType correction = -keplersFunction
+                / ( firstDerivative - keplersFunction * secondDerivative
+                    / ( getFloatingInteger< ScalarType >( 2 ) * firstDerivative ) );
+        hyperbolicEccentricAnomaly += correction;
+
+        if ( fabs( correction ) <= tolerance * std::max(
+                 getFloatingInteger< ScalarType >( 1 ), fabs( hyperbolicEccentricAnomaly ) ) )
+        {
+            return hyperbolicEccentricAnomaly;
+        }
+    }
+
+    boost::throw_exception(
+                boost::enable_error_info(
+                    std::runtime_error( "Hyperbolic Kepler equation solver did not converge." ) ) );
+}
+
+//! Check sizes of batch of eccentricities and mean anomalies.
+/*!
+ * Checks whether the number of eccentricities matches the number of mean anomalies in a batch of
+ * orbits for which Kepler's equation is to be solved, and throws an exception if not.
+ * \param eccentricities Eccentricities of the orbits [-].
+ * \param meanAnomalies (Hyperbolic) mean anomalies [rad].
+ */
+void checkKeplerEquationBatchSizes( const Eigen::ArrayXd& eccentricities,
+                                    const Eigen::ArrayXd& meanAnomalies );
+
+//! Solve Kepler's equation for a batch of elliptical orbits.
+/*!
+ * Solves Kepler's equation for the eccentric anomaly for a batch of elliptical orbits, using the
+ * same method as solveKeplersEquationForEllipticalOrbits(). The computations are expressed as
+ * Eigen array expressions over the complete batch, so that they can be vectorized by the
+ * compiler.
+ * \param eccentricities Eccentricities of the orbits (all >= 0.0 and < 1.0) [-].
+ * \param meanAnomalies Mean anomalies [rad].
+ * \return Eccentric anomalies, in the same revolution as the mean anomalies [rad].
+ */
+Eigen::ArrayXd solveKeplersEquationForEllipticalOrbitBatch( const Eigen::ArrayXd& eccentricities,
+                                                           const Eigen::ArrayXd& meanAnomalies );
+
+//! Solve Kepler's equation for a batch of hyperbolic orbits.
+/*!
+ * Solves Kepler's equation for the hyperbolic eccentric anomaly for a batch of hyperbolic orbits,
+ * using the same method as solveKeplersEquationForHyperbolicOrbits(). The Halley corrections are
+ * only applied to the anomalies that have not yet converged, such that the cost of each iteration
+ * decreases as the batch converges.
+ * \param eccentricities Eccentricities of the orbits (all > 1.0) [-].
+ * \param hyperbolicMeanAnomalies Hyperbolic mean anomalies [rad].
+ * \param maximumNumberOfIterations Maximum number of Halley corrections (default = 50).
+ * \return Hyperbolic eccentric anomalies [rad].
+ */
+Eigen::ArrayXd solveKeplersEquationForHyperbolicOrbitBatch(
+        const Eigen::ArrayXd& eccentricities, const Eigen::ArrayXd& hyperbolicMeanAnomalies,
+        const int maximumNumberOfIterations = 50 );
+
+} // namespace orbital_element_conversions
+
+} // namespace tudat
+
+#endif // TUDAT_KEPLER_EQUATION_SOLVERS_H
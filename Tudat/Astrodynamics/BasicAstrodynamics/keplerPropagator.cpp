@@ -0,0 +1,144 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#include <vector>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/keplerPropagator.h"
+
+namespace tudat
+{
+
+namespace orbital_element_conversions
+{
+
+//! Propagate batch of Kepler orbits.
+Eigen::Matrix< double, 6, Eigen::Dynamic > propagateKeplerOrbits(
+        const Eigen::Matrix< double, 6, Eigen::Dynamic >& initialStatesInKeplerianElements,
+        const double propagationTime,
+        const double centralBodyGravitationalParameter )
+{
+    Eigen::Matrix< double, 6, Eigen::Dynamic > finalStatesInKeplerianElements
+            = initialStatesInKeplerianElements;
+
+    // Sort orbits by type.
+    std::vector< int > ellipticalOrbitIndices, hyperbolicOrbitIndices;
+    for ( int i = 0; i < initialStatesInKeplerianElements.cols( ); i++ )
+    {
+        const double eccentricity = initialStatesInKeplerianElements( eccentricityIndex, i );
+        if ( eccentricity < 0.0 )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error( "Eccentricity is invalid (smaller than 0)." ) ) );
+        }
+        else if ( eccentricity < 1.0 )
+        {
+            ellipticalOrbitIndices.push_back( i );
+        }
+        else if ( eccentricity > 1.0 )
+        {
+            hyperbolicOrbitIndices.push_back( i );
+        }
+        else
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error( "Parabolic orbits are not (yet) supported." ) ) );
+        }
+    }
+
+    // Propagate elliptical orbits.
+    {
+        const int numberOfOrbits = ellipticalOrbitIndices.size( );
+        Eigen::ArrayXd eccentricities( numberOfOrbits ), meanAnomalies( numberOfOrbits );
+        for ( int i = 0; i < numberOfOrbits; i++ )
+        {
+            const Eigen::Matrix< double, 6, 1 > initialState
+                    = initialStatesInKeplerianElements.col( ellipticalOrbitIndices[ i ] );
+            eccentricities( i ) = initialState( eccentricityIndex );
+            meanAnomalies( i ) = convertEllipticalEccentricAnomalyToMeanAnomaly(
+                        convertTrueAnomalyToEllipticalEccentricAnomaly(
+                            initialState( trueAnomalyIndex ), eccentricities( i ) ),
+                        eccentricities( i ) )
+                    + convertElapsedTimeToEllipticalMeanAnomalyChange(
+                        propagationTime, centralBodyGravitationalParameter,
+                        initialState( semiMajorAxisIndex ) );
+        }
+
+        const Eigen::ArrayXd eccentricAnomalies
+                = solveKeplersEquationForEllipticalOrbitBatch( eccentricities, meanAnomalies );
+
+        for ( int i = 0; i < numberOfOrbits; i++ )
+        {
+            finalStatesInKeplerianElements( trueAnomalyIndex, ellipticalOrbitIndices[ i ] )
+                    = convertEllipticalEccentricAnomalyToTrueAnomaly(
+                        eccentricAnomalies( i ), eccentricities( i ) );
+        }
+    }
+
+    // Propagate hyperbolic orbits.
+    {
+        const int numberOfOrbits = hyperbolicOrbitIndices.size( );
+        Eigen::ArrayXd eccentricities( numberOfOrbits ), meanAnomalies( numberOfOrbits );
+        for ( int i = 0; i < numberOfOrbits; i++ )
+        {
+            const Eigen::Matrix< double, 6, 1 > initialState
+                    = initialStatesInKeplerianElements.col( hyperbolicOrbitIndices[ i ] );
+            eccentricities( i ) = initialState( eccentricityIndex );
+            meanAnomalies( i ) = convertHyperbolicEccentricAnomalyToMeanAnomaly(
+                        convertTrueAnomalyToHyperbolicEccentricAnomaly(
+                            initialState( trueAnomalyIndex ), eccentricities( i ) ),
+                        eccentricities( i ) )
+                    + convertElapsedTimeToHyperbolicMeanAnomalyChange(
+                        propagationTime, centralBodyGravitationalParameter,
+                        initialState( semiMajorAxisIndex ) );
+        }
+
+        const Eigen::ArrayXd hyperbolicEccentricAnomalies
+                = solveKeplersEquationForHyperbolicOrbitBatch( eccentricities, meanAnomalies );
+
+        for ( int i = 0; i < numberOfOrbits; i++ )
+        {
+            finalStatesInKeplerianElements( trueAnomalyIndex, hyperbolicOrbitIndices[ i ] )
+                    = convertHyperbolicEccentricAnomalyToTrueAnomaly(
+                        hyperbolicEccentricAnomalies( i ), eccentricities( i ) );
+        }
+    }
+
+    return finalStatesInKeplerianElements;
+}
+
+} // namespace orbital_element_conversions
+
+} // namespace tudat
@@ -40,6 +40,8 @@
  *      121205    P. Musegaas       Updated code to final version of rootfinders.
  *      130120    K. Kumar          Updated VectorXd to Vector6d.
  *      150417    D. Dirkx          Made modifications for templated element conversions.
+ *      261018                      Solved Kepler's equation without root-finder by default; added
+ *                                  batch propagation of multiple orbits.
  *
  *    References
  *
@@ -58,6 +60,7 @@
 #include "Tudat/Astrodynamics/BasicAstrodynamics/stateVectorIndices.h"
 #include "Tudat/Astrodynamics/BasicAstrodynamics/orbitalElementConversions.h"
 #include "Tudat/Astrodynamics/BasicAstrodynamics/convertMeanToEccentricAnomalies.h"
+#include "Tudat/Astrodynamics/BasicAstrodynamics/keplerEquationSolvers.h"
 #include "Tudat/Mathematics/RootFinders/rootFinder.h"
 #include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
 
@@ -88,9 +91,9 @@ namespace orbital_element_conversions
  * \param propagationTime Propagation time.                                                     [s]
  * \param centralBodyGravitationalParameter Gravitational parameter of central body      [m^3 s^-2]
  * \param aRootFinder Shared-pointer to the root-finder that is used to solve the conversion from
- *          mean to eccentric anomaly. Default is Newton-Raphson using 5.0e-14 absolute X-tolerance
- *          and 1000 iterations as maximum. Higher precision may invoke machine precision
- *          problems for some values.
+ *          mean to eccentric anomaly. By default, no root-finder is used, and Kepler's equation
+ *          is solved with solveKeplersEquationForEllipticalOrbits() or
+ *          solveKeplersEquationForHyperbolicOrbits().
  * \return finalStateInKeplerianElements Final state vector in classical Keplerian elements.
  *          Order is important!
  *          finalStateInKeplerianElements( 0 ) = semiMajorAxis,                                 [m]
@@ -144,10 +147,13 @@ Eigen::Matrix< ScalarType, 6, 1 > propagateKeplerOrbit(
                     initialStateInKeplerianElements( semiMajorAxisIndex ) );
 
         // Compute eccentric anomaly for mean anomaly.
-        const ScalarType finalEccentricAnomaly =
-                convertMeanAnomalyToEccentricAnomaly< ScalarType >(
-                    initialStateInKeplerianElements( eccentricityIndex ),
-                    initialMeanAnomaly + meanAnomalyChange );
+        const ScalarType finalEccentricAnomaly = aRootFinder.get( )
+                ? convertMeanAnomalyToEccentricAnomaly< ScalarType >(
+                      initialStateInKeplerianElements( eccentricityIndex ),
+                      initialMeanAnomaly + meanAnomalyChange, true, TUDAT_NAN, aRootFinder )
+                : solveKeplersEquationForEllipticalOrbits< ScalarType >(
+                      initialStateInKeplerianElements( eccentricityIndex ),
+                      initialMeanAnomaly + meanAnomalyChange );
 
         // Compute true anomaly for computed eccentric anomaly.
         finalStateInKeplerianElements( trueAnomalyIndex ) =
@@ -178,10 +184,14 @@ Eigen::Matrix< ScalarType, 6, 1 > propagateKeplerOrbit(
                     initialStateInKeplerianElements( semiMajorAxisIndex ) );
 
         // Compute hyperbolic eccentric anomaly for mean anomaly.
-        const ScalarType finalHyperbolicEccentricAnomaly =
-                convertMeanAnomalyToHyperbolicEccentricAnomaly(
-                    initialStateInKeplerianElements( eccentricityIndex ),
-                    initialHyperbolicMeanAnomaly + hyperbolicMeanAnomalyChange );
+        const ScalarType finalHyperbolicEccentricAnomaly = aRootFinder.get( )
+                ? convertMeanAnomalyToHyperbolicEccentricAnomaly< ScalarType >(
+                      initialStateInKeplerianElements( eccentricityIndex ),
+                      initialHyperbolicMeanAnomaly + hyperbolicMeanAnomalyChange, true,
+                      TUDAT_NAN, aRootFinder )
+                : solveKeplersEquationForHyperbolicOrbits< ScalarType >(
+                      initialStateInKeplerianElements( eccentricityIndex ),
+                      initialHyperbolicMeanAnomaly + hyperbolicMeanAnomalyChange );
 
         // Compute true anomaly for computed hyperbolic eccentric anomaly.
         finalStateInKeplerianElements( trueAnomalyIndex ) =
@@ -201,6 +211,25 @@ Eigen::Matrix< ScalarType, 6, 1 > propagateKeplerOrbit(
     return finalStateInKeplerianElements;
 }
 
+//! Propagate batch of Kepler orbits.
+/*!
+ * Propagates a batch of Kepler orbits (e.g., a catalog of objects) over the same propagation
+ * time. The orbits may be elliptic or hyperbolic; parabolic orbits are not supported and will
+ * result in an error message. Kepler's equation is solved for all elliptic and all hyperbolic
+ * orbits at once, using solveKeplersEquationForEllipticalOrbitBatch() and
+ * solveKeplersEquationForHyperbolicOrbitBatch(). As for propagateKeplerOrbit(), the true anomalies
+ * are returned within the -PI to PI spectrum.
+ * \param initialStatesInKeplerianElements Initial states in classical Keplerian elements, one
+ *          state per column (same order as for propagateKeplerOrbit()).
+ * \param propagationTime Propagation time.                                                    [s]
+ * \param centralBodyGravitationalParameter Gravitational parameter of central body     [m^3 s^-2]
+ * \return Final states in classical Keplerian elements, one state per column.
+ */
+Eigen::Matrix< double, 6, Eigen::Dynamic > propagateKeplerOrbits(
+        const Eigen::Matrix< double, 6, Eigen::Dynamic >& initialStatesInKeplerianElements,
+        const double propagationTime,
+        const double centralBodyGravitationalParameter );
+
 } // namespace orbital_element_conversions
 
 } // namespace tudat
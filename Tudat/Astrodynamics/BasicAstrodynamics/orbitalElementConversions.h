@@ -44,6 +44,7 @@
  *      121205    K. Kumar          Migrated namespace to directory-based protocol and added
  *                                  backwards compatibility.
  *      150417    D. Dirkx          Made modifications for templated element conversions.
+ *      261018                      Made functions usable with dual numbers.
  *
  *    References
  *      Chobotov, V.A. Orbital Mechanics, Third Edition, AIAA Education Series, VA, 2002.
@@ -257,6 +258,9 @@ Eigen::Matrix< ScalarType, 6, 1 > convertCartesianToKeplerianElements(
         const Eigen::Matrix< ScalarType, 6, 1 >& cartesianElements,
         const ScalarType centralBodyGravitationalParameter )
 {
+    using std::acos;
+    using std::fabs;
+
     // Set tolerance.
     const ScalarType tolerance = 20.0 * std::numeric_limits< ScalarType >::epsilon( );
 
@@ -290,8 +294,8 @@ Eigen::Matrix< ScalarType, 6, 1 > convertCartesianToKeplerianElements(
     // Compute and store semi-major axis.
     // Check if orbit is parabolic. If it is, store the semi-latus rectum instead of the
     // semi-major axis.
-    if ( std::fabs( computedKeplerianElements_( eccentricityIndex ) -
-                    mathematical_constants::getFloatingInteger< ScalarType >( 1 ) ) < tolerance )
+    if ( fabs( computedKeplerianElements_( eccentricityIndex ) -
+               mathematical_constants::getFloatingInteger< ScalarType >( 1 ) ) < tolerance )
     {
         computedKeplerianElements_( semiLatusRectumIndex ) = semiLatusRectum_;
     }
@@ -306,8 +310,8 @@ Eigen::Matrix< ScalarType, 6, 1 > convertCartesianToKeplerianElements(
     }
 
     // Compute and store inclination.
-    computedKeplerianElements_( inclinationIndex ) = std::acos( angularMomentum_.z( )
-                                                                / angularMomentum_.norm( ) );
+    computedKeplerianElements_( inclinationIndex ) = acos( angularMomentum_.z( )
+                                                           / angularMomentum_.norm( ) );
 
     // Compute and store longitude of ascending node.
     // Define the quadrant condition for the argument of perigee.
@@ -315,7 +319,7 @@ Eigen::Matrix< ScalarType, 6, 1 > convertCartesianToKeplerianElements(
 
     // Check if the orbit is equatorial. If it is, set the vector to the line of nodes to the
     // x-axis.
-    if ( std::fabs( computedKeplerianElements_( inclinationIndex ) ) < tolerance )
+    if ( fabs( computedKeplerianElements_( inclinationIndex ) ) < tolerance )
     {
         unitAscendingNodeVector_ = Eigen::Matrix< ScalarType, 3, 1 >::UnitX( );
 
@@ -326,7 +330,7 @@ Eigen::Matrix< ScalarType, 6, 1 > convertCartesianToKeplerianElements(
 
     // Compute and store the resulting longitude of ascending node.
     computedKeplerianElements_( longitudeOfAscendingNodeIndex )
-            = std::acos( unitAscendingNodeVector_.x( ) );
+            = acos( unitAscendingNodeVector_.x( ) );
 
     // Check if the quandrant is correct.
     if ( unitAscendingNodeVector_.y( ) <
@@ -344,7 +348,7 @@ Eigen::Matrix< ScalarType, 6, 1 > convertCartesianToKeplerianElements(
 
     // Check if the orbit is circular. If it is, set the eccentricity vector to unit vector
     // pointing to the ascending node, i.e. set the argument of periapsis to zero.
-    if ( std::fabs( computedKeplerianElements_( eccentricityIndex ) ) < tolerance )
+    if ( fabs( computedKeplerianElements_( eccentricityIndex ) ) < tolerance )
     {
         eccentricityVector_ = unitAscendingNodeVector_;
 
@@ -375,7 +379,7 @@ Eigen::Matrix< ScalarType, 6, 1 > convertCartesianToKeplerianElements(
     else
     {
         computedKeplerianElements_( argumentOfPeriapsisIndex )
-                = std::acos( eccentricityVector_.normalized( ).dot( unitAscendingNodeVector_ ) );
+                = acos( eccentricityVector_.normalized( ).dot( unitAscendingNodeVector_ ) );
 
         // Check if the quadrant is correct.
         if ( argumentOfPeriapsisQuandrantCondition <
@@ -394,14 +398,14 @@ Eigen::Matrix< ScalarType, 6, 1 > convertCartesianToKeplerianElements(
 
     // Check if the dot-product is one of the limiting cases: 0.0 or 1.0
     // (within prescribed tolerance).
-    if ( std::fabs( mathematical_constants::getFloatingInteger< ScalarType >( 1 ) -
-                    dotProductPositionAndEccentricityVectors ) < tolerance )
+    if ( fabs( mathematical_constants::getFloatingInteger< ScalarType >( 1 ) -
+               dotProductPositionAndEccentricityVectors ) < tolerance )
     {
         dotProductPositionAndEccentricityVectors =
                 mathematical_constants::getFloatingInteger< ScalarType >( 1 );
     }
 
-    if ( std::fabs( dotProductPositionAndEccentricityVectors ) < tolerance )
+    if ( fabs( dotProductPositionAndEccentricityVectors ) < tolerance )
     {
         dotProductPositionAndEccentricityVectors  =
                 mathematical_constants::getFloatingInteger< ScalarType >( 0 );
@@ -409,7 +413,7 @@ Eigen::Matrix< ScalarType, 6, 1 > convertCartesianToKeplerianElements(
 
     // Compute and store true anomaly.
     computedKeplerianElements_( trueAnomalyIndex )
-            = std::acos( dotProductPositionAndEccentricityVectors );
+            = acos( dotProductPositionAndEccentricityVectors );
 
     // Check if the quandrant is correct.
     if ( trueAnomalyQuandrantCondition <
@@ -440,9 +444,10 @@ ScalarType convertTrueAnomalyToEllipticalEccentricAnomaly(
         const ScalarType trueAnomaly, const ScalarType eccentricity )
 
 {
+    using std::atan2;
     using std::cos;
+    using std::sin;
     using std::sqrt;
-    using std::atan2;
 
     if ( eccentricity >= mathematical_constants::getFloatingInteger< ScalarType >( 1 ) ||
          eccentricity < mathematical_constants::getFloatingInteger< ScalarType >( 0 ) )
@@ -456,7 +461,7 @@ ScalarType convertTrueAnomalyToEllipticalEccentricAnomaly(
         // Declare and compute sine and cosine of eccentric anomaly.
         ScalarType sineOfEccentricAnomaly_ =
                 sqrt( mathematical_constants::getFloatingInteger< ScalarType >( 1 ) -
-                      eccentricity * eccentricity ) * std::sin( trueAnomaly ) /
+                      eccentricity * eccentricity ) * sin( trueAnomaly ) /
                 ( mathematical_constants::getFloatingInteger< ScalarType >( 1 ) +
                   eccentricity * cos( trueAnomaly ) );
         ScalarType cosineOfEccentricAnomaly_ = ( eccentricity + cos( trueAnomaly ) )
@@ -480,6 +485,11 @@ template< typename ScalarType = double >
 ScalarType convertTrueAnomalyToHyperbolicEccentricAnomaly( const ScalarType trueAnomaly,
                                                            const ScalarType eccentricity )
 {
+    using boost::math::atanh;
+    using std::cos;
+    using std::sin;
+    using std::sqrt;
+
     if ( eccentricity <= mathematical_constants::getFloatingInteger< ScalarType >( 1 ) )
     {
         boost::throw_exception(
@@ -489,13 +499,11 @@ ScalarType convertTrueAnomalyToHyperbolicEccentricAnomaly( const ScalarType true
 
     else
     {
-        using std::cos;
-
         // Compute hyperbolic sine and hyperbolic cosine of hyperbolic eccentric anomaly.
         ScalarType hyperbolicSineOfHyperbolicEccentricAnomaly_
-                = std::sqrt( eccentricity * eccentricity -
-                             mathematical_constants::getFloatingInteger< ScalarType >( 1 ) )
-                * std::sin( trueAnomaly ) /
+                = sqrt( eccentricity * eccentricity -
+                        mathematical_constants::getFloatingInteger< ScalarType >( 1 ) )
+                * sin( trueAnomaly ) /
                 ( mathematical_constants::getFloatingInteger< ScalarType >( 1 ) +
                   cos( trueAnomaly ) );
 
@@ -505,8 +513,8 @@ ScalarType convertTrueAnomalyToHyperbolicEccentricAnomaly( const ScalarType true
                   cos( trueAnomaly ) );
 
         // Return hyperbolic eccentric anomaly.
-        return boost::math::atanh( hyperbolicSineOfHyperbolicEccentricAnomaly_
-                                   / hyperbolicCosineOfHyperbolicEccentricAnomaly_ );
+        return atanh( hyperbolicSineOfHyperbolicEccentricAnomaly_
+                      / hyperbolicCosineOfHyperbolicEccentricAnomaly_ );
     }
 }
 
@@ -527,6 +535,8 @@ template< typename ScalarType = double >
 ScalarType convertTrueAnomalyToEccentricAnomaly( const ScalarType trueAnomaly,
                                                  const ScalarType eccentricity )
 {
+    using std::fabs;
+
     // Declare computed eccentric anomaly.
     ScalarType eccentricAnomaly_ = 0.0;
 
@@ -539,8 +549,8 @@ ScalarType convertTrueAnomalyToEccentricAnomaly( const ScalarType trueAnomaly,
     }
 
     // Check if orbit is parabolic and throw an error if true.
-    else if ( std::fabs( eccentricity -
-                         mathematical_constants::getFloatingInteger< ScalarType >( 1 ) ) <
+    else if ( fabs( eccentricity -
+                    mathematical_constants::getFloatingInteger< ScalarType >( 1 ) ) <
               std::numeric_limits< ScalarType >::epsilon( ) )
     {
         boost::throw_exception(
@@ -580,6 +590,11 @@ ScalarType convertEllipticalEccentricAnomalyToTrueAnomaly(
         const ScalarType ellipticEccentricAnomaly,
         const ScalarType eccentricity )
 {
+    using std::atan2;
+    using std::cos;
+    using std::sin;
+    using std::sqrt;
+
     if ( eccentricity >= mathematical_constants::getFloatingInteger< ScalarType >( 1 ) ||
          eccentricity < mathematical_constants::getFloatingInteger< ScalarType >( 0 ) )
     {
@@ -590,14 +605,11 @@ ScalarType convertEllipticalEccentricAnomalyToTrueAnomaly(
 
     else
     {
-        using std::cos;
-        using std::sqrt;
-
         // Compute sine and cosine of true anomaly.
         ScalarType sineOfTrueAnomaly_ =
                 sqrt( mathematical_constants::getFloatingInteger< ScalarType >( 1 ) -
                       eccentricity * eccentricity ) *
-                std::sin( ellipticEccentricAnomaly )
+                sin( ellipticEccentricAnomaly )
                 / ( mathematical_constants::getFloatingInteger< ScalarType >( 1 ) -
                     eccentricity * cos( ellipticEccentricAnomaly ) );
 
@@ -606,7 +618,7 @@ ScalarType convertEllipticalEccentricAnomalyToTrueAnomaly(
                     eccentricity * cos( ellipticEccentricAnomaly ) );
 
         // Return true anomaly.
-        return std::atan2( sineOfTrueAnomaly_, cosineOfTrueAnomaly_  );
+        return atan2( sineOfTrueAnomaly_, cosineOfTrueAnomaly_  );
     }
 }
 
@@ -623,6 +635,11 @@ ScalarType convertHyperbolicEccentricAnomalyToTrueAnomaly(
         const ScalarType hyperbolicEccentricAnomaly,
         const ScalarType eccentricity )
 {
+    using std::atan2;
+    using std::cosh;
+    using std::sinh;
+    using std::sqrt;
+
     if ( eccentricity <= mathematical_constants::getFloatingInteger< ScalarType >( 1 ) )
     {
         boost::throw_exception(
@@ -632,13 +649,11 @@ ScalarType convertHyperbolicEccentricAnomalyToTrueAnomaly(
 
     else
     {
-        using std::cosh;
-
         // Compute sine and cosine of true anomaly.
         ScalarType sineOfTrueAnomaly_
-                = std::sqrt( eccentricity * eccentricity -
-                             mathematical_constants::getFloatingInteger< ScalarType >( 1 ) )
-                * std::sinh( hyperbolicEccentricAnomaly )
+                = sqrt( eccentricity * eccentricity -
+                        mathematical_constants::getFloatingInteger< ScalarType >( 1 ) )
+                * sinh( hyperbolicEccentricAnomaly )
                 / ( eccentricity * cosh( hyperbolicEccentricAnomaly ) -
                     mathematical_constants::getFloatingInteger< ScalarType >( 1 ) );
 
@@ -648,7 +663,7 @@ ScalarType convertHyperbolicEccentricAnomalyToTrueAnomaly(
                     mathematical_constants::getFloatingInteger< ScalarType >( 1 ) );
 
         // Return true anomaly.
-        return std::atan2( sineOfTrueAnomaly_, cosineOfTrueAnomaly_ );
+        return atan2( sineOfTrueAnomaly_, cosineOfTrueAnomaly_ );
     }
 
 }
@@ -671,6 +686,8 @@ template< typename ScalarType = double >
 ScalarType convertEccentricAnomalyToTrueAnomaly( const ScalarType eccentricAnomaly,
                                                  const ScalarType eccentricity )
 {
+    using std::fabs;
+
     // Declare computed true anomaly.
     ScalarType trueAnomaly_ = -mathematical_constants::getFloatingInteger< ScalarType >( 0 );
 
@@ -683,8 +700,8 @@ ScalarType convertEccentricAnomalyToTrueAnomaly( const ScalarType eccentricAnoma
     }
 
     // Check if orbit is parabolic and throw an error if true.
-    else if ( std::fabs( eccentricity -
-                         mathematical_constants::getFloatingInteger< ScalarType >( 1 ) ) <
+    else if ( fabs( eccentricity -
+                    mathematical_constants::getFloatingInteger< ScalarType >( 1 ) ) <
               std::numeric_limits< ScalarType >::epsilon( ) )
     {
         boost::throw_exception(
@@ -725,7 +742,9 @@ ScalarType convertEllipticalEccentricAnomalyToMeanAnomaly(
         const ScalarType ellipticalEccentricAnomaly,
         const ScalarType eccentricity )
 {
-    return ellipticalEccentricAnomaly - eccentricity * std::sin( ellipticalEccentricAnomaly );
+    using std::sin;
+
+    return ellipticalEccentricAnomaly - eccentricity * sin( ellipticalEccentricAnomaly );
 }
 
 
@@ -742,7 +761,9 @@ ScalarType convertHyperbolicEccentricAnomalyToMeanAnomaly(
         const ScalarType hyperbolicEccentricAnomaly,
         const ScalarType eccentricity )
 {
-    return eccentricity * std::sinh( hyperbolicEccentricAnomaly ) - hyperbolicEccentricAnomaly;
+    using std::sinh;
+
+    return eccentricity * sinh( hyperbolicEccentricAnomaly ) - hyperbolicEccentricAnomaly;
 }
 
 //! Convert eccentric anomaly to mean anomaly.
@@ -763,6 +784,8 @@ ScalarType convertEccentricAnomalyToMeanAnomaly(
         const ScalarType eccentricAnomaly,
         const ScalarType eccentricity )
 {
+    using std::fabs;
+
     // Declare computed mean anomaly.
     ScalarType meanAnomaly_ = 0.0;
 
@@ -775,8 +798,8 @@ ScalarType convertEccentricAnomalyToMeanAnomaly(
     }
 
     // Check if orbit is parabolic and throw an error if true.
-    else if ( std::fabs( eccentricity -
-                         mathematical_constants::getFloatingInteger< ScalarType >( 1 ) ) <
+    else if ( fabs( eccentricity -
+                    mathematical_constants::getFloatingInteger< ScalarType >( 1 ) ) <
               std::numeric_limits< ScalarType >::epsilon( ) )
     {
         boost::throw_exception(
@@ -819,6 +842,8 @@ ScalarType convertElapsedTimeToEllipticalMeanAnomalyChange(
         const ScalarType elapsedTime, const ScalarType centralBodyGravitationalParameter,
         const ScalarType semiMajorAxis )
 {
+    using std::sqrt;
+
     // Check if semi-major axis is invalid and throw error if true.
     if ( semiMajorAxis < mathematical_constants::getFloatingInteger< ScalarType >( 0 ) )
     {
@@ -830,8 +855,8 @@ ScalarType convertElapsedTimeToEllipticalMeanAnomalyChange(
     // Else return elliptical mean anomaly change.
     else
     {
-        return std::sqrt( centralBodyGravitationalParameter
-                          / ( semiMajorAxis * semiMajorAxis * semiMajorAxis ) ) * elapsedTime;
+        return sqrt( centralBodyGravitationalParameter
+                     / ( semiMajorAxis * semiMajorAxis * semiMajorAxis ) ) * elapsedTime;
     }
 }
 
@@ -851,6 +876,8 @@ ScalarType convertElapsedTimeToHyperbolicMeanAnomalyChange(
         const ScalarType elapsedTime, const ScalarType centralBodyGravitationalParameter,
         const ScalarType semiMajorAxis )
 {
+    using std::sqrt;
+
     // Check if semi-major axis is invalid and throw error if true.
     if ( semiMajorAxis > mathematical_constants::getFloatingInteger< ScalarType >( 0 ) )
     {
@@ -862,8 +889,8 @@ ScalarType convertElapsedTimeToHyperbolicMeanAnomalyChange(
     // Else return hyperbolic mean anomaly change.
     else
     {
-        return std::sqrt( centralBodyGravitationalParameter
-                          / ( - semiMajorAxis * semiMajorAxis * semiMajorAxis ) ) * elapsedTime;
+        return sqrt( centralBodyGravitationalParameter
+                     / ( - semiMajorAxis * semiMajorAxis * semiMajorAxis ) ) * elapsedTime;
     }
 }
 
@@ -923,6 +950,8 @@ ScalarType convertEllipticalMeanAnomalyChangeToElapsedTime(
         const ScalarType centralBodyGravitationalParameter,
         const ScalarType semiMajorAxis )
 {
+    using std::sqrt;
+
     // Check if semi-major axis is invalid and throw error if true.
     if ( semiMajorAxis < mathematical_constants::getFloatingInteger< ScalarType >( 0 ) )
     {
@@ -934,7 +963,7 @@ ScalarType convertEllipticalMeanAnomalyChangeToElapsedTime(
     // Else return elapsed time.
     else
     {
-        return ellipticalMeanAnomalyChange * std::sqrt(
+        return ellipticalMeanAnomalyChange * sqrt(
                     semiMajorAxis * semiMajorAxis * semiMajorAxis
                     / centralBodyGravitationalParameter );
     }
@@ -956,6 +985,8 @@ ScalarType convertHyperbolicMeanAnomalyChangeToElapsedTime(
         const ScalarType centralBodyGravitationalParameter,
         const ScalarType semiMajorAxis )
 {
+    using std::sqrt;
+
     // Check if semi-major axis is invalid and throw error if true.
     if ( semiMajorAxis > mathematical_constants::getFloatingInteger< ScalarType >( 0 ) )
     {
@@ -967,8 +998,8 @@ ScalarType convertHyperbolicMeanAnomalyChangeToElapsedTime(
     // Else return elapsed time.
     else
     {
-        return std::sqrt( -semiMajorAxis * semiMajorAxis * semiMajorAxis
-                          / centralBodyGravitationalParameter ) * hyperbolicMeanAnomalyChange;
+        return sqrt( -semiMajorAxis * semiMajorAxis * semiMajorAxis
+                     / centralBodyGravitationalParameter ) * hyperbolicMeanAnomalyChange;
     }
 }
 
@@ -1022,9 +1053,11 @@ template< typename ScalarType = double >
 ScalarType convertEllipticalMeanMotionToSemiMajorAxis(
         const ScalarType ellipticalMeanMotion, const ScalarType centralBodyGravitationalParameter )
 {
-    return std::pow( centralBodyGravitationalParameter
-                     / ( ellipticalMeanMotion * ellipticalMeanMotion ),
-                     mathematical_constants::getFloatingFraction< ScalarType >( 1, 3 ) );
+    using std::pow;
+
+    return pow( centralBodyGravitationalParameter
+                / ( ellipticalMeanMotion * ellipticalMeanMotion ),
+                mathematical_constants::getFloatingFraction< ScalarType >( 1, 3 ) );
 }
 
 //! Convert semi-major axis to elliptical mean motion.
@@ -1038,6 +1071,8 @@ template< typename ScalarType = double >
 ScalarType convertSemiMajorAxisToEllipticalMeanMotion(
         const ScalarType semiMajorAxis, const ScalarType centralBodyGravitationalParameter )
 {
+    using std::sqrt;
+
     // Check if semi-major axis is invalid and throw error if true.
     if ( semiMajorAxis < mathematical_constants::getFloatingInteger< ScalarType >( 0 ) )
     {
@@ -1048,8 +1083,8 @@ ScalarType convertSemiMajorAxisToEllipticalMeanMotion(
 
     // Else compute and return elliptical mean motion.
     {
-        return std::sqrt( centralBodyGravitationalParameter /
-                          ( semiMajorAxis * semiMajorAxis * semiMajorAxis ) );
+        return sqrt( centralBodyGravitationalParameter /
+                     ( semiMajorAxis * semiMajorAxis * semiMajorAxis ) );
     }
 }
 } // namespace orbital_element_conversions
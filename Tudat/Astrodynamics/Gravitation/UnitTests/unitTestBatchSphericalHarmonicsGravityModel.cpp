@@ -0,0 +1,243 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      Unit test created.
+ *      261018                      Added test of evaluation on polar axis.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Basics/testMacros.h"
+
+#include "Tudat/Astrodynamics/Gravitation/batchSphericalHarmonicsGravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModel.h"
+#include "Tudat/Mathematics/BasicMathematics/sphericalHarmonics.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Get synthetic geodesy-normalized coefficients of test field.
+void getTestCoefficients( const int maximumDegree, const int maximumOrder,
+                          Eigen::MatrixXd& cosineCoefficients, Eigen::MatrixXd& sineCoefficients )
+{
+    cosineCoefficients = Eigen::MatrixXd::Zero( maximumDegree + 1, maximumOrder + 1 );
+    sineCoefficients = Eigen::MatrixXd::Zero( maximumDegree + 1, maximumOrder + 1 );
+    cosineCoefficients( 0, 0 ) = 1.0;
+    cosineCoefficients( 2, 0 ) = -4.841651437908150e-4;
+    for ( int degree = 2; degree <= maximumDegree; degree++ )
+    {
+        for ( int order = 0; order <= degree && order <= maximumOrder; order++ )
+        {
+            cosineCoefficients( degree, order ) += 1.0e-6 / ( degree * degree )
+                    * std::sin( 1.3 * degree + 2.1 * order );
+            if ( order > 0 )
+            {
+                sineCoefficients( degree, order ) = 1.0e-6 / ( degree * degree )
+                        * std::cos( 0.7 * degree + 1.7 * order );
+            }
+        }
+    }
+}
+
+//! Get set of test positions, distributed over a shell around the body.
+Eigen::Matrix3Xd getTestPositions( const int numberOfPositions )
+{
+    Eigen::Matrix3Xd positions( 3, numberOfPositions );
+    for ( int i = 0; i < numberOfPositions; i++ )
+    {
+        const double latitude = 1.5 * std::sin( 0.731 * i );
+        const double longitude = 2.399963 * i;
+        const double radius = 6.6e6 + 1.0e6 * std::fabs( std::cos( 1.17 * i ) );
+        positions.col( i ) = radius * Eigen::Vector3d( std::cos( latitude ) * std::cos( longitude ),
+                                                       std::cos( latitude ) * std::sin( longitude ),
+                                                       std::sin( latitude ) );
+    }
+    return positions;
+}
+
+BOOST_AUTO_TEST_SUITE( test_batch_spherical_harmonics_gravity_model )
+
+//! Test whether batch evaluation reproduces single-position evaluation.
+BOOST_AUTO_TEST_CASE( testBatchAgainstSinglePositionEvaluation )
+{
+    using namespace gravitation;
+
+    const double gravitationalParameter = 3.986004418e14;
+    const double planetaryRadius = 6378137.0;
+
+    // Test both square coefficient matrices, and matrices with order lower than degree. The number
+    // of positions is chosen such that the last chunk is not completely filled.
+    const int maximumDegrees[ 2 ] = { 30, 12 };
+    const int maximumOrders[ 2 ] = { 30, 5 };
+    const int numberOfPositions = 4 * BatchSphericalHarmonicsWorkspace::numberOfLanes + 5;
+    const Eigen::Matrix3Xd positions = getTestPositions( numberOfPositions );
+
+    for ( int testCase = 0; testCase < 2; testCase++ )
+    {
+        Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+        getTestCoefficients( maximumDegrees[ testCase ], maximumOrders[ testCase ],
+                             cosineCoefficients, sineCoefficients );
+
+        const Eigen::Matrix3Xd batchAccelerations
+                = computeBatchGeodesyNormalizedGravitationalAccelerationSum(
+                    positions, gravitationalParameter, planetaryRadius,
+                    cosineCoefficients, sineCoefficients );
+
+        basic_mathematics::SphericalHarmonicsWorkspace workspace(
+                    maximumDegrees[ testCase ], maximumOrders[ testCase ] );
+        for ( int i = 0; i < numberOfPositions; i++ )
+        {
+            const Eigen::Vector3d expectedAcceleration
+                    = computeGeodesyNormalizedGravitationalAccelerationSum(
+                        positions.col( i ), gravitationalParameter, planetaryRadius,
+                        cosineCoefficients, sineCoefficients, workspace );
+            const Eigen::Vector3d computedAcceleration = batchAccelerations.col( i );
+
+            TUDAT_CHECK_MATRIX_BASE( computedAcceleration, expectedAcceleration )
+                    BOOST_CHECK_SMALL( computedAcceleration.coeff( row, col )
+                                       - expectedAcceleration.coeff( row, col ),
+                                       1.0e-14 * expectedAcceleration.norm( ) );
+        }
+    }
+}
+
+//! Test whether batch evaluation is regular on the polar axis.
+BOOST_AUTO_TEST_CASE( testBatchEvaluationOnPolarAxis )
+{
+    using namespace gravitation;
+
+    const double gravitationalParameter = 3.986004418e14;
+    const double planetaryRadius = 6378137.0;
+
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    getTestCoefficients( 12, 12, cosineCoefficients, sineCoefficients );
+
+    // Set positions on and near the polar axis, above both poles.
+    Eigen::Matrix3Xd positions( 3, 4 );
+    positions << 0.0, 0.0, 1.0E-3, 0.0,
+            0.0, 0.0, 0.0, 1.0E-3,
+            7.0E6, -7.0E6, 7.0E6, -7.0E6;
+
+    const Eigen::Matrix3Xd batchAccelerations
+            = computeBatchGeodesyNormalizedGravitationalAccelerationSum(
+                positions, gravitationalParameter, planetaryRadius,
+                cosineCoefficients, sineCoefficients );
+
+    basic_mathematics::SphericalHarmonicsWorkspace workspace( 12, 12 );
+    for ( int i = 0; i < positions.cols( ); i++ )
+    {
+        const Eigen::Vector3d expectedAcceleration
+                = computeGeodesyNormalizedGravitationalAccelerationSum(
+                    positions.col( i ), gravitationalParameter, planetaryRadius,
+                    cosineCoefficients, sineCoefficients, workspace );
+        const Eigen::Vector3d computedAcceleration = batchAccelerations.col( i );
+
+        BOOST_CHECK( computedAcceleration.allFinite( ) );
+        TUDAT_CHECK_MATRIX_BASE( computedAcceleration, expectedAcceleration )
+                BOOST_CHECK_SMALL( computedAcceleration.coeff( row, col )
+                                   - expectedAcceleration.coeff( row, col ),
+                                   1.0e-14 * expectedAcceleration.norm( ) );
+    }
+}
+
+//! Test whether multi-threaded evaluation gives identical results.
+BOOST_AUTO_TEST_CASE( testBatchMultiThreadedEvaluation )
+{
+    using namespace gravitation;
+
+    const double gravitationalParameter = 3.986004418e14;
+    const double planetaryRadius = 6378137.0;
+
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    getTestCoefficients( 20, 20, cosineCoefficients, sineCoefficients );
+    const Eigen::Matrix3Xd positions = getTestPositions( 1001 );
+
+    const Eigen::Matrix3Xd singleThreadedAccelerations
+            = computeBatchGeodesyNormalizedGravitationalAccelerationSum(
+                positions, gravitationalParameter, planetaryRadius,
+                cosineCoefficients, sineCoefficients, 1 );
+
+    // Check results for various numbers of threads, including more threads than chunks.
+    const int numberOfThreads[ 3 ] = { 2, 3, 1000 };
+    for ( int i = 0; i < 3; i++ )
+    {
+        const Eigen::Matrix3Xd multiThreadedAccelerations
+                = computeBatchGeodesyNormalizedGravitationalAccelerationSum(
+                    positions, gravitationalParameter, planetaryRadius,
+                    cosineCoefficients, sineCoefficients, numberOfThreads[ i ] );
+        BOOST_CHECK( multiThreadedAccelerations == singleThreadedAccelerations );
+    }
+}
+
+//! Test whether invalid input is rejected.
+BOOST_AUTO_TEST_CASE( testBatchInvalidInput )
+{
+    using namespace gravitation;
+
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    getTestCoefficients( 4, 4, cosineCoefficients, sineCoefficients );
+
+    // Check that empty batch is handled.
+    BOOST_CHECK_EQUAL( computeBatchGeodesyNormalizedGravitationalAccelerationSum(
+                           Eigen::Matrix3Xd( 3, 0 ), 3.986004418e14, 6378137.0,
+                           cosineCoefficients, sineCoefficients, 4 ).cols( ), 0 );
+
+    // Check that position inside reference sphere is rejected.
+    Eigen::Matrix3Xd positions = getTestPositions( 10 );
+    positions.col( 7 ) = Eigen::Vector3d( 1.0e6, 0.0, 0.0 );
+    bool isExceptionThrown = false;
+    try
+    {
+        computeBatchGeodesyNormalizedGravitationalAccelerationSum(
+                    positions, 3.986004418e14, 6378137.0, cosineCoefficients, sineCoefficients );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown = true;
+    }
+    BOOST_CHECK( isExceptionThrown );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,298 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      Unit test created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/lambda/lambda.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Basics/testMacros.h"
+
+#include "Tudat/Astrodynamics/Gravitation/griddedGravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModel.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Get set of geodesy-normalized test coefficients, with a realistic decay with degree.
+void getGriddedGravityTestCoefficients( const int numberOfDegrees,
+                                        Eigen::MatrixXd& cosineCoefficients,
+                                        Eigen::MatrixXd& sineCoefficients )
+{
+    cosineCoefficients = Eigen::MatrixXd::Zero( numberOfDegrees, numberOfDegrees );
+    sineCoefficients = Eigen::MatrixXd::Zero( numberOfDegrees, numberOfDegrees );
+    cosineCoefficients( 0, 0 ) = 1.0;
+    cosineCoefficients( 2, 0 ) = -4.841651437908150e-4;
+    for ( int degree = 2; degree < numberOfDegrees; degree++ )
+    {
+        for ( int order = 0; order <= degree; order++ )
+        {
+            if ( degree > 2 || order > 0 )
+            {
+                cosineCoefficients( degree, order ) = 1.0E-5 / ( degree * degree )
+                        * std::sin( 1.3 * degree + 0.7 * order );
+            }
+            if ( order > 0 )
+            {
+                sineCoefficients( degree, order ) = 1.0E-5 / ( degree * degree )
+                        * std::cos( 0.9 * degree + 1.1 * order );
+            }
+        }
+    }
+}
+
+//! Get test position in shell, from set of pseudo-random numbers.
+Eigen::Vector3d getGriddedGravityTestPosition( const int index, const double minimumRadius,
+                                               const double maximumRadius )
+{
+    const double radius = minimumRadius + ( maximumRadius - minimumRadius )
+            * ( 0.5 + 0.5 * std::sin( 12.9898 * index ) );
+    const double latitude = 1.5707963 * std::sin( 78.233 * index );
+    const double longitude = 3.1415926 * std::sin( 37.719 * index );
+    return radius * Eigen::Vector3d( std::cos( latitude ) * std::cos( longitude ),
+                                     std::cos( latitude ) * std::sin( longitude ),
+                                     std::sin( latitude ) );
+}
+
+BOOST_AUTO_TEST_SUITE( test_gridded_gravity_model )
+
+//! Test interpolation of perturbing acceleration from grid.
+BOOST_AUTO_TEST_CASE( testSphericalHarmonicsAccelerationGrid )
+{
+    using namespace gravitation;
+
+    const double gravitationalParameter = 3.986004418e14;
+    const double referenceRadius = 6378137.0;
+    const double minimumRadius = referenceRadius + 3.0E5;
+    const double maximumRadius = referenceRadius + 1.0E6;
+
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    getGriddedGravityTestCoefficients( 11, cosineCoefficients, sineCoefficients );
+
+    SphericalHarmonicsAccelerationGrid accelerationGrid(
+                gravitationalParameter, referenceRadius, cosineCoefficients, sineCoefficients,
+                minimumRadius, maximumRadius, 8, 90, 180 );
+    BOOST_CHECK_LT( accelerationGrid.getVerifiedMaximumError( ), 0.0 );
+
+    const double maximumError = accelerationGrid.computeMaximumInterpolationError( 500 );
+    BOOST_CHECK_EQUAL( accelerationGrid.getVerifiedMaximumError( ), maximumError );
+
+    // Check perturbing acceleration, excluding central term, against spherical harmonics
+    // expansion (in singularity-free formulation), including points on and close to the polar
+    // axis, and on the date line.
+    PinesSphericalHarmonicsWorkspace pinesWorkspace( 10, 10 );
+    Eigen::MatrixXd perturbingCosineCoefficients = cosineCoefficients;
+    perturbingCosineCoefficients( 0, 0 ) = 0.0;
+    const Eigen::Vector3d sampleAcceleration = computeGeodesyNormalizedGravitationalAccelerationSum(
+                Eigen::Vector3d( minimumRadius, 0.0, 0.0 ), gravitationalParameter,
+                referenceRadius, perturbingCosineCoefficients, sineCoefficients );
+
+    std::vector< Eigen::Vector3d > testPositions;
+    testPositions.push_back( Eigen::Vector3d( 0.0, 0.0, 7.0E6 ) );
+    testPositions.push_back( Eigen::Vector3d( 1.0, 0.0, -7.2E6 ) );
+    testPositions.push_back( Eigen::Vector3d( -7.1E6, 0.0, 1.0E5 ) );
+    testPositions.push_back( Eigen::Vector3d( minimumRadius, 0.0, 0.0 ) );
+    testPositions.push_back( Eigen::Vector3d( 0.0, -maximumRadius, 0.0 ) );
+    for ( int i = 1; i <= 50; i++ )
+    {
+        testPositions.push_back(
+                    getGriddedGravityTestPosition( i, minimumRadius, maximumRadius ) );
+    }
+
+    for ( unsigned int i = 0; i < testPositions.size( ); i++ )
+    {
+        BOOST_CHECK( accelerationGrid.isPositionInGrid( testPositions[ i ] ) );
+        const Eigen::Vector3d expectedAcceleration
+                = computePinesGeodesyNormalizedGravitationalAccelerationSum(
+                    testPositions[ i ], gravitationalParameter, referenceRadius,
+                    perturbingCosineCoefficients, sineCoefficients, pinesWorkspace );
+        BOOST_CHECK_SMALL( ( accelerationGrid.interpolatePerturbingAcceleration(
+                                 testPositions[ i ] ) - expectedAcceleration ).norm( ),
+                           1.0E-5 * sampleAcceleration.norm( ) );
+    }
+
+    BOOST_CHECK( !accelerationGrid.isPositionInGrid( Eigen::Vector3d( 0.0, 0.0, 8.0E6 ) ) );
+}
+
+//! Test creation of acceleration grid with error bound.
+BOOST_AUTO_TEST_CASE( testAccelerationGridWithErrorBound )
+{
+    using namespace gravitation;
+
+    const double gravitationalParameter = 3.986004418e14;
+    const double referenceRadius = 6378137.0;
+    const double minimumRadius = referenceRadius + 5.0E5;
+    const double maximumRadius = referenceRadius + 1.5E6;
+    const double tolerance = 1.0E-8;
+
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    getGriddedGravityTestCoefficients( 11, cosineCoefficients, sineCoefficients );
+
+    const SphericalHarmonicsAccelerationGridPointer accelerationGrid
+            = createSphericalHarmonicsAccelerationGrid(
+                gravitationalParameter, referenceRadius, cosineCoefficients, sineCoefficients,
+                minimumRadius, maximumRadius, tolerance, 4, 20, 40, 500 );
+
+    // Check that grid was refined, and that error bound was met.
+    BOOST_CHECK_GT( accelerationGrid->getNumberOfLatitudeIntervals( ), 20 );
+    BOOST_CHECK_LE( accelerationGrid->getVerifiedMaximumError( ), tolerance );
+
+    // Check error at independent set of test points.
+    for ( int i = 1; i <= 200; i++ )
+    {
+        const Eigen::Vector3d position
+                = getGriddedGravityTestPosition( i, minimumRadius, maximumRadius );
+        BOOST_CHECK_SMALL( ( accelerationGrid->interpolatePerturbingAcceleration( position )
+                             - accelerationGrid->computePerturbingAcceleration( position ) )
+                           .norm( ), 2.0 * tolerance );
+    }
+
+    // Check that error is thrown if tolerance cannot be met.
+    bool isExceptionThrown = false;
+    try
+    {
+        createSphericalHarmonicsAccelerationGrid(
+                    gravitationalParameter, referenceRadius, cosineCoefficients,
+                    sineCoefficients, minimumRadius, maximumRadius, 1.0E-20, 4, 20, 40, 100, 1 );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown = true;
+    }
+    BOOST_CHECK( isExceptionThrown );
+}
+
+//! Test gridded acceleration model against spherical harmonics acceleration model.
+BOOST_AUTO_TEST_CASE( testGriddedGravitationalAccelerationModel )
+{
+    using namespace gravitation;
+
+    const double gravitationalParameter = 3.986004418e14;
+    const double referenceRadius = 6378137.0;
+    const double minimumRadius = referenceRadius + 3.0E5;
+    const double maximumRadius = referenceRadius + 1.0E6;
+    const Eigen::Vector3d centralBodyPosition( 1.0E8, -2.0E7, 3.0E6 );
+
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    getGriddedGravityTestCoefficients( 9, cosineCoefficients, sineCoefficients );
+
+    const SphericalHarmonicsAccelerationGridPointer accelerationGrid
+            = boost::make_shared< SphericalHarmonicsAccelerationGrid >(
+                gravitationalParameter, referenceRadius, cosineCoefficients, sineCoefficients,
+                minimumRadius, maximumRadius, 8, 90, 180 );
+
+    // Position inside grid.
+    {
+        const Eigen::Vector3d position = centralBodyPosition
+                + getGriddedGravityTestPosition( 3, minimumRadius, maximumRadius );
+        GriddedGravitationalAccelerationModel griddedModel(
+                    boost::lambda::constant( position ), accelerationGrid,
+                    boost::lambda::constant( centralBodyPosition ) );
+        SphericalHarmonicsGravitationalAccelerationModelXd sphericalHarmonicsModel(
+                    boost::lambda::constant( position ), gravitationalParameter, referenceRadius,
+                    cosineCoefficients, sineCoefficients,
+                    boost::lambda::constant( centralBodyPosition ) );
+
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( griddedModel.getAcceleration( ),
+                                           sphericalHarmonicsModel.getAcceleration( ), 1.0E-8 );
+    }
+
+    // Position outside grid, for which acceleration is computed directly.
+    {
+        const Eigen::Vector3d position = centralBodyPosition
+                + Eigen::Vector3d( 2.0E7, -1.0E7, 5.0E6 );
+        GriddedGravitationalAccelerationModel griddedModel(
+                    boost::lambda::constant( position ), accelerationGrid,
+                    boost::lambda::constant( centralBodyPosition ) );
+        SphericalHarmonicsGravitationalAccelerationModelXd sphericalHarmonicsModel(
+                    boost::lambda::constant( position ), gravitationalParameter, referenceRadius,
+                    cosineCoefficients, sineCoefficients,
+                    boost::lambda::constant( centralBodyPosition ) );
+
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( griddedModel.getAcceleration( ),
+                                           sphericalHarmonicsModel.getAcceleration( ), 1.0E-14 );
+    }
+}
+
+//! Test whether invalid grid definitions are rejected.
+BOOST_AUTO_TEST_CASE( testAccelerationGridInputChecks )
+{
+    using namespace gravitation;
+
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    getGriddedGravityTestCoefficients( 5, cosineCoefficients, sineCoefficients );
+
+    // Test shell inside reference sphere.
+    bool isExceptionThrown = false;
+    try
+    {
+        SphericalHarmonicsAccelerationGrid accelerationGrid(
+                    3.986004418e14, 6378137.0, cosineCoefficients, sineCoefficients, 6.0E6, 7.0E6,
+                    8, 20, 40 );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown = true;
+    }
+    BOOST_CHECK( isExceptionThrown );
+
+    // Test too small number of radial intervals.
+    isExceptionThrown = false;
+    try
+    {
+        SphericalHarmonicsAccelerationGrid accelerationGrid(
+                    3.986004418e14, 6378137.0, cosineCoefficients, sineCoefficients, 6.5E6, 7.0E6,
+                    2, 20, 40 );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown = true;
+    }
+    BOOST_CHECK( isExceptionThrown );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
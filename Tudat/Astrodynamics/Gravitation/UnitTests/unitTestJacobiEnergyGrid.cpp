@@ -0,0 +1,282 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      Unit test created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "Tudat/Basics/testMacros.h"
+
+#include "Tudat/Astrodynamics/Gravitation/jacobiEnergy.h"
+#include "Tudat/Astrodynamics/Gravitation/jacobiEnergyGrid.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_jacobi_energy_grid )
+
+//! Test whether grid values match direct evaluation of Jacobi energy, for any number of threads.
+BOOST_AUTO_TEST_CASE( testJacobiEnergyGridAgainstDirectEvaluation )
+{
+    using namespace gravitation::circular_restricted_three_body_problem;
+
+    const double massParameter = 0.012150585609624;
+    const Eigen::VectorXd xCoordinates = Eigen::VectorXd::LinSpaced( 23, -1.5, 1.4 );
+    const Eigen::VectorXd yCoordinates = Eigen::VectorXd::LinSpaced( 17, -1.1, 1.3 );
+    const Eigen::VectorXd zCoordinates = Eigen::VectorXd::LinSpaced( 5, -0.3, 0.5 );
+
+    JacobiEnergyGrid singleThreadedGrid( massParameter, xCoordinates, yCoordinates,
+                                         zCoordinates, 1 );
+    JacobiEnergyGrid multiThreadedGrid( massParameter, xCoordinates, yCoordinates,
+                                        zCoordinates, 4 );
+
+    BOOST_CHECK( singleThreadedGrid.getJacobiEnergies( ).matrix( )
+                 == multiThreadedGrid.getJacobiEnergies( ).matrix( ) );
+
+    for ( int k = 0; k < zCoordinates.rows( ); k++ )
+    {
+        for ( int j = 0; j < yCoordinates.rows( ); j++ )
+        {
+            for ( int i = 0; i < xCoordinates.rows( ); i++ )
+            {
+                Eigen::VectorXd state = Eigen::VectorXd::Zero( 6 );
+                state.segment( 0, 3 ) = Eigen::Vector3d(
+                            xCoordinates( i ), yCoordinates( j ), zCoordinates( k ) );
+
+                const double expectedJacobiEnergy = computeJacobiEnergy( massParameter, state );
+                BOOST_CHECK_CLOSE_FRACTION( singleThreadedGrid.getJacobiEnergy( i, j, k ),
+                                            expectedJacobiEnergy,
+                                            1.0E1 * std::numeric_limits< double >::epsilon( ) );
+                BOOST_CHECK_CLOSE_FRACTION(
+                            singleThreadedGrid.getEffectivePotential( i, j, k ),
+                            computeEffectivePotential( massParameter, state.segment( 0, 3 ) ),
+                            1.0E1 * std::numeric_limits< double >::epsilon( ) );
+            }
+        }
+    }
+
+    // Check that slices are stored with x-index along rows.
+    const Eigen::MatrixXd slice = multiThreadedGrid.getJacobiEnergySlice( 3 );
+    BOOST_CHECK_EQUAL( slice.rows( ), xCoordinates.rows( ) );
+    BOOST_CHECK_EQUAL( slice.cols( ), yCoordinates.rows( ) );
+    BOOST_CHECK_EQUAL( slice( 7, 11 ), multiThreadedGrid.getJacobiEnergy( 7, 11, 3 ) );
+
+    // Check that invalid grids are rejected.
+    bool isExceptionThrown = false;
+    try
+    {
+        JacobiEnergyGrid invalidGrid( massParameter, xCoordinates.reverse( ), yCoordinates );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown = true;
+    }
+    BOOST_CHECK( isExceptionThrown );
+}
+
+//! Test zero-velocity curves in Earth-Moon system.
+BOOST_AUTO_TEST_CASE( testZeroVelocityCurves )
+{
+    using namespace gravitation::circular_restricted_three_body_problem;
+
+    const double massParameter = 0.012150585609624;
+    const Eigen::VectorXd coordinates = Eigen::VectorXd::LinSpaced( 401, -2.0, 2.0 );
+    JacobiEnergyGrid jacobiEnergyGrid( massParameter, coordinates, coordinates,
+                                       Eigen::VectorXd::Zero( 1 ), 4 );
+
+    // Above energy of L1, the regions around the Earth and Moon and the outer region are
+    // separated (three curves); between energies of L2 and L1, the regions around the Earth and
+    // Moon are connected (two curves).
+    const double jacobiEnergies[ 2 ] = { 3.3, 3.18 };
+    const unsigned int expectedNumberOfCurves[ 2 ] = { 3, 2 };
+    for ( int test = 0; test < 2; test++ )
+    {
+        const std::vector< Eigen::Matrix2Xd > curves
+                = jacobiEnergyGrid.computeZeroVelocityCurves( jacobiEnergies[ test ] );
+        BOOST_CHECK_EQUAL( curves.size( ), expectedNumberOfCurves[ test ] );
+
+        for ( unsigned int curve = 0; curve < curves.size( ); curve++ )
+        {
+            // Check that curve is closed.
+            BOOST_CHECK( curves[ curve ].col( 0 )
+                         == curves[ curve ].col( curves[ curve ].cols( ) - 1 ) );
+
+            // Check that points lie on zero-velocity curve, up to interpolation error.
+            for ( int i = 0; i < curves[ curve ].cols( ); i++ )
+            {
+                const Eigen::Vector3d position( curves[ curve ]( 0, i ),
+                                                curves[ curve ]( 1, i ), 0.0 );
+                BOOST_CHECK_CLOSE_FRACTION(
+                            2.0 * computeEffectivePotential( massParameter, position ),
+                            jacobiEnergies[ test ], 1.0E-3 );
+            }
+        }
+    }
+}
+
+//! Test zero-velocity surface around Moon.
+BOOST_AUTO_TEST_CASE( testZeroVelocitySurface )
+{
+    using namespace gravitation::circular_restricted_three_body_problem;
+
+    const double massParameter = 0.012150585609624;
+    const double jacobiEnergy = 3.3;
+    const Eigen::VectorXd xCoordinates = Eigen::VectorXd::LinSpaced( 81, 0.8, 1.2 );
+    const Eigen::VectorXd yzCoordinates = Eigen::VectorXd::LinSpaced( 81, -0.2, 0.2 );
+    JacobiEnergyGrid jacobiEnergyGrid( massParameter, xCoordinates, yzCoordinates,
+                                       yzCoordinates, 4 );
+
+    const Eigen::Matrix3Xd triangles = jacobiEnergyGrid.computeZeroVelocitySurface( jacobiEnergy );
+    BOOST_CHECK( triangles.cols( ) > 0 );
+    BOOST_CHECK_EQUAL( triangles.cols( ) % 3, 0 );
+
+    // Check that vertices lie on zero-velocity surface, up to interpolation error.
+    for ( int i = 0; i < triangles.cols( ); i++ )
+    {
+        BOOST_CHECK_CLOSE_FRACTION(
+                    2.0 * computeEffectivePotential( massParameter, triangles.col( i ) ),
+                    jacobiEnergy, 1.0E-3 );
+    }
+
+    // Compute enclosed volume with divergence theorem; normals point into the region around the
+    // Moon, so the volume is negative.
+    double surfaceVolume = 0.0;
+    for ( int i = 0; i < triangles.cols( ); i += 3 )
+    {
+        surfaceVolume += triangles.col( i ).dot(
+                    triangles.col( i + 1 ).cross( triangles.col( i + 2 ) ) ) / 6.0;
+    }
+
+    // Estimate volume by counting grid points in region where motion is possible.
+    const double cellSize = 0.005;
+    const Eigen::ArrayXd jacobiEnergies = jacobiEnergyGrid.getJacobiEnergies( );
+    const int numberOfPointsInside = ( jacobiEnergies > jacobiEnergy ).count( );
+    const double gridVolume = numberOfPointsInside * cellSize * cellSize * cellSize;
+
+    BOOST_CHECK( surfaceVolume < 0.0 );
+    BOOST_CHECK_CLOSE_FRACTION( -surfaceVolume, gridVolume, 5.0E-2 );
+
+    // Check that planar grid is rejected.
+    bool isExceptionThrown = false;
+    try
+    {
+        JacobiEnergyGrid planarGrid( massParameter, xCoordinates, yzCoordinates );
+        planarGrid.computeZeroVelocitySurface( jacobiEnergy );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown = true;
+    }
+    BOOST_CHECK( isExceptionThrown );
+}
+
+//! Test writing of grid to binary file.
+BOOST_AUTO_TEST_CASE( testJacobiEnergyGridBinaryFile )
+{
+    using namespace gravitation::circular_restricted_three_body_problem;
+
+    const double massParameter = 0.012150585609624;
+    const Eigen::VectorXd xCoordinates = Eigen::VectorXd::LinSpaced( 7, -1.5, 1.5 );
+    const Eigen::VectorXd yCoordinates = Eigen::VectorXd::LinSpaced( 5, -1.0, 1.0 );
+    const Eigen::VectorXd zCoordinates = Eigen::VectorXd::LinSpaced( 3, -0.5, 0.5 );
+    JacobiEnergyGrid jacobiEnergyGrid( massParameter, xCoordinates, yCoordinates,
+                                       zCoordinates );
+
+    const boost::filesystem::path temporaryDirectory
+            = boost::filesystem::temp_directory_path( ) / boost::filesystem::unique_path( );
+    boost::filesystem::create_directories( temporaryDirectory );
+    const std::string fileName = ( temporaryDirectory / "jacobiEnergyGrid.bin" ).string( );
+    jacobiEnergyGrid.writeToBinaryFile( fileName );
+
+    // Read file back, and check contents.
+    std::ifstream gridFile( fileName.c_str( ), std::ios::in | std::ios::binary );
+    char fileIdentifier[ 8 ];
+    boost::uint32_t byteOrderMarker, fileFormatVersion;
+    boost::int32_t numberOfPoints[ 4 ];
+    double readMassParameter;
+    gridFile.read( fileIdentifier, 8 );
+    gridFile.read( reinterpret_cast< char* >( &byteOrderMarker ), sizeof( byteOrderMarker ) );
+    gridFile.read( reinterpret_cast< char* >( &fileFormatVersion ),
+                   sizeof( fileFormatVersion ) );
+    gridFile.read( reinterpret_cast< char* >( numberOfPoints ), sizeof( numberOfPoints ) );
+    gridFile.read( reinterpret_cast< char* >( &readMassParameter ), sizeof( double ) );
+
+    BOOST_CHECK_EQUAL( std::string( fileIdentifier, 8 ), "TUDATJEG" );
+    BOOST_CHECK_EQUAL( byteOrderMarker, 0x01020304u );
+    BOOST_CHECK_EQUAL( fileFormatVersion, 1u );
+    BOOST_CHECK_EQUAL( numberOfPoints[ 0 ], 7 );
+    BOOST_CHECK_EQUAL( numberOfPoints[ 1 ], 5 );
+    BOOST_CHECK_EQUAL( numberOfPoints[ 2 ], 3 );
+    BOOST_CHECK_EQUAL( readMassParameter, massParameter );
+
+    Eigen::VectorXd readXCoordinates( 7 ), readYCoordinates( 5 ), readZCoordinates( 3 );
+    Eigen::ArrayXd readJacobiEnergies( 7 * 5 * 3 );
+    gridFile.read( reinterpret_cast< char* >( readXCoordinates.data( ) ), 7 * sizeof( double ) );
+    gridFile.read( reinterpret_cast< char* >( readYCoordinates.data( ) ), 5 * sizeof( double ) );
+    gridFile.read( reinterpret_cast< char* >( readZCoordinates.data( ) ), 3 * sizeof( double ) );
+    gridFile.read( reinterpret_cast< char* >( readJacobiEnergies.data( ) ),
+                   readJacobiEnergies.size( ) * sizeof( double ) );
+    BOOST_CHECK( !gridFile.fail( ) );
+    BOOST_CHECK( gridFile.peek( ) == std::char_traits< char >::eof( ) );
+    gridFile.close( );
+
+    BOOST_CHECK( readXCoordinates == xCoordinates );
+    BOOST_CHECK( readYCoordinates == yCoordinates );
+    BOOST_CHECK( readZCoordinates == zCoordinates );
+    BOOST_CHECK( readJacobiEnergies.matrix( ) == jacobiEnergyGrid.getJacobiEnergies( ).matrix( ) );
+    BOOST_CHECK_EQUAL( readJacobiEnergies( 3 + 7 * ( 2 + 5 * 1 ) ),
+                       jacobiEnergyGrid.getJacobiEnergy( 3, 2, 1 ) );
+
+    boost::filesystem::remove_all( temporaryDirectory );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,230 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      Unit test created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/lambda/lambda.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Basics/testMacros.h"
+
+#include "Tudat/Astrodynamics/Gravitation/masconGravityModel.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Create set of mascons uniformly distributed in a sphere, with random gravitational parameters.
+void createTestMascons( const int numberOfMascons, const double radius,
+                        const double minimumGravitationalParameter,
+                        const double maximumGravitationalParameter,
+                        Eigen::VectorXd& gravitationalParameters, Eigen::Matrix3Xd& positions )
+{
+    boost::mt19937 randomNumberGenerator( 42 );
+    boost::random::uniform_real_distribution< > coordinateDistribution( -radius, radius );
+    boost::random::uniform_real_distribution< > gravitationalParameterDistribution(
+                minimumGravitationalParameter, maximumGravitationalParameter );
+
+    gravitationalParameters.resize( numberOfMascons );
+    positions.resize( 3, numberOfMascons );
+    for ( int i = 0; i < numberOfMascons; i++ )
+    {
+        do
+        {
+            positions.col( i ) = Eigen::Vector3d(
+                        coordinateDistribution( randomNumberGenerator ),
+                        coordinateDistribution( randomNumberGenerator ),
+                        coordinateDistribution( randomNumberGenerator ) );
+        }
+        while ( positions.col( i ).norm( ) > radius );
+        gravitationalParameters( i ) = gravitationalParameterDistribution( randomNumberGenerator );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE( test_mascon_gravity_model )
+
+//! Test exact evaluation of mascon gravity field against direct summation.
+BOOST_AUTO_TEST_CASE( testMasconGravityFieldExactSummation )
+{
+    Eigen::VectorXd gravitationalParameters;
+    Eigen::Matrix3Xd positions;
+    createTestMascons( 1000, 1.7E6, 1.0E9, 9.0E9, gravitationalParameters, positions );
+
+    gravitation::MasconGravityField masconGravityField( gravitationalParameters, positions, 0.0 );
+    BOOST_CHECK_EQUAL( masconGravityField.getNumberOfMascons( ), 1000 );
+    BOOST_CHECK_CLOSE_FRACTION( masconGravityField.getGravitationalParameter( ),
+                                gravitationalParameters.sum( ), 1.0E-15 );
+
+    const Eigen::Vector3d position( 1.2E6, -0.9E6, 1.1E6 );
+    double expectedPotential = 0.0;
+    Eigen::Vector3d expectedGradient = Eigen::Vector3d::Zero( );
+    for ( int i = 0; i < positions.cols( ); i++ )
+    {
+        const Eigen::Vector3d relativePosition = positions.col( i ) - position;
+        expectedPotential += gravitationalParameters( i ) / relativePosition.norm( );
+        expectedGradient += gravitationalParameters( i ) * relativePosition
+                / std::pow( relativePosition.norm( ), 3.0 );
+    }
+
+    double computedPotential;
+    Eigen::Vector3d computedGradient;
+    masconGravityField.computeGravityFieldTerms( position, computedPotential, computedGradient );
+
+    BOOST_CHECK_CLOSE_FRACTION( computedPotential, expectedPotential, 1.0E-13 );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( computedGradient, expectedGradient, 1.0E-12 );
+    BOOST_CHECK_EQUAL( masconGravityField.getNumberOfExactlySummedMascons( ), 1000 );
+}
+
+//! Test accuracy of tree evaluation of mascon gravity field at different altitudes.
+BOOST_AUTO_TEST_CASE( testMasconGravityFieldTreeAccuracy )
+{
+    const double radius = 1.7E6;
+    Eigen::VectorXd gravitationalParameters;
+    Eigen::Matrix3Xd positions;
+    createTestMascons( 5000, radius, 1.0E9, 1.9E9, gravitationalParameters, positions );
+
+    gravitation::MasconGravityField exactGravityField( gravitationalParameters, positions, 0.0 );
+    gravitation::MasconGravityField treeGravityField( gravitationalParameters, positions, 0.3 );
+    BOOST_CHECK( treeGravityField.getNumberOfTreeNodes( ) > 1 );
+
+    const Eigen::Vector3d direction = Eigen::Vector3d( 0.3, -0.5, 0.8 ).normalized( );
+    const double altitudes[ 3 ] = { 1.0E4, 1.0E5, 1.0E6 };
+    for ( int i = 0; i < 3; i++ )
+    {
+        const Eigen::Vector3d position = ( radius + altitudes[ i ] ) * direction;
+        const Eigen::Vector3d exactGradient = exactGravityField.getGradientOfPotential( position );
+        const Eigen::Vector3d treeGradient = treeGravityField.getGradientOfPotential( position );
+
+        BOOST_CHECK_SMALL( ( treeGradient - exactGradient ).norm( ),
+                           1.0E-3 * exactGradient.norm( ) );
+        BOOST_CHECK( treeGravityField.getNumberOfExactlySummedMascons( ) < 5000 );
+    }
+
+    // Check that only the expansion of the root node is used far away from the mascons.
+    const Eigen::Vector3d farPosition = 20.0 * radius * direction;
+    const Eigen::Vector3d exactGradient = exactGravityField.getGradientOfPotential( farPosition );
+    const Eigen::Vector3d treeGradient = treeGravityField.getGradientOfPotential( farPosition );
+    BOOST_CHECK_EQUAL( treeGravityField.getNumberOfExactlySummedMascons( ), 0 );
+    BOOST_CHECK_SMALL( ( treeGradient - exactGradient ).norm( ),
+                       1.0E-5 * exactGradient.norm( ) );
+}
+
+//! Test multipole expansion for mascons with mixed-sign gravitational parameters.
+BOOST_AUTO_TEST_CASE( testMasconGravityFieldMixedSignExpansion )
+{
+    const double radius = 1.7E6;
+    Eigen::VectorXd gravitationalParameters;
+    Eigen::Matrix3Xd positions;
+    createTestMascons( 500, radius, -1.0E9, 1.0E9, gravitationalParameters, positions );
+
+    gravitation::MasconGravityField exactGravityField( gravitationalParameters, positions, 0.0 );
+    gravitation::MasconGravityField treeGravityField( gravitationalParameters, positions, 0.3 );
+
+    // Evaluate at position where only the expansion of the root node is used.
+    const Eigen::Vector3d position = 10.0 * radius * Eigen::Vector3d( 0.6, 0.0, -0.8 );
+    const Eigen::Vector3d treeGradient = treeGravityField.getGradientOfPotential( position );
+    BOOST_CHECK_EQUAL( treeGravityField.getNumberOfExactlySummedMascons( ), 0 );
+
+    const Eigen::Vector3d exactGradient = exactGravityField.getGradientOfPotential( position );
+    BOOST_CHECK_SMALL( ( treeGradient - exactGradient ).norm( ),
+                       1.0E-2 * exactGradient.norm( ) );
+
+    // Check gradient of expansion against central difference of potential of expansion.
+    const double stepSize = 1.0E2;
+    Eigen::Vector3d numericalGradient;
+    for ( int j = 0; j < 3; j++ )
+    {
+        const Eigen::Vector3d perturbation = stepSize * Eigen::Vector3d::Unit( j );
+        numericalGradient( j ) = ( treeGravityField.getGravitationalPotential(
+                                       position + perturbation )
+                                   - treeGravityField.getGravitationalPotential(
+                                       position - perturbation ) ) / ( 2.0 * stepSize );
+    }
+    BOOST_CHECK_SMALL( ( treeGradient - numericalGradient ).norm( ),
+                       1.0E-8 * treeGradient.norm( ) );
+}
+
+//! Test mascon gravitational acceleration model.
+BOOST_AUTO_TEST_CASE( testMasconGravitationalAccelerationModel )
+{
+    Eigen::VectorXd gravitationalParameters;
+    Eigen::Matrix3Xd positions;
+    createTestMascons( 2000, 1.7E6, 1.0E9, 3.0E9, gravitationalParameters, positions );
+    gravitation::MasconGravityFieldPointer masconGravityField
+            = boost::make_shared< gravitation::MasconGravityField >(
+                gravitationalParameters, positions );
+
+    const Eigen::Vector3d bodyPosition( 3.0E8, -1.0E8, 2.0E7 );
+    const Eigen::Vector3d spacecraftPosition
+            = bodyPosition + Eigen::Vector3d( 1.0E6, 1.5E6, 0.2E6 );
+    gravitation::MasconGravitationalAccelerationModel accelerationModel(
+                boost::lambda::constant( spacecraftPosition ), masconGravityField,
+                boost::lambda::constant( bodyPosition ) );
+
+    const Eigen::Vector3d computedAcceleration = accelerationModel.getAcceleration( );
+    const Eigen::Vector3d expectedAcceleration = masconGravityField->getGradientOfPotential(
+                spacecraftPosition - bodyPosition );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( computedAcceleration, expectedAcceleration, 1.0E-15 );
+}
+
+//! Test whether inconsistent mascon input is rejected.
+BOOST_AUTO_TEST_CASE( testMasconGravityFieldErrorHandling )
+{
+    bool isExceptionThrown = false;
+    try
+    {
+        gravitation::MasconGravityField masconGravityField( Eigen::VectorXd::Ones( 3 ),
+                                                            Eigen::Matrix3Xd::Zero( 3, 4 ) );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown = true;
+    }
+    BOOST_CHECK( isExceptionThrown );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,236 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      Unit test created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Basics/testMacros.h"
+
+#include "Tudat/Astrodynamics/Gravitation/centralGravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/nBodyGravityModel.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Get positions of a cloud of test bodies, concentrated towards the center.
+Eigen::Matrix3Xd getTestCloudPositions( const int numberOfBodies )
+{
+    Eigen::Matrix3Xd positions( 3, numberOfBodies );
+    for ( int i = 0; i < numberOfBodies; i++ )
+    {
+        const double radius = 1.0E3 * std::pow( 0.5 + 0.5 * std::sin( 12.9898 * i ), 2.0 ) + 1.0;
+        const double latitude = 1.5 * std::sin( 78.233 * i );
+        const double longitude = 2.399963 * i;
+        positions.col( i ) = radius * Eigen::Vector3d( std::cos( latitude ) * std::cos( longitude ),
+                                                       std::cos( latitude ) * std::sin( longitude ),
+                                                       std::sin( latitude ) );
+    }
+    return positions;
+}
+
+//! Get gravitational parameters of test bodies.
+Eigen::VectorXd getTestGravitationalParameters( const int numberOfBodies )
+{
+    Eigen::VectorXd gravitationalParameters( numberOfBodies );
+    for ( int i = 0; i < numberOfBodies; i++ )
+    {
+        gravitationalParameters( i ) = 1.0 + 0.5 * std::cos( 3.7 * i );
+    }
+    return gravitationalParameters;
+}
+
+BOOST_AUTO_TEST_SUITE( test_n_body_gravity_model )
+
+//! Test whether direct summation reproduces pair-wise central gravity accelerations.
+BOOST_AUTO_TEST_CASE( testDirectSummationAgainstPairwiseAccelerations )
+{
+    using namespace gravitation;
+
+    const int numberOfBodies = 37;
+    const Eigen::Matrix3Xd positions = getTestCloudPositions( numberOfBodies );
+    const Eigen::VectorXd gravitationalParameters
+            = getTestGravitationalParameters( numberOfBodies );
+
+    NBodyGravitationalAccelerationEngine engine( gravitationalParameters );
+    const Eigen::Matrix3Xd computedAccelerations = engine.computeAccelerations( positions );
+    BOOST_CHECK_EQUAL( engine.getNumberOfTreeNodes( ), 0 );
+
+    for ( int i = 0; i < numberOfBodies; i++ )
+    {
+        Eigen::Vector3d expectedAcceleration = Eigen::Vector3d::Zero( );
+        for ( int j = 0; j < numberOfBodies; j++ )
+        {
+            if ( j != i )
+            {
+                expectedAcceleration += computeGravitationalAcceleration(
+                            positions.col( i ), gravitationalParameters( j ), positions.col( j ) );
+            }
+        }
+
+        const Eigen::Vector3d computedAcceleration = computedAccelerations.col( i );
+        TUDAT_CHECK_MATRIX_BASE( computedAcceleration, expectedAcceleration )
+                BOOST_CHECK_SMALL( computedAcceleration.coeff( row, col )
+                                   - expectedAcceleration.coeff( row, col ),
+                                   1.0E-13 * expectedAcceleration.norm( ) );
+    }
+}
+
+//! Test whether softening length is correctly applied.
+BOOST_AUTO_TEST_CASE( testDirectSummationWithSoftening )
+{
+    using namespace gravitation;
+
+    const double gravitationalParameter = 2.0;
+    const double softeningLength = 3.0;
+    Eigen::Matrix3Xd positions = Eigen::Matrix3Xd::Zero( 3, 2 );
+    positions( 0, 1 ) = 4.0;
+
+    NBodyGravitationalAccelerationEngine engine(
+                Eigen::VectorXd::Constant( 2, gravitationalParameter ), directSummation, 0.5,
+                softeningLength );
+    const Eigen::Matrix3Xd accelerations = engine.computeAccelerations( positions );
+
+    // Softened distance is 5.
+    BOOST_CHECK_CLOSE_FRACTION( accelerations( 0, 0 ), gravitationalParameter * 4.0 / 125.0,
+                                std::numeric_limits< double >::epsilon( ) );
+    BOOST_CHECK_CLOSE_FRACTION( accelerations( 0, 1 ), -gravitationalParameter * 4.0 / 125.0,
+                                std::numeric_limits< double >::epsilon( ) );
+    BOOST_CHECK_EQUAL( accelerations.block( 1, 0, 2, 2 ).norm( ), 0.0 );
+}
+
+//! Test whether Barnes-Hut method converges to direct summation.
+BOOST_AUTO_TEST_CASE( testBarnesHutAgainstDirectSummation )
+{
+    using namespace gravitation;
+
+    const int numberOfBodies = 3000;
+    const Eigen::Matrix3Xd positions = getTestCloudPositions( numberOfBodies );
+    const Eigen::VectorXd gravitationalParameters
+            = getTestGravitationalParameters( numberOfBodies );
+
+    NBodyGravitationalAccelerationEngine directEngine( gravitationalParameters );
+    const Eigen::Matrix3Xd directAccelerations = directEngine.computeAccelerations( positions );
+
+    // Check that opening angle of zero reproduces direct summation.
+    NBodyGravitationalAccelerationEngine exactTreeEngine(
+                gravitationalParameters, barnesHutTree, 0.0 );
+    const Eigen::Matrix3Xd exactTreeAccelerations
+            = exactTreeEngine.computeAccelerations( positions );
+    BOOST_CHECK_GT( exactTreeEngine.getNumberOfTreeNodes( ), numberOfBodies / 8 );
+    for ( int i = 0; i < numberOfBodies; i++ )
+    {
+        BOOST_CHECK_SMALL( ( exactTreeAccelerations.col( i ) - directAccelerations.col( i ) )
+                           .norm( ), 1.0E-12 * directAccelerations.col( i ).norm( ) );
+    }
+
+    // Check that error decreases with opening angle, and is small for typical opening angle.
+    const double openingAngles[ 2 ] = { 0.8, 0.4 };
+    const double maximumRmsErrors[ 2 ] = { 3.0E-2, 5.0E-3 };
+    double previousRmsError = 0.0;
+    for ( int k = 0; k < 2; k++ )
+    {
+        NBodyGravitationalAccelerationEngine treeEngine(
+                    gravitationalParameters, barnesHutTree, openingAngles[ k ] );
+        const Eigen::Matrix3Xd treeAccelerations = treeEngine.computeAccelerations( positions );
+
+        double sumOfSquaredErrors = 0.0;
+        for ( int i = 0; i < numberOfBodies; i++ )
+        {
+            sumOfSquaredErrors += ( treeAccelerations.col( i ) - directAccelerations.col( i ) )
+                    .squaredNorm( ) / directAccelerations.col( i ).squaredNorm( );
+        }
+        const double rmsError = std::sqrt( sumOfSquaredErrors / numberOfBodies );
+        BOOST_CHECK_LT( rmsError, maximumRmsErrors[ k ] );
+        if ( k > 0 )
+        {
+            BOOST_CHECK_LT( rmsError, previousRmsError );
+        }
+        previousRmsError = rmsError;
+    }
+}
+
+//! Test whether multi-threaded evaluation gives identical results.
+BOOST_AUTO_TEST_CASE( testMultiThreadedEvaluation )
+{
+    using namespace gravitation;
+
+    const int numberOfBodies = 501;
+    const Eigen::Matrix3Xd positions = getTestCloudPositions( numberOfBodies );
+    const Eigen::VectorXd gravitationalParameters
+            = getTestGravitationalParameters( numberOfBodies );
+
+    const NBodyAccelerationMethod methods[ 2 ] = { directSummation, barnesHutTree };
+    for ( int k = 0; k < 2; k++ )
+    {
+        NBodyGravitationalAccelerationEngine singleThreadedEngine(
+                    gravitationalParameters, methods[ k ], 0.5, 0.0, 1 );
+        NBodyGravitationalAccelerationEngine multiThreadedEngine(
+                    gravitationalParameters, methods[ k ], 0.5, 0.0, 4 );
+        BOOST_CHECK( singleThreadedEngine.computeAccelerations( positions )
+                     == multiThreadedEngine.computeAccelerations( positions ) );
+    }
+}
+
+//! Test whether invalid input is rejected.
+BOOST_AUTO_TEST_CASE( testInvalidInput )
+{
+    using namespace gravitation;
+
+    NBodyGravitationalAccelerationEngine engine( Eigen::VectorXd::Ones( 3 ) );
+    bool isExceptionThrown = false;
+    try
+    {
+        engine.computeAccelerations( Eigen::Matrix3Xd::Zero( 3, 4 ) );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown = true;
+    }
+    BOOST_CHECK( isExceptionThrown );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
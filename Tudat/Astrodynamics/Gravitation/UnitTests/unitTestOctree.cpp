@@ -0,0 +1,132 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      Unit test created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <vector>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/Gravitation/octree.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_octree )
+
+//! Test whether octree partitions points into nested nodes.
+BOOST_AUTO_TEST_CASE( testOctreePartitioning )
+{
+    using namespace gravitation;
+
+    // Create clustered set of points, including coincident points.
+    const int numberOfPoints = 500;
+    Eigen::Matrix3Xd positions( 3, numberOfPoints );
+    for ( int i = 0; i < numberOfPoints; i++ )
+    {
+        const double scale = ( i % 5 == 0 ) ? 1.0 : 0.01;
+        positions.col( i ) = scale * Eigen::Vector3d( std::sin( 12.9898 * i ),
+                                                      std::sin( 78.233 * i ),
+                                                      std::sin( 37.719 * i ) );
+    }
+    positions.rightCols( 20 ).colwise( ) = Eigen::Vector3d( 0.5, 0.5, 0.5 );
+
+    const int maximumNumberOfPointsPerLeaf = 8;
+    Octree octree( maximumNumberOfPointsPerLeaf, 20 );
+
+    // Build tree twice, to test that rebuilding replaces the tree.
+    octree.build( positions );
+    const int numberOfNodes = octree.getNumberOfNodes( );
+    octree.build( positions );
+    BOOST_CHECK_EQUAL( octree.getNumberOfNodes( ), numberOfNodes );
+
+    // Check that sorted indices are a permutation of the point indices.
+    const std::vector< int >& sortedIndices = octree.getSortedIndices( );
+    std::vector< int > numberOfOccurrences( numberOfPoints, 0 );
+    for ( unsigned int k = 0; k < sortedIndices.size( ); k++ )
+    {
+        numberOfOccurrences[ sortedIndices[ k ] ]++;
+    }
+    for ( int i = 0; i < numberOfPoints; i++ )
+    {
+        BOOST_CHECK_EQUAL( numberOfOccurrences[ i ], 1 );
+    }
+
+    // Check root node, and that each node contains its points and is partitioned by its children.
+    BOOST_CHECK_EQUAL( octree.getNode( 0 ).firstIndex, 0 );
+    BOOST_CHECK_EQUAL( octree.getNode( 0 ).endIndex, numberOfPoints );
+    int numberOfPointsInLeaves = 0;
+    for ( int nodeIndex = 0; nodeIndex < octree.getNumberOfNodes( ); nodeIndex++ )
+    {
+        const Octree::Node& node = octree.getNode( nodeIndex );
+        for ( int k = node.firstIndex; k < node.endIndex; k++ )
+        {
+            BOOST_CHECK_LE( ( positions.col( sortedIndices[ k ] ) - node.center )
+                            .cwiseAbs( ).maxCoeff( ), node.halfWidth );
+        }
+
+        if ( node.isLeaf )
+        {
+            numberOfPointsInLeaves += node.endIndex - node.firstIndex;
+            continue;
+        }
+
+        // Children are created after their parent, and cover its range contiguously.
+        int childStart = node.firstIndex;
+        for ( int octant = 0; octant < 8; octant++ )
+        {
+            if ( node.children[ octant ] >= 0 )
+            {
+                const Octree::Node& child = octree.getNode( node.children[ octant ] );
+                BOOST_CHECK_GT( node.children[ octant ], nodeIndex );
+                BOOST_CHECK_EQUAL( child.firstIndex, childStart );
+                BOOST_CHECK_EQUAL( child.halfWidth, 0.5 * node.halfWidth );
+                childStart = child.endIndex;
+            }
+        }
+        BOOST_CHECK_EQUAL( childStart, node.endIndex );
+        BOOST_CHECK_GT( node.endIndex - node.firstIndex, maximumNumberOfPointsPerLeaf );
+    }
+    BOOST_CHECK_EQUAL( numberOfPointsInLeaves, numberOfPoints );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
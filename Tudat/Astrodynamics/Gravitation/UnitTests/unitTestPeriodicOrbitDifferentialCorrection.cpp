@@ -0,0 +1,459 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      Unit test created.
+ *
+ *    References
+ *      Howell, K.C. Three-dimensional, periodic, 'halo' orbits, Celestial Mechanics, 32(1),
+ *          53-71, 1984.
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <vector>
+
+#include <boost/make_shared.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/Eigenvalues>
+
+#include "Tudat/Basics/testMacros.h"
+#include "Tudat/Mathematics/RootFinders/newtonRaphson.h"
+
+#include "Tudat/Astrodynamics/Gravitation/librationPoint.h"
+#include "Tudat/Astrodynamics/Gravitation/periodicOrbitDifferentialCorrection.h"
+#include "Tudat/Astrodynamics/Gravitation/stateDerivativeCircularRestrictedThreeBodyProblem.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+namespace crtbp = gravitation::circular_restricted_three_body_problem;
+
+//! Mass parameter of Earth-Moon system used in tests.
+const double earthMoonMassParameter = 0.012150585609624;
+
+//! Compute initial state and period of small planar Lyapunov orbit about L1.
+/*!
+ * Computes the initial state and period of a small planar Lyapunov orbit about the L1 libration
+ * point of the Earth-Moon system, from the oscillatory in-plane mode of the linearized dynamics.
+ */
+void computeLinearLyapunovOrbit( const double xAmplitude, basic_mathematics::Vector6d& initialState,
+                                 double& period )
+{
+    crtbp::LibrationPoint librationPointL1(
+                earthMoonMassParameter,
+                boost::make_shared< root_finders::NewtonRaphson >( 1.0e-14, 1000 ) );
+    librationPointL1.computeLocationOfLibrationPoint( crtbp::LibrationPoint::l1 );
+    const Eigen::Vector3d locationOfL1 = librationPointL1.getLocationOfLagrangeLibrationPoint( );
+
+    // Select in-plane part of linearized dynamics (x, y, vx, vy).
+    const basic_mathematics::Matrix6d jacobian
+            = crtbp::computeStateDerivativeJacobian( earthMoonMassParameter, locationOfL1 );
+    const int inPlaneIndices[ 4 ] = { 0, 1, 3, 4 };
+    Eigen::Matrix4d inPlaneJacobian;
+    for ( int i = 0; i < 4; i++ )
+    {
+        for ( int j = 0; j < 4; j++ )
+        {
+            inPlaneJacobian( i, j ) = jacobian( inPlaneIndices[ i ], inPlaneIndices[ j ] );
+        }
+    }
+
+    // Find oscillatory mode, and scale eigenvector such that its x-component is real.
+    Eigen::EigenSolver< Eigen::Matrix4d > eigenSolver( inPlaneJacobian );
+    int oscillatoryMode = 0;
+    for ( int i = 0; i < 4; i++ )
+    {
+        if ( eigenSolver.eigenvalues( )( i ).imag( ) > 0.0 )
+        {
+            oscillatoryMode = i;
+        }
+    }
+    const Eigen::Vector4cd eigenvector = eigenSolver.eigenvectors( ).col( oscillatoryMode )
+            / eigenSolver.eigenvectors( )( 0, oscillatoryMode );
+
+    initialState = basic_mathematics::Vector6d::Zero( );
+    initialState.segment( 0, 3 ) = locationOfL1;
+    for ( int i = 0; i < 4; i++ )
+    {
+        initialState( inPlaneIndices[ i ] ) += xAmplitude * eigenvector( i ).real( );
+    }
+    period = 2.0 * M_PI / eigenSolver.eigenvalues( )( oscillatoryMode ).imag( );
+}
+
+//! Compute maximum difference between initial state and state after one period.
+double computePeriodicityError( const crtbp::PeriodicOrbitPointer periodicOrbit )
+{
+    const crtbp::StateAndStateTransitionMatrix finalStateAndStateTransitionMatrix
+            = crtbp::propagateStateAndStateTransitionMatrix(
+                earthMoonMassParameter, periodicOrbit->getInitialState( ),
+                periodicOrbit->getPeriod( ) );
+    return ( finalStateAndStateTransitionMatrix.col( 0 ) - periodicOrbit->getInitialState( ) )
+            .cwiseAbs( ).maxCoeff( );
+}
+
+//! Get corrected halo orbit about L1 used in tests.
+crtbp::PeriodicOrbitPointer getTestHaloOrbit( )
+{
+    // Set initial guess of halo orbit (Howell, 1984), with amplitude fixed by z-position.
+    basic_mathematics::Vector6d initialStateGuess;
+    initialStateGuess << 0.8234, 0.0, 0.0224, 0.0, 0.1343, 0.0;
+
+    crtbp::SymmetricPeriodicOrbitCorrector corrector( earthMoonMassParameter );
+    return corrector.correctPeriodicOrbit( initialStateGuess, 2.743,
+                                           crtbp::zCartesianPositionIndex );
+}
+
+BOOST_AUTO_TEST_SUITE( test_periodic_orbit_differential_correction )
+
+//! Test analytic Jacobian and state derivative against existing CRTBP state derivative.
+BOOST_AUTO_TEST_CASE( testStateDerivativeJacobian )
+{
+    crtbp::StateDerivativeCircularRestrictedThreeBodyProblem stateDerivativeModel(
+                earthMoonMassParameter );
+
+    basic_mathematics::Vector6d state;
+    state << 0.85, 0.04, 0.03, -0.02, 0.17, 0.01;
+
+    // Check state derivative in first column of combined derivative.
+    crtbp::StateAndStateTransitionMatrix stateAndStateTransitionMatrix;
+    stateAndStateTransitionMatrix.col( 0 ) = state;
+    stateAndStateTransitionMatrix.block( 0, 1, 6, 6 ) = basic_mathematics::Matrix6d::Identity( );
+    const crtbp::StateAndStateTransitionMatrix derivative
+            = crtbp::computeStateAndStateTransitionMatrixDerivative(
+                earthMoonMassParameter, 0.0, stateAndStateTransitionMatrix );
+    const basic_mathematics::Vector6d expectedStateDerivative
+            = stateDerivativeModel.computeStateDerivative( 0.0, state );
+    const basic_mathematics::Vector6d computedStateDerivative = derivative.col( 0 );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( computedStateDerivative, expectedStateDerivative, 1.0E-13 );
+
+    // Check Jacobian against central differences of state derivative.
+    const basic_mathematics::Matrix6d computedJacobian = crtbp::computeStateDerivativeJacobian(
+                earthMoonMassParameter, state.segment( 0, 3 ) );
+    const double stateStep = 1.0E-6;
+    for ( int j = 0; j < 6; j++ )
+    {
+        basic_mathematics::Vector6d perturbedState = state;
+        perturbedState( j ) += stateStep;
+        const basic_mathematics::Vector6d upperStateDerivative
+                = stateDerivativeModel.computeStateDerivative( 0.0, perturbedState );
+        perturbedState( j ) -= 2.0 * stateStep;
+        const basic_mathematics::Vector6d lowerStateDerivative
+                = stateDerivativeModel.computeStateDerivative( 0.0, perturbedState );
+
+        for ( int i = 0; i < 6; i++ )
+        {
+            BOOST_CHECK_SMALL( computedJacobian( i, j ) - ( upperStateDerivative( i )
+                                                            - lowerStateDerivative( i ) )
+                               / ( 2.0 * stateStep ), 1.0E-7 );
+        }
+    }
+
+    // For the identity state transition matrix, its derivative equals the Jacobian.
+    const basic_mathematics::Matrix6d stateTransitionMatrixDerivative
+            = derivative.block( 0, 1, 6, 6 );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( stateTransitionMatrixDerivative, computedJacobian,
+                                       1.0E-15 );
+}
+
+//! Test propagated state transition matrix against finite differences.
+BOOST_AUTO_TEST_CASE( testStateTransitionMatrixPropagation )
+{
+    basic_mathematics::Vector6d initialState;
+    initialState << 0.82, 0.0, 0.03, 0.0, 0.14, 0.0;
+    const double propagationTime = 1.2;
+
+    const crtbp::StateAndStateTransitionMatrix finalStateAndStateTransitionMatrix
+            = crtbp::propagateStateAndStateTransitionMatrix(
+                earthMoonMassParameter, initialState, propagationTime );
+
+    const double stateStep = 1.0E-6;
+    for ( int j = 0; j < 6; j++ )
+    {
+        basic_mathematics::Vector6d perturbedState = initialState;
+        perturbedState( j ) += stateStep;
+        const basic_mathematics::Vector6d upperFinalState
+                = crtbp::propagateStateAndStateTransitionMatrix(
+                    earthMoonMassParameter, perturbedState, propagationTime ).col( 0 );
+        perturbedState( j ) -= 2.0 * stateStep;
+        const basic_mathematics::Vector6d lowerFinalState
+                = crtbp::propagateStateAndStateTransitionMatrix(
+                    earthMoonMassParameter, perturbedState, propagationTime ).col( 0 );
+
+        for ( int i = 0; i < 6; i++ )
+        {
+            BOOST_CHECK_SMALL( finalStateAndStateTransitionMatrix( i, 1 + j )
+                               - ( upperFinalState( i ) - lowerFinalState( i ) )
+                               / ( 2.0 * stateStep ), 1.0E-5 );
+        }
+    }
+}
+
+//! Test correction of planar Lyapunov orbit from linear approximation.
+BOOST_AUTO_TEST_CASE( testLyapunovOrbitCorrection )
+{
+    basic_mathematics::Vector6d initialStateGuess;
+    double periodGuess;
+    computeLinearLyapunovOrbit( -0.01, initialStateGuess, periodGuess );
+
+    crtbp::SymmetricPeriodicOrbitCorrector corrector( earthMoonMassParameter );
+    const crtbp::PeriodicOrbitPointer lyapunovOrbit = corrector.correctPeriodicOrbit(
+                initialStateGuess, periodGuess, crtbp::xCartesianPositionIndex );
+
+    // Check that orbit is planar, has fixed x-position and is periodic.
+    BOOST_CHECK_EQUAL( lyapunovOrbit->getInitialState( )( crtbp::xCartesianPositionIndex ),
+                       initialStateGuess( crtbp::xCartesianPositionIndex ) );
+    BOOST_CHECK_EQUAL( lyapunovOrbit->getInitialState( )( crtbp::zCartesianPositionIndex ), 0.0 );
+    BOOST_CHECK_SMALL( computePeriodicityError( lyapunovOrbit ), 1.0E-9 );
+    BOOST_CHECK_CLOSE_FRACTION( lyapunovOrbit->getPeriod( ), periodGuess, 1.0E-2 );
+
+    // Check monodromy matrix, computed with symmetry, against propagation over full period.
+    const basic_mathematics::Matrix6d expectedMonodromyMatrix
+            = crtbp::propagateStateAndStateTransitionMatrix(
+                earthMoonMassParameter, lyapunovOrbit->getInitialState( ),
+                lyapunovOrbit->getPeriod( ) ).block( 0, 1, 6, 6 );
+    const basic_mathematics::Matrix6d computedMonodromyMatrix
+            = lyapunovOrbit->getMonodromyMatrix( );
+    BOOST_CHECK_SMALL( ( computedMonodromyMatrix - expectedMonodromyMatrix ).cwiseAbs( )
+                       .maxCoeff( ), 1.0E-6 * expectedMonodromyMatrix.cwiseAbs( ).maxCoeff( ) );
+
+    // Check that monodromy matrix is symplectic (unit determinant) and that the orbit is
+    // unstable, as all L1 Lyapunov orbits.
+    BOOST_CHECK_CLOSE_FRACTION( computedMonodromyMatrix.determinant( ), 1.0, 1.0E-6 );
+    BOOST_CHECK_GT( lyapunovOrbit->getStabilityIndex( ), 100.0 );
+}
+
+//! Test correction of halo orbit.
+BOOST_AUTO_TEST_CASE( testHaloOrbitCorrection )
+{
+    const crtbp::PeriodicOrbitPointer haloOrbit = getTestHaloOrbit( );
+
+    BOOST_CHECK_EQUAL( haloOrbit->getInitialState( )( crtbp::zCartesianPositionIndex ), 0.0224 );
+    BOOST_CHECK_SMALL( computePeriodicityError( haloOrbit ), 1.0E-8 );
+    BOOST_CHECK_CLOSE_FRACTION( haloOrbit->getPeriod( ), 2.743, 1.0E-2 );
+
+    const basic_mathematics::Matrix6d expectedMonodromyMatrix
+            = crtbp::propagateStateAndStateTransitionMatrix(
+                earthMoonMassParameter, haloOrbit->getInitialState( ),
+                haloOrbit->getPeriod( ) ).block( 0, 1, 6, 6 );
+    const basic_mathematics::Matrix6d computedMonodromyMatrix = haloOrbit->getMonodromyMatrix( );
+    BOOST_CHECK_SMALL( ( computedMonodromyMatrix - expectedMonodromyMatrix ).cwiseAbs( )
+                       .maxCoeff( ), 1.0E-6 * expectedMonodromyMatrix.cwiseAbs( ).maxCoeff( ) );
+}
+
+//! Test correction of vertical Lyapunov orbit, which is symmetric w.r.t. x-axis.
+BOOST_AUTO_TEST_CASE( testVerticalOrbitCorrection )
+{
+    crtbp::LibrationPoint librationPointL1(
+                earthMoonMassParameter,
+                boost::make_shared< root_finders::NewtonRaphson >( 1.0e-14, 1000 ) );
+    librationPointL1.computeLocationOfLibrationPoint( crtbp::LibrationPoint::l1 );
+    const Eigen::Vector3d locationOfL1 = librationPointL1.getLocationOfLagrangeLibrationPoint( );
+
+    // Set initial guess from linear out-of-plane oscillation.
+    const basic_mathematics::Matrix6d jacobian
+            = crtbp::computeStateDerivativeJacobian( earthMoonMassParameter, locationOfL1 );
+    const double outOfPlaneFrequency = std::sqrt( -jacobian( crtbp::zAccelerationIndex,
+                                                             crtbp::zCartesianPositionIndex ) );
+    basic_mathematics::Vector6d initialStateGuess = basic_mathematics::Vector6d::Zero( );
+    initialStateGuess( crtbp::xCartesianPositionIndex ) = locationOfL1.x( );
+    initialStateGuess( crtbp::zCartesianVelocityIndex ) = 0.02 * outOfPlaneFrequency;
+
+    crtbp::SymmetricPeriodicOrbitCorrector corrector( earthMoonMassParameter,
+                                                      crtbp::xAxisSymmetry );
+    const crtbp::PeriodicOrbitPointer verticalOrbit = corrector.correctPeriodicOrbit(
+                initialStateGuess, 2.0 * M_PI / outOfPlaneFrequency,
+                crtbp::zCartesianVelocityIndex );
+
+    BOOST_CHECK_SMALL( computePeriodicityError( verticalOrbit ), 1.0E-9 );
+    BOOST_CHECK_EQUAL( verticalOrbit->getInitialState( )( crtbp::zCartesianPositionIndex ), 0.0 );
+    BOOST_CHECK_EQUAL( verticalOrbit->getInitialState( )( crtbp::zCartesianVelocityIndex ),
+                       initialStateGuess( crtbp::zCartesianVelocityIndex ) );
+
+    const basic_mathematics::Matrix6d expectedMonodromyMatrix
+            = crtbp::propagateStateAndStateTransitionMatrix(
+                earthMoonMassParameter, verticalOrbit->getInitialState( ),
+                verticalOrbit->getPeriod( ) ).block( 0, 1, 6, 6 );
+    const basic_mathematics::Matrix6d computedMonodromyMatrix
+            = verticalOrbit->getMonodromyMatrix( );
+    BOOST_CHECK_SMALL( ( computedMonodromyMatrix - expectedMonodromyMatrix ).cwiseAbs( )
+                       .maxCoeff( ), 1.0E-6 * expectedMonodromyMatrix.cwiseAbs( ).maxCoeff( ) );
+}
+
+//! Test multiple-shooting correction of perturbed halo orbit.
+BOOST_AUTO_TEST_CASE( testMultipleShootingCorrection )
+{
+    const crtbp::PeriodicOrbitPointer haloOrbit = getTestHaloOrbit( );
+
+    // Sample patch points along halo orbit, and perturb them.
+    const int numberOfPatchPoints = 6;
+    Eigen::Matrix< double, 6, Eigen::Dynamic > patchPointStates( 6, numberOfPatchPoints );
+    Eigen::VectorXd segmentDurations = Eigen::VectorXd::Constant(
+                numberOfPatchPoints, haloOrbit->getPeriod( ) / numberOfPatchPoints );
+    patchPointStates.col( 0 ) = haloOrbit->getInitialState( );
+    for ( int i = 1; i < numberOfPatchPoints; i++ )
+    {
+        patchPointStates.col( i ) = crtbp::propagateStateAndStateTransitionMatrix(
+                    earthMoonMassParameter, patchPointStates.col( i - 1 ),
+                    segmentDurations( i - 1 ) ).col( 0 );
+    }
+    for ( int i = 0; i < numberOfPatchPoints; i++ )
+    {
+        patchPointStates.col( i ) += 1.0E-4 * basic_mathematics::Vector6d(
+                    std::sin( 1.0 + i ), std::cos( 2.0 + i ), std::sin( 3.0 * i ),
+                    std::cos( 4.0 * i ), std::sin( 5.0 + i ), std::cos( 6.0 + i ) );
+        segmentDurations( i ) *= 1.0 + 1.0E-3 * std::sin( 7.0 * i );
+    }
+
+    const crtbp::PeriodicOrbitPointer correctedOrbit
+            = crtbp::correctPeriodicOrbitWithMultipleShooting(
+                earthMoonMassParameter, patchPointStates, segmentDurations, 1.0E-11, 20, 3 );
+
+    // Check continuity of corrected segments.
+    for ( int i = 0; i < numberOfPatchPoints; i++ )
+    {
+        const basic_mathematics::Vector6d finalState
+                = crtbp::propagateStateAndStateTransitionMatrix(
+                    earthMoonMassParameter, patchPointStates.col( i ),
+                    segmentDurations( i ) ).col( 0 );
+        BOOST_CHECK_SMALL( ( finalState - patchPointStates.col( ( i + 1 ) % numberOfPatchPoints ) )
+                           .cwiseAbs( ).maxCoeff( ), 1.0E-10 );
+    }
+
+    // Check that corrected orbit is close to original halo orbit, and that its monodromy matrix
+    // is consistent with propagation over a full period.
+    BOOST_CHECK_CLOSE_FRACTION( correctedOrbit->getPeriod( ), haloOrbit->getPeriod( ), 1.0E-2 );
+    BOOST_CHECK_CLOSE_FRACTION( correctedOrbit->getJacobiEnergy( ), haloOrbit->getJacobiEnergy( ),
+                                1.0E-3 );
+    const basic_mathematics::Matrix6d expectedMonodromyMatrix
+            = crtbp::propagateStateAndStateTransitionMatrix(
+                earthMoonMassParameter, correctedOrbit->getInitialState( ),
+                correctedOrbit->getPeriod( ) ).block( 0, 1, 6, 6 );
+    const basic_mathematics::Matrix6d computedMonodromyMatrix
+            = correctedOrbit->getMonodromyMatrix( );
+    BOOST_CHECK_SMALL( ( computedMonodromyMatrix - expectedMonodromyMatrix ).cwiseAbs( )
+                       .maxCoeff( ), 1.0E-6 * expectedMonodromyMatrix.cwiseAbs( ).maxCoeff( ) );
+}
+
+//! Test natural-parameter continuation of Lyapunov family, sequentially and in parallel.
+BOOST_AUTO_TEST_CASE( testNaturalParameterContinuation )
+{
+    basic_mathematics::Vector6d initialStateGuess;
+    double periodGuess;
+    computeLinearLyapunovOrbit( -0.005, initialStateGuess, periodGuess );
+
+    const int numberOfOrbits = 25;
+    const double parameterStepSize = -0.002;
+    std::vector< std::vector< crtbp::PeriodicOrbitPointer > > families;
+    for ( int numberOfThreads = 1; numberOfThreads <= 4; numberOfThreads += 3 )
+    {
+        crtbp::SymmetricPeriodicOrbitCorrector corrector(
+                    earthMoonMassParameter, crtbp::xzPlaneSymmetry, 1.0E-11, 20,
+                    numberOfThreads );
+        const crtbp::PeriodicOrbitPointer firstOrbit = corrector.correctPeriodicOrbit(
+                    initialStateGuess, periodGuess, crtbp::xCartesianPositionIndex );
+        families.push_back( corrector.computeFamilyWithNaturalParameterContinuation(
+                                firstOrbit, crtbp::xCartesianPositionIndex, parameterStepSize,
+                                numberOfOrbits ) );
+    }
+
+    for ( unsigned int j = 0; j < families.size( ); j++ )
+    {
+        BOOST_CHECK_EQUAL( families[ j ].size( ), numberOfOrbits );
+    }
+
+    for ( int i = 0; i < numberOfOrbits; i++ )
+    {
+        // Check continuation parameter and periodicity of each member.
+        BOOST_CHECK_CLOSE_FRACTION(
+                    families[ 0 ][ i ]->getInitialState( )( crtbp::xCartesianPositionIndex ),
+                    initialStateGuess( crtbp::xCartesianPositionIndex ) + i * parameterStepSize,
+                    1.0E-12 );
+        BOOST_CHECK_SMALL( computePeriodicityError( families[ 0 ][ i ] ), 1.0E-8 );
+
+        // Check that parallel continuation gives the same family.
+        const basic_mathematics::Vector6d sequentialInitialState
+                = families[ 0 ][ i ]->getInitialState( );
+        const basic_mathematics::Vector6d parallelInitialState
+                = families[ 1 ][ i ]->getInitialState( );
+        BOOST_CHECK_SMALL( ( sequentialInitialState - parallelInitialState ).cwiseAbs( )
+                           .maxCoeff( ), 1.0E-9 );
+
+        // Check that Jacobi energy decreases with amplitude.
+        if ( i > 0 )
+        {
+            BOOST_CHECK_LT( families[ 0 ][ i ]->getJacobiEnergy( ),
+                            families[ 0 ][ i - 1 ]->getJacobiEnergy( ) );
+        }
+    }
+}
+
+//! Test pseudo-arclength continuation of halo family.
+BOOST_AUTO_TEST_CASE( testPseudoArclengthContinuation )
+{
+    const crtbp::PeriodicOrbitPointer haloOrbit = getTestHaloOrbit( );
+
+    crtbp::SymmetricPeriodicOrbitCorrector corrector(
+                earthMoonMassParameter, crtbp::xzPlaneSymmetry, 1.0E-11, 20, 4 );
+    const int numberOfOrbits = 40;
+    const double arclengthStepSize = 0.005;
+    const std::vector< crtbp::PeriodicOrbitPointer > family
+            = corrector.computeFamilyWithPseudoArclengthContinuation(
+                haloOrbit, arclengthStepSize, numberOfOrbits );
+
+    BOOST_CHECK_EQUAL( family.size( ), numberOfOrbits );
+    for ( int i = 1; i < numberOfOrbits; i++ )
+    {
+        BOOST_CHECK_SMALL( computePeriodicityError( family[ i ] ), 1.0E-7 );
+
+        // Check that members are distinct, but not farther apart than the batch size allows.
+        const basic_mathematics::Vector6d stateDifference
+                = family[ i ]->getInitialState( ) - family[ i - 1 ]->getInitialState( );
+        BOOST_CHECK_GT( stateDifference.norm( ), 0.1 * arclengthStepSize );
+        BOOST_CHECK_LT( stateDifference.norm( ), 4.0 * arclengthStepSize );
+
+        // Halo orbits of the northern family remain out-of-plane, with x-position increasing
+        // towards the Moon.
+        BOOST_CHECK_GT( family[ i ]->getInitialState( )( crtbp::zCartesianPositionIndex ), 0.0 );
+        BOOST_CHECK_GT( family[ i ]->getInitialState( )( crtbp::xCartesianPositionIndex ),
+                        family[ i - 1 ]->getInitialState( )( crtbp::xCartesianPositionIndex ) );
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,315 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      Unit test created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+
+#include <boost/lambda/lambda.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Basics/testMacros.h"
+
+#include "Tudat/Astrodynamics/Gravitation/pinesSphericalHarmonicsGravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModel.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Get set of geodesy-normalized test coefficients, with a realistic decay with degree.
+void getTestCoefficients( const int numberOfDegrees, Eigen::MatrixXd& cosineCoefficients,
+                          Eigen::MatrixXd& sineCoefficients )
+{
+    cosineCoefficients = Eigen::MatrixXd::Zero( numberOfDegrees, numberOfDegrees );
+    sineCoefficients = Eigen::MatrixXd::Zero( numberOfDegrees, numberOfDegrees );
+    cosineCoefficients( 0, 0 ) = 1.0;
+    cosineCoefficients( 2, 0 ) = -4.841651437908150e-4;
+    for ( int degree = 2; degree < numberOfDegrees; degree++ )
+    {
+        for ( int order = 0; order <= degree; order++ )
+        {
+            if ( degree > 2 || order > 0 )
+            {
+                cosineCoefficients( degree, order ) = 1.0E-6 / ( degree * degree )
+                        * std::sin( 1.3 * degree + 0.7 * order );
+            }
+            if ( order > 0 )
+            {
+                sineCoefficients( degree, order ) = 1.0E-6 / ( degree * degree )
+                        * std::cos( 0.9 * degree + 1.1 * order );
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE( test_PinesSphericalHarmonicsGravity )
+
+//! Test Pines formulation against spherical coordinates formulation.
+BOOST_AUTO_TEST_CASE( testPinesAccelerationAgainstSphericalCoordinatesFormulation )
+{
+    using namespace gravitation;
+
+    const double gravitationalParameter = 3.986004418e14;
+    const double planetaryRadius = 6378137.0;
+
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    getTestCoefficients( 31, cosineCoefficients, sineCoefficients );
+
+    PinesSphericalHarmonicsWorkspace pinesWorkspace( 30, 30 );
+    basic_mathematics::SphericalHarmonicsWorkspace sphericalHarmonicsWorkspace( 30, 30 );
+
+    // Test at range of positions, including positions close to the poles.
+    for ( int i = 0; i < 20; i++ )
+    {
+        const double latitude = -1.57 + 3.14 * static_cast< double >( i ) / 19.0;
+        const double longitude = 0.37 * static_cast< double >( i ) - 3.0;
+        const double radius = planetaryRadius + 2.0E5 + 1.0E5 * static_cast< double >( i );
+        const Eigen::Vector3d position
+                = radius * Eigen::Vector3d( std::cos( latitude ) * std::cos( longitude ),
+                                            std::cos( latitude ) * std::sin( longitude ),
+                                            std::sin( latitude ) );
+
+        const Eigen::Vector3d pinesAcceleration
+                = computePinesGeodesyNormalizedGravitationalAccelerationSum(
+                    position, gravitationalParameter, planetaryRadius, cosineCoefficients,
+                    sineCoefficients, pinesWorkspace );
+        const Eigen::Vector3d expectedAcceleration
+                = computeGeodesyNormalizedGravitationalAccelerationSum(
+                    position, gravitationalParameter, planetaryRadius, cosineCoefficients,
+                    sineCoefficients, sphericalHarmonicsWorkspace );
+
+        TUDAT_CHECK_MATRIX_BASE( pinesAcceleration, expectedAcceleration )
+                BOOST_CHECK_SMALL( pinesAcceleration.coeff( row, col )
+                                   - expectedAcceleration.coeff( row, col ),
+                                   1.0E-13 * expectedAcceleration.norm( ) );
+    }
+}
+
+//! Test Pines formulation on the polar axis, where spherical coordinates are singular.
+BOOST_AUTO_TEST_CASE( testPinesAccelerationAtPole )
+{
+    using namespace gravitation;
+
+    const double gravitationalParameter = 3.986004418e14;
+    const double planetaryRadius = 6378137.0;
+
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    getTestCoefficients( 21, cosineCoefficients, sineCoefficients );
+
+    PinesSphericalHarmonicsWorkspace pinesWorkspace( 20, 20 );
+    basic_mathematics::SphericalHarmonicsWorkspace sphericalHarmonicsWorkspace( 20, 20 );
+
+    for ( int sign = -1; sign <= 1; sign += 2 )
+    {
+        // Compute acceleration exactly on polar axis.
+        const Eigen::Vector3d polarPosition( 0.0, 0.0, sign * 7.0E6 );
+        const Eigen::Vector3d pinesAcceleration
+                = computePinesGeodesyNormalizedGravitationalAccelerationSum(
+                    polarPosition, gravitationalParameter, planetaryRadius, cosineCoefficients,
+                    sineCoefficients, pinesWorkspace );
+
+        // Compare with spherical coordinates formulation slightly off the polar axis (the 1 mm
+        // offset results in an acceleration difference of order 1.0E-9 m/s^2).
+        const Eigen::Vector3d nearPolarPosition
+                = polarPosition + Eigen::Vector3d( 1.0E-3, 0.0, 0.0 );
+        const Eigen::Vector3d expectedAcceleration
+                = computeGeodesyNormalizedGravitationalAccelerationSum(
+                    nearPolarPosition, gravitationalParameter, planetaryRadius,
+                    cosineCoefficients, sineCoefficients, sphericalHarmonicsWorkspace );
+
+        BOOST_CHECK( pinesAcceleration.allFinite( ) );
+        TUDAT_CHECK_MATRIX_BASE( pinesAcceleration, expectedAcceleration )
+                BOOST_CHECK_SMALL( pinesAcceleration.coeff( row, col )
+                                   - expectedAcceleration.coeff( row, col ),
+                                   1.0E-9 * expectedAcceleration.norm( ) );
+    }
+}
+
+//! Test gravity gradient tensor against numerical derivative of acceleration.
+BOOST_AUTO_TEST_CASE( testPinesGravityGradientTensor )
+{
+    using namespace gravitation;
+
+    const double gravitationalParameter = 3.986004418e14;
+    const double planetaryRadius = 6378137.0;
+
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    getTestCoefficients( 16, cosineCoefficients, sineCoefficients );
+
+    PinesSphericalHarmonicsWorkspace pinesWorkspace( 15, 15 );
+
+    std::vector< Eigen::Vector3d > positions;
+    positions.push_back( Eigen::Vector3d( 4.2E6, -5.3E6, 3.1E6 ) );
+    positions.push_back( Eigen::Vector3d( -1.2E6, 2.3E6, -6.9E6 ) );
+    positions.push_back( Eigen::Vector3d( 0.0, 0.0, 7.1E6 ) );
+
+    for ( unsigned int i = 0; i < positions.size( ); i++ )
+    {
+        Eigen::Vector3d acceleration;
+        const Eigen::Matrix3d gravityGradientTensor
+                = computePinesGeodesyNormalizedGravityGradientTensor(
+                    positions[ i ], gravitationalParameter, planetaryRadius, cosineCoefficients,
+                    sineCoefficients, pinesWorkspace, acceleration );
+
+        // Check acceleration that is returned by reference.
+        const Eigen::Vector3d expectedAcceleration
+                = computePinesGeodesyNormalizedGravitationalAccelerationSum(
+                    positions[ i ], gravitationalParameter, planetaryRadius, cosineCoefficients,
+                    sineCoefficients, pinesWorkspace );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( acceleration, expectedAcceleration, 1.0E-14 );
+
+        // Compute gravity gradient tensor with central differences.
+        const double positionPerturbation = 10.0;
+        Eigen::Matrix3d numericalGravityGradientTensor;
+        for ( int j = 0; j < 3; j++ )
+        {
+            Eigen::Vector3d perturbedPosition = positions[ i ];
+            perturbedPosition( j ) += positionPerturbation;
+            const Eigen::Vector3d upperAcceleration
+                    = computePinesGeodesyNormalizedGravitationalAccelerationSum(
+                        perturbedPosition, gravitationalParameter, planetaryRadius,
+                        cosineCoefficients, sineCoefficients, pinesWorkspace );
+            perturbedPosition( j ) -= 2.0 * positionPerturbation;
+            const Eigen::Vector3d lowerAcceleration
+                    = computePinesGeodesyNormalizedGravitationalAccelerationSum(
+                        perturbedPosition, gravitationalParameter, planetaryRadius,
+                        cosineCoefficients, sineCoefficients, pinesWorkspace );
+            numericalGravityGradientTensor.col( j )
+                    = ( upperAcceleration - lowerAcceleration ) / ( 2.0 * positionPerturbation );
+        }
+
+        TUDAT_CHECK_MATRIX_BASE( gravityGradientTensor, numericalGravityGradientTensor )
+                BOOST_CHECK_SMALL( gravityGradientTensor.coeff( row, col )
+                                   - numericalGravityGradientTensor.coeff( row, col ),
+                                   1.0E-8 * gravityGradientTensor.norm( ) );
+
+        // Check symmetry and Laplace's equation (trace equal to zero).
+        for ( int row = 0; row < 3; row++ )
+        {
+            for ( int col = 0; col < row; col++ )
+            {
+                BOOST_CHECK_SMALL( gravityGradientTensor( row, col )
+                                   - gravityGradientTensor( col, row ),
+                                   1.0E-14 * gravityGradientTensor.norm( ) );
+            }
+        }
+        BOOST_CHECK_SMALL( gravityGradientTensor.trace( ),
+                           1.0E-14 * gravityGradientTensor.norm( ) );
+    }
+}
+
+//! Test selection of Pines formulation in acceleration model class.
+BOOST_AUTO_TEST_CASE( testPinesFormulationInAccelerationModel )
+{
+    using namespace gravitation;
+
+    const double gravitationalParameter = 3.986004418e14;
+    const double planetaryRadius = 6378137.0;
+    const Eigen::Vector3d position( 7.0E6, 1.0E5, -3.0E5 );
+
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    getTestCoefficients( 11, cosineCoefficients, sineCoefficients );
+
+    SphericalHarmonicsGravitationalAccelerationModelXd sphericalCoordinatesModel(
+                boost::lambda::constant( position ), gravitationalParameter, planetaryRadius,
+                cosineCoefficients, sineCoefficients );
+    SphericalHarmonicsGravitationalAccelerationModelXd pinesModel(
+                boost::lambda::constant( position ), gravitationalParameter, planetaryRadius,
+                cosineCoefficients, sineCoefficients,
+                boost::lambda::constant( Eigen::Vector3d::Zero( ) ), pinesFormulation );
+
+    BOOST_CHECK_EQUAL( pinesModel.getFormulation( ), pinesFormulation );
+    BOOST_CHECK_EQUAL( sphericalCoordinatesModel.getFormulation( ),
+                       sphericalCoordinatesFormulation );
+
+    const Eigen::Vector3d pinesAcceleration = pinesModel.getAcceleration( );
+    const Eigen::Vector3d expectedAcceleration = sphericalCoordinatesModel.getAcceleration( );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( pinesAcceleration, expectedAcceleration, 1.0E-13 );
+
+    // Check that gravity gradient tensor is identical for both models.
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( pinesModel.getGravityGradientTensor( ),
+                                       sphericalCoordinatesModel.getGravityGradientTensor( ),
+                                       1.0E-15 );
+}
+
+//! Test whether invalid input is rejected.
+BOOST_AUTO_TEST_CASE( testPinesInputChecks )
+{
+    using namespace gravitation;
+
+    Eigen::MatrixXd cosineCoefficients, sineCoefficients;
+    getTestCoefficients( 11, cosineCoefficients, sineCoefficients );
+
+    // Test workspace that is too small for coefficients.
+    PinesSphericalHarmonicsWorkspace smallWorkspace( 5, 5 );
+    bool isExceptionThrown = false;
+    try
+    {
+        computePinesGeodesyNormalizedGravitationalAccelerationSum(
+                    Eigen::Vector3d( 7.0E6, 0.0, 0.0 ), 3.986004418e14, 6378137.0,
+                    cosineCoefficients, sineCoefficients, smallWorkspace );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown = true;
+    }
+    BOOST_CHECK( isExceptionThrown );
+
+    // Test position inside reference sphere.
+    PinesSphericalHarmonicsWorkspace pinesWorkspace( 10, 10 );
+    isExceptionThrown = false;
+    try
+    {
+        computePinesGeodesyNormalizedGravitationalAccelerationSum(
+                    Eigen::Vector3d( 6.0E6, 0.0, 0.0 ), 3.986004418e14, 6378137.0,
+                    cosineCoefficients, sineCoefficients, pinesWorkspace );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown = true;
+    }
+    BOOST_CHECK( isExceptionThrown );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,295 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      Unit test created.
+ *      261018                      Added tests of facet orientation check and base class potential.
+ *
+ *    References
+ *      Werner, R.A., Scheeres, D.J. Exterior gravitation of a polyhedron derived and compared with
+ *          harmonic and mascon gravitation representations of asteroid 4769 Castalia, Celestial
+ *          Mechanics and Dynamical Astronomy, 65, 313-344, 1997.
+ *
+ *    Notes
+ *      The potential at the center of a homogeneous cube with edges of length s is equal to
+ *      G rho s^2 ( 3 ln( 2 + sqrt( 3 ) ) - pi / 2 ).
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Basics/testMacros.h"
+
+#include "Tudat/Astrodynamics/Gravitation/polyhedronGravityField.h"
+#include "Tudat/InputOutput/basicInputOutput.h"
+#include "Tudat/InputOutput/polyhedronShapeFileReader.h"
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Get path of test shape file, containing cube with edges of 2 (km).
+std::string getTestShapeFilePath( )
+{
+    return input_output::getTudatRootPath( ) + "/InputOutput/UnitTests/testPolyhedronShape.obj";
+}
+
+//! Create polyhedron gravity field of test cube, with edges of 2 km.
+gravitation::PolyhedronGravityField createTestCubeGravityField(
+        const double gravitationalParameter, const int numberOfThreads = 1 )
+{
+    Eigen::Matrix3Xd vertices;
+    Eigen::Matrix3Xi facets;
+    input_output::readPolyhedronShapeFile( getTestShapeFilePath( ), vertices, facets, 1.0E3 );
+    return gravitation::PolyhedronGravityField( gravitationalParameter, vertices, facets,
+                                                numberOfThreads );
+}
+
+BOOST_AUTO_TEST_SUITE( test_polyhedron_gravity_field )
+
+//! Test polyhedron properties and potential at center of cube.
+BOOST_AUTO_TEST_CASE( testPolyhedronGravityFieldOfCube )
+{
+    const double gravitationalParameter = 5.0E4;
+    const double edgeLength = 2.0E3;
+    gravitation::PolyhedronGravityField cubeGravityField
+            = createTestCubeGravityField( gravitationalParameter );
+
+    // Check shape properties (quadrilateral faces are split in two triangles).
+    BOOST_CHECK_EQUAL( cubeGravityField.getNumberOfVertices( ), 8 );
+    BOOST_CHECK_EQUAL( cubeGravityField.getNumberOfFacets( ), 12 );
+    BOOST_CHECK_EQUAL( cubeGravityField.getNumberOfEdges( ), 18 );
+    BOOST_CHECK_CLOSE_FRACTION( cubeGravityField.getVolume( ), 8.0E9, 1.0E-15 );
+
+    // Check potential and its gradient at center of cube against analytical values.
+    const double gravitationalConstantTimesDensity = gravitationalParameter / 8.0E9;
+    const double expectedPotential = gravitationalConstantTimesDensity * edgeLength * edgeLength
+            * ( 3.0 * std::log( 2.0 + std::sqrt( 3.0 ) ) - mathematical_constants::PI / 2.0 );
+
+    double potential, laplacianOfPotential;
+    Eigen::Vector3d gradientOfPotential;
+    cubeGravityField.computeGravityFieldTerms( Eigen::Vector3d::Zero( ), potential,
+                                               gradientOfPotential, laplacianOfPotential );
+
+    BOOST_CHECK_CLOSE_FRACTION( potential, expectedPotential, 1.0E-14 );
+    BOOST_CHECK_CLOSE_FRACTION( cubeGravityField.getGravitationalPotential(
+                                    Eigen::Vector3d::Zero( ) ), expectedPotential, 1.0E-14 );
+
+    // Check that potential is also obtained through base class.
+    gravitation::GravityFieldModel& baseGravityField = cubeGravityField;
+    BOOST_CHECK_CLOSE_FRACTION( baseGravityField.getGravitationalPotential(
+                                    Eigen::Vector3d::Zero( ) ), expectedPotential, 1.0E-14 );
+    BOOST_CHECK_SMALL( gradientOfPotential.norm( ),
+                       1.0E-14 * gravitationalConstantTimesDensity * edgeLength );
+    BOOST_CHECK_CLOSE_FRACTION( laplacianOfPotential,
+                                -4.0 * mathematical_constants::PI
+                                * gravitationalConstantTimesDensity, 1.0E-14 );
+}
+
+//! Test Laplacian of potential inside and outside polyhedron.
+BOOST_AUTO_TEST_CASE( testPolyhedronGravityFieldLaplacian )
+{
+    const double gravitationalParameter = 5.0E4;
+    gravitation::PolyhedronGravityField cubeGravityField
+            = createTestCubeGravityField( gravitationalParameter );
+    const double expectedInteriorLaplacian
+            = -4.0 * mathematical_constants::PI * gravitationalParameter / 8.0E9;
+
+    Eigen::Matrix3Xd interiorPositions( 3, 3 );
+    interiorPositions << 300.0, -999.0, 0.0,
+            -400.0, 250.0, 990.0,
+            500.0, 10.0, -990.0;
+    for ( int i = 0; i < interiorPositions.cols( ); i++ )
+    {
+        BOOST_CHECK_CLOSE_FRACTION(
+                    cubeGravityField.getLaplacianOfPotential( interiorPositions.col( i ) ),
+                    expectedInteriorLaplacian, 1.0E-12 );
+    }
+
+    Eigen::Matrix3Xd exteriorPositions( 3, 3 );
+    exteriorPositions << 1001.0, -1500.0, 4.0E4,
+            -400.0, 1500.0, -2.0E4,
+            500.0, 1500.0, 1.0E4;
+    for ( int i = 0; i < exteriorPositions.cols( ); i++ )
+    {
+        BOOST_CHECK_SMALL( cubeGravityField.getLaplacianOfPotential( exteriorPositions.col( i ) ),
+                           1.0E-12 * std::fabs( expectedInteriorLaplacian ) );
+    }
+}
+
+//! Test gravitational acceleration far from polyhedron against point-mass acceleration.
+BOOST_AUTO_TEST_CASE( testPolyhedronGravityFieldFarField )
+{
+    const double gravitationalParameter = 5.0E4;
+    gravitation::PolyhedronGravityField cubeGravityField
+            = createTestCubeGravityField( gravitationalParameter );
+
+    // Degree two and three terms of cube vanish, so that the relative deviation from a point mass
+    // scales with the fourth power of the ratio of size and distance.
+    const Eigen::Vector3d position( 6.0E4, -7.0E4, 3.0E4 );
+    const Eigen::Vector3d expectedGradient
+            = -gravitationalParameter * position / std::pow( position.norm( ), 3.0 );
+    const Eigen::Vector3d computedGradient = cubeGravityField.getGradientOfPotential( position );
+
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( computedGradient, expectedGradient, 1.0E-8 );
+    BOOST_CHECK_CLOSE_FRACTION( cubeGravityField.getGravitationalPotential( position ),
+                                gravitationalParameter / position.norm( ), 1.0E-8 );
+}
+
+//! Test gradient of potential against numerical derivative of potential.
+BOOST_AUTO_TEST_CASE( testPolyhedronGravityFieldGradient )
+{
+    gravitation::PolyhedronGravityField cubeGravityField = createTestCubeGravityField( 5.0E4 );
+
+    Eigen::Matrix3Xd positions( 3, 4 );
+    positions << 1500.0, 300.0, -2500.0, 1200.0,
+            300.0, -400.0, 700.0, 1100.0,
+            -200.0, 500.0, 3000.0, 1050.0;
+    const double stepSize = 0.1;
+
+    for ( int i = 0; i < positions.cols( ); i++ )
+    {
+        const Eigen::Vector3d computedGradient
+                = cubeGravityField.getGradientOfPotential( positions.col( i ) );
+
+        // Compute central difference of potential along each axis.
+        Eigen::Vector3d numericalGradient;
+        for ( int j = 0; j < 3; j++ )
+        {
+            const Eigen::Vector3d perturbation = stepSize * Eigen::Vector3d::Unit( j );
+            numericalGradient( j ) = ( cubeGravityField.getGravitationalPotential(
+                                           positions.col( i ) + perturbation )
+                                       - cubeGravityField.getGravitationalPotential(
+                                           positions.col( i ) - perturbation ) )
+                    / ( 2.0 * stepSize );
+        }
+
+        for ( int j = 0; j < 3; j++ )
+        {
+            BOOST_CHECK_SMALL( computedGradient( j ) - numericalGradient( j ),
+                               1.0E-7 * computedGradient.norm( ) );
+        }
+    }
+}
+
+//! Test whether threading and facet orientation do not influence results.
+BOOST_AUTO_TEST_CASE( testPolyhedronGravityFieldThreadsAndOrientation )
+{
+    const double gravitationalParameter = 5.0E4;
+    gravitation::PolyhedronGravityField singleThreadGravityField
+            = createTestCubeGravityField( gravitationalParameter );
+    gravitation::PolyhedronGravityField multiThreadGravityField
+            = createTestCubeGravityField( gravitationalParameter, 3 );
+
+    // Create gravity field from clockwise facets.
+    Eigen::Matrix3Xd vertices;
+    Eigen::Matrix3Xi facets;
+    input_output::readPolyhedronShapeFile( getTestShapeFilePath( ), vertices, facets, 1.0E3 );
+    facets.row( 0 ).swap( facets.row( 1 ) );
+    gravitation::PolyhedronGravityField reorientedGravityField(
+                gravitationalParameter, vertices, facets );
+    BOOST_CHECK_CLOSE_FRACTION( reorientedGravityField.getVolume( ), 8.0E9, 1.0E-15 );
+
+    const Eigen::Vector3d position( 1700.0, -900.0, 1300.0 );
+    const Eigen::Vector3d expectedGradient
+            = singleThreadGravityField.getGradientOfPotential( position );
+
+    const Eigen::Vector3d multiThreadGradient
+            = multiThreadGravityField.getGradientOfPotential( position );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( multiThreadGradient, expectedGradient, 1.0E-13 );
+    BOOST_CHECK_CLOSE_FRACTION( multiThreadGravityField.getGravitationalPotential( position ),
+                                singleThreadGravityField.getGravitationalPotential( position ),
+                                1.0E-13 );
+
+    const Eigen::Vector3d reorientedGradient
+            = reorientedGravityField.getGradientOfPotential( position );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( reorientedGradient, expectedGradient, 1.0E-13 );
+}
+
+//! Test whether open or inconsistently oriented polyhedron and missing shape file are rejected.
+BOOST_AUTO_TEST_CASE( testPolyhedronGravityFieldErrorHandling )
+{
+    Eigen::Matrix3Xd vertices;
+    Eigen::Matrix3Xi facets;
+    input_output::readPolyhedronShapeFile( getTestShapeFilePath( ), vertices, facets );
+
+    // Remove last facet, so that polyhedron is no longer closed.
+    const Eigen::Matrix3Xi openFacets = facets.leftCols( facets.cols( ) - 1 );
+    bool isExceptionThrown = false;
+    try
+    {
+        gravitation::PolyhedronGravityField openGravityField( 1.0, vertices, openFacets );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown = true;
+    }
+    BOOST_CHECK( isExceptionThrown );
+
+    // Reverse orientation of single facet, so that facets are not oriented consistently.
+    Eigen::Matrix3Xi inconsistentFacets = facets;
+    std::swap( inconsistentFacets( 1, 0 ), inconsistentFacets( 2, 0 ) );
+    isExceptionThrown = false;
+    try
+    {
+        gravitation::PolyhedronGravityField inconsistentGravityField(
+                    1.0, vertices, inconsistentFacets );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown = true;
+    }
+    BOOST_CHECK( isExceptionThrown );
+
+    isExceptionThrown = false;
+    try
+    {
+        input_output::readPolyhedronShapeFile(
+                    input_output::getTudatRootPath( ) + "/InputOutput/UnitTests/nonExistent.obj",
+                    vertices, facets );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown = true;
+    }
+    BOOST_CHECK( isExceptionThrown );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
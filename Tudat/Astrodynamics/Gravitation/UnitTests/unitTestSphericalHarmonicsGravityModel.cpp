@@ -26,6 +26,8 @@
  *      YYMMDD    Author            Comment
  *      121017    E. Dekens         Created file.
  *      121022    K. Kumar          Added unit test for wrapper class.
+ *      261018                      Added unit test for altitude-adaptive truncation.
+ *      261018                      Added unit test for evaluation on polar axis.
  *
  *    References
  *      Mathworks. gravitysphericalharmonic, Implement spherical harmonic representation of
@@ -311,6 +313,173 @@ BOOST_AUTO_TEST_CASE( test_SphericalHarmonicsGravitationalAccelerationWrapperCla
     TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedAcceleration, acceleration, 1.0e-15 );
 }
 
+// Check altitude-adaptive truncation of the expansion, for a synthetic field up to degree 40.
+BOOST_AUTO_TEST_CASE( test_SphericalHarmonicsGravitationalAccelerationAdaptiveTruncation )
+{
+    // Short-cuts.
+    using namespace gravitation;
+
+    const double gravitationalParameter = 3.986004418e14;
+    const double planetaryRadius = 6378137.0;
+    const int maximumDegree = 40;
+
+    // Define synthetic geodesy-normalized coefficients, following Kaula's rule of thumb.
+    Eigen::MatrixXd cosineCoefficients = Eigen::MatrixXd::Zero( maximumDegree + 1,
+                                                                maximumDegree + 1 );
+    Eigen::MatrixXd sineCoefficients = Eigen::MatrixXd::Zero( maximumDegree + 1,
+                                                              maximumDegree + 1 );
+    cosineCoefficients( 0, 0 ) = 1.0;
+    for ( int degree = 2; degree <= maximumDegree; degree++ )
+    {
+        for ( int order = 0; order <= degree; order++ )
+        {
+            cosineCoefficients( degree, order ) = 1.0e-5 / ( degree * degree )
+                    * std::sin( 1.3 * degree + 2.1 * order );
+            if ( order > 0 )
+            {
+                sineCoefficients( degree, order ) = 1.0e-5 / ( degree * degree )
+                        * std::cos( 0.7 * degree + 1.7 * order );
+            }
+        }
+    }
+
+    const double truncationTolerance = 1.0e-9;
+
+    // Check truncation at GEO altitude and in LEO, for both formulations.
+    const Eigen::Vector3d geostationaryPosition( 3.0e7, -2.2e7, 1.9e7 );
+    const Eigen::Vector3d lowEarthOrbitPosition( 4.1e6, 3.2e6, -4.2e6 );
+    for ( int formulationIndex = 0; formulationIndex < 2; formulationIndex++ )
+    {
+        const SphericalHarmonicsFormulation formulation
+                = static_cast< SphericalHarmonicsFormulation >( formulationIndex );
+
+        SphericalHarmonicsGravitationalAccelerationModelXd geostationaryGravity(
+                    boost::lambda::constant( geostationaryPosition ), gravitationalParameter,
+                    planetaryRadius, cosineCoefficients, sineCoefficients,
+                    boost::lambda::constant( Eigen::Vector3d::Zero( ) ), formulation );
+        const Eigen::Vector3d fullGeostationaryAcceleration
+                = geostationaryGravity.getAcceleration( );
+        BOOST_CHECK_EQUAL( geostationaryGravity.getCurrentTruncationDegree( ), -1 );
+
+        geostationaryGravity.setTruncationTolerance( truncationTolerance );
+        const Eigen::Vector3d truncatedGeostationaryAcceleration
+                = geostationaryGravity.getAcceleration( );
+        BOOST_CHECK_LT( geostationaryGravity.getCurrentTruncationDegree( ), maximumDegree / 4 );
+        BOOST_CHECK_GE( geostationaryGravity.getCurrentTruncationDegree( ), 2 );
+        BOOST_CHECK_LE( ( truncatedGeostationaryAcceleration
+                          - fullGeostationaryAcceleration ).norm( ), truncationTolerance );
+
+        SphericalHarmonicsGravitationalAccelerationModelXd lowEarthOrbitGravity(
+                    boost::lambda::constant( lowEarthOrbitPosition ), gravitationalParameter,
+                    planetaryRadius, cosineCoefficients, sineCoefficients,
+                    boost::lambda::constant( Eigen::Vector3d::Zero( ) ), formulation );
+        const Eigen::Vector3d fullLowEarthOrbitAcceleration
+                = lowEarthOrbitGravity.getAcceleration( );
+        lowEarthOrbitGravity.setTruncationTolerance( truncationTolerance );
+        const Eigen::Vector3d truncatedLowEarthOrbitAcceleration
+                = lowEarthOrbitGravity.getAcceleration( );
+        BOOST_CHECK_GT( lowEarthOrbitGravity.getCurrentTruncationDegree( ),
+                        ( 3 * maximumDegree ) / 4 );
+        BOOST_CHECK_LE( ( truncatedLowEarthOrbitAcceleration
+                          - fullLowEarthOrbitAcceleration ).norm( ), truncationTolerance );
+
+        // Check that disabling truncation reproduces the full expansion exactly.
+        geostationaryGravity.setTruncationTolerance( 0.0 );
+        const Eigen::Vector3d untruncatedGeostationaryAcceleration
+                = geostationaryGravity.getAcceleration( );
+        BOOST_CHECK_EQUAL( geostationaryGravity.getCurrentTruncationDegree( ), -1 );
+        for ( int i = 0; i < 3; i++ )
+        {
+            BOOST_CHECK_EQUAL( untruncatedGeostationaryAcceleration( i ),
+                               fullGeostationaryAcceleration( i ) );
+        }
+    }
+
+    // Check that truncated sum equals sum with truncated coefficient matrices.
+    const int truncationDegree = 7;
+    basic_mathematics::SphericalHarmonicsWorkspace workspace( maximumDegree, maximumDegree );
+    const Eigen::Vector3d truncatedAcceleration
+            = computeGeodesyNormalizedGravitationalAccelerationSum(
+                geostationaryPosition, gravitationalParameter, planetaryRadius,
+                cosineCoefficients, sineCoefficients, workspace, truncationDegree );
+    const Eigen::Vector3d expectedAcceleration
+            = computeGeodesyNormalizedGravitationalAccelerationSum(
+                geostationaryPosition, gravitationalParameter, planetaryRadius,
+                cosineCoefficients.topLeftCorner( truncationDegree + 1, truncationDegree + 1 ),
+                sineCoefficients.topLeftCorner( truncationDegree + 1, truncationDegree + 1 ),
+                workspace );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedAcceleration, truncatedAcceleration, 1.0e-15 );
+}
+
+// Check acceleration on polar axis, where the latitude derivatives are evaluated by their limit.
+BOOST_AUTO_TEST_CASE( test_SphericalHarmonicsGravitationalAccelerationOnPolarAxis )
+{
+    // Short-cuts.
+    using namespace gravitation;
+
+    const double gravitationalParameter = 3.986004418e14;
+    const double planetaryRadius = 6378137.0;
+    const int maximumDegree = 20;
+
+    // Define synthetic geodesy-normalized coefficients.
+    Eigen::MatrixXd cosineCoefficients = Eigen::MatrixXd::Zero( maximumDegree + 1,
+                                                                maximumDegree + 1 );
+    Eigen::MatrixXd sineCoefficients = Eigen::MatrixXd::Zero( maximumDegree + 1,
+                                                              maximumDegree + 1 );
+    cosineCoefficients( 0, 0 ) = 1.0;
+    for ( int degree = 2; degree <= maximumDegree; degree++ )
+    {
+        for ( int order = 0; order <= degree; order++ )
+        {
+            cosineCoefficients( degree, order ) = 1.0e-5 / ( degree * degree )
+                    * std::sin( 1.3 * degree + 2.1 * order );
+            if ( order > 0 )
+            {
+                sineCoefficients( degree, order ) = 1.0e-5 / ( degree * degree )
+                        * std::cos( 0.7 * degree + 1.7 * order );
+            }
+        }
+    }
+
+    basic_mathematics::SphericalHarmonicsWorkspace workspace( maximumDegree, maximumDegree );
+    for ( int sign = -1; sign <= 1; sign += 2 )
+    {
+        // Compute acceleration exactly on polar axis, with and without explicit workspace.
+        const Eigen::Vector3d polarPosition( 0.0, 0.0, sign * 7.0e6 );
+        const Eigen::Vector3d polarAcceleration
+                = computeGeodesyNormalizedGravitationalAccelerationSum(
+                    polarPosition, gravitationalParameter, planetaryRadius, cosineCoefficients,
+                    sineCoefficients, workspace );
+        const Eigen::Vector3d polarAccelerationWithoutWorkspace
+                = computeGeodesyNormalizedGravitationalAccelerationSum(
+                    polarPosition, gravitationalParameter, planetaryRadius, cosineCoefficients,
+                    sineCoefficients );
+
+        BOOST_CHECK( polarAcceleration.allFinite( ) );
+        for ( int i = 0; i < 3; i++ )
+        {
+            BOOST_CHECK_EQUAL( polarAccelerationWithoutWorkspace( i ), polarAcceleration( i ) );
+        }
+
+        // Compare with acceleration slightly off the polar axis (the 1 mm offset results in an
+        // acceleration difference of order 1.0e-9 m/s^2), in two directions.
+        for ( int direction = 0; direction < 2; direction++ )
+        {
+            const Eigen::Vector3d nearPolarPosition
+                    = polarPosition + 1.0e-3 * Eigen::Vector3d::Unit( direction );
+            const Eigen::Vector3d nearPolarAcceleration
+                    = computeGeodesyNormalizedGravitationalAccelerationSum(
+                        nearPolarPosition, gravitationalParameter, planetaryRadius,
+                        cosineCoefficients, sineCoefficients, workspace );
+
+            TUDAT_CHECK_MATRIX_BASE( polarAcceleration, nearPolarAcceleration )
+                    BOOST_CHECK_SMALL( polarAcceleration.coeff( row, col )
+                                       - nearPolarAcceleration.coeff( row, col ),
+                                       1.0e-9 * nearPolarAcceleration.norm( ) );
+        }
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
@@ -27,6 +27,8 @@
  *      130307    R.C.A. Boon       File created.
  *      130308    D. Dirkx          Modified to add test of central body position; test with
  *                                  difference of central body accelerations.
+ *      261018                      Added tests of Battin formulation and grouped third-body
+ *                                  acceleration model.
  *
  *    References
  *
@@ -36,9 +38,13 @@
 
 #define BOOST_TEST_MAIN
 
+#include <cmath>
 #include <limits>
 #include <vector>
 
+#include <boost/bind.hpp>
+#include <boost/lambda/lambda.hpp>
+
 #include <boost/test/floating_point_comparison.hpp>
 #include <boost/test/unit_test.hpp>
 #include <boost/make_shared.hpp>
@@ -53,6 +59,13 @@ namespace tudat
 namespace unit_tests
 {
 
+//! Return given position, and count the number of calls.
+Eigen::Vector3d getPositionAndCountCall( const Eigen::Vector3d position, int* numberOfCalls )
+{
+    ( *numberOfCalls )++;
+    return position;
+}
+
 BOOST_AUTO_TEST_SUITE( test_third_body_perturbation )
 
 
@@ -308,6 +321,117 @@ BOOST_AUTO_TEST_CASE( testRealisticThirdBodyPerturbation )
                                        tolerance );
 }
 
+//! Test Battin formulation of third-body perturbation.
+BOOST_AUTO_TEST_CASE( testBattinThirdBodyPerturbation )
+{
+    const double sunGravitationalParameter = 1.32712440018E20;
+    const Eigen::Vector3d sunPosition( 1.2E11, -0.8E11, 0.3E11 );
+
+    // Check against direct formulation for body far from central body.
+    const Eigen::Vector3d distantPosition( 3.0E8, 1.0E8, -2.0E8 );
+    const Eigen::Vector3d expectedAcceleration
+            = gravitation::computeThirdBodyPerturbingAcceleration(
+                sunGravitationalParameter, sunPosition, distantPosition );
+    const Eigen::Vector3d computedAcceleration
+            = gravitation::computeThirdBodyPerturbingAccelerationBattin(
+                sunGravitationalParameter, sunPosition, distantPosition );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( computedAcceleration, expectedAcceleration, 1.0E-10 );
+
+    // Check against direct formulation in extended precision for body close to central body,
+    // for which the direct formulation in double precision loses about eight digits.
+    const Eigen::Vector3d closePosition( 1.0E3, -2.0E3, 0.5E3 );
+    const Eigen::Vector3d closeAcceleration
+            = gravitation::computeThirdBodyPerturbingAccelerationBattin(
+                sunGravitationalParameter, sunPosition, closePosition );
+
+    long double squaredDistanceToSun = 0.0L;
+    long double squaredDistanceOfSun = 0.0L;
+    for ( int i = 0; i < 3; i++ )
+    {
+        const long double relativePosition
+                = static_cast< long double >( sunPosition( i ) ) - closePosition( i );
+        squaredDistanceToSun += relativePosition * relativePosition;
+        squaredDistanceOfSun += static_cast< long double >( sunPosition( i ) ) * sunPosition( i );
+    }
+    for ( int i = 0; i < 3; i++ )
+    {
+        const long double expectedComponent = sunGravitationalParameter * (
+                    ( static_cast< long double >( sunPosition( i ) ) - closePosition( i ) )
+                    / ( squaredDistanceToSun * std::sqrt( squaredDistanceToSun ) )
+                    - static_cast< long double >( sunPosition( i ) )
+                    / ( squaredDistanceOfSun * std::sqrt( squaredDistanceOfSun ) ) );
+        BOOST_CHECK_SMALL( static_cast< double >( closeAcceleration( i ) - expectedComponent ),
+                           1.0E-9 * closeAcceleration.norm( ) );
+    }
+}
+
+//! Test grouped third-body acceleration model.
+BOOST_AUTO_TEST_CASE( testGroupedThirdBodyAccelerationModel )
+{
+    // Set positions and gravitational parameters of Sun, Moon and Jupiter (w.r.t. solar system
+    // barycenter), and Earth as central body.
+    const Eigen::Vector3d earthPosition( 1.3E11, 6.5E10, -2.0E7 );
+    const Eigen::Vector3d satellitePosition
+            = earthPosition + Eigen::Vector3d( 7.0E6, -1.0E6, 2.0E6 );
+    Eigen::Matrix3Xd perturbingBodyPositions( 3, 3 );
+    perturbingBodyPositions.col( 0 ) = Eigen::Vector3d( 1.0E8, -2.0E8, 1.0E6 );
+    perturbingBodyPositions.col( 1 ) = earthPosition + Eigen::Vector3d( 3.0E8, 2.4E8, 1.0E7 );
+    perturbingBodyPositions.col( 2 ) = Eigen::Vector3d( -7.0E11, 2.0E11, 1.0E10 );
+    const Eigen::Vector3d gravitationalParameters( 1.32712440018E20, 4.9028E12, 1.26686534E17 );
+
+    int numberOfCentralBodyCalls = 0;
+    int numberOfPerturbingBodyCalls = 0;
+    gravitation::GroupedThirdBodyAccelerationModel groupedAcceleration(
+                boost::lambda::constant( satellitePosition ),
+                boost::bind( &getPositionAndCountCall, earthPosition,
+                             &numberOfCentralBodyCalls ) );
+    for ( int i = 0; i < 3; i++ )
+    {
+        groupedAcceleration.addPerturbingBody(
+                    gravitationalParameters( i ),
+                    boost::bind( &getPositionAndCountCall, Eigen::Vector3d(
+                                     perturbingBodyPositions.col( i ) ),
+                                 &numberOfPerturbingBodyCalls ) );
+    }
+    BOOST_CHECK_EQUAL( groupedAcceleration.getNumberOfPerturbingBodies( ), 3 );
+
+    groupedAcceleration.updateMembers( );
+    BOOST_CHECK_EQUAL( numberOfCentralBodyCalls, 1 );
+    BOOST_CHECK_EQUAL( numberOfPerturbingBodyCalls, 3 );
+
+    // Check against sum of separate third-body perturbations.
+    Eigen::Vector3d expectedAcceleration = Eigen::Vector3d::Zero( );
+    for ( int i = 0; i < 3; i++ )
+    {
+        expectedAcceleration += gravitation::computeThirdBodyPerturbingAcceleration(
+                    gravitationalParameters( i ), perturbingBodyPositions.col( i ),
+                    satellitePosition, earthPosition );
+    }
+    const Eigen::Vector3d computedAcceleration = groupedAcceleration.getAcceleration( );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( computedAcceleration, expectedAcceleration, 1.0E-8 );
+
+    // Check accelerations of a set of bodies in the same environment.
+    Eigen::Matrix3Xd relativePositions( 3, 2 );
+    relativePositions.col( 0 ) = satellitePosition - earthPosition;
+    relativePositions.col( 1 ) = Eigen::Vector3d( -4.0E7, 1.0E7, 0.0 );
+    const Eigen::Matrix3Xd computedAccelerations
+            = groupedAcceleration.computeAccelerations( relativePositions );
+    for ( int j = 0; j < 2; j++ )
+    {
+        Eigen::Vector3d expectedBodyAcceleration = Eigen::Vector3d::Zero( );
+        for ( int i = 0; i < 3; i++ )
+        {
+            expectedBodyAcceleration += gravitation::computeThirdBodyPerturbingAccelerationBattin(
+                        gravitationalParameters( i ),
+                        perturbingBodyPositions.col( i ) - earthPosition,
+                        relativePositions.col( j ) );
+        }
+        const Eigen::Vector3d computedBodyAcceleration = computedAccelerations.col( j );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( computedBodyAcceleration, expectedBodyAcceleration,
+                                           1.0E-14 );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
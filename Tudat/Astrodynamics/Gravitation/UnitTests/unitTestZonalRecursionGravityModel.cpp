@@ -0,0 +1,201 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      Unit test created.
+ *      261018                      Renamed test target to test_ZonalRecursionGravityModel.
+ *
+ *    References
+ *      Lemoine, F.G., et al. The development of the joint NASA GSFC and the National Imagery and
+ *          Mapping Agency (NIMA) geopotential model EGM96, NASA/TP-1998-206861, 1998.
+ *
+ *    Notes
+ *      The zonal coefficients that are used are the (rounded) unnormalized EGM96 values.
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+
+#include <boost/lambda/lambda.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Basics/testMacros.h"
+
+#include "Tudat/Astrodynamics/Gravitation/centralJ2J3J4GravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/centralZonalGravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModel.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Get unnormalized zonal coefficients J2 to J10 of Earth.
+Eigen::Matrix< double, 9, 1 > getEarthZonalCoefficients( )
+{
+    Eigen::Matrix< double, 9, 1 > zonalCoefficients;
+    zonalCoefficients << 1.08262668E-3, -2.53265649E-6, -1.61962159E-6, -2.27296083E-7,
+            5.40681239E-7, -3.52359908E-7, -2.04799710E-7, -1.20443492E-7, -2.41206660E-7;
+    return zonalCoefficients;
+}
+
+//! Get set of test positions w.r.t. Earth.
+Eigen::Matrix3Xd getTestPositions( )
+{
+    Eigen::Matrix3Xd positions( 3, 5 );
+    positions << 7.0E6, -4.2E6, 1.0E5, 3.3E6, 2.0E7,
+            0.0, 5.1E6, -2.0E5, -3.3E6, -1.0E7,
+            0.0, 2.4E6, -6.9E6, 5.2E6, 3.0E6;
+    return positions;
+}
+
+BOOST_AUTO_TEST_SUITE( test_zonal_recursion_gravity_model )
+
+//! Test central and zonal acceleration up to degree 4 against separate zonal term functions.
+BOOST_AUTO_TEST_CASE( testCentralZonalGravityModelAgainstSeparateTerms )
+{
+    using namespace gravitation;
+
+    const double gravitationalParameter = 3.986004418E14;
+    const double equatorialRadius = 6378137.0;
+    const Eigen::Matrix< double, 9, 1 > zonalCoefficients = getEarthZonalCoefficients( );
+    const Eigen::Matrix3Xd positions = getTestPositions( );
+
+    for ( int i = 0; i < positions.cols( ); i++ )
+    {
+        const Eigen::Vector3d position = positions.col( i );
+
+        const Eigen::Vector3d expectedAcceleration
+                = computeGravitationalAcceleration( position, gravitationalParameter )
+                + computeGravitationalAccelerationDueToJ2(
+                    position, gravitationalParameter, equatorialRadius,
+                    zonalCoefficients( 0 ), Eigen::Vector3d::Zero( ) )
+                + computeGravitationalAccelerationDueToJ3(
+                    position, gravitationalParameter, equatorialRadius,
+                    zonalCoefficients( 1 ), Eigen::Vector3d::Zero( ) )
+                + computeGravitationalAccelerationDueToJ4(
+                    position, gravitationalParameter, equatorialRadius,
+                    zonalCoefficients( 2 ), Eigen::Vector3d::Zero( ) );
+
+        const Eigen::Vector3d computedAcceleration
+                = computeCentralAndZonalGravitationalAcceleration< 4 >(
+                    position, gravitationalParameter, equatorialRadius,
+                    Eigen::Vector3d( zonalCoefficients.segment( 0, 3 ) ) );
+
+        TUDAT_CHECK_MATRIX_BASE( computedAcceleration, expectedAcceleration )
+                BOOST_CHECK_SMALL( computedAcceleration.coeff( row, col )
+                                   - expectedAcceleration.coeff( row, col ),
+                                   1.0E-14 * expectedAcceleration.norm( ) );
+    }
+}
+
+//! Test central and zonal acceleration up to degree 10 against spherical harmonics model.
+BOOST_AUTO_TEST_CASE( testCentralZonalGravityModelAgainstSphericalHarmonics )
+{
+    using namespace gravitation;
+
+    const double gravitationalParameter = 3.986004418E14;
+    const double equatorialRadius = 6378137.0;
+    const Eigen::Matrix< double, 9, 1 > zonalCoefficients = getEarthZonalCoefficients( );
+    const Eigen::Matrix3Xd positions = getTestPositions( );
+
+    // Set geodesy-normalized cosine coefficients, C_n0 = -J_n / sqrt( 2n + 1 ).
+    Eigen::MatrixXd cosineCoefficients = Eigen::MatrixXd::Zero( 11, 11 );
+    cosineCoefficients( 0, 0 ) = 1.0;
+    for ( int degree = 2; degree <= 10; degree++ )
+    {
+        cosineCoefficients( degree, 0 ) = -zonalCoefficients( degree - 2 )
+                / std::sqrt( 2.0 * static_cast< double >( degree ) + 1.0 );
+    }
+    const Eigen::MatrixXd sineCoefficients = Eigen::MatrixXd::Zero( 11, 11 );
+
+    for ( int i = 0; i < positions.cols( ); i++ )
+    {
+        const Eigen::Vector3d position = positions.col( i );
+
+        const Eigen::Vector3d expectedAcceleration
+                = computeGeodesyNormalizedGravitationalAccelerationSum(
+                    position, gravitationalParameter, equatorialRadius, cosineCoefficients,
+                    sineCoefficients );
+        const Eigen::Vector3d computedAcceleration
+                = computeCentralAndZonalGravitationalAcceleration< 10 >(
+                    position, gravitationalParameter, equatorialRadius, zonalCoefficients );
+
+        TUDAT_CHECK_MATRIX_BASE( computedAcceleration, expectedAcceleration )
+                BOOST_CHECK_SMALL( computedAcceleration.coeff( row, col )
+                                   - expectedAcceleration.coeff( row, col ),
+                                   1.0E-14 * expectedAcceleration.norm( ) );
+    }
+}
+
+//! Test central and zonal gravitational acceleration model class.
+BOOST_AUTO_TEST_CASE( testCentralZonalGravitationalAccelerationModel )
+{
+    using namespace gravitation;
+
+    const double gravitationalParameter = 3.986004418E14;
+    const double equatorialRadius = 6378137.0;
+    const Eigen::Matrix< double, 9, 1 > zonalCoefficients = getEarthZonalCoefficients( );
+    const Eigen::Vector3d earthPosition( 1.4E11, -3.0E10, 1.0E9 );
+    const Eigen::Vector3d satellitePosition
+            = earthPosition + Eigen::Vector3d( -4.2E6, 5.1E6, 2.4E6 );
+
+    CentralZonalGravitationalAccelerationModel< 10 > zonalGravity(
+                boost::lambda::constant( satellitePosition ), gravitationalParameter,
+                equatorialRadius, zonalCoefficients, boost::lambda::constant( earthPosition ) );
+    BOOST_CHECK_EQUAL( zonalGravity.getZonalCoefficients( )( 8 ), zonalCoefficients( 8 ) );
+
+    const Eigen::Vector3d computedAcceleration = zonalGravity.getAcceleration( );
+    const Eigen::Vector3d expectedAcceleration
+            = computeCentralAndZonalGravitationalAcceleration< 10 >(
+                satellitePosition - earthPosition, gravitationalParameter, equatorialRadius,
+                zonalCoefficients );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( computedAcceleration, expectedAcceleration, 1.0E-15 );
+
+    // Check that model without higher zonal terms reproduces central + J2 + J3 + J4 model.
+    CentralZonalGravitationalAccelerationModel< 4 > zonalGravityToDegreeFour(
+                boost::lambda::constant( satellitePosition ), gravitationalParameter,
+                equatorialRadius, Eigen::Vector3d( zonalCoefficients.segment( 0, 3 ) ),
+                boost::lambda::constant( earthPosition ) );
+    CentralJ2J3J4GravitationalAccelerationModel centralJ2J3J4Gravity(
+                boost::lambda::constant( satellitePosition ), gravitationalParameter,
+                equatorialRadius, zonalCoefficients( 0 ), zonalCoefficients( 1 ),
+                zonalCoefficients( 2 ), boost::lambda::constant( earthPosition ) );
+    const Eigen::Vector3d zonalAccelerationToDegreeFour
+            = zonalGravityToDegreeFour.getAcceleration( );
+    const Eigen::Vector3d centralJ2J3J4Acceleration = centralJ2J3J4Gravity.getAcceleration( );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION( zonalAccelerationToDegreeFour, centralJ2J3J4Acceleration,
+                                       1.0E-15 );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
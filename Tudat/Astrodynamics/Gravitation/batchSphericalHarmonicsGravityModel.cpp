@@ -0,0 +1,402 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Made latitude derivatives regular on polar axis.
+ *
+ *    References
+ *      Heiskanen, W.A., Moritz, H. Physical geodesy. Freeman, 1967.
+ *      Holmes, S.A., Featherstone, W.E. A unified approach to the Clenshaw summation and the
+ *          recursive computation of very high degree and order normalised associated Legendre
+ *          functions, Journal of Geodesy, 76(5), 279-299, 2002.
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <boost/exception/all.hpp>
+
+#include "Tudat/Astrodynamics/Gravitation/batchSphericalHarmonicsGravityModel.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+
+// Definition of number of lanes, required since it is used by reference.
+const int BatchSphericalHarmonicsWorkspace::numberOfLanes;
+
+//! Constructor.
+BatchSphericalHarmonicsWorkspace::BatchSphericalHarmonicsWorkspace( const int maximumDegree,
+                                                                    const int maximumOrder )
+    : maximumDegree_( maximumDegree ),
+      maximumOrder_( maximumOrder )
+{
+    if ( maximumDegree_ < 0 || maximumOrder_ < 0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, maximum degree and order of batch spherical harmonics "
+                            "workspace must be non-negative." ) ) );
+    }
+
+    // Legendre polynomials are computed up to one order higher than requested, since these are
+    // needed for the derivatives.
+    const int numberOfOrders = maximumOrder_ + 2;
+
+    verticalRecurrenceFactors_ = Eigen::MatrixXd::Zero( maximumDegree_ + 1, numberOfOrders );
+    secondVerticalRecurrenceFactors_
+            = Eigen::MatrixXd::Zero( maximumDegree_ + 1, numberOfOrders );
+    sectoralRecurrenceFactors_ = Eigen::VectorXd::Zero( numberOfOrders );
+    derivativeFactors_ = Eigen::MatrixXd::Zero( maximumDegree_ + 1, maximumOrder_ + 1 );
+
+    currentLegendreColumn_ = LaneBuffer::Zero( numberOfLanes, maximumDegree_ + 1 );
+    nextLegendreColumn_ = LaneBuffer::Zero( numberOfLanes, maximumDegree_ + 1 );
+    firstOrderLegendreColumnOverCosineOfLatitude_
+            = LaneBuffer::Zero( numberOfLanes, maximumDegree_ + 1 );
+    radiusRatioPowers_ = LaneBuffer::Zero( numberOfLanes, maximumDegree_ + 1 );
+
+    // Precompute recurrence factors.
+    for ( int order = 1; order < numberOfOrders; order++ )
+    {
+        const double m = static_cast< double >( order );
+        sectoralRecurrenceFactors_( order ) = ( order == 1 ) ?
+                    std::sqrt( 3.0 ) : std::sqrt( ( 2.0 * m + 1.0 ) / ( 2.0 * m ) );
+    }
+
+    for ( int degree = 1; degree <= maximumDegree_; degree++ )
+    {
+        const double n = static_cast< double >( degree );
+        for ( int order = 0; order < degree && order < numberOfOrders; order++ )
+        {
+            const double m = static_cast< double >( order );
+            verticalRecurrenceFactors_( degree, order ) = std::sqrt(
+                        ( 2.0 * n - 1.0 ) * ( 2.0 * n + 1.0 ) / ( ( n - m ) * ( n + m ) ) );
+
+            if ( degree > order + 1 )
+            {
+                secondVerticalRecurrenceFactors_( degree, order ) = std::sqrt(
+                            ( 2.0 * n + 1.0 ) * ( n + m - 1.0 ) * ( n - m - 1.0 )
+                            / ( ( n - m ) * ( n + m ) * ( 2.0 * n - 3.0 ) ) );
+            }
+        }
+
+        for ( int order = 0; order < degree && order <= maximumOrder_; order++ )
+        {
+            const double m = static_cast< double >( order );
+            derivativeFactors_( degree, order ) = std::sqrt( ( n - m ) * ( n + m + 1.0 ) );
+            if ( order == 0 )
+            {
+                derivativeFactors_( degree, order ) *= std::sqrt( 0.5 );
+            }
+        }
+    }
+}
+
+//! Compute column of Legendre polynomials of single order.
+void BatchSphericalHarmonicsWorkspace::computeLegendreColumn( const int order,
+                                                             const int highestDegree,
+                                                             const LaneArray& sineOfLatitude,
+                                                             LaneBuffer& legendreColumn )
+{
+    if ( order < highestDegree )
+    {
+        legendreColumn.col( order + 1 ) = verticalRecurrenceFactors_( order + 1, order )
+                * sineOfLatitude * legendreColumn.col( order );
+    }
+
+    for ( int degree = order + 2; degree <= highestDegree; degree++ )
+    {
+        legendreColumn.col( degree )
+                = verticalRecurrenceFactors_( degree, order ) * sineOfLatitude
+                * legendreColumn.col( degree - 1 )
+                - secondVerticalRecurrenceFactors_( degree, order )
+                * legendreColumn.col( degree - 2 );
+    }
+}
+
+//! Compute accelerations for a single chunk of positions.
+void BatchSphericalHarmonicsWorkspace::computeAccelerations(
+        const Eigen::Matrix3Xd& positions,
+        const int startIndex,
+        const double gravitationalParameter,
+        const double equatorialRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        Eigen::Matrix3Xd& accelerations )
+{
+    const int highestDegree = static_cast< int >( cosineHarmonicCoefficients.rows( ) ) - 1;
+    const int highestOrder = std::min( static_cast< int >( cosineHarmonicCoefficients.cols( ) ) - 1,
+                                       highestDegree );
+    const int numberOfPositions = std::min( numberOfLanes,
+                                            static_cast< int >( positions.cols( ) ) - startIndex );
+
+    // Gather positions into lanes, padding unused lanes with last position.
+    LaneArray xPositions, yPositions, zPositions;
+    for ( int lane = 0; lane < numberOfLanes; lane++ )
+    {
+        const int positionIndex = startIndex + std::min( lane, numberOfPositions - 1 );
+        xPositions( lane ) = positions( 0, positionIndex );
+        yPositions( lane ) = positions( 1, positionIndex );
+        zPositions( lane ) = positions( 2, positionIndex );
+    }
+
+    // Compute radius, latitude and longitude terms directly from Cartesian positions.
+    const LaneArray radius = ( xPositions.square( ) + yPositions.square( )
+                               + zPositions.square( ) ).sqrt( );
+    const LaneArray distanceFromPolarAxis = ( xPositions.square( )
+                                              + yPositions.square( ) ).sqrt( );
+    const LaneArray sineOfLatitude = zPositions / radius;
+    const LaneArray cosineOfLatitude = distanceFromPolarAxis / radius;
+    const LaneArray cosineOfLongitude = ( distanceFromPolarAxis > 0.0 ).select(
+                xPositions / distanceFromPolarAxis, LaneArray::Ones( ) );
+    const LaneArray sineOfLongitude = ( distanceFromPolarAxis > 0.0 ).select(
+                yPositions / distanceFromPolarAxis, LaneArray::Zero( ) );
+
+    // Compute powers of radius ratio.
+    const LaneArray radiusRatio = equatorialRadius / radius;
+    radiusRatioPowers_.col( 0 ).setOnes( );
+    for ( int degree = 1; degree <= highestDegree; degree++ )
+    {
+        radiusRatioPowers_.col( degree ) = radiusRatioPowers_.col( degree - 1 ) * radiusRatio;
+    }
+
+    // Sum derivatives of potential w.r.t. radius, latitude (divided by r) and longitude (divided
+    // by r cos(latitude), which is regular on the polar axis), each without the common factor
+    // mu / r^2, per order.
+    LaneArray radialSum = LaneArray::Zero( );
+    LaneArray latitudinalSum = LaneArray::Zero( );
+    LaneArray longitudinalSum = LaneArray::Zero( );
+
+    LaneArray cosineOfMultipleLongitude = LaneArray::Ones( );
+    LaneArray sineOfMultipleLongitude = LaneArray::Zero( );
+
+    currentLegendreColumn_.col( 0 ).setOnes( );
+    computeLegendreColumn( 0, highestDegree, sineOfLatitude, currentLegendreColumn_ );
+
+    // Compute Legendre polynomials of order one divided by cosine of latitude, which are regular
+    // on the polar axis, with the same recurrence, starting from P_{1,1} / cos( latitude ).
+    if ( highestOrder > 0 )
+    {
+        firstOrderLegendreColumnOverCosineOfLatitude_.col( 1 ).setConstant(
+                    sectoralRecurrenceFactors_( 1 ) );
+        computeLegendreColumn( 1, highestDegree, sineOfLatitude,
+                               firstOrderLegendreColumnOverCosineOfLatitude_ );
+    }
+    const LaneArray inverseCosineOfLatitude = ( cosineOfLatitude > 0.0 ).select(
+                1.0 / cosineOfLatitude, LaneArray::Zero( ) );
+    for ( int order = 0; order <= highestOrder; order++ )
+    {
+        // Compute column of next order, required for derivatives w.r.t. latitude.
+        if ( order < highestDegree )
+        {
+            nextLegendreColumn_.col( order + 1 ) = sectoralRecurrenceFactors_( order + 1 )
+                    * cosineOfLatitude * currentLegendreColumn_.col( order );
+            computeLegendreColumn( order + 1, highestDegree, sineOfLatitude,
+                                   nextLegendreColumn_ );
+        }
+
+        const double m = static_cast< double >( order );
+        for ( int degree = order; degree <= highestDegree; degree++ )
+        {
+            const double cosineCoefficient = cosineHarmonicCoefficients( degree, order );
+            const double sineCoefficient = sineHarmonicCoefficients( degree, order );
+            const LaneArray coefficientTerm = cosineCoefficient * cosineOfMultipleLongitude
+                    + sineCoefficient * sineOfMultipleLongitude;
+            const LaneArray scaledLegendrePolynomial
+                    = radiusRatioPowers_.col( degree ) * currentLegendreColumn_.col( degree );
+
+            // Compute Legendre polynomial divided by cosine of latitude, multiplied by radius
+            // ratio power. Polynomials of order two and higher contain at least the square of the
+            // cosine of latitude as factor, so that the limit on the polar axis is zero.
+            LaneArray scaledLegendrePolynomialOverCosineOfLatitude = LaneArray::Zero( );
+            if ( order == 1 )
+            {
+                scaledLegendrePolynomialOverCosineOfLatitude = radiusRatioPowers_.col( degree )
+                        * firstOrderLegendreColumnOverCosineOfLatitude_.col( degree );
+            }
+            else if ( order > 1 )
+            {
+                scaledLegendrePolynomialOverCosineOfLatitude
+                        = scaledLegendrePolynomial * inverseCosineOfLatitude;
+            }
+
+            // Compute derivative of Legendre polynomial w.r.t. latitude, multiplied by radius
+            // ratio power.
+            LaneArray scaledLegendrePolynomialDerivative
+                    = -m * sineOfLatitude * scaledLegendrePolynomialOverCosineOfLatitude;
+            if ( degree > order )
+            {
+                scaledLegendrePolynomialDerivative += derivativeFactors_( degree, order )
+                        * radiusRatioPowers_.col( degree ) * nextLegendreColumn_.col( degree );
+            }
+
+            radialSum -= static_cast< double >( degree + 1 ) * scaledLegendrePolynomial
+                    * coefficientTerm;
+            latitudinalSum += scaledLegendrePolynomialDerivative * coefficientTerm;
+            longitudinalSum += m * scaledLegendrePolynomialOverCosineOfLatitude
+                    * ( sineCoefficient * cosineOfMultipleLongitude
+                        - cosineCoefficient * sineOfMultipleLongitude );
+        }
+
+        // Move to next order.
+        currentLegendreColumn_.swap( nextLegendreColumn_ );
+        const LaneArray previousCosineOfMultipleLongitude = cosineOfMultipleLongitude;
+        cosineOfMultipleLongitude = cosineOfMultipleLongitude * cosineOfLongitude
+                - sineOfMultipleLongitude * sineOfLongitude;
+        sineOfMultipleLongitude = sineOfMultipleLongitude * cosineOfLongitude
+                + previousCosineOfMultipleLongitude * sineOfLongitude;
+    }
+
+    // Convert from spherical gradient to Cartesian gradient (which equals acceleration vector).
+    const LaneArray preMultiplier = gravitationalParameter / radius.square( );
+    const LaneArray radialComponent = preMultiplier * radialSum;
+    const LaneArray latitudinalComponent = preMultiplier * latitudinalSum;
+    const LaneArray longitudinalComponent = preMultiplier * longitudinalSum;
+    const LaneArray horizontalComponent = radialComponent * cosineOfLatitude
+            - latitudinalComponent * sineOfLatitude;
+
+    const LaneArray xAccelerations = horizontalComponent * cosineOfLongitude
+            - longitudinalComponent * sineOfLongitude;
+    const LaneArray yAccelerations = horizontalComponent * sineOfLongitude
+            + longitudinalComponent * cosineOfLongitude;
+    const LaneArray zAccelerations = radialComponent * sineOfLatitude
+            + latitudinalComponent * cosineOfLatitude;
+
+    // Scatter accelerations of used lanes.
+    for ( int lane = 0; lane < numberOfPositions; lane++ )
+    {
+        accelerations( 0, startIndex + lane ) = xAccelerations( lane );
+        accelerations( 1, startIndex + lane ) = yAccelerations( lane );
+        accelerations( 2, startIndex + lane ) = zAccelerations( lane );
+    }
+}
+
+//! Compute accelerations for a range of chunks of positions.
+void computeBatchGeodesyNormalizedGravitationalAccelerationChunks(
+        BatchSphericalHarmonicsWorkspace workspace,
+        const Eigen::Matrix3Xd& positions,
+        const double gravitationalParameter,
+        const double equatorialRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        const int firstChunk,
+        const int endChunk,
+        Eigen::Matrix3Xd& accelerations )
+{
+    for ( int chunk = firstChunk; chunk < endChunk; chunk++ )
+    {
+        workspace.computeAccelerations(
+                    positions, chunk * BatchSphericalHarmonicsWorkspace::numberOfLanes,
+                    gravitationalParameter, equatorialRadius, cosineHarmonicCoefficients,
+                    sineHarmonicCoefficients, accelerations );
+    }
+}
+
+//! Compute gravitational acceleration due to spherical harmonics at multiple positions.
+Eigen::Matrix3Xd computeBatchGeodesyNormalizedGravitationalAccelerationSum(
+        const Eigen::Matrix3Xd& positions,
+        const double gravitationalParameter,
+        const double equatorialRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        const int numberOfThreads )
+{
+    if ( cosineHarmonicCoefficients.rows( ) < 1
+         || cosineHarmonicCoefficients.rows( ) != sineHarmonicCoefficients.rows( )
+         || cosineHarmonicCoefficients.cols( ) != sineHarmonicCoefficients.cols( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, cosine and sine coefficient matrices of batch spherical "
+                            "harmonics evaluation must be non-empty and equal in size." ) ) );
+    }
+
+    // Check all positions before evaluation, such that no errors occur in the worker threads.
+    if ( positions.cols( ) > 0 && positions.colwise( ).norm( ).minCoeff( ) < equatorialRadius )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Distance to origin is smaller than the size of the main body." ) ) );
+    }
+
+    Eigen::Matrix3Xd accelerations( 3, positions.cols( ) );
+    if ( positions.cols( ) == 0 )
+    {
+        return accelerations;
+    }
+
+    // Create workspace, which is copied to each thread.
+    const BatchSphericalHarmonicsWorkspace workspace(
+                cosineHarmonicCoefficients.rows( ) - 1,
+                std::max( static_cast< int >( cosineHarmonicCoefficients.cols( ) ) - 1, 0 ) );
+
+    // Divide chunks over threads.
+    const int numberOfLanes = BatchSphericalHarmonicsWorkspace::numberOfLanes;
+    const int numberOfChunks = ( positions.cols( ) + numberOfLanes - 1 ) / numberOfLanes;
+    const int numberOfUsedThreads = std::max( 1, std::min( numberOfThreads, numberOfChunks ) );
+    const int chunksPerThread = ( numberOfChunks + numberOfUsedThreads - 1 )
+            / numberOfUsedThreads;
+
+    std::vector< std::thread > threads;
+    for ( int thread = 1; thread < numberOfUsedThreads; thread++ )
+    {
+        threads.push_back( std::thread(
+                               &computeBatchGeodesyNormalizedGravitationalAccelerationChunks,
+                               workspace, std::cref( positions ), gravitationalParameter,
+                               equatorialRadius, std::cref( cosineHarmonicCoefficients ),
+                               std::cref( sineHarmonicCoefficients ),
+                               std::min( thread * chunksPerThread, numberOfChunks ),
+                               std::min( ( thread + 1 ) * chunksPerThread, numberOfChunks ),
+                               std::ref( accelerations ) ) );
+    }
+
+    // Evaluate first range of chunks on calling thread.
+    computeBatchGeodesyNormalizedGravitationalAccelerationChunks(
+                workspace, positions, gravitationalParameter, equatorialRadius,
+                cosineHarmonicCoefficients, sineHarmonicCoefficients,
+                0, std::min( chunksPerThread, numberOfChunks ), accelerations );
+
+    for ( unsigned int i = 0; i < threads.size( ); i++ )
+    {
+        threads[ i ].join( );
+    }
+
+    return accelerations;
+}
+
+} // namespace gravitation
+} // namespace tudat
@@ -0,0 +1,212 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Made latitude derivatives regular on polar axis.
+ *      261018                      Documented polar-axis behaviour in notes.
+ *
+ *    References
+ *      Heiskanen, W.A., Moritz, H. Physical geodesy. Freeman, 1967.
+ *      Holmes, S.A., Featherstone, W.E. A unified approach to the Clenshaw summation and the
+ *          recursive computation of very high degree and order normalised associated Legendre
+ *          functions, Journal of Geodesy, 76(5), 279-299, 2002.
+ *
+ *    Notes
+ *      For each position, the batch evaluation gives the same result as the function
+ *      computeGeodesyNormalizedGravitationalAccelerationSum(), up to round-off errors, since the
+ *      terms are summed in a different order (per order, instead of per degree). Unlike the
+ *      single-position function, the batch evaluation is regular on the polar axis: the latitude
+ *      and longitude derivatives are computed from the Legendre polynomials divided by the cosine
+ *      of latitude, for which the order-one terms are obtained from their own recurrence and the
+ *      higher-order terms vanish on the axis. Positions on the polar axis therefore give the
+ *      (finite) limit of the acceleration, rather than NaN.
+ *
+ */
+
+#ifndef TUDAT_BATCH_SPHERICAL_HARMONICS_GRAVITY_MODEL_H
+#define TUDAT_BATCH_SPHERICAL_HARMONICS_GRAVITY_MODEL_H
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+namespace gravitation
+{
+
+//! Workspace for batch evaluation of spherical harmonics acceleration.
+/*!
+ * This class evaluates the acceleration due to a geodesy-normalized spherical harmonics
+ * expansion for a number of positions simultaneously. The positions are processed in chunks of
+ * numberOfLanes positions, and all quantities (Legendre polynomials, multiple-angle trigonometric
+ * terms, radius ratio powers and partial sums) are stored as fixed-size Eigen arrays with one
+ * element (lane) per position. As a result, each step of the recurrences is a single array
+ * operation over all lanes, which Eigen maps to SIMD instructions. The Legendre polynomials are
+ * computed column-wise (per order), using the same recurrences as the
+ * basic_mathematics::SphericalHarmonicsWorkspace class, such that only two columns need to be
+ * stored at a time. All recurrence factors are precomputed when the workspace is constructed.
+ */
+class BatchSphericalHarmonicsWorkspace
+{
+public:
+
+    //! Number of positions that is processed simultaneously.
+    static const int numberOfLanes = 8;
+
+    //! Typedef for array with a single value per lane.
+    typedef Eigen::Array< double, numberOfLanes, 1 > LaneArray;
+
+    //! Typedef for array with a column of values per lane.
+    typedef Eigen::Array< double, numberOfLanes, Eigen::Dynamic > LaneBuffer;
+
+    //! Constructor.
+    /*!
+     * Constructor, allocates memory and precomputes all recurrence factors for the given
+     * maximum degree and order.
+     * \param maximumDegree Maximum degree of spherical harmonics terms that are evaluated.
+     * \param maximumOrder Maximum order of spherical harmonics terms that are evaluated.
+     */
+    BatchSphericalHarmonicsWorkspace( const int maximumDegree, const int maximumOrder );
+
+    //! Compute accelerations for a single chunk of positions.
+    /*!
+     * Computes the acceleration due to the spherical harmonics expansion at (at most)
+     * numberOfLanes consecutive positions, starting at the given index. If fewer positions
+     * remain, the unused lanes are filled with the last position, and their result is discarded.
+     * \param positions Cartesian positions, in the frame in which the expansion is defined; each
+     *          column contains a single position.
+     * \param startIndex Index of first position of the chunk.
+     * \param gravitationalParameter Gravitational parameter associated with the spherical
+     *          harmonics [m^3 s^-2].
+     * \param equatorialRadius Reference radius of the spherical harmonics [m].
+     * \param cosineHarmonicCoefficients Matrix with <B>geodesy-normalized</B> cosine harmonic
+     *          coefficients.
+     * \param sineHarmonicCoefficients Matrix with <B>geodesy-normalized</B> sine harmonic
+     *          coefficients.
+     * \param accelerations Matrix in which the accelerations are stored, in the columns
+     *          corresponding to the positions of the chunk (returned by reference).
+     */
+    void computeAccelerations( const Eigen::Matrix3Xd& positions,
+                               const int startIndex,
+                               const double gravitationalParameter,
+                               const double equatorialRadius,
+                               const Eigen::MatrixXd& cosineHarmonicCoefficients,
+                               const Eigen::MatrixXd& sineHarmonicCoefficients,
+                               Eigen::Matrix3Xd& accelerations );
+
+    //! Get maximum degree.
+    /*!
+     * Returns the maximum degree for which the workspace computes terms.
+     * \return Maximum degree.
+     */
+    int getMaximumDegree( ) const { return maximumDegree_; }
+
+    //! Get maximum order.
+    /*!
+     * Returns the maximum order for which the workspace computes terms.
+     * \return Maximum order.
+     */
+    int getMaximumOrder( ) const { return maximumOrder_; }
+
+protected:
+
+private:
+
+    //! Compute column of Legendre polynomials of single order.
+    /*!
+     * Computes the non-sectoral Legendre polynomials of the given order, up to the given degree,
+     * from the sectoral polynomial that is stored in the column at index order.
+     * \param order Order of column.
+     * \param highestDegree Highest degree up to which column is computed.
+     * \param sineOfLatitude Sine of latitude of each lane.
+     * \param legendreColumn Column of Legendre polynomials (returned by reference).
+     */
+    void computeLegendreColumn( const int order, const int highestDegree,
+                                const LaneArray& sineOfLatitude, LaneBuffer& legendreColumn );
+
+    //! Maximum degree.
+    int maximumDegree_;
+
+    //! Maximum order.
+    int maximumOrder_;
+
+    //! First factors of vertical Legendre polynomial recurrence.
+    Eigen::MatrixXd verticalRecurrenceFactors_;
+
+    //! Second factors of vertical Legendre polynomial recurrence.
+    Eigen::MatrixXd secondVerticalRecurrenceFactors_;
+
+    //! Factors of sectoral Legendre polynomial recurrence.
+    Eigen::VectorXd sectoralRecurrenceFactors_;
+
+    //! Factors of derivative of Legendre polynomials w.r.t. latitude.
+    Eigen::MatrixXd derivativeFactors_;
+
+    //! Legendre polynomials of current order, for each lane.
+    LaneBuffer currentLegendreColumn_;
+
+    //! Legendre polynomials of next order, for each lane.
+    LaneBuffer nextLegendreColumn_;
+
+    //! Legendre polynomials of order one divided by cosine of latitude, for each lane.
+    LaneBuffer firstOrderLegendreColumnOverCosineOfLatitude_;
+
+    //! Powers of ratio of reference radius and radius, for each lane.
+    LaneBuffer radiusRatioPowers_;
+};
+
+//! Compute gravitational acceleration due to spherical harmonics at multiple positions.
+/*!
+ * Computes the acceleration due to a geodesy-normalized spherical harmonics expansion at a batch
+ * of positions, as computed for a single position by
+ * computeGeodesyNormalizedGravitationalAccelerationSum(). The positions are divided into chunks
+ * that are evaluated with a BatchSphericalHarmonicsWorkspace (vectorized over the positions of
+ * each chunk), and the chunks are divided over the requested number of threads.
+ * \param positions Cartesian positions, in the frame in which the expansion is defined (e.g.,
+ *          body-fixed frame); each column contains a single position.
+ * \param gravitationalParameter Gravitational parameter associated with the spherical harmonics
+ *          [m^3 s^-2].
+ * \param equatorialRadius Reference radius of the spherical harmonics [m].
+ * \param cosineHarmonicCoefficients Matrix with <B>geodesy-normalized</B> cosine harmonic
+ *          coefficients. The row index indicates the degree and the column index indicates the
+ *          order of coefficients.
+ * \param sineHarmonicCoefficients Matrix with <B>geodesy-normalized</B> sine harmonic
+ *          coefficients. The matrix must be equal in size to cosineHarmonicCoefficients.
+ * \param numberOfThreads Number of threads over which the evaluation is divided (default = 1).
+ * \return Cartesian accelerations; each column contains the acceleration at the position in the
+ *          corresponding column of positions.
+ */
+Eigen::Matrix3Xd computeBatchGeodesyNormalizedGravitationalAccelerationSum(
+        const Eigen::Matrix3Xd& positions,
+        const double gravitationalParameter,
+        const double equatorialRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        const int numberOfThreads = 1 );
+
+} // namespace gravitation
+} // namespace tudat
+
+#endif // TUDAT_BATCH_SPHERICAL_HARMONICS_GRAVITY_MODEL_H
@@ -26,6 +26,8 @@
  *      YYMMDD    Author            Comment
  *      121105    K. Kumar          File created from content in other files.
  *      121210    D. Dirkx          Added function implementations for class.
+ *      261018                      Evaluate class acceleration in single pass with
+ *                                  computeCentralAndZonalGravitationalAcceleration( ).
  *
  *    References
  *
@@ -36,6 +38,7 @@
 #include <cmath>
 
 #include "Tudat/Astrodynamics/BasicAstrodynamics/stateVectorIndices.h"
+#include "Tudat/Astrodynamics/Gravitation/centralZonalGravityModel.h"
 #include "Tudat/Astrodynamics/Gravitation/centralJ2J3GravityModel.h"
 
 namespace tudat
@@ -88,23 +91,13 @@ Eigen::Vector3d computeGravitationalAccelerationDueToJ3(
 //! Get gravitational acceleration.
 Eigen::Vector3d CentralJ2J3GravitationalAccelerationModel::getAcceleration( )
 {
-    // Sum and return constituent acceleration terms.
-    return computeGravitationalAcceleration(
-                this->positionOfBodySubjectToAcceleration,
-                this->gravitationalParameter,
-                this->positionOfBodyExertingAcceleration )
-            + computeGravitationalAccelerationDueToJ2(
-                this->positionOfBodySubjectToAcceleration,
-                this->gravitationalParameter,
-                this->equatorialRadius,
-                this->j2GravityCoefficient,
-                this->positionOfBodyExertingAcceleration )
-            + computeGravitationalAccelerationDueToJ3(
-                this->positionOfBodySubjectToAcceleration,
-                this->gravitationalParameter,
-                this->equatorialRadius,
-                this->j3GravityCoefficient,
-                this->positionOfBodyExertingAcceleration );
+    // Compute central and zonal terms in a single pass.
+    return computeCentralAndZonalGravitationalAcceleration< 3 >(
+                this->positionOfBodySubjectToAcceleration
+                - this->positionOfBodyExertingAcceleration,
+                this->gravitationalParameter, this->equatorialRadius,
+                Eigen::Matrix< double, 2, 1 >( this->j2GravityCoefficient,
+                                               this->j3GravityCoefficient ) );
 }
 
 } // namespace gravitation
@@ -26,6 +26,8 @@
  *      YYMMDD    Author            Comment
  *      121105    K. Kumar          File created from content in other files.
  *      121210    D. Dirkx          Added function implementations for class.
+ *      261018                      Evaluate class acceleration in single pass with
+ *                                  computeCentralAndZonalGravitationalAcceleration( ).
  *
  *    References
  *
@@ -39,6 +41,7 @@
 #include <boost/exception/all.hpp>
 
 #include "Tudat/Astrodynamics/BasicAstrodynamics/stateVectorIndices.h"
+#include "Tudat/Astrodynamics/Gravitation/centralZonalGravityModel.h"
 #include "Tudat/Astrodynamics/Gravitation/centralJ2J3J4GravityModel.h"
 
 namespace tudat
@@ -185,29 +188,14 @@ Eigen::Vector3d computeGravitationalAccelerationZonalSum(
 //! Get gravitational acceleration.
 Eigen::Vector3d CentralJ2J3J4GravitationalAccelerationModel::getAcceleration( )
 {
-    // Sum and return constituent acceleration terms.
-    return computeGravitationalAcceleration(
-                this->positionOfBodySubjectToAcceleration,
-                this->gravitationalParameter,
-                this->positionOfBodyExertingAcceleration )
-            + computeGravitationalAccelerationDueToJ2(
-                this->positionOfBodySubjectToAcceleration,
-                this->gravitationalParameter,
-                this->equatorialRadius,
-                this->j2GravityCoefficient,
-                this->positionOfBodyExertingAcceleration )
-            + computeGravitationalAccelerationDueToJ3(
-                this->positionOfBodySubjectToAcceleration,
-                this->gravitationalParameter,
-                this->equatorialRadius,
-                this->j3GravityCoefficient,
-                this->positionOfBodyExertingAcceleration )
-            + computeGravitationalAccelerationDueToJ4(
-                this->positionOfBodySubjectToAcceleration,
-                this->gravitationalParameter,
-                this->equatorialRadius,
-                this->j4GravityCoefficient,
-                this->positionOfBodyExertingAcceleration );
+    // Compute central and zonal terms in a single pass.
+    return computeCentralAndZonalGravitationalAcceleration< 4 >(
+                this->positionOfBodySubjectToAcceleration
+                - this->positionOfBodyExertingAcceleration,
+                this->gravitationalParameter, this->equatorialRadius,
+                Eigen::Matrix< double, 3, 1 >( this->j2GravityCoefficient,
+                                               this->j3GravityCoefficient,
+                                               this->j4GravityCoefficient ) );
 }
 
 } // namespace gravitation
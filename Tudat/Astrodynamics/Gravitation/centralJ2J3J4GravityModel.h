@@ -34,6 +34,7 @@
  *      130225    K. Kumar          Fixed bug with constructor calling virtual function function;
  *                                  updated free function order of arguments to match clss
  *                                  constructor; added override of updateMembers() function.
+ *      261018                      Updated description of getAcceleration( ).
  *
  *    References
  *
@@ -203,9 +204,8 @@ public:
     //! Get gravitational acceleration.
     /*!
      * Returns the gravitational acceleration computed using the input parameters provided to the
-     * class. This function serves as a wrapper for the computeGravitationalAcceleration(),
-     * computeGravitationalAccelerationDueToJ2(), and computeGravitationalAccelerationDueToJ3()
-     * functions.
+     * class. The central and zonal terms are evaluated in a single pass by
+     * computeCentralAndZonalGravitationalAcceleration( ).
      * \return Computed gravitational acceleration vector.
      */
     Eigen::Vector3d getAcceleration( );
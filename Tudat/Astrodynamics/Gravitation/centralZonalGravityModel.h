@@ -0,0 +1,290 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *
+ *    References
+ *      Montenbruck, O., Gill, E. Satellite Orbits, Corrected Third Printing, Springer, 2005.
+ *
+ *    Notes
+ *      The zonal terms are summed by a template recursion over the degree, so that the loop over
+ *      the degrees is fully unrolled by the compiler, and the Legendre polynomials, their
+ *      derivatives and the powers of R/r are carried from one degree to the next in registers.
+ *
+ */
+
+#ifndef TUDAT_CENTRAL_ZONAL_GRAVITY_MODEL_H
+#define TUDAT_CENTRAL_ZONAL_GRAVITY_MODEL_H
+
+#include <cmath>
+
+#include <boost/lambda/lambda.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModel.h"
+#include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModelBase.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+
+//! Template struct to add zonal terms of given degree and higher to acceleration factors.
+/*!
+ * Template struct to add the zonal terms of degree Degree up to and including degree MaxDegree
+ * to the radial and axial acceleration factors (see
+ * computeCentralAndZonalGravitationalAcceleration( )). The recursion over the degree is resolved
+ * at compile time; the specialization for IsFinished = true terminates the recursion.
+ * \tparam Degree Degree of zonal term that is added.
+ * \tparam MaxDegree Maximum degree of zonal terms.
+ * \tparam IsFinished Boolean denoting whether all zonal terms have been added.
+ */
+template< int Degree, int MaxDegree, bool IsFinished = ( Degree > MaxDegree ) >
+struct ZonalGravityTermSummation
+{
+    //! Add zonal term of current degree, and of all higher degrees.
+    /*!
+     * Adds zonal term of current degree to acceleration factors, and recursively adds the terms
+     * of all higher degrees.
+     * \param scaledZCoordinate z-coordinate divided by distance (sine of latitude).
+     * \param radiusRatio Ratio of equatorial radius and distance.
+     * \param zonalCoefficients Zonal coefficients J_2 to J_MaxDegree.
+     * \param previousRadiusRatioPower Ratio of equatorial radius and distance to the power
+     *          Degree - 1.
+     * \param previousLegendrePolynomial Legendre polynomial of degree Degree - 1.
+     * \param secondPreviousLegendrePolynomial Legendre polynomial of degree Degree - 2.
+     * \param previousLegendreDerivative Derivative of Legendre polynomial of degree Degree - 1.
+     * \param radialFactor Factor multiplying unit position vector (updated by reference).
+     * \param axialFactor Factor multiplying unit z-vector (updated by reference).
+     */
+    template< typename CoefficientVector >
+    static inline void addTerms( const double scaledZCoordinate, const double radiusRatio,
+                                 const CoefficientVector& zonalCoefficients,
+                                 const double previousRadiusRatioPower,
+                                 const double previousLegendrePolynomial,
+                                 const double secondPreviousLegendrePolynomial,
+                                 const double previousLegendreDerivative,
+                                 double& radialFactor, double& axialFactor )
+    {
+        const double degree = static_cast< double >( Degree );
+
+        // Compute Legendre polynomial and its derivative with Bonnet's recursion.
+        const double legendrePolynomial
+                = ( ( 2.0 * degree - 1.0 ) * scaledZCoordinate * previousLegendrePolynomial
+                    - ( degree - 1.0 ) * secondPreviousLegendrePolynomial ) / degree;
+        const double legendreDerivative = scaledZCoordinate * previousLegendreDerivative
+                + degree * previousLegendrePolynomial;
+
+        const double radiusRatioPower = previousRadiusRatioPower * radiusRatio;
+        const double scaledCoefficient = zonalCoefficients.coeff( Degree - 2 ) * radiusRatioPower;
+
+        radialFactor += scaledCoefficient * ( ( degree + 1.0 ) * legendrePolynomial
+                                              + scaledZCoordinate * legendreDerivative );
+        axialFactor -= scaledCoefficient * legendreDerivative;
+
+        ZonalGravityTermSummation< Degree + 1, MaxDegree >::addTerms(
+                    scaledZCoordinate, radiusRatio, zonalCoefficients, radiusRatioPower,
+                    legendrePolynomial, previousLegendrePolynomial, legendreDerivative,
+                    radialFactor, axialFactor );
+    }
+};
+
+//! Specialization of ZonalGravityTermSummation that terminates the recursion.
+template< int Degree, int MaxDegree >
+struct ZonalGravityTermSummation< Degree, MaxDegree, true >
+{
+    //! Add no further terms.
+    template< typename CoefficientVector >
+    static inline void addTerms( const double, const double, const CoefficientVector&,
+                                 const double, const double, const double, const double,
+                                 double&, double& )
+    { }
+};
+
+//! Compute central and zonal gravitational acceleration.
+/*!
+ * Computes the gravitational acceleration due to the central term and the zonal terms up to
+ * degree MaxDegree of a spherical harmonics gravity field, in a single pass (Montenbruck & Gill,
+ * 2005):
+ * \f[
+ *      \bar{a} = \frac{ \mu }{ r^{ 2 } } \left[ \left( -1 + \sum_{ n = 2 }^{ N } J_{ n }
+ *                \left( \frac{ R }{ r } \right)^{ n } \left( ( n + 1 ) P_{ n }( \hat{z} )
+ *                + \hat{z} P'_{ n }( \hat{z} ) \right) \right) \hat{r}
+ *                - \sum_{ n = 2 }^{ N } J_{ n } \left( \frac{ R }{ r } \right)^{ n }
+ *                P'_{ n }( \hat{z} ) \hat{k} \right]
+ * \f]
+ * where \f$ \hat{z} = z / r \f$, \f$ P_{ n } \f$ is the (unnormalized) Legendre polynomial of
+ * degree n, and \f$ \hat{k} \f$ is the unit vector along the z-axis of the frame in which the
+ * relative position is expressed (i.e., the rotation axis of the body exerting the
+ * acceleration). The square root and division are evaluated once, and all radial powers and
+ * Legendre polynomials are obtained by recursion.
+ * \tparam MaxDegree Maximum degree of zonal terms (at least 2).
+ * \param relativePosition Position of body subject to acceleration w.r.t. body exerting
+ *          acceleration [m].
+ * \param gravitationalParameter Gravitational parameter of body exerting acceleration
+ *          [m^3 s^-2].
+ * \param equatorialRadius Equatorial radius of body exerting acceleration [m].
+ * \param zonalCoefficients Unnormalized zonal coefficients J_2 to J_MaxDegree [-].
+ * \return Gravitational acceleration [m s^-2].
+ */
+template< int MaxDegree, typename CoefficientVector >
+Eigen::Vector3d computeCentralAndZonalGravitationalAcceleration(
+        const Eigen::Vector3d& relativePosition,
+        const double gravitationalParameter,
+        const double equatorialRadius,
+        const CoefficientVector& zonalCoefficients )
+{
+    static_assert( MaxDegree >= 2, "Maximum degree of zonal gravity model must be at least 2." );
+
+    const double inverseDistance = 1.0 / relativePosition.norm( );
+    const double scaledZCoordinate = relativePosition.z( ) * inverseDistance;
+    const double radiusRatio = equatorialRadius * inverseDistance;
+
+    // Start recursion from central term, with P_0 = 1, P_1 = z/r and P'_1 = 1.
+    double radialFactor = -1.0;
+    double axialFactor = 0.0;
+    ZonalGravityTermSummation< 2, MaxDegree >::addTerms(
+                scaledZCoordinate, radiusRatio, zonalCoefficients, radiusRatio,
+                scaledZCoordinate, 1.0, 1.0, radialFactor, axialFactor );
+
+    const double preMultiplier = gravitationalParameter * inverseDistance * inverseDistance;
+    Eigen::Vector3d acceleration = ( preMultiplier * radialFactor * inverseDistance )
+            * relativePosition;
+    acceleration.z( ) += preMultiplier * axialFactor;
+    return acceleration;
+}
+
+//! Template class for central and zonal gravitational acceleration model.
+/*!
+ * This template class implements a gravitational acceleration model that includes the central
+ * term and all zonal terms up to and including degree MaxDegree of the (unnormalized)
+ * spherical harmonics expansion, which are evaluated in a single pass by
+ * computeCentralAndZonalGravitationalAcceleration( ). The positions are assumed to be expressed
+ * in a frame of which the z-axis is along the rotation axis of the body exerting the
+ * acceleration.
+ * \tparam MaxDegree Maximum degree of zonal terms (at least 2).
+ */
+template< int MaxDegree >
+class CentralZonalGravitationalAccelerationModel
+        : public basic_astrodynamics::AccelerationModel< Eigen::Vector3d >,
+        public SphericalHarmonicsGravitationalAccelerationModelBase< Eigen::Vector3d >
+{
+private:
+
+    //! Typedef for base class.
+    typedef SphericalHarmonicsGravitationalAccelerationModelBase< Eigen::Vector3d > Base;
+
+public:
+
+    //! Typedef for vector of zonal coefficients J_2 to J_MaxDegree.
+    typedef Eigen::Matrix< double, MaxDegree - 1, 1, Eigen::DontAlign > ZonalCoefficientVector;
+
+    //! Constructor taking position-functions for bodies, and constant parameters of spherical
+    //! harmonics expansion.
+    /*!
+     * Constructor taking a pointer to a function returning the position of the body subject to
+     * gravitational acceleration, constant gravitational parameter, equatorial radius and zonal
+     * coefficients of the body exerting the acceleration, and a pointer to a function returning
+     * the position of the body exerting the gravitational acceleration (typically the central
+     * body). The constructor also updates all the internal members. The position of the body
+     * exerting the gravitational acceleration is an optional parameter; the default position is
+     * the origin.
+     * \param positionOfBodySubjectToAccelerationFunction Pointer to function returning position of
+     *          body subject to gravitational acceleration.
+     * \param aGravitationalParameter A (constant) gravitational parameter [m^2 s^-3].
+     * \param anEquatorialRadius A (constant) equatorial radius [m].
+     * \param someZonalCoefficients (Constant) zonal coefficients J_2 to J_MaxDegree.
+     * \param positionOfBodyExertingAccelerationFunction Pointer to function returning position of
+     *          body exerting gravitational acceleration (default = (0,0,0)).
+     */
+    CentralZonalGravitationalAccelerationModel(
+            const StateFunction positionOfBodySubjectToAccelerationFunction,
+            const double aGravitationalParameter,
+            const double anEquatorialRadius,
+            const ZonalCoefficientVector& someZonalCoefficients,
+            const StateFunction positionOfBodyExertingAccelerationFunction
+            = boost::lambda::constant( Eigen::Vector3d::Zero( ) ) )
+        : Base( positionOfBodySubjectToAccelerationFunction,
+                aGravitationalParameter,
+                positionOfBodyExertingAccelerationFunction ),
+          equatorialRadius( anEquatorialRadius ),
+          zonalCoefficients( someZonalCoefficients )
+    {
+        this->updateMembers( );
+    }
+
+    //! Get gravitational acceleration.
+    /*!
+     * Returns the gravitational acceleration due to the central and zonal terms, computed using
+     * the input parameters provided to the class.
+     * \return Computed gravitational acceleration vector.
+     */
+    Eigen::Vector3d getAcceleration( )
+    {
+        return computeCentralAndZonalGravitationalAcceleration< MaxDegree >(
+                    this->positionOfBodySubjectToAcceleration
+                    - this->positionOfBodyExertingAcceleration,
+                    this->gravitationalParameter, equatorialRadius, zonalCoefficients );
+    }
+
+    //! Update members.
+    /*!
+     * Updates class members relevant for computing the gravitational acceleration. In this case
+     * the function simply updates the members in the base class.
+     * \sa SphericalHarmonicsGravitationalAccelerationModelBase.
+     */
+    void updateMembers( ) { this->updateBaseMembers( ); }
+
+    //! Get zonal coefficients.
+    /*!
+     * Returns the zonal coefficients J_2 to J_MaxDegree.
+     * \return Zonal coefficients.
+     */
+    ZonalCoefficientVector getZonalCoefficients( ) { return zonalCoefficients; }
+
+protected:
+
+    //! Equatorial radius [m].
+    /*!
+     * Equatorial radius of unnormalized spherical harmonics gravity field representation [m].
+     */
+    const double equatorialRadius;
+
+    //! Zonal coefficients J_2 to J_MaxDegree.
+    /*!
+     * Zonal coefficients of unnormalized spherical harmonics gravity field representation.
+     */
+    const ZonalCoefficientVector zonalCoefficients;
+
+private:
+};
+
+} // namespace gravitation
+} // namespace tudat
+
+#endif // TUDAT_CENTRAL_ZONAL_GRAVITY_MODEL_H
@@ -36,6 +36,7 @@
  *      120502    K. Kumar          Added missing constructor initialization of position vectors.
  *      130121    K. Kumar          Added shared-ptr typedef.
  *      15YOLO    D. Dirkx          Changed some stuff.
+ *      261018                      Made gravitational potential function virtual.
  *
  *    References
  *
@@ -107,7 +108,7 @@ public:
      * \param bodyFixedPosition Position at which the gravitational potential is to be evaluated.
      * \return Gravitational potential.
      */
-    double getGravitationalPotential( const Eigen::Vector3d& bodyFixedPosition )
+    virtual double getGravitationalPotential( const Eigen::Vector3d& bodyFixedPosition )
     {
         return gravitationalParameter_ / bodyFixedPosition.norm( );
     }
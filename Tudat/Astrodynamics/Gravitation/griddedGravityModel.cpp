@@ -0,0 +1,374 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Evaluate expansion in caller-owned workspace.
+ *
+ *    References
+ *      Press, W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing. Cambridge
+ *          University Press, February 2002.
+ *      Roberts, M. The Unreasonable Effectiveness of Quasirandom Sequences,
+ *          http://extremelearning.com.au/unreasonable-effectiveness-of-quasirandom-sequences/,
+ *          2018.
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+#include <boost/make_shared.hpp>
+
+#include "Tudat/Astrodynamics/Gravitation/centralGravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/griddedGravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/pinesSphericalHarmonicsGravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModel.h"
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+
+//! Compute weights of cubic Lagrange interpolation on four equidistant nodes.
+/*!
+ * Computes the weights of cubic Lagrange interpolation on four equidistant nodes, located at
+ * normalized coordinates 0, 1, 2 and 3 (Press et al., 2002).
+ * \param normalizedCoordinate Normalized coordinate at which interpolation is performed.
+ * \param weights Interpolation weights of the four nodes (returned by reference).
+ */
+inline void computeCubicLagrangeWeights( const double normalizedCoordinate, double weights[ 4 ] )
+{
+    const double x0 = normalizedCoordinate;
+    const double x1 = normalizedCoordinate - 1.0;
+    const double x2 = normalizedCoordinate - 2.0;
+    const double x3 = normalizedCoordinate - 3.0;
+    weights[ 0 ] = -x1 * x2 * x3 / 6.0;
+    weights[ 1 ] = x0 * x2 * x3 / 2.0;
+    weights[ 2 ] = -x0 * x1 * x3 / 2.0;
+    weights[ 3 ] = x0 * x1 * x2 / 6.0;
+}
+
+//! Constructor.
+SphericalHarmonicsAccelerationGrid::SphericalHarmonicsAccelerationGrid(
+        const double gravitationalParameter,
+        const double referenceRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        const double minimumRadius,
+        const double maximumRadius,
+        const int numberOfRadialIntervals,
+        const int numberOfLatitudeIntervals,
+        const int numberOfLongitudeIntervals )
+    : gravitationalParameter_( gravitationalParameter ),
+      referenceRadius_( referenceRadius ),
+      cosineHarmonicCoefficients_( cosineHarmonicCoefficients ),
+      sineHarmonicCoefficients_( sineHarmonicCoefficients ),
+      minimumRadius_( minimumRadius ),
+      maximumRadius_( maximumRadius ),
+      numberOfRadialIntervals_( numberOfRadialIntervals ),
+      numberOfLatitudeIntervals_( numberOfLatitudeIntervals ),
+      numberOfLongitudeIntervals_( numberOfLongitudeIntervals ),
+      radialStepSize_( ( maximumRadius - minimumRadius ) / numberOfRadialIntervals ),
+      latitudeStepSize_( mathematical_constants::PI / numberOfLatitudeIntervals ),
+      longitudeStepSize_( 2.0 * mathematical_constants::PI / numberOfLongitudeIntervals ),
+      numberOfLatitudeNodes_( numberOfLatitudeIntervals + 3 ),
+      numberOfLongitudeNodes_( numberOfLongitudeIntervals + 3 ),
+      verifiedMaximumError_( -1.0 )
+{
+    if ( minimumRadius_ < referenceRadius_ || maximumRadius_ <= minimumRadius_ )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, shell of acceleration grid must be outside reference sphere "
+                            "of spherical harmonics expansion, and have non-zero thickness." ) ) );
+    }
+
+    if ( numberOfRadialIntervals_ < 3 || numberOfLatitudeIntervals_ < 2
+         || numberOfLongitudeIntervals_ < 4 )
+    {
+        std::stringstream errorMessage;
+        errorMessage << "Error, acceleration grid requires at least 3 radial, 2 latitude and 4 "
+                     << "longitude intervals, but " << numberOfRadialIntervals_ << ", "
+                     << numberOfLatitudeIntervals_ << " and " << numberOfLongitudeIntervals_
+                     << " were provided." << std::endl;
+        boost::throw_exception( boost::enable_error_info( std::runtime_error(
+                                                              errorMessage.str( ) ) ) );
+    }
+
+    // Remove central term from expansion.
+    if ( cosineHarmonicCoefficients_.size( ) > 0 )
+    {
+        cosineHarmonicCoefficients_( 0, 0 ) = 0.0;
+    }
+
+    // Evaluate perturbing acceleration at all grid nodes. The singularity-free Pines formulation
+    // is used, since the grid contains nodes on the polar axis.
+    PinesSphericalHarmonicsWorkspace pinesWorkspace( getMaximumDegree( ), getMaximumOrder( ) );
+    nodeAccelerations_.resize( 3, ( numberOfRadialIntervals_ + 1 ) * numberOfLatitudeNodes_
+                               * numberOfLongitudeNodes_ );
+    int nodeIndex = 0;
+    for ( int radialIndex = 0; radialIndex <= numberOfRadialIntervals_; radialIndex++ )
+    {
+        for ( int latitudeIndex = 0; latitudeIndex < numberOfLatitudeNodes_; latitudeIndex++ )
+        {
+            for ( int longitudeIndex = 0; longitudeIndex < numberOfLongitudeNodes_;
+                  longitudeIndex++ )
+            {
+                nodeAccelerations_.col( nodeIndex )
+                        = computePinesGeodesyNormalizedGravitationalAccelerationSum(
+                            getNodePosition( radialIndex, latitudeIndex, longitudeIndex ),
+                            gravitationalParameter_, referenceRadius_,
+                            cosineHarmonicCoefficients_, sineHarmonicCoefficients_,
+                            pinesWorkspace );
+                nodeIndex++;
+            }
+        }
+    }
+}
+
+//! Interpolate perturbing acceleration.
+Eigen::Vector3d SphericalHarmonicsAccelerationGrid::interpolatePerturbingAcceleration(
+        const Eigen::Vector3d& position ) const
+{
+    const double horizontalDistance = std::sqrt( position.x( ) * position.x( )
+                                                 + position.y( ) * position.y( ) );
+    const double radius = std::sqrt( horizontalDistance * horizontalDistance
+                                     + position.z( ) * position.z( ) );
+    const double latitude = std::atan2( position.z( ), horizontalDistance );
+    const double longitude = std::atan2( position.y( ), position.x( ) );
+
+    // Determine first node of radial stencil; at the boundaries of the shell, the stencil is
+    // shifted inwards (one-sided interpolation).
+    const double radialCoordinate = ( radius - minimumRadius_ ) / radialStepSize_;
+    const int radialStartIndex = std::min( std::max(
+                static_cast< int >( std::floor( radialCoordinate ) ) - 1, 0 ),
+                                           numberOfRadialIntervals_ - 3 );
+
+    // Determine first node of latitude and longitude stencils (in grid including ghost nodes).
+    const double latitudeCoordinate
+            = ( latitude + 0.5 * mathematical_constants::PI ) / latitudeStepSize_;
+    const int latitudeStartIndex = std::min( std::max(
+                static_cast< int >( std::floor( latitudeCoordinate ) ), 0 ),
+                                             numberOfLatitudeIntervals_ - 1 );
+    const double longitudeCoordinate
+            = ( longitude + mathematical_constants::PI ) / longitudeStepSize_;
+    const int longitudeStartIndex = std::min( std::max(
+                static_cast< int >( std::floor( longitudeCoordinate ) ), 0 ),
+                                              numberOfLongitudeIntervals_ - 1 );
+
+    // Compute interpolation weights.
+    double radialWeights[ 4 ], latitudeWeights[ 4 ], longitudeWeights[ 4 ];
+    computeCubicLagrangeWeights( radialCoordinate - radialStartIndex, radialWeights );
+    computeCubicLagrangeWeights( latitudeCoordinate - latitudeStartIndex + 1.0, latitudeWeights );
+    computeCubicLagrangeWeights( longitudeCoordinate - longitudeStartIndex + 1.0,
+                                 longitudeWeights );
+
+    // Sum weighted accelerations of 4x4x4 surrounding nodes.
+    Eigen::Vector3d acceleration = Eigen::Vector3d::Zero( );
+    for ( int i = 0; i < 4; i++ )
+    {
+        for ( int j = 0; j < 4; j++ )
+        {
+            const double radialLatitudeWeight = radialWeights[ i ] * latitudeWeights[ j ];
+            const int firstNodeIndex = ( ( radialStartIndex + i ) * numberOfLatitudeNodes_
+                                         + latitudeStartIndex + j ) * numberOfLongitudeNodes_
+                    + longitudeStartIndex;
+            for ( int k = 0; k < 4; k++ )
+            {
+                acceleration += ( radialLatitudeWeight * longitudeWeights[ k ] )
+                        * nodeAccelerations_.col( firstNodeIndex + k );
+            }
+        }
+    }
+
+    return acceleration;
+}
+
+//! Compute perturbing acceleration from spherical harmonics expansion.
+Eigen::Vector3d SphericalHarmonicsAccelerationGrid::computePerturbingAcceleration(
+        const Eigen::Vector3d& position,
+        basic_mathematics::SphericalHarmonicsWorkspace& sphericalHarmonicsWorkspace ) const
+{
+    return computeGeodesyNormalizedGravitationalAccelerationSum(
+                position, gravitationalParameter_, referenceRadius_,
+                cosineHarmonicCoefficients_, sineHarmonicCoefficients_,
+                sphericalHarmonicsWorkspace );
+}
+
+//! Compute maximum interpolation error.
+double SphericalHarmonicsAccelerationGrid::computeMaximumInterpolationError(
+        const int numberOfTestPoints )
+{
+    // Set increments of three-dimensional Kronecker (R3) sequence (Roberts, 2018).
+    const double generalizedGoldenRatio = 1.22074408460575947536;
+    const Eigen::Vector3d sequenceIncrements(
+                1.0 / generalizedGoldenRatio,
+                1.0 / ( generalizedGoldenRatio * generalizedGoldenRatio ),
+                1.0 / ( generalizedGoldenRatio * generalizedGoldenRatio
+                        * generalizedGoldenRatio ) );
+
+    const double minimumRadiusCubed = minimumRadius_ * minimumRadius_ * minimumRadius_;
+    const double maximumRadiusCubed = maximumRadius_ * maximumRadius_ * maximumRadius_;
+
+    basic_mathematics::SphericalHarmonicsWorkspace sphericalHarmonicsWorkspace(
+                getMaximumDegree( ), getMaximumOrder( ) );
+
+    double maximumError = 0.0;
+    for ( int i = 0; i < numberOfTestPoints; i++ )
+    {
+        // Map point of sequence to shell, uniformly distributed over volume.
+        Eigen::Vector3d unitCubePoint;
+        for ( int j = 0; j < 3; j++ )
+        {
+            const double sequenceValue = 0.5 + sequenceIncrements( j ) * ( i + 1 );
+            unitCubePoint( j ) = sequenceValue - std::floor( sequenceValue );
+        }
+        double radius = std::cbrt( minimumRadiusCubed + unitCubePoint( 0 )
+                                   * ( maximumRadiusCubed - minimumRadiusCubed ) );
+        double latitude = std::asin( 2.0 * unitCubePoint( 1 ) - 1.0 );
+        double longitude = 2.0 * mathematical_constants::PI * unitCubePoint( 2 )
+                - mathematical_constants::PI;
+
+        for ( int pointType = 0; pointType < 2; pointType++ )
+        {
+            // Move every second test point to center of the grid cell that contains it.
+            if ( pointType == 1 )
+            {
+                radius = minimumRadius_ + radialStepSize_ * (
+                            std::min( std::floor( ( radius - minimumRadius_ ) / radialStepSize_ ),
+                                      numberOfRadialIntervals_ - 1.0 ) + 0.5 );
+                latitude = -0.5 * mathematical_constants::PI + latitudeStepSize_ * (
+                            std::min( std::floor( ( latitude + 0.5 * mathematical_constants::PI )
+                                                  / latitudeStepSize_ ),
+                                      numberOfLatitudeIntervals_ - 1.0 ) + 0.5 );
+                longitude = -mathematical_constants::PI + longitudeStepSize_ * (
+                            std::min( std::floor( ( longitude + mathematical_constants::PI )
+                                                  / longitudeStepSize_ ),
+                                      numberOfLongitudeIntervals_ - 1.0 ) + 0.5 );
+            }
+
+            const Eigen::Vector3d position
+                    = radius * Eigen::Vector3d( std::cos( latitude ) * std::cos( longitude ),
+                                                std::cos( latitude ) * std::sin( longitude ),
+                                                std::sin( latitude ) );
+            maximumError = std::max(
+                        maximumError, ( interpolatePerturbingAcceleration( position )
+                                        - computePerturbingAcceleration(
+                                              position, sphericalHarmonicsWorkspace ) ).norm( ) );
+        }
+    }
+
+    verifiedMaximumError_ = maximumError;
+    return maximumError;
+}
+
+//! Get position of grid node.
+Eigen::Vector3d SphericalHarmonicsAccelerationGrid::getNodePosition(
+        const int radialIndex, const int latitudeIndex, const int longitudeIndex ) const
+{
+    // Latitudes beyond the poles and longitudes beyond the date line (ghost nodes) are mapped to
+    // the correct positions by the conversion to Cartesian coordinates.
+    const double radius = minimumRadius_ + radialIndex * radialStepSize_;
+    const double latitude = -0.5 * mathematical_constants::PI
+            + ( latitudeIndex - 1 ) * latitudeStepSize_;
+    const double longitude = -mathematical_constants::PI
+            + ( longitudeIndex - 1 ) * longitudeStepSize_;
+
+    return radius * Eigen::Vector3d( std::cos( latitude ) * std::cos( longitude ),
+                                     std::cos( latitude ) * std::sin( longitude ),
+                                     std::sin( latitude ) );
+}
+
+//! Create spherical harmonics acceleration grid satisfying error bound.
+SphericalHarmonicsAccelerationGridPointer createSphericalHarmonicsAccelerationGrid(
+        const double gravitationalParameter, const double referenceRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        const double minimumRadius, const double maximumRadius, const double tolerance,
+        const int initialNumberOfRadialIntervals, const int initialNumberOfLatitudeIntervals,
+        const int initialNumberOfLongitudeIntervals, const int numberOfTestPoints,
+        const int maximumNumberOfRefinements )
+{
+    int numberOfRadialIntervals = initialNumberOfRadialIntervals;
+    int numberOfLatitudeIntervals = initialNumberOfLatitudeIntervals;
+    int numberOfLongitudeIntervals = initialNumberOfLongitudeIntervals;
+
+    for ( int refinement = 0; refinement <= maximumNumberOfRefinements; refinement++ )
+    {
+        SphericalHarmonicsAccelerationGridPointer accelerationGrid
+                = boost::make_shared< SphericalHarmonicsAccelerationGrid >(
+                    gravitationalParameter, referenceRadius, cosineHarmonicCoefficients,
+                    sineHarmonicCoefficients, minimumRadius, maximumRadius,
+                    numberOfRadialIntervals, numberOfLatitudeIntervals,
+                    numberOfLongitudeIntervals );
+
+        if ( accelerationGrid->computeMaximumInterpolationError( numberOfTestPoints )
+             <= tolerance )
+        {
+            return accelerationGrid;
+        }
+
+        // Refine grid by factor 1.5 in all directions.
+        numberOfRadialIntervals = ( 3 * numberOfRadialIntervals + 1 ) / 2;
+        numberOfLatitudeIntervals = ( 3 * numberOfLatitudeIntervals + 1 ) / 2;
+        numberOfLongitudeIntervals = ( 3 * numberOfLongitudeIntervals + 1 ) / 2;
+    }
+
+    std::stringstream errorMessage;
+    errorMessage << "Error, acceleration grid with interpolation error below " << tolerance
+                 << " m/s^2 not found in " << maximumNumberOfRefinements << " refinements."
+                 << std::endl;
+    boost::throw_exception( boost::enable_error_info( std::runtime_error(
+                                                          errorMessage.str( ) ) ) );
+}
+
+//! Get gravitational acceleration.
+Eigen::Vector3d GriddedGravitationalAccelerationModel::getAcceleration( )
+{
+    const Eigen::Vector3d relativePosition = this->positionOfBodySubjectToAcceleration
+            - this->positionOfBodyExertingAcceleration;
+
+    const Eigen::Vector3d centralAcceleration = computeGravitationalAcceleration(
+                relativePosition, gravitationalParameter );
+
+    if ( accelerationGrid_->isPositionInGrid( relativePosition ) )
+    {
+        return centralAcceleration
+                + accelerationGrid_->interpolatePerturbingAcceleration( relativePosition );
+    }
+
+    return centralAcceleration + accelerationGrid_->computePerturbingAcceleration(
+                relativePosition, sphericalHarmonicsWorkspace_ );
+}
+
+} // namespace gravitation
+} // namespace tudat
@@ -0,0 +1,440 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Moved spherical harmonics workspace from (shared) grid to
+ *                                  acceleration model.
+ *
+ *    References
+ *      Press, W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing. Cambridge
+ *          University Press, February 2002.
+ *
+ *    Notes
+ *      The acceleration grid is defined in the frame in which the spherical harmonic coefficients
+ *      are defined (i.e., typically body-fixed), in the same manner as for the
+ *      SphericalHarmonicsGravitationalAccelerationModel.
+ *
+ *      The interpolated quantities are the Cartesian components of the perturbing acceleration,
+ *      which are smooth functions of position, also at the poles. The grid in latitude and
+ *      longitude is extended by ghost nodes beyond the poles and the date line, which are
+ *      evaluated directly from the spherical harmonic expansion, so that the same cubic stencil
+ *      can be used everywhere in the grid.
+ *
+ */
+
+#ifndef TUDAT_GRIDDED_GRAVITY_MODEL_H
+#define TUDAT_GRIDDED_GRAVITY_MODEL_H
+
+#include <algorithm>
+
+#include <boost/lambda/lambda.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModel.h"
+#include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModelBase.h"
+#include "Tudat/Mathematics/BasicMathematics/sphericalHarmonics.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+
+//! Class containing a precomputed grid of spherical harmonics perturbing accelerations.
+/*!
+ * Class containing the perturbing (i.e., non-central) gravitational acceleration due to a
+ * spherical harmonics expansion, precomputed on a regular grid in radius, latitude and longitude
+ * over a spherical shell. Inside the shell, the acceleration is obtained by tricubic (Lagrange)
+ * interpolation of the Cartesian acceleration components on the 4x4x4 nodes surrounding the
+ * evaluation point, which requires a few hundred floating-point operations, independent of the
+ * degree and order of the expansion. The interpolation error can be verified against the
+ * spherical harmonics expansion with computeMaximumInterpolationError(), and a grid satisfying a
+ * given error bound can be created with createSphericalHarmonicsAccelerationGrid().
+ */
+class SphericalHarmonicsAccelerationGrid
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, precomputes the perturbing acceleration at all nodes of the grid. The central
+     * (degree zero) term of the expansion is not included in the grid.
+     * \param gravitationalParameter Gravitational parameter of the body [m^3 s^-2].
+     * \param referenceRadius Reference radius of the spherical harmonics expansion [m].
+     * \param cosineHarmonicCoefficients Geodesy-normalized cosine coefficients.
+     * \param sineHarmonicCoefficients Geodesy-normalized sine coefficients.
+     * \param minimumRadius Inner radius of the shell covered by the grid [m].
+     * \param maximumRadius Outer radius of the shell covered by the grid [m].
+     * \param numberOfRadialIntervals Number of grid intervals in radial direction.
+     * \param numberOfLatitudeIntervals Number of grid intervals in latitude (from pole to pole).
+     * \param numberOfLongitudeIntervals Number of grid intervals in longitude.
+     */
+    SphericalHarmonicsAccelerationGrid( const double gravitationalParameter,
+                                        const double referenceRadius,
+                                        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+                                        const Eigen::MatrixXd& sineHarmonicCoefficients,
+                                        const double minimumRadius,
+                                        const double maximumRadius,
+                                        const int numberOfRadialIntervals,
+                                        const int numberOfLatitudeIntervals,
+                                        const int numberOfLongitudeIntervals );
+
+    //! Check whether position is inside grid.
+    /*!
+     * Checks whether position is inside the shell covered by the grid.
+     * \param position Position at which acceleration is to be evaluated, in frame of coefficients.
+     * \return True if position is inside the shell covered by the grid.
+     */
+    bool isPositionInGrid( const Eigen::Vector3d& position ) const
+    {
+        const double radius = position.norm( );
+        return ( radius >= minimumRadius_ && radius <= maximumRadius_ );
+    }
+
+    //! Interpolate perturbing acceleration.
+    /*!
+     * Computes the perturbing acceleration by tricubic interpolation of the grid. The position
+     * must be inside the grid (see isPositionInGrid()); no check is performed.
+     * \param position Position at which acceleration is to be evaluated, in frame of coefficients.
+     * \return Interpolated perturbing acceleration.
+     */
+    Eigen::Vector3d interpolatePerturbingAcceleration( const Eigen::Vector3d& position ) const;
+
+    //! Compute perturbing acceleration from spherical harmonics expansion.
+    /*!
+     * Computes the perturbing acceleration directly from the spherical harmonics expansion, as
+     * used to generate the grid. This is used to verify the grid, and outside of the grid. Since
+     * a grid may be shared between acceleration models (and threads), the workspace in which the
+     * expansion is evaluated is provided by the caller.
+     * \param position Position at which acceleration is to be evaluated, in frame of coefficients.
+     * \param sphericalHarmonicsWorkspace Workspace in which expansion is evaluated, of at least
+     *          the maximum degree and order of the grid.
+     * \return Perturbing acceleration.
+     */
+    Eigen::Vector3d computePerturbingAcceleration(
+            const Eigen::Vector3d& position,
+            basic_mathematics::SphericalHarmonicsWorkspace& sphericalHarmonicsWorkspace ) const;
+
+    //! Compute perturbing acceleration from spherical harmonics expansion.
+    /*!
+     * Computes the perturbing acceleration directly from the spherical harmonics expansion, using
+     * the spherical harmonics workspace of the current thread.
+     * \param position Position at which acceleration is to be evaluated, in frame of coefficients.
+     * \return Perturbing acceleration.
+     */
+    Eigen::Vector3d computePerturbingAcceleration( const Eigen::Vector3d& position ) const
+    {
+        return computePerturbingAcceleration(
+                    position, basic_mathematics::getSphericalHarmonicsWorkspace(
+                        getMaximumDegree( ), getMaximumOrder( ) ) );
+    }
+
+    //! Compute maximum interpolation error.
+    /*!
+     * Computes the maximum norm of the difference between the interpolated and directly computed
+     * perturbing acceleration over a set of test points. The test points are distributed
+     * quasi-randomly (with a Kronecker sequence) and uniformly over the volume of the shell, and
+     * are supplemented by the centers of a subset of grid cells, at which the interpolation error
+     * is typically largest. The result is stored, and can be retrieved with
+     * getVerifiedMaximumError().
+     * \param numberOfTestPoints Number of quasi-random test points.
+     * \return Maximum norm of interpolation error [m s^-2].
+     */
+    double computeMaximumInterpolationError( const int numberOfTestPoints );
+
+    //! Get maximum interpolation error, from last verification.
+    /*!
+     * Returns maximum interpolation error, as computed by the last call to
+     * computeMaximumInterpolationError(); a negative value is returned if the grid has not been
+     * verified.
+     * \return Maximum norm of interpolation error [m s^-2].
+     */
+    double getVerifiedMaximumError( ) const { return verifiedMaximumError_; }
+
+    //! Get gravitational parameter.
+    /*!
+     * Returns gravitational parameter.
+     * \return Gravitational parameter [m^3 s^-2].
+     */
+    double getGravitationalParameter( ) const { return gravitationalParameter_; }
+
+    //! Get maximum degree of spherical harmonics expansion.
+    /*!
+     * Returns maximum degree of spherical harmonics expansion from which grid is computed.
+     * \return Maximum degree of expansion.
+     */
+    int getMaximumDegree( ) const
+    {
+        return std::max( static_cast< int >( cosineHarmonicCoefficients_.rows( ) ) - 1, 0 );
+    }
+
+    //! Get maximum order of spherical harmonics expansion.
+    /*!
+     * Returns maximum order of spherical harmonics expansion from which grid is computed.
+     * \return Maximum order of expansion.
+     */
+    int getMaximumOrder( ) const
+    {
+        return std::max( static_cast< int >( cosineHarmonicCoefficients_.cols( ) ) - 1, 0 );
+    }
+
+    //! Get inner radius of shell covered by the grid.
+    /*!
+     * Returns inner radius of shell covered by the grid.
+     * \return Inner radius of shell [m].
+     */
+    double getMinimumRadius( ) const { return minimumRadius_; }
+
+    //! Get outer radius of shell covered by the grid.
+    /*!
+     * Returns outer radius of shell covered by the grid.
+     * \return Outer radius of shell [m].
+     */
+    double getMaximumRadius( ) const { return maximumRadius_; }
+
+    //! Get number of grid intervals in radial direction.
+    /*!
+     * Returns number of grid intervals in radial direction.
+     * \return Number of grid intervals in radial direction.
+     */
+    int getNumberOfRadialIntervals( ) const { return numberOfRadialIntervals_; }
+
+    //! Get number of grid intervals in latitude.
+    /*!
+     * Returns number of grid intervals in latitude.
+     * \return Number of grid intervals in latitude.
+     */
+    int getNumberOfLatitudeIntervals( ) const { return numberOfLatitudeIntervals_; }
+
+    //! Get number of grid intervals in longitude.
+    /*!
+     * Returns number of grid intervals in longitude.
+     * \return Number of grid intervals in longitude.
+     */
+    int getNumberOfLongitudeIntervals( ) const { return numberOfLongitudeIntervals_; }
+
+protected:
+
+private:
+
+    //! Get position of grid node.
+    /*!
+     * Returns position of grid node, where the indices include the ghost nodes (i.e., index 1
+     * corresponds to the first node inside the grid).
+     * \param radialIndex Radial index of node.
+     * \param latitudeIndex Latitude index of node.
+     * \param longitudeIndex Longitude index of node.
+     * \return Position of grid node.
+     */
+    Eigen::Vector3d getNodePosition( const int radialIndex, const int latitudeIndex,
+                                     const int longitudeIndex ) const;
+
+    //! Gravitational parameter [m^3 s^-2].
+    const double gravitationalParameter_;
+
+    //! Reference radius [m].
+    const double referenceRadius_;
+
+    //! Geodesy-normalized cosine coefficients, without central term.
+    Eigen::MatrixXd cosineHarmonicCoefficients_;
+
+    //! Geodesy-normalized sine coefficients.
+    const Eigen::MatrixXd sineHarmonicCoefficients_;
+
+    //! Inner radius of shell [m].
+    const double minimumRadius_;
+
+    //! Outer radius of shell [m].
+    const double maximumRadius_;
+
+    //! Number of grid intervals in radial direction.
+    const int numberOfRadialIntervals_;
+
+    //! Number of grid intervals in latitude.
+    const int numberOfLatitudeIntervals_;
+
+    //! Number of grid intervals in longitude.
+    const int numberOfLongitudeIntervals_;
+
+    //! Radial grid spacing [m].
+    const double radialStepSize_;
+
+    //! Latitude grid spacing [rad].
+    const double latitudeStepSize_;
+
+    //! Longitude grid spacing [rad].
+    const double longitudeStepSize_;
+
+    //! Number of latitude nodes, including ghost nodes.
+    const int numberOfLatitudeNodes_;
+
+    //! Number of longitude nodes, including ghost nodes.
+    const int numberOfLongitudeNodes_;
+
+    //! Perturbing accelerations at grid nodes (including ghost nodes), one per column.
+    /*!
+     * Perturbing accelerations at grid nodes (including ghost nodes), one per column, ordered
+     * with longitude index varying fastest, and radial index slowest.
+     */
+    Eigen::Matrix3Xd nodeAccelerations_;
+
+    //! Maximum interpolation error from last verification [m s^-2].
+    double verifiedMaximumError_;
+};
+
+//! Typedef for shared-pointer to SphericalHarmonicsAccelerationGrid object.
+typedef boost::shared_ptr< SphericalHarmonicsAccelerationGrid >
+SphericalHarmonicsAccelerationGridPointer;
+
+//! Create spherical harmonics acceleration grid satisfying error bound.
+/*!
+ * Creates a spherical harmonics acceleration grid, of which the interpolation error is verified
+ * to be below the given tolerance. Starting from the given numbers of intervals, the number of
+ * intervals in all directions is increased by a factor 1.5 until the verified maximum
+ * interpolation error (see SphericalHarmonicsAccelerationGrid::computeMaximumInterpolationError())
+ * is below the tolerance. The initial numbers of intervals of a suitable grid scale with the
+ * maximum degree of the expansion; a good first guess is one to two intervals per degree in
+ * latitude and twice that in longitude.
+ * \param gravitationalParameter Gravitational parameter of the body [m^3 s^-2].
+ * \param referenceRadius Reference radius of the spherical harmonics expansion [m].
+ * \param cosineHarmonicCoefficients Geodesy-normalized cosine coefficients.
+ * \param sineHarmonicCoefficients Geodesy-normalized sine coefficients.
+ * \param minimumRadius Inner radius of the shell covered by the grid [m].
+ * \param maximumRadius Outer radius of the shell covered by the grid [m].
+ * \param tolerance Maximum allowed norm of interpolation error [m s^-2].
+ * \param initialNumberOfRadialIntervals Initial number of grid intervals in radial direction.
+ * \param initialNumberOfLatitudeIntervals Initial number of grid intervals in latitude.
+ * \param initialNumberOfLongitudeIntervals Initial number of grid intervals in longitude.
+ * \param numberOfTestPoints Number of quasi-random test points used for verification
+ *          (default = 1000).
+ * \param maximumNumberOfRefinements Maximum number of grid refinements; an exception is thrown if
+ *          the tolerance is not reached (default = 6).
+ * \return Spherical harmonics acceleration grid.
+ */
+SphericalHarmonicsAccelerationGridPointer createSphericalHarmonicsAccelerationGrid(
+        const double gravitationalParameter, const double referenceRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        const double minimumRadius, const double maximumRadius, const double tolerance,
+        const int initialNumberOfRadialIntervals, const int initialNumberOfLatitudeIntervals,
+        const int initialNumberOfLongitudeIntervals, const int numberOfTestPoints = 1000,
+        const int maximumNumberOfRefinements = 6 );
+
+//! Class for gravitational acceleration interpolated from precomputed grid.
+/*!
+ * Class for the gravitational acceleration of a body with a spherical harmonics gravity field,
+ * in which the central term is evaluated analytically, and the perturbing acceleration is
+ * interpolated from a precomputed SphericalHarmonicsAccelerationGrid. Outside of the shell
+ * covered by the grid, the perturbing acceleration is evaluated directly from the spherical
+ * harmonics expansion, so that the model can be used over the complete trajectory.
+ */
+class GriddedGravitationalAccelerationModel
+        : public basic_astrodynamics::AccelerationModel< Eigen::Vector3d >,
+        public SphericalHarmonicsGravitationalAccelerationModelBase< Eigen::Vector3d >
+{
+private:
+
+    //! Typedef for base class.
+    typedef SphericalHarmonicsGravitationalAccelerationModelBase< Eigen::Vector3d > Base;
+
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor taking a pointer to a function returning the position of the body subject to
+     * gravitational acceleration, the precomputed acceleration grid, and a pointer to a function
+     * returning the position of the body exerting the gravitational acceleration. The
+     * gravitational parameter is taken from the grid. The constructor also updates all the
+     * internal members.
+     * \param positionOfBodySubjectToAccelerationFunction Pointer to function returning position of
+     *          body subject to gravitational acceleration.
+     * \param accelerationGrid Precomputed grid of perturbing accelerations.
+     * \param positionOfBodyExertingAccelerationFunction Pointer to function returning position of
+     *          body exerting gravitational acceleration (default = (0,0,0)).
+     */
+    GriddedGravitationalAccelerationModel(
+            const StateFunction positionOfBodySubjectToAccelerationFunction,
+            const SphericalHarmonicsAccelerationGridPointer accelerationGrid,
+            const StateFunction positionOfBodyExertingAccelerationFunction
+            = boost::lambda::constant( Eigen::Vector3d::Zero( ) ) )
+        : Base( positionOfBodySubjectToAccelerationFunction,
+                accelerationGrid->getGravitationalParameter( ),
+                positionOfBodyExertingAccelerationFunction ),
+          accelerationGrid_( accelerationGrid ),
+          sphericalHarmonicsWorkspace_( accelerationGrid->getMaximumDegree( ),
+                                        accelerationGrid->getMaximumOrder( ) )
+    {
+        this->updateMembers( );
+    }
+
+    //! Get gravitational acceleration.
+    /*!
+     * Returns the sum of the central gravitational acceleration and the (interpolated)
+     * perturbing acceleration.
+     * \return Computed gravitational acceleration vector.
+     */
+    Eigen::Vector3d getAcceleration( );
+
+    //! Update class members.
+    /*!
+     * Updates all the base class members to their current values.
+     */
+    void updateMembers( ) { this->updateBaseMembers( ); }
+
+    //! Get acceleration grid.
+    /*!
+     * Returns acceleration grid.
+     * \return Acceleration grid.
+     */
+    SphericalHarmonicsAccelerationGridPointer getAccelerationGrid( )
+    {
+        return accelerationGrid_;
+    }
+
+protected:
+
+private:
+
+    //! Precomputed grid of perturbing accelerations.
+    SphericalHarmonicsAccelerationGridPointer accelerationGrid_;
+
+    //! Workspace for evaluation of spherical harmonics expansion outside of grid.
+    /*!
+     * Workspace for evaluation of spherical harmonics expansion outside of grid, owned by this
+     * model, so that the grid can be shared between models that are evaluated concurrently.
+     */
+    basic_mathematics::SphericalHarmonicsWorkspace sphericalHarmonicsWorkspace_;
+};
+
+//! Typedef for shared-pointer to GriddedGravitationalAccelerationModel object.
+typedef boost::shared_ptr< GriddedGravitationalAccelerationModel >
+GriddedGravitationalAccelerationModelPointer;
+
+} // namespace gravitation
+} // namespace tudat
+
+#endif // TUDAT_GRIDDED_GRAVITY_MODEL_H
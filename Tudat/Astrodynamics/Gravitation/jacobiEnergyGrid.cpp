@@ -0,0 +1,573 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *
+ *    References
+ *      Wakker, K.F., "Astrodynamics I, AE4-874", Delft University of Technology, 2007.
+ *      Lorensen, W.E., Cline, H.E. Marching cubes: a high resolution 3D surface construction
+ *          algorithm, Computer Graphics, 21(4), 163-169, 1987.
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include <boost/cstdint.hpp>
+#include <boost/exception/all.hpp>
+
+#include <Eigen/Geometry>
+
+#include "Tudat/Astrodynamics/Gravitation/jacobiEnergyGrid.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+namespace circular_restricted_three_body_problem
+{
+
+//! Header of binary Jacobi energy grid file.
+/*!
+ * Header of binary Jacobi energy grid file. The size of the header is a multiple of eight bytes,
+ * so that the doubles that follow it are aligned.
+ */
+struct JacobiEnergyGridFileHeader
+{
+    //! Identifier of file type.
+    char fileIdentifier[ 8 ];
+
+    //! Marker to detect byte order of file.
+    boost::uint32_t byteOrderMarker;
+
+    //! Version of file format.
+    boost::uint32_t fileFormatVersion;
+
+    //! Number of grid points along x-axis.
+    boost::int32_t numberOfXPoints;
+
+    //! Number of grid points along y-axis.
+    boost::int32_t numberOfYPoints;
+
+    //! Number of grid points along z-axis.
+    boost::int32_t numberOfZPoints;
+
+    //! Padding, to align mass parameter.
+    boost::int32_t padding;
+
+    //! Mass parameter of CRTBP.
+    double massParameter;
+};
+
+//! Identifier of binary Jacobi energy grid file.
+const char jacobiEnergyGridFileIdentifier[ 8 ] = { 'T', 'U', 'D', 'A', 'T', 'J', 'E', 'G' };
+
+//! Compute effective potential.
+double computeEffectivePotential( const double massParameter, const Eigen::Vector3d& position )
+{
+    const double distanceToPrimaryBody
+            = ( position - Eigen::Vector3d( -massParameter, 0.0, 0.0 ) ).norm( );
+    const double distanceToSecondaryBody
+            = ( position - Eigen::Vector3d( 1.0 - massParameter, 0.0, 0.0 ) ).norm( );
+
+    return 0.5 * ( position.x( ) * position.x( ) + position.y( ) * position.y( ) )
+            + ( 1.0 - massParameter ) / distanceToPrimaryBody
+            + massParameter / distanceToSecondaryBody;
+}
+
+//! Constructor.
+JacobiEnergyGrid::JacobiEnergyGrid( const double massParameter,
+                                    const Eigen::VectorXd& xCoordinates,
+                                    const Eigen::VectorXd& yCoordinates,
+                                    const Eigen::VectorXd& zCoordinates,
+                                    const int numberOfThreads )
+    : massParameter_( massParameter ),
+      xCoordinates_( xCoordinates ),
+      yCoordinates_( yCoordinates ),
+      zCoordinates_( zCoordinates ),
+      numberOfXPoints_( xCoordinates.rows( ) ),
+      numberOfYPoints_( yCoordinates.rows( ) ),
+      numberOfZPoints_( zCoordinates.rows( ) )
+{
+    // Check that grid coordinates are strictly increasing.
+    const Eigen::VectorXd* coordinates[ 3 ] = { &xCoordinates_, &yCoordinates_, &zCoordinates_ };
+    for ( int axis = 0; axis < 3; axis++ )
+    {
+        const int minimumNumberOfPoints = ( axis < 2 ) ? 2 : 1;
+        bool isAxisValid = ( coordinates[ axis ]->rows( ) >= minimumNumberOfPoints );
+        for ( int i = 1; isAxisValid && i < coordinates[ axis ]->rows( ); i++ )
+        {
+            isAxisValid = ( ( *coordinates[ axis ] )( i ) > ( *coordinates[ axis ] )( i - 1 ) );
+        }
+
+        if ( !isAxisValid )
+        {
+            std::stringstream errorMessage;
+            errorMessage << "Error, coordinates along axis " << axis << " of Jacobi energy grid "
+                         << "must be strictly increasing, with at least " << minimumNumberOfPoints
+                         << " point(s)." << std::endl;
+            boost::throw_exception( boost::enable_error_info( std::runtime_error(
+                                                                  errorMessage.str( ) ) ) );
+        }
+    }
+
+    jacobiEnergies_.resize( numberOfXPoints_ * numberOfYPoints_ * numberOfZPoints_ );
+
+    // Divide grid lines over threads, and compute first range on calling thread.
+    const int numberOfLines = numberOfYPoints_ * numberOfZPoints_;
+    const int numberOfUsedThreads = std::max( 1, std::min( numberOfThreads, numberOfLines ) );
+    const int linesPerThread = ( numberOfLines + numberOfUsedThreads - 1 ) / numberOfUsedThreads;
+
+    std::vector< std::thread > threads;
+    for ( int thread = 1; thread < numberOfUsedThreads; thread++ )
+    {
+        threads.push_back( std::thread( &JacobiEnergyGrid::computeJacobiEnergyOnGridLines, this,
+                                        std::min( thread * linesPerThread, numberOfLines ),
+                                        std::min( ( thread + 1 ) * linesPerThread,
+                                                  numberOfLines ) ) );
+    }
+
+    computeJacobiEnergyOnGridLines( 0, std::min( linesPerThread, numberOfLines ) );
+
+    for ( unsigned int i = 0; i < threads.size( ); i++ )
+    {
+        threads[ i ].join( );
+    }
+}
+
+//! Get slice of Jacobi energy grid.
+Eigen::MatrixXd JacobiEnergyGrid::getJacobiEnergySlice( const int zIndex )
+{
+    if ( zIndex < 0 || zIndex >= numberOfZPoints_ )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error, z-index of Jacobi energy grid slice is out of "
+                                            "range." ) ) );
+    }
+
+    return Eigen::Map< const Eigen::MatrixXd >(
+                jacobiEnergies_.data( ) + getGridIndex( 0, 0, zIndex ),
+                numberOfXPoints_, numberOfYPoints_ );
+}
+
+//! Compute zero-velocity curves.
+std::vector< Eigen::Matrix2Xd > JacobiEnergyGrid::computeZeroVelocityCurves(
+        const double jacobiEnergy, const int zIndex )
+{
+    const Eigen::MatrixXd levelValues
+            = getJacobiEnergySlice( zIndex ).array( ) - jacobiEnergy;
+
+    // Find contour segments in all cells (marching squares). Segment end points lie on cell
+    // edges, which are identified by 2 * ( i + nx * j ) for the edge from (i, j) along the
+    // x-axis, and 2 * ( i + nx * j ) + 1 for the edge from (i, j) along the y-axis.
+    std::map< int, Eigen::Vector2d > edgePoints;
+    std::vector< std::pair< int, int > > segments;
+    const int cornerXOffsets[ 4 ] = { 0, 1, 1, 0 };
+    const int cornerYOffsets[ 4 ] = { 0, 0, 1, 1 };
+    for ( int j = 0; j < numberOfYPoints_ - 1; j++ )
+    {
+        for ( int i = 0; i < numberOfXPoints_ - 1; i++ )
+        {
+            double cornerValues[ 4 ];
+            int numberOfCornersInside = 0;
+            for ( int corner = 0; corner < 4; corner++ )
+            {
+                cornerValues[ corner ] = levelValues( i + cornerXOffsets[ corner ],
+                                                      j + cornerYOffsets[ corner ] );
+                numberOfCornersInside += ( cornerValues[ corner ] > 0.0 );
+            }
+
+            if ( numberOfCornersInside == 0 || numberOfCornersInside == 4 )
+            {
+                continue;
+            }
+
+            // Edges of cell, where edge k runs from corner k to corner k + 1 (bottom, right,
+            // top, left).
+            const int edges[ 4 ] = { 2 * ( i + numberOfXPoints_ * j ),
+                                     2 * ( i + 1 + numberOfXPoints_ * j ) + 1,
+                                     2 * ( i + numberOfXPoints_ * ( j + 1 ) ),
+                                     2 * ( i + numberOfXPoints_ * j ) + 1 };
+            std::vector< int > crossedEdges;
+            for ( int edge = 0; edge < 4; edge++ )
+            {
+                const int startCorner = edge;
+                const int endCorner = ( edge + 1 ) % 4;
+                if ( ( cornerValues[ startCorner ] > 0.0 ) == ( cornerValues[ endCorner ] > 0.0 ) )
+                {
+                    continue;
+                }
+
+                crossedEdges.push_back( edge );
+                if ( edgePoints.count( edges[ edge ] ) == 0 )
+                {
+                    const double fraction = computeZeroCrossingFraction(
+                                cornerValues[ startCorner ], cornerValues[ endCorner ] );
+                    const Eigen::Vector2d startPoint(
+                                xCoordinates_( i + cornerXOffsets[ startCorner ] ),
+                                yCoordinates_( j + cornerYOffsets[ startCorner ] ) );
+                    const Eigen::Vector2d endPoint(
+                                xCoordinates_( i + cornerXOffsets[ endCorner ] ),
+                                yCoordinates_( j + cornerYOffsets[ endCorner ] ) );
+                    edgePoints[ edges[ edge ] ] = startPoint + fraction * ( endPoint - startPoint );
+                }
+            }
+
+            if ( crossedEdges.size( ) == 2 )
+            {
+                segments.push_back( std::make_pair( edges[ crossedEdges[ 0 ] ],
+                                                    edges[ crossedEdges[ 1 ] ] ) );
+            }
+            else
+            {
+                // Resolve saddle cell with mean value: if it has the sign of corners 0 and 2,
+                // these are connected, and corners 1 and 3 are cut off.
+                const double meanValue = 0.25 * ( cornerValues[ 0 ] + cornerValues[ 1 ]
+                                                  + cornerValues[ 2 ] + cornerValues[ 3 ] );
+                if ( ( meanValue > 0.0 ) == ( cornerValues[ 0 ] > 0.0 ) )
+                {
+                    segments.push_back( std::make_pair( edges[ 0 ], edges[ 1 ] ) );
+                    segments.push_back( std::make_pair( edges[ 2 ], edges[ 3 ] ) );
+                }
+                else
+                {
+                    segments.push_back( std::make_pair( edges[ 3 ], edges[ 0 ] ) );
+                    segments.push_back( std::make_pair( edges[ 1 ], edges[ 2 ] ) );
+                }
+            }
+        }
+    }
+
+    // Join segments into polylines, using the segments that share each edge.
+    std::map< int, std::vector< int > > segmentsOnEdges;
+    for ( unsigned int i = 0; i < segments.size( ); i++ )
+    {
+        segmentsOnEdges[ segments[ i ].first ].push_back( i );
+        segmentsOnEdges[ segments[ i ].second ].push_back( i );
+    }
+
+    std::vector< bool > isSegmentUsed( segments.size( ), false );
+    std::vector< Eigen::Matrix2Xd > curves;
+    for ( unsigned int firstSegment = 0; firstSegment < segments.size( ); firstSegment++ )
+    {
+        if ( isSegmentUsed[ firstSegment ] )
+        {
+            continue;
+        }
+        isSegmentUsed[ firstSegment ] = true;
+
+        // Extend curve from both ends of first segment, until no unused segment is attached.
+        std::vector< int > curveEdges[ 2 ];
+        curveEdges[ 0 ].push_back( segments[ firstSegment ].first );
+        curveEdges[ 1 ].push_back( segments[ firstSegment ].second );
+        for ( int direction = 0; direction < 2; direction++ )
+        {
+            bool isCurveExtended = true;
+            while ( isCurveExtended )
+            {
+                isCurveExtended = false;
+                const int currentEdge = curveEdges[ direction ].back( );
+                const std::vector< int >& attachedSegments = segmentsOnEdges[ currentEdge ];
+                for ( unsigned int i = 0; i < attachedSegments.size( ); i++ )
+                {
+                    const int segment = attachedSegments[ i ];
+                    if ( !isSegmentUsed[ segment ] )
+                    {
+                        isSegmentUsed[ segment ] = true;
+                        curveEdges[ direction ].push_back(
+                                    ( segments[ segment ].first == currentEdge )
+                                    ? segments[ segment ].second : segments[ segment ].first );
+                        isCurveExtended = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        // Concatenate reversed first half and second half of curve.
+        const int numberOfPoints = curveEdges[ 0 ].size( ) + curveEdges[ 1 ].size( );
+        Eigen::Matrix2Xd curve( 2, numberOfPoints );
+        for ( unsigned int i = 0; i < curveEdges[ 0 ].size( ); i++ )
+        {
+            curve.col( curveEdges[ 0 ].size( ) - 1 - i ) = edgePoints[ curveEdges[ 0 ][ i ] ];
+        }
+        for ( unsigned int i = 0; i < curveEdges[ 1 ].size( ); i++ )
+        {
+            curve.col( curveEdges[ 0 ].size( ) + i ) = edgePoints[ curveEdges[ 1 ][ i ] ];
+        }
+        curves.push_back( curve );
+    }
+
+    return curves;
+}
+
+//! Compute zero-velocity surface.
+Eigen::Matrix3Xd JacobiEnergyGrid::computeZeroVelocitySurface( const double jacobiEnergy )
+{
+    if ( numberOfZPoints_ < 2 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error, zero-velocity surface requires a 3D Jacobi "
+                                            "energy grid." ) ) );
+    }
+
+    // Decomposition of cell in six tetrahedra sharing the diagonal from corner 0 to corner 7,
+    // where corner n is offset by ( n & 1, ( n >> 1 ) & 1, ( n >> 2 ) & 1 ) grid points.
+    const int tetrahedra[ 6 ][ 4 ] = { { 0, 1, 3, 7 }, { 0, 3, 2, 7 }, { 0, 2, 6, 7 },
+                                       { 0, 6, 4, 7 }, { 0, 4, 5, 7 }, { 0, 5, 1, 7 } };
+
+    std::vector< Eigen::Vector3d > triangleVertices;
+    Eigen::Vector3d cornerPositions[ 8 ];
+    double cornerValues[ 8 ];
+    for ( int k = 0; k < numberOfZPoints_ - 1; k++ )
+    {
+        for ( int j = 0; j < numberOfYPoints_ - 1; j++ )
+        {
+            for ( int i = 0; i < numberOfXPoints_ - 1; i++ )
+            {
+                int numberOfCornersInside = 0;
+                for ( int corner = 0; corner < 8; corner++ )
+                {
+                    const int xIndex = i + ( corner & 1 );
+                    const int yIndex = j + ( ( corner >> 1 ) & 1 );
+                    const int zIndex = k + ( ( corner >> 2 ) & 1 );
+                    cornerPositions[ corner ] = Eigen::Vector3d( xCoordinates_( xIndex ),
+                                                                 yCoordinates_( yIndex ),
+                                                                 zCoordinates_( zIndex ) );
+                    cornerValues[ corner ] = jacobiEnergies_(
+                                getGridIndex( xIndex, yIndex, zIndex ) ) - jacobiEnergy;
+                    numberOfCornersInside += ( cornerValues[ corner ] > 0.0 );
+                }
+
+                if ( numberOfCornersInside == 0 || numberOfCornersInside == 8 )
+                {
+                    continue;
+                }
+
+                for ( int tetrahedron = 0; tetrahedron < 6; tetrahedron++ )
+                {
+                    // Sort vertices of tetrahedron by side of surface.
+                    std::vector< int > insideVertices, outsideVertices;
+                    for ( int vertex = 0; vertex < 4; vertex++ )
+                    {
+                        const int corner = tetrahedra[ tetrahedron ][ vertex ];
+                        if ( cornerValues[ corner ] > 0.0 )
+                        {
+                            insideVertices.push_back( corner );
+                        }
+                        else
+                        {
+                            outsideVertices.push_back( corner );
+                        }
+                    }
+
+                    if ( insideVertices.empty( ) || outsideVertices.empty( ) )
+                    {
+                        continue;
+                    }
+
+                    // Compute crossing points on edges between inside and outside vertices,
+                    // ordered such that consecutive points share a vertex.
+                    std::vector< Eigen::Vector3d > crossingPoints;
+                    std::vector< std::pair< int, int > > crossedEdges;
+                    if ( insideVertices.size( ) == 2 )
+                    {
+                        crossedEdges.push_back( std::make_pair( insideVertices[ 0 ],
+                                                                outsideVertices[ 0 ] ) );
+                        crossedEdges.push_back( std::make_pair( insideVertices[ 0 ],
+                                                                outsideVertices[ 1 ] ) );
+                        crossedEdges.push_back( std::make_pair( insideVertices[ 1 ],
+                                                                outsideVertices[ 1 ] ) );
+                        crossedEdges.push_back( std::make_pair( insideVertices[ 1 ],
+                                                                outsideVertices[ 0 ] ) );
+                    }
+                    else
+                    {
+                        const std::vector< int >& loneVertex = ( insideVertices.size( ) == 1 )
+                                ? insideVertices : outsideVertices;
+                        const std::vector< int >& otherVertices
+                                = ( insideVertices.size( ) == 1 )
+                                ? outsideVertices : insideVertices;
+                        for ( int vertex = 0; vertex < 3; vertex++ )
+                        {
+                            crossedEdges.push_back( std::make_pair( loneVertex[ 0 ],
+                                                                    otherVertices[ vertex ] ) );
+                        }
+                    }
+
+                    for ( unsigned int edge = 0; edge < crossedEdges.size( ); edge++ )
+                    {
+                        const int startCorner = crossedEdges[ edge ].first;
+                        const int endCorner = crossedEdges[ edge ].second;
+                        crossingPoints.push_back(
+                                    cornerPositions[ startCorner ]
+                                    + computeZeroCrossingFraction( cornerValues[ startCorner ],
+                                                                   cornerValues[ endCorner ] )
+                                    * ( cornerPositions[ endCorner ]
+                                        - cornerPositions[ startCorner ] ) );
+                    }
+
+                    // Determine direction into region where motion is possible.
+                    Eigen::Vector3d insideDirection = Eigen::Vector3d::Zero( );
+                    for ( unsigned int vertex = 0; vertex < insideVertices.size( ); vertex++ )
+                    {
+                        insideDirection += cornerPositions[ insideVertices[ vertex ] ]
+                                / static_cast< double >( insideVertices.size( ) );
+                    }
+                    for ( unsigned int vertex = 0; vertex < outsideVertices.size( ); vertex++ )
+                    {
+                        insideDirection -= cornerPositions[ outsideVertices[ vertex ] ]
+                                / static_cast< double >( outsideVertices.size( ) );
+                    }
+
+                    // Add one triangle, or two for a quadrilateral, with consistent orientation.
+                    for ( unsigned int triangle = 0; triangle < crossingPoints.size( ) - 2;
+                          triangle++ )
+                    {
+                        const Eigen::Vector3d& firstVertex = crossingPoints[ 0 ];
+                        const Eigen::Vector3d& secondVertex = crossingPoints[ triangle + 1 ];
+                        const Eigen::Vector3d& thirdVertex = crossingPoints[ triangle + 2 ];
+                        const bool isOrientationReversed
+                                = ( secondVertex - firstVertex ).cross(
+                                    thirdVertex - firstVertex ).dot( insideDirection ) < 0.0;
+
+                        triangleVertices.push_back( firstVertex );
+                        triangleVertices.push_back( isOrientationReversed ? thirdVertex
+                                                                          : secondVertex );
+                        triangleVertices.push_back( isOrientationReversed ? secondVertex
+                                                                          : thirdVertex );
+                    }
+                }
+            }
+        }
+    }
+
+    Eigen::Matrix3Xd triangles( 3, triangleVertices.size( ) );
+    for ( unsigned int i = 0; i < triangleVertices.size( ); i++ )
+    {
+        triangles.col( i ) = triangleVertices[ i ];
+    }
+    return triangles;
+}
+
+//! Write grid to binary file.
+void JacobiEnergyGrid::writeToBinaryFile( const std::string& fileName )
+{
+    JacobiEnergyGridFileHeader header;
+    std::memcpy( header.fileIdentifier, jacobiEnergyGridFileIdentifier,
+                 sizeof( header.fileIdentifier ) );
+    header.byteOrderMarker = 0x01020304;
+    header.fileFormatVersion = 1;
+    header.numberOfXPoints = numberOfXPoints_;
+    header.numberOfYPoints = numberOfYPoints_;
+    header.numberOfZPoints = numberOfZPoints_;
+    header.padding = 0;
+    header.massParameter = massParameter_;
+
+    std::ofstream gridFile( fileName.c_str( ), std::ios::out | std::ios::binary );
+    if ( gridFile.fail( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error, Jacobi energy grid file '" + fileName
+                                            + "' could not be opened for writing." ) ) );
+    }
+
+    gridFile.write( reinterpret_cast< const char* >( &header ), sizeof( header ) );
+    gridFile.write( reinterpret_cast< const char* >( xCoordinates_.data( ) ),
+                    numberOfXPoints_ * sizeof( double ) );
+    gridFile.write( reinterpret_cast< const char* >( yCoordinates_.data( ) ),
+                    numberOfYPoints_ * sizeof( double ) );
+    gridFile.write( reinterpret_cast< const char* >( zCoordinates_.data( ) ),
+                    numberOfZPoints_ * sizeof( double ) );
+    gridFile.write( reinterpret_cast< const char* >( jacobiEnergies_.data( ) ),
+                    jacobiEnergies_.size( ) * sizeof( double ) );
+
+    if ( gridFile.fail( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error, could not write Jacobi energy grid file '"
+                                            + fileName + "'." ) ) );
+    }
+}
+
+//! Compute fraction along edge at which grid values cross zero.
+double JacobiEnergyGrid::computeZeroCrossingFraction( const double startValue,
+                                                      const double endValue )
+{
+    if ( std::isinf( startValue ) )
+    {
+        return 1.0;
+    }
+    else if ( std::isinf( endValue ) )
+    {
+        return 0.0;
+    }
+    else
+    {
+        return startValue / ( startValue - endValue );
+    }
+}
+
+//! Compute Jacobi energy on range of grid lines.
+void JacobiEnergyGrid::computeJacobiEnergyOnGridLines( const int firstLine, const int endLine )
+{
+    // Precompute terms that only depend on x-coordinate.
+    const Eigen::ArrayXd xCoordinatesSquared = xCoordinates_.array( ).square( );
+    const Eigen::ArrayXd xDistancesToPrimaryBodySquared
+            = ( xCoordinates_.array( ) + massParameter_ ).square( );
+    const Eigen::ArrayXd xDistancesToSecondaryBodySquared
+            = ( xCoordinates_.array( ) - ( 1.0 - massParameter_ ) ).square( );
+
+    for ( int line = firstLine; line < endLine; line++ )
+    {
+        const double yCoordinate = yCoordinates_( line % numberOfYPoints_ );
+        const double zCoordinate = zCoordinates_( line / numberOfYPoints_ );
+        const double yzDistanceSquared = yCoordinate * yCoordinate + zCoordinate * zCoordinate;
+
+        jacobiEnergies_.segment( line * numberOfXPoints_, numberOfXPoints_ )
+                = xCoordinatesSquared + yCoordinate * yCoordinate
+                + 2.0 * ( 1.0 - massParameter_ )
+                * ( xDistancesToPrimaryBodySquared + yzDistanceSquared ).rsqrt( )
+                + 2.0 * massParameter_
+                * ( xDistancesToSecondaryBodySquared + yzDistanceSquared ).rsqrt( );
+    }
+}
+
+} // namespace circular_restricted_three_body_problem
+} // namespace gravitation
+} // namespace tudat
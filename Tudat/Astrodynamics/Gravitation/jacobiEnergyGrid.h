@@ -0,0 +1,253 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *
+ *    References
+ *      Wakker, K.F., "Astrodynamics I, AE4-874", Delft University of Technology, 2007.
+ *      Lorensen, W.E., Cline, H.E. Marching cubes: a high resolution 3D surface construction
+ *          algorithm, Computer Graphics, 21(4), 163-169, 1987.
+ *
+ *    Notes
+ *      The Jacobi energy on the grid is the zero-velocity Jacobi energy, i.e. twice the effective
+ *      potential. For a given Jacobi energy C, motion is possible where the grid value is at
+ *      least C, and the zero-velocity curves and surfaces are the level sets at C.
+ *
+ *      Zero-velocity surfaces in 3D are extracted by splitting each grid cell in six tetrahedra
+ *      sharing the cell diagonal (marching tetrahedra). This is a variant of marching cubes that
+ *      has no ambiguous cases and does not require the 256-case lookup table.
+ *
+ */
+
+#ifndef TUDAT_JACOBI_ENERGY_GRID_H
+#define TUDAT_JACOBI_ENERGY_GRID_H
+
+#include <string>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+namespace gravitation
+{
+namespace circular_restricted_three_body_problem
+{
+
+//! Compute effective potential.
+/*!
+ * Computes the effective potential (pseudo-potential) in normalized units of the CRTBP:
+ * \f[
+ *      \Omega = \frac{1}{2}\left( x^{2} + y^{2} \right) + \frac{1-\mu}{r_{1}}
+ *               + \frac{\mu}{r_{2}},
+ * \f]
+ * such that the Jacobi energy is \f$C_{J} = 2\Omega - V^{2}\f$ (Wakker, 2007).
+ * \param massParameter Mass parameter of CRTBP.
+ * \param position Position in normalized units.
+ * \return Effective potential in normalized units.
+ */
+double computeEffectivePotential( const double massParameter, const Eigen::Vector3d& position );
+
+//! Grid of zero-velocity Jacobi energy in CRTBP.
+/*!
+ * Class that evaluates the zero-velocity Jacobi energy (twice the effective potential) on a
+ * rectilinear 2D or 3D grid, and extracts zero-velocity curves and surfaces for a given Jacobi
+ * energy. Each grid line along the x-axis is evaluated as a single Eigen array expression, and
+ * the lines are divided over a user-specified number of threads. The values are stored with the
+ * x-index running fastest, then the y-index, then the z-index.
+ */
+class JacobiEnergyGrid
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, evaluates the zero-velocity Jacobi energy on the grid spanned by the given
+     * coordinates. Grid points that coincide with one of the primaries have infinite value.
+     * \param massParameter Mass parameter of CRTBP.
+     * \param xCoordinates Strictly increasing x-coordinates of grid (at least two).
+     * \param yCoordinates Strictly increasing y-coordinates of grid (at least two).
+     * \param zCoordinates Strictly increasing z-coordinates of grid (default: single z = 0 for a
+     *          2D grid in the plane of the primaries).
+     * \param numberOfThreads Number of threads used to evaluate grid (default = 1).
+     */
+    JacobiEnergyGrid( const double massParameter, const Eigen::VectorXd& xCoordinates,
+                      const Eigen::VectorXd& yCoordinates,
+                      const Eigen::VectorXd& zCoordinates = Eigen::VectorXd::Zero( 1 ),
+                      const int numberOfThreads = 1 );
+
+    //! Get Jacobi energy at grid point.
+    /*!
+     * Returns the zero-velocity Jacobi energy at a grid point.
+     * \param xIndex Index of grid point along x-axis.
+     * \param yIndex Index of grid point along y-axis.
+     * \param zIndex Index of grid point along z-axis (default = 0).
+     * \return Zero-velocity Jacobi energy.
+     */
+    double getJacobiEnergy( const int xIndex, const int yIndex, const int zIndex = 0 )
+    {
+        return jacobiEnergies_( getGridIndex( xIndex, yIndex, zIndex ) );
+    }
+
+    //! Get effective potential at grid point.
+    /*!
+     * Returns the effective potential at a grid point, i.e. half the zero-velocity Jacobi energy.
+     * \param xIndex Index of grid point along x-axis.
+     * \param yIndex Index of grid point along y-axis.
+     * \param zIndex Index of grid point along z-axis (default = 0).
+     * \return Effective potential.
+     */
+    double getEffectivePotential( const int xIndex, const int yIndex, const int zIndex = 0 )
+    {
+        return 0.5 * getJacobiEnergy( xIndex, yIndex, zIndex );
+    }
+
+    //! Get slice of Jacobi energy grid.
+    /*!
+     * Returns the zero-velocity Jacobi energy in a plane of constant z.
+     * \param zIndex Index of plane along z-axis (default = 0).
+     * \return Jacobi energy, with rows along x-axis and columns along y-axis.
+     */
+    Eigen::MatrixXd getJacobiEnergySlice( const int zIndex = 0 );
+
+    //! Get all grid values.
+    /*!
+     * Returns the zero-velocity Jacobi energy at all grid points, with the x-index running
+     * fastest.
+     * \return Jacobi energy at all grid points.
+     */
+    Eigen::ArrayXd getJacobiEnergies( ) { return jacobiEnergies_; }
+
+    //! Get x-coordinates of grid.
+    Eigen::VectorXd getXCoordinates( ) { return xCoordinates_; }
+
+    //! Get y-coordinates of grid.
+    Eigen::VectorXd getYCoordinates( ) { return yCoordinates_; }
+
+    //! Get z-coordinates of grid.
+    Eigen::VectorXd getZCoordinates( ) { return zCoordinates_; }
+
+    //! Compute zero-velocity curves.
+    /*!
+     * Computes the zero-velocity curves for the given Jacobi energy in a plane of constant z,
+     * using marching squares with linear interpolation along the cell edges. Ambiguous (saddle)
+     * cells are resolved with the mean of the cell corner values. The segments are joined into
+     * polylines; for closed curves, the last point equals the first point.
+     * \param jacobiEnergy Jacobi energy of zero-velocity curves.
+     * \param zIndex Index of plane along z-axis (default = 0).
+     * \return Zero-velocity curves, each as a set of (x, y) points, one per column.
+     */
+    std::vector< Eigen::Matrix2Xd > computeZeroVelocityCurves( const double jacobiEnergy,
+                                                               const int zIndex = 0 );
+
+    //! Compute zero-velocity surface.
+    /*!
+     * Computes the zero-velocity surface for the given Jacobi energy, using marching tetrahedra
+     * with linear interpolation along the edges. The triangles are oriented such that their
+     * normals (right-hand rule) point into the region where motion is possible. Requires at least
+     * two grid points along the z-axis.
+     * \param jacobiEnergy Jacobi energy of zero-velocity surface.
+     * \return Vertices of triangles, with three consecutive columns per triangle.
+     */
+    Eigen::Matrix3Xd computeZeroVelocitySurface( const double jacobiEnergy );
+
+    //! Write grid to binary file.
+    /*!
+     * Writes the grid to a binary file, in native byte order. The file starts with a 40-byte
+     * header: the identifier "TUDATJEG" (8 characters), a byte order marker 0x01020304 and the
+     * format version (unsigned 32-bit integers), the number of grid points along the x-, y- and
+     * z-axes and four bytes of padding (signed 32-bit integers), and the mass parameter (double).
+     * It is followed by the x-, y- and z-coordinates and the Jacobi energy at all grid points
+     * (doubles, x-index running fastest).
+     * \param fileName Name of binary file.
+     */
+    void writeToBinaryFile( const std::string& fileName );
+
+protected:
+
+private:
+
+    //! Get index of grid point in vector of grid values.
+    int getGridIndex( const int xIndex, const int yIndex, const int zIndex )
+    {
+        return xIndex + numberOfXPoints_ * ( yIndex + numberOfYPoints_ * zIndex );
+    }
+
+    //! Compute fraction along edge at which grid values cross zero.
+    /*!
+     * Computes the fraction along a grid edge at which the linearly interpolated value crosses
+     * zero, given the values at the start and end of the edge, which have opposite signs.
+     * Infinite values (at the primaries) place the crossing at the other end of the edge.
+     * \param startValue Value at start of edge.
+     * \param endValue Value at end of edge.
+     * \return Fraction along edge at which value crosses zero.
+     */
+    static double computeZeroCrossingFraction( const double startValue, const double endValue );
+
+    //! Compute Jacobi energy on range of grid lines.
+    /*!
+     * Computes the zero-velocity Jacobi energy on a range of grid lines along the x-axis, such
+     * that it can be run on a separate thread.
+     * \param firstLine Index of first grid line (y-index + number of y-points * z-index).
+     * \param endLine Index one past last grid line.
+     */
+    void computeJacobiEnergyOnGridLines( const int firstLine, const int endLine );
+
+    //! Mass parameter of CRTBP.
+    const double massParameter_;
+
+    //! x-coordinates of grid.
+    const Eigen::VectorXd xCoordinates_;
+
+    //! y-coordinates of grid.
+    const Eigen::VectorXd yCoordinates_;
+
+    //! z-coordinates of grid.
+    const Eigen::VectorXd zCoordinates_;
+
+    //! Number of grid points along x-axis.
+    const int numberOfXPoints_;
+
+    //! Number of grid points along y-axis.
+    const int numberOfYPoints_;
+
+    //! Number of grid points along z-axis.
+    const int numberOfZPoints_;
+
+    //! Zero-velocity Jacobi energy at all grid points.
+    Eigen::ArrayXd jacobiEnergies_;
+};
+
+//! Typedef for shared-pointer to JacobiEnergyGrid object.
+typedef boost::shared_ptr< JacobiEnergyGrid > JacobiEnergyGridPointer;
+
+} // namespace circular_restricted_three_body_problem
+} // namespace gravitation
+} // namespace tudat
+
+#endif // TUDAT_JACOBI_ENERGY_GRID_H
@@ -0,0 +1,237 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Use shared Octree class; compute multipole expansions per node
+ *                                  after building tree.
+ *      261018                      Sum mascons of leaf nodes without temporary arrays.
+ *
+ *    References
+ *      Barnes, J., Hut, P. A hierarchical O(N log N) force-calculation algorithm, Nature, 324,
+ *          446-449, 1986.
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include "Tudat/Astrodynamics/Gravitation/masconGravityModel.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+
+//! Maximum number of mascons in a leaf node of the mascon octree.
+const int maximumNumberOfMasconsPerTreeLeaf = 16;
+
+//! Maximum depth of the mascon octree, which limits refinement for (nearly) coincident mascons.
+const int maximumMasconTreeDepth = 40;
+
+//! Constructor.
+MasconGravityField::MasconGravityField( const Eigen::VectorXd& gravitationalParameters,
+                                        const Eigen::Matrix3Xd& positions,
+                                        const double openingAngle )
+    : GravityFieldModel( gravitationalParameters.sum( ) ),
+      tree_( maximumNumberOfMasconsPerTreeLeaf, maximumMasconTreeDepth ),
+      openingAngle_( openingAngle ),
+      numberOfExactlySummedMascons_( 0 )
+{
+    const int numberOfMascons = gravitationalParameters.rows( );
+    if ( numberOfMascons < 1 || positions.cols( ) != numberOfMascons )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, mascon gravity field requires at least one mascon, and the "
+                            "number of positions must match the number of gravitational "
+                            "parameters." ) ) );
+    }
+
+    tree_.build( positions );
+    const std::vector< int >& sortedIndices = tree_.getSortedIndices( );
+
+    // Compute multipole expansion of each node.
+    nodeExpansions_.resize( tree_.getNumberOfNodes( ) );
+    for ( int nodeIndex = 0; nodeIndex < tree_.getNumberOfNodes( ); nodeIndex++ )
+    {
+        const Octree::Node& node = tree_.getNode( nodeIndex );
+        MultipoleExpansion& expansion = nodeExpansions_[ nodeIndex ];
+
+        // Compute expansion center (mean position of mascons) of node.
+        for ( int k = node.firstIndex; k < node.endIndex; k++ )
+        {
+            expansion.expansionCenter += positions.col( sortedIndices[ k ] );
+        }
+        expansion.expansionCenter /= static_cast< double >( node.endIndex - node.firstIndex );
+
+        // Compute radius and multipole moments of node w.r.t. expansion center.
+        for ( int k = node.firstIndex; k < node.endIndex; k++ )
+        {
+            const int mascon = sortedIndices[ k ];
+            const double masconGravitationalParameter = gravitationalParameters( mascon );
+            const Eigen::Vector3d offset = positions.col( mascon ) - expansion.expansionCenter;
+            expansion.radius = std::max( expansion.radius, offset.norm( ) );
+            expansion.gravitationalParameter += masconGravitationalParameter;
+            expansion.dipole += masconGravitationalParameter * offset;
+            expansion.quadrupole += masconGravitationalParameter
+                    * ( 3.0 * offset * offset.transpose( )
+                        - offset.squaredNorm( ) * Eigen::Matrix3d::Identity( ) );
+        }
+    }
+
+    // Store mascons contiguously in the order of the tree.
+    masconGravitationalParameters_.resize( numberOfMascons );
+    xMasconPositions_.resize( numberOfMascons );
+    yMasconPositions_.resize( numberOfMascons );
+    zMasconPositions_.resize( numberOfMascons );
+    for ( int i = 0; i < numberOfMascons; i++ )
+    {
+        masconGravitationalParameters_( i ) = gravitationalParameters( sortedIndices[ i ] );
+        xMasconPositions_( i ) = positions( 0, sortedIndices[ i ] );
+        yMasconPositions_( i ) = positions( 1, sortedIndices[ i ] );
+        zMasconPositions_( i ) = positions( 2, sortedIndices[ i ] );
+    }
+}
+
+//! Get the gravitational potential at given body-fixed position.
+double MasconGravityField::getGravitationalPotential( const Eigen::Vector3d& bodyFixedPosition )
+{
+    double potential;
+    Eigen::Vector3d gradientOfPotential;
+    computeGravityFieldTerms( bodyFixedPosition, potential, gradientOfPotential );
+    return potential;
+}
+
+//! Get the gradient of the potential.
+Eigen::Vector3d MasconGravityField::getGradientOfPotential(
+        const Eigen::Vector3d& bodyFixedPosition )
+{
+    double potential;
+    Eigen::Vector3d gradientOfPotential;
+    computeGravityFieldTerms( bodyFixedPosition, potential, gradientOfPotential );
+    return gradientOfPotential;
+}
+
+//! Compute the potential and its gradient.
+void MasconGravityField::computeGravityFieldTerms( const Eigen::Vector3d& bodyFixedPosition,
+                                                   double& potential,
+                                                   Eigen::Vector3d& gradientOfPotential )
+{
+    potential = 0.0;
+    gradientOfPotential.setZero( );
+    numberOfExactlySummedMascons_ = 0;
+
+    // Traverse tree with fixed-size stack; each level adds at most seven nodes to the stack.
+    int nodeStack[ 7 * maximumMasconTreeDepth + 8 ];
+    int stackSize = 0;
+    nodeStack[ stackSize++ ] = 0;
+    while ( stackSize > 0 )
+    {
+        const int nodeIndex = nodeStack[ --stackSize ];
+        const Octree::Node& node = tree_.getNode( nodeIndex );
+        const MultipoleExpansion& expansion = nodeExpansions_[ nodeIndex ];
+
+        // Use multipole expansion of node if it is sufficiently far away.
+        const Eigen::Vector3d relativePosition = bodyFixedPosition - expansion.expansionCenter;
+        const double squaredDistance = relativePosition.squaredNorm( );
+        if ( expansion.radius * expansion.radius
+             < openingAngle_ * openingAngle_ * squaredDistance )
+        {
+            const double inverseDistance = 1.0 / std::sqrt( squaredDistance );
+            const double inverseSquaredDistance = inverseDistance * inverseDistance;
+            const double inverseCubedDistance = inverseSquaredDistance * inverseDistance;
+            const double inverseFifthPowerDistance
+                    = inverseCubedDistance * inverseSquaredDistance;
+
+            const double dipoleProjection = expansion.dipole.dot( relativePosition );
+            const Eigen::Vector3d quadrupoleTimesPosition
+                    = expansion.quadrupole * relativePosition;
+            const double quadrupoleProjection = relativePosition.dot( quadrupoleTimesPosition );
+
+            potential += expansion.gravitationalParameter * inverseDistance
+                    + dipoleProjection * inverseCubedDistance
+                    + 0.5 * quadrupoleProjection * inverseFifthPowerDistance;
+            gradientOfPotential += expansion.dipole * inverseCubedDistance
+                    + quadrupoleTimesPosition * inverseFifthPowerDistance
+                    - ( expansion.gravitationalParameter * inverseCubedDistance
+                        + 3.0 * dipoleProjection * inverseFifthPowerDistance
+                        + 2.5 * quadrupoleProjection * inverseFifthPowerDistance
+                        * inverseSquaredDistance ) * relativePosition;
+        }
+        else if ( node.isLeaf )
+        {
+            // Sum contributions of contiguous mascons in leaf directly, in a scalar loop without
+            // temporary arrays.
+            double leafPotential = 0.0;
+            double xLeafGradient = 0.0;
+            double yLeafGradient = 0.0;
+            double zLeafGradient = 0.0;
+            for ( int i = node.firstIndex; i < node.endIndex; i++ )
+            {
+                const double xRelativePosition = xMasconPositions_( i ) - bodyFixedPosition.x( );
+                const double yRelativePosition = yMasconPositions_( i ) - bodyFixedPosition.y( );
+                const double zRelativePosition = zMasconPositions_( i ) - bodyFixedPosition.z( );
+                const double inverseDistance = 1.0 / std::sqrt(
+                            xRelativePosition * xRelativePosition
+                            + yRelativePosition * yRelativePosition
+                            + zRelativePosition * zRelativePosition );
+
+                // Compute mu_i / r_i and mu_i / r_i^3.
+                const double potentialWeight
+                        = masconGravitationalParameters_( i ) * inverseDistance;
+                const double gradientWeight = potentialWeight * inverseDistance * inverseDistance;
+
+                leafPotential += potentialWeight;
+                xLeafGradient += gradientWeight * xRelativePosition;
+                yLeafGradient += gradientWeight * yRelativePosition;
+                zLeafGradient += gradientWeight * zRelativePosition;
+            }
+
+            potential += leafPotential;
+            gradientOfPotential += Eigen::Vector3d( xLeafGradient, yLeafGradient, zLeafGradient );
+            numberOfExactlySummedMascons_ += node.endIndex - node.firstIndex;
+        }
+        else
+        {
+            for ( int octant = 0; octant < 8; octant++ )
+            {
+                if ( node.children[ octant ] >= 0 )
+                {
+                    nodeStack[ stackSize++ ] = node.children[ octant ];
+                }
+            }
+        }
+    }
+}
+
+} // namespace gravitation
+} // namespace tudat
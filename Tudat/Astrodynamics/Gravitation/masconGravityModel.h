@@ -0,0 +1,316 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Use shared Octree class; initialize multipole expansions in
+ *                                  constructor.
+ *
+ *    References
+ *      Muller, P.M., Sjogren, W.L. Mascons: lunar mass concentrations, Science, 161(3842),
+ *          680-684, 1968.
+ *      Barnes, J., Hut, P. A hierarchical O(N log N) force-calculation algorithm, Nature, 324,
+ *          446-449, 1986.
+ *
+ *    Notes
+ *      The multipole expansion of each tree node is taken about the geometric center of the
+ *      mascons in the node, rather than about their center of mass, and includes the dipole term.
+ *      This keeps the expansion well-defined for mascon sets with negative gravitational
+ *      parameters (mass deficits), for which the total gravitational parameter of a node may be
+ *      (close to) zero.
+ *
+ */
+
+#ifndef TUDAT_MASCON_GRAVITY_MODEL_H
+#define TUDAT_MASCON_GRAVITY_MODEL_H
+
+#include <vector>
+
+#include <boost/lambda/lambda.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModel.h"
+#include "Tudat/Astrodynamics/Gravitation/gravityFieldModel.h"
+#include "Tudat/Astrodynamics/Gravitation/octree.h"
+#include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModelBase.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+
+//! Mascon gravity field class.
+/*!
+ * Class to represent the gravity field of a body as a set of mass concentrations (mascons),
+ * i.e. point masses at fixed positions in the body-fixed frame:
+ * \f[
+ *      U = \sum_{ i } \frac{ \mu_{ i } }{ | \bar{r}_{ i } - \bar{r} | }
+ * \f]
+ * The mascons are sorted into an octree when the object is created, and stored contiguously in
+ * the order of the tree, as structure-of-arrays, so that the mascons of each leaf node are summed
+ * in a single vectorizable loop. For each node, the monopole, dipole and quadrupole terms of the
+ * multipole expansion of its mascons are precomputed. When the gravity field is evaluated, the
+ * expansion of a node is used instead of the exact sum over its mascons if
+ * \f$ \rho_{ node } < \theta d \f$, with \f$ \rho_{ node } \f$ the maximum distance of its
+ * mascons from the expansion center, d the distance from the expansion center to the field point
+ * and \f$ \theta \f$ the opening angle. The relative error of the contribution of an accepted
+ * node is of the order \f$ \theta^{ 3 } \f$. An opening angle of zero results in the exact sum
+ * over all mascons.
+ */
+class MasconGravityField: public GravityFieldModel
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, sorts the mascons into an octree and computes the multipole expansions of its
+     * nodes. The gravitational parameter of the field is set to the sum of the gravitational
+     * parameters of the mascons.
+     * \param gravitationalParameters Gravitational parameters of mascons [m^3 s^-2].
+     * \param positions Positions of mascons in body-fixed frame, each column containing the
+     *          position of a single mascon [m].
+     * \param openingAngle Opening angle below which the multipole expansion of a node is used
+     *          (default = 0.3).
+     */
+    MasconGravityField( const Eigen::VectorXd& gravitationalParameters,
+                        const Eigen::Matrix3Xd& positions,
+                        const double openingAngle = 0.3 );
+
+    //! Virtual destructor.
+    /*!
+     *  Virtual destructor.
+     */
+    virtual ~MasconGravityField( ) { }
+
+    //! Get the gravitational potential at given body-fixed position.
+    /*!
+     * Returns the gravitational potential of the mascons at given body-fixed position.
+     * \param bodyFixedPosition Position at which the gravitational potential is to be evaluated.
+     * \return Gravitational potential.
+     */
+    double getGravitationalPotential( const Eigen::Vector3d& bodyFixedPosition );
+
+    //! Get the gradient of the potential.
+    /*!
+     * Returns the gradient of the potential (i.e., the gravitational acceleration in the
+     * body-fixed frame) of the mascons at given body-fixed position.
+     * \param bodyFixedPosition Position at which gradient of potential is to be determined.
+     * \return Gradient of potential.
+     */
+    Eigen::Vector3d getGradientOfPotential( const Eigen::Vector3d& bodyFixedPosition );
+
+    //! Compute the potential and its gradient.
+    /*!
+     * Computes the potential and its gradient in a single traversal of the octree.
+     * \param bodyFixedPosition Position at which terms are to be determined.
+     * \param potential Gravitational potential (returned by reference).
+     * \param gradientOfPotential Gradient of potential (returned by reference).
+     */
+    void computeGravityFieldTerms( const Eigen::Vector3d& bodyFixedPosition,
+                                   double& potential,
+                                   Eigen::Vector3d& gradientOfPotential );
+
+    //! Set opening angle.
+    /*!
+     * Sets the opening angle below which the multipole expansion of a node is used.
+     * \param openingAngle Opening angle (zero for exact sum over all mascons).
+     */
+    void setOpeningAngle( const double openingAngle ) { openingAngle_ = openingAngle; }
+
+    //! Get opening angle.
+    /*!
+     * Returns the opening angle below which the multipole expansion of a node is used.
+     * \return Opening angle.
+     */
+    double getOpeningAngle( ) { return openingAngle_; }
+
+    //! Get number of mascons.
+    /*!
+     * Returns the number of mascons.
+     * \return Number of mascons.
+     */
+    int getNumberOfMascons( ) { return masconGravitationalParameters_.rows( ); }
+
+    //! Get number of nodes of octree.
+    /*!
+     * Returns the number of nodes of the octree.
+     * \return Number of nodes of octree.
+     */
+    int getNumberOfTreeNodes( ) { return tree_.getNumberOfNodes( ); }
+
+    //! Get number of mascons summed exactly during last evaluation.
+    /*!
+     * Returns the number of mascons of which the contribution was summed exactly (i.e., in leaf
+     * nodes that were not approximated by their multipole expansion) during the last evaluation.
+     * \return Number of mascons summed exactly during last evaluation.
+     */
+    int getNumberOfExactlySummedMascons( ) { return numberOfExactlySummedMascons_; }
+
+protected:
+
+private:
+
+    //! Multipole expansion of mascons in octree node.
+    struct MultipoleExpansion
+    {
+        //! Constructor.
+        /*!
+         * Constructor, initializes an expansion without mass about the origin.
+         */
+        MultipoleExpansion( )
+            : expansionCenter( Eigen::Vector3d::Zero( ) ), radius( 0.0 ),
+              gravitationalParameter( 0.0 ), dipole( Eigen::Vector3d::Zero( ) ),
+              quadrupole( Eigen::Matrix3d::Zero( ) )
+        { }
+
+        //! Center about which multipole expansion of node is taken.
+        Eigen::Vector3d expansionCenter;
+
+        //! Maximum distance of mascons in node from expansion center.
+        double radius;
+
+        //! Sum of gravitational parameters of mascons in node (monopole).
+        double gravitationalParameter;
+
+        //! Dipole of mascons in node w.r.t. expansion center.
+        Eigen::Vector3d dipole;
+
+        //! Traceless quadrupole of mascons in node w.r.t. expansion center.
+        Eigen::Matrix3d quadrupole;
+    };
+
+    //! Gravitational parameters of mascons, in the order of the tree.
+    Eigen::ArrayXd masconGravitationalParameters_;
+
+    //! x-positions of mascons, in the order of the tree.
+    Eigen::ArrayXd xMasconPositions_;
+
+    //! y-positions of mascons, in the order of the tree.
+    Eigen::ArrayXd yMasconPositions_;
+
+    //! z-positions of mascons, in the order of the tree.
+    Eigen::ArrayXd zMasconPositions_;
+
+    //! Octree of mascons.
+    Octree tree_;
+
+    //! Multipole expansions of mascons in each node of octree.
+    std::vector< MultipoleExpansion > nodeExpansions_;
+
+    //! Opening angle below which the multipole expansion of a node is used.
+    double openingAngle_;
+
+    //! Number of mascons summed exactly during last evaluation.
+    int numberOfExactlySummedMascons_;
+};
+
+//! Typedef for shared-pointer to MasconGravityField object.
+typedef boost::shared_ptr< MasconGravityField > MasconGravityFieldPointer;
+
+//! Class for gravitational acceleration due to mascon gravity field.
+/*!
+ * Class for the gravitational acceleration due to a MasconGravityField. The mascon positions are
+ * assumed to be expressed in the frame in which the positions of the bodies are provided.
+ */
+class MasconGravitationalAccelerationModel
+        : public basic_astrodynamics::AccelerationModel< Eigen::Vector3d >,
+        public SphericalHarmonicsGravitationalAccelerationModelBase< Eigen::Vector3d >
+{
+private:
+
+    //! Typedef for base class.
+    typedef SphericalHarmonicsGravitationalAccelerationModelBase< Eigen::Vector3d > Base;
+
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor taking a pointer to a function returning the position of the body subject to
+     * gravitational acceleration, the mascon gravity field, and a pointer to a function returning
+     * the position of the body exerting the gravitational acceleration. The gravitational
+     * parameter is taken from the gravity field. The constructor also updates all the internal
+     * members.
+     * \param positionOfBodySubjectToAccelerationFunction Pointer to function returning position of
+     *          body subject to gravitational acceleration.
+     * \param masconGravityField Mascon gravity field of body exerting acceleration.
+     * \param positionOfBodyExertingAccelerationFunction Pointer to function returning position of
+     *          body exerting gravitational acceleration (default = (0,0,0)).
+     */
+    MasconGravitationalAccelerationModel(
+            const StateFunction positionOfBodySubjectToAccelerationFunction,
+            const MasconGravityFieldPointer masconGravityField,
+            const StateFunction positionOfBodyExertingAccelerationFunction
+            = boost::lambda::constant( Eigen::Vector3d::Zero( ) ) )
+        : Base( positionOfBodySubjectToAccelerationFunction,
+                masconGravityField->getGravitationalParameter( ),
+                positionOfBodyExertingAccelerationFunction ),
+          masconGravityField_( masconGravityField )
+    {
+        this->updateMembers( );
+    }
+
+    //! Get gravitational acceleration.
+    /*!
+     * Returns the gravitational acceleration due to the mascon gravity field.
+     * \return Computed gravitational acceleration vector.
+     */
+    Eigen::Vector3d getAcceleration( )
+    {
+        return masconGravityField_->getGradientOfPotential(
+                    this->positionOfBodySubjectToAcceleration
+                    - this->positionOfBodyExertingAcceleration );
+    }
+
+    //! Update class members.
+    /*!
+     * Updates all the base class members to their current values.
+     */
+    void updateMembers( ) { this->updateBaseMembers( ); }
+
+    //! Get mascon gravity field.
+    /*!
+     * Returns mascon gravity field.
+     * \return Mascon gravity field.
+     */
+    MasconGravityFieldPointer getMasconGravityField( ) { return masconGravityField_; }
+
+protected:
+
+private:
+
+    //! Mascon gravity field of body exerting acceleration.
+    MasconGravityFieldPointer masconGravityField_;
+};
+
+//! Typedef for shared-pointer to MasconGravitationalAccelerationModel object.
+typedef boost::shared_ptr< MasconGravitationalAccelerationModel >
+MasconGravitationalAccelerationModelPointer;
+
+} // namespace gravitation
+} // namespace tudat
+
+#endif // TUDAT_MASCON_GRAVITY_MODEL_H
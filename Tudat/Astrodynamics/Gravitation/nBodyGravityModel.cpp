@@ -0,0 +1,313 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Initialize tree nodes in constructor.
+ *      261018                      Use shared Octree class for Barnes-Hut tree.
+ *
+ *    References
+ *      Barnes, J., Hut, P. A hierarchical O(N log N) force-calculation algorithm, Nature, 324,
+ *          446-449, 1986.
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+
+#include <boost/exception/all.hpp>
+
+#include "Tudat/Astrodynamics/Gravitation/nBodyGravityModel.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+
+//! Maximum number of bodies in a leaf node of the Barnes-Hut tree.
+const int maximumNumberOfBodiesPerTreeLeaf = 8;
+
+//! Maximum depth of the Barnes-Hut tree, which limits refinement for (nearly) coincident bodies.
+const int maximumTreeDepth = 40;
+
+//! Constructor.
+NBodyGravitationalAccelerationEngine::NBodyGravitationalAccelerationEngine(
+        const Eigen::VectorXd& gravitationalParameters,
+        const NBodyAccelerationMethod method,
+        const double openingAngle,
+        const double softeningLength,
+        const int numberOfThreads )
+    : gravitationalParameters_( gravitationalParameters.array( ) ),
+      method_( method ),
+      openingAngle_( openingAngle ),
+      squaredSofteningLength_( softeningLength * softeningLength ),
+      numberOfThreads_( numberOfThreads ),
+      tree_( maximumNumberOfBodiesPerTreeLeaf, maximumTreeDepth )
+{
+    if ( gravitationalParameters_.rows( ) < 1 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, N-body acceleration engine requires at least one body." ) ) );
+    }
+
+    if ( openingAngle_ < 0.0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, opening angle of Barnes-Hut method must be non-negative." ) ) );
+    }
+}
+
+//! Compute accelerations of all bodies from structure-of-arrays positions.
+void NBodyGravitationalAccelerationEngine::computeAccelerations(
+        const Eigen::ArrayXd& xPositions,
+        const Eigen::ArrayXd& yPositions,
+        const Eigen::ArrayXd& zPositions,
+        Eigen::ArrayXd& xAccelerations,
+        Eigen::ArrayXd& yAccelerations,
+        Eigen::ArrayXd& zAccelerations )
+{
+    const int numberOfBodies = gravitationalParameters_.rows( );
+    if ( xPositions.rows( ) != numberOfBodies || yPositions.rows( ) != numberOfBodies
+         || zPositions.rows( ) != numberOfBodies )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, number of positions does not match number of bodies in "
+                            "N-body acceleration engine." ) ) );
+    }
+
+    xAccelerations.resize( numberOfBodies );
+    yAccelerations.resize( numberOfBodies );
+    zAccelerations.resize( numberOfBodies );
+
+    if ( method_ == barnesHutTree )
+    {
+        buildTree( xPositions, yPositions, zPositions );
+    }
+
+    // Divide bodies over threads, and compute first range on calling thread.
+    const int numberOfUsedThreads = std::max( 1, std::min( numberOfThreads_, numberOfBodies ) );
+    const int bodiesPerThread = ( numberOfBodies + numberOfUsedThreads - 1 )
+            / numberOfUsedThreads;
+
+    std::vector< std::thread > threads;
+    for ( int thread = 1; thread < numberOfUsedThreads; thread++ )
+    {
+        threads.push_back( std::thread(
+                               &NBodyGravitationalAccelerationEngine::computeAccelerationsOfRange,
+                               this,
+                               std::min( thread * bodiesPerThread, numberOfBodies ),
+                               std::min( ( thread + 1 ) * bodiesPerThread, numberOfBodies ),
+                               std::cref( xPositions ), std::cref( yPositions ),
+                               std::cref( zPositions ), std::ref( xAccelerations ),
+                               std::ref( yAccelerations ), std::ref( zAccelerations ) ) );
+    }
+
+    computeAccelerationsOfRange( 0, std::min( bodiesPerThread, numberOfBodies ),
+                                 xPositions, yPositions, zPositions,
+                                 xAccelerations, yAccelerations, zAccelerations );
+
+    for ( unsigned int i = 0; i < threads.size( ); i++ )
+    {
+        threads[ i ].join( );
+    }
+}
+
+//! Compute accelerations of all bodies.
+Eigen::Matrix3Xd NBodyGravitationalAccelerationEngine::computeAccelerations(
+        const Eigen::Matrix3Xd& positions )
+{
+    Eigen::ArrayXd xAccelerations, yAccelerations, zAccelerations;
+    computeAccelerations( positions.row( 0 ).transpose( ).array( ),
+                          positions.row( 1 ).transpose( ).array( ),
+                          positions.row( 2 ).transpose( ).array( ),
+                          xAccelerations, yAccelerations, zAccelerations );
+
+    Eigen::Matrix3Xd accelerations( 3, positions.cols( ) );
+    accelerations.row( 0 ) = xAccelerations.matrix( ).transpose( );
+    accelerations.row( 1 ) = yAccelerations.matrix( ).transpose( );
+    accelerations.row( 2 ) = zAccelerations.matrix( ).transpose( );
+    return accelerations;
+}
+
+//! Compute accelerations of a range of bodies.
+void NBodyGravitationalAccelerationEngine::computeAccelerationsOfRange(
+        const int firstBody, const int endBody,
+        const Eigen::ArrayXd& xPositions,
+        const Eigen::ArrayXd& yPositions,
+        const Eigen::ArrayXd& zPositions,
+        Eigen::ArrayXd& xAccelerations,
+        Eigen::ArrayXd& yAccelerations,
+        Eigen::ArrayXd& zAccelerations )
+{
+    if ( method_ == barnesHutTree )
+    {
+        for ( int i = firstBody; i < endBody; i++ )
+        {
+            const Eigen::Vector3d acceleration = computeTreeAcceleration(
+                        i, Eigen::Vector3d( xPositions( i ), yPositions( i ), zPositions( i ) ) );
+            xAccelerations( i ) = acceleration.x( );
+            yAccelerations( i ) = acceleration.y( );
+            zAccelerations( i ) = acceleration.z( );
+        }
+        return;
+    }
+
+    // Allocate buffers for relative positions and weights of all bodies w.r.t. current body.
+    const int numberOfBodies = gravitationalParameters_.rows( );
+    Eigen::ArrayXd xRelativePositions( numberOfBodies );
+    Eigen::ArrayXd yRelativePositions( numberOfBodies );
+    Eigen::ArrayXd zRelativePositions( numberOfBodies );
+    Eigen::ArrayXd weights( numberOfBodies );
+
+    for ( int i = firstBody; i < endBody; i++ )
+    {
+        xRelativePositions = xPositions - xPositions( i );
+        yRelativePositions = yPositions - yPositions( i );
+        zRelativePositions = zPositions - zPositions( i );
+
+        // Compute mu_j / r_ij^3, excluding the body itself.
+        weights = xRelativePositions.square( ) + yRelativePositions.square( )
+                + zRelativePositions.square( ) + squaredSofteningLength_;
+        weights( i ) = 1.0;
+        weights = gravitationalParameters_ * ( weights * weights.sqrt( ) ).inverse( );
+        weights( i ) = 0.0;
+
+        xAccelerations( i ) = ( weights * xRelativePositions ).sum( );
+        yAccelerations( i ) = ( weights * yRelativePositions ).sum( );
+        zAccelerations( i ) = ( weights * zRelativePositions ).sum( );
+    }
+}
+
+//! Build Barnes-Hut tree.
+void NBodyGravitationalAccelerationEngine::buildTree( const Eigen::ArrayXd& xPositions,
+                                                      const Eigen::ArrayXd& yPositions,
+                                                      const Eigen::ArrayXd& zPositions )
+{
+    const int numberOfBodies = gravitationalParameters_.rows( );
+    treePositions_.resize( 3, numberOfBodies );
+    treePositions_.row( 0 ) = xPositions.matrix( ).transpose( );
+    treePositions_.row( 1 ) = yPositions.matrix( ).transpose( );
+    treePositions_.row( 2 ) = zPositions.matrix( ).transpose( );
+
+    tree_.build( treePositions_ );
+
+    // Compute total gravitational parameter and center of mass of each node.
+    const std::vector< int >& sortedBodyIndices = tree_.getSortedIndices( );
+    const int numberOfNodes = tree_.getNumberOfNodes( );
+    nodeGravitationalParameters_.resize( numberOfNodes );
+    nodeCentersOfMass_.resize( 3, numberOfNodes );
+    for ( int nodeIndex = 0; nodeIndex < numberOfNodes; nodeIndex++ )
+    {
+        const Octree::Node& node = tree_.getNode( nodeIndex );
+        double gravitationalParameter = 0.0;
+        Eigen::Vector3d weightedPosition = Eigen::Vector3d::Zero( );
+        for ( int k = node.firstIndex; k < node.endIndex; k++ )
+        {
+            const int body = sortedBodyIndices[ k ];
+            gravitationalParameter += gravitationalParameters_( body );
+            weightedPosition += gravitationalParameters_( body ) * treePositions_.col( body );
+        }
+
+        nodeGravitationalParameters_( nodeIndex ) = gravitationalParameter;
+        nodeCentersOfMass_.col( nodeIndex ) = ( gravitationalParameter != 0.0 ) ?
+                    Eigen::Vector3d( weightedPosition / gravitationalParameter ) : node.center;
+    }
+}
+
+//! Compute acceleration of single body using Barnes-Hut tree.
+Eigen::Vector3d NBodyGravitationalAccelerationEngine::computeTreeAcceleration(
+        const int bodyIndex, const Eigen::Vector3d& position )
+{
+    const std::vector< int >& sortedBodyIndices = tree_.getSortedIndices( );
+    Eigen::Vector3d acceleration = Eigen::Vector3d::Zero( );
+    const double squaredOpeningAngle = openingAngle_ * openingAngle_;
+
+    std::vector< int > nodeStack;
+    nodeStack.reserve( 8 * maximumTreeDepth );
+    nodeStack.push_back( 0 );
+    while ( !nodeStack.empty( ) )
+    {
+        const int nodeIndex = nodeStack.back( );
+        const Octree::Node& node = tree_.getNode( nodeIndex );
+        nodeStack.pop_back( );
+
+        if ( node.isLeaf )
+        {
+            // Sum contributions of bodies in leaf directly.
+            for ( int k = node.firstIndex; k < node.endIndex; k++ )
+            {
+                const int body = sortedBodyIndices[ k ];
+                if ( body != bodyIndex )
+                {
+                    const Eigen::Vector3d relativePosition = treePositions_.col( body ) - position;
+                    const double squaredDistance = relativePosition.squaredNorm( )
+                            + squaredSofteningLength_;
+                    acceleration += gravitationalParameters_( body ) * relativePosition
+                            / ( squaredDistance * std::sqrt( squaredDistance ) );
+                }
+            }
+            continue;
+        }
+
+        // Use monopole of node if it is sufficiently far away, and does not contain the body.
+        const Eigen::Vector3d relativePosition = nodeCentersOfMass_.col( nodeIndex ) - position;
+        const double squaredDistance = relativePosition.squaredNorm( );
+        const double width = 2.0 * node.halfWidth;
+        const bool isBodyInNode
+                = ( position - node.center ).cwiseAbs( ).maxCoeff( ) <= node.halfWidth;
+        if ( !isBodyInNode && width * width < squaredOpeningAngle * squaredDistance )
+        {
+            const double softenedSquaredDistance = squaredDistance + squaredSofteningLength_;
+            acceleration += nodeGravitationalParameters_( nodeIndex ) * relativePosition
+                    / ( softenedSquaredDistance * std::sqrt( softenedSquaredDistance ) );
+        }
+        else
+        {
+            for ( int octant = 0; octant < 8; octant++ )
+            {
+                if ( node.children[ octant ] >= 0 )
+                {
+                    nodeStack.push_back( node.children[ octant ] );
+                }
+            }
+        }
+    }
+
+    return acceleration;
+}
+
+} // namespace gravitation
+} // namespace tudat
@@ -0,0 +1,236 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Added constructor of OctreeNode.
+ *      261018                      Use shared Octree class for Barnes-Hut tree.
+ *
+ *    References
+ *      Barnes, J., Hut, P. A hierarchical O(N log N) force-calculation algorithm, Nature, 324,
+ *          446-449, 1986.
+ *
+ *    Notes
+ *      The Barnes-Hut method uses only the monopole term of each tree node. Its error is
+ *      controlled by the opening angle; an opening angle of zero reproduces the direct summation
+ *      (up to round-off errors), but at a higher cost.
+ *
+ */
+
+#ifndef TUDAT_N_BODY_GRAVITY_MODEL_H
+#define TUDAT_N_BODY_GRAVITY_MODEL_H
+
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/Gravitation/octree.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+
+//! Methods with which mutual gravitational accelerations of N bodies can be computed.
+enum NBodyAccelerationMethod
+{
+    //! Direct summation over all pairs of bodies, O(N^2).
+    directSummation,
+
+    //! Barnes-Hut octree approximation, O(N log N).
+    barnesHutTree
+};
+
+//! N-body gravitational acceleration engine.
+/*!
+ * This class computes the mutual gravitational (point-mass) accelerations of a set of N bodies:
+ * \f[
+ *      \bar{a}_{i} = \sum_{j \neq i} \mu_{j} \frac{ \bar{r}_{j} - \bar{r}_{i} }
+ *                    { ( | \bar{r}_{j} - \bar{r}_{i} |^{2} + \epsilon^{2} )^{3/2} }
+ * \f]
+ * in which \f$ \epsilon \f$ is an (optional) softening length. The positions and accelerations
+ * are passed as structure-of-arrays (separate x-, y- and z-arrays), and the gravitational
+ * parameters are stored in an array, such that the inner loop of the direct summation consists of
+ * Eigen array expressions, which the compiler can vectorize. Alternatively, the accelerations are
+ * approximated using the Barnes-Hut octree method (Barnes & Hut, 1986), in which a tree node of
+ * size s at distance d is replaced by its total gravitational parameter at its center of mass if
+ * s / d is smaller than the opening angle. In both cases, the bodies are divided over the
+ * requested number of threads.
+ */
+class NBodyGravitationalAccelerationEngine
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, sets the gravitational parameters of the bodies and the method with which the
+     * accelerations are computed.
+     * \param gravitationalParameters Gravitational parameters of all bodies [m^3 s^-2].
+     * \param method Method with which accelerations are computed (default = directSummation).
+     * \param openingAngle Opening angle of Barnes-Hut method; not used for direct summation
+     *          (default = 0.5).
+     * \param softeningLength Softening length [m] (default = 0.0).
+     * \param numberOfThreads Number of threads over which the bodies are divided (default = 1).
+     */
+    NBodyGravitationalAccelerationEngine( const Eigen::VectorXd& gravitationalParameters,
+                                          const NBodyAccelerationMethod method = directSummation,
+                                          const double openingAngle = 0.5,
+                                          const double softeningLength = 0.0,
+                                          const int numberOfThreads = 1 );
+
+    //! Compute accelerations of all bodies from structure-of-arrays positions.
+    /*!
+     * Computes the mutual gravitational accelerations of all bodies.
+     * \param xPositions x-positions of all bodies [m].
+     * \param yPositions y-positions of all bodies [m].
+     * \param zPositions z-positions of all bodies [m].
+     * \param xAccelerations x-accelerations of all bodies [m s^-2] (returned by reference).
+     * \param yAccelerations y-accelerations of all bodies [m s^-2] (returned by reference).
+     * \param zAccelerations z-accelerations of all bodies [m s^-2] (returned by reference).
+     */
+    void computeAccelerations( const Eigen::ArrayXd& xPositions,
+                               const Eigen::ArrayXd& yPositions,
+                               const Eigen::ArrayXd& zPositions,
+                               Eigen::ArrayXd& xAccelerations,
+                               Eigen::ArrayXd& yAccelerations,
+                               Eigen::ArrayXd& zAccelerations );
+
+    //! Compute accelerations of all bodies.
+    /*!
+     * Computes the mutual gravitational accelerations of all bodies.
+     * \param positions Positions of all bodies, each column containing the position of a single
+     *          body [m].
+     * \return Accelerations of all bodies, each column containing the acceleration of a single
+     *          body [m s^-2].
+     */
+    Eigen::Matrix3Xd computeAccelerations( const Eigen::Matrix3Xd& positions );
+
+    //! Get number of bodies.
+    /*!
+     * Returns the number of bodies.
+     * \return Number of bodies.
+     */
+    int getNumberOfBodies( ) { return gravitationalParameters_.rows( ); }
+
+    //! Get method with which accelerations are computed.
+    /*!
+     * Returns the method with which accelerations are computed.
+     * \return Method with which accelerations are computed.
+     */
+    NBodyAccelerationMethod getMethod( ) { return method_; }
+
+    //! Get number of nodes of Barnes-Hut tree.
+    /*!
+     * Returns the number of nodes of the Barnes-Hut tree, as built during the last computation of
+     * the accelerations (zero for direct summation).
+     * \return Number of nodes of Barnes-Hut tree.
+     */
+    int getNumberOfTreeNodes( ) { return tree_.getNumberOfNodes( ); }
+
+protected:
+
+private:
+
+    //! Compute accelerations of a range of bodies.
+    /*!
+     * Computes the accelerations of a range of bodies, with the selected method. For the
+     * Barnes-Hut method, the tree must have been built.
+     * \param firstBody Index of first body of range.
+     * \param endBody Index after last body of range.
+     * \param xPositions x-positions of all bodies.
+     * \param yPositions y-positions of all bodies.
+     * \param zPositions z-positions of all bodies.
+     * \param xAccelerations x-accelerations of all bodies (returned by reference).
+     * \param yAccelerations y-accelerations of all bodies (returned by reference).
+     * \param zAccelerations z-accelerations of all bodies (returned by reference).
+     */
+    void computeAccelerationsOfRange( const int firstBody, const int endBody,
+                                      const Eigen::ArrayXd& xPositions,
+                                      const Eigen::ArrayXd& yPositions,
+                                      const Eigen::ArrayXd& zPositions,
+                                      Eigen::ArrayXd& xAccelerations,
+                                      Eigen::ArrayXd& yAccelerations,
+                                      Eigen::ArrayXd& zAccelerations );
+
+    //! Build Barnes-Hut tree.
+    /*!
+     * Builds the Barnes-Hut octree for the given positions, and computes the total gravitational
+     * parameter and center of mass of each node.
+     * \param xPositions x-positions of all bodies.
+     * \param yPositions y-positions of all bodies.
+     * \param zPositions z-positions of all bodies.
+     */
+    void buildTree( const Eigen::ArrayXd& xPositions,
+                    const Eigen::ArrayXd& yPositions,
+                    const Eigen::ArrayXd& zPositions );
+
+    //! Compute acceleration of single body using Barnes-Hut tree.
+    /*!
+     * Computes the acceleration of a single body by traversing the Barnes-Hut tree.
+     * \param bodyIndex Index of body.
+     * \param position Position of body.
+     * \return Acceleration of body.
+     */
+    Eigen::Vector3d computeTreeAcceleration( const int bodyIndex,
+                                             const Eigen::Vector3d& position );
+
+    //! Gravitational parameters of all bodies [m^3 s^-2].
+    Eigen::ArrayXd gravitationalParameters_;
+
+    //! Method with which accelerations are computed.
+    NBodyAccelerationMethod method_;
+
+    //! Opening angle of Barnes-Hut method.
+    double openingAngle_;
+
+    //! Square of softening length [m^2].
+    double squaredSofteningLength_;
+
+    //! Number of threads over which the bodies are divided.
+    int numberOfThreads_;
+
+    //! Barnes-Hut tree.
+    Octree tree_;
+
+    //! Total gravitational parameters of bodies in each tree node [m^3 s^-2].
+    Eigen::ArrayXd nodeGravitationalParameters_;
+
+    //! Centers of mass of bodies in each tree node, one per column.
+    Eigen::Matrix3Xd nodeCentersOfMass_;
+
+    //! Positions of bodies, as used to build Barnes-Hut tree.
+    Eigen::Matrix3Xd treePositions_;
+};
+
+//! Typedef for shared-pointer to NBodyGravitationalAccelerationEngine.
+typedef boost::shared_ptr< NBodyGravitationalAccelerationEngine >
+NBodyGravitationalAccelerationEnginePointer;
+
+} // namespace gravitation
+} // namespace tudat
+
+#endif // TUDAT_N_BODY_GRAVITY_MODEL_H
@@ -0,0 +1,137 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *
+ *    References
+ *      Barnes, J., Hut, P. A hierarchical O(N log N) force-calculation algorithm, Nature, 324,
+ *          446-449, 1986.
+ *
+ *    Notes
+ *
+ */
+
+#include "Tudat/Astrodynamics/Gravitation/octree.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+
+//! Build octree.
+void Octree::build( const Eigen::Matrix3Xd& positions )
+{
+    const int numberOfPoints = positions.cols( );
+    sortedIndices_.resize( numberOfPoints );
+    for ( int i = 0; i < numberOfPoints; i++ )
+    {
+        sortedIndices_[ i ] = i;
+    }
+
+    // Set root node as cube enclosing all points, slightly enlarged to avoid points on boundary.
+    const Eigen::Vector3d minimumCorner = positions.rowwise( ).minCoeff( );
+    const Eigen::Vector3d maximumCorner = positions.rowwise( ).maxCoeff( );
+    const double halfWidth = 0.5 * ( maximumCorner - minimumCorner ).maxCoeff( ) * ( 1.0 + 1.0E-10 )
+            + 1.0E-10;
+
+    nodes_.clear( );
+    createNode( 0.5 * ( minimumCorner + maximumCorner ), halfWidth, 0, numberOfPoints, 0,
+                positions );
+}
+
+//! Create node, and its children.
+int Octree::createNode( const Eigen::Vector3d& center, const double halfWidth,
+                        const int firstIndex, const int endIndex, const int depth,
+                        const Eigen::Matrix3Xd& positions )
+{
+    const int nodeIndex = nodes_.size( );
+    nodes_.push_back( Node( ) );
+
+    Node& node = nodes_[ nodeIndex ];
+    node.center = center;
+    node.halfWidth = halfWidth;
+    node.firstIndex = firstIndex;
+    node.endIndex = endIndex;
+    node.isLeaf = ( endIndex - firstIndex <= maximumNumberOfPointsPerLeaf_ )
+            || ( depth >= maximumDepth_ );
+
+    if ( node.isLeaf )
+    {
+        return nodeIndex;
+    }
+
+    // Sort points of node per octant (bit 0: x, bit 1: y, bit 2: z above center).
+    std::vector< int > octants( endIndex - firstIndex );
+    int octantSizes[ 8 ] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+    for ( int k = firstIndex; k < endIndex; k++ )
+    {
+        const Eigen::Vector3d position = positions.col( sortedIndices_[ k ] );
+        const int octant = ( position.x( ) >= center.x( ) ? 1 : 0 )
+                + ( position.y( ) >= center.y( ) ? 2 : 0 )
+                + ( position.z( ) >= center.z( ) ? 4 : 0 );
+        octants[ k - firstIndex ] = octant;
+        octantSizes[ octant ]++;
+    }
+
+    int octantStarts[ 8 ];
+    octantStarts[ 0 ] = firstIndex;
+    for ( int octant = 1; octant < 8; octant++ )
+    {
+        octantStarts[ octant ] = octantStarts[ octant - 1 ] + octantSizes[ octant - 1 ];
+    }
+
+    const std::vector< int > unsortedIndices( sortedIndices_.begin( ) + firstIndex,
+                                              sortedIndices_.begin( ) + endIndex );
+    int octantPositions[ 8 ];
+    std::copy( octantStarts, octantStarts + 8, octantPositions );
+    for ( unsigned int k = 0; k < unsortedIndices.size( ); k++ )
+    {
+        sortedIndices_[ octantPositions[ octants[ k ] ]++ ] = unsortedIndices[ k ];
+    }
+
+    // Create child nodes of non-empty octants. Note that the node reference is not used after
+    // this point, since creating nodes may reallocate the list of nodes.
+    const double childHalfWidth = 0.5 * halfWidth;
+    for ( int octant = 0; octant < 8; octant++ )
+    {
+        if ( octantSizes[ octant ] > 0 )
+        {
+            const Eigen::Vector3d childCenter = center + childHalfWidth * Eigen::Vector3d(
+                        ( octant & 1 ) ? 1.0 : -1.0,
+                        ( octant & 2 ) ? 1.0 : -1.0,
+                        ( octant & 4 ) ? 1.0 : -1.0 );
+            const int childIndex = createNode(
+                        childCenter, childHalfWidth, octantStarts[ octant ],
+                        octantStarts[ octant ] + octantSizes[ octant ], depth + 1, positions );
+            nodes_[ nodeIndex ].children[ octant ] = childIndex;
+        }
+    }
+
+    return nodeIndex;
+}
+
+} // namespace gravitation
+} // namespace tudat
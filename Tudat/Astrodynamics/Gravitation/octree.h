@@ -0,0 +1,196 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *
+ *    References
+ *      Barnes, J., Hut, P. A hierarchical O(N log N) force-calculation algorithm, Nature, 324,
+ *          446-449, 1986.
+ *
+ *    Notes
+ *      The octree only stores the topology of the tree (i.e., the geometry of the nodes and the
+ *      ranges of sorted points they contain). Users of the octree, such as the Barnes-Hut N-body
+ *      acceleration engine and the mascon gravity field, compute their own (multipole) moments
+ *      per node, stored in arrays indexed by node index.
+ *
+ */
+
+#ifndef TUDAT_OCTREE_H
+#define TUDAT_OCTREE_H
+
+#include <algorithm>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+namespace gravitation
+{
+
+//! Octree of point positions.
+/*!
+ * Class that recursively subdivides a cube enclosing a set of points into octants, until a node
+ * contains at most a given number of points, or a given depth is reached. The indices of the
+ * points are sorted such that the points of each node are contiguous, so that each node refers to
+ * a range of sorted indices. The nodes are stored in a single list, in which each node precedes
+ * its children, with the root node at index zero.
+ */
+class Octree
+{
+public:
+
+    //! Node of octree.
+    struct Node
+    {
+        //! Constructor.
+        /*!
+         * Constructor, initializes an empty leaf node without children.
+         */
+        Node( )
+            : center( Eigen::Vector3d::Zero( ) ), halfWidth( 0.0 ), firstIndex( 0 ),
+              endIndex( 0 ), isLeaf( true )
+        {
+            std::fill( children, children + 8, -1 );
+        }
+
+        //! Geometric center of (cubic) node.
+        Eigen::Vector3d center;
+
+        //! Half of width of node.
+        double halfWidth;
+
+        //! Index of first point of node in list of sorted point indices.
+        int firstIndex;
+
+        //! Index after last point of node in list of sorted point indices.
+        int endIndex;
+
+        //! Indices of child nodes per octant (-1 if absent).
+        /*!
+         * Indices of child nodes per octant (-1 if absent), where bit 0, 1 and 2 of the octant
+         * denote whether the child is above the center in x, y and z, respectively.
+         */
+        int children[ 8 ];
+
+        //! Boolean denoting whether node is a leaf.
+        bool isLeaf;
+    };
+
+    //! Constructor.
+    /*!
+     * Constructor, sets the criteria at which the subdivision of nodes stops.
+     * \param maximumNumberOfPointsPerLeaf Maximum number of points in a leaf node.
+     * \param maximumDepth Maximum depth of tree, which limits refinement for (nearly) coincident
+     *          points.
+     */
+    Octree( const int maximumNumberOfPointsPerLeaf, const int maximumDepth )
+        : maximumNumberOfPointsPerLeaf_( maximumNumberOfPointsPerLeaf ),
+          maximumDepth_( maximumDepth )
+    { }
+
+    //! Build octree.
+    /*!
+     * Builds the octree for the given positions, replacing any previously built tree. The root
+     * node is the cube enclosing all points, slightly enlarged to avoid points on its boundary.
+     * The memory of the tree is reused when it is rebuilt.
+     * \param positions Positions of all points, each column containing the position of a single
+     *          point.
+     */
+    void build( const Eigen::Matrix3Xd& positions );
+
+    //! Get node of octree.
+    /*!
+     * Returns node of octree.
+     * \param nodeIndex Index of node (root node at index zero).
+     * \return Node of octree.
+     */
+    const Node& getNode( const int nodeIndex ) const { return nodes_[ nodeIndex ]; }
+
+    //! Get number of nodes of octree.
+    /*!
+     * Returns the number of nodes of the octree.
+     * \return Number of nodes of octree.
+     */
+    int getNumberOfNodes( ) const { return nodes_.size( ); }
+
+    //! Get sorted point indices.
+    /*!
+     * Returns the indices of the points, sorted such that the points of each node are
+     * contiguous.
+     * \return Sorted point indices.
+     */
+    const std::vector< int >& getSortedIndices( ) const { return sortedIndices_; }
+
+    //! Get maximum depth of tree.
+    /*!
+     * Returns the maximum depth of the tree.
+     * \return Maximum depth of tree.
+     */
+    int getMaximumDepth( ) const { return maximumDepth_; }
+
+protected:
+
+private:
+
+    //! Create node, and its children.
+    /*!
+     * Creates a node containing the given range of sorted point indices, sorts the points of the
+     * node per octant, and recursively creates its children.
+     * \param center Geometric center of node.
+     * \param halfWidth Half of width of node.
+     * \param firstIndex Index of first point of node in list of sorted point indices.
+     * \param endIndex Index after last point of node in list of sorted point indices.
+     * \param depth Depth of node in tree.
+     * \param positions Positions of all points.
+     * \return Index of created node.
+     */
+    int createNode( const Eigen::Vector3d& center, const double halfWidth,
+                    const int firstIndex, const int endIndex, const int depth,
+                    const Eigen::Matrix3Xd& positions );
+
+    //! Maximum number of points in a leaf node.
+    const int maximumNumberOfPointsPerLeaf_;
+
+    //! Maximum depth of tree.
+    const int maximumDepth_;
+
+    //! Nodes of octree, with root node at index zero.
+    std::vector< Node > nodes_;
+
+    //! Indices of points, sorted such that points of each node are contiguous.
+    std::vector< int > sortedIndices_;
+};
+
+//! Typedef for shared-pointer to Octree object.
+typedef boost::shared_ptr< Octree > OctreePointer;
+
+} // namespace gravitation
+} // namespace tudat
+
+#endif // TUDAT_OCTREE_H
@@ -0,0 +1,805 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Compute state derivative with CRTBP state derivative model.
+ *
+ *    References
+ *      Howell, K.C. Three-dimensional, periodic, 'halo' orbits, Celestial Mechanics, 32(1),
+ *          53-71, 1984.
+ *      Pavlak, T.A. Trajectory design and orbit maintenance strategies in multi-body dynamical
+ *          regimes, PhD thesis, Purdue University, 2013.
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include <boost/bind.hpp>
+#include <boost/exception/all.hpp>
+
+#include <Eigen/Cholesky>
+#include <Eigen/Eigenvalues>
+#include <Eigen/LU>
+
+#include "Tudat/Astrodynamics/Gravitation/jacobiEnergy.h"
+#include "Tudat/Astrodynamics/Gravitation/periodicOrbitDifferentialCorrection.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaCoefficients.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKuttaVariableStepSizeIntegrator.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+namespace circular_restricted_three_body_problem
+{
+
+//! Compute Jacobian of CRTBP state derivative w.r.t. state.
+basic_mathematics::Matrix6d computeStateDerivativeJacobian( const double massParameter,
+                                                            const Eigen::Vector3d& position )
+{
+    basic_mathematics::Matrix6d stateDerivativeJacobian = basic_mathematics::Matrix6d::Zero( );
+    stateDerivativeJacobian.block( 0, 3, 3, 3 ) = Eigen::Matrix3d::Identity( );
+
+    // Compute Hessian of effective potential, starting with centrifugal term.
+    Eigen::Matrix3d potentialHessian = Eigen::Matrix3d::Zero( );
+    potentialHessian( 0, 0 ) = 1.0;
+    potentialHessian( 1, 1 ) = 1.0;
+
+    // Add contributions of primary (at x = -mu) and secondary (at x = 1 - mu).
+    const double massFractions[ 2 ] = { 1.0 - massParameter, massParameter };
+    const double xPositionsOfPrimaries[ 2 ] = { -massParameter, 1.0 - massParameter };
+    for ( int i = 0; i < 2; i++ )
+    {
+        Eigen::Vector3d relativePosition = position;
+        relativePosition( 0 ) -= xPositionsOfPrimaries[ i ];
+        const double squaredDistance = relativePosition.squaredNorm( );
+        const double inverseDistanceCubed
+                = 1.0 / ( squaredDistance * std::sqrt( squaredDistance ) );
+
+        potentialHessian += massFractions[ i ] * inverseDistanceCubed
+                * ( 3.0 / squaredDistance * relativePosition * relativePosition.transpose( )
+                    - Eigen::Matrix3d::Identity( ) );
+    }
+    stateDerivativeJacobian.block( 3, 0, 3, 3 ) = potentialHessian;
+
+    // Add Coriolis terms.
+    stateDerivativeJacobian( xAccelerationIndex, yCartesianVelocityIndex ) = 2.0;
+    stateDerivativeJacobian( yAccelerationIndex, xCartesianVelocityIndex ) = -2.0;
+
+    return stateDerivativeJacobian;
+}
+
+//! Compute derivative of state and state transition matrix.
+StateAndStateTransitionMatrix computeStateAndStateTransitionMatrixDerivative(
+        const double massParameter, const double time,
+        const StateAndStateTransitionMatrix& stateAndStateTransitionMatrix )
+{
+    const Eigen::Vector3d position = stateAndStateTransitionMatrix.block( 0, 0, 3, 1 );
+    StateAndStateTransitionMatrix derivative;
+
+    // Compute state derivative with the CRTBP state derivative model.
+    StateDerivativeCircularRestrictedThreeBodyProblem stateDerivativeModel( massParameter );
+    derivative.col( 0 ) = stateDerivativeModel.computeStateDerivative(
+                time, stateAndStateTransitionMatrix.col( 0 ) );
+
+    // Compute derivative of state transition matrix, using the block structure of the Jacobian:
+    // the position rows are the velocity rows of the state transition matrix, and the velocity
+    // rows follow from the potential Hessian and the Coriolis terms.
+    const basic_mathematics::Matrix6d stateDerivativeJacobian
+            = computeStateDerivativeJacobian( massParameter, position );
+
+    derivative.block( 0, 1, 3, 6 ) = stateAndStateTransitionMatrix.block( 3, 1, 3, 6 );
+    derivative.block( 3, 1, 3, 6 ) = stateDerivativeJacobian.block( 3, 0, 3, 3 )
+            * stateAndStateTransitionMatrix.block( 0, 1, 3, 6 );
+    derivative.block( xAccelerationIndex, 1, 1, 6 )
+            += 2.0 * stateAndStateTransitionMatrix.block( yCartesianVelocityIndex, 1, 1, 6 );
+    derivative.block( yAccelerationIndex, 1, 1, 6 )
+            -= 2.0 * stateAndStateTransitionMatrix.block( xCartesianVelocityIndex, 1, 1, 6 );
+
+    return derivative;
+}
+
+//! Propagate state and state transition matrix.
+StateAndStateTransitionMatrix propagateStateAndStateTransitionMatrix(
+        const double massParameter, const basic_mathematics::Vector6d& initialState,
+        const double propagationTime, const double integrationTolerance )
+{
+    if ( !( propagationTime > 0.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, propagation time of state transition matrix must be "
+                            "positive." ) ) );
+    }
+
+    StateAndStateTransitionMatrix initialStateAndStateTransitionMatrix;
+    initialStateAndStateTransitionMatrix.col( 0 ) = initialState;
+    initialStateAndStateTransitionMatrix.block( 0, 1, 6, 6 )
+            = basic_mathematics::Matrix6d::Identity( );
+
+    numerical_integrators::RungeKuttaVariableStepSizeIntegrator<
+            double, StateAndStateTransitionMatrix, StateAndStateTransitionMatrix > integrator(
+                numerical_integrators::RungeKuttaCoefficients::get(
+                    numerical_integrators::RungeKuttaCoefficients::rungeKuttaFehlberg78 ),
+                boost::bind( &computeStateAndStateTransitionMatrixDerivative,
+                             massParameter, _1, _2 ),
+                0.0, initialStateAndStateTransitionMatrix,
+                std::numeric_limits< double >::epsilon( ) * propagationTime, propagationTime,
+                integrationTolerance, integrationTolerance );
+
+    return integrator.integrateTo( propagationTime, 1.0E-3 * propagationTime );
+}
+
+//! Constructor.
+PeriodicOrbit::PeriodicOrbit( const double massParameter,
+                              const basic_mathematics::Vector6d& initialState,
+                              const double period,
+                              const basic_mathematics::Matrix6d& monodromyMatrix )
+    : initialState_( initialState ),
+      period_( period ),
+      monodromyMatrix_( monodromyMatrix )
+{
+    jacobiEnergy_ = computeJacobiEnergy( massParameter, initialState_ );
+
+    // Compute stability index from eigenvalue of monodromy matrix with largest magnitude.
+    Eigen::EigenSolver< basic_mathematics::Matrix6d > eigenSolver( monodromyMatrix_, false );
+    const double largestEigenvalueMagnitude = eigenSolver.eigenvalues( ).cwiseAbs( ).maxCoeff( );
+    stabilityIndex_ = 0.5 * ( largestEigenvalueMagnitude + 1.0 / largestEigenvalueMagnitude );
+}
+
+//! Constructor.
+SymmetricPeriodicOrbitCorrector::SymmetricPeriodicOrbitCorrector(
+        const double massParameter, const PeriodicOrbitSymmetry symmetry, const double tolerance,
+        const int maximumNumberOfIterations, const int numberOfThreads,
+        const double integrationTolerance )
+    : massParameter_( massParameter ),
+      symmetry_( symmetry ),
+      tolerance_( tolerance ),
+      maximumNumberOfIterations_( maximumNumberOfIterations ),
+      numberOfThreads_( std::max( 1, numberOfThreads ) ),
+      integrationTolerance_( integrationTolerance )
+{
+    // Set mirror image of state under symmetry, i.e. (x, -y, z, -vx, vy, -vz) for xz-plane
+    // symmetry and (x, -y, -z, -vx, vy, vz) for x-axis symmetry.
+    switch ( symmetry_ )
+    {
+    case xzPlaneSymmetry:
+        symmetryMatrixDiagonal_ << 1.0, -1.0, 1.0, -1.0, 1.0, -1.0;
+        break;
+
+    case xAxisSymmetry:
+        symmetryMatrixDiagonal_ << 1.0, -1.0, -1.0, -1.0, 1.0, 1.0;
+        break;
+
+    default:
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error, periodic orbit symmetry not recognized." ) ) );
+    }
+}
+
+//! Correct periodic orbit.
+PeriodicOrbitPointer SymmetricPeriodicOrbitCorrector::correctPeriodicOrbit(
+        const basic_mathematics::Vector6d& initialStateGuess, const double periodGuess,
+        const StateElementIndices fixedStateElement )
+{
+    std::vector< int > freeStateElements, constrainedStateElements;
+    getFreeAndConstrainedStateElements( initialStateGuess, freeStateElements,
+                                        constrainedStateElements );
+
+    // Set free variables from guess.
+    const int numberOfFreeVariables = freeStateElements.size( ) + 1;
+    Eigen::VectorXd freeVariables( numberOfFreeVariables );
+    for ( unsigned int i = 0; i < freeStateElements.size( ); i++ )
+    {
+        freeVariables( i ) = initialStateGuess( freeStateElements[ i ] );
+    }
+    freeVariables( numberOfFreeVariables - 1 ) = 0.5 * periodGuess;
+
+    // Fix given component of initial state.
+    const int fixedVariableIndex = getFreeVariableIndex( fixedStateElement, freeStateElements );
+    Eigen::VectorXd additionalConstraintGradient = Eigen::VectorXd::Zero( numberOfFreeVariables );
+    additionalConstraintGradient( fixedVariableIndex ) = 1.0;
+
+    PeriodicOrbitPointer correctedOrbit;
+    if ( !correctWithAdditionalConstraint( freeVariables, freeStateElements,
+                                           constrainedStateElements, additionalConstraintGradient,
+                                           freeVariables( fixedVariableIndex ), correctedOrbit ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, differential corrector of periodic orbit did not "
+                            "converge." ) ) );
+    }
+
+    return correctedOrbit;
+}
+
+//! Compute family of periodic orbits with natural-parameter continuation.
+std::vector< PeriodicOrbitPointer >
+SymmetricPeriodicOrbitCorrector::computeFamilyWithNaturalParameterContinuation(
+        const PeriodicOrbitPointer firstOrbit, const StateElementIndices continuationParameter,
+        const double parameterStepSize, const int numberOfOrbits )
+{
+    return computeFamily( firstOrbit, continuationParameter, parameterStepSize, numberOfOrbits );
+}
+
+//! Compute family of periodic orbits with pseudo-arclength continuation.
+std::vector< PeriodicOrbitPointer >
+SymmetricPeriodicOrbitCorrector::computeFamilyWithPseudoArclengthContinuation(
+        const PeriodicOrbitPointer firstOrbit, const double arclengthStepSize,
+        const int numberOfOrbits )
+{
+    return computeFamily( firstOrbit, -1, arclengthStepSize, numberOfOrbits );
+}
+
+//! Determine free and constrained state elements.
+void SymmetricPeriodicOrbitCorrector::getFreeAndConstrainedStateElements(
+        const basic_mathematics::Vector6d& initialState, std::vector< int >& freeStateElements,
+        std::vector< int >& constrainedStateElements )
+{
+    freeStateElements.clear( );
+    constrainedStateElements.clear( );
+
+    switch ( symmetry_ )
+    {
+    case xzPlaneSymmetry:
+
+        // Out-of-plane components are excluded for planar orbits.
+        freeStateElements.push_back( xCartesianPositionIndex );
+        if ( initialState( zCartesianPositionIndex ) != 0.0 )
+        {
+            freeStateElements.push_back( zCartesianPositionIndex );
+        }
+        freeStateElements.push_back( yCartesianVelocityIndex );
+
+        constrainedStateElements.push_back( yCartesianPositionIndex );
+        constrainedStateElements.push_back( xCartesianVelocityIndex );
+        if ( initialState( zCartesianPositionIndex ) != 0.0 )
+        {
+            constrainedStateElements.push_back( zCartesianVelocityIndex );
+        }
+        break;
+
+    case xAxisSymmetry:
+
+        freeStateElements.push_back( xCartesianPositionIndex );
+        freeStateElements.push_back( yCartesianVelocityIndex );
+        freeStateElements.push_back( zCartesianVelocityIndex );
+
+        constrainedStateElements.push_back( yCartesianPositionIndex );
+        constrainedStateElements.push_back( zCartesianPositionIndex );
+        constrainedStateElements.push_back( xCartesianVelocityIndex );
+        break;
+    }
+}
+
+//! Get index of state element in vector of free variables.
+int SymmetricPeriodicOrbitCorrector::getFreeVariableIndex(
+        const int stateElement, const std::vector< int >& freeStateElements )
+{
+    for ( unsigned int i = 0; i < freeStateElements.size( ); i++ )
+    {
+        if ( freeStateElements[ i ] == stateElement )
+        {
+            return i;
+        }
+    }
+
+    std::stringstream errorMessage;
+    errorMessage << "Error, state element " << stateElement << " is not a free variable of the "
+                 << "symmetric periodic orbit." << std::endl;
+    boost::throw_exception( boost::enable_error_info( std::runtime_error(
+                                                          errorMessage.str( ) ) ) );
+}
+
+//! Compute initial state from free variables.
+basic_mathematics::Vector6d SymmetricPeriodicOrbitCorrector::computeInitialState(
+        const Eigen::VectorXd& freeVariables, const std::vector< int >& freeStateElements )
+{
+    basic_mathematics::Vector6d initialState = basic_mathematics::Vector6d::Zero( );
+    for ( unsigned int i = 0; i < freeStateElements.size( ); i++ )
+    {
+        initialState( freeStateElements[ i ] ) = freeVariables( i );
+    }
+    return initialState;
+}
+
+//! Evaluate constraints and their Jacobian.
+void SymmetricPeriodicOrbitCorrector::evaluateConstraints(
+        const Eigen::VectorXd& freeVariables, const std::vector< int >& freeStateElements,
+        const std::vector< int >& constrainedStateElements, Eigen::VectorXd& constraints,
+        Eigen::MatrixXd& constraintJacobian,
+        StateAndStateTransitionMatrix& finalStateAndStateTransitionMatrix )
+{
+    const int numberOfFreeVariables = freeVariables.rows( );
+    const int numberOfConstraints = constrainedStateElements.size( );
+
+    finalStateAndStateTransitionMatrix = propagateStateAndStateTransitionMatrix(
+                massParameter_, computeInitialState( freeVariables, freeStateElements ),
+                freeVariables( numberOfFreeVariables - 1 ), integrationTolerance_ );
+    const StateAndStateTransitionMatrix finalDerivative
+            = computeStateAndStateTransitionMatrixDerivative(
+                massParameter_, 0.0, finalStateAndStateTransitionMatrix );
+
+    // Constraints are the (zero) crossing conditions at half a period; the derivative w.r.t.
+    // the half-period is the state derivative.
+    constraints.resize( numberOfConstraints );
+    constraintJacobian.resize( numberOfConstraints, numberOfFreeVariables );
+    for ( int i = 0; i < numberOfConstraints; i++ )
+    {
+        constraints( i ) = finalStateAndStateTransitionMatrix( constrainedStateElements[ i ], 0 );
+        for ( int j = 0; j < numberOfFreeVariables - 1; j++ )
+        {
+            constraintJacobian( i, j ) = finalStateAndStateTransitionMatrix(
+                        constrainedStateElements[ i ], 1 + freeStateElements[ j ] );
+        }
+        constraintJacobian( i, numberOfFreeVariables - 1 )
+                = finalDerivative( constrainedStateElements[ i ], 0 );
+    }
+}
+
+//! Correct orbit with additional linear constraint.
+bool SymmetricPeriodicOrbitCorrector::correctWithAdditionalConstraint(
+        Eigen::VectorXd& freeVariables, const std::vector< int >& freeStateElements,
+        const std::vector< int >& constrainedStateElements,
+        const Eigen::VectorXd& additionalConstraintGradient,
+        const double additionalConstraintTarget, PeriodicOrbitPointer& correctedOrbit )
+{
+    const int numberOfFreeVariables = freeVariables.rows( );
+
+    Eigen::VectorXd constraints;
+    Eigen::MatrixXd constraintJacobian;
+    StateAndStateTransitionMatrix finalStateAndStateTransitionMatrix;
+    Eigen::VectorXd augmentedConstraints( numberOfFreeVariables );
+    Eigen::MatrixXd augmentedConstraintJacobian( numberOfFreeVariables, numberOfFreeVariables );
+
+    for ( int iteration = 0; iteration <= maximumNumberOfIterations_; iteration++ )
+    {
+        if ( !( freeVariables( numberOfFreeVariables - 1 ) > 0.0 ) )
+        {
+            return false;
+        }
+
+        evaluateConstraints( freeVariables, freeStateElements, constrainedStateElements,
+                             constraints, constraintJacobian, finalStateAndStateTransitionMatrix );
+
+        augmentedConstraints.head( numberOfFreeVariables - 1 ) = constraints;
+        augmentedConstraints( numberOfFreeVariables - 1 )
+                = additionalConstraintGradient.dot( freeVariables ) - additionalConstraintTarget;
+
+        if ( augmentedConstraints.cwiseAbs( ).maxCoeff( ) < tolerance_ )
+        {
+            // Compute monodromy matrix from state transition matrix over half a period, using
+            // the symmetry of the orbit: Phi(T) = G Phi(T/2)^-1 G Phi(T/2).
+            const basic_mathematics::Matrix6d halfPeriodStateTransitionMatrix
+                    = finalStateAndStateTransitionMatrix.block( 0, 1, 6, 6 );
+            const basic_mathematics::Matrix6d symmetryMatrix
+                    = symmetryMatrixDiagonal_.asDiagonal( );
+            const basic_mathematics::Matrix6d monodromyMatrix
+                    = symmetryMatrix * halfPeriodStateTransitionMatrix.inverse( ) * symmetryMatrix
+                    * halfPeriodStateTransitionMatrix;
+
+            correctedOrbit = PeriodicOrbitPointer(
+                        new PeriodicOrbit( massParameter_,
+                                           computeInitialState( freeVariables, freeStateElements ),
+                                           2.0 * freeVariables( numberOfFreeVariables - 1 ),
+                                           monodromyMatrix ) );
+            return true;
+        }
+
+        if ( iteration == maximumNumberOfIterations_ )
+        {
+            break;
+        }
+
+        // Perform Newton step on square augmented system.
+        augmentedConstraintJacobian.topRows( numberOfFreeVariables - 1 ) = constraintJacobian;
+        augmentedConstraintJacobian.row( numberOfFreeVariables - 1 )
+                = additionalConstraintGradient.transpose( );
+        freeVariables -= augmentedConstraintJacobian.fullPivLu( ).solve( augmentedConstraints );
+
+        if ( !freeVariables.allFinite( ) )
+        {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//! Correct range of family members.
+void SymmetricPeriodicOrbitCorrector::correctFamilyMembers(
+        const int firstMember, const int endMember, const std::vector< int >& freeStateElements,
+        const std::vector< int >& constrainedStateElements,
+        const Eigen::VectorXd& additionalConstraintGradient,
+        const std::vector< double >& additionalConstraintTargets,
+        std::vector< Eigen::VectorXd >& freeVariables,
+        std::vector< PeriodicOrbitPointer >& correctedOrbits )
+{
+    for ( int i = firstMember; i < endMember; i++ )
+    {
+        // Exceptions may not leave a thread; a failed propagation is treated as non-convergence.
+        try
+        {
+            if ( !correctWithAdditionalConstraint(
+                     freeVariables[ i ], freeStateElements, constrainedStateElements,
+                     additionalConstraintGradient, additionalConstraintTargets[ i ],
+                     correctedOrbits[ i ] ) )
+            {
+                correctedOrbits[ i ].reset( );
+            }
+        }
+        catch( std::exception& )
+        {
+            correctedOrbits[ i ].reset( );
+        }
+    }
+}
+
+//! Compute family using continuation.
+std::vector< PeriodicOrbitPointer > SymmetricPeriodicOrbitCorrector::computeFamily(
+        const PeriodicOrbitPointer firstOrbit, const int continuationParameter,
+        const double stepSize, const int numberOfOrbits )
+{
+    const basic_mathematics::Vector6d firstInitialState = firstOrbit->getInitialState( );
+
+    std::vector< int > freeStateElements, constrainedStateElements;
+    getFreeAndConstrainedStateElements( firstInitialState, freeStateElements,
+                                        constrainedStateElements );
+
+    const int numberOfFreeVariables = freeStateElements.size( ) + 1;
+    Eigen::VectorXd lastFreeVariables( numberOfFreeVariables );
+    for ( unsigned int i = 0; i < freeStateElements.size( ); i++ )
+    {
+        lastFreeVariables( i ) = firstInitialState( freeStateElements[ i ] );
+    }
+    lastFreeVariables( numberOfFreeVariables - 1 ) = 0.5 * firstOrbit->getPeriod( );
+
+    // Set the gradient of the additional constraint, and the direction in which new members are
+    // predicted: the family tangent for pseudo-arclength continuation, and initially the
+    // continuation parameter for natural-parameter continuation.
+    const bool usePseudoArclengthContinuation = ( continuationParameter < 0 );
+    int continuationParameterIndex = -1;
+    Eigen::VectorXd additionalConstraintGradient;
+    if ( usePseudoArclengthContinuation )
+    {
+        additionalConstraintGradient = computeFamilyTangent(
+                    lastFreeVariables, freeStateElements, constrainedStateElements );
+        if ( additionalConstraintGradient( 0 ) < 0.0 )
+        {
+            additionalConstraintGradient *= -1.0;
+        }
+    }
+    else
+    {
+        continuationParameterIndex = getFreeVariableIndex( continuationParameter,
+                                                           freeStateElements );
+        additionalConstraintGradient = Eigen::VectorXd::Zero( numberOfFreeVariables );
+        additionalConstraintGradient( continuationParameterIndex ) = 1.0;
+    }
+    Eigen::VectorXd predictionDirection = additionalConstraintGradient;
+
+    std::vector< PeriodicOrbitPointer > family;
+    family.reserve( numberOfOrbits );
+    family.push_back( firstOrbit );
+
+    double currentStepSize = stepSize;
+    std::vector< Eigen::VectorXd > freeVariables;
+    std::vector< double > additionalConstraintTargets;
+    std::vector< PeriodicOrbitPointer > correctedOrbits;
+    while ( static_cast< int >( family.size( ) ) < numberOfOrbits )
+    {
+        // Predict batch of new members, one per thread.
+        const int numberOfMembers = std::min( numberOfThreads_, numberOfOrbits
+                                              - static_cast< int >( family.size( ) ) );
+        freeVariables.resize( numberOfMembers );
+        additionalConstraintTargets.resize( numberOfMembers );
+        correctedOrbits.assign( numberOfMembers, PeriodicOrbitPointer( ) );
+        for ( int i = 0; i < numberOfMembers; i++ )
+        {
+            const double memberStepSize = static_cast< double >( i + 1 ) * currentStepSize;
+            freeVariables[ i ] = lastFreeVariables + memberStepSize * predictionDirection;
+            additionalConstraintTargets[ i ]
+                    = additionalConstraintGradient.dot( lastFreeVariables ) + memberStepSize;
+        }
+
+        // Correct members concurrently.
+        std::vector< std::thread > threads;
+        for ( int i = 1; i < numberOfMembers; i++ )
+        {
+            threads.push_back( std::thread(
+                                   &SymmetricPeriodicOrbitCorrector::correctFamilyMembers, this,
+                                   i, i + 1, std::cref( freeStateElements ),
+                                   std::cref( constrainedStateElements ),
+                                   std::cref( additionalConstraintGradient ),
+                                   std::cref( additionalConstraintTargets ),
+                                   std::ref( freeVariables ), std::ref( correctedOrbits ) ) );
+        }
+        correctFamilyMembers( 0, 1, freeStateElements, constrainedStateElements,
+                              additionalConstraintGradient, additionalConstraintTargets,
+                              freeVariables, correctedOrbits );
+        for ( unsigned int i = 0; i < threads.size( ); i++ )
+        {
+            threads[ i ].join( );
+        }
+
+        // Accept converged members up to the first member that did not converge.
+        int numberOfConvergedMembers = 0;
+        while ( numberOfConvergedMembers < numberOfMembers
+                && correctedOrbits[ numberOfConvergedMembers ] )
+        {
+            numberOfConvergedMembers++;
+        }
+
+        if ( numberOfConvergedMembers == 0 )
+        {
+            currentStepSize *= 0.5;
+            if ( std::fabs( currentStepSize ) < 1.0E-3 * std::fabs( stepSize ) )
+            {
+                boost::throw_exception(
+                            boost::enable_error_info(
+                                std::runtime_error(
+                                    "Error, continuation of periodic orbit family failed; step "
+                                    "size was reduced below minimum." ) ) );
+            }
+            continue;
+        }
+
+        for ( int i = 0; i < numberOfConvergedMembers; i++ )
+        {
+            family.push_back( correctedOrbits[ i ] );
+        }
+        const Eigen::VectorXd previousFreeVariables = ( numberOfConvergedMembers > 1 )
+                ? freeVariables[ numberOfConvergedMembers - 2 ] : lastFreeVariables;
+        lastFreeVariables = freeVariables[ numberOfConvergedMembers - 1 ];
+
+        // Update prediction direction, keeping the orientation of the family.
+        if ( usePseudoArclengthContinuation )
+        {
+            const Eigen::VectorXd tangent = computeFamilyTangent(
+                        lastFreeVariables, freeStateElements, constrainedStateElements );
+            additionalConstraintGradient = ( tangent.dot( additionalConstraintGradient ) < 0.0 )
+                    ? Eigen::VectorXd( -tangent ) : tangent;
+            predictionDirection = additionalConstraintGradient;
+        }
+        else
+        {
+            predictionDirection = ( lastFreeVariables - previousFreeVariables )
+                    / ( lastFreeVariables( continuationParameterIndex )
+                        - previousFreeVariables( continuationParameterIndex ) );
+        }
+
+        // Restore step size after a fully converged batch.
+        if ( numberOfConvergedMembers == numberOfMembers
+             && std::fabs( currentStepSize ) < std::fabs( stepSize ) )
+        {
+            currentStepSize = ( std::fabs( 2.0 * currentStepSize ) < std::fabs( stepSize ) )
+                    ? 2.0 * currentStepSize : stepSize;
+        }
+    }
+
+    return family;
+}
+
+//! Compute tangent to family.
+Eigen::VectorXd SymmetricPeriodicOrbitCorrector::computeFamilyTangent(
+        const Eigen::VectorXd& freeVariables, const std::vector< int >& freeStateElements,
+        const std::vector< int >& constrainedStateElements )
+{
+    Eigen::VectorXd constraints;
+    Eigen::MatrixXd constraintJacobian;
+    StateAndStateTransitionMatrix finalStateAndStateTransitionMatrix;
+    evaluateConstraints( freeVariables, freeStateElements, constrainedStateElements,
+                         constraints, constraintJacobian, finalStateAndStateTransitionMatrix );
+
+    const Eigen::MatrixXd nullSpace = constraintJacobian.fullPivLu( ).kernel( );
+    return nullSpace.col( 0 ).normalized( );
+}
+
+//! Propagate multiple-shooting segments.
+void propagateMultipleShootingSegments(
+        const double massParameter,
+        const Eigen::Matrix< double, 6, Eigen::Dynamic >& patchPointStates,
+        const Eigen::VectorXd& segmentDurations, const int firstSegment, const int endSegment,
+        const double integrationTolerance,
+        std::vector< StateAndStateTransitionMatrix >& finalStatesAndStateTransitionMatrices,
+        std::vector< int >& isSegmentPropagated )
+{
+    for ( int i = firstSegment; i < endSegment; i++ )
+    {
+        // Exceptions may not leave a thread; a failed propagation is flagged instead.
+        try
+        {
+            finalStatesAndStateTransitionMatrices[ i ] = propagateStateAndStateTransitionMatrix(
+                        massParameter, patchPointStates.col( i ), segmentDurations( i ),
+                        integrationTolerance );
+            isSegmentPropagated[ i ] = 1;
+        }
+        catch( std::exception& )
+        {
+            isSegmentPropagated[ i ] = 0;
+        }
+    }
+}
+
+//! Correct periodic orbit with multiple shooting.
+PeriodicOrbitPointer correctPeriodicOrbitWithMultipleShooting(
+        const double massParameter, Eigen::Matrix< double, 6, Eigen::Dynamic >& patchPointStates,
+        Eigen::VectorXd& segmentDurations, const double tolerance,
+        const int maximumNumberOfIterations, const int numberOfThreads,
+        const double integrationTolerance )
+{
+    const int numberOfSegments = patchPointStates.cols( );
+    if ( numberOfSegments < 1 || segmentDurations.rows( ) != numberOfSegments )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, multiple shooting requires one segment duration per patch "
+                            "point." ) ) );
+    }
+
+    // Continuity constraints for all segments, except for the y-velocity at the end of the last
+    // segment, which is implied by the Jacobi integral.
+    const int numberOfConstraints = 6 * numberOfSegments - 1;
+    const int numberOfFreeVariables = 7 * numberOfSegments;
+
+    const int numberOfUsedThreads = std::max( 1, std::min( numberOfThreads, numberOfSegments ) );
+    const int segmentsPerThread = ( numberOfSegments + numberOfUsedThreads - 1 )
+            / numberOfUsedThreads;
+
+    std::vector< StateAndStateTransitionMatrix > finalStatesAndStateTransitionMatrices(
+                numberOfSegments );
+    std::vector< int > isSegmentPropagated( numberOfSegments, 0 );
+    Eigen::VectorXd constraints( numberOfConstraints );
+    Eigen::MatrixXd constraintJacobian( numberOfConstraints, numberOfFreeVariables );
+
+    for ( int iteration = 0; iteration <= maximumNumberOfIterations; iteration++ )
+    {
+        // Propagate segments, divided over threads.
+        std::vector< std::thread > threads;
+        for ( int thread = 1; thread < numberOfUsedThreads; thread++ )
+        {
+            threads.push_back( std::thread(
+                                   &propagateMultipleShootingSegments, massParameter,
+                                   std::cref( patchPointStates ), std::cref( segmentDurations ),
+                                   std::min( thread * segmentsPerThread, numberOfSegments ),
+                                   std::min( ( thread + 1 ) * segmentsPerThread,
+                                             numberOfSegments ),
+                                   integrationTolerance,
+                                   std::ref( finalStatesAndStateTransitionMatrices ),
+                                   std::ref( isSegmentPropagated ) ) );
+        }
+        propagateMultipleShootingSegments(
+                    massParameter, patchPointStates, segmentDurations, 0,
+                    std::min( segmentsPerThread, numberOfSegments ), integrationTolerance,
+                    finalStatesAndStateTransitionMatrices, isSegmentPropagated );
+        for ( unsigned int i = 0; i < threads.size( ); i++ )
+        {
+            threads[ i ].join( );
+        }
+
+        if ( std::find( isSegmentPropagated.begin( ), isSegmentPropagated.end( ), 0 )
+             != isSegmentPropagated.end( ) )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error(
+                                "Error, propagation of multiple-shooting segment failed." ) ) );
+        }
+
+        // Evaluate continuity constraints and their Jacobian w.r.t. the patch point states and
+        // segment durations.
+        constraintJacobian.setZero( );
+        for ( int i = 0; i < numberOfSegments; i++ )
+        {
+            const int nextPatchPoint = ( i + 1 ) % numberOfSegments;
+            const StateAndStateTransitionMatrix& finalStateAndStateTransitionMatrix
+                    = finalStatesAndStateTransitionMatrices[ i ];
+            const StateAndStateTransitionMatrix finalDerivative
+                    = computeStateAndStateTransitionMatrixDerivative(
+                        massParameter, 0.0, finalStateAndStateTransitionMatrix );
+
+            int constraintIndex = 6 * i;
+            for ( int j = 0; j < 6; j++ )
+            {
+                if ( i == numberOfSegments - 1 && j == yCartesianVelocityIndex )
+                {
+                    continue;
+                }
+
+                constraints( constraintIndex ) = finalStateAndStateTransitionMatrix( j, 0 )
+                        - patchPointStates( j, nextPatchPoint );
+                constraintJacobian.block( constraintIndex, 6 * i, 1, 6 )
+                        = finalStateAndStateTransitionMatrix.block( j, 1, 1, 6 );
+                constraintJacobian( constraintIndex, 6 * nextPatchPoint + j ) -= 1.0;
+                constraintJacobian( constraintIndex, 6 * numberOfSegments + i )
+                        = finalDerivative( j, 0 );
+                constraintIndex++;
+            }
+        }
+
+        if ( constraints.cwiseAbs( ).maxCoeff( ) < tolerance )
+        {
+            // Compute monodromy matrix as product of segment state transition matrices.
+            basic_mathematics::Matrix6d monodromyMatrix = basic_mathematics::Matrix6d::Identity( );
+            for ( int i = 0; i < numberOfSegments; i++ )
+            {
+                monodromyMatrix = finalStatesAndStateTransitionMatrices[ i ].block( 0, 1, 6, 6 )
+                        * monodromyMatrix;
+            }
+
+            return PeriodicOrbitPointer( new PeriodicOrbit( massParameter,
+                                                            patchPointStates.col( 0 ),
+                                                            segmentDurations.sum( ),
+                                                            monodromyMatrix ) );
+        }
+
+        if ( iteration == maximumNumberOfIterations )
+        {
+            break;
+        }
+
+        // Apply minimum-norm update of under-determined system.
+        const Eigen::VectorXd update = constraintJacobian.transpose( )
+                * ( constraintJacobian * constraintJacobian.transpose( ) ).ldlt( ).solve(
+                    constraints );
+        for ( int i = 0; i < numberOfSegments; i++ )
+        {
+            patchPointStates.col( i ) -= update.segment( 6 * i, 6 );
+        }
+        segmentDurations -= update.tail( numberOfSegments );
+
+        if ( !( segmentDurations.minCoeff( ) > 0.0 ) || !update.allFinite( ) )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error(
+                                "Error, multiple-shooting corrector of periodic orbit "
+                                "diverged." ) ) );
+        }
+    }
+
+    boost::throw_exception(
+                boost::enable_error_info(
+                    std::runtime_error(
+                        "Error, multiple-shooting corrector of periodic orbit did not "
+                        "converge." ) ) );
+}
+
+} // namespace circular_restricted_three_body_problem
+} // namespace gravitation
+} // namespace tudat
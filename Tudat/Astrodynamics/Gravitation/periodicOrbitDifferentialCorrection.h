@@ -0,0 +1,515 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Compute state derivative with CRTBP state derivative model.
+ *
+ *    References
+ *      Howell, K.C. Three-dimensional, periodic, 'halo' orbits, Celestial Mechanics, 32(1),
+ *          53-71, 1984.
+ *      Pavlak, T.A. Trajectory design and orbit maintenance strategies in multi-body dynamical
+ *          regimes, PhD thesis, Purdue University, 2013.
+ *      Doedel, E.J., et al. Elemental periodic orbits associated with the libration points in the
+ *          circular restricted 3-body problem, International Journal of Bifurcation and Chaos,
+ *          17(8), 2625-2677, 2007.
+ *
+ *    Notes
+ *      All quantities are expressed in normalized units of the CRTBP, in the frame co-rotating
+ *      with the primaries, consistent with StateDerivativeCircularRestrictedThreeBodyProblem.
+ *
+ *      The symmetric corrector uses a fixed-time formulation: the half-period is one of the free
+ *      variables, and the crossing of the plane of symmetry is imposed as a constraint. This
+ *      avoids event detection during the propagation, and gives a constraint Jacobian with a
+ *      one-dimensional null space, which is the tangent to the family used by the pseudo-arclength
+ *      continuation.
+ *
+ */
+
+#ifndef TUDAT_PERIODIC_ORBIT_DIFFERENTIAL_CORRECTION_H
+#define TUDAT_PERIODIC_ORBIT_DIFFERENTIAL_CORRECTION_H
+
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/Gravitation/stateDerivativeCircularRestrictedThreeBodyProblem.h"
+#include "Tudat/Mathematics/BasicMathematics/linearAlgebraTypes.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+namespace circular_restricted_three_body_problem
+{
+
+//! Typedef for matrix containing state (first column) and state transition matrix (last columns).
+/*!
+ * Typedef for matrix containing state (first column) and state transition matrix (last columns).
+ * The matrix is not aligned, so that it can be stored in standard containers (e.g., by the
+ * numerical integrators) without an aligned allocator.
+ */
+typedef Eigen::Matrix< double, 6, 7, Eigen::DontAlign > StateAndStateTransitionMatrix;
+
+//! Compute Jacobian of CRTBP state derivative w.r.t. state.
+/*!
+ * Computes the Jacobian of the CRTBP state derivative w.r.t. the Cartesian state, which is used
+ * to propagate the state transition matrix. It is given by:
+ * \f[
+ *      A = \left[ \begin{array}{cc} 0 & I \\ U_{rr} & 2\Omega \end{array} \right]
+ * \f]
+ * where \f$U_{rr}\f$ is the Hessian of the effective potential w.r.t. the position, and
+ * \f$\Omega\f$ is the skew-symmetric matrix of the Coriolis term.
+ * \param massParameter Mass parameter of CRTBP.
+ * \param position Position in normalized units.
+ * \return Jacobian of state derivative w.r.t. state.
+ */
+basic_mathematics::Matrix6d computeStateDerivativeJacobian( const double massParameter,
+                                                            const Eigen::Vector3d& position );
+
+//! Compute derivative of state and state transition matrix.
+/*!
+ * Computes the derivative of the combined state and state transition matrix, i.e. the state
+ * derivative of StateDerivativeCircularRestrictedThreeBodyProblem in the first column and
+ * \f$A\Phi\f$ in the remaining six columns, with the Jacobian \f$A\f$ computed analytically
+ * from computeStateDerivativeJacobian().
+ * \param massParameter Mass parameter of CRTBP.
+ * \param time Time.
+ * \param stateAndStateTransitionMatrix Current state and state transition matrix.
+ * \return Derivative of state and state transition matrix.
+ */
+StateAndStateTransitionMatrix computeStateAndStateTransitionMatrixDerivative(
+        const double massParameter, const double time,
+        const StateAndStateTransitionMatrix& stateAndStateTransitionMatrix );
+
+//! Propagate state and state transition matrix.
+/*!
+ * Propagates the state and state transition matrix (initialized to identity) from the given
+ * initial state, using a Runge-Kutta-Fehlberg 7(8) integrator.
+ * \param massParameter Mass parameter of CRTBP.
+ * \param initialState Initial state in normalized units.
+ * \param propagationTime Time over which state is propagated; must be positive.
+ * \param integrationTolerance Relative and absolute error tolerance of integrator.
+ * \return Final state (first column) and state transition matrix (last columns).
+ */
+StateAndStateTransitionMatrix propagateStateAndStateTransitionMatrix(
+        const double massParameter, const basic_mathematics::Vector6d& initialState,
+        const double propagationTime, const double integrationTolerance = 1.0E-12 );
+
+//! Periodic orbit in CRTBP.
+/*!
+ * Class containing a corrected periodic orbit of the CRTBP, defined by its initial state and
+ * period, and its monodromy matrix (the state transition matrix over one period), from which the
+ * stability of the orbit is determined.
+ */
+class PeriodicOrbit
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, sets the orbit properties, and computes its Jacobi energy and stability index.
+     * \param massParameter Mass parameter of CRTBP.
+     * \param initialState Initial state of periodic orbit.
+     * \param period Period of periodic orbit.
+     * \param monodromyMatrix State transition matrix over one period.
+     */
+    PeriodicOrbit( const double massParameter, const basic_mathematics::Vector6d& initialState,
+                   const double period, const basic_mathematics::Matrix6d& monodromyMatrix );
+
+    //! Get initial state.
+    /*!
+     * Returns the initial state of the periodic orbit.
+     * \return Initial state.
+     */
+    basic_mathematics::Vector6d getInitialState( ) { return initialState_; }
+
+    //! Get period.
+    /*!
+     * Returns the period of the periodic orbit.
+     * \return Period.
+     */
+    double getPeriod( ) { return period_; }
+
+    //! Get monodromy matrix.
+    /*!
+     * Returns the state transition matrix over one period.
+     * \return Monodromy matrix.
+     */
+    basic_mathematics::Matrix6d getMonodromyMatrix( ) { return monodromyMatrix_; }
+
+    //! Get Jacobi energy.
+    /*!
+     * Returns the Jacobi energy of the periodic orbit, as computed by computeJacobiEnergy().
+     * \return Jacobi energy.
+     */
+    double getJacobiEnergy( ) { return jacobiEnergy_; }
+
+    //! Get stability index.
+    /*!
+     * Returns the stability index \f$\frac{1}{2}(|\lambda_{max}| + 1/|\lambda_{max}|)\f$, with
+     * \f$\lambda_{max}\f$ the eigenvalue of the monodromy matrix with largest magnitude. The orbit
+     * is linearly stable if the index equals one.
+     * \return Stability index.
+     */
+    double getStabilityIndex( ) { return stabilityIndex_; }
+
+protected:
+
+private:
+
+    //! Initial state of periodic orbit.
+    const basic_mathematics::Vector6d initialState_;
+
+    //! Period of periodic orbit.
+    const double period_;
+
+    //! State transition matrix over one period.
+    const basic_mathematics::Matrix6d monodromyMatrix_;
+
+    //! Jacobi energy of periodic orbit.
+    double jacobiEnergy_;
+
+    //! Stability index of periodic orbit.
+    double stabilityIndex_;
+
+public:
+
+    EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+};
+
+//! Typedef for shared-pointer to PeriodicOrbit object.
+typedef boost::shared_ptr< PeriodicOrbit > PeriodicOrbitPointer;
+
+//! Symmetries of periodic orbits that can be corrected with single shooting.
+/*!
+ * Symmetries of periodic orbits in the CRTBP. Orbits with xz-plane symmetry (e.g., planar
+ * Lyapunov and halo orbits) start perpendicular to the xz-plane, with initial state
+ * \f$(x,0,z,0,\dot{y},0)\f$. Orbits with x-axis symmetry (e.g., vertical Lyapunov orbits) start
+ * on the x-axis, with initial state \f$(x,0,0,0,\dot{y},\dot{z})\f$. In both cases, the orbit
+ * crosses the plane or axis of symmetry again in the same way after half a period.
+ */
+enum PeriodicOrbitSymmetry
+{
+    xzPlaneSymmetry,
+    xAxisSymmetry
+};
+
+//! Differential corrector and continuation for symmetric periodic orbits in CRTBP.
+/*!
+ * Class that corrects symmetric periodic orbits with single shooting over half a period, and
+ * generates families of such orbits with natural-parameter or pseudo-arclength continuation
+ * (Howell, 1984; Doedel et al., 2007). The free variables are the non-zero components of the
+ * symmetric initial state and the half-period; the constraints are the crossing conditions at
+ * half a period. For planar orbits with xz-plane symmetry (zero initial z-position and
+ * z-velocity), the out-of-plane components are excluded. During continuation, a batch of family
+ * members, one per thread, is predicted from the last corrected member and corrected
+ * concurrently.
+ */
+class SymmetricPeriodicOrbitCorrector
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, sets the CRTBP system and the settings of the corrector.
+     * \param massParameter Mass parameter of CRTBP.
+     * \param symmetry Symmetry of the periodic orbits that are corrected.
+     * \param tolerance Tolerance on infinity norm of constraints at convergence.
+     * \param maximumNumberOfIterations Maximum number of Newton iterations per orbit.
+     * \param numberOfThreads Number of threads used to correct family members concurrently.
+     * \param integrationTolerance Relative and absolute error tolerance of integrator.
+     */
+    SymmetricPeriodicOrbitCorrector( const double massParameter,
+                                     const PeriodicOrbitSymmetry symmetry = xzPlaneSymmetry,
+                                     const double tolerance = 1.0E-11,
+                                     const int maximumNumberOfIterations = 20,
+                                     const int numberOfThreads = 1,
+                                     const double integrationTolerance = 1.0E-12 );
+
+    //! Correct periodic orbit.
+    /*!
+     * Corrects a periodic orbit from an initial guess, while keeping one component of the
+     * initial state fixed. Components of the initial state that are zero for the symmetry of the
+     * corrector are ignored. An exception is thrown if the corrector does not converge.
+     * \param initialStateGuess Initial guess of initial state.
+     * \param periodGuess Initial guess of period.
+     * \param fixedStateElement Index of component of initial state that is kept fixed; must be a
+     *          free variable for the symmetry of the corrector (e.g., x-position or z-position
+     *          for halo orbits).
+     * \return Corrected periodic orbit.
+     */
+    PeriodicOrbitPointer correctPeriodicOrbit( const basic_mathematics::Vector6d& initialStateGuess,
+                                               const double periodGuess,
+                                               const StateElementIndices fixedStateElement );
+
+    //! Compute family of periodic orbits with natural-parameter continuation.
+    /*!
+     * Computes a family of periodic orbits by stepping one component of the initial state, and
+     * correcting each new member with this component fixed. New members are predicted by
+     * extrapolating the last two members. If a member does not converge, the step size is
+     * halved; an exception is thrown if the step size is reduced by more than a factor 1000.
+     * \param firstOrbit First member of family, as returned by correctPeriodicOrbit().
+     * \param continuationParameter Index of component of initial state that is stepped.
+     * \param parameterStepSize Step in continuation parameter between family members.
+     * \param numberOfOrbits Number of family members (including the first orbit).
+     * \return Family of periodic orbits.
+     */
+    std::vector< PeriodicOrbitPointer > computeFamilyWithNaturalParameterContinuation(
+            const PeriodicOrbitPointer firstOrbit, const StateElementIndices continuationParameter,
+            const double parameterStepSize, const int numberOfOrbits );
+
+    //! Compute family of periodic orbits with pseudo-arclength continuation.
+    /*!
+     * Computes a family of periodic orbits by stepping along the tangent to the family, i.e. the
+     * null space of the constraint Jacobian, and correcting each new member with the constraint
+     * that its projection on the tangent equals the step. In contrast to natural-parameter
+     * continuation, this can follow a family through folds of any component of the initial
+     * state. The initial tangent is oriented such that a positive step increases the x-position.
+     * \param firstOrbit First member of family, as returned by correctPeriodicOrbit().
+     * \param arclengthStepSize Step in pseudo-arclength between family members.
+     * \param numberOfOrbits Number of family members (including the first orbit).
+     * \return Family of periodic orbits.
+     */
+    std::vector< PeriodicOrbitPointer > computeFamilyWithPseudoArclengthContinuation(
+            const PeriodicOrbitPointer firstOrbit, const double arclengthStepSize,
+            const int numberOfOrbits );
+
+protected:
+
+private:
+
+    //! Determine free and constrained state elements.
+    /*!
+     * Determines the components of the initial state that are free variables, and the
+     * components of the state at half a period that are constrained, for the symmetry of the
+     * corrector and the given initial state. All other components of the initial state are zero.
+     * \param initialState Initial state (used to detect planar orbits).
+     * \param freeStateElements Indices of free components of initial state (returned by
+     *          reference).
+     * \param constrainedStateElements Indices of constrained components of final state (returned
+     *          by reference).
+     */
+    void getFreeAndConstrainedStateElements( const basic_mathematics::Vector6d& initialState,
+                                             std::vector< int >& freeStateElements,
+                                             std::vector< int >& constrainedStateElements );
+
+    //! Get index of state element in vector of free variables.
+    /*!
+     * Returns the index of a component of the initial state in the vector of free variables, and
+     * throws an exception if it is not a free variable.
+     * \param stateElement Index of component of initial state.
+     * \param freeStateElements Indices of free components of initial state.
+     * \return Index in vector of free variables.
+     */
+    int getFreeVariableIndex( const int stateElement,
+                              const std::vector< int >& freeStateElements );
+
+    //! Compute initial state from free variables.
+    /*!
+     * Computes the symmetric initial state from the free variables.
+     * \param freeVariables Free variables (free components of initial state and half-period).
+     * \param freeStateElements Indices of free components of initial state.
+     * \return Initial state.
+     */
+    basic_mathematics::Vector6d computeInitialState( const Eigen::VectorXd& freeVariables,
+                                                     const std::vector< int >& freeStateElements );
+
+    //! Evaluate constraints and their Jacobian.
+    /*!
+     * Propagates the orbit defined by the free variables over half a period, and evaluates the
+     * constraints at the end, and their Jacobian w.r.t. the free variables.
+     * \param freeVariables Free variables (free components of initial state and half-period).
+     * \param freeStateElements Indices of free components of initial state.
+     * \param constrainedStateElements Indices of constrained components of final state.
+     * \param constraints Constraints (returned by reference).
+     * \param constraintJacobian Jacobian of constraints w.r.t. free variables (returned by
+     *          reference).
+     * \param finalStateAndStateTransitionMatrix State and state transition matrix at half a
+     *          period (returned by reference).
+     */
+    void evaluateConstraints( const Eigen::VectorXd& freeVariables,
+                              const std::vector< int >& freeStateElements,
+                              const std::vector< int >& constrainedStateElements,
+                              Eigen::VectorXd& constraints, Eigen::MatrixXd& constraintJacobian,
+                              StateAndStateTransitionMatrix& finalStateAndStateTransitionMatrix );
+
+    //! Correct orbit with additional linear constraint.
+    /*!
+     * Corrects the free variables with Newton's method, with the additional constraint that the
+     * inner product of the free variables and the given gradient equals the given target, which
+     * fixes a component of the initial state (natural-parameter continuation) or the step along
+     * the family tangent (pseudo-arclength continuation). Exceptions thrown during propagation
+     * are not caught.
+     * \param freeVariables Free variables; guess on input, corrected values on output.
+     * \param freeStateElements Indices of free components of initial state.
+     * \param constrainedStateElements Indices of constrained components of final state.
+     * \param additionalConstraintGradient Gradient of additional constraint.
+     * \param additionalConstraintTarget Target value of additional constraint.
+     * \param correctedOrbit Corrected orbit (returned by reference, if converged).
+     * \return True if corrector converged.
+     */
+    bool correctWithAdditionalConstraint( Eigen::VectorXd& freeVariables,
+                                          const std::vector< int >& freeStateElements,
+                                          const std::vector< int >& constrainedStateElements,
+                                          const Eigen::VectorXd& additionalConstraintGradient,
+                                          const double additionalConstraintTarget,
+                                          PeriodicOrbitPointer& correctedOrbit );
+
+    //! Correct range of family members.
+    /*!
+     * Corrects a range of predicted family members, catching any exceptions, such that it can be
+     * run on a separate thread. Members that do not converge are set to a null pointer.
+     * \param firstMember Index of first member to correct.
+     * \param endMember Index one past last member to correct.
+     * \param freeStateElements Indices of free components of initial state.
+     * \param constrainedStateElements Indices of constrained components of final state.
+     * \param additionalConstraintGradient Gradient of additional constraint.
+     * \param additionalConstraintTargets Target values of additional constraint, per member.
+     * \param freeVariables Free variables per member; predicted values on input, corrected
+     *          values on output.
+     * \param correctedOrbits Corrected orbits per member (returned by reference).
+     */
+    void correctFamilyMembers( const int firstMember, const int endMember,
+                               const std::vector< int >& freeStateElements,
+                               const std::vector< int >& constrainedStateElements,
+                               const Eigen::VectorXd& additionalConstraintGradient,
+                               const std::vector< double >& additionalConstraintTargets,
+                               std::vector< Eigen::VectorXd >& freeVariables,
+                               std::vector< PeriodicOrbitPointer >& correctedOrbits );
+
+    //! Compute family using continuation.
+    /*!
+     * Computes a family of periodic orbits, using pseudo-arclength continuation if no
+     * continuation parameter is given (negative index), and natural-parameter continuation
+     * otherwise.
+     * \param firstOrbit First member of family.
+     * \param continuationParameter Index of component of initial state that is stepped, or -1
+     *          for pseudo-arclength continuation.
+     * \param stepSize Step size between family members.
+     * \param numberOfOrbits Number of family members (including the first orbit).
+     * \return Family of periodic orbits.
+     */
+    std::vector< PeriodicOrbitPointer > computeFamily( const PeriodicOrbitPointer firstOrbit,
+                                                       const int continuationParameter,
+                                                       const double stepSize,
+                                                       const int numberOfOrbits );
+
+    //! Compute tangent to family.
+    /*!
+     * Computes the unit tangent to the family of periodic orbits, i.e. the null space of the
+     * constraint Jacobian at the given free variables.
+     * \param freeVariables Free variables of a corrected orbit.
+     * \param freeStateElements Indices of free components of initial state.
+     * \param constrainedStateElements Indices of constrained components of final state.
+     * \return Unit tangent to family.
+     */
+    Eigen::VectorXd computeFamilyTangent( const Eigen::VectorXd& freeVariables,
+                                          const std::vector< int >& freeStateElements,
+                                          const std::vector< int >& constrainedStateElements );
+
+    //! Mass parameter of CRTBP.
+    const double massParameter_;
+
+    //! Symmetry of the periodic orbits that are corrected.
+    const PeriodicOrbitSymmetry symmetry_;
+
+    //! Tolerance on infinity norm of constraints at convergence.
+    const double tolerance_;
+
+    //! Maximum number of Newton iterations per orbit.
+    const int maximumNumberOfIterations_;
+
+    //! Number of threads used to correct family members concurrently.
+    const int numberOfThreads_;
+
+    //! Relative and absolute error tolerance of integrator.
+    const double integrationTolerance_;
+
+    //! Diagonal of symmetry matrix, which maps the state to its mirror image.
+    basic_mathematics::Vector6d symmetryMatrixDiagonal_;
+};
+
+//! Typedef for shared-pointer to SymmetricPeriodicOrbitCorrector object.
+typedef boost::shared_ptr< SymmetricPeriodicOrbitCorrector > SymmetricPeriodicOrbitCorrectorPointer;
+
+//! Propagate multiple-shooting segments.
+/*!
+ * Propagates the state and state transition matrix of a range of multiple-shooting segments,
+ * such that it can be run on a separate thread. Exceptions are caught, and flagged in the
+ * success indicators.
+ * \param massParameter Mass parameter of CRTBP.
+ * \param patchPointStates States at patch points, one per column.
+ * \param segmentDurations Durations of segments starting at each patch point.
+ * \param firstSegment Index of first segment to propagate.
+ * \param endSegment Index one past last segment to propagate.
+ * \param integrationTolerance Relative and absolute error tolerance of integrator.
+ * \param finalStatesAndStateTransitionMatrices Final state and state transition matrix per
+ *          segment (returned by reference).
+ * \param isSegmentPropagated Indicator per segment, set to 1 if propagation succeeded and 0
+ *          otherwise (returned by reference).
+ */
+void propagateMultipleShootingSegments(
+        const double massParameter,
+        const Eigen::Matrix< double, 6, Eigen::Dynamic >& patchPointStates,
+        const Eigen::VectorXd& segmentDurations, const int firstSegment, const int endSegment,
+        const double integrationTolerance,
+        std::vector< StateAndStateTransitionMatrix >& finalStatesAndStateTransitionMatrices,
+        std::vector< int >& isSegmentPropagated );
+
+//! Correct periodic orbit with multiple shooting.
+/*!
+ * Corrects a (not necessarily symmetric) periodic orbit, discretized by a set of patch points,
+ * with multiple shooting (Pavlak, 2013). The free variables are the states at all patch points
+ * and the durations of all segments; the constraints are continuity between consecutive
+ * segments and periodicity between the end of the last segment and the first patch point. The
+ * periodicity constraint on the y-velocity is omitted, as it is implied by the other constraints
+ * and the Jacobi integral. Since the system is under-determined, the minimum-norm update is used
+ * in each iteration. Segments are propagated concurrently on the given number of threads. An
+ * exception is thrown if the corrector does not converge.
+ * \param massParameter Mass parameter of CRTBP.
+ * \param patchPointStates States at patch points, one per column; guesses on input, corrected
+ *          states on output.
+ * \param segmentDurations Durations of segments starting at each patch point; guesses on input,
+ *          corrected durations on output.
+ * \param tolerance Tolerance on infinity norm of constraints at convergence.
+ * \param maximumNumberOfIterations Maximum number of iterations.
+ * \param numberOfThreads Number of threads used to propagate segments.
+ * \param integrationTolerance Relative and absolute error tolerance of integrator.
+ * \return Corrected periodic orbit, starting at the first patch point.
+ */
+PeriodicOrbitPointer correctPeriodicOrbitWithMultipleShooting(
+        const double massParameter, Eigen::Matrix< double, 6, Eigen::Dynamic >& patchPointStates,
+        Eigen::VectorXd& segmentDurations, const double tolerance = 1.0E-11,
+        const int maximumNumberOfIterations = 20, const int numberOfThreads = 1,
+        const double integrationTolerance = 1.0E-12 );
+
+} // namespace circular_restricted_three_body_problem
+} // namespace gravitation
+} // namespace tudat
+
+#endif // TUDAT_PERIODIC_ORBIT_DIFFERENTIAL_CORRECTION_H
@@ -0,0 +1,433 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Added truncation of workspace update and acceleration sum.
+ *
+ *    References
+ *      Pines, S. Uniform representation of the gravitational potential and its derivatives,
+ *          AIAA Journal, 11(11), 1508-1511, 1973.
+ *      Eckman, R.A., Brown, A.J., Adamo, D.R. Normalization of gravitational acceleration models,
+ *          NASA/TP-2011-216156, 2011.
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include "Tudat/Astrodynamics/Gravitation/pinesSphericalHarmonicsGravityModel.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+
+//! Constructor.
+PinesSphericalHarmonicsWorkspace::PinesSphericalHarmonicsWorkspace( const int maximumDegree,
+                                                                    const int maximumOrder )
+    : maximumDegree_( maximumDegree ),
+      maximumOrder_( maximumOrder ),
+      radius_( 0.0 ),
+      unitPosition_( Eigen::Vector3d::UnitX( ) )
+{
+    if ( maximumDegree_ < 0 || maximumOrder_ < 0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, maximum degree and order of Pines spherical harmonics "
+                            "workspace must be non-negative." ) ) );
+    }
+
+    // Derived Legendre functions are required up to one degree and two orders higher than the
+    // expansion itself.
+    const int numberOfDegrees = maximumDegree_ + 2;
+    const int numberOfOrders = maximumOrder_ + 3;
+
+    verticalRecurrenceFactors_ = Eigen::MatrixXd::Zero( numberOfDegrees, numberOfOrders );
+    secondVerticalRecurrenceFactors_ = Eigen::MatrixXd::Zero( numberOfDegrees, numberOfOrders );
+    sectoralRecurrenceFactors_ = Eigen::VectorXd::Zero( numberOfOrders );
+    orderDerivativeFactors_ = Eigen::MatrixXd::Zero( numberOfDegrees, numberOfOrders - 1 );
+    degreeOrderDerivativeFactors_
+            = Eigen::MatrixXd::Zero( numberOfDegrees - 1, numberOfOrders - 2 );
+
+    derivedLegendreFunctions_ = Eigen::MatrixXd::Zero( numberOfDegrees, numberOfOrders );
+    realParts_ = Eigen::VectorXd::Zero( maximumOrder_ + 1 );
+    imaginaryParts_ = Eigen::VectorXd::Zero( maximumOrder_ + 1 );
+    radiusRatioPowers_ = Eigen::VectorXd::Zero( maximumDegree_ + 1 );
+
+    // Precompute recurrence factors.
+    for ( int order = 1; order < numberOfOrders; order++ )
+    {
+        const double m = static_cast< double >( order );
+        sectoralRecurrenceFactors_( order ) = ( order == 1 ) ?
+                    std::sqrt( 3.0 ) : std::sqrt( ( 2.0 * m + 1.0 ) / ( 2.0 * m ) );
+    }
+
+    for ( int degree = 1; degree < numberOfDegrees; degree++ )
+    {
+        const double n = static_cast< double >( degree );
+        for ( int order = 0; order < degree && order < numberOfOrders; order++ )
+        {
+            const double m = static_cast< double >( order );
+            verticalRecurrenceFactors_( degree, order ) = std::sqrt(
+                        ( 2.0 * n - 1.0 ) * ( 2.0 * n + 1.0 ) / ( ( n - m ) * ( n + m ) ) );
+
+            if ( degree > order + 1 )
+            {
+                secondVerticalRecurrenceFactors_( degree, order ) = std::sqrt(
+                            ( 2.0 * n + 1.0 ) * ( n + m - 1.0 ) * ( n - m - 1.0 )
+                            / ( ( n - m ) * ( n + m ) * ( 2.0 * n - 3.0 ) ) );
+            }
+        }
+    }
+
+    // Precompute derivative factors; the factor ( 2 - delta_0m ) / 2 accounts for the difference
+    // in normalization between order zero and higher orders.
+    for ( int degree = 0; degree < numberOfDegrees; degree++ )
+    {
+        const double n = static_cast< double >( degree );
+        for ( int order = 0; order <= degree && order < numberOfOrders - 1; order++ )
+        {
+            const double m = static_cast< double >( order );
+            const double normalizationRatio = ( order == 0 ) ? 0.5 : 1.0;
+            orderDerivativeFactors_( degree, order ) = std::sqrt(
+                        normalizationRatio * ( n - m ) * ( n + m + 1.0 ) );
+
+            if ( degree < numberOfDegrees - 1 && order < numberOfOrders - 2 )
+            {
+                degreeOrderDerivativeFactors_( degree, order ) = std::sqrt(
+                            normalizationRatio * ( 2.0 * n + 1.0 ) / ( 2.0 * n + 3.0 )
+                            * ( n + m + 1.0 ) * ( n + m + 2.0 ) );
+            }
+        }
+    }
+}
+
+//! Update workspace to new position.
+void PinesSphericalHarmonicsWorkspace::update( const Eigen::Vector3d& cartesianPosition,
+                                               const double referenceRadius,
+                                               const int truncationDegree,
+                                               const int truncationOrder )
+{
+    // Determine degree and order up to which terms are evaluated.
+    const int evaluatedMaximumDegree = ( truncationDegree < 0 )
+            ? maximumDegree_ : std::min( truncationDegree, maximumDegree_ );
+    const int evaluatedMaximumOrder = ( truncationOrder < 0 )
+            ? maximumOrder_ : std::min( truncationOrder, maximumOrder_ );
+
+    radius_ = cartesianPosition.norm( );
+    unitPosition_ = cartesianPosition / radius_;
+
+    // Compute powers of radius ratio.
+    const double radiusRatio = referenceRadius / radius_;
+    radiusRatioPowers_( 0 ) = 1.0;
+    for ( int degree = 1; degree <= evaluatedMaximumDegree; degree++ )
+    {
+        radiusRatioPowers_( degree ) = radiusRatioPowers_( degree - 1 ) * radiusRatio;
+    }
+
+    // Compute real and imaginary parts of ( s + i t )^m.
+    realParts_( 0 ) = 1.0;
+    imaginaryParts_( 0 ) = 0.0;
+    for ( int order = 1; order <= evaluatedMaximumOrder; order++ )
+    {
+        realParts_( order ) = unitPosition_.x( ) * realParts_( order - 1 )
+                - unitPosition_.y( ) * imaginaryParts_( order - 1 );
+        imaginaryParts_( order ) = unitPosition_.x( ) * imaginaryParts_( order - 1 )
+                + unitPosition_.y( ) * realParts_( order - 1 );
+    }
+
+    // Compute derived Legendre functions column-wise, starting each column from the sectoral term.
+    const int highestDegree = evaluatedMaximumDegree + 1;
+    const int highestOrder = std::min( evaluatedMaximumOrder + 2, highestDegree );
+    const double u = unitPosition_.z( );
+    derivedLegendreFunctions_( 0, 0 ) = 1.0;
+    for ( int order = 0; order <= highestOrder; order++ )
+    {
+        if ( order > 0 )
+        {
+            derivedLegendreFunctions_( order, order ) = sectoralRecurrenceFactors_( order )
+                    * derivedLegendreFunctions_( order - 1, order - 1 );
+        }
+
+        if ( order < highestDegree )
+        {
+            derivedLegendreFunctions_( order + 1, order )
+                    = verticalRecurrenceFactors_( order + 1, order ) * u
+                    * derivedLegendreFunctions_( order, order );
+        }
+
+        for ( int degree = order + 2; degree <= highestDegree; degree++ )
+        {
+            derivedLegendreFunctions_( degree, order )
+                    = verticalRecurrenceFactors_( degree, order ) * u
+                    * derivedLegendreFunctions_( degree - 1, order )
+                    - secondVerticalRecurrenceFactors_( degree, order )
+                    * derivedLegendreFunctions_( degree - 2, order );
+        }
+    }
+}
+
+//! Check consistency of Pines workspace, coefficients and position.
+void checkPinesSphericalHarmonicsInput( const Eigen::Vector3d& positionOfBodySubjectToAcceleration,
+                                        const double equatorialRadius,
+                                        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+                                        const PinesSphericalHarmonicsWorkspace& pinesWorkspace )
+{
+    if ( pinesWorkspace.getMaximumDegree( ) < cosineHarmonicCoefficients.rows( ) - 1
+         || pinesWorkspace.getMaximumOrder( ) < cosineHarmonicCoefficients.cols( ) - 1 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, Pines spherical harmonics workspace is too small for "
+                            "coefficient matrices." ) ) );
+    }
+
+    if ( positionOfBodySubjectToAcceleration.norm( ) < equatorialRadius )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Distance to origin is smaller than the size of the main body." ) ) );
+    }
+}
+
+//! Compute gravitational acceleration due to geodesy-normalized spherical harmonics expansion,
+//! using the Pines formulation.
+Eigen::Vector3d computePinesGeodesyNormalizedGravitationalAccelerationSum(
+        const Eigen::Vector3d& positionOfBodySubjectToAcceleration,
+        const double gravitationalParameter,
+        const double equatorialRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        PinesSphericalHarmonicsWorkspace& pinesWorkspace,
+        const int truncationDegree )
+{
+    checkPinesSphericalHarmonicsInput( positionOfBodySubjectToAcceleration, equatorialRadius,
+                                       cosineHarmonicCoefficients, pinesWorkspace );
+
+    // Set highest degree and order (exclusive) that are summed.
+    const int highestDegree = ( truncationDegree < 0 )
+            ? static_cast< int >( cosineHarmonicCoefficients.rows( ) )
+            : std::min( static_cast< int >( cosineHarmonicCoefficients.rows( ) ),
+                        truncationDegree + 1 );
+    const int highestOrder = std::min( static_cast< int >( cosineHarmonicCoefficients.cols( ) ),
+                                       highestDegree );
+
+    // Compute derived Legendre functions and (s + i t)^m terms in single pass.
+    pinesWorkspace.update( positionOfBodySubjectToAcceleration, equatorialRadius,
+                           highestDegree - 1, highestOrder - 1 );
+    const Eigen::Vector3d unitPosition = pinesWorkspace.getUnitPosition( );
+
+    Eigen::Vector3d accelerationSum = Eigen::Vector3d::Zero( );
+    for ( int degree = 0; degree < highestDegree; degree++ )
+    {
+        double a1 = 0.0;
+        double a2 = 0.0;
+        double a3 = 0.0;
+        double a4 = 0.0;
+        for ( int order = 0; order <= degree && order < highestOrder; order++ )
+        {
+            const double cosineCoefficient = cosineHarmonicCoefficients( degree, order );
+            const double sineCoefficient = sineHarmonicCoefficients( degree, order );
+            const double coefficientTerm
+                    = cosineCoefficient * pinesWorkspace.getRealPart( order )
+                    + sineCoefficient * pinesWorkspace.getImaginaryPart( order );
+
+            if ( order > 0 )
+            {
+                const double orderTimesLegendreFunction = static_cast< double >( order )
+                        * pinesWorkspace.getDerivedLegendreFunction( degree, order );
+                a1 += orderTimesLegendreFunction
+                        * ( cosineCoefficient * pinesWorkspace.getRealPart( order - 1 )
+                            + sineCoefficient * pinesWorkspace.getImaginaryPart( order - 1 ) );
+                a2 += orderTimesLegendreFunction
+                        * ( sineCoefficient * pinesWorkspace.getRealPart( order - 1 )
+                            - cosineCoefficient * pinesWorkspace.getImaginaryPart( order - 1 ) );
+            }
+
+            a3 += pinesWorkspace.getOrderDerivativeFactor( degree, order )
+                    * pinesWorkspace.getDerivedLegendreFunction( degree, order + 1 )
+                    * coefficientTerm;
+            a4 -= pinesWorkspace.getDegreeOrderDerivativeFactor( degree, order )
+                    * pinesWorkspace.getDerivedLegendreFunction( degree + 1, order + 1 )
+                    * coefficientTerm;
+        }
+
+        accelerationSum += pinesWorkspace.getRadiusRatioPower( degree )
+                * ( Eigen::Vector3d( a1, a2, a3 ) + a4 * unitPosition );
+    }
+
+    const double radius = pinesWorkspace.getRadius( );
+    return gravitationalParameter / ( radius * radius ) * accelerationSum;
+}
+
+//! Compute gravity gradient tensor due to geodesy-normalized spherical harmonics expansion,
+//! using the Pines formulation.
+Eigen::Matrix3d computePinesGeodesyNormalizedGravityGradientTensor(
+        const Eigen::Vector3d& positionOfBodySubjectToAcceleration,
+        const double gravitationalParameter,
+        const double equatorialRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        PinesSphericalHarmonicsWorkspace& pinesWorkspace,
+        Eigen::Vector3d& acceleration )
+{
+    checkPinesSphericalHarmonicsInput( positionOfBodySubjectToAcceleration, equatorialRadius,
+                                       cosineHarmonicCoefficients, pinesWorkspace );
+
+    // Compute derived Legendre functions and (s + i t)^m terms in single pass.
+    pinesWorkspace.update( positionOfBodySubjectToAcceleration, equatorialRadius );
+    const Eigen::Vector3d unitPosition = pinesWorkspace.getUnitPosition( );
+
+    const int highestDegree = cosineHarmonicCoefficients.rows( );
+    const int highestOrder = cosineHarmonicCoefficients.cols( );
+
+    // Sums of acceleration terms (weighted for radial derivative), and of derivatives of
+    // acceleration terms w.r.t. s, t and u.
+    Eigen::Vector3d accelerationSum = Eigen::Vector3d::Zero( );
+    Eigen::Vector3d radialDerivativeSum = Eigen::Vector3d::Zero( );
+    Eigen::Matrix3d directionDerivativeSum = Eigen::Matrix3d::Zero( );
+
+    for ( int degree = 0; degree < highestDegree; degree++ )
+    {
+        // Acceleration terms a1, a2, a3 and a4 of current degree.
+        Eigen::Vector3d accelerationTerms = Eigen::Vector3d::Zero( );
+        double a4 = 0.0;
+
+        // Derivatives of a1, a2, a3 (rows) and a4 w.r.t. s, t and u (columns).
+        Eigen::Matrix3d accelerationTermDerivatives = Eigen::Matrix3d::Zero( );
+        Eigen::Vector3d a4Derivatives = Eigen::Vector3d::Zero( );
+
+        for ( int order = 0; order <= degree && order < highestOrder; order++ )
+        {
+            const double m = static_cast< double >( order );
+            const double cosineCoefficient = cosineHarmonicCoefficients( degree, order );
+            const double sineCoefficient = sineHarmonicCoefficients( degree, order );
+
+            const double legendreFunction
+                    = pinesWorkspace.getDerivedLegendreFunction( degree, order );
+            const double orderDerivativeFactor
+                    = pinesWorkspace.getOrderDerivativeFactor( degree, order );
+            const double firstOrderDerivative = orderDerivativeFactor
+                    * pinesWorkspace.getDerivedLegendreFunction( degree, order + 1 );
+            const double secondOrderDerivative = orderDerivativeFactor
+                    * pinesWorkspace.getOrderDerivativeFactor( degree, order + 1 )
+                    * pinesWorkspace.getDerivedLegendreFunction( degree, order + 2 );
+            const double degreeOrderDerivativeFactor
+                    = pinesWorkspace.getDegreeOrderDerivativeFactor( degree, order );
+            const double radialLegendreFunction = degreeOrderDerivativeFactor
+                    * pinesWorkspace.getDerivedLegendreFunction( degree + 1, order + 1 );
+            const double radialLegendreFunctionDerivative = degreeOrderDerivativeFactor
+                    * pinesWorkspace.getOrderDerivativeFactor( degree + 1, order + 1 )
+                    * pinesWorkspace.getDerivedLegendreFunction( degree + 1, order + 2 );
+
+            const double coefficientTerm
+                    = cosineCoefficient * pinesWorkspace.getRealPart( order )
+                    + sineCoefficient * pinesWorkspace.getImaginaryPart( order );
+
+            accelerationTerms( 2 ) += firstOrderDerivative * coefficientTerm;
+            a4 -= radialLegendreFunction * coefficientTerm;
+            accelerationTermDerivatives( 2, 2 ) += secondOrderDerivative * coefficientTerm;
+            a4Derivatives( 2 ) -= radialLegendreFunctionDerivative * coefficientTerm;
+
+            if ( order > 0 )
+            {
+                const double firstCoefficientTerm
+                        = cosineCoefficient * pinesWorkspace.getRealPart( order - 1 )
+                        + sineCoefficient * pinesWorkspace.getImaginaryPart( order - 1 );
+                const double secondCoefficientTerm
+                        = sineCoefficient * pinesWorkspace.getRealPart( order - 1 )
+                        - cosineCoefficient * pinesWorkspace.getImaginaryPart( order - 1 );
+
+                accelerationTerms( 0 ) += m * legendreFunction * firstCoefficientTerm;
+                accelerationTerms( 1 ) += m * legendreFunction * secondCoefficientTerm;
+
+                accelerationTermDerivatives( 0, 2 ) += m * firstOrderDerivative
+                        * firstCoefficientTerm;
+                accelerationTermDerivatives( 1, 2 ) += m * firstOrderDerivative
+                        * secondCoefficientTerm;
+                accelerationTermDerivatives( 2, 0 ) += m * firstOrderDerivative
+                        * firstCoefficientTerm;
+                accelerationTermDerivatives( 2, 1 ) += m * firstOrderDerivative
+                        * secondCoefficientTerm;
+
+                a4Derivatives( 0 ) -= m * radialLegendreFunction * firstCoefficientTerm;
+                a4Derivatives( 1 ) -= m * radialLegendreFunction * secondCoefficientTerm;
+
+                if ( order > 1 )
+                {
+                    const double firstSecondCoefficientTerm
+                            = cosineCoefficient * pinesWorkspace.getRealPart( order - 2 )
+                            + sineCoefficient * pinesWorkspace.getImaginaryPart( order - 2 );
+                    const double secondSecondCoefficientTerm
+                            = sineCoefficient * pinesWorkspace.getRealPart( order - 2 )
+                            - cosineCoefficient * pinesWorkspace.getImaginaryPart( order - 2 );
+                    const double orderFactor = m * ( m - 1.0 ) * legendreFunction;
+
+                    accelerationTermDerivatives( 0, 0 ) += orderFactor
+                            * firstSecondCoefficientTerm;
+                    accelerationTermDerivatives( 0, 1 ) += orderFactor
+                            * secondSecondCoefficientTerm;
+                    accelerationTermDerivatives( 1, 0 ) += orderFactor
+                            * secondSecondCoefficientTerm;
+                    accelerationTermDerivatives( 1, 1 ) -= orderFactor
+                            * firstSecondCoefficientTerm;
+                }
+            }
+        }
+
+        // Add contribution of current degree; the derivative of the term a4 * ( s, t, u ) w.r.t.
+        // the direction cosines contains both the derivative of a4 and of the unit vector.
+        const double radiusRatioPower = pinesWorkspace.getRadiusRatioPower( degree );
+        const Eigen::Vector3d degreeAcceleration = accelerationTerms + a4 * unitPosition;
+        accelerationSum += radiusRatioPower * degreeAcceleration;
+        radialDerivativeSum += static_cast< double >( degree + 2 ) * radiusRatioPower
+                * degreeAcceleration;
+        directionDerivativeSum += radiusRatioPower
+                * ( accelerationTermDerivatives + unitPosition * a4Derivatives.transpose( )
+                    + a4 * Eigen::Matrix3d::Identity( ) );
+    }
+
+    const double radius = pinesWorkspace.getRadius( );
+    acceleration = gravitationalParameter / ( radius * radius ) * accelerationSum;
+
+    // Convert derivatives w.r.t. radius and direction cosines to derivatives w.r.t. Cartesian
+    // position, using d(s,t,u)/dx = ( I - e e^T ) / r and dr/dx = e^T, with e the unit position.
+    return gravitationalParameter / ( radius * radius * radius )
+            * ( -radialDerivativeSum * unitPosition.transpose( ) + directionDerivativeSum
+                - directionDerivativeSum * unitPosition * unitPosition.transpose( ) );
+}
+
+} // namespace gravitation
+} // namespace tudat
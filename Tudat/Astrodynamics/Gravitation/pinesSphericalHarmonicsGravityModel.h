@@ -0,0 +1,347 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Added truncation degree to acceleration sum.
+ *
+ *    References
+ *      Pines, S. Uniform representation of the gravitational potential and its derivatives,
+ *          AIAA Journal, 11(11), 1508-1511, 1973.
+ *      Eckman, R.A., Brown, A.J., Adamo, D.R. Normalization of gravitational acceleration models,
+ *          NASA/TP-2011-216156, 2011.
+ *
+ *    Notes
+ *      In the Pines formulation, the spherical harmonics expansion is written in terms of the
+ *      direction cosines s = x/r, t = y/r and u = z/r of the position vector, and of the derived
+ *      Legendre functions A_{n,m}( u ) = d^m P_{n}( u ) / du^m. Since no spherical coordinates
+ *      are used, the formulation has no singularities at the poles, and no trigonometric functions
+ *      need to be evaluated.
+ *
+ */
+
+#ifndef TUDAT_PINES_SPHERICAL_HARMONICS_GRAVITY_MODEL_H
+#define TUDAT_PINES_SPHERICAL_HARMONICS_GRAVITY_MODEL_H
+
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+namespace gravitation
+{
+
+//! Workspace for evaluation of spherical harmonics expansion with the Pines formulation.
+/*!
+ * This class evaluates, in a single pass, all quantities that are required to evaluate a
+ * (geodesy-normalized) spherical harmonics expansion, and its first and second derivatives, with
+ * the Pines formulation (Pines, 1973): the geodesy-normalized derived Legendre functions
+ * \f$ \bar{A}_{n,m}( u ) \f$, the real and imaginary parts \f$ r_{m} \f$ and \f$ i_{m} \f$ of
+ * \f$ ( s + i t )^{ m } \f$ and the powers \f$ ( R / r )^{ n } \f$. The derived Legendre functions
+ * are computed with (Eckman et al., 2011):
+ * \f{eqnarray*}{
+ *     \bar{A}_{m,m} &=& \sqrt{ \frac{ 2m + 1 }{ 2m } } \bar{A}_{m-1,m-1} \\
+ *     \bar{A}_{n,m} &=& a_{n,m} u \bar{A}_{n-1,m} - b_{n,m} \bar{A}_{n-2,m}
+ * \f}
+ * with \f$ \bar{A}_{0,0} = 1 \f$, \f$ \bar{A}_{1,1} = \sqrt{ 3 } \f$, and \f$ a_{n,m} \f$ and
+ * \f$ b_{n,m} \f$ the same factors as used for the geodesy-normalized Legendre polynomials. The
+ * derived Legendre functions are computed up to one degree and two orders higher than the
+ * maximum degree and order of the expansion, as required for the derivatives. All normalization
+ * factors are precomputed when the workspace is constructed.
+ */
+class PinesSphericalHarmonicsWorkspace
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, allocates memory and precomputes all normalization factors for the given
+     * maximum degree and order.
+     * \param maximumDegree Maximum degree of spherical harmonics expansion.
+     * \param maximumOrder Maximum order of spherical harmonics expansion.
+     */
+    PinesSphericalHarmonicsWorkspace( const int maximumDegree, const int maximumOrder );
+
+    //! Update workspace to new position.
+    /*!
+     * Computes the derived Legendre functions, the real and imaginary parts of
+     * \f$ ( s + i t )^{ m } \f$ and the radius ratio powers at the given position, up to the
+     * maximum degree and order, or up to the given (lower) truncation degree and order. In the
+     * latter case, only the terms required up to the truncation degree and order are valid after
+     * the update.
+     * \param cartesianPosition Cartesian position, in the frame in which the spherical harmonics
+     *          expansion is defined.
+     * \param referenceRadius Reference radius of the spherical harmonics expansion.
+     * \param truncationDegree Degree up to which terms are evaluated; a negative value denotes
+     *          the maximum degree of the workspace (default = -1).
+     * \param truncationOrder Order up to which terms are evaluated; a negative value denotes
+     *          the maximum order of the workspace (default = -1).
+     */
+    void update( const Eigen::Vector3d& cartesianPosition, const double referenceRadius,
+                 const int truncationDegree = -1, const int truncationOrder = -1 );
+
+    //! Get maximum degree.
+    /*!
+     * Returns the maximum degree of the expansion for which the workspace computes terms.
+     * \return Maximum degree.
+     */
+    int getMaximumDegree( ) const { return maximumDegree_; }
+
+    //! Get maximum order.
+    /*!
+     * Returns the maximum order of the expansion for which the workspace computes terms.
+     * \return Maximum order.
+     */
+    int getMaximumOrder( ) const { return maximumOrder_; }
+
+    //! Get geodesy-normalized derived Legendre function.
+    /*!
+     * Returns geodesy-normalized derived Legendre function at the position of the last update.
+     * Degrees up to one more than the maximum degree, and orders up to two more than the maximum
+     * order are available. The function is zero if the order exceeds the degree.
+     * \param degree Degree of derived Legendre function.
+     * \param order Order of derived Legendre function.
+     * \return Derived Legendre function.
+     */
+    double getDerivedLegendreFunction( const int degree, const int order ) const
+    {
+        return derivedLegendreFunctions_( degree, order );
+    }
+
+    //! Get real part of ( s + i t )^m.
+    /*!
+     * Returns real part of \f$ ( s + i t )^{ m } \f$ at the position of the last update.
+     * \param order Order m.
+     * \return Real part of ( s + i t )^m.
+     */
+    double getRealPart( const int order ) const { return realParts_( order ); }
+
+    //! Get imaginary part of ( s + i t )^m.
+    /*!
+     * Returns imaginary part of \f$ ( s + i t )^{ m } \f$ at the position of the last update.
+     * \param order Order m.
+     * \return Imaginary part of ( s + i t )^m.
+     */
+    double getImaginaryPart( const int order ) const { return imaginaryParts_( order ); }
+
+    //! Get power of ratio of reference radius and radius.
+    /*!
+     * Returns ratio of reference radius and radius to the power degree, at the position of the
+     * last update.
+     * \param degree Degree.
+     * \return (R/r)^degree.
+     */
+    double getRadiusRatioPower( const int degree ) const { return radiusRatioPowers_( degree ); }
+
+    //! Get factor relating derivative of derived Legendre function to next order.
+    /*!
+     * Returns factor \f$ \sqrt{ ( 2 - \delta_{0,m} ) ( n - m ) ( n + m + 1 ) / 2 } \f$, with which
+     * \f$ \bar{A}_{n,m+1} \f$ is multiplied to obtain \f$ d\bar{A}_{n,m} / du \f$.
+     * \param degree Degree n.
+     * \param order Order m.
+     * \return Derivative factor.
+     */
+    double getOrderDerivativeFactor( const int degree, const int order ) const
+    {
+        return orderDerivativeFactors_( degree, order );
+    }
+
+    //! Get factor relating radial term of derived Legendre function to next degree and order.
+    /*!
+     * Returns factor
+     * \f$ \sqrt{ ( 2 - \delta_{0,m} ) ( 2n + 1 ) ( n + m + 1 ) ( n + m + 2 )
+     *      / ( 2 ( 2n + 3 ) ) } \f$
+     * with which \f$ \bar{A}_{n+1,m+1} \f$ is multiplied in the radial term of the acceleration.
+     * \param degree Degree n.
+     * \param order Order m.
+     * \return Radial term factor.
+     */
+    double getDegreeOrderDerivativeFactor( const int degree, const int order ) const
+    {
+        return degreeOrderDerivativeFactors_( degree, order );
+    }
+
+    //! Get radius.
+    /*!
+     * Returns radial distance of the position of the last update.
+     * \return Radius.
+     */
+    double getRadius( ) const { return radius_; }
+
+    //! Get unit position vector.
+    /*!
+     * Returns unit vector (s, t, u) along the position of the last update.
+     * \return Unit position vector.
+     */
+    Eigen::Vector3d getUnitPosition( ) const { return unitPosition_; }
+
+protected:
+
+private:
+
+    //! Maximum degree of spherical harmonics expansion.
+    int maximumDegree_;
+
+    //! Maximum order of spherical harmonics expansion.
+    int maximumOrder_;
+
+    //! Factors a_{n,m} of vertical recurrence.
+    Eigen::MatrixXd verticalRecurrenceFactors_;
+
+    //! Factors b_{n,m} of vertical recurrence.
+    Eigen::MatrixXd secondVerticalRecurrenceFactors_;
+
+    //! Factors of sectoral recurrence, per order.
+    Eigen::VectorXd sectoralRecurrenceFactors_;
+
+    //! Factors with which A_{n,m+1} is multiplied to obtain derivative of A_{n,m} w.r.t. u.
+    Eigen::MatrixXd orderDerivativeFactors_;
+
+    //! Factors with which A_{n+1,m+1} is multiplied in radial term of acceleration.
+    Eigen::MatrixXd degreeOrderDerivativeFactors_;
+
+    //! Geodesy-normalized derived Legendre functions.
+    Eigen::MatrixXd derivedLegendreFunctions_;
+
+    //! Real parts of ( s + i t )^m.
+    Eigen::VectorXd realParts_;
+
+    //! Imaginary parts of ( s + i t )^m.
+    Eigen::VectorXd imaginaryParts_;
+
+    //! Powers of ratio of reference radius and radius.
+    Eigen::VectorXd radiusRatioPowers_;
+
+    //! Radius at last update.
+    double radius_;
+
+    //! Unit position vector at last update.
+    Eigen::Vector3d unitPosition_;
+};
+
+//! Typedef for shared-pointer to PinesSphericalHarmonicsWorkspace.
+typedef boost::shared_ptr< PinesSphericalHarmonicsWorkspace >
+PinesSphericalHarmonicsWorkspacePointer;
+
+//! Check consistency of Pines workspace, coefficients and position.
+/*!
+ * Checks whether the maximum degree and order of the workspace are sufficient for the given
+ * coefficient matrix, and whether the position is outside the reference sphere. A runtime error
+ * is thrown if either condition is violated.
+ * \param positionOfBodySubjectToAcceleration Cartesian position vector with respect to the
+ *          reference frame that is associated with the harmonic coefficients [m].
+ * \param equatorialRadius Reference radius of the spherical harmonics [m].
+ * \param cosineHarmonicCoefficients Matrix with cosine harmonic coefficients.
+ * \param pinesWorkspace Workspace used to evaluate the spherical harmonics terms.
+ */
+void checkPinesSphericalHarmonicsInput( const Eigen::Vector3d& positionOfBodySubjectToAcceleration,
+                                        const double equatorialRadius,
+                                        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+                                        const PinesSphericalHarmonicsWorkspace& pinesWorkspace );
+
+//! Compute gravitational acceleration due to geodesy-normalized spherical harmonics expansion,
+//! using the Pines formulation.
+/*!
+ * Computes the gravitational acceleration due to a spherical harmonics expansion with
+ * geodesy-normalized coefficients, using the singularity-free formulation of Pines (1973),
+ * normalized as described by Eckman et al. (2011):
+ * \f{eqnarray*}{
+ *     \bar{a} &=& \frac{ \mu }{ r^{ 2 } } \sum_{ n } \left( \frac{ R }{ r } \right)^{ n }
+ *                 \left[ ( a_{1,n}, a_{2,n}, a_{3,n} ) + a_{4,n} ( s, t, u ) \right] \\
+ *     a_{1,n} &=& \sum_{ m } m \bar{A}_{n,m} ( \bar{C}_{n,m} r_{m-1} + \bar{S}_{n,m} i_{m-1} ) \\
+ *     a_{2,n} &=& \sum_{ m } m \bar{A}_{n,m} ( \bar{S}_{n,m} r_{m-1} - \bar{C}_{n,m} i_{m-1} ) \\
+ *     a_{3,n} &=& \sum_{ m } \alpha_{n,m} \bar{A}_{n,m+1}
+ *                 ( \bar{C}_{n,m} r_{m} + \bar{S}_{n,m} i_{m} ) \\
+ *     a_{4,n} &=& -\sum_{ m } \beta_{n,m} \bar{A}_{n+1,m+1}
+ *                 ( \bar{C}_{n,m} r_{m} + \bar{S}_{n,m} i_{m} )
+ * \f}
+ * with \f$ \alpha_{n,m} \f$ and \f$ \beta_{n,m} \f$ the normalization factors given by
+ * PinesSphericalHarmonicsWorkspace::getOrderDerivativeFactor( ) and
+ * PinesSphericalHarmonicsWorkspace::getDegreeOrderDerivativeFactor( ), respectively.
+ * The coefficient matrices are defined in the same manner as for
+ * computeGeodesyNormalizedGravitationalAccelerationSum( ).
+ * \param positionOfBodySubjectToAcceleration Cartesian position vector with respect to the
+ *          reference frame that is associated with the harmonic coefficients [m].
+ * \param gravitationalParameter Gravitational parameter associated with the spherical harmonics
+ *          [m^3 s^-2].
+ * \param equatorialRadius Reference radius of the spherical harmonics [m].
+ * \param cosineHarmonicCoefficients Matrix with <B>geodesy-normalized</B> cosine harmonic
+ *          coefficients. The row index indicates the degree and the column index indicates the
+ *          order of coefficients.
+ * \param sineHarmonicCoefficients Matrix with <B>geodesy-normalized</B> sine harmonic
+ *          coefficients. The matrix must be equal in size to cosineHarmonicCoefficients.
+ * \param pinesWorkspace Workspace used to evaluate the spherical harmonics terms. Its maximum
+ *          degree and order must be at least equal to the highest degree and order of the
+ *          coefficient matrices.
+ * \param truncationDegree Degree up to which the expansion is summed; a negative value denotes
+ *          the highest degree of the coefficient matrices (default = -1).
+ * \return Cartesian acceleration vector resulting from the summation of all harmonic terms.
+ */
+Eigen::Vector3d computePinesGeodesyNormalizedGravitationalAccelerationSum(
+        const Eigen::Vector3d& positionOfBodySubjectToAcceleration,
+        const double gravitationalParameter,
+        const double equatorialRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        PinesSphericalHarmonicsWorkspace& pinesWorkspace,
+        const int truncationDegree = -1 );
+
+//! Compute gravity gradient tensor due to geodesy-normalized spherical harmonics expansion,
+//! using the Pines formulation.
+/*!
+ * Computes the gravity gradient tensor (i.e., the matrix of partial derivatives of the
+ * gravitational acceleration w.r.t. the Cartesian position) due to a spherical harmonics
+ * expansion with geodesy-normalized coefficients, using the Pines formulation. The derivatives
+ * are obtained by differentiating the terms \f$ a_{1,n} \f$ to \f$ a_{4,n} \f$ given in
+ * computePinesGeodesyNormalizedGravitationalAccelerationSum( ) w.r.t. s, t and u, which only
+ * requires derived Legendre functions of one order higher. This function also computes the
+ * acceleration, which is returned by reference.
+ * \param positionOfBodySubjectToAcceleration Cartesian position vector with respect to the
+ *          reference frame that is associated with the harmonic coefficients [m].
+ * \param gravitationalParameter Gravitational parameter associated with the spherical harmonics
+ *          [m^3 s^-2].
+ * \param equatorialRadius Reference radius of the spherical harmonics [m].
+ * \param cosineHarmonicCoefficients Matrix with <B>geodesy-normalized</B> cosine harmonic
+ *          coefficients.
+ * \param sineHarmonicCoefficients Matrix with <B>geodesy-normalized</B> sine harmonic coefficients.
+ * \param pinesWorkspace Workspace used to evaluate the spherical harmonics terms.
+ * \param acceleration Cartesian acceleration vector resulting from the summation of all harmonic
+ *          terms (returned by reference).
+ * \return Gravity gradient tensor [s^-2].
+ */
+Eigen::Matrix3d computePinesGeodesyNormalizedGravityGradientTensor(
+        const Eigen::Vector3d& positionOfBodySubjectToAcceleration,
+        const double gravitationalParameter,
+        const double equatorialRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        PinesSphericalHarmonicsWorkspace& pinesWorkspace,
+        Eigen::Vector3d& acceleration );
+
+} // namespace gravitation
+} // namespace tudat
+
+#endif // TUDAT_PINES_SPHERICAL_HARMONICS_GRAVITY_MODEL_H
@@ -0,0 +1,346 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Added check of consistent facet orientation.
+ *
+ *    References
+ *      Werner, R.A., Scheeres, D.J. Exterior gravitation of a polyhedron derived and compared with
+ *          harmonic and mascon gravitation representations of asteroid 4769 Castalia, Celestial
+ *          Mechanics and Dynamical Astronomy, 65, 313-344, 1997.
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <boost/exception/all.hpp>
+
+#include <Eigen/Geometry>
+
+#include "Tudat/Astrodynamics/Gravitation/polyhedronGravityField.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+
+//! Constructor.
+PolyhedronGravityField::PolyhedronGravityField( const double gravitationalParameter,
+                                                const Eigen::Matrix3Xd& vertices,
+                                                const Eigen::Matrix3Xi& facets,
+                                                const int numberOfThreads )
+    : GravityFieldModel( gravitationalParameter ),
+      vertices_( vertices ),
+      facets_( facets ),
+      numberOfThreads_( numberOfThreads )
+{
+    const int numberOfVertices = vertices_.cols( );
+    const int numberOfFacets = facets_.cols( );
+
+    if ( numberOfFacets < 4 || facets_.minCoeff( ) < 0
+         || facets_.maxCoeff( ) >= numberOfVertices )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, polyhedron requires at least four facets, with vertex "
+                            "indices in the range of the provided vertices." ) ) );
+    }
+
+    // Compute volume as sum of volumes of tetrahedra spanned by origin and each facet.
+    volume_ = 0.0;
+    for ( int i = 0; i < numberOfFacets; i++ )
+    {
+        volume_ += vertices_.col( facets_( 0, i ) ).dot(
+                    vertices_.col( facets_( 1, i ) ).cross( vertices_.col( facets_( 2, i ) ) ) );
+    }
+    volume_ /= 6.0;
+
+    // Reorient facets if they are defined clockwise, as seen from outside the body.
+    if ( volume_ < 0.0 )
+    {
+        facets_.row( 1 ).swap( facets_.row( 2 ) );
+        volume_ = -volume_;
+    }
+
+    if ( !( volume_ > 0.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error, volume of polyhedron is zero." ) ) );
+    }
+
+    gravitationalConstantTimesDensity_ = gravitationalParameter_ / volume_;
+
+    // Compute outward facet normals.
+    facetNormals_.resize( 3, numberOfFacets );
+    for ( int i = 0; i < numberOfFacets; i++ )
+    {
+        const Eigen::Vector3d firstVertex = vertices_.col( facets_( 0, i ) );
+        facetNormals_.col( i ) = ( vertices_.col( facets_( 1, i ) ) - firstVertex ).cross(
+                    vertices_.col( facets_( 2, i ) ) - firstVertex ).normalized( );
+    }
+
+    // Determine unique edges, and sum contributions of adjacent facets to edge dyads.
+    std::map< std::pair< int, int >, int > edgeIndices;
+    std::vector< Eigen::Matrix3d > edgeDyads;
+    std::vector< int > numberOfAdjacentFacets;
+    std::vector< int > numberOfForwardTraversals;
+    std::vector< std::pair< int, int > > edgeVertices;
+
+    for ( int i = 0; i < numberOfFacets; i++ )
+    {
+        for ( int j = 0; j < 3; j++ )
+        {
+            const int startVertex = facets_( j, i );
+            const int endVertex = facets_( ( j + 1 ) % 3, i );
+            const std::pair< int, int > edgeKey( std::min( startVertex, endVertex ),
+                                                 std::max( startVertex, endVertex ) );
+
+            std::map< std::pair< int, int >, int >::iterator edgeIterator
+                    = edgeIndices.find( edgeKey );
+            int edgeIndex;
+            if ( edgeIterator == edgeIndices.end( ) )
+            {
+                edgeIndex = edgeVertices.size( );
+                edgeIndices[ edgeKey ] = edgeIndex;
+                edgeVertices.push_back( edgeKey );
+                edgeDyads.push_back( Eigen::Matrix3d::Zero( ) );
+                numberOfAdjacentFacets.push_back( 0 );
+                numberOfForwardTraversals.push_back( 0 );
+            }
+            else
+            {
+                edgeIndex = edgeIterator->second;
+            }
+
+            // Compute outward normal of edge, in plane of facet.
+            const Eigen::Vector3d edgeNormal = ( vertices_.col( endVertex )
+                                                 - vertices_.col( startVertex ) ).cross(
+                        facetNormals_.col( i ) ).normalized( );
+
+            edgeDyads[ edgeIndex ] += facetNormals_.col( i ) * edgeNormal.transpose( );
+            numberOfAdjacentFacets[ edgeIndex ]++;
+            if ( startVertex < endVertex )
+            {
+                numberOfForwardTraversals[ edgeIndex ]++;
+            }
+        }
+    }
+
+    // Store edge quantities as structure-of-arrays.
+    const int numberOfEdges = edgeVertices.size( );
+    edges_.resize( 2, numberOfEdges );
+    edgeDyads_.resize( 9, numberOfEdges );
+    edgeLengths_.resize( numberOfEdges );
+    for ( int i = 0; i < numberOfEdges; i++ )
+    {
+        if ( numberOfAdjacentFacets[ i ] != 2 )
+        {
+            std::stringstream errorMessage;
+            errorMessage << "Error, polyhedron is not closed: edge between vertices "
+                         << edgeVertices[ i ].first << " and " << edgeVertices[ i ].second
+                         << " is shared by " << numberOfAdjacentFacets[ i ]
+                         << " facet(s), instead of 2." << std::endl;
+            boost::throw_exception( boost::enable_error_info( std::runtime_error(
+                                                                  errorMessage.str( ) ) ) );
+        }
+
+        // Check that adjacent facets traverse edge in opposite directions, i.e., that all facets
+        // are oriented consistently.
+        if ( numberOfForwardTraversals[ i ] != 1 )
+        {
+            std::stringstream errorMessage;
+            errorMessage << "Error, facets of polyhedron are not oriented consistently: edge "
+                         << "between vertices " << edgeVertices[ i ].first << " and "
+                         << edgeVertices[ i ].second << " is traversed in the same direction "
+                         << "by both adjacent facets." << std::endl;
+            boost::throw_exception( boost::enable_error_info( std::runtime_error(
+                                                                  errorMessage.str( ) ) ) );
+        }
+
+        edges_( 0, i ) = edgeVertices[ i ].first;
+        edges_( 1, i ) = edgeVertices[ i ].second;
+        edgeDyads_.col( i ) = Eigen::Map< const Eigen::Matrix< double, 9, 1 > >(
+                    edgeDyads[ i ].data( ) );
+        edgeLengths_( i ) = ( vertices_.col( edges_( 1, i ) )
+                              - vertices_.col( edges_( 0, i ) ) ).norm( );
+    }
+
+    relativeVertexPositions_.resize( 3, numberOfVertices );
+    vertexDistances_.resize( numberOfVertices );
+}
+
+//! Get the gravitational potential at given body-fixed position.
+double PolyhedronGravityField::getGravitationalPotential(
+        const Eigen::Vector3d& bodyFixedPosition )
+{
+    double potential, laplacianOfPotential;
+    Eigen::Vector3d gradientOfPotential;
+    computeGravityFieldTerms( bodyFixedPosition, potential, gradientOfPotential,
+                              laplacianOfPotential );
+    return potential;
+}
+
+//! Get the gradient of the potential.
+Eigen::Vector3d PolyhedronGravityField::getGradientOfPotential(
+        const Eigen::Vector3d& bodyFixedPosition )
+{
+    double potential, laplacianOfPotential;
+    Eigen::Vector3d gradientOfPotential;
+    computeGravityFieldTerms( bodyFixedPosition, potential, gradientOfPotential,
+                              laplacianOfPotential );
+    return gradientOfPotential;
+}
+
+//! Get the Laplacian of the potential.
+double PolyhedronGravityField::getLaplacianOfPotential( const Eigen::Vector3d& bodyFixedPosition )
+{
+    double potential, laplacianOfPotential;
+    Eigen::Vector3d gradientOfPotential;
+    computeGravityFieldTerms( bodyFixedPosition, potential, gradientOfPotential,
+                              laplacianOfPotential );
+    return laplacianOfPotential;
+}
+
+//! Compute the potential, its gradient and its Laplacian.
+void PolyhedronGravityField::computeGravityFieldTerms( const Eigen::Vector3d& bodyFixedPosition,
+                                                       double& potential,
+                                                       Eigen::Vector3d& gradientOfPotential,
+                                                       double& laplacianOfPotential )
+{
+    // Compute vertex positions relative to field point once, as they are shared by the facet
+    // and edge sums.
+    relativeVertexPositions_ = vertices_.colwise( ) - bodyFixedPosition;
+    vertexDistances_ = relativeVertexPositions_.colwise( ).norm( ).transpose( );
+
+    const int numberOfFacets = facets_.cols( );
+    const int numberOfEdges = edges_.cols( );
+
+    // Divide facets and edges over threads, and compute first ranges on calling thread.
+    const int numberOfUsedThreads = std::max( 1, std::min( numberOfThreads_, numberOfFacets ) );
+    const int facetsPerThread = ( numberOfFacets + numberOfUsedThreads - 1 )
+            / numberOfUsedThreads;
+    const int edgesPerThread = ( numberOfEdges + numberOfUsedThreads - 1 ) / numberOfUsedThreads;
+
+    std::vector< Eigen::Matrix< double, 5, 1 > > partialSums( numberOfUsedThreads );
+    std::vector< std::thread > threads;
+    for ( int thread = 1; thread < numberOfUsedThreads; thread++ )
+    {
+        threads.push_back( std::thread(
+                               &PolyhedronGravityField::computePartialSums, this,
+                               std::min( thread * facetsPerThread, numberOfFacets ),
+                               std::min( ( thread + 1 ) * facetsPerThread, numberOfFacets ),
+                               std::min( thread * edgesPerThread, numberOfEdges ),
+                               std::min( ( thread + 1 ) * edgesPerThread, numberOfEdges ),
+                               std::ref( partialSums[ thread ] ) ) );
+    }
+
+    computePartialSums( 0, std::min( facetsPerThread, numberOfFacets ),
+                        0, std::min( edgesPerThread, numberOfEdges ), partialSums[ 0 ] );
+
+    for ( unsigned int i = 0; i < threads.size( ); i++ )
+    {
+        threads[ i ].join( );
+    }
+
+    // Reduce partial sums in fixed order, so that the result does not depend on thread timing.
+    Eigen::Matrix< double, 5, 1 > totalSums = partialSums[ 0 ];
+    for ( int thread = 1; thread < numberOfUsedThreads; thread++ )
+    {
+        totalSums += partialSums[ thread ];
+    }
+
+    potential = 0.5 * gravitationalConstantTimesDensity_ * totalSums( 0 );
+    gradientOfPotential = gravitationalConstantTimesDensity_ * totalSums.segment( 1, 3 );
+    laplacianOfPotential = -gravitationalConstantTimesDensity_ * totalSums( 4 );
+}
+
+//! Compute partial sums over range of facets and edges.
+void PolyhedronGravityField::computePartialSums( const int firstFacet, const int endFacet,
+                                                 const int firstEdge, const int endEdge,
+                                                 Eigen::Matrix< double, 5, 1 >& partialSums )
+{
+    double potentialSum = 0.0;
+    Eigen::Vector3d gradientSum = Eigen::Vector3d::Zero( );
+    double solidAngleSum = 0.0;
+
+    // Add facet contributions, using the solid angle expression of Werner & Scheeres (1997).
+    for ( int i = firstFacet; i < endFacet; i++ )
+    {
+        const Eigen::Vector3d firstVertex = relativeVertexPositions_.col( facets_( 0, i ) );
+        const Eigen::Vector3d secondVertex = relativeVertexPositions_.col( facets_( 1, i ) );
+        const Eigen::Vector3d thirdVertex = relativeVertexPositions_.col( facets_( 2, i ) );
+        const double firstDistance = vertexDistances_( facets_( 0, i ) );
+        const double secondDistance = vertexDistances_( facets_( 1, i ) );
+        const double thirdDistance = vertexDistances_( facets_( 2, i ) );
+
+        const double solidAngle = 2.0 * std::atan2(
+                    firstVertex.dot( secondVertex.cross( thirdVertex ) ),
+                    firstDistance * secondDistance * thirdDistance
+                    + firstDistance * secondVertex.dot( thirdVertex )
+                    + secondDistance * thirdVertex.dot( firstVertex )
+                    + thirdDistance * firstVertex.dot( secondVertex ) );
+
+        const double normalDistance = facetNormals_.col( i ).dot( firstVertex );
+        potentialSum -= normalDistance * normalDistance * solidAngle;
+        gradientSum += normalDistance * solidAngle * facetNormals_.col( i );
+        solidAngleSum += solidAngle;
+    }
+
+    // Add edge contributions.
+    for ( int i = firstEdge; i < endEdge; i++ )
+    {
+        const Eigen::Vector3d startVertex = relativeVertexPositions_.col( edges_( 0, i ) );
+        const double distanceSum = vertexDistances_( edges_( 0, i ) )
+                + vertexDistances_( edges_( 1, i ) );
+        const double wirePotential = std::log( ( distanceSum + edgeLengths_( i ) )
+                                               / ( distanceSum - edgeLengths_( i ) ) );
+
+        const Eigen::Vector3d dyadTimesVertex
+                = Eigen::Map< const Eigen::Matrix3d >( edgeDyads_.col( i ).data( ) )
+                * startVertex;
+        potentialSum += startVertex.dot( dyadTimesVertex ) * wirePotential;
+        gradientSum -= wirePotential * dyadTimesVertex;
+    }
+
+    partialSums( 0 ) = potentialSum;
+    partialSums.segment( 1, 3 ) = gradientSum;
+    partialSums( 4 ) = solidAngleSum;
+}
+
+} // namespace gravitation
+} // namespace tudat
@@ -0,0 +1,237 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Facet orientation is checked for consistency.
+ *
+ *    References
+ *      Werner, R.A., Scheeres, D.J. Exterior gravitation of a polyhedron derived and compared with
+ *          harmonic and mascon gravitation representations of asteroid 4769 Castalia, Celestial
+ *          Mechanics and Dynamical Astronomy, 65, 313-344, 1997.
+ *
+ *    Notes
+ *      The polyhedron is assumed to be closed and of constant density. Its facets must be
+ *      triangles, and must be oriented consistently, i.e., each edge must be traversed once in
+ *      each direction by its two adjacent facets; the facets are reoriented automatically if all
+ *      of them are defined clockwise (as seen from outside the body). The potential, its gradient and its Laplacian are valid
+ *      both outside and inside the body, but are singular on its edges and vertices.
+ *
+ */
+
+#ifndef TUDAT_POLYHEDRON_GRAVITY_FIELD_H
+#define TUDAT_POLYHEDRON_GRAVITY_FIELD_H
+
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/Gravitation/gravityFieldModel.h"
+
+namespace tudat
+{
+namespace gravitation
+{
+
+//! Polyhedron gravity field class.
+/*!
+ * Class to represent the gravity field of a homogeneous polyhedron, e.g., the shape model of an
+ * asteroid or comet nucleus, using the formulation of Werner & Scheeres (1997):
+ * \f{eqnarray*}{
+ *     U &=& \frac{ 1 }{ 2 } G \rho \sum_{ e } \bar{r}_{e} \cdot E_{e} \cdot \bar{r}_{e} L_{e}
+ *          - \frac{ 1 }{ 2 } G \rho \sum_{ f } \bar{r}_{f} \cdot F_{f} \cdot \bar{r}_{f}
+ *            \omega_{f} \\
+ *     \nabla U &=& -G \rho \sum_{ e } E_{e} \cdot \bar{r}_{e} L_{e}
+ *          + G \rho \sum_{ f } F_{f} \cdot \bar{r}_{f} \omega_{f} \\
+ *     \nabla^{2} U &=& -G \rho \sum_{ f } \omega_{f}
+ * \f}
+ * in which \f$ \bar{r}_{e} \f$ and \f$ \bar{r}_{f} \f$ are vectors from the field point to a
+ * vertex of edge e and facet f, \f$ L_{e} \f$ is the potential of a unit-density wire along edge
+ * e, and \f$ \omega_{f} \f$ is the signed solid angle of facet f, as seen from the field point.
+ * The facet dyads \f$ F_{f} = \hat{n}_{f} \hat{n}_{f}^{T} \f$ are stored through the outward
+ * facet normals, and the edge dyads
+ * \f$ E_{e} = \hat{n}_{A} \hat{n}^{A}_{12}{}^{T} + \hat{n}_{B} \hat{n}^{B}_{21}{}^{T} \f$ (with
+ * \f$ \hat{n}^{A}_{12} \f$ the outward normal of the edge in the plane of adjacent facet A) are
+ * precomputed when the object is created. All per-facet and per-edge quantities are stored as
+ * structure-of-arrays, and the sums over facets and edges are divided over the requested number of
+ * threads. The density is derived from the gravitational parameter and the volume of the
+ * polyhedron.
+ */
+class PolyhedronGravityField: public GravityFieldModel
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, precomputes the facet normals, edges, edge dyads and volume of the polyhedron.
+     * \param gravitationalParameter Gravitational parameter of body [m^3 s^-2].
+     * \param vertices Positions of vertices in body-fixed frame, each column containing a single
+     *          vertex [m].
+     * \param facets Zero-based vertex indices of triangular facets, each column containing a
+     *          single facet, ordered counter-clockwise as seen from outside the body.
+     * \param numberOfThreads Number of threads over which the facet and edge sums are divided
+     *          (default = 1).
+     */
+    PolyhedronGravityField( const double gravitationalParameter,
+                            const Eigen::Matrix3Xd& vertices,
+                            const Eigen::Matrix3Xi& facets,
+                            const int numberOfThreads = 1 );
+
+    //! Virtual destructor.
+    /*!
+     *  Virtual destructor.
+     */
+    virtual ~PolyhedronGravityField( ) { }
+
+    //! Get the gravitational potential at given body-fixed position.
+    /*!
+     * Returns the gravitational potential of the polyhedron at given body-fixed position.
+     * \param bodyFixedPosition Position at which the gravitational potential is to be evaluated.
+     * \return Gravitational potential.
+     */
+    double getGravitationalPotential( const Eigen::Vector3d& bodyFixedPosition );
+
+    //! Get the gradient of the potential.
+    /*!
+     * Returns the gradient of the potential (i.e., the gravitational acceleration in the
+     * body-fixed frame) of the polyhedron at given body-fixed position.
+     * \param bodyFixedPosition Position at which gradient of potential is to be determined.
+     * \return Gradient of potential.
+     */
+    Eigen::Vector3d getGradientOfPotential( const Eigen::Vector3d& bodyFixedPosition );
+
+    //! Get the Laplacian of the potential.
+    /*!
+     * Returns the Laplacian of the potential of the polyhedron at given body-fixed position,
+     * which is zero outside the body, and equal to \f$ -4 \pi G \rho \f$ inside the body. It may
+     * therefore be used to determine whether a position is inside the body.
+     * \param bodyFixedPosition Position at which Laplacian of potential is to be determined.
+     * \return Laplacian of potential.
+     */
+    double getLaplacianOfPotential( const Eigen::Vector3d& bodyFixedPosition );
+
+    //! Compute the potential, its gradient and its Laplacian.
+    /*!
+     * Computes the potential, its gradient and its Laplacian in a single pass over the facets
+     * and edges of the polyhedron.
+     * \param bodyFixedPosition Position at which terms are to be determined.
+     * \param potential Gravitational potential (returned by reference).
+     * \param gradientOfPotential Gradient of potential (returned by reference).
+     * \param laplacianOfPotential Laplacian of potential (returned by reference).
+     */
+    void computeGravityFieldTerms( const Eigen::Vector3d& bodyFixedPosition,
+                                   double& potential,
+                                   Eigen::Vector3d& gradientOfPotential,
+                                   double& laplacianOfPotential );
+
+    //! Get volume of polyhedron.
+    /*!
+     * Returns the volume of the polyhedron.
+     * \return Volume of polyhedron [m^3].
+     */
+    double getVolume( ) { return volume_; }
+
+    //! Get number of vertices.
+    /*!
+     * Returns the number of vertices of the polyhedron.
+     * \return Number of vertices.
+     */
+    int getNumberOfVertices( ) { return vertices_.cols( ); }
+
+    //! Get number of facets.
+    /*!
+     * Returns the number of facets of the polyhedron.
+     * \return Number of facets.
+     */
+    int getNumberOfFacets( ) { return facets_.cols( ); }
+
+    //! Get number of edges.
+    /*!
+     * Returns the number of edges of the polyhedron.
+     * \return Number of edges.
+     */
+    int getNumberOfEdges( ) { return edges_.cols( ); }
+
+protected:
+
+private:
+
+    //! Compute partial sums over range of facets and edges.
+    /*!
+     * Computes the facet and edge sums of the potential, its gradient and the solid angle over
+     * the given ranges of facets and edges, using the relative vertex positions of the current
+     * evaluation.
+     * \param firstFacet Index of first facet of range.
+     * \param endFacet Index after last facet of range.
+     * \param firstEdge Index of first edge of range.
+     * \param endEdge Index after last edge of range.
+     * \param partialSums Partial sums of potential, three gradient components and solid angle,
+     *          without the factor G rho (returned by reference).
+     */
+    void computePartialSums( const int firstFacet, const int endFacet,
+                             const int firstEdge, const int endEdge,
+                             Eigen::Matrix< double, 5, 1 >& partialSums );
+
+    //! Positions of vertices in body-fixed frame [m].
+    Eigen::Matrix3Xd vertices_;
+
+    //! Vertex indices of facets.
+    Eigen::Matrix3Xi facets_;
+
+    //! Outward unit normals of facets.
+    Eigen::Matrix3Xd facetNormals_;
+
+    //! Vertex indices of edges.
+    Eigen::Matrix2Xi edges_;
+
+    //! Edge dyads, each column containing a single (column-major) 3x3 dyad.
+    Eigen::Matrix< double, 9, Eigen::Dynamic > edgeDyads_;
+
+    //! Lengths of edges [m].
+    Eigen::VectorXd edgeLengths_;
+
+    //! Volume of polyhedron [m^3].
+    double volume_;
+
+    //! Product of gravitational constant and density [s^-2].
+    double gravitationalConstantTimesDensity_;
+
+    //! Number of threads over which the facet and edge sums are divided.
+    int numberOfThreads_;
+
+    //! Positions of vertices relative to current field point.
+    Eigen::Matrix3Xd relativeVertexPositions_;
+
+    //! Distances of vertices to current field point.
+    Eigen::VectorXd vertexDistances_;
+};
+
+//! Typedef for shared-pointer to PolyhedronGravityField object.
+typedef boost::shared_ptr< PolyhedronGravityField > PolyhedronGravityFieldPointer;
+
+} // namespace gravitation
+} // namespace tudat
+
+#endif // TUDAT_POLYHEDRON_GRAVITY_FIELD_H
@@ -39,6 +39,9 @@
  *                                  predefined Earth gravity fields.
  *      120326    D. Dirkx          Changed raw pointers to shared pointers.
  *      141020    D. Dirkx          Change of architecture.
+ *      261018                      Evaluate potential using single-pass spherical harmonics
+ *                                  workspace.
+ *      261018                      Reuse thread-local spherical harmonics workspace.
  *
  *    References
  *      Vallado, D. A., Crawford, P., Hujsak, R., & Kelso, T. Revisiting Spacetrack Report #3:
@@ -49,8 +52,10 @@
  *
  */
 
+#include <algorithm>
+
 #include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityField.h"
-#include "Tudat/Mathematics/BasicMathematics/coordinateConversions.h"
+#include "Tudat/Mathematics/BasicMathematics/sphericalHarmonics.h"
 
 namespace tudat
 {
@@ -65,19 +70,14 @@ double calculateSphericalHarmonicGravitationalPotential(
         const Eigen::MatrixXd& sineCoefficients, const int minimumumDegree,
         const int minimumumOrder )
 {
-    // Initialize (distance/reference radius)^n (n=ratioToPowerDegree)
-    double ratioToPowerDegree = 1.0;
-    double radiusRatio = referenceRadius / bodyFixedPosition.norm( );
-
-    // Declare local variables used in calculation
-    double legendrePolynomial = 0.0;
-    double singleDegreeTerm = 0.0;
-
-    // Determine body fixed spherical position of body udnergoing acceleration.
-    Eigen::Vector3d sphericalPositon =
-            coordinate_conversions::convertCartesianToSpherical( bodyFixedPosition );
-    double latitude = mathematical_constants::PI / 2.0 - sphericalPositon.y( );
-    double longitude = sphericalPositon.z( );
+    // Compute Legendre polynomials, trigonometric terms and radius ratio powers in single pass,
+    // using the workspace of the current thread.
+    const int maximumDegree = std::max( static_cast< int >( cosineCoefficients.rows( ) ) - 1, 0 );
+    const int maximumOrder = std::max( static_cast< int >( cosineCoefficients.cols( ) ) - 1, 0 );
+    basic_mathematics::SphericalHarmonicsWorkspace& sphericalHarmonicsWorkspace
+            = basic_mathematics::getSphericalHarmonicsWorkspace( maximumDegree, maximumOrder );
+    sphericalHarmonicsWorkspace.update( bodyFixedPosition, referenceRadius, maximumDegree,
+                                        std::min( maximumOrder, maximumDegree ) );
 
     double potential = 0.0;
     int startDegree = 0;
@@ -91,36 +91,31 @@ double calculateSphericalHarmonicGravitationalPotential(
     else
     {
         startDegree = minimumumDegree;
-        ratioToPowerDegree *= std::pow( radiusRatio, startDegree - 1 );
     }
 
     // Iterate over all degrees
     for( int degree = startDegree; degree < cosineCoefficients.rows( ); degree++ )
     {
-        singleDegreeTerm = 0.0;
+        double singleDegreeTerm = 0.0;
 
         // Iterate over all orders in current degree for which coefficients are provided.
         for( int order = minimumumOrder; ( order < cosineCoefficients.cols( ) &&
                                            order <= degree ); order++ )
         {
-            // Calculate legendre polynomial (geodesy-normalized) at current degree and order
-            legendrePolynomial = basic_mathematics::computeGeodesyLegendrePolynomial(
-                        degree, order, std::sin( latitude ) );
-
             // Calculate contribution to potential from current degree and order
-            singleDegreeTerm += legendrePolynomial * ( cosineCoefficients( degree, order ) *
-                                                       std::cos( order * longitude ) +
-                                                       sineCoefficients( degree, order ) *
-                                                       std::sin( order * longitude ) );
+            singleDegreeTerm += sphericalHarmonicsWorkspace.getLegendrePolynomial( degree, order )
+                    * ( cosineCoefficients( degree, order )
+                        * sphericalHarmonicsWorkspace.getCosineOfMultipleLongitude( order )
+                        + sineCoefficients( degree, order )
+                        * sphericalHarmonicsWorkspace.getSineOfMultipleLongitude( order ) );
         }
 
         // Add potential contributions from current degree to toal value.
-        ratioToPowerDegree *= radiusRatio;
-        potential += singleDegreeTerm * ratioToPowerDegree;
+        potential += singleDegreeTerm * sphericalHarmonicsWorkspace.getRadiusRatioPower( degree );
     }
 
     // Multiply by central term and return
-    return potential * gravitationalParameter / bodyFixedPosition.norm( );
+    return potential * gravitationalParameter / sphericalHarmonicsWorkspace.getRadius( );
 }
 }
 }
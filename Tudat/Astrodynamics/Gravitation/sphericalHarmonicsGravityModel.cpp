@@ -25,6 +25,12 @@
  *    Changelog
  *      YYMMDD    Author            Comment
  *      121017    E. Dekens         Code created.
+ *      261018                      Replaced recursive Legendre polynomial evaluation in
+ *                                  acceleration sum by single-pass workspace evaluation.
+ *      261018                      Added truncation degree to acceleration sum, and functions for
+ *                                  adaptive truncation.
+ *      261018                      Made acceleration sum regular on polar axis, and reuse
+ *                                  thread-local workspace in overload without workspace.
  *
  *    References
  *
@@ -32,6 +38,7 @@
  *
  */
 
+#include <algorithm>
 #include <cmath>
 #include <limits>
 #include <stdexcept>
@@ -66,24 +73,42 @@ Eigen::Vector3d computeGeodesyNormalizedGravitationalAccelerationSum(
         const Eigen::MatrixXd& cosineHarmonicCoefficients,
         const Eigen::MatrixXd& sineHarmonicCoefficients )
 {
-    // Set highest degree and order.
-    const int highestDegree = cosineHarmonicCoefficients.rows( );
-    const int highestOrder = cosineHarmonicCoefficients.cols( );
-
-    // Declare spherical position vector.
-    Eigen::Vector3d sphericalpositionOfBodySubjectToAcceleration = Eigen::Vector3d::Zero( );
-
-    // Convert Cartesian coordinates to cylindrical.
-    const Eigen::Vector3d cylindricalCoordinates = coordinate_conversions::
-            convertCartesianToCylindrical( positionOfBodySubjectToAcceleration );
+    // Use workspace of current thread, so that normalization factors are not recomputed.
+    return computeGeodesyNormalizedGravitationalAccelerationSum(
+                positionOfBodySubjectToAcceleration, gravitationalParameter, equatorialRadius,
+                cosineHarmonicCoefficients, sineHarmonicCoefficients,
+                basic_mathematics::getSphericalHarmonicsWorkspace(
+                    std::max( static_cast< int >( cosineHarmonicCoefficients.rows( ) ) - 1, 0 ),
+                    std::max( static_cast< int >( cosineHarmonicCoefficients.cols( ) ) - 1,
+                              0 ) ) );
+}
 
-    // Compute radius coordinate.
-    sphericalpositionOfBodySubjectToAcceleration( 0 )
-            = std::sqrt( cylindricalCoordinates( 0 ) * cylindricalCoordinates( 0 )
-                       + cylindricalCoordinates( 2 ) * cylindricalCoordinates( 2 ) );
+//! Compute gravitational acceleration due to multiple spherical harmonics terms, defined using
+//! geodesy-normalization, using existing workspace.
+Eigen::Vector3d computeGeodesyNormalizedGravitationalAccelerationSum(
+        const Eigen::Vector3d& positionOfBodySubjectToAcceleration,
+        const double gravitationalParameter,
+        const double equatorialRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        basic_mathematics::SphericalHarmonicsWorkspace& sphericalHarmonicsWorkspace,
+        const int truncationDegree )
+{
+    // Check if workspace is sufficiently large.
+    if ( sphericalHarmonicsWorkspace.getMaximumDegree( ) < cosineHarmonicCoefficients.rows( ) - 1
+         || sphericalHarmonicsWorkspace.getMaximumOrder( )
+         < cosineHarmonicCoefficients.cols( ) - 1 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, spherical harmonics workspace is too small for coefficient "
+                            "matrices." ) ) );
+    }
 
     // If radius coordinate is smaller than planetary radius...
-    if ( sphericalpositionOfBodySubjectToAcceleration( 0 ) < equatorialRadius )
+    const double radius = positionOfBodySubjectToAcceleration.norm( );
+    if ( radius < equatorialRadius )
     {
         // ...throw runtime error.
         boost::throw_exception(
@@ -92,71 +117,79 @@ Eigen::Vector3d computeGeodesyNormalizedGravitationalAccelerationSum(
                             "Distance to origin is smaller than the size of the main body." ) ) );
     }
 
-    // If radius coordinate is zero...
-    if ( std::fabs( cylindricalCoordinates( 0 ) ) < std::numeric_limits< double >::epsilon( ) )
-    {
-        // ...set latitude coordinate to 90 degrees.
-        sphericalpositionOfBodySubjectToAcceleration( 1 )
-                = mathematical_constants::PI / 2.0;
-    }
-
-    // Else...
-    else
-    {
-        // ...compute latitude coordinate.
-        sphericalpositionOfBodySubjectToAcceleration( 1 )
-                = std::atan( cylindricalCoordinates( 2 ) / cylindricalCoordinates( 0 ) );
-    }
-
-    // Compute longitude coordinate.
-    sphericalpositionOfBodySubjectToAcceleration( 2 ) = cylindricalCoordinates( 1 );
-
-    // Compute gradient premultiplier.
-    const double preMultiplier = gravitationalParameter / equatorialRadius;
-
-    // Initialize gradient vector.
-    Eigen::Vector3d sphericalGradient = Eigen::Vector3d::Zero( );
-
-    // Loop through all degrees.
+    // Set highest degree and order (exclusive) that are summed.
+    const int highestDegree = ( truncationDegree < 0 )
+            ? static_cast< int >( cosineHarmonicCoefficients.rows( ) )
+            : std::min( static_cast< int >( cosineHarmonicCoefficients.rows( ) ),
+                        truncationDegree + 1 );
+    const int highestOrder = std::min( static_cast< int >( cosineHarmonicCoefficients.cols( ) ),
+                                       highestDegree );
+
+    // Compute Legendre polynomials, trigonometric terms and radius ratio powers in single pass,
+    // up to the highest degree and order that are summed.
+    sphericalHarmonicsWorkspace.update( positionOfBodySubjectToAcceleration, equatorialRadius,
+                                        highestDegree - 1, highestOrder - 1 );
+
+    // Sum derivatives of potential w.r.t. radius, latitude (divided by r) and longitude (divided
+    // by r cos(latitude)), each without the common factor mu / r^2. The latter uses the ratio of
+    // the Legendre polynomials and cos(latitude), which is regular on the polar axis.
+    double radialSum = 0.0;
+    double latitudinalSum = 0.0;
+    double longitudinalSum = 0.0;
     for ( int degree = 0; degree < highestDegree; degree++ )
     {
-        // Loop through all orders.
+        double degreeRadialSum = 0.0;
+        double degreeLatitudinalSum = 0.0;
+        double degreeLongitudinalSum = 0.0;
         for ( int order = 0; order <= degree && order < highestOrder; order++ )
         {
-            // Compute geodesy-normalized Legendre polynomials.
-            const double legendrePolynomial = basic_mathematics::computeGeodesyLegendrePolynomial(
-                        degree, order,
-                        std::sin( sphericalpositionOfBodySubjectToAcceleration( 1 ) ) );
-            const double incrementedLegendrePolynomial =
-                    basic_mathematics::computeGeodesyLegendrePolynomial(
-                        degree, order + 1,
-                        std::sin( sphericalpositionOfBodySubjectToAcceleration( 1 ) ) );
-
-            // Compute geodesy-normalized Legendre polynomial derivative.
-            const double legendrePolynomialDerivative =
-                    basic_mathematics::computeGeodesyLegendrePolynomialDerivative(
-                        degree, order,
-                        std::sin( sphericalpositionOfBodySubjectToAcceleration( 1 ) ),
-                        legendrePolynomial, incrementedLegendrePolynomial );
-
-            // Compute the potential gradient of a single spherical harmonic term.
-            sphericalGradient += basic_mathematics::computePotentialGradient(
-                        sphericalpositionOfBodySubjectToAcceleration,
-                        equatorialRadius,
-                        preMultiplier,
-                        degree,
-                        order,
-                        cosineHarmonicCoefficients( degree, order ),
-                        sineHarmonicCoefficients( degree, order ),
-                        legendrePolynomial,
-                        legendrePolynomialDerivative );
+            const double cosineTerm = sphericalHarmonicsWorkspace.getCosineOfMultipleLongitude(
+                        order );
+            const double sineTerm = sphericalHarmonicsWorkspace.getSineOfMultipleLongitude(
+                        order );
+            const double cosineCoefficient = cosineHarmonicCoefficients( degree, order );
+            const double sineCoefficient = sineHarmonicCoefficients( degree, order );
+            const double coefficientTerm = cosineCoefficient * cosineTerm
+                    + sineCoefficient * sineTerm;
+
+            degreeRadialSum += sphericalHarmonicsWorkspace.getLegendrePolynomial( degree, order )
+                    * coefficientTerm;
+            degreeLatitudinalSum += sphericalHarmonicsWorkspace.getLegendrePolynomialDerivative(
+                        degree, order ) * coefficientTerm;
+            if ( order > 0 )
+            {
+                degreeLongitudinalSum += static_cast< double >( order )
+                        * sphericalHarmonicsWorkspace.getLegendrePolynomialOverCosineOfLatitude(
+                            degree, order )
+                        * ( sineCoefficient * cosineTerm - cosineCoefficient * sineTerm );
+            }
         }
+
+        const double radiusRatioPower = sphericalHarmonicsWorkspace.getRadiusRatioPower( degree );
+        radialSum -= static_cast< double >( degree + 1 ) * radiusRatioPower * degreeRadialSum;
+        latitudinalSum += radiusRatioPower * degreeLatitudinalSum;
+        longitudinalSum += radiusRatioPower * degreeLongitudinalSum;
     }
 
-    // Convert from spherical gradient to Cartesian gradient (which equals acceleration vector) and
-    // return the resulting acceleration vector.
-    return coordinate_conversions::convertSphericalToCartesianGradient(
-                sphericalGradient, positionOfBodySubjectToAcceleration );
+    // Convert from spherical gradient to Cartesian gradient (which equals acceleration vector),
+    // using unit vectors in radial, latitudinal and longitudinal directions.
+    const double sineOfLatitude = sphericalHarmonicsWorkspace.getSineOfLatitude( );
+    const double cosineOfLatitude = sphericalHarmonicsWorkspace.getCosineOfLatitude( );
+    const double sineOfLongitude = sphericalHarmonicsWorkspace.getSineOfLongitude( );
+    const double cosineOfLongitude = sphericalHarmonicsWorkspace.getCosineOfLongitude( );
+
+    const Eigen::Vector3d radialUnitVector( cosineOfLatitude * cosineOfLongitude,
+                                            cosineOfLatitude * sineOfLongitude,
+                                            sineOfLatitude );
+    const Eigen::Vector3d latitudinalUnitVector( -sineOfLatitude * cosineOfLongitude,
+                                                 -sineOfLatitude * sineOfLongitude,
+                                                 cosineOfLatitude );
+    const Eigen::Vector3d longitudinalUnitVector( -sineOfLongitude, cosineOfLongitude, 0.0 );
+
+    const double preMultiplier = gravitationalParameter / ( radius * radius );
+    return preMultiplier * ( radialSum * radialUnitVector
+                             + latitudinalSum * latitudinalUnitVector
+                             + longitudinalSum * longitudinalUnitVector );
 }
 
 //! Compute gravitational acceleration due to single spherical harmonics term.
@@ -246,5 +279,53 @@ Eigen::Vector3d computeSingleGeodesyNormalizedGravitationalAcceleration(
                 sphericalGradient, positionOfBodySubjectToAcceleration );
 }
 
+//! Compute per-degree RMS power of geodesy-normalized coefficients.
+Eigen::VectorXd computeDegreeCoefficientNorms( const Eigen::MatrixXd& cosineHarmonicCoefficients,
+                                               const Eigen::MatrixXd& sineHarmonicCoefficients )
+{
+    const int numberOfDegrees = cosineHarmonicCoefficients.rows( );
+    const int numberOfOrders = cosineHarmonicCoefficients.cols( );
+
+    Eigen::VectorXd degreeCoefficientNorms = Eigen::VectorXd::Zero( numberOfDegrees );
+    for ( int degree = 0; degree < numberOfDegrees; degree++ )
+    {
+        const int highestOrder = std::min( degree + 1, numberOfOrders );
+        degreeCoefficientNorms( degree ) = std::sqrt(
+                    cosineHarmonicCoefficients.row( degree ).head( highestOrder ).squaredNorm( )
+                    + sineHarmonicCoefficients.row( degree ).head( highestOrder ).squaredNorm( ) );
+    }
+
+    return degreeCoefficientNorms;
+}
+
+//! Compute altitude-adaptive truncation degree of spherical harmonics expansion.
+int computeAdaptiveTruncationDegree( const double radius,
+                                     const double gravitationalParameter,
+                                     const double equatorialRadius,
+                                     const Eigen::VectorXd& degreeCoefficientNorms,
+                                     const double tolerance )
+{
+    const int maximumDegree = static_cast< int >( degreeCoefficientNorms.rows( ) ) - 1;
+    const double radiusRatio = equatorialRadius / radius;
+    const double centralAcceleration = gravitationalParameter / ( radius * radius );
+
+    // Sum estimated acceleration of omitted terms, starting at highest degree, until tolerance
+    // is exceeded.
+    double omittedAcceleration = 0.0;
+    for ( int degree = maximumDegree; degree > 1; degree-- )
+    {
+        omittedAcceleration += centralAcceleration
+                * std::pow( radiusRatio, degree ) * degreeCoefficientNorms( degree )
+                * std::sqrt( static_cast< double >( ( degree + 1 ) * ( 2 * degree + 1 ) ) );
+
+        if ( omittedAcceleration > tolerance )
+        {
+            return degree;
+        }
+    }
+
+    return std::min( maximumDegree, 1 );
+}
+
 } // namespace gravitation
 } // namespace tudat
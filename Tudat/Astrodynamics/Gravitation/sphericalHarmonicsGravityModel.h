@@ -30,30 +30,46 @@
  *                                  renamed file, and merged content from other files.
  *      121210    D. Dirkx          Simplified class by removing template parameters.
  *      130224    K. Kumar          Updated include guard name; corrected Doxygen errors.
+ *      261018                      Added workspace overload of acceleration sum function, and
+ *                                  workspace member to acceleration model class.
+ *      261018                      Added selection of Pines formulation, and gravity gradient
+ *                                  tensor.
+ *      261018                      Added altitude-adaptive truncation of acceleration sum.
+ *      261018                      Allocate only workspace of formulation that is used.
  *
  *    References
  *      Heiskanen, W.A., Moritz, H. Physical geodesy. Freeman, 1967.
+ *      Kaula, W.M. Theory of satellite geodesy. Blaisdell, 1966.
  *
  *    Notes
- *      The class implementation currently only wraps the geodesy-normalized free function to
- *      compute the gravitational acceleration. Maybe in future, using an enum, the user can be
- *      given the choice of the free function to wrap.
+ *      The class implementation wraps either the geodesy-normalized free function that uses
+ *      spherical coordinates, or the singularity-free Pines formulation, to compute the
+ *      gravitational acceleration. The formulation is selected using the
+ *      SphericalHarmonicsFormulation enum.
+ *      If a truncation tolerance is set, the expansion is truncated at the lowest degree for
+ *      which the estimated acceleration of the omitted terms, based on the per-degree RMS power
+ *      of the coefficients, is below the tolerance. This estimate is a statistical (RMS) measure,
+ *      not a strict upper bound on the error of a single evaluation.
  *
  */
 
 #ifndef TUDAT_SPHERICAL_HARMONICS_GRAVITY_MODEL_H
 #define TUDAT_SPHERICAL_HARMONICS_GRAVITY_MODEL_H
 
+#include <algorithm>
 #include <stdexcept>
 
 #include <boost/function.hpp>
+#include <boost/make_shared.hpp>
 #include <boost/lambda/lambda.hpp>
 #include <boost/shared_ptr.hpp>
 
 #include <Eigen/Core>
 
 #include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModel.h"
+#include "Tudat/Astrodynamics/Gravitation/pinesSphericalHarmonicsGravityModel.h"
 #include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModelBase.h"
+#include "Tudat/Mathematics/BasicMathematics/sphericalHarmonics.h"
 
 namespace tudat
 {
@@ -109,6 +125,84 @@ Eigen::Vector3d computeGeodesyNormalizedGravitationalAccelerationSum(
         const Eigen::MatrixXd& cosineHarmonicCoefficients,
         const Eigen::MatrixXd& sineHarmonicCoefficients );
 
+//! Compute gravitational acceleration due to multiple spherical harmonics terms, defined using
+//! geodesy-normalization, using existing workspace.
+/*!
+ * This function computes the acceleration caused by gravitational spherical harmonics, with the
+ * coefficients expressed using a geodesy-normalization, in the same manner as the function
+ * without workspace argument. The Legendre polynomials, their derivatives and the trigonometric
+ * and radius terms are evaluated in a single pass by the workspace that is passed to this
+ * function, which avoids repeated allocation and precomputation of normalization factors when
+ * the acceleration is evaluated many times (e.g., during numerical propagation).
+ * \param positionOfBodySubjectToAcceleration Cartesian position vector with respect to the
+ *          reference frame that is associated with the harmonic coefficients.
+ * \param gravitationalParameter Gravitational parameter associated with the spherical harmonics
+ *          [m^3 s^-2].
+ * \param equatorialRadius Reference radius of the spherical harmonics [m].
+ * \param cosineHarmonicCoefficients Matrix with <B>geodesy-normalized</B> cosine harmonic
+ *          coefficients. The row index indicates the degree and the column index indicates the
+ *          order of coefficients.
+ * \param sineHarmonicCoefficients Matrix with <B>geodesy-normalized</B> sine harmonic
+ *          coefficients. The matrix must be equal in size to cosineHarmonicCoefficients.
+ * \param sphericalHarmonicsWorkspace Workspace used to evaluate the spherical harmonics terms.
+ *          Its maximum degree and order must be at least equal to the highest degree and order
+ *          of the coefficient matrices.
+ * \param truncationDegree Degree up to which the expansion is summed; a negative value denotes
+ *          the highest degree of the coefficient matrices (default = -1).
+ * \return Cartesian acceleration vector resulting from the summation of all harmonic terms.
+ */
+Eigen::Vector3d computeGeodesyNormalizedGravitationalAccelerationSum(
+        const Eigen::Vector3d& positionOfBodySubjectToAcceleration,
+        const double gravitationalParameter,
+        const double equatorialRadius,
+        const Eigen::MatrixXd& cosineHarmonicCoefficients,
+        const Eigen::MatrixXd& sineHarmonicCoefficients,
+        basic_mathematics::SphericalHarmonicsWorkspace& sphericalHarmonicsWorkspace,
+        const int truncationDegree = -1 );
+
+//! Compute per-degree RMS power of geodesy-normalized coefficients.
+/*!
+ * Computes, for each degree n, the root-sum-square of the geodesy-normalized coefficients of that
+ * degree:
+ * \f[
+ *     P_{ n } = \sqrt{ \sum_{ m = 0 }^{ n } \bar{ C }_{ n, m }^{ 2 } + \bar{ S }_{ n, m }^{ 2 } }
+ * \f]
+ * which is the square root of the degree variance of the expansion (Kaula, 1966).
+ * \param cosineHarmonicCoefficients Matrix with <B>geodesy-normalized</B> cosine harmonic
+ *          coefficients.
+ * \param sineHarmonicCoefficients Matrix with <B>geodesy-normalized</B> sine harmonic
+ *          coefficients.
+ * \return Vector with per-degree RMS power, the index denoting the degree.
+ */
+Eigen::VectorXd computeDegreeCoefficientNorms( const Eigen::MatrixXd& cosineHarmonicCoefficients,
+                                               const Eigen::MatrixXd& sineHarmonicCoefficients );
+
+//! Compute altitude-adaptive truncation degree of spherical harmonics expansion.
+/*!
+ * Computes the lowest degree N at which the spherical harmonics expansion can be truncated, such
+ * that the estimated acceleration of all omitted terms (degree N+1 and higher) is below the given
+ * tolerance. The RMS acceleration of the terms of degree n, at radius r, is estimated as:
+ * \f[
+ *     a_{ n } = \frac{ \mu }{ r^{ 2 } } \left( \frac{ R }{ r } \right)^{ n } P_{ n }
+ *               \sqrt{ ( n + 1 ) ( 2 n + 1 ) }
+ * \f]
+ * in which \f$ P_{ n } \f$ is the per-degree RMS power of the coefficients, as computed by
+ * computeDegreeCoefficientNorms(), and the omitted acceleration is taken as the sum of these
+ * estimates. Degrees 0 and 1 are never truncated.
+ * \param radius Distance from center of mass of body exerting acceleration [m].
+ * \param gravitationalParameter Gravitational parameter of body exerting acceleration
+ *          [m^3 s^-2].
+ * \param equatorialRadius Reference radius of the spherical harmonics [m].
+ * \param degreeCoefficientNorms Per-degree RMS power of the coefficients.
+ * \param tolerance Tolerance on omitted acceleration [m s^-2].
+ * \return Truncation degree.
+ */
+int computeAdaptiveTruncationDegree( const double radius,
+                                     const double gravitationalParameter,
+                                     const double equatorialRadius,
+                                     const Eigen::VectorXd& degreeCoefficientNorms,
+                                     const double tolerance );
+
 //! Compute gravitational acceleration due to single spherical harmonics term.
 /*!
  * This function computes the acceleration caused by a single gravitational spherical harmonics
@@ -157,13 +251,27 @@ Eigen::Vector3d computeSingleGeodesyNormalizedGravitationalAcceleration(
         const double cosineHarmonicCoefficient,
         const double sineHarmonicCoefficient );
 
+//! Formulations with which spherical harmonics acceleration can be evaluated.
+enum SphericalHarmonicsFormulation
+{
+    //! Evaluation in spherical coordinates, with
+    //! computeGeodesyNormalizedGravitationalAccelerationSum.
+    sphericalCoordinatesFormulation,
+
+    //! Evaluation with singularity-free Pines formulation, with
+    //! computePinesGeodesyNormalizedGravitationalAccelerationSum.
+    pinesFormulation
+};
+
 //! Template class for general spherical harmonics gravitational acceleration model.
 /*!
  * This templated class implements a general spherical harmonics gravitational acceleration model.
  * The acceleration computed with this class is based on the geodesy-normalization described by
  * (Heiskanen & Moritz, 1967), implemented in the
- * computeGeodesyNormalizedGravitationalAccelerationSum() function. The acceleration computed is a
- * sum, based on the matrix of coefficients of the model provided.
+ * computeGeodesyNormalizedGravitationalAccelerationSum() function, or, if selected, in the
+ * computePinesGeodesyNormalizedGravitationalAccelerationSum() function, which is free of
+ * singularities at the poles. The acceleration computed is a sum, based on the matrix of
+ * coefficients of the model provided.
  * \tparam CoefficientMatrixType Data type for cosine and sine coefficients in spherical harmonics
  *         expansion; may be used for compile-time definition of maximum degree and order.
  */
@@ -202,6 +310,8 @@ public:
      * \param aSineHarmonicCoefficientMatrix A (constant) sine harmonic coefficient matrix.
      * \param positionOfBodyExertingAccelerationFunction Pointer to function returning position of
      *          body exerting gravitational acceleration (default = (0,0,0)).
+     * \param aFormulation Formulation with which acceleration is evaluated
+     *          (default = sphericalCoordinatesFormulation).
      */
     SphericalHarmonicsGravitationalAccelerationModel(
             const StateFunction positionOfBodySubjectToAccelerationFunction,
@@ -210,14 +320,19 @@ public:
             const CoefficientMatrixType aCosineHarmonicCoefficientMatrix,
             const CoefficientMatrixType aSineHarmonicCoefficientMatrix,
             const StateFunction positionOfBodyExertingAccelerationFunction
-            = boost::lambda::constant( Eigen::Vector3d::Zero( ) ) )
+            = boost::lambda::constant( Eigen::Vector3d::Zero( ) ),
+            const SphericalHarmonicsFormulation aFormulation = sphericalCoordinatesFormulation )
         : Base( positionOfBodySubjectToAccelerationFunction,
                 aGravitationalParameter,
                 positionOfBodyExertingAccelerationFunction ),
           equatorialRadius( anEquatorialRadius ),
           getCosineHarmonicsCoefficients(
               boost::lambda::constant(aCosineHarmonicCoefficientMatrix ) ),
-          getSineHarmonicsCoefficients( boost::lambda::constant(aSineHarmonicCoefficientMatrix ) )
+          getSineHarmonicsCoefficients( boost::lambda::constant(aSineHarmonicCoefficientMatrix ) ),
+          formulation( aFormulation ),
+          areCoefficientsConstant( true ),
+          truncationTolerance( 0.0 ),
+          currentTruncationDegree( -1 )
     {
         this->updateMembers( );
     }
@@ -241,6 +356,8 @@ public:
                 sine-coefficients of spherical harmonics expansion.
      * \param positionOfBodyExertingAccelerationFunction Pointer to function returning position of
      *          body exerting gravitational acceleration (default = (0,0,0)).
+     * \param aFormulation Formulation with which acceleration is evaluated
+     *          (default = sphericalCoordinatesFormulation).
      */
     SphericalHarmonicsGravitationalAccelerationModel(
             const StateFunction positionOfBodySubjectToAccelerationFunction,
@@ -249,13 +366,18 @@ public:
             const CoefficientMatrixReturningFunction cosineHarmonicCoefficientsFunction,
             const CoefficientMatrixReturningFunction sineHarmonicCoefficientsFunction,
             const StateFunction positionOfBodyExertingAccelerationFunction
-            = boost::lambda::constant( Eigen::Vector3d::Zero( ) ) )
+            = boost::lambda::constant( Eigen::Vector3d::Zero( ) ),
+            const SphericalHarmonicsFormulation aFormulation = sphericalCoordinatesFormulation )
         : Base( positionOfBodySubjectToAccelerationFunction,
                 aGravitationalParameter,
                 positionOfBodyExertingAccelerationFunction ),
           equatorialRadius( anEquatorialRadius ),
           getCosineHarmonicsCoefficients( cosineHarmonicCoefficientsFunction ),
-          getSineHarmonicsCoefficients( sineHarmonicCoefficientsFunction )
+          getSineHarmonicsCoefficients( sineHarmonicCoefficientsFunction ),
+          formulation( aFormulation ),
+          areCoefficientsConstant( false ),
+          truncationTolerance( 0.0 ),
+          currentTruncationDegree( -1 )
     {
         this->updateMembers( );
     }
@@ -269,6 +391,52 @@ public:
      */
     Eigen::Vector3d getAcceleration( );
 
+    //! Get gravity gradient tensor.
+    /*!
+     * Returns the gravity gradient tensor (partial derivatives of the gravitational acceleration
+     * w.r.t. the position of the body subject to the acceleration), computed using the input
+     * parameters provided to the class. The tensor is always evaluated with the Pines
+     * formulation, through the computePinesGeodesyNormalizedGravityGradientTensor() function.
+     * \return Computed gravity gradient tensor.
+     */
+    Eigen::Matrix3d getGravityGradientTensor( );
+
+    //! Get formulation with which acceleration is evaluated.
+    /*!
+     * Returns the formulation with which the acceleration is evaluated.
+     * \return Formulation with which acceleration is evaluated.
+     */
+    SphericalHarmonicsFormulation getFormulation( ) { return formulation; }
+
+    //! Set tolerance for altitude-adaptive truncation of expansion.
+    /*!
+     * Sets the tolerance on the estimated acceleration of the omitted terms, with which the
+     * truncation degree of the expansion is determined at each evaluation of the acceleration,
+     * using computeAdaptiveTruncationDegree(). The per-degree RMS power of the coefficients is
+     * computed once by this function if the coefficients are constant, and at each call to
+     * updateMembers() otherwise. A tolerance that is zero or negative disables truncation
+     * (default).
+     * \param aTruncationTolerance Tolerance on omitted acceleration [m s^-2].
+     */
+    void setTruncationTolerance( const double aTruncationTolerance )
+    {
+        truncationTolerance = aTruncationTolerance;
+        if ( truncationTolerance > 0.0 )
+        {
+            degreeCoefficientNorms = computeDegreeCoefficientNorms(
+                        cosineHarmonicCoefficients, sineHarmonicCoefficients );
+        }
+        currentTruncationDegree = -1;
+    }
+
+    //! Get truncation degree used in last evaluation of acceleration.
+    /*!
+     * Returns the degree at which the expansion was truncated in the last evaluation of the
+     * acceleration. A value of -1 denotes that the full expansion was used.
+     * \return Truncation degree used in last evaluation of acceleration.
+     */
+    int getCurrentTruncationDegree( ) { return currentTruncationDegree; }
+
     //! Update class members.
     /*!
      * Updates all the base class members to their current values and also updates the class
@@ -278,6 +446,14 @@ public:
     {
         cosineHarmonicCoefficients = getCosineHarmonicsCoefficients( );
         sineHarmonicCoefficients = getSineHarmonicsCoefficients( );
+
+        // Recompute per-degree power of coefficients only if these may have changed.
+        if ( truncationTolerance > 0.0 && !areCoefficientsConstant )
+        {
+            degreeCoefficientNorms = computeDegreeCoefficientNorms(
+                        cosineHarmonicCoefficients, sineHarmonicCoefficients );
+        }
+
         this->updateBaseMembers( );
     }
 
@@ -285,6 +461,56 @@ protected:
 
 private:
 
+    //! Get maximum degree of coefficient matrices.
+    int getMaximumDegree( ) const
+    {
+        return std::max( static_cast< int >( cosineHarmonicCoefficients.rows( ) ) - 1, 0 );
+    }
+
+    //! Get maximum order of coefficient matrices.
+    int getMaximumOrder( ) const
+    {
+        return std::max( static_cast< int >( cosineHarmonicCoefficients.cols( ) ) - 1, 0 );
+    }
+
+    //! Get workspace for spherical coordinates formulation.
+    /*!
+     * Returns workspace for spherical coordinates formulation, which is created on first use,
+     * and recreated only if the size of the coefficient matrices has changed.
+     * \return Workspace for spherical coordinates formulation.
+     */
+    basic_mathematics::SphericalHarmonicsWorkspace& getSphericalCoordinatesWorkspace( )
+    {
+        if ( !sphericalHarmonicsWorkspace
+             || sphericalHarmonicsWorkspace->getMaximumDegree( ) != getMaximumDegree( )
+             || sphericalHarmonicsWorkspace->getMaximumOrder( ) != getMaximumOrder( ) )
+        {
+            sphericalHarmonicsWorkspace
+                    = boost::make_shared< basic_mathematics::SphericalHarmonicsWorkspace >(
+                        getMaximumDegree( ), getMaximumOrder( ) );
+        }
+        return *sphericalHarmonicsWorkspace;
+    }
+
+    //! Get workspace for Pines formulation.
+    /*!
+     * Returns workspace for Pines formulation (used for the acceleration if selected, and for the
+     * gravity gradient tensor), which is created on first use, and recreated only if the size of
+     * the coefficient matrices has changed.
+     * \return Workspace for Pines formulation.
+     */
+    PinesSphericalHarmonicsWorkspace& getPinesWorkspace( )
+    {
+        if ( !pinesWorkspace
+             || pinesWorkspace->getMaximumDegree( ) != getMaximumDegree( )
+             || pinesWorkspace->getMaximumOrder( ) != getMaximumOrder( ) )
+        {
+            pinesWorkspace = boost::make_shared< PinesSphericalHarmonicsWorkspace >(
+                        getMaximumDegree( ), getMaximumOrder( ) );
+        }
+        return *pinesWorkspace;
+    }
+
     //! Equatorial radius [m].
     /*!
      * Current value of equatorial (planetary) radius used for spherical harmonics expansion [m].
@@ -316,6 +542,38 @@ private:
      * spherical harmonics expansion.
      */
     const CoefficientMatrixReturningFunction getSineHarmonicsCoefficients;
+
+    //! Formulation with which acceleration is evaluated.
+    const SphericalHarmonicsFormulation formulation;
+
+    //! Boolean denoting whether the coefficients are constant.
+    const bool areCoefficientsConstant;
+
+    //! Tolerance on omitted acceleration for adaptive truncation [m s^-2].
+    double truncationTolerance;
+
+    //! Per-degree RMS power of coefficients, used for adaptive truncation.
+    Eigen::VectorXd degreeCoefficientNorms;
+
+    //! Truncation degree used in last evaluation of acceleration (-1 if full expansion is used).
+    int currentTruncationDegree;
+
+    //! Workspace for evaluation of spherical harmonics terms.
+    /*!
+     * Workspace in which the Legendre polynomials, trigonometric terms and radius terms are
+     * evaluated, reused for each evaluation of the acceleration. Only allocated if the spherical
+     * coordinates formulation is used.
+     */
+    basic_mathematics::SphericalHarmonicsWorkspacePointer sphericalHarmonicsWorkspace;
+
+    //! Workspace for evaluation of spherical harmonics terms with Pines formulation.
+    /*!
+     * Workspace in which the derived Legendre functions and other terms of the Pines
+     * formulation are evaluated, reused for each evaluation of the acceleration and gravity
+     * gradient tensor. Only allocated if the Pines formulation or gravity gradient tensor is
+     * used.
+     */
+    PinesSphericalHarmonicsWorkspacePointer pinesWorkspace;
 };
 
 //! Typedef for SphericalHarmonicsGravitationalAccelerationModelXd.
@@ -335,13 +593,55 @@ template< typename CoefficientMatrixType >
 Eigen::Vector3d SphericalHarmonicsGravitationalAccelerationModel< CoefficientMatrixType >
 ::getAcceleration( )
 {
+    const Eigen::Vector3d relativePosition = this->positionOfBodySubjectToAcceleration
+            - this->positionOfBodyExertingAcceleration;
+
+    // Determine truncation degree from current radius, if required.
+    currentTruncationDegree = -1;
+    if ( truncationTolerance > 0.0 )
+    {
+        currentTruncationDegree = computeAdaptiveTruncationDegree(
+                    relativePosition.norm( ), gravitationalParameter, equatorialRadius,
+                    degreeCoefficientNorms, truncationTolerance );
+    }
+
+    if ( formulation == pinesFormulation )
+    {
+        return computePinesGeodesyNormalizedGravitationalAccelerationSum(
+                    relativePosition,
+                    gravitationalParameter,
+                    equatorialRadius,
+                    cosineHarmonicCoefficients,
+                    sineHarmonicCoefficients,
+                    getPinesWorkspace( ),
+                    currentTruncationDegree );
+    }
+
     return computeGeodesyNormalizedGravitationalAccelerationSum(
+                relativePosition,
+                gravitationalParameter,
+                equatorialRadius,
+                cosineHarmonicCoefficients,
+                sineHarmonicCoefficients,
+                getSphericalCoordinatesWorkspace( ),
+                currentTruncationDegree );
+}
+
+//! Get gravity gradient tensor.
+template< typename CoefficientMatrixType >
+Eigen::Matrix3d SphericalHarmonicsGravitationalAccelerationModel< CoefficientMatrixType >
+::getGravityGradientTensor( )
+{
+    Eigen::Vector3d acceleration;
+    return computePinesGeodesyNormalizedGravityGradientTensor(
                 this->positionOfBodySubjectToAcceleration
                 - this->positionOfBodyExertingAcceleration,
                 gravitationalParameter,
                 equatorialRadius,
                 cosineHarmonicCoefficients,
-                sineHarmonicCoefficients );
+                sineHarmonicCoefficients,
+                getPinesWorkspace( ),
+                acceleration );
 }
 
 } // namespace gravitation
@@ -26,15 +26,21 @@
  *      YYMMDD    Author            Comment
  *      130307    R.C.A. Boon       File created.
  *      130308    D. Dirkx          Modified to add variable central body position.
+ *      261018                      Added Battin formulation of third-body perturbation and
+ *                                  grouped third-body acceleration model.
  *
  *    References
  *      Wakker, K.F. Astrodynamics I, Delft University of Technology, 2010.
  *      Montebruck O, Gill E. Satellite Orbits, Corrected Third Printing, Springer, 2005.
+ *      Battin, R.H. An Introduction to the Mathematics and Methods of Astrodynamics, Revised
+ *          Edition, AIAA Education Series, 1999.
  *
  *    Notes
  *
  */
 
+#include <cmath>
+
 #include "Tudat/Astrodynamics/Gravitation/centralGravityModel.h"
 #include "Tudat/Astrodynamics/Gravitation/thirdBodyPerturbation.h"
 
@@ -60,5 +66,106 @@ Eigen::Vector3d computeThirdBodyPerturbingAcceleration(
                                               positionOfPerturbingBody );
 }
 
+//! Compute perturbing acceleration by third body, using Battin's formulation.
+Eigen::Vector3d computeThirdBodyPerturbingAccelerationBattin(
+        const double gravitationalParameterOfPerturbingBody,
+        const Eigen::Vector3d& relativePositionOfPerturbingBody,
+        const Eigen::Vector3d& relativePositionOfAffectedBody )
+// Using chapter 8 of (Battin, 1999).
+{
+    const double inverseSquaredDistanceOfPerturbingBody
+            = 1.0 / relativePositionOfPerturbingBody.squaredNorm( );
+
+    // Compute q = r . ( r - 2 s ) / s^2, and f( q ), avoiding cancellation for small r.
+    const double q = relativePositionOfAffectedBody.dot(
+                relativePositionOfAffectedBody - 2.0 * relativePositionOfPerturbingBody )
+            * inverseSquaredDistanceOfPerturbingBody;
+    const double f = q * ( 3.0 + 3.0 * q + q * q ) / ( 1.0 + std::pow( 1.0 + q, 1.5 ) );
+
+    const double distanceToPerturbingBody
+            = ( relativePositionOfPerturbingBody - relativePositionOfAffectedBody ).norm( );
+    return -gravitationalParameterOfPerturbingBody
+            / ( distanceToPerturbingBody * distanceToPerturbingBody * distanceToPerturbingBody )
+            * ( relativePositionOfAffectedBody + f * relativePositionOfPerturbingBody );
+}
+
+//! Constructor.
+GroupedThirdBodyAccelerationModel::GroupedThirdBodyAccelerationModel(
+        const PositionFunction positionOfBodySubjectToAccelerationFunction,
+        const PositionFunction positionOfCentralBodyFunction )
+    : positionOfBodySubjectToAccelerationFunction_( positionOfBodySubjectToAccelerationFunction ),
+      positionOfCentralBodyFunction_( positionOfCentralBodyFunction ),
+      currentRelativePositionOfAffectedBody_( Eigen::Vector3d::Zero( ) )
+{ }
+
+//! Add perturbing body.
+void GroupedThirdBodyAccelerationModel::addPerturbingBody(
+        const double gravitationalParameter, const PositionFunction positionFunction )
+{
+    gravitationalParameters_.push_back( gravitationalParameter );
+    positionFunctionsOfPerturbingBodies_.push_back( positionFunction );
+    currentRelativePositionsOfPerturbingBodies_.setZero( 3, gravitationalParameters_.size( ) );
+    currentInverseSquaredDistancesOfPerturbingBodies_.setZero( gravitationalParameters_.size( ) );
+}
+
+//! Compute accelerations of a set of bodies.
+Eigen::Matrix3Xd GroupedThirdBodyAccelerationModel::computeAccelerations(
+        const Eigen::Matrix3Xd& relativePositionsOfAffectedBodies )
+{
+    Eigen::Matrix3Xd accelerations( 3, relativePositionsOfAffectedBodies.cols( ) );
+    for ( int i = 0; i < relativePositionsOfAffectedBodies.cols( ); i++ )
+    {
+        accelerations.col( i ) = computeAcceleration( relativePositionsOfAffectedBodies.col( i ) );
+    }
+    return accelerations;
+}
+
+//! Update member variables to current state.
+void GroupedThirdBodyAccelerationModel::updateMembers( )
+{
+    // Retrieve position of central body once, shared by all perturbing bodies.
+    const Eigen::Vector3d positionOfCentralBody = positionOfCentralBodyFunction_( );
+    currentRelativePositionOfAffectedBody_
+            = positionOfBodySubjectToAccelerationFunction_( ) - positionOfCentralBody;
+
+    for ( unsigned int i = 0; i < positionFunctionsOfPerturbingBodies_.size( ); i++ )
+    {
+        currentRelativePositionsOfPerturbingBodies_.col( i )
+                = positionFunctionsOfPerturbingBodies_[ i ]( ) - positionOfCentralBody;
+        currentInverseSquaredDistancesOfPerturbingBodies_( i )
+                = 1.0 / currentRelativePositionsOfPerturbingBodies_.col( i ).squaredNorm( );
+    }
+}
+
+//! Compute acceleration of single body.
+Eigen::Vector3d GroupedThirdBodyAccelerationModel::computeAcceleration(
+        const Eigen::Vector3d& relativePositionOfAffectedBody )
+{
+    const double squaredDistanceOfAffectedBody = relativePositionOfAffectedBody.squaredNorm( );
+
+    // Sum perturbations of all bodies in a single loop, using Battin's formulation.
+    Eigen::Vector3d acceleration = Eigen::Vector3d::Zero( );
+    for ( unsigned int i = 0; i < gravitationalParameters_.size( ); i++ )
+    {
+        const Eigen::Vector3d relativePositionOfPerturbingBody
+                = currentRelativePositionsOfPerturbingBodies_.col( i );
+
+        const double q = ( squaredDistanceOfAffectedBody - 2.0 * relativePositionOfAffectedBody.dot(
+                               relativePositionOfPerturbingBody ) )
+                * currentInverseSquaredDistancesOfPerturbingBodies_( i );
+        const double onePlusQ = 1.0 + q;
+        const double f = q * ( 3.0 + 3.0 * q + q * q ) / ( 1.0 + onePlusQ * std::sqrt( onePlusQ ) );
+
+        // Compute d^2 = s^2 ( 1 + q ).
+        const double squaredDistanceToPerturbingBody
+                = onePlusQ / currentInverseSquaredDistancesOfPerturbingBodies_( i );
+        acceleration -= gravitationalParameters_[ i ]
+                / ( squaredDistanceToPerturbingBody * std::sqrt( squaredDistanceToPerturbingBody ) )
+                * ( relativePositionOfAffectedBody + f * relativePositionOfPerturbingBody );
+    }
+
+    return acceleration;
+}
+
 } // namespace gravitation
 } // namespace tudat
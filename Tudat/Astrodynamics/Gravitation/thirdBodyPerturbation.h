@@ -26,10 +26,14 @@
  *      YYMMDD    Author            Comment
  *      130307    R.C.A. Boon       File created.
  *      130308    D. Dirkx          Modified to add variable central body position.
+ *      261018                      Added Battin formulation of third-body perturbation and
+ *                                  grouped third-body acceleration model.
  *
  *    References
  *      Wakker, K.F. Astrodynamics I, Delft University of Technology, 2010.
  *      Montebruck O, Gill E. Satellite Orbits, Corrected Third Printing, Springer, 2005.
+ *      Battin, R.H. An Introduction to the Mathematics and Methods of Astrodynamics, Revised
+ *          Edition, AIAA Education Series, 1999.
  *
  *    Notes
  *
@@ -38,8 +42,14 @@
 #ifndef TUDAT_THIRD_BODY_PERTURBATION_H
 #define TUDAT_THIRD_BODY_PERTURBATION_H
 
+#include <vector>
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+
 #include <Eigen/Core>
 
+#include "Tudat/Astrodynamics/BasicAstrodynamics/accelerationModel.h"
 #include "Tudat/Astrodynamics/Gravitation/centralGravityModel.h"
 #include "Tudat/Astrodynamics/Gravitation/sphericalHarmonicsGravityModel.h"
 
@@ -85,6 +95,30 @@ Eigen::Vector3d computeThirdBodyPerturbingAcceleration(
         const Eigen::Vector3d& positionOfAffectedBody,
         const Eigen::Vector3d& positionOfCentralBody = Eigen::Vector3d::Zero( ) );
 
+//! Compute perturbing acceleration by third body, using Battin's formulation.
+/*!
+ * Computes the perturbing acceleration by a third body, in the same manner as
+ * computeThirdBodyPerturbingAcceleration( ), but using the formulation of Battin (1999), which
+ * does not suffer from the loss of precision that occurs when the difference of the two
+ * (nearly equal) direct accelerations is taken for a body close to the central body:
+ * \f{eqnarray*}{
+ *      \bar{a} &=& -\frac{ \mu_{ p } }{ d^{ 3 } } \left( \bar{r} + f( q ) \bar{s} \right) \\
+ *      q &=& \frac{ \bar{r} \cdot ( \bar{r} - 2 \bar{s} ) }{ \bar{s} \cdot \bar{s} } \\
+ *      f( q ) &=& q \frac{ 3 + 3 q + q^{ 2 } }{ 1 + ( 1 + q )^{ 3 / 2 } }
+ * \f}
+ * where \f$ \bar{r} \f$ and \f$ \bar{s} \f$ are the positions of the affected and perturbing
+ * body w.r.t. the central body, and \f$ d = | \bar{s} - \bar{r} | \f$.
+ * \param gravitationalParameterOfPerturbingBody Gravitational parameter of perturbing body
+ *          [m^3 s^-2].
+ * \param relativePositionOfPerturbingBody Position of perturbing body w.r.t. central body [m].
+ * \param relativePositionOfAffectedBody Position of affected body w.r.t. central body [m].
+ * \return Perturbing acceleration of affected body, w.r.t. central body [m s^-2].
+ */
+Eigen::Vector3d computeThirdBodyPerturbingAccelerationBattin(
+        const double gravitationalParameterOfPerturbingBody,
+        const Eigen::Vector3d& relativePositionOfPerturbingBody,
+        const Eigen::Vector3d& relativePositionOfAffectedBody );
+
 //! Class for calculating third-body (gravitational) accelerations.
 /*!
  *  Class for calculating third-body (gravitational accelerations),
@@ -190,6 +224,125 @@ ThirdBodyCentralGravityAcceleration;
 typedef ThirdBodyAcceleration< SphericalHarmonicsGravitationalAccelerationModelXd >
 ThirdBodySphericalHarmonicsGravitationalAccelerationModel;
 
+//! Class for calculating grouped third-body (point-mass) accelerations.
+/*!
+ * Class for calculating the sum of the third-body accelerations of any number of point-mass
+ * perturbing bodies on a body, expressed in a frame centered on a single central body. In
+ * contrast to a set of ThirdBodyAcceleration objects, the position of each body (including the
+ * central body) is retrieved only once per call to updateMembers( ), after which the
+ * perturbations of all bodies are evaluated in a single loop, using the numerically stable
+ * formulation of Battin (1999) (see computeThirdBodyPerturbingAccelerationBattin( )). The
+ * quantities that depend only on the perturbing bodies are computed during the update, so that
+ * the perturbations of several affected bodies in the same environment can be computed at little
+ * additional cost with computeAccelerations( ).
+ */
+class GroupedThirdBodyAccelerationModel
+        : public basic_astrodynamics::AccelerationModel< Eigen::Vector3d >
+{
+public:
+
+    //! Typedef for a position-returning function.
+    typedef boost::function< Eigen::Vector3d( ) > PositionFunction;
+
+    //! Constructor.
+    /*!
+     * Constructor, sets the functions returning the positions of the body undergoing the
+     * acceleration and of the central body. Perturbing bodies are added with
+     * addPerturbingBody( ).
+     * \param positionOfBodySubjectToAccelerationFunction Function returning position of body
+     *          subject to acceleration.
+     * \param positionOfCentralBodyFunction Function returning position of central body.
+     */
+    GroupedThirdBodyAccelerationModel(
+            const PositionFunction positionOfBodySubjectToAccelerationFunction,
+            const PositionFunction positionOfCentralBodyFunction );
+
+    //! Add perturbing body.
+    /*!
+     * Adds a (point-mass) perturbing body.
+     * \param gravitationalParameter Gravitational parameter of perturbing body [m^3 s^-2].
+     * \param positionFunction Function returning position of perturbing body, in the same frame
+     *          as the positions of the central body and body subject to acceleration.
+     */
+    void addPerturbingBody( const double gravitationalParameter,
+                            const PositionFunction positionFunction );
+
+    //! Get acceleration.
+    /*!
+     * Returns the sum of the third-body accelerations of all perturbing bodies, as computed from
+     * the positions retrieved during the last call to updateMembers( ).
+     * \return Sum of third-body accelerations [m s^-2].
+     */
+    Eigen::Vector3d getAcceleration( )
+    {
+        return computeAcceleration( currentRelativePositionOfAffectedBody_ );
+    }
+
+    //! Compute accelerations of a set of bodies.
+    /*!
+     * Computes the sum of the third-body accelerations of all perturbing bodies for a set of
+     * bodies, using the positions of the perturbing bodies retrieved during the last call to
+     * updateMembers( ).
+     * \param relativePositionsOfAffectedBodies Positions of affected bodies w.r.t. central body,
+     *          each column containing the position of a single body [m].
+     * \return Sum of third-body accelerations of each body, each column containing the
+     *          acceleration of a single body [m s^-2].
+     */
+    Eigen::Matrix3Xd computeAccelerations(
+            const Eigen::Matrix3Xd& relativePositionsOfAffectedBodies );
+
+    //! Update member variables to current state.
+    /*!
+     * Retrieves the positions of the central body, the body subject to acceleration and all
+     * perturbing bodies (each exactly once), and computes the positions of the perturbing bodies
+     * w.r.t. the central body.
+     */
+    void updateMembers( );
+
+    //! Get number of perturbing bodies.
+    /*!
+     * Returns the number of perturbing bodies.
+     * \return Number of perturbing bodies.
+     */
+    int getNumberOfPerturbingBodies( ) { return gravitationalParameters_.size( ); }
+
+private:
+
+    //! Compute acceleration of single body.
+    /*!
+     * Computes the sum of the third-body accelerations of all perturbing bodies for a single
+     * body, using the current positions of the perturbing bodies.
+     * \param relativePositionOfAffectedBody Position of affected body w.r.t. central body [m].
+     * \return Sum of third-body accelerations [m s^-2].
+     */
+    Eigen::Vector3d computeAcceleration( const Eigen::Vector3d& relativePositionOfAffectedBody );
+
+    //! Function returning position of body subject to acceleration.
+    PositionFunction positionOfBodySubjectToAccelerationFunction_;
+
+    //! Function returning position of central body.
+    PositionFunction positionOfCentralBodyFunction_;
+
+    //! Gravitational parameters of perturbing bodies [m^3 s^-2].
+    std::vector< double > gravitationalParameters_;
+
+    //! Functions returning positions of perturbing bodies.
+    std::vector< PositionFunction > positionFunctionsOfPerturbingBodies_;
+
+    //! Current positions of perturbing bodies w.r.t. central body, one per column.
+    Eigen::Matrix3Xd currentRelativePositionsOfPerturbingBodies_;
+
+    //! Current inverse squared distances of perturbing bodies to central body.
+    Eigen::VectorXd currentInverseSquaredDistancesOfPerturbingBodies_;
+
+    //! Current position of body subject to acceleration w.r.t. central body.
+    Eigen::Vector3d currentRelativePositionOfAffectedBody_;
+};
+
+//! Typedef for shared-pointer to GroupedThirdBodyAccelerationModel.
+typedef boost::shared_ptr< GroupedThirdBodyAccelerationModel >
+GroupedThirdBodyAccelerationModelPointer;
+
 } // namespace gravitation
 
 } // namespace tudat
@@ -0,0 +1,226 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      Unit test created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <boost/bind.hpp>
+#include <boost/lambda/lambda.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "Tudat/Basics/testMacros.h"
+
+#include "Tudat/Astrodynamics/Gravitation/centralJ2GravityModel.h"
+#include "Tudat/Astrodynamics/Gravitation/thirdBodyPerturbation.h"
+#include "Tudat/Astrodynamics/StateDerivativeModels/multiBodyCartesianStateDerivativeModel.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Compute position of test third body (circular orbit in xy-plane) as a function of time.
+Eigen::Vector3d getThirdBodyPosition( const double time, const double distance,
+                                      const double angularVelocity )
+{
+    return distance * Eigen::Vector3d( std::cos( angularVelocity * time ),
+                                       std::sin( angularVelocity * time ), 0.1 );
+}
+
+//! Get constant test rotation from inertial to body-fixed frame.
+Eigen::Quaterniond getTestRotation( const double time )
+{
+    return Eigen::Quaterniond( Eigen::AngleAxisd( 0.3, Eigen::Vector3d::UnitX( ) )
+                               * Eigen::AngleAxisd( 1.0E-4 * time, Eigen::Vector3d::UnitZ( ) ) );
+}
+
+BOOST_AUTO_TEST_SUITE( test_multi_body_cartesian_state_derivative_model )
+
+//! Test whether multi-body model reproduces independent acceleration models of each body.
+BOOST_AUTO_TEST_CASE( testMultiBodyStateDerivativeAgainstSingleBodyModels )
+{
+    using namespace gravitation;
+    using state_derivative_models::MultiBodyCartesianStateDerivativeModel;
+
+    // Set environment properties.
+    const double earthGravitationalParameter = 3.986004418E14;
+    const double earthEquatorialRadius = 6378136.6;
+    const double earthJ2 = 1.0826E-3;
+    const double moonGravitationalParameter = 4.9048695E12;
+    const double sunGravitationalParameter = 1.32712440018E20;
+    const double moonDistance = 3.844E8;
+    const double sunDistance = 1.496E11;
+    const double moonAngularVelocity = 2.66E-6;
+    const double sunAngularVelocity = 1.99E-7;
+    const double currentTime = 3.2E4;
+
+    // Set states of a set of spacecraft.
+    const int numberOfBodies = 13;
+    Eigen::VectorXd states( 6 * numberOfBodies );
+    for ( int i = 0; i < numberOfBodies; i++ )
+    {
+        const double angle = 0.47 * static_cast< double >( i );
+        const double radius = 6.9E6 + 2.5E5 * static_cast< double >( i );
+        states.segment( 6 * i, 3 ) = radius * Eigen::Vector3d(
+                    std::cos( angle ) * std::cos( 0.2 * angle ), std::sin( angle ),
+                    std::cos( angle ) * std::sin( 0.2 * angle ) + 0.3 );
+        states.segment( 6 * i + 3, 3 ) = Eigen::Vector3d(
+                    -7.0E3 * std::sin( angle ), 7.0E3 * std::cos( angle ),
+                    1.0E2 * static_cast< double >( i ) );
+    }
+
+    // Create multi-body state derivative model.
+    MultiBodyCartesianStateDerivativeModel multiBodyModel(
+                numberOfBodies, earthGravitationalParameter, earthEquatorialRadius, earthJ2 );
+    multiBodyModel.addThirdBody( moonGravitationalParameter,
+                                 boost::bind( &getThirdBodyPosition, _1, moonDistance,
+                                              moonAngularVelocity ) );
+    multiBodyModel.addThirdBody( sunGravitationalParameter,
+                                 boost::bind( &getThirdBodyPosition, _1, sunDistance,
+                                              sunAngularVelocity ) );
+
+    // Compute state derivative.
+    const Eigen::VectorXd computedStateDerivative
+            = multiBodyModel.computeStateDerivative( currentTime, states );
+
+    // Compute expected state derivative with single-body acceleration models.
+    const Eigen::Vector3d moonPosition
+            = getThirdBodyPosition( currentTime, moonDistance, moonAngularVelocity );
+    const Eigen::Vector3d sunPosition
+            = getThirdBodyPosition( currentTime, sunDistance, sunAngularVelocity );
+
+    for ( int i = 0; i < numberOfBodies; i++ )
+    {
+        const Eigen::Vector3d position = states.segment( 6 * i, 3 );
+
+        CentralJ2GravitationalAccelerationModel centralBodyAcceleration(
+                    boost::lambda::constant( position ), earthGravitationalParameter,
+                    earthEquatorialRadius, earthJ2 );
+
+        const Eigen::Vector3d expectedAcceleration
+                = centralBodyAcceleration.getAcceleration( )
+                + computeThirdBodyPerturbingAcceleration(
+                    moonGravitationalParameter, moonPosition, position )
+                + computeThirdBodyPerturbingAcceleration(
+                    sunGravitationalParameter, sunPosition, position );
+
+        const Eigen::Vector3d computedVelocity = computedStateDerivative.segment( 6 * i, 3 );
+        const Eigen::Vector3d expectedVelocity = states.segment( 6 * i + 3, 3 );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( computedVelocity, expectedVelocity,
+                                           std::numeric_limits< double >::epsilon( ) );
+
+        const Eigen::Vector3d computedAcceleration
+                = computedStateDerivative.segment( 6 * i + 3, 3 );
+        TUDAT_CHECK_MATRIX_BASE( computedAcceleration, expectedAcceleration )
+                BOOST_CHECK_SMALL( computedAcceleration.coeff( row, col )
+                                   - expectedAcceleration.coeff( row, col ),
+                                   1.0E-14 * expectedAcceleration.norm( ) );
+    }
+}
+
+//! Test whether rotation of central body is correctly accounted for in J2 acceleration.
+BOOST_AUTO_TEST_CASE( testMultiBodyStateDerivativeWithCentralBodyRotation )
+{
+    using namespace gravitation;
+    using state_derivative_models::MultiBodyCartesianStateDerivativeModel;
+
+    const double gravitationalParameter = 3.986004418E14;
+    const double equatorialRadius = 6378136.6;
+    const double j2Coefficient = 1.0826E-3;
+    const double currentTime = 1.5E3;
+
+    // Set positions of a set of spacecraft.
+    Eigen::Matrix3Xd positions( 3, 4 );
+    positions << 7.0E6, -2.1E6, 1.0E6, 4.3E6,
+            1.2E6, 6.6E6, -1.0E6, 4.3E6,
+            -0.3E6, 1.8E6, 7.4E6, 4.3E6;
+
+    MultiBodyCartesianStateDerivativeModel multiBodyModel(
+                positions.cols( ), gravitationalParameter, equatorialRadius, j2Coefficient );
+    multiBodyModel.setCentralBodyRotationFunction( &getTestRotation );
+    multiBodyModel.updateEnvironment( currentTime );
+
+    const Eigen::Matrix3Xd computedAccelerations
+            = multiBodyModel.computeAccelerations( positions );
+
+    // Compute expected accelerations in body-fixed frame, and rotate back to inertial frame.
+    const Eigen::Quaterniond rotationToBodyFixedFrame = getTestRotation( currentTime );
+    for ( int i = 0; i < positions.cols( ); i++ )
+    {
+        const Eigen::Vector3d bodyFixedPosition = rotationToBodyFixedFrame * positions.col( i );
+        CentralJ2GravitationalAccelerationModel bodyFixedAcceleration(
+                    boost::lambda::constant( bodyFixedPosition ), gravitationalParameter,
+                    equatorialRadius, j2Coefficient );
+
+        const Eigen::Vector3d expectedAcceleration
+                = rotationToBodyFixedFrame.inverse( ) * bodyFixedAcceleration.getAcceleration( );
+        const Eigen::Vector3d computedAcceleration = computedAccelerations.col( i );
+
+        TUDAT_CHECK_MATRIX_BASE( computedAcceleration, expectedAcceleration )
+                BOOST_CHECK_SMALL( computedAcceleration.coeff( row, col )
+                                   - expectedAcceleration.coeff( row, col ),
+                                   1.0E-14 * expectedAcceleration.norm( ) );
+    }
+}
+
+//! Test whether inconsistent state sizes are rejected.
+BOOST_AUTO_TEST_CASE( testMultiBodyStateDerivativeStateSizeCheck )
+{
+    using state_derivative_models::MultiBodyCartesianStateDerivativeModel;
+
+    MultiBodyCartesianStateDerivativeModel multiBodyModel( 3, 3.986004418E14 );
+    bool isExceptionThrown = false;
+    try
+    {
+        multiBodyModel.computeStateDerivative( 0.0, Eigen::VectorXd::Ones( 12 ) );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown = true;
+    }
+    BOOST_CHECK( isExceptionThrown );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
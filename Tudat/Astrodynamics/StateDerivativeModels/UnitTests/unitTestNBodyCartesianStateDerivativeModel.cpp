@@ -0,0 +1,142 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      Unit test created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+#include "Tudat/Mathematics/NumericalIntegrators/rungeKutta4Integrator.h"
+
+#include "Tudat/Astrodynamics/Gravitation/nBodyGravityModel.h"
+#include "Tudat/Astrodynamics/StateDerivativeModels/nBodyCartesianStateDerivativeModel.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_n_body_cartesian_state_derivative_model )
+
+//! Test propagation of binary on circular orbit, with both acceleration methods.
+BOOST_AUTO_TEST_CASE( testNBodyStateDerivativeBinaryPropagation )
+{
+    using namespace gravitation;
+    using namespace state_derivative_models;
+
+    // Set binary of unequal masses on circular orbit about barycenter.
+    const double firstGravitationalParameter = 3.0;
+    const double secondGravitationalParameter = 1.0;
+    const double separation = 2.0;
+    const double totalGravitationalParameter
+            = firstGravitationalParameter + secondGravitationalParameter;
+    const double angularVelocity = std::sqrt( totalGravitationalParameter
+                                              / ( separation * separation * separation ) );
+    const double orbitalPeriod = 2.0 * mathematical_constants::PI / angularVelocity;
+
+    const double firstRadius = separation * secondGravitationalParameter
+            / totalGravitationalParameter;
+    const double secondRadius = separation - firstRadius;
+
+    Eigen::VectorXd initialState = Eigen::VectorXd::Zero( 12 );
+    initialState( 0 ) = -firstRadius;
+    initialState( 4 ) = -firstRadius * angularVelocity;
+    initialState( 6 ) = secondRadius;
+    initialState( 10 ) = secondRadius * angularVelocity;
+
+    const NBodyAccelerationMethod methods[ 2 ] = { directSummation, barnesHutTree };
+    for ( int k = 0; k < 2; k++ )
+    {
+        NBodyCartesianStateDerivativeModel stateDerivativeModel(
+                    boost::make_shared< NBodyGravitationalAccelerationEngine >(
+                        ( Eigen::VectorXd( 2 ) << firstGravitationalParameter,
+                          secondGravitationalParameter ).finished( ), methods[ k ] ) );
+        BOOST_CHECK_EQUAL( stateDerivativeModel.getAccelerationEngine( )->getMethod( ),
+                           methods[ k ] );
+
+        // Propagate over one orbital period.
+        numerical_integrators::RungeKutta4IntegratorXd integrator(
+                    boost::bind( &NBodyCartesianStateDerivativeModel::computeStateDerivative,
+                                 &stateDerivativeModel, _1, _2 ),
+                    0.0, initialState );
+        const Eigen::VectorXd finalState = integrator.integrateTo( orbitalPeriod,
+                                                                   orbitalPeriod / 1000.0 );
+
+        // Check that final state equals initial state.
+        for ( int i = 0; i < 12; i++ )
+        {
+            BOOST_CHECK_SMALL( finalState( i ) - initialState( i ), 1.0E-8 );
+        }
+
+        // Check conservation of linear momentum.
+        const Eigen::Vector3d finalMomentum
+                = firstGravitationalParameter * finalState.segment( 3, 3 )
+                + secondGravitationalParameter * finalState.segment( 9, 3 );
+        BOOST_CHECK_SMALL( finalMomentum.norm( ), 1.0E-14 );
+    }
+}
+
+//! Test whether inconsistent state sizes are rejected.
+BOOST_AUTO_TEST_CASE( testNBodyStateDerivativeStateSizeCheck )
+{
+    using namespace gravitation;
+    using namespace state_derivative_models;
+
+    NBodyCartesianStateDerivativeModel stateDerivativeModel(
+                boost::make_shared< NBodyGravitationalAccelerationEngine >(
+                    Eigen::VectorXd::Ones( 3 ) ) );
+    bool isExceptionThrown = false;
+    try
+    {
+        stateDerivativeModel.computeStateDerivative( 0.0, Eigen::VectorXd::Ones( 12 ) );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown = true;
+    }
+    BOOST_CHECK( isExceptionThrown );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,134 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include "Tudat/Astrodynamics/StateDerivativeModels/cartesianStateBuffers.h"
+
+namespace tudat
+{
+namespace state_derivative_models
+{
+
+//! Constructor.
+CartesianStateBuffers::CartesianStateBuffers( const int numberOfBodies )
+    : numberOfBodies( numberOfBodies )
+{
+    if ( numberOfBodies < 1 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, state buffers require at least one body." ) ) );
+    }
+
+    // Allocate structure-of-arrays buffers once.
+    xPositions.resize( numberOfBodies );
+    yPositions.resize( numberOfBodies );
+    zPositions.resize( numberOfBodies );
+    xAccelerations.resize( numberOfBodies );
+    yAccelerations.resize( numberOfBodies );
+    zAccelerations.resize( numberOfBodies );
+}
+
+//! Gather positions from concatenated state vector.
+void CartesianStateBuffers::gatherPositions( const Eigen::VectorXd& state )
+{
+    if ( state.rows( ) != 6 * numberOfBodies )
+    {
+        std::stringstream errorMessage;
+        errorMessage << "Error, expected concatenated state of " << numberOfBodies
+                     << " bodies of size " << 6 * numberOfBodies
+                     << ", but received state of size " << state.rows( ) << "." << std::endl;
+        boost::throw_exception( boost::enable_error_info( std::runtime_error(
+                                                              errorMessage.str( ) ) ) );
+    }
+
+    for ( int i = 0; i < numberOfBodies; i++ )
+    {
+        xPositions( i ) = state( 6 * i );
+        yPositions( i ) = state( 6 * i + 1 );
+        zPositions( i ) = state( 6 * i + 2 );
+    }
+}
+
+//! Gather positions from matrix of positions.
+void CartesianStateBuffers::gatherPositions( const Eigen::Matrix3Xd& positions )
+{
+    if ( positions.cols( ) != numberOfBodies )
+    {
+        std::stringstream errorMessage;
+        errorMessage << "Error, expected positions of " << numberOfBodies
+                     << " bodies, but received " << positions.cols( ) << " positions."
+                     << std::endl;
+        boost::throw_exception( boost::enable_error_info( std::runtime_error(
+                                                              errorMessage.str( ) ) ) );
+    }
+
+    xPositions = positions.row( 0 ).transpose( ).array( );
+    yPositions = positions.row( 1 ).transpose( ).array( );
+    zPositions = positions.row( 2 ).transpose( ).array( );
+}
+
+//! Scatter velocities and accelerations into state derivative.
+Eigen::VectorXd CartesianStateBuffers::scatterStateDerivative(
+        const Eigen::VectorXd& state ) const
+{
+    Eigen::VectorXd stateDerivative( 6 * numberOfBodies );
+    for ( int i = 0; i < numberOfBodies; i++ )
+    {
+        stateDerivative.segment( 6 * i, 3 ) = state.segment( 6 * i + 3, 3 );
+        stateDerivative( 6 * i + 3 ) = xAccelerations( i );
+        stateDerivative( 6 * i + 4 ) = yAccelerations( i );
+        stateDerivative( 6 * i + 5 ) = zAccelerations( i );
+    }
+
+    return stateDerivative;
+}
+
+//! Get accelerations as matrix.
+Eigen::Matrix3Xd CartesianStateBuffers::getAccelerations( ) const
+{
+    Eigen::Matrix3Xd accelerations( 3, numberOfBodies );
+    accelerations.row( 0 ) = xAccelerations.matrix( ).transpose( );
+    accelerations.row( 1 ) = yAccelerations.matrix( ).transpose( );
+    accelerations.row( 2 ) = zAccelerations.matrix( ).transpose( );
+    return accelerations;
+}
+
+} // namespace state_derivative_models
+} // namespace tudat
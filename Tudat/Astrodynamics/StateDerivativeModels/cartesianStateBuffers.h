@@ -0,0 +1,125 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *
+ *    References
+ *
+ *    Notes
+ *      The concatenated state vector of multiple bodies is [r_0, v_0, r_1, v_1, ...], as
+ *      propagated by the MultiBodyCartesianStateDerivativeModel and
+ *      NBodyCartesianStateDerivativeModel.
+ *
+ */
+
+#ifndef TUDAT_CARTESIAN_STATE_BUFFERS_H
+#define TUDAT_CARTESIAN_STATE_BUFFERS_H
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+namespace state_derivative_models
+{
+
+//! Structure-of-arrays buffers for positions and accelerations of multiple bodies.
+/*!
+ * Structure containing separate x-, y- and z-arrays for the positions and accelerations of
+ * multiple bodies, such that accelerations can be computed with (vectorizable) Eigen array
+ * expressions. The buffers are allocated once, and filled from and written to the concatenated
+ * Cartesian state vector of all bodies.
+ */
+struct CartesianStateBuffers
+{
+    //! Constructor.
+    /*!
+     * Constructor, allocates buffers for the given number of bodies. An exception is thrown if
+     * the number of bodies is smaller than one.
+     * \param numberOfBodies Number of bodies.
+     */
+    CartesianStateBuffers( const int numberOfBodies );
+
+    //! Gather positions from concatenated state vector.
+    /*!
+     * Copies the positions of all bodies from the concatenated Cartesian state vector into the
+     * position buffers. An exception is thrown if the size of the state is not six times the
+     * number of bodies.
+     * \param state Concatenated Cartesian states of all bodies.
+     */
+    void gatherPositions( const Eigen::VectorXd& state );
+
+    //! Gather positions from matrix of positions.
+    /*!
+     * Copies the positions of all bodies into the position buffers. An exception is thrown if
+     * the number of positions does not match the number of bodies.
+     * \param positions Positions of all bodies, each column containing the position of a single
+     *          body.
+     */
+    void gatherPositions( const Eigen::Matrix3Xd& positions );
+
+    //! Scatter velocities and accelerations into state derivative.
+    /*!
+     * Creates the concatenated Cartesian state derivative of all bodies from the velocities in
+     * the state and the accelerations in the acceleration buffers.
+     * \param state Concatenated Cartesian states of all bodies.
+     * \return Concatenated Cartesian state derivatives of all bodies.
+     */
+    Eigen::VectorXd scatterStateDerivative( const Eigen::VectorXd& state ) const;
+
+    //! Get accelerations as matrix.
+    /*!
+     * Returns the accelerations in the acceleration buffers.
+     * \return Accelerations of all bodies, each column containing the acceleration of a single
+     *          body.
+     */
+    Eigen::Matrix3Xd getAccelerations( ) const;
+
+    //! Number of bodies.
+    int numberOfBodies;
+
+    //! Buffer for x-positions of all bodies.
+    Eigen::ArrayXd xPositions;
+
+    //! Buffer for y-positions of all bodies.
+    Eigen::ArrayXd yPositions;
+
+    //! Buffer for z-positions of all bodies.
+    Eigen::ArrayXd zPositions;
+
+    //! Buffer for x-accelerations of all bodies.
+    Eigen::ArrayXd xAccelerations;
+
+    //! Buffer for y-accelerations of all bodies.
+    Eigen::ArrayXd yAccelerations;
+
+    //! Buffer for z-accelerations of all bodies.
+    Eigen::ArrayXd zAccelerations;
+};
+
+} // namespace state_derivative_models
+} // namespace tudat
+
+#endif // TUDAT_CARTESIAN_STATE_BUFFERS_H
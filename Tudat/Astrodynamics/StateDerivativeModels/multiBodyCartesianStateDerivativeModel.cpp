@@ -0,0 +1,189 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Use shared structure-of-arrays state buffers.
+ *
+ *    References
+ *      Montenbruck, O., Gill, E. Satellite Orbits, Corrected Third Printing, Springer, 2005.
+ *
+ *    Notes
+ *
+ */
+
+#include "Tudat/Astrodynamics/StateDerivativeModels/multiBodyCartesianStateDerivativeModel.h"
+
+namespace tudat
+{
+namespace state_derivative_models
+{
+
+//! Constructor.
+MultiBodyCartesianStateDerivativeModel::MultiBodyCartesianStateDerivativeModel(
+        const int numberOfBodies,
+        const double centralBodyGravitationalParameter,
+        const double centralBodyEquatorialRadius,
+        const double centralBodyJ2Coefficient )
+    : numberOfBodies_( numberOfBodies ),
+      centralBodyGravitationalParameter_( centralBodyGravitationalParameter ),
+      centralBodyEquatorialRadius_( centralBodyEquatorialRadius ),
+      centralBodyJ2Coefficient_( centralBodyJ2Coefficient ),
+      currentRotationAxis_( Eigen::Vector3d::UnitZ( ) ),
+      stateBuffers_( numberOfBodies )
+{ }
+
+//! Add third body to environment.
+void MultiBodyCartesianStateDerivativeModel::addThirdBody(
+        const double gravitationalParameter, const PositionFunction positionFunction )
+{
+    thirdBodyGravitationalParameters_.push_back( gravitationalParameter );
+    thirdBodyPositionFunctions_.push_back( positionFunction );
+    currentThirdBodyPositions_.push_back( Eigen::Vector3d::Zero( ) );
+    currentCentralBodyAccelerations_.push_back( Eigen::Vector3d::Zero( ) );
+}
+
+//! Update environment.
+void MultiBodyCartesianStateDerivativeModel::updateEnvironment( const double time )
+{
+    // Evaluate third-body positions, and acceleration they exert on central body.
+    for ( unsigned int i = 0; i < thirdBodyPositionFunctions_.size( ); i++ )
+    {
+        currentThirdBodyPositions_[ i ] = thirdBodyPositionFunctions_[ i ]( time );
+
+        const double distanceToCentralBody = currentThirdBodyPositions_[ i ].norm( );
+        currentCentralBodyAccelerations_[ i ] = thirdBodyGravitationalParameters_[ i ]
+                * currentThirdBodyPositions_[ i ]
+                / ( distanceToCentralBody * distanceToCentralBody * distanceToCentralBody );
+    }
+
+    // Evaluate rotation axis of central body (z-axis of body-fixed frame in inertial frame).
+    if ( !rotationFunction_.empty( ) )
+    {
+        currentRotationAxis_ = rotationFunction_( time ).inverse( ) * Eigen::Vector3d::UnitZ( );
+    }
+}
+
+//! Compute state derivative.
+Eigen::VectorXd MultiBodyCartesianStateDerivativeModel::computeStateDerivative(
+        const double time, const Eigen::VectorXd& state )
+{
+    // Evaluate shared environment once for all bodies.
+    updateEnvironment( time );
+
+    // Gather positions into structure-of-arrays buffers.
+    stateBuffers_.gatherPositions( state );
+
+    computeAccelerationsFromBuffers( );
+
+    // Scatter velocities and accelerations into state derivative.
+    return stateBuffers_.scatterStateDerivative( state );
+}
+
+//! Compute accelerations of all bodies.
+Eigen::Matrix3Xd MultiBodyCartesianStateDerivativeModel::computeAccelerations(
+        const Eigen::Matrix3Xd& positions )
+{
+    stateBuffers_.gatherPositions( positions );
+    computeAccelerationsFromBuffers( );
+    return stateBuffers_.getAccelerations( );
+}
+
+//! Compute accelerations of all bodies from positions in structure-of-arrays buffers.
+void MultiBodyCartesianStateDerivativeModel::computeAccelerationsFromBuffers( )
+{
+    const Eigen::ArrayXd& xPositions = stateBuffers_.xPositions;
+    const Eigen::ArrayXd& yPositions = stateBuffers_.yPositions;
+    const Eigen::ArrayXd& zPositions = stateBuffers_.zPositions;
+    Eigen::ArrayXd& xAccelerations = stateBuffers_.xAccelerations;
+    Eigen::ArrayXd& yAccelerations = stateBuffers_.yAccelerations;
+    Eigen::ArrayXd& zAccelerations = stateBuffers_.zAccelerations;
+
+    // Compute inverse radius and its powers, shared by central and J2 terms.
+    const Eigen::ArrayXd inverseRadius = ( xPositions.square( ) + yPositions.square( )
+                                           + zPositions.square( ) ).sqrt( ).inverse( );
+    const Eigen::ArrayXd inverseRadiusSquared = inverseRadius.square( );
+
+    // Compute central gravitational acceleration.
+    Eigen::ArrayXd radialFactor
+            = -centralBodyGravitationalParameter_ * inverseRadiusSquared * inverseRadius;
+
+    // Add J2 acceleration, if required.
+    if ( centralBodyJ2Coefficient_ != 0.0 )
+    {
+        // Compute normalized projection of position on rotation axis.
+        const Eigen::ArrayXd scaledAxialCoordinate
+                = ( currentRotationAxis_.x( ) * xPositions
+                    + currentRotationAxis_.y( ) * yPositions
+                    + currentRotationAxis_.z( ) * zPositions ) * inverseRadius;
+
+        // Compute J2 pre-multiplier: -3/2 mu J2 R^2 / r^5.
+        const Eigen::ArrayXd j2PreMultiplier
+                = -1.5 * centralBodyGravitationalParameter_ * centralBodyJ2Coefficient_
+                * centralBodyEquatorialRadius_ * centralBodyEquatorialRadius_
+                * inverseRadiusSquared * inverseRadiusSquared * inverseRadius;
+
+        radialFactor += j2PreMultiplier * ( 1.0 - 5.0 * scaledAxialCoordinate.square( ) );
+
+        // Compute term along rotation axis.
+        const Eigen::ArrayXd axialFactor
+                = 2.0 * j2PreMultiplier * scaledAxialCoordinate / inverseRadius;
+
+        xAccelerations = radialFactor * xPositions + axialFactor * currentRotationAxis_.x( );
+        yAccelerations = radialFactor * yPositions + axialFactor * currentRotationAxis_.y( );
+        zAccelerations = radialFactor * zPositions + axialFactor * currentRotationAxis_.z( );
+    }
+    else
+    {
+        xAccelerations = radialFactor * xPositions;
+        yAccelerations = radialFactor * yPositions;
+        zAccelerations = radialFactor * zPositions;
+    }
+
+    // Add third-body perturbations.
+    for ( unsigned int i = 0; i < currentThirdBodyPositions_.size( ); i++ )
+    {
+        const Eigen::Vector3d& thirdBodyPosition = currentThirdBodyPositions_[ i ];
+        const Eigen::ArrayXd xRelativePositions = thirdBodyPosition.x( ) - xPositions;
+        const Eigen::ArrayXd yRelativePositions = thirdBodyPosition.y( ) - yPositions;
+        const Eigen::ArrayXd zRelativePositions = thirdBodyPosition.z( ) - zPositions;
+
+        const Eigen::ArrayXd inverseDistance
+                = ( xRelativePositions.square( ) + yRelativePositions.square( )
+                    + zRelativePositions.square( ) ).sqrt( ).inverse( );
+        const Eigen::ArrayXd directFactor
+                = thirdBodyGravitationalParameters_[ i ] * inverseDistance.cube( );
+
+        xAccelerations += directFactor * xRelativePositions
+                - currentCentralBodyAccelerations_[ i ].x( );
+        yAccelerations += directFactor * yRelativePositions
+                - currentCentralBodyAccelerations_[ i ].y( );
+        zAccelerations += directFactor * zRelativePositions
+                - currentCentralBodyAccelerations_[ i ].z( );
+    }
+}
+
+} // namespace state_derivative_models
+} // namespace tudat
@@ -0,0 +1,233 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Use shared structure-of-arrays state buffers.
+ *
+ *    References
+ *      Montenbruck, O., Gill, E. Satellite Orbits, Corrected Third Printing, Springer, 2005.
+ *
+ *    Notes
+ *      The state vector that is propagated by the MultiBodyCartesianStateDerivativeModel is the
+ *      concatenation of the Cartesian states of all bodies, i.e. [r_0, v_0, r_1, v_1, ...]. This
+ *      allows it to be used directly with the numerical integrators in Tudat. Internally, the
+ *      positions are copied to structure-of-arrays buffers, so that the per-body acceleration
+ *      loops are expressed as Eigen array expressions, which the compiler can vectorize.
+ *
+ */
+
+#ifndef TUDAT_MULTI_BODY_CARTESIAN_STATE_DERIVATIVE_MODEL_H
+#define TUDAT_MULTI_BODY_CARTESIAN_STATE_DERIVATIVE_MODEL_H
+
+#include <vector>
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "Tudat/Astrodynamics/StateDerivativeModels/cartesianStateBuffers.h"
+#include "Tudat/Astrodynamics/StateDerivativeModels/stateDerivativeModel.h"
+
+namespace tudat
+{
+namespace state_derivative_models
+{
+
+//! Multi-body Cartesian state derivative model class.
+/*!
+ * This class computes the Cartesian state derivative of a set of bodies (e.g., the spacecraft in
+ * a constellation or formation) that all move in the same environment, but do not attract each
+ * other. The environment consists of a central body, with a point-mass and (optional) J2
+ * gravity field, and any number of third (point-mass) bodies. The environment (positions of the
+ * third bodies and orientation of the central body) is evaluated only once per call to
+ * computeStateDerivative(), after which the accelerations of all bodies are computed in a
+ * single structure-of-arrays loop per acceleration type. The accelerations are expressed in an
+ * inertial frame centered on the central body (Montenbruck & Gill, 2005):
+ * \f{eqnarray*}{
+ *      \bar{a}_{central} &=& -\frac{\mu}{r^{3}}\bar{r} \\
+ *      \bar{a}_{J2} &=& -\frac{3}{2}\frac{\mu J_{2} R^{2}}{r^{4}}\left[ ( 1 - 5\hat{z}^{2} )
+ *                       \hat{r} + 2\hat{z}\hat{k} \right] \\
+ *      \bar{a}_{3rd} &=& \mu_{p}\left[ \frac{\bar{\rho}_{p} - \bar{r}}
+ *                       {| \bar{\rho}_{p} - \bar{r} |^{3}}
+ *                       - \frac{\bar{\rho}_{p}}{\rho_{p}^{3}} \right]
+ * \f}
+ * where \f$\hat{k}\f$ is the (inertial) unit vector along the rotation axis of the central body,
+ * \f$\hat{z} = \hat{r}\cdot\hat{k}\f$ and \f$\bar{\rho}_{p}\f$ is the position of perturbing
+ * body p w.r.t. the central body.
+ */
+class MultiBodyCartesianStateDerivativeModel
+        : public StateDerivativeModel< double, Eigen::VectorXd >
+{
+public:
+
+    //! Typedef for function returning position of a body as a function of time.
+    typedef boost::function< Eigen::Vector3d( const double ) > PositionFunction;
+
+    //! Typedef for function returning rotation from inertial to body-fixed frame.
+    typedef boost::function< Eigen::Quaterniond( const double ) > RotationFunction;
+
+    //! Constructor.
+    /*!
+     * Constructor, sets the number of bodies that is propagated and the properties of the central
+     * body. If no J2-coefficient (or equatorial radius) is provided, only the point-mass
+     * acceleration of the central body is computed.
+     * \param numberOfBodies Number of bodies of which the state is propagated.
+     * \param centralBodyGravitationalParameter Gravitational parameter of central body
+     *          [m^3 s^-2].
+     * \param centralBodyEquatorialRadius Equatorial radius of central body, used as reference
+     *          radius for J2-coefficient [m] (default = 0.0).
+     * \param centralBodyJ2Coefficient Unnormalized J2-coefficient of central body [-]
+     *          (default = 0.0).
+     */
+    MultiBodyCartesianStateDerivativeModel( const int numberOfBodies,
+                                            const double centralBodyGravitationalParameter,
+                                            const double centralBodyEquatorialRadius = 0.0,
+                                            const double centralBodyJ2Coefficient = 0.0 );
+
+    //! Add third body to environment.
+    /*!
+     * Adds a third (point-mass) body to the environment, which exerts a perturbing acceleration
+     * on all bodies. The position function of the third body is called once per call to
+     * computeStateDerivative().
+     * \param gravitationalParameter Gravitational parameter of third body [m^3 s^-2].
+     * \param positionFunction Function returning the position of the third body w.r.t. the
+     *          central body, in the inertial frame in which the states are propagated, as a
+     *          function of time.
+     */
+    void addThirdBody( const double gravitationalParameter,
+                       const PositionFunction positionFunction );
+
+    //! Set rotation model of central body.
+    /*!
+     * Sets function returning the rotation from the inertial frame to the frame fixed to the
+     * central body. This is used to determine the direction of the rotation axis of the central
+     * body for the J2 acceleration, which is evaluated once per call to
+     * computeStateDerivative(). If no rotation function is set, the rotation axis is assumed to
+     * be along the z-axis of the inertial frame.
+     * \param rotationFunction Function returning rotation from inertial to body-fixed frame, as a
+     *          function of time.
+     */
+    void setCentralBodyRotationFunction( const RotationFunction rotationFunction )
+    {
+        rotationFunction_ = rotationFunction;
+    }
+
+    //! Compute state derivative.
+    /*!
+     * Computes the state derivative of all bodies. First, the environment is evaluated at the
+     * current time, after which the accelerations of all bodies are computed.
+     * \param time Current time.
+     * \param state Concatenated Cartesian states of all bodies; the size must be six times the
+     *          number of bodies.
+     * \return Concatenated Cartesian state derivatives of all bodies.
+     */
+    Eigen::VectorXd computeStateDerivative( const double time, const Eigen::VectorXd& state );
+
+    //! Compute accelerations of all bodies.
+    /*!
+     * Computes the accelerations of all bodies, using the environment as evaluated during the
+     * last call to updateEnvironment().
+     * \param positions Positions of all bodies, each column containing the position of a single
+     *          body.
+     * \return Accelerations of all bodies, each column containing the acceleration of a single
+     *          body.
+     */
+    Eigen::Matrix3Xd computeAccelerations( const Eigen::Matrix3Xd& positions );
+
+    //! Update environment.
+    /*!
+     * Evaluates the positions of all third bodies and the orientation of the central body at the
+     * given time, and stores the quantities that are shared by all bodies.
+     * \param time Time at which environment is to be evaluated.
+     */
+    void updateEnvironment( const double time );
+
+    //! Get number of bodies.
+    /*!
+     * Returns the number of bodies of which the state is propagated.
+     * \return Number of bodies.
+     */
+    int getNumberOfBodies( ) { return numberOfBodies_; }
+
+protected:
+
+private:
+
+    //! Compute accelerations of all bodies from positions in structure-of-arrays buffers.
+    /*!
+     * Computes the accelerations of all bodies from the positions stored in the x-, y- and
+     * z-position buffers, and stores the result in the acceleration buffers.
+     */
+    void computeAccelerationsFromBuffers( );
+
+    //! Number of bodies of which the state is propagated.
+    const int numberOfBodies_;
+
+    //! Gravitational parameter of central body [m^3 s^-2].
+    const double centralBodyGravitationalParameter_;
+
+    //! Equatorial radius of central body [m].
+    const double centralBodyEquatorialRadius_;
+
+    //! J2-coefficient of central body [-].
+    const double centralBodyJ2Coefficient_;
+
+    //! Gravitational parameters of third bodies [m^3 s^-2].
+    std::vector< double > thirdBodyGravitationalParameters_;
+
+    //! Position functions of third bodies.
+    std::vector< PositionFunction > thirdBodyPositionFunctions_;
+
+    //! Function returning rotation from inertial to central body-fixed frame.
+    RotationFunction rotationFunction_;
+
+    //! Current positions of third bodies w.r.t. central body, as set by updateEnvironment().
+    std::vector< Eigen::Vector3d > currentThirdBodyPositions_;
+
+    //! Current (indirect) accelerations of central body due to third bodies.
+    /*!
+     * Current accelerations of central body due to third bodies, i.e. the term that is shared by
+     * all bodies in the third-body perturbation, as set by updateEnvironment().
+     */
+    std::vector< Eigen::Vector3d > currentCentralBodyAccelerations_;
+
+    //! Current rotation axis of central body, in inertial frame.
+    Eigen::Vector3d currentRotationAxis_;
+
+    //! Structure-of-arrays buffers for positions and accelerations of all bodies.
+    CartesianStateBuffers stateBuffers_;
+};
+
+//! Typedef for shared-pointer to MultiBodyCartesianStateDerivativeModel.
+typedef boost::shared_ptr< MultiBodyCartesianStateDerivativeModel >
+MultiBodyCartesianStateDerivativeModelPointer;
+
+} // namespace state_derivative_models
+} // namespace tudat
+
+#endif // TUDAT_MULTI_BODY_CARTESIAN_STATE_DERIVATIVE_MODEL_H
@@ -24,13 +24,45 @@
  *
  *    Changelog
  *      YYMMDD    Author            Comment
- *      120823    K. Kumar          File created.
+ *      261018                      File created.
+ *      261018                      Use shared structure-of-arrays state buffers.
  *
  *    References
  *
  *    Notes
- *      This file is necessary to ensure that the StateDerivativeModels directory appears in the Qt
- *      Creator project tree. It can be removed once a source file (.cpp) is added to the
- *      directory.
  *
  */
+
+#include "Tudat/Astrodynamics/StateDerivativeModels/nBodyCartesianStateDerivativeModel.h"
+
+namespace tudat
+{
+namespace state_derivative_models
+{
+
+//! Constructor.
+NBodyCartesianStateDerivativeModel::NBodyCartesianStateDerivativeModel(
+        const gravitation::NBodyGravitationalAccelerationEnginePointer accelerationEngine )
+    : accelerationEngine_( accelerationEngine ),
+      numberOfBodies_( accelerationEngine->getNumberOfBodies( ) ),
+      stateBuffers_( numberOfBodies_ )
+{ }
+
+//! Compute state derivative.
+Eigen::VectorXd NBodyCartesianStateDerivativeModel::computeStateDerivative(
+        const double time, const Eigen::VectorXd& state )
+{
+    // Gather positions into structure-of-arrays buffers.
+    stateBuffers_.gatherPositions( state );
+
+    accelerationEngine_->computeAccelerations(
+                stateBuffers_.xPositions, stateBuffers_.yPositions, stateBuffers_.zPositions,
+                stateBuffers_.xAccelerations, stateBuffers_.yAccelerations,
+                stateBuffers_.zAccelerations );
+
+    // Scatter velocities and accelerations into state derivative.
+    return stateBuffers_.scatterStateDerivative( state );
+}
+
+} // namespace state_derivative_models
+} // namespace tudat
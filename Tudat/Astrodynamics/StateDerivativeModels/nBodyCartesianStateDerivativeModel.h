@@ -0,0 +1,118 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Use shared structure-of-arrays state buffers.
+ *
+ *    References
+ *
+ *    Notes
+ *      The state vector that is propagated by the NBodyCartesianStateDerivativeModel is the
+ *      concatenation of the Cartesian states of all bodies, i.e. [r_0, v_0, r_1, v_1, ...], such
+ *      that it can be used directly with the numerical integrators in Tudat.
+ *
+ */
+
+#ifndef TUDAT_N_BODY_CARTESIAN_STATE_DERIVATIVE_MODEL_H
+#define TUDAT_N_BODY_CARTESIAN_STATE_DERIVATIVE_MODEL_H
+
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Astrodynamics/Gravitation/nBodyGravityModel.h"
+#include "Tudat/Astrodynamics/StateDerivativeModels/cartesianStateBuffers.h"
+#include "Tudat/Astrodynamics/StateDerivativeModels/stateDerivativeModel.h"
+
+namespace tudat
+{
+namespace state_derivative_models
+{
+
+//! N-body Cartesian state derivative model class.
+/*!
+ * This class computes the Cartesian state derivative of a set of mutually attracting (point-mass)
+ * bodies, e.g., the fragments of a debris cloud or the members of an asteroid swarm. The positions
+ * are copied to structure-of-arrays buffers, after which the accelerations are computed by an
+ * NBodyGravitationalAccelerationEngine, using either direct summation or the Barnes-Hut method.
+ */
+class NBodyCartesianStateDerivativeModel
+        : public StateDerivativeModel< double, Eigen::VectorXd >
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, sets the engine with which the mutual accelerations of the bodies are
+     * computed.
+     * \param accelerationEngine Engine with which mutual accelerations are computed; this also
+     *          defines the number of bodies.
+     */
+    NBodyCartesianStateDerivativeModel(
+            const gravitation::NBodyGravitationalAccelerationEnginePointer accelerationEngine );
+
+    //! Compute state derivative.
+    /*!
+     * Computes the state derivative of all bodies.
+     * \param time Current time.
+     * \param state Concatenated Cartesian states of all bodies; the size must be six times the
+     *          number of bodies.
+     * \return Concatenated Cartesian state derivatives of all bodies.
+     */
+    Eigen::VectorXd computeStateDerivative( const double time, const Eigen::VectorXd& state );
+
+    //! Get engine with which mutual accelerations are computed.
+    /*!
+     * Returns the engine with which the mutual accelerations of the bodies are computed.
+     * \return Engine with which mutual accelerations are computed.
+     */
+    gravitation::NBodyGravitationalAccelerationEnginePointer getAccelerationEngine( )
+    {
+        return accelerationEngine_;
+    }
+
+protected:
+
+private:
+
+    //! Engine with which mutual accelerations are computed.
+    const gravitation::NBodyGravitationalAccelerationEnginePointer accelerationEngine_;
+
+    //! Number of bodies of which the state is propagated.
+    const int numberOfBodies_;
+
+    //! Structure-of-arrays buffers for positions and accelerations of all bodies.
+    CartesianStateBuffers stateBuffers_;
+};
+
+//! Typedef for shared-pointer to NBodyCartesianStateDerivativeModel.
+typedef boost::shared_ptr< NBodyCartesianStateDerivativeModel >
+NBodyCartesianStateDerivativeModelPointer;
+
+} // namespace state_derivative_models
+} // namespace tudat
+
+#endif // TUDAT_N_BODY_CARTESIAN_STATE_DERIVATIVE_MODEL_H
@@ -0,0 +1,342 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      Unit test created.
+ *      261018                      Added tests of invalid degree/order and stale cache files.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include <boost/filesystem.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Basics/testMacros.h"
+#include "Tudat/InputOutput/basicInputOutput.h"
+#include "Tudat/InputOutput/gravityFieldCoefficientsReader.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Get path of test gravity field file.
+std::string getTestGravityFieldFilePath( const std::string& fileName )
+{
+    return input_output::getTudatRootPath( ) + "/InputOutput/UnitTests/" + fileName;
+}
+
+BOOST_AUTO_TEST_SUITE( test_gravity_field_coefficients_reader )
+
+//! Test reading of ICGEM file, including truncation.
+BOOST_AUTO_TEST_CASE( testIcgemGravityFieldReader )
+{
+    using namespace input_output;
+
+    const GravityFieldCoefficients coefficients = readIcgemGravityFieldFile(
+                getTestGravityFieldFilePath( "testGravityField.gfc" ) );
+
+    BOOST_CHECK_EQUAL( coefficients.getMaximumDegree( ), 4 );
+    BOOST_CHECK_EQUAL( coefficients.getMaximumOrder( ), 4 );
+    BOOST_CHECK_CLOSE_FRACTION( coefficients.gravitationalParameter, 0.3986004415E+15,
+                                std::numeric_limits< double >::epsilon( ) );
+    BOOST_CHECK_CLOSE_FRACTION( coefficients.referenceRadius, 0.63781363E+07,
+                                std::numeric_limits< double >::epsilon( ) );
+    BOOST_CHECK_EQUAL( coefficients.cosineCoefficients( 0, 0 ), 1.0 );
+    BOOST_CHECK_CLOSE_FRACTION( coefficients.cosineCoefficients( 2, 0 ),
+                                -0.484165143790815E-03,
+                                std::numeric_limits< double >::epsilon( ) );
+    BOOST_CHECK_CLOSE_FRACTION( coefficients.sineCoefficients( 3, 3 ), 0.141434926192941E-05,
+                                std::numeric_limits< double >::epsilon( ) );
+    BOOST_CHECK_CLOSE_FRACTION( coefficients.cosineCoefficients( 4, 4 ),
+                                -0.188519633023033E-06,
+                                std::numeric_limits< double >::epsilon( ) );
+
+    // Read truncated coefficients, and compare with complete set of coefficients.
+    const GravityFieldCoefficients truncatedCoefficients = readIcgemGravityFieldFile(
+                getTestGravityFieldFilePath( "testGravityField.gfc" ), 3, 2 );
+    BOOST_CHECK_EQUAL( truncatedCoefficients.cosineCoefficients.rows( ), 4 );
+    BOOST_CHECK_EQUAL( truncatedCoefficients.cosineCoefficients.cols( ), 3 );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                truncatedCoefficients.cosineCoefficients,
+                Eigen::MatrixXd( coefficients.cosineCoefficients.topLeftCorner( 4, 3 ) ),
+                std::numeric_limits< double >::epsilon( ) );
+    TUDAT_CHECK_MATRIX_CLOSE_FRACTION(
+                truncatedCoefficients.sineCoefficients,
+                Eigen::MatrixXd( coefficients.sineCoefficients.topLeftCorner( 4, 3 ) ),
+                std::numeric_limits< double >::epsilon( ) );
+}
+
+//! Test reading of (unnormalized) SHADR file.
+BOOST_AUTO_TEST_CASE( testShadrGravityFieldReader )
+{
+    using namespace input_output;
+
+    const GravityFieldCoefficients coefficients = readShadrGravityFieldFile(
+                getTestGravityFieldFilePath( "testGravityField.shadr" ) );
+
+    // Check conversion of units from km to m.
+    BOOST_CHECK_EQUAL( coefficients.getMaximumDegree( ), 3 );
+    BOOST_CHECK_CLOSE_FRACTION( coefficients.gravitationalParameter, 4.9028001224453001E12,
+                                std::numeric_limits< double >::epsilon( ) );
+    BOOST_CHECK_CLOSE_FRACTION( coefficients.referenceRadius, 1.738E6,
+                                std::numeric_limits< double >::epsilon( ) );
+
+    // Check missing degree-zero term and normalization of coefficients, using closed-form
+    // normalization factors.
+    BOOST_CHECK_EQUAL( coefficients.cosineCoefficients( 0, 0 ), 1.0 );
+    BOOST_CHECK_CLOSE_FRACTION( coefficients.cosineCoefficients( 2, 0 ),
+                                -2.0321568464952570E-04 / std::sqrt( 5.0 ),
+                                4.0 * std::numeric_limits< double >::epsilon( ) );
+    BOOST_CHECK_CLOSE_FRACTION( coefficients.cosineCoefficients( 2, 2 ),
+                                2.2358E-05 / std::sqrt( 5.0 / 12.0 ),
+                                4.0 * std::numeric_limits< double >::epsilon( ) );
+    BOOST_CHECK_CLOSE_FRACTION( coefficients.sineCoefficients( 3, 1 ),
+                                5.89E-06 / std::sqrt( 7.0 / 6.0 ),
+                                4.0 * std::numeric_limits< double >::epsilon( ) );
+    BOOST_CHECK_CLOSE_FRACTION( coefficients.sineCoefficients( 3, 3 ),
+                                -2.48E-07 / std::sqrt( 7.0 / 360.0 ),
+                                4.0 * std::numeric_limits< double >::epsilon( ) );
+}
+
+//! Test writing and memory-mapping of binary cache file.
+BOOST_AUTO_TEST_CASE( testGravityFieldCacheFile )
+{
+    using namespace input_output;
+
+    const boost::filesystem::path temporaryDirectory
+            = boost::filesystem::temp_directory_path( ) / boost::filesystem::unique_path( );
+    boost::filesystem::create_directories( temporaryDirectory );
+
+    // Test direct writing and mapping of cache file.
+    {
+        const GravityFieldCoefficients coefficients = readIcgemGravityFieldFile(
+                    getTestGravityFieldFilePath( "testGravityField.gfc" ) );
+        const std::string cacheFileName = ( temporaryDirectory / "direct.bin" ).string( );
+        writeGravityFieldCoefficientsCacheFile( coefficients, cacheFileName );
+
+        const MappedGravityFieldCoefficients mappedCoefficients( cacheFileName );
+        BOOST_CHECK_EQUAL( mappedCoefficients.getMaximumDegree( ), 4 );
+        BOOST_CHECK_EQUAL( mappedCoefficients.getMaximumOrder( ), 4 );
+        BOOST_CHECK_EQUAL( mappedCoefficients.getGravitationalParameter( ),
+                           coefficients.gravitationalParameter );
+        BOOST_CHECK_EQUAL( mappedCoefficients.getReferenceRadius( ),
+                           coefficients.referenceRadius );
+        BOOST_CHECK( mappedCoefficients.getCosineCoefficients( )
+                     == coefficients.cosineCoefficients );
+        BOOST_CHECK( mappedCoefficients.getSineCoefficients( )
+                     == coefficients.sineCoefficients );
+
+        const GravityFieldCoefficients truncatedCoefficients
+                = mappedCoefficients.getCoefficients( 2, 1 );
+        BOOST_CHECK( truncatedCoefficients.cosineCoefficients
+                     == coefficients.cosineCoefficients.topLeftCorner( 3, 2 ) );
+        BOOST_CHECK( truncatedCoefficients.sineCoefficients
+                     == coefficients.sineCoefficients.topLeftCorner( 3, 2 ) );
+    }
+
+    // Test loading of coefficients through cache file.
+    {
+        const std::string cacheFileName = ( temporaryDirectory / "loaded.bin" ).string( );
+        const GravityFieldCoefficients expectedCoefficients = readShadrGravityFieldFile(
+                    getTestGravityFieldFilePath( "testGravityField.shadr" ), 3, 2 );
+
+        // First call parses text file, and creates cache file.
+        BOOST_CHECK( !boost::filesystem::exists( cacheFileName ) );
+        const GravityFieldCoefficients parsedCoefficients = loadGravityFieldCoefficients(
+                    getTestGravityFieldFilePath( "testGravityField.shadr" ),
+                    shadrGravityFieldFormat, 3, 2, cacheFileName );
+        BOOST_CHECK( boost::filesystem::exists( cacheFileName ) );
+
+        // Second call reads cache file.
+        const GravityFieldCoefficients cachedCoefficients = loadGravityFieldCoefficients(
+                    getTestGravityFieldFilePath( "testGravityField.shadr" ),
+                    shadrGravityFieldFormat, 3, 2, cacheFileName );
+
+        BOOST_CHECK( parsedCoefficients.cosineCoefficients
+                     == expectedCoefficients.cosineCoefficients );
+        BOOST_CHECK( parsedCoefficients.sineCoefficients
+                     == expectedCoefficients.sineCoefficients );
+        BOOST_CHECK( cachedCoefficients.cosineCoefficients
+                     == expectedCoefficients.cosineCoefficients );
+        BOOST_CHECK( cachedCoefficients.sineCoefficients
+                     == expectedCoefficients.sineCoefficients );
+        BOOST_CHECK_EQUAL( cachedCoefficients.gravitationalParameter,
+                           expectedCoefficients.gravitationalParameter );
+        BOOST_CHECK_EQUAL( cachedCoefficients.referenceRadius,
+                           expectedCoefficients.referenceRadius );
+
+        // Check that complete field, and size of text file, are stored in cache file.
+        BOOST_CHECK_EQUAL( MappedGravityFieldCoefficients( cacheFileName ).getMaximumDegree( ),
+                           3 );
+        BOOST_CHECK_EQUAL( MappedGravityFieldCoefficients( cacheFileName ).getSourceFileSize( ),
+                           boost::filesystem::file_size(
+                               getTestGravityFieldFilePath( "testGravityField.shadr" ) ) );
+    }
+
+    // Test that cache file is rewritten if text file has changed, but is not newer.
+    {
+        const std::string fileName = ( temporaryDirectory / "changed.shadr" ).string( );
+        const std::string cacheFileName = fileName + ".bin";
+        {
+            std::ofstream file( fileName.c_str( ) );
+            file << "1738.0, 4902.8, 0.0, 2, 2, 1\n"
+                 << "2, 0, -1.0E-04, 0.0, 0.0, 0.0\n";
+        }
+        BOOST_CHECK_EQUAL( loadGravityFieldCoefficients(
+                               fileName, shadrGravityFieldFormat ).getMaximumDegree( ), 2 );
+
+        // Change degree of text file, and reset its modification time to that of cache file.
+        {
+            std::ofstream file( fileName.c_str( ) );
+            file << "1738.0, 4902.8, 0.0, 3, 3, 1\n"
+                 << "2, 0, -1.0E-04, 0.0, 0.0, 0.0\n"
+                 << "3, 0, -1.0E-05, 0.0, 0.0, 0.0\n";
+        }
+        boost::filesystem::last_write_time(
+                    fileName, boost::filesystem::last_write_time( cacheFileName ) );
+
+        const GravityFieldCoefficients reloadedCoefficients = loadGravityFieldCoefficients(
+                    fileName, shadrGravityFieldFormat );
+        BOOST_CHECK_EQUAL( reloadedCoefficients.getMaximumDegree( ), 3 );
+        BOOST_CHECK_EQUAL( reloadedCoefficients.cosineCoefficients( 3, 0 ), -1.0E-05 );
+        BOOST_CHECK_EQUAL( MappedGravityFieldCoefficients( cacheFileName ).getMaximumDegree( ),
+                           3 );
+    }
+
+    boost::filesystem::remove_all( temporaryDirectory );
+}
+
+//! Test whether invalid requests and files are rejected.
+BOOST_AUTO_TEST_CASE( testGravityFieldReaderErrors )
+{
+    using namespace input_output;
+
+    // Test request of degree that is not available in file.
+    bool isExceptionThrown = false;
+    try
+    {
+        readIcgemGravityFieldFile( getTestGravityFieldFilePath( "testGravityField.gfc" ), 5 );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown = true;
+    }
+    BOOST_CHECK( isExceptionThrown );
+
+    // Test reading of file that is not an ICGEM file.
+    isExceptionThrown = false;
+    try
+    {
+        readIcgemGravityFieldFile( getTestGravityFieldFilePath( "testGravityField.shadr" ) );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown = true;
+    }
+    BOOST_CHECK( isExceptionThrown );
+
+    // Test reading of files with invalid degree or order.
+    const boost::filesystem::path temporaryDirectory
+            = boost::filesystem::temp_directory_path( ) / boost::filesystem::unique_path( );
+    boost::filesystem::create_directories( temporaryDirectory );
+    const std::string invalidRecords[ 4 ] =
+    { "2, 3, 1.0E-06, 0.0, 0.0, 0.0", "-2, 0, 1.0E-06, 0.0, 0.0, 0.0",
+      "2x, 0, 1.0E-06, 0.0, 0.0, 0.0", "2, , 1.0E-06, 0.0, 0.0, 0.0" };
+    for ( unsigned int i = 0; i < 4; i++ )
+    {
+        const std::string fileName = ( temporaryDirectory / "invalid.shadr" ).string( );
+        {
+            std::ofstream file( fileName.c_str( ) );
+            file << "1738.0, 4902.8, 0.0, 3, 3, 1\n" << invalidRecords[ i ] << "\n";
+        }
+
+        isExceptionThrown = false;
+        try
+        {
+            readShadrGravityFieldFile( fileName );
+        }
+        catch( std::runtime_error& error )
+        {
+            isExceptionThrown = true;
+            BOOST_CHECK( std::string( error.what( ) ).find( invalidRecords[ i ] )
+                         != std::string::npos );
+        }
+        BOOST_CHECK( isExceptionThrown );
+    }
+
+    // Test reading of file with header in which order exceeds degree.
+    {
+        const std::string fileName = ( temporaryDirectory / "invalidHeader.shadr" ).string( );
+        {
+            std::ofstream file( fileName.c_str( ) );
+            file << "1738.0, 4902.8, 0.0, 2, 3, 1\n";
+        }
+
+        isExceptionThrown = false;
+        try
+        {
+            readShadrGravityFieldFile( fileName );
+        }
+        catch( std::runtime_error& )
+        {
+            isExceptionThrown = true;
+        }
+        BOOST_CHECK( isExceptionThrown );
+    }
+    boost::filesystem::remove_all( temporaryDirectory );
+
+    // Test mapping of file that is not a cache file.
+    isExceptionThrown = false;
+    try
+    {
+        MappedGravityFieldCoefficients mappedCoefficients(
+                    getTestGravityFieldFilePath( "testGravityField.gfc" ) );
+    }
+    catch( std::runtime_error& )
+    {
+        isExceptionThrown = true;
+    }
+    BOOST_CHECK( isExceptionThrown );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
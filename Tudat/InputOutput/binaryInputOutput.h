@@ -0,0 +1,143 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *
+ *    References
+ *
+ *    Notes
+ *      Values are written in the native binary representation of the machine. Streams written by
+ *      these functions can therefore only be read on machines with the same endianness and
+ *      floating-point format, which is the case for all platforms currently supported by Tudat.
+ *      Streams should be opened in binary mode (std::ios::binary).
+ *
+ */
+
+#ifndef TUDAT_BINARY_INPUT_OUTPUT_H
+#define TUDAT_BINARY_INPUT_OUTPUT_H
+
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/exception/all.hpp>
+
+namespace tudat
+{
+namespace input_output
+{
+
+//! Write value to binary stream.
+/*!
+ * Writes value of plain-old-data type to stream in its binary representation.
+ * \tparam ValueType Type of value (e.g., double or boost::uint64_t).
+ * \param stream Stream to which value is written.
+ * \param value Value to write.
+ */
+template< typename ValueType >
+void writeValueToBinaryStream( std::ostream& stream, const ValueType& value )
+{
+    stream.write( reinterpret_cast< const char* >( &value ), sizeof( ValueType ) );
+    if ( !stream )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error, could not write value to binary stream." ) ) );
+    }
+}
+
+//! Read value from binary stream.
+/*!
+ * Reads value of plain-old-data type from stream, as written by writeValueToBinaryStream( ).
+ * \tparam ValueType Type of value (e.g., double or boost::uint64_t).
+ * \param stream Stream from which value is read.
+ * \return Value read from stream.
+ */
+template< typename ValueType >
+ValueType readValueFromBinaryStream( std::istream& stream )
+{
+    ValueType value;
+    stream.read( reinterpret_cast< char* >( &value ), sizeof( ValueType ) );
+    if ( !stream )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error, could not read value from binary stream." ) ) );
+    }
+    return value;
+}
+
+//! Write vector to binary stream.
+/*!
+ * Writes size of vector (as 64-bit unsigned integer), followed by its entries, to stream in
+ * binary representation.
+ * \tparam ValueType Type of entries of vector (plain-old-data type).
+ * \param stream Stream to which vector is written.
+ * \param vector Vector to write.
+ */
+template< typename ValueType >
+void writeVectorToBinaryStream( std::ostream& stream, const std::vector< ValueType >& vector )
+{
+    writeValueToBinaryStream( stream, static_cast< boost::uint64_t >( vector.size( ) ) );
+    if ( !vector.empty( ) )
+    {
+        stream.write( reinterpret_cast< const char* >( &vector[ 0 ] ),
+                      vector.size( ) * sizeof( ValueType ) );
+    }
+    if ( !stream )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error, could not write vector to binary stream." ) ) );
+    }
+}
+
+//! Read vector from binary stream.
+/*!
+ * Reads vector from stream, as written by writeVectorToBinaryStream( ).
+ * \tparam ValueType Type of entries of vector (plain-old-data type).
+ * \param stream Stream from which vector is read.
+ * \return Vector read from stream.
+ */
+template< typename ValueType >
+std::vector< ValueType > readVectorFromBinaryStream( std::istream& stream )
+{
+    const boost::uint64_t vectorSize = readValueFromBinaryStream< boost::uint64_t >( stream );
+
+    std::vector< ValueType > vector;
+    for ( boost::uint64_t i = 0; i < vectorSize; i++ )
+    {
+        vector.push_back( readValueFromBinaryStream< ValueType >( stream ) );
+    }
+    return vector;
+}
+
+} // namespace input_output
+} // namespace tudat
+
+#endif // TUDAT_BINARY_INPUT_OUTPUT_H
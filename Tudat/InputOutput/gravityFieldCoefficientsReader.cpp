@@ -0,0 +1,609 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Validate degree and order fields; check source file size and
+ *                                  degree/order in cache header before reuse.
+ *      261018                      Moved declarations of helper functions to header file.
+ *
+ *    References
+ *      Barthelmes, F., Foerste, C. The ICGEM-format, GFZ Potsdam, Department 1 "Geodesy and
+ *          Remote Sensing", 2011.
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/exception/all.hpp>
+#include <boost/filesystem.hpp>
+#include <boost/format.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "Tudat/InputOutput/gravityFieldCoefficientsReader.h"
+
+namespace tudat
+{
+namespace input_output
+{
+
+//! Throw runtime error with given message.
+void throwGravityFieldFileError( const std::string& errorMessage )
+{
+    boost::throw_exception( boost::enable_error_info( std::runtime_error( errorMessage ) ) );
+}
+
+//! Determine and check degree and order to which coefficients are to be truncated.
+void getTruncationDegreeAndOrder( const int requestedMaximumDegree,
+                                  const int requestedMaximumOrder,
+                                  const int availableMaximumDegree,
+                                  const int availableMaximumOrder,
+                                  int& maximumDegree, int& maximumOrder )
+{
+    maximumDegree = ( requestedMaximumDegree < 0 ) ? availableMaximumDegree
+                                                   : requestedMaximumDegree;
+    maximumOrder = ( requestedMaximumOrder < 0 )
+            ? std::min( maximumDegree, availableMaximumOrder ) : requestedMaximumOrder;
+
+    if ( maximumDegree > availableMaximumDegree || maximumOrder > availableMaximumOrder )
+    {
+        throwGravityFieldFileError(
+                    boost::str( boost::format( "Error, requested gravity field degree/order %1%/%2%"
+                                               " exceeds available degree/order %3%/%4%." )
+                                % maximumDegree % maximumOrder % availableMaximumDegree
+                                % availableMaximumOrder ) );
+    }
+
+    if ( maximumOrder > maximumDegree )
+    {
+        throwGravityFieldFileError(
+                    boost::str( boost::format( "Error, requested gravity field order %1% exceeds "
+                                               "requested degree %2%." )
+                                % maximumOrder % maximumDegree ) );
+    }
+}
+
+//! Compute geodesy normalization factor of spherical harmonic coefficient.
+double computeGeodesyNormalizationFactor( const int degree, const int order )
+{
+    return std::sqrt( ( order == 0 ? 1.0 : 2.0 ) * ( 2.0 * degree + 1.0 )
+                      * std::exp( std::lgamma( degree - order + 1.0 )
+                                  - std::lgamma( degree + order + 1.0 ) ) );
+}
+
+//! Convert unnormalized coefficients to geodesy-normalized coefficients.
+void normalizeGravityFieldCoefficients( GravityFieldCoefficients& coefficients )
+{
+    for ( int degree = 0; degree < coefficients.cosineCoefficients.rows( ); degree++ )
+    {
+        for ( int order = 0; order <= std::min< int >(
+                  degree, coefficients.cosineCoefficients.cols( ) - 1 ); order++ )
+        {
+            const double normalizationFactor = computeGeodesyNormalizationFactor( degree, order );
+            coefficients.cosineCoefficients( degree, order ) /= normalizationFactor;
+            coefficients.sineCoefficients( degree, order ) /= normalizationFactor;
+        }
+    }
+}
+
+//! Parse floating-point number, allowing Fortran-style exponents.
+double parseGravityFieldFileNumber( std::string numberString )
+{
+    std::replace( numberString.begin( ), numberString.end( ), 'D', 'E' );
+    std::replace( numberString.begin( ), numberString.end( ), 'd', 'e' );
+
+    char* endOfNumber;
+    const double number = std::strtod( numberString.c_str( ), &endOfNumber );
+    if ( endOfNumber == numberString.c_str( ) || *endOfNumber != '\0' )
+    {
+        throwGravityFieldFileError( "Error, could not parse number '" + numberString
+                                    + "' in gravity field file." );
+    }
+    return number;
+}
+
+//! Parse integer field of gravity field file.
+int parseGravityFieldFileInteger( const std::string& integerString, const std::string& line,
+                                  const std::string& fileName )
+{
+    int integer = 0;
+    try
+    {
+        integer = boost::lexical_cast< int >( integerString );
+    }
+    catch( boost::bad_lexical_cast& )
+    {
+        throwGravityFieldFileError( "Error, could not parse integer '" + integerString
+                                    + "' in line '" + line + "' of gravity field file '"
+                                    + fileName + "'." );
+    }
+    return integer;
+}
+
+//! Check degree and order read from gravity field file.
+void checkGravityFieldFileDegreeAndOrder( const int degree, const int order,
+                                          const std::string& line, const std::string& fileName )
+{
+    if ( degree < 0 || order < 0 || order > degree )
+    {
+        throwGravityFieldFileError(
+                    boost::str( boost::format( "Error, invalid degree/order %1%/%2% in line '%3%' "
+                                               "of gravity field file '%4%'." )
+                                % degree % order % line % fileName ) );
+    }
+}
+
+//! Open gravity field text file.
+void openGravityFieldFile( const std::string& fileName, std::ifstream& file )
+{
+    file.open( fileName.c_str( ) );
+    if ( file.fail( ) )
+    {
+        throwGravityFieldFileError( "Error, gravity field file '" + fileName
+                                    + "' could not be opened." );
+    }
+}
+
+//! Read header of ICGEM (.gfc) file.
+void readIcgemGravityFieldFileHeader( std::ifstream& file, const std::string& fileName,
+                                      GravityFieldCoefficients& coefficients,
+                                      int& fileMaximumDegree, bool& isFileNormalized )
+{
+    fileMaximumDegree = -1;
+    isFileNormalized = true;
+    bool isEndOfHeaderFound = false;
+    std::string line;
+    std::string keyword;
+    std::string value;
+    while ( std::getline( file, line ) )
+    {
+        std::istringstream lineStream( line );
+        if ( !( lineStream >> keyword ) )
+        {
+            continue;
+        }
+
+        if ( keyword == "end_of_head" )
+        {
+            isEndOfHeaderFound = true;
+            break;
+        }
+
+        lineStream >> value;
+        if ( keyword == "earth_gravity_constant" || keyword == "gravity_constant" )
+        {
+            coefficients.gravitationalParameter = parseGravityFieldFileNumber( value );
+        }
+        else if ( keyword == "radius" )
+        {
+            coefficients.referenceRadius = parseGravityFieldFileNumber( value );
+        }
+        else if ( keyword == "max_degree" )
+        {
+            fileMaximumDegree = parseGravityFieldFileInteger( value, line, fileName );
+            checkGravityFieldFileDegreeAndOrder( fileMaximumDegree, 0, line, fileName );
+        }
+        else if ( keyword == "norm" )
+        {
+            isFileNormalized = ( value != "unnormalized" );
+        }
+    }
+
+    if ( !isEndOfHeaderFound || fileMaximumDegree < 0 )
+    {
+        throwGravityFieldFileError( "Error, no valid ICGEM header (including max_degree and "
+                                    "end_of_head keywords) found in file '" + fileName + "'." );
+    }
+}
+
+//! Read gravity field coefficients from ICGEM (.gfc) file.
+GravityFieldCoefficients readIcgemGravityFieldFile( const std::string& fileName,
+                                                    const int maximumDegree,
+                                                    const int maximumOrder )
+{
+    std::ifstream file;
+    openGravityFieldFile( fileName, file );
+
+    // Read header.
+    GravityFieldCoefficients coefficients;
+    int fileMaximumDegree;
+    bool isFileNormalized;
+    readIcgemGravityFieldFileHeader( file, fileName, coefficients, fileMaximumDegree,
+                                     isFileNormalized );
+
+    int usedMaximumDegree, usedMaximumOrder;
+    getTruncationDegreeAndOrder( maximumDegree, maximumOrder, fileMaximumDegree,
+                                 fileMaximumDegree, usedMaximumDegree, usedMaximumOrder );
+    coefficients.cosineCoefficients
+            = Eigen::MatrixXd::Zero( usedMaximumDegree + 1, usedMaximumOrder + 1 );
+    coefficients.sineCoefficients
+            = Eigen::MatrixXd::Zero( usedMaximumDegree + 1, usedMaximumOrder + 1 );
+
+    // Read coefficients.
+    std::string line;
+    std::vector< std::string > lineSplit;
+    while ( std::getline( file, line ) )
+    {
+        boost::algorithm::trim( line );
+        if ( line.empty( ) )
+        {
+            continue;
+        }
+
+        boost::algorithm::split( lineSplit, line, boost::is_any_of( " \t" ),
+                                 boost::algorithm::token_compress_on );
+        if ( lineSplit[ 0 ] != "gfc" && lineSplit[ 0 ] != "gfct" )
+        {
+            continue;
+        }
+
+        if ( lineSplit.size( ) < 5 )
+        {
+            throwGravityFieldFileError( "Error, incomplete record '" + line
+                                        + "' in ICGEM file '" + fileName + "'." );
+        }
+
+        const int degree = parseGravityFieldFileInteger( lineSplit[ 1 ], line, fileName );
+        const int order = parseGravityFieldFileInteger( lineSplit[ 2 ], line, fileName );
+        checkGravityFieldFileDegreeAndOrder( degree, order, line, fileName );
+        if ( degree <= usedMaximumDegree && order <= usedMaximumOrder )
+        {
+            coefficients.cosineCoefficients( degree, order )
+                    = parseGravityFieldFileNumber( lineSplit[ 3 ] );
+            coefficients.sineCoefficients( degree, order )
+                    = parseGravityFieldFileNumber( lineSplit[ 4 ] );
+        }
+    }
+
+    if ( !isFileNormalized )
+    {
+        normalizeGravityFieldCoefficients( coefficients );
+    }
+
+    return coefficients;
+}
+
+//! Read header record of SHADR file.
+void readShadrGravityFieldFileHeader( std::ifstream& file, const std::string& fileName,
+                                      GravityFieldCoefficients& coefficients,
+                                      int& fileMaximumDegree, int& fileMaximumOrder,
+                                      bool& isFileNormalized )
+{
+    std::string line;
+    std::vector< std::string > lineSplit;
+    std::getline( file, line );
+    boost::algorithm::trim( line );
+    boost::algorithm::split( lineSplit, line, boost::is_any_of( ", \t" ),
+                             boost::algorithm::token_compress_on );
+    if ( lineSplit.size( ) < 6 )
+    {
+        throwGravityFieldFileError( "Error, no valid SHADR header record found in file '"
+                                    + fileName + "'." );
+    }
+
+    // Convert reference radius and gravitational parameter from km to m.
+    coefficients.referenceRadius = 1.0E3 * parseGravityFieldFileNumber( lineSplit[ 0 ] );
+    coefficients.gravitationalParameter = 1.0E9 * parseGravityFieldFileNumber( lineSplit[ 1 ] );
+    fileMaximumDegree = parseGravityFieldFileInteger( lineSplit[ 3 ], line, fileName );
+    fileMaximumOrder = parseGravityFieldFileInteger( lineSplit[ 4 ], line, fileName );
+    checkGravityFieldFileDegreeAndOrder( fileMaximumDegree, fileMaximumOrder, line, fileName );
+    isFileNormalized = ( parseGravityFieldFileInteger( lineSplit[ 5 ], line, fileName ) == 1 );
+}
+
+//! Read gravity field coefficients from SHADR file.
+GravityFieldCoefficients readShadrGravityFieldFile( const std::string& fileName,
+                                                    const int maximumDegree,
+                                                    const int maximumOrder )
+{
+    std::ifstream file;
+    openGravityFieldFile( fileName, file );
+
+    // Read header record.
+    GravityFieldCoefficients coefficients;
+    int fileMaximumDegree, fileMaximumOrder;
+    bool isFileNormalized;
+    readShadrGravityFieldFileHeader( file, fileName, coefficients, fileMaximumDegree,
+                                     fileMaximumOrder, isFileNormalized );
+
+    int usedMaximumDegree, usedMaximumOrder;
+    getTruncationDegreeAndOrder( maximumDegree, maximumOrder, fileMaximumDegree,
+                                 fileMaximumOrder, usedMaximumDegree, usedMaximumOrder );
+    coefficients.cosineCoefficients
+            = Eigen::MatrixXd::Zero( usedMaximumDegree + 1, usedMaximumOrder + 1 );
+    coefficients.sineCoefficients
+            = Eigen::MatrixXd::Zero( usedMaximumDegree + 1, usedMaximumOrder + 1 );
+    coefficients.cosineCoefficients( 0, 0 ) = 1.0;
+
+    // Read coefficient records.
+    std::string line;
+    std::vector< std::string > lineSplit;
+    while ( std::getline( file, line ) )
+    {
+        boost::algorithm::trim( line );
+        if ( line.empty( ) )
+        {
+            continue;
+        }
+
+        boost::algorithm::split( lineSplit, line, boost::is_any_of( ", \t" ),
+                                 boost::algorithm::token_compress_on );
+        if ( lineSplit.size( ) < 4 )
+        {
+            throwGravityFieldFileError( "Error, incomplete record '" + line
+                                        + "' in SHADR file '" + fileName + "'." );
+        }
+
+        const int degree = parseGravityFieldFileInteger( lineSplit[ 0 ], line, fileName );
+        const int order = parseGravityFieldFileInteger( lineSplit[ 1 ], line, fileName );
+        checkGravityFieldFileDegreeAndOrder( degree, order, line, fileName );
+        if ( degree <= usedMaximumDegree && order <= usedMaximumOrder )
+        {
+            coefficients.cosineCoefficients( degree, order )
+                    = parseGravityFieldFileNumber( lineSplit[ 2 ] );
+            coefficients.sineCoefficients( degree, order )
+                    = parseGravityFieldFileNumber( lineSplit[ 3 ] );
+        }
+    }
+
+    if ( !isFileNormalized )
+    {
+        normalizeGravityFieldCoefficients( coefficients );
+    }
+
+    return coefficients;
+}
+
+//! Write gravity field coefficients to binary cache file.
+void writeGravityFieldCoefficientsCacheFile( const GravityFieldCoefficients& coefficients,
+                                             const std::string& cacheFileName,
+                                             const boost::uintmax_t sourceFileSize )
+{
+    if ( coefficients.cosineCoefficients.rows( ) != coefficients.sineCoefficients.rows( )
+         || coefficients.cosineCoefficients.cols( ) != coefficients.sineCoefficients.cols( ) )
+    {
+        throwGravityFieldFileError( "Error, sizes of cosine and sine coefficient matrices are "
+                                    "inconsistent when writing gravity field cache file." );
+    }
+
+    GravityFieldCacheFileHeader header;
+    std::memcpy( header.fileIdentifier, gravityFieldCacheFileIdentifier,
+                 sizeof( header.fileIdentifier ) );
+    header.byteOrderMarker = gravityFieldCacheByteOrderMarker;
+    header.fileFormatVersion = gravityFieldCacheFileFormatVersion;
+    header.maximumDegree = coefficients.getMaximumDegree( );
+    header.maximumOrder = coefficients.getMaximumOrder( );
+    header.gravitationalParameter = coefficients.gravitationalParameter;
+    header.referenceRadius = coefficients.referenceRadius;
+    header.sourceFileSize = sourceFileSize;
+
+    // Write to temporary file first, and rename it afterwards, so that other processes never map
+    // an incomplete cache file.
+    const boost::filesystem::path cacheFilePath( cacheFileName );
+    const boost::filesystem::path temporaryFilePath
+            = cacheFilePath.string( ) + "." + boost::filesystem::unique_path( ).string( );
+    {
+        std::ofstream cacheFile( temporaryFilePath.string( ).c_str( ),
+                                 std::ios::out | std::ios::binary );
+        if ( cacheFile.fail( ) )
+        {
+            throwGravityFieldFileError( "Error, gravity field cache file '" + cacheFileName
+                                        + "' could not be opened for writing." );
+        }
+
+        const std::streamsize matrixSize = static_cast< std::streamsize >(
+                    coefficients.cosineCoefficients.size( ) * sizeof( double ) );
+        cacheFile.write( reinterpret_cast< const char* >( &header ), sizeof( header ) );
+        cacheFile.write( reinterpret_cast< const char* >(
+                             coefficients.cosineCoefficients.data( ) ), matrixSize );
+        cacheFile.write( reinterpret_cast< const char* >(
+                             coefficients.sineCoefficients.data( ) ), matrixSize );
+        if ( cacheFile.fail( ) )
+        {
+            throwGravityFieldFileError( "Error, could not write gravity field cache file '"
+                                        + cacheFileName + "'." );
+        }
+    }
+    boost::filesystem::rename( temporaryFilePath, cacheFilePath );
+}
+
+//! Constructor.
+MappedGravityFieldCoefficients::MappedGravityFieldCoefficients( const std::string& cacheFileName )
+    : fileMapping_( cacheFileName.c_str( ), boost::interprocess::read_only ),
+      mappedRegion_( fileMapping_, boost::interprocess::read_only )
+{
+    if ( mappedRegion_.get_size( ) < sizeof( GravityFieldCacheFileHeader ) )
+    {
+        throwGravityFieldFileError( "Error, gravity field cache file '" + cacheFileName
+                                    + "' is too small." );
+    }
+
+    // Check header.
+    const char* mappedData = static_cast< const char* >( mappedRegion_.get_address( ) );
+    GravityFieldCacheFileHeader header;
+    std::memcpy( &header, mappedData, sizeof( header ) );
+
+    if ( std::memcmp( header.fileIdentifier, gravityFieldCacheFileIdentifier,
+                      sizeof( header.fileIdentifier ) ) != 0
+         || header.byteOrderMarker != gravityFieldCacheByteOrderMarker
+         || header.fileFormatVersion != gravityFieldCacheFileFormatVersion )
+    {
+        throwGravityFieldFileError( "Error, file '" + cacheFileName + "' is not a gravity field "
+                                    "cache file of the current format and byte order." );
+    }
+
+    maximumDegree_ = header.maximumDegree;
+    maximumOrder_ = header.maximumOrder;
+    gravitationalParameter_ = header.gravitationalParameter;
+    referenceRadius_ = header.referenceRadius;
+    sourceFileSize_ = header.sourceFileSize;
+
+    const std::size_t numberOfCoefficients = static_cast< std::size_t >( maximumDegree_ + 1 )
+            * static_cast< std::size_t >( maximumOrder_ + 1 );
+    if ( maximumDegree_ < 0 || maximumOrder_ < 0 || mappedRegion_.get_size( )
+         != sizeof( header ) + 2 * numberOfCoefficients * sizeof( double ) )
+    {
+        throwGravityFieldFileError( "Error, size of gravity field cache file '" + cacheFileName
+                                    + "' is inconsistent with its header." );
+    }
+
+    cosineCoefficientsData_ = reinterpret_cast< const double* >( mappedData + sizeof( header ) );
+    sineCoefficientsData_ = cosineCoefficientsData_ + numberOfCoefficients;
+}
+
+//! Get (truncated) copy of coefficients.
+GravityFieldCoefficients MappedGravityFieldCoefficients::getCoefficients(
+        const int maximumDegree, const int maximumOrder ) const
+{
+    int usedMaximumDegree, usedMaximumOrder;
+    getTruncationDegreeAndOrder( maximumDegree, maximumOrder, maximumDegree_, maximumOrder_,
+                                 usedMaximumDegree, usedMaximumOrder );
+
+    GravityFieldCoefficients coefficients;
+    coefficients.gravitationalParameter = gravitationalParameter_;
+    coefficients.referenceRadius = referenceRadius_;
+    coefficients.cosineCoefficients = getCosineCoefficients( ).topLeftCorner(
+                usedMaximumDegree + 1, usedMaximumOrder + 1 );
+    coefficients.sineCoefficients = getSineCoefficients( ).topLeftCorner(
+                usedMaximumDegree + 1, usedMaximumOrder + 1 );
+    return coefficients;
+}
+
+//! Read maximum degree and order of coefficients in gravity field file.
+void readGravityFieldFileMaximumDegreeAndOrder( const std::string& fileName,
+                                                const GravityFieldFileFormat fileFormat,
+                                                int& fileMaximumDegree, int& fileMaximumOrder )
+{
+    std::ifstream file;
+    openGravityFieldFile( fileName, file );
+
+    GravityFieldCoefficients coefficients;
+    bool isFileNormalized;
+    switch ( fileFormat )
+    {
+    case icgemGravityFieldFormat:
+        readIcgemGravityFieldFileHeader( file, fileName, coefficients, fileMaximumDegree,
+                                         isFileNormalized );
+        fileMaximumOrder = fileMaximumDegree;
+        break;
+    case shadrGravityFieldFormat:
+        readShadrGravityFieldFileHeader( file, fileName, coefficients, fileMaximumDegree,
+                                         fileMaximumOrder, isFileNormalized );
+        break;
+    default:
+        throwGravityFieldFileError( "Error, gravity field file format not recognized." );
+    }
+}
+
+//! Check whether binary cache file can be used instead of gravity field text file.
+bool isGravityFieldCacheFileUpToDate( const std::string& cacheFileName,
+                                      const std::string& fileName,
+                                      const GravityFieldFileFormat fileFormat )
+{
+    if ( boost::filesystem::last_write_time( cacheFileName )
+         < boost::filesystem::last_write_time( fileName ) )
+    {
+        return false;
+    }
+
+    std::ifstream cacheFile( cacheFileName.c_str( ), std::ios::in | std::ios::binary );
+    GravityFieldCacheFileHeader header;
+    cacheFile.read( reinterpret_cast< char* >( &header ), sizeof( header ) );
+    if ( cacheFile.fail( )
+         || std::memcmp( header.fileIdentifier, gravityFieldCacheFileIdentifier,
+                         sizeof( header.fileIdentifier ) ) != 0
+         || header.byteOrderMarker != gravityFieldCacheByteOrderMarker
+         || header.fileFormatVersion != gravityFieldCacheFileFormatVersion
+         || header.sourceFileSize != boost::filesystem::file_size( fileName ) )
+    {
+        return false;
+    }
+
+    int fileMaximumDegree, fileMaximumOrder;
+    readGravityFieldFileMaximumDegreeAndOrder( fileName, fileFormat, fileMaximumDegree,
+                                               fileMaximumOrder );
+    return ( header.maximumDegree == fileMaximumDegree
+             && header.maximumOrder == fileMaximumOrder );
+}
+
+//! Load gravity field coefficients, using binary cache file.
+GravityFieldCoefficients loadGravityFieldCoefficients( const std::string& fileName,
+                                                       const GravityFieldFileFormat fileFormat,
+                                                       const int maximumDegree,
+                                                       const int maximumOrder,
+                                                       const std::string& cacheFileName )
+{
+    const std::string usedCacheFileName = cacheFileName.empty( ) ? fileName + ".bin"
+                                                                 : cacheFileName;
+
+    // Use cache file, if it is up to date.
+    if ( boost::filesystem::exists( usedCacheFileName )
+         && ( !boost::filesystem::exists( fileName )
+              || isGravityFieldCacheFileUpToDate( usedCacheFileName, fileName, fileFormat ) ) )
+    {
+        return MappedGravityFieldCoefficients( usedCacheFileName ).getCoefficients(
+                    maximumDegree, maximumOrder );
+    }
+
+    // Parse complete text file, and write it to cache file.
+    GravityFieldCoefficients coefficients;
+    switch ( fileFormat )
+    {
+    case icgemGravityFieldFormat:
+        coefficients = readIcgemGravityFieldFile( fileName );
+        break;
+    case shadrGravityFieldFormat:
+        coefficients = readShadrGravityFieldFile( fileName );
+        break;
+    default:
+        throwGravityFieldFileError( "Error, gravity field file format not recognized." );
+    }
+    writeGravityFieldCoefficientsCacheFile( coefficients, usedCacheFileName,
+                                            boost::filesystem::file_size( fileName ) );
+
+    // Truncate coefficients to requested degree and order.
+    int usedMaximumDegree, usedMaximumOrder;
+    getTruncationDegreeAndOrder( maximumDegree, maximumOrder, coefficients.getMaximumDegree( ),
+                                 coefficients.getMaximumOrder( ), usedMaximumDegree,
+                                 usedMaximumOrder );
+    coefficients.cosineCoefficients.conservativeResize( usedMaximumDegree + 1,
+                                                        usedMaximumOrder + 1 );
+    coefficients.sineCoefficients.conservativeResize( usedMaximumDegree + 1,
+                                                      usedMaximumOrder + 1 );
+    return coefficients;
+}
+
+} // namespace input_output
+} // namespace tudat
@@ -0,0 +1,523 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Added size of source file to cache file header.
+ *      261018                      Declared helper functions of gravity field file readers.
+ *
+ *    References
+ *      Barthelmes, F., Foerste, C. The ICGEM-format, GFZ Potsdam, Department 1 "Geodesy and
+ *          Remote Sensing", 2011.
+ *      NASA Planetary Data System, Geosciences Node. SHADR spherical harmonic ASCII data record
+ *          description, e.g. LRO/LOLA and GRAIL gravity data set documentation.
+ *
+ *    Notes
+ *      Parsing a gravity field file of high degree (e.g., EGM2008 up to degree 2190) takes in the
+ *      order of seconds, which is dominated by the text-to-double conversion. For applications
+ *      that repeatedly load the same model, loadGravityFieldCoefficients() converts the text file
+ *      once into a binary cache file, which is subsequently memory-mapped, so that loading the
+ *      coefficients consists only of copying the requested block of coefficients.
+ *
+ *      The binary cache files are written in the native byte order and floating-point
+ *      representation of the machine, and are not intended to be exchanged between platforms. A
+ *      cache file with a different byte order is detected and rejected when it is read.
+ *
+ */
+
+#ifndef TUDAT_GRAVITY_FIELD_COEFFICIENTS_READER_H
+#define TUDAT_GRAVITY_FIELD_COEFFICIENTS_READER_H
+
+#include <fstream>
+#include <string>
+
+#include <boost/cstdint.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+namespace input_output
+{
+
+//! Data structure containing spherical harmonic gravity field coefficients, read from file.
+/*!
+ * Data structure containing spherical harmonic gravity field coefficients, as read from a
+ * gravity field file, together with the associated gravitational parameter and reference radius.
+ * The coefficients are always stored geodesy-normalized, i.e. as required by
+ * SphericalHarmonicsGravityField. Entry (n,m) of the cosine and sine coefficient matrices
+ * contains the coefficient of degree n and order m.
+ */
+struct GravityFieldCoefficients
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor, initializes all scalar members to zero, and the coefficient matrices
+     * to empty matrices.
+     */
+    GravityFieldCoefficients( )
+        : gravitationalParameter( 0.0 ),
+          referenceRadius( 0.0 )
+    { }
+
+    //! Gravitational parameter of the body [m^3 s^-2].
+    double gravitationalParameter;
+
+    //! Reference radius of the spherical harmonic expansion [m].
+    double referenceRadius;
+
+    //! Geodesy-normalized cosine coefficients.
+    Eigen::MatrixXd cosineCoefficients;
+
+    //! Geodesy-normalized sine coefficients.
+    Eigen::MatrixXd sineCoefficients;
+
+    //! Get maximum degree of coefficients.
+    /*!
+     * Returns maximum degree of coefficients.
+     * \return Maximum degree of coefficients.
+     */
+    int getMaximumDegree( ) const { return cosineCoefficients.rows( ) - 1; }
+
+    //! Get maximum order of coefficients.
+    /*!
+     * Returns maximum order of coefficients.
+     * \return Maximum order of coefficients.
+     */
+    int getMaximumOrder( ) const { return cosineCoefficients.cols( ) - 1; }
+};
+
+//! Typedef for shared-pointer to GravityFieldCoefficients object.
+typedef boost::shared_ptr< GravityFieldCoefficients > GravityFieldCoefficientsPointer;
+
+//! Enum of supported gravity field file formats.
+enum GravityFieldFileFormat
+{
+    icgemGravityFieldFormat,
+    shadrGravityFieldFormat
+};
+
+//! Header of binary gravity field cache file.
+/*!
+ * Header of binary gravity field cache file. The size of the header is a multiple of eight
+ * bytes, so that the coefficients that follow it are correctly aligned in mapped memory.
+ */
+struct GravityFieldCacheFileHeader
+{
+    //! Identifier of file type.
+    char fileIdentifier[ 8 ];
+
+    //! Marker to detect byte order of file.
+    boost::uint32_t byteOrderMarker;
+
+    //! Version of file format.
+    boost::uint32_t fileFormatVersion;
+
+    //! Maximum degree of coefficients in file.
+    boost::int32_t maximumDegree;
+
+    //! Maximum order of coefficients in file.
+    boost::int32_t maximumOrder;
+
+    //! Gravitational parameter [m^3 s^-2].
+    double gravitationalParameter;
+
+    //! Reference radius [m].
+    double referenceRadius;
+
+    //! Size of text file from which cache file was written [bytes].
+    boost::uint64_t sourceFileSize;
+};
+
+//! Identifier of binary gravity field cache file.
+const char gravityFieldCacheFileIdentifier[ 8 ] = { 'T', 'U', 'D', 'A', 'T', 'G', 'F', 'C' };
+
+//! Byte order marker of binary gravity field cache file.
+const boost::uint32_t gravityFieldCacheByteOrderMarker = 0x01020304;
+
+//! Version of binary gravity field cache file format.
+const boost::uint32_t gravityFieldCacheFileFormatVersion = 2;
+
+//! Read gravity field coefficients from ICGEM (.gfc) file.
+/*!
+ * Reads gravity field coefficients from a file in the format of the International Centre for
+ * Global Earth Models (ICGEM; Barthelmes & Foerste, 2011). The header is read up to the
+ * end_of_head keyword, from which the earth_gravity_constant, radius, max_degree and norm
+ * keywords are used. Subsequently, all gfc (and the static part of gfct) records with degree and
+ * order up to the requested maximum are stored; time-variable records (trnd, acos, asin) are
+ * ignored. Both 'E' and Fortran-style 'D' exponents are supported. Coefficients that are
+ * provided unnormalized (norm unnormalized) are converted to geodesy-normalized coefficients.
+ * \param fileName Name of the file that is to be read.
+ * \param maximumDegree Maximum degree up to which coefficients are to be read; a negative value
+ *          denotes the maximum degree in the file (default = -1).
+ * \param maximumOrder Maximum order up to which coefficients are to be read; a negative value
+ *          denotes the maximum order that is consistent with the maximum degree (default = -1).
+ * \return Gravity field coefficients, of size ( maximumDegree + 1 ) x ( maximumOrder + 1 ).
+ */
+GravityFieldCoefficients readIcgemGravityFieldFile( const std::string& fileName,
+                                                    const int maximumDegree = -1,
+                                                    const int maximumOrder = -1 );
+
+//! Read gravity field coefficients from SHADR file.
+/*!
+ * Reads gravity field coefficients from a spherical harmonic ASCII data record (SHADR) file, as
+ * used for the planetary gravity fields in the NASA Planetary Data System. The first
+ * (comma-separated) record contains the reference radius [km], gravitational parameter
+ * [km^3 s^-2], its uncertainty, maximum degree and order, and a normalization flag (0:
+ * unnormalized, 1: normalized). Each subsequent record contains degree, order, cosine and sine
+ * coefficient (and their uncertainties). Coefficients that are provided unnormalized are
+ * converted to geodesy-normalized coefficients, and the physical constants are converted to SI
+ * units. Since SHADR files commonly omit the degree-zero term, the (0,0) cosine coefficient is
+ * set to one if it is not provided.
+ * \param fileName Name of the file that is to be read.
+ * \param maximumDegree Maximum degree up to which coefficients are to be read; a negative value
+ *          denotes the maximum degree in the file (default = -1).
+ * \param maximumOrder Maximum order up to which coefficients are to be read; a negative value
+ *          denotes the maximum order that is consistent with the maximum degree (default = -1).
+ * \return Gravity field coefficients, of size ( maximumDegree + 1 ) x ( maximumOrder + 1 ).
+ */
+GravityFieldCoefficients readShadrGravityFieldFile( const std::string& fileName,
+                                                    const int maximumDegree = -1,
+                                                    const int maximumOrder = -1 );
+
+//! Write gravity field coefficients to binary cache file.
+/*!
+ * Writes gravity field coefficients to a binary cache file, which can be memory-mapped by
+ * MappedGravityFieldCoefficients. The file contains a fixed-size header, followed by the
+ * column-major cosine and sine coefficient matrices.
+ * \param coefficients Gravity field coefficients that are to be written.
+ * \param cacheFileName Name of the cache file that is to be written.
+ * \param sourceFileSize Size of the text file from which the coefficients were read, stored in
+ *          the header to detect a changed text file (default = 0).
+ */
+void writeGravityFieldCoefficientsCacheFile( const GravityFieldCoefficients& coefficients,
+                                             const std::string& cacheFileName,
+                                             const boost::uintmax_t sourceFileSize = 0 );
+
+//! Class providing direct access to gravity field coefficients in a memory-mapped cache file.
+/*!
+ * Class that memory-maps a binary gravity field cache file, as written by
+ * writeGravityFieldCoefficientsCacheFile(), and provides the coefficient matrices as Eigen maps
+ * on the mapped memory, so that no parsing or copying is needed to access them. The mapping is
+ * released when the object is destroyed, after which the maps are no longer valid.
+ */
+class MappedGravityFieldCoefficients
+{
+public:
+
+    //! Typedef for map of (read-only) coefficient matrix in mapped memory.
+    typedef Eigen::Map< const Eigen::MatrixXd > CoefficientMatrixMap;
+
+    //! Constructor.
+    /*!
+     * Constructor, memory-maps the cache file and checks its header.
+     * \param cacheFileName Name of the cache file.
+     */
+    MappedGravityFieldCoefficients( const std::string& cacheFileName );
+
+    //! Get gravitational parameter [m^3 s^-2].
+    /*!
+     * Returns gravitational parameter [m^3 s^-2].
+     * \return Gravitational parameter.
+     */
+    double getGravitationalParameter( ) const { return gravitationalParameter_; }
+
+    //! Get reference radius [m].
+    /*!
+     * Returns reference radius [m].
+     * \return Reference radius.
+     */
+    double getReferenceRadius( ) const { return referenceRadius_; }
+
+    //! Get maximum degree of coefficients in cache file.
+    /*!
+     * Returns maximum degree of coefficients in cache file.
+     * \return Maximum degree of coefficients.
+     */
+    int getMaximumDegree( ) const { return maximumDegree_; }
+
+    //! Get maximum order of coefficients in cache file.
+    /*!
+     * Returns maximum order of coefficients in cache file.
+     * \return Maximum order of coefficients.
+     */
+    int getMaximumOrder( ) const { return maximumOrder_; }
+
+    //! Get size of text file from which cache file was written.
+    /*!
+     * Returns size of text file from which cache file was written [bytes].
+     * \return Size of text file.
+     */
+    boost::uintmax_t getSourceFileSize( ) const { return sourceFileSize_; }
+
+    //! Get map of cosine coefficients in mapped memory.
+    /*!
+     * Returns map of cosine coefficients in mapped memory.
+     * \return Map of geodesy-normalized cosine coefficients.
+     */
+    CoefficientMatrixMap getCosineCoefficients( ) const
+    {
+        return CoefficientMatrixMap( cosineCoefficientsData_, maximumDegree_ + 1,
+                                     maximumOrder_ + 1 );
+    }
+
+    //! Get map of sine coefficients in mapped memory.
+    /*!
+     * Returns map of sine coefficients in mapped memory.
+     * \return Map of geodesy-normalized sine coefficients.
+     */
+    CoefficientMatrixMap getSineCoefficients( ) const
+    {
+        return CoefficientMatrixMap( sineCoefficientsData_, maximumDegree_ + 1,
+                                     maximumOrder_ + 1 );
+    }
+
+    //! Get (truncated) copy of coefficients.
+    /*!
+     * Returns a copy of the coefficients, truncated to the requested degree and order.
+     * \param maximumDegree Maximum degree of returned coefficients; a negative value denotes the
+     *          maximum degree in the cache file (default = -1).
+     * \param maximumOrder Maximum order of returned coefficients; a negative value denotes the
+     *          maximum order that is consistent with the maximum degree (default = -1).
+     * \return Gravity field coefficients.
+     */
+    GravityFieldCoefficients getCoefficients( const int maximumDegree = -1,
+                                              const int maximumOrder = -1 ) const;
+
+protected:
+
+private:
+
+    //! File mapping of cache file.
+    boost::interprocess::file_mapping fileMapping_;
+
+    //! Mapped region of cache file.
+    boost::interprocess::mapped_region mappedRegion_;
+
+    //! Gravitational parameter [m^3 s^-2].
+    double gravitationalParameter_;
+
+    //! Reference radius [m].
+    double referenceRadius_;
+
+    //! Maximum degree of coefficients in cache file.
+    int maximumDegree_;
+
+    //! Maximum order of coefficients in cache file.
+    int maximumOrder_;
+
+    //! Size of text file from which cache file was written [bytes].
+    boost::uintmax_t sourceFileSize_;
+
+    //! Pointer to start of cosine coefficients in mapped memory.
+    const double* cosineCoefficientsData_;
+
+    //! Pointer to start of sine coefficients in mapped memory.
+    const double* sineCoefficientsData_;
+};
+
+//! Typedef for shared-pointer to MappedGravityFieldCoefficients object.
+typedef boost::shared_ptr< MappedGravityFieldCoefficients > MappedGravityFieldCoefficientsPointer;
+
+//! Load gravity field coefficients, using binary cache file.
+/*!
+ * Loads gravity field coefficients from the given text file. If the cache file exists, is not
+ * older than the text file, and its header matches the size of the text file and the maximum
+ * degree and order given in the header of the text file, the coefficients are read from the
+ * memory-mapped cache file. Otherwise, the text file is parsed completely (i.e., without
+ * truncation), the result is written to the cache file, and the requested coefficients are
+ * returned. If no cache file name is provided, the name of the text file is used, with ".bin"
+ * appended.
+ * \param fileName Name of the gravity field text file.
+ * \param fileFormat Format of the gravity field text file.
+ * \param maximumDegree Maximum degree of returned coefficients; a negative value denotes the
+ *          maximum degree in the file (default = -1).
+ * \param maximumOrder Maximum order of returned coefficients; a negative value denotes the
+ *          maximum order that is consistent with the maximum degree (default = -1).
+ * \param cacheFileName Name of the binary cache file (default = "").
+ * \return Gravity field coefficients.
+ */
+GravityFieldCoefficients loadGravityFieldCoefficients( const std::string& fileName,
+                                                       const GravityFieldFileFormat fileFormat,
+                                                       const int maximumDegree = -1,
+                                                       const int maximumOrder = -1,
+                                                       const std::string& cacheFileName = "" );
+
+//! Throw runtime error with given message.
+/*!
+ * Throws runtime error with given message, used for all errors encountered when reading gravity
+ * field files.
+ * \param errorMessage Message of the error that is thrown.
+ */
+void throwGravityFieldFileError( const std::string& errorMessage );
+
+//! Determine and check degree and order to which coefficients are to be truncated.
+/*!
+ * Determines the degree and order to which the coefficients are to be truncated, from the
+ * requested and available degree and order, and checks their consistency.
+ * \param requestedMaximumDegree Requested maximum degree; negative for available maximum degree.
+ * \param requestedMaximumOrder Requested maximum order; negative for maximum order consistent with
+ *          maximum degree.
+ * \param availableMaximumDegree Maximum degree that is available.
+ * \param availableMaximumOrder Maximum order that is available.
+ * \param maximumDegree Maximum degree to which coefficients are to be truncated (returned by
+ *          reference).
+ * \param maximumOrder Maximum order to which coefficients are to be truncated (returned by
+ *          reference).
+ */
+void getTruncationDegreeAndOrder( const int requestedMaximumDegree,
+                                  const int requestedMaximumOrder,
+                                  const int availableMaximumDegree,
+                                  const int availableMaximumOrder,
+                                  int& maximumDegree, int& maximumOrder );
+
+//! Compute geodesy normalization factor of spherical harmonic coefficient.
+/*!
+ * Computes the factor by which a geodesy-normalized coefficient is multiplied to obtain the
+ * unnormalized coefficient. The factorials are evaluated through the logarithm of the gamma
+ * function, so that the factor can also be computed for high degrees.
+ * \param degree Degree of coefficient.
+ * \param order Order of coefficient.
+ * \return Geodesy normalization factor.
+ */
+double computeGeodesyNormalizationFactor( const int degree, const int order );
+
+//! Convert unnormalized coefficients to geodesy-normalized coefficients.
+/*!
+ * Converts unnormalized coefficients to geodesy-normalized coefficients, in place.
+ * \param coefficients Gravity field coefficients that are to be converted.
+ */
+void normalizeGravityFieldCoefficients( GravityFieldCoefficients& coefficients );
+
+//! Parse floating-point number, allowing Fortran-style exponents.
+/*!
+ * Parses floating-point number from string, in which the exponent may be denoted by 'D' or 'd'
+ * (as commonly used in gravity field files generated by Fortran programs).
+ * \param numberString String containing floating-point number.
+ * \return Parsed number.
+ */
+double parseGravityFieldFileNumber( std::string numberString );
+
+//! Parse integer field of gravity field file.
+/*!
+ * Parses integer field of gravity field file, and throws an error containing the offending line
+ * if the field is not a valid integer.
+ * \param integerString String containing integer.
+ * \param line Line of gravity field file containing the field (used in error message).
+ * \param fileName Name of gravity field file (used in error message).
+ * \return Parsed integer.
+ */
+int parseGravityFieldFileInteger( const std::string& integerString, const std::string& line,
+                                  const std::string& fileName );
+
+//! Check degree and order read from gravity field file.
+/*!
+ * Checks whether degree and order read from gravity field file are valid (i.e., non-negative,
+ * and order not exceeding degree), and throws an error containing the offending line otherwise.
+ * \param degree Degree read from file.
+ * \param order Order read from file.
+ * \param line Line of gravity field file containing degree and order (used in error message).
+ * \param fileName Name of gravity field file (used in error message).
+ */
+void checkGravityFieldFileDegreeAndOrder( const int degree, const int order,
+                                          const std::string& line, const std::string& fileName );
+
+//! Open gravity field text file.
+/*!
+ * Opens gravity field text file for reading, and throws a runtime error if it cannot be opened.
+ * \param fileName Name of the gravity field text file.
+ * \param file Stream that is opened (returned by reference).
+ */
+void openGravityFieldFile( const std::string& fileName, std::ifstream& file );
+
+//! Read header of ICGEM (.gfc) file.
+/*!
+ * Reads header of ICGEM file, up to and including the end_of_head keyword.
+ * \param file Stream of opened ICGEM file, positioned at its start.
+ * \param fileName Name of ICGEM file (used in error messages).
+ * \param coefficients Gravity field coefficients, of which the gravitational parameter and
+ *          reference radius are set (returned by reference).
+ * \param fileMaximumDegree Maximum degree of coefficients in file (returned by reference).
+ * \param isFileNormalized Boolean denoting whether coefficients in file are geodesy-normalized
+ *          (returned by reference).
+ */
+void readIcgemGravityFieldFileHeader( std::ifstream& file, const std::string& fileName,
+                                      GravityFieldCoefficients& coefficients,
+                                      int& fileMaximumDegree, bool& isFileNormalized );
+
+//! Read header record of SHADR file.
+/*!
+ * Reads header record of SHADR file, and converts the physical constants to SI units.
+ * \param file Stream of opened SHADR file, positioned at its start.
+ * \param fileName Name of SHADR file (used in error messages).
+ * \param coefficients Gravity field coefficients, of which the gravitational parameter and
+ *          reference radius are set (returned by reference).
+ * \param fileMaximumDegree Maximum degree of coefficients in file (returned by reference).
+ * \param fileMaximumOrder Maximum order of coefficients in file (returned by reference).
+ * \param isFileNormalized Boolean denoting whether coefficients in file are geodesy-normalized
+ *          (returned by reference).
+ */
+void readShadrGravityFieldFileHeader( std::ifstream& file, const std::string& fileName,
+                                      GravityFieldCoefficients& coefficients,
+                                      int& fileMaximumDegree, int& fileMaximumOrder,
+                                      bool& isFileNormalized );
+
+//! Read maximum degree and order of coefficients in gravity field file.
+/*!
+ * Reads maximum degree and order of coefficients in gravity field file from its header, without
+ * reading the coefficients.
+ * \param fileName Name of the gravity field text file.
+ * \param fileFormat Format of the gravity field text file.
+ * \param fileMaximumDegree Maximum degree of coefficients in file (returned by reference).
+ * \param fileMaximumOrder Maximum order of coefficients in file (returned by reference).
+ */
+void readGravityFieldFileMaximumDegreeAndOrder( const std::string& fileName,
+                                                const GravityFieldFileFormat fileFormat,
+                                                int& fileMaximumDegree, int& fileMaximumOrder );
+
+//! Check whether binary cache file can be used instead of gravity field text file.
+/*!
+ * Checks whether binary cache file can be used instead of gravity field text file, i.e., whether
+ * it is of the current format, not older than the text file, and was written from a text file of
+ * the same size and with the same maximum degree and order. Only the headers of both files are
+ * read.
+ * \param cacheFileName Name of the binary cache file.
+ * \param fileName Name of the gravity field text file.
+ * \param fileFormat Format of the gravity field text file.
+ * \return True if cache file is consistent with text file, false otherwise.
+ */
+bool isGravityFieldCacheFileUpToDate( const std::string& cacheFileName,
+                                      const std::string& fileName,
+                                      const GravityFieldFileFormat fileFormat );
+
+} // namespace input_output
+} // namespace tudat
+
+#endif // TUDAT_GRAVITY_FIELD_COEFFICIENTS_READER_H
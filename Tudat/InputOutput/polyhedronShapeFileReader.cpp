@@ -0,0 +1,143 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *
+ *    References
+ *      Wavefront Technologies. Object files (.obj), Advanced Visualizer Manual, Appendix B1.
+ *
+ *    Notes
+ *
+ */
+
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/exception/all.hpp>
+
+#include "Tudat/InputOutput/polyhedronShapeFileReader.h"
+
+namespace tudat
+{
+namespace input_output
+{
+
+//! Read polyhedron shape file.
+void readPolyhedronShapeFile( const std::string& fileName,
+                              Eigen::Matrix3Xd& vertices,
+                              Eigen::Matrix3Xi& facets,
+                              const double unitConversionFactor )
+{
+    std::ifstream file( fileName.c_str( ) );
+    if ( !file.is_open( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error, polyhedron shape file '" + fileName
+                                            + "' could not be opened." ) ) );
+    }
+
+    std::vector< double > vertexCoordinates;
+    std::vector< int > facetIndices;
+
+    std::string line;
+    int lineNumber = 0;
+    while ( std::getline( file, line ) )
+    {
+        lineNumber++;
+        std::istringstream lineStream( line );
+        std::string keyword;
+        if ( !( lineStream >> keyword ) )
+        {
+            continue;
+        }
+
+        if ( keyword == "v" )
+        {
+            double x, y, z;
+            if ( !( lineStream >> x >> y >> z ) )
+            {
+                std::stringstream errorMessage;
+                errorMessage << "Error, invalid vertex on line " << lineNumber
+                             << " of polyhedron shape file '" << fileName << "'.";
+                boost::throw_exception( boost::enable_error_info(
+                                            std::runtime_error( errorMessage.str( ) ) ) );
+            }
+            vertexCoordinates.push_back( unitConversionFactor * x );
+            vertexCoordinates.push_back( unitConversionFactor * y );
+            vertexCoordinates.push_back( unitConversionFactor * z );
+        }
+        else if ( keyword == "f" )
+        {
+            // Read vertex indices, discarding texture and normal indices.
+            std::vector< int > faceVertices;
+            std::string vertexEntry;
+            while ( lineStream >> vertexEntry )
+            {
+                faceVertices.push_back( std::atoi(
+                                            vertexEntry.substr( 0, vertexEntry.find( '/' ) )
+                                            .c_str( ) ) - 1 );
+            }
+
+            if ( faceVertices.size( ) < 3 )
+            {
+                std::stringstream errorMessage;
+                errorMessage << "Error, facet with fewer than three vertices on line "
+                             << lineNumber << " of polyhedron shape file '" << fileName << "'.";
+                boost::throw_exception( boost::enable_error_info(
+                                            std::runtime_error( errorMessage.str( ) ) ) );
+            }
+
+            // Split face into triangles with common first vertex.
+            for ( unsigned int i = 1; i + 1 < faceVertices.size( ); i++ )
+            {
+                facetIndices.push_back( faceVertices[ 0 ] );
+                facetIndices.push_back( faceVertices[ i ] );
+                facetIndices.push_back( faceVertices[ i + 1 ] );
+            }
+        }
+    }
+
+    const int numberOfVertices = vertexCoordinates.size( ) / 3;
+    vertices = Eigen::Map< Eigen::Matrix3Xd >( vertexCoordinates.data( ), 3, numberOfVertices );
+    facets = Eigen::Map< Eigen::Matrix3Xi >( facetIndices.data( ), 3, facetIndices.size( ) / 3 );
+
+    if ( numberOfVertices == 0 || facets.cols( ) == 0 || facets.minCoeff( ) < 0
+         || facets.maxCoeff( ) >= numberOfVertices )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error, polyhedron shape file '" + fileName
+                                            + "' contains no facets, or invalid vertex "
+                                            "indices." ) ) );
+    }
+}
+
+} // namespace input_output
+} // namespace tudat
@@ -0,0 +1,75 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Corrected units of vertices in documentation.
+ *
+ *    References
+ *      Wavefront Technologies. Object files (.obj), Advanced Visualizer Manual, Appendix B1.
+ *
+ *    Notes
+ *      Only the vertex ("v") and face ("f") records of the Wavefront OBJ format are read, which is
+ *      the format in which, e.g., the shape models of small bodies in the NASA Planetary Data
+ *      System are commonly distributed. All other records are ignored. Faces with more than three
+ *      vertices are split into triangles (fan triangulation).
+ *
+ */
+
+#ifndef TUDAT_POLYHEDRON_SHAPE_FILE_READER_H
+#define TUDAT_POLYHEDRON_SHAPE_FILE_READER_H
+
+#include <string>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+namespace input_output
+{
+
+//! Read polyhedron shape file.
+/*!
+ * Reads a triangulated polyhedron shape model from a file in Wavefront OBJ format, i.e. with
+ * lines "v x y z" defining the vertices, and lines "f i j k" defining the (1-based) vertex
+ * indices of each facet. Vertex indices of a facet may be followed by texture and normal indices
+ * ("f i/t/n ..."), which are ignored.
+ * \param fileName Name of shape file.
+ * \param vertices Positions of vertices, each column containing a single vertex, in the units
+ *          of the file multiplied by the unit conversion factor (returned by reference).
+ * \param facets Zero-based vertex indices of facets, each column containing a single facet
+ *          (returned by reference).
+ * \param unitConversionFactor Factor by which the vertex positions are multiplied, e.g. 1.0E3 to
+ *          convert a file in km to m (default = 1.0).
+ */
+void readPolyhedronShapeFile( const std::string& fileName,
+                              Eigen::Matrix3Xd& vertices,
+                              Eigen::Matrix3Xi& facets,
+                              const double unitConversionFactor = 1.0 );
+
+} // namespace input_output
+} // namespace tudat
+
+#endif // TUDAT_POLYHEDRON_SHAPE_FILE_READER_H
@@ -0,0 +1,240 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      Unit test created.
+ *      261018                      Added test of power functions at zero base.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "Tudat/Basics/testMacros.h"
+
+#include "Tudat/Mathematics/BasicMathematics/dualNumber.h"
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Typedef for dual number with two derivatives.
+typedef basic_mathematics::DualNumber< 2 > TestDualNumber;
+
+//! Test function, templated on scalar type.
+template< typename ScalarType >
+ScalarType computeTestFunction( const ScalarType x, const ScalarType y )
+{
+    using std::atan2;
+    using std::exp;
+    using std::log;
+    using std::pow;
+    using std::sin;
+    using std::sqrt;
+
+    return x * sin( y ) / ( mathematical_constants::getFloatingInteger< ScalarType >( 2 ) + y )
+            + exp( x * y ) * log( x ) - sqrt( x * x + y * y ) + atan2( y, x ) + pow( x, y )
+            - mathematical_constants::getFloatingFraction< ScalarType >( 1, 3 ) * pow( y, 3.0 );
+}
+
+//! Compute analytical partial derivatives of test function.
+Eigen::Vector2d computeTestFunctionPartials( const double x, const double y )
+{
+    const double radius = std::sqrt( x * x + y * y );
+    Eigen::Vector2d partials;
+    partials( 0 ) = std::sin( y ) / ( 2.0 + y )
+            + std::exp( x * y ) * ( y * std::log( x ) + 1.0 / x ) - x / radius
+            - y / ( radius * radius ) + y * std::pow( x, y - 1.0 );
+    partials( 1 ) = x * ( std::cos( y ) * ( 2.0 + y ) - std::sin( y ) )
+            / ( ( 2.0 + y ) * ( 2.0 + y ) )
+            + x * std::exp( x * y ) * std::log( x ) - y / radius + x / ( radius * radius )
+            + std::pow( x, y ) * std::log( x ) - y * y;
+    return partials;
+}
+
+BOOST_AUTO_TEST_SUITE( test_dual_number )
+
+using basic_mathematics::DualNumber;
+
+//! Test partial derivatives of composite function against analytical values.
+BOOST_AUTO_TEST_CASE( testDualNumberCompositeFunction )
+{
+    const double x = 1.3;
+    const double y = 0.7;
+
+    const TestDualNumber result
+            = computeTestFunction( TestDualNumber( x, 0 ), TestDualNumber( y, 1 ) );
+    const Eigen::Vector2d expectedPartials = computeTestFunctionPartials( x, y );
+
+    BOOST_CHECK_CLOSE_FRACTION( result.getValue( ), computeTestFunction( x, y ),
+                                std::numeric_limits< double >::epsilon( ) );
+    BOOST_CHECK_CLOSE_FRACTION( result.getDerivative( 0 ), expectedPartials( 0 ), 1.0E-14 );
+    BOOST_CHECK_CLOSE_FRACTION( result.getDerivative( 1 ), expectedPartials( 1 ), 1.0E-14 );
+}
+
+//! Test derivatives of elementary functions against analytical values.
+BOOST_AUTO_TEST_CASE( testDualNumberElementaryFunctions )
+{
+    const double x = 0.4;
+    const DualNumber< 1 > dualX( x, 0 );
+
+    BOOST_CHECK_CLOSE_FRACTION( tan( dualX ).getDerivative( 0 ),
+                                1.0 / ( std::cos( x ) * std::cos( x ) ), 1.0E-15 );
+    BOOST_CHECK_CLOSE_FRACTION( asin( dualX ).getDerivative( 0 ),
+                                1.0 / std::sqrt( 1.0 - x * x ), 1.0E-15 );
+    BOOST_CHECK_CLOSE_FRACTION( acos( dualX ).getDerivative( 0 ),
+                                -1.0 / std::sqrt( 1.0 - x * x ), 1.0E-15 );
+    BOOST_CHECK_CLOSE_FRACTION( atan( dualX ).getDerivative( 0 ), 1.0 / ( 1.0 + x * x ),
+                                1.0E-15 );
+    BOOST_CHECK_CLOSE_FRACTION( sinh( dualX ).getDerivative( 0 ), std::cosh( x ), 1.0E-15 );
+    BOOST_CHECK_CLOSE_FRACTION( cosh( dualX ).getDerivative( 0 ), std::sinh( x ), 1.0E-15 );
+    BOOST_CHECK_CLOSE_FRACTION( tanh( dualX ).getDerivative( 0 ),
+                                1.0 - std::tanh( x ) * std::tanh( x ), 1.0E-15 );
+    BOOST_CHECK_CLOSE_FRACTION( asinh( dualX ).getDerivative( 0 ),
+                                1.0 / std::sqrt( x * x + 1.0 ), 1.0E-15 );
+    BOOST_CHECK_CLOSE_FRACTION( acosh( 1.0 / dualX ).getDerivative( 0 ),
+                                -1.0 / ( x * x * std::sqrt( 1.0 / ( x * x ) - 1.0 ) ), 1.0E-15 );
+    BOOST_CHECK_CLOSE_FRACTION( atanh( dualX ).getDerivative( 0 ), 1.0 / ( 1.0 - x * x ),
+                                1.0E-15 );
+    BOOST_CHECK_CLOSE_FRACTION( cbrt( dualX ).getDerivative( 0 ),
+                                1.0 / ( 3.0 * std::cbrt( x * x ) ), 1.0E-15 );
+    BOOST_CHECK_CLOSE_FRACTION( pow( 2.0, dualX ).getDerivative( 0 ),
+                                std::pow( 2.0, x ) * std::log( 2.0 ), 1.0E-15 );
+    BOOST_CHECK_CLOSE_FRACTION( fmod( 3.0 * dualX, DualNumber< 1 >( 0.5 ) ).getValue( ),
+                                std::fmod( 3.0 * x, 0.5 ), 1.0E-15 );
+    BOOST_CHECK_EQUAL( fmod( 3.0 * dualX, DualNumber< 1 >( 0.5 ) ).getDerivative( 0 ), 3.0 );
+    BOOST_CHECK_EQUAL( fabs( -dualX ).getDerivative( 0 ), 1.0 );
+    BOOST_CHECK_EQUAL( floor( 3.0 * dualX ).getValue( ), 1.0 );
+    BOOST_CHECK_EQUAL( floor( 3.0 * dualX ).getDerivative( 0 ), 0.0 );
+
+    // Check compound assignment operators.
+    DualNumber< 1 > compoundResult = dualX;
+    compoundResult *= dualX;
+    compoundResult /= 1.0 + dualX;
+    compoundResult += 2.0 * dualX;
+    compoundResult -= 0.5;
+    BOOST_CHECK_CLOSE_FRACTION( compoundResult.getDerivative( 0 ),
+                                ( x * x + 2.0 * x ) / ( ( 1.0 + x ) * ( 1.0 + x ) ) + 2.0,
+                                1.0E-15 );
+}
+
+//! Test whether derivatives of power functions are defined for zero base.
+BOOST_AUTO_TEST_CASE( testDualNumberPowerOfZero )
+{
+    const DualNumber< 1 > dualZero( 0.0, 0 );
+
+    // Scalar exponent.
+    BOOST_CHECK_EQUAL( pow( dualZero, 2.0 ).getValue( ), 0.0 );
+    BOOST_CHECK_EQUAL( pow( dualZero, 2.0 ).getDerivative( 0 ), 0.0 );
+    BOOST_CHECK_EQUAL( pow( dualZero, 3.0 ).getDerivative( 0 ), 0.0 );
+    BOOST_CHECK_EQUAL( pow( dualZero, 1.0 ).getDerivative( 0 ), 1.0 );
+
+    // Dual number exponent that does not depend on the variables.
+    BOOST_CHECK_EQUAL( pow( dualZero, DualNumber< 1 >( 2.0 ) ).getValue( ), 0.0 );
+    BOOST_CHECK_EQUAL( pow( dualZero, DualNumber< 1 >( 2.0 ) ).getDerivative( 0 ), 0.0 );
+    BOOST_CHECK_EQUAL( pow( dualZero, DualNumber< 1 >( 1.0 ) ).getDerivative( 0 ), 1.0 );
+
+    // Dual number exponent that depends on the variables, at non-zero base.
+    const double x = 0.4;
+    const DualNumber< 2 > dualX( x, 0 );
+    const DualNumber< 2 > dualY( 2.5, 1 );
+    const DualNumber< 2 > power = pow( dualX, dualY );
+    BOOST_CHECK_CLOSE_FRACTION( power.getDerivative( 0 ), 2.5 * std::pow( x, 1.5 ), 1.0E-15 );
+    BOOST_CHECK_CLOSE_FRACTION( power.getDerivative( 1 ), std::pow( x, 2.5 ) * std::log( x ),
+                                1.0E-15 );
+}
+
+//! Test use of dual numbers with mathematical constants and in Eigen types.
+BOOST_AUTO_TEST_CASE( testDualNumberCompatibility )
+{
+    using namespace mathematical_constants;
+
+    // Check conversion from constants and comparison with scalars.
+    const TestDualNumber two = getFloatingInteger< TestDualNumber >( 2 );
+    BOOST_CHECK_EQUAL( two.getValue( ), 2.0 );
+    BOOST_CHECK( two.getDerivatives( ).isZero( ) );
+    BOOST_CHECK_EQUAL( getPi< TestDualNumber >( ).getValue( ), PI );
+    BOOST_CHECK( getFloatingFraction< TestDualNumber >( 1, 3 ) < 0.5 );
+    BOOST_CHECK( 1 < two );
+    BOOST_CHECK_EQUAL( std::numeric_limits< TestDualNumber >::epsilon( ).getValue( ),
+                       std::numeric_limits< double >::epsilon( ) );
+    BOOST_CHECK_EQUAL( std::numeric_limits< TestDualNumber >::digits,
+                       std::numeric_limits< double >::digits );
+
+    // Check vector operations on vector of independent variables.
+    const Eigen::Vector3d position( 1.0, -2.0, 0.5 );
+    const Eigen::Matrix< DualNumber< 3 >, 3, 1 > dualPosition
+            = basic_mathematics::createIndependentDualNumbers( position );
+    const Eigen::Matrix< DualNumber< 3 >, 3, 1 > dualUnitVector
+            = dualPosition / dualPosition.norm( );
+    const Eigen::Matrix< DualNumber< 3 >, 3, 1 > dualCrossProduct
+            = dualPosition.cross( Eigen::Matrix< DualNumber< 3 >, 3, 1 >(
+                                      dualPosition.cwiseProduct( dualPosition ) ) );
+
+    const double radius = position.norm( );
+    const Eigen::Matrix3d expectedUnitVectorJacobian
+            = ( Eigen::Matrix3d::Identity( ) - position * position.transpose( )
+                / ( radius * radius ) ) / radius;
+    const Eigen::Matrix3d unitVectorJacobian
+            = basic_mathematics::getDualNumberJacobian( dualUnitVector );
+    TUDAT_CHECK_MATRIX_BASE( unitVectorJacobian, expectedUnitVectorJacobian )
+            BOOST_CHECK_SMALL( unitVectorJacobian.coeff( row, col )
+                               - expectedUnitVectorJacobian.coeff( row, col ), 1.0E-15 );
+
+    // Jacobian of r x ( r .* r ) w.r.t. r.
+    Eigen::Matrix3d expectedCrossProductJacobian;
+    const double x = position.x( ), y = position.y( ), z = position.z( );
+    expectedCrossProductJacobian << 0.0, z * z - 2.0 * y * z, 2.0 * y * z - y * y,
+            2.0 * x * z - z * z, 0.0, x * x - 2.0 * x * z,
+            y * y - 2.0 * x * y, 2.0 * x * y - x * x, 0.0;
+    BOOST_CHECK( basic_mathematics::getDualNumberJacobian( dualCrossProduct )
+                 == expectedCrossProductJacobian );
+    BOOST_CHECK( basic_mathematics::getDualNumberValues( dualUnitVector )
+                 == position / radius );
+
+    // Check mixed dual number and scalar Eigen expressions.
+    const Eigen::Matrix< DualNumber< 3 >, 3, 1 > scaledPosition
+            = dualPosition.cwiseProduct( position ) * 2.0;
+    BOOST_CHECK( basic_mathematics::getDualNumberJacobian( scaledPosition )
+                 == Eigen::Matrix3d( ( 2.0 * position ).asDiagonal( ) ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,241 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      Unit test created.
+ *      261018                      Added test of empty input; set minimum columns per thread.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/function.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Basics/testMacros.h"
+
+#include "Tudat/Mathematics/BasicMathematics/jacobianEngine.h"
+#include "Tudat/Mathematics/BasicMathematics/numericalDerivative.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Function object computing the state derivative in the two-body problem (with mu = 1).
+/*!
+ * Function object computing the state derivative in the two-body problem, templated on the scalar
+ * type, so that it can be used for both finite difference and complex-step Jacobians.
+ */
+struct TwoBodyStateDerivativeFunction
+{
+    //! Compute state derivative.
+    template< typename ScalarType >
+    Eigen::Matrix< ScalarType, Eigen::Dynamic, 1 > operator( )(
+            const Eigen::Matrix< ScalarType, Eigen::Dynamic, 1 >& state ) const
+    {
+        const ScalarType radius = std::sqrt( state( 0 ) * state( 0 ) + state( 1 ) * state( 1 )
+                                             + state( 2 ) * state( 2 ) );
+        Eigen::Matrix< ScalarType, Eigen::Dynamic, 1 > stateDerivative( 6 );
+        stateDerivative.segment( 0, 3 ) = state.segment( 3, 3 );
+        stateDerivative.segment( 3, 3 ) = -state.segment( 0, 3 ) / ( radius * radius * radius );
+        return stateDerivative;
+    }
+};
+
+//! Compute analytical Jacobian of two-body state derivative (with mu = 1).
+Eigen::MatrixXd computeTwoBodyStateDerivativeJacobian( const Eigen::VectorXd& state )
+{
+    const Eigen::Vector3d position = state.segment( 0, 3 );
+    const double radius = position.norm( );
+
+    Eigen::MatrixXd jacobian = Eigen::MatrixXd::Zero( 6, 6 );
+    jacobian.block( 0, 3, 3, 3 ) = Eigen::Matrix3d::Identity( );
+    jacobian.block( 3, 0, 3, 3 ) = 3.0 * position * position.transpose( ) / std::pow( radius, 5 )
+            - Eigen::Matrix3d::Identity( ) / std::pow( radius, 3 );
+    return jacobian;
+}
+
+//! Get test state.
+Eigen::VectorXd getTestState( )
+{
+    Eigen::VectorXd state( 6 );
+    state << 0.8, -0.5, 0.3, 0.2, 0.9, -0.1;
+    return state;
+}
+
+BOOST_AUTO_TEST_SUITE( test_jacobian_engine )
+
+using namespace numerical_derivatives;
+
+//! Test accuracy of finite difference Jacobians of all schemes and orders.
+BOOST_AUTO_TEST_CASE( testFiniteDifferenceJacobianAccuracy )
+{
+    const Eigen::VectorXd state = getTestState( );
+    const Eigen::MatrixXd expectedJacobian = computeTwoBodyStateDerivativeJacobian( state );
+    const FiniteDifferenceJacobianEngine::VectorFunction function
+            = TwoBodyStateDerivativeFunction( );
+
+    // Set schemes, orders and expected accuracies.
+    const FiniteDifferenceScheme schemes[ 7 ] =
+    { forwardDifferenceScheme, forwardDifferenceScheme, forwardDifferenceScheme,
+      centralDifferenceScheme, centralDifferenceScheme, centralDifferenceScheme,
+      centralDifferenceScheme };
+    const int orders[ 7 ] = { 1, 2, 3, 2, 4, 6, 8 };
+    const double tolerances[ 7 ] = { 1.0E-3, 1.0E-7, 1.0E-10, 1.0E-7, 1.0E-10, 1.0E-11,
+                                     1.0E-11 };
+
+    for ( int i = 0; i < 7; i++ )
+    {
+        FiniteDifferenceJacobianEngine jacobianEngine( function, schemes[ i ], orders[ i ] );
+        const Eigen::MatrixXd computedJacobian = jacobianEngine.computeJacobian( state );
+
+        TUDAT_CHECK_MATRIX_BASE( computedJacobian, expectedJacobian )
+                BOOST_CHECK_SMALL( computedJacobian.coeff( row, col )
+                                   - expectedJacobian.coeff( row, col ), tolerances[ i ] );
+    }
+}
+
+//! Test whether engine reproduces existing central difference function.
+BOOST_AUTO_TEST_CASE( testFiniteDifferenceJacobianAgainstCentralDifference )
+{
+    const Eigen::VectorXd state = getTestState( );
+    const FiniteDifferenceJacobianEngine::VectorFunction function
+            = TwoBodyStateDerivativeFunction( );
+
+    const CentralDifferenceOrders orders[ 4 ] = { order2, order4, order6, order8 };
+    for ( int i = 0; i < 4; i++ )
+    {
+        FiniteDifferenceJacobianEngine jacobianEngine(
+                    function, centralDifferenceScheme, static_cast< int >( orders[ i ] ) );
+        const Eigen::MatrixXd expectedJacobian = computeCentralDifference(
+                    state, function, 0.0, 0.0, orders[ i ] );
+
+        BOOST_CHECK( jacobianEngine.computeJacobian( state ) == expectedJacobian );
+        BOOST_CHECK_EQUAL( jacobianEngine.getNumberOfFunctionEvaluations( ),
+                           6 * static_cast< int >( orders[ i ] ) );
+    }
+}
+
+//! Test multi-threaded evaluation, and reuse of base point function value.
+BOOST_AUTO_TEST_CASE( testFiniteDifferenceJacobianThreadsAndBasePoint )
+{
+    const Eigen::VectorXd state = getTestState( );
+    const FiniteDifferenceJacobianEngine::VectorFunction function
+            = TwoBodyStateDerivativeFunction( );
+
+    // Compute Jacobian on single and multiple threads.
+    FiniteDifferenceJacobianEngine singleThreadedEngine( function, forwardDifferenceScheme, 2 );
+    FiniteDifferenceJacobianEngine multiThreadedEngine( function, forwardDifferenceScheme, 2, 4 );
+    multiThreadedEngine.setMinimumNumberOfColumnsPerThread( 1 );
+
+    const Eigen::MatrixXd singleThreadedJacobian = singleThreadedEngine.computeJacobian( state );
+    BOOST_CHECK( multiThreadedEngine.computeJacobian( state ) == singleThreadedJacobian );
+    BOOST_CHECK_EQUAL( multiThreadedEngine.getNumberOfFunctionEvaluations( ), 13 );
+    BOOST_CHECK( multiThreadedEngine.getBaseFunctionValue( ) == function( state ) );
+
+    // Repeat computation with supplied base point function value.
+    BOOST_CHECK( multiThreadedEngine.computeJacobian( state, function( state ) )
+                 == singleThreadedJacobian );
+    BOOST_CHECK_EQUAL( multiThreadedEngine.getNumberOfFunctionEvaluations( ), 12 );
+
+    // Compute central difference Jacobian on more threads than columns.
+    FiniteDifferenceJacobianEngine singleThreadedCentralEngine(
+                function, centralDifferenceScheme, 4 );
+    FiniteDifferenceJacobianEngine multiThreadedCentralEngine(
+                function, centralDifferenceScheme, 4, 8 );
+    multiThreadedCentralEngine.setMinimumNumberOfColumnsPerThread( 1 );
+    const Eigen::MatrixXd expectedJacobian
+            = singleThreadedCentralEngine.computeJacobian( state );
+    BOOST_CHECK( multiThreadedCentralEngine.computeJacobian( state ) == expectedJacobian );
+    BOOST_CHECK( multiThreadedCentralEngine.computeJacobian( state ) == expectedJacobian );
+}
+
+//! Test accuracy of complex-step Jacobian.
+BOOST_AUTO_TEST_CASE( testComplexStepJacobian )
+{
+    const Eigen::VectorXd state = getTestState( );
+    const Eigen::MatrixXd expectedJacobian = computeTwoBodyStateDerivativeJacobian( state );
+    const Eigen::MatrixXd computedJacobian
+            = computeComplexStepJacobian( TwoBodyStateDerivativeFunction( ), state );
+
+    TUDAT_CHECK_MATRIX_BASE( computedJacobian, expectedJacobian )
+            BOOST_CHECK_SMALL( computedJacobian.coeff( row, col )
+                               - expectedJacobian.coeff( row, col ), 1.0E-15 );
+}
+
+//! Test exceptions for invalid order, empty input, and for exceptions thrown on worker threads.
+BOOST_AUTO_TEST_CASE( testFiniteDifferenceJacobianExceptions )
+{
+    const FiniteDifferenceJacobianEngine::VectorFunction function
+            = TwoBodyStateDerivativeFunction( );
+
+    BOOST_CHECK_THROW( FiniteDifferenceJacobianEngine( function, centralDifferenceScheme, 3 ),
+                       std::runtime_error );
+    BOOST_CHECK_THROW( FiniteDifferenceJacobianEngine( function, forwardDifferenceScheme, 4 ),
+                       std::runtime_error );
+
+    // Function that throws for large values of last element, which is evaluated on a worker
+    // thread.
+    const FiniteDifferenceJacobianEngine::VectorFunction throwingFunction
+            = [ ]( const Eigen::VectorXd& input )
+    {
+        if ( input( input.rows( ) - 1 ) > 1.0 )
+        {
+            throw std::runtime_error( "Input out of range." );
+        }
+        return Eigen::VectorXd( 2.0 * input );
+    };
+
+    FiniteDifferenceJacobianEngine jacobianEngine(
+                throwingFunction, centralDifferenceScheme, 2, 3 );
+    jacobianEngine.setMinimumNumberOfColumnsPerThread( 2 );
+    BOOST_CHECK_THROW( jacobianEngine.computeJacobian( Eigen::VectorXd::Constant( 6, 1.0 ) ),
+                       std::runtime_error );
+    const Eigen::MatrixXd jacobian
+            = jacobianEngine.computeJacobian( Eigen::VectorXd::Constant( 6, 0.5 ) );
+    BOOST_CHECK_SMALL( ( jacobian - 2.0 * Eigen::MatrixXd::Identity( 6, 6 ) ).norm( ), 1.0E-10 );
+
+    // Empty input is rejected, with and without function value at base point.
+    FiniteDifferenceJacobianEngine forwardJacobianEngine( function, forwardDifferenceScheme, 1 );
+    BOOST_CHECK_THROW( jacobianEngine.computeJacobian( Eigen::VectorXd( ) ), std::runtime_error );
+    BOOST_CHECK_THROW( forwardJacobianEngine.computeJacobian( Eigen::VectorXd( ),
+                                                              Eigen::VectorXd::Zero( 6 ) ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -25,6 +25,7 @@
  *    Changelog
  *      YYMMDD    Author            Comment
  *      120926    E. Dekens         File created.
+ *      261018                      Added tests of cache statistics and multi-threaded use.
  *
  *    References
  *      Mathworks. Legendre - Associated Legendre functions. Help documentation of MATLAB R2012a,
@@ -42,6 +43,10 @@
 
 #define BOOST_TEST_MAIN
 
+#include <functional>
+#include <thread>
+#include <vector>
+
 #include <boost/test/floating_point_comparison.hpp>
 #include <boost/test/unit_test.hpp>
 
@@ -278,6 +283,91 @@ BOOST_AUTO_TEST_CASE( test_Legendre_GeodesyLegendrePolynomialDerivative )
     TUDAT_CHECK_MATRIX_CLOSE_FRACTION( expectedValues, computedTestValues, 1.0e-14 );
 }
 
+BOOST_AUTO_TEST_CASE( test_LegendreCacheStatistics )
+{
+    using namespace basic_mathematics;
+
+    // Define polynomial parameter.
+    const double polynomialParameter = 0.3;
+
+    // Compute polynomial with explicit cache, and compare with default (thread-local) cache.
+    LegendreCache explicitCache( 100 );
+    BOOST_CHECK_EQUAL( explicitCache.getMaximumNumberOfEntries( ), 100u );
+    const double explicitCacheValue = computeGeodesyLegendrePolynomial(
+                10, 3, polynomialParameter, explicitCache );
+    BOOST_CHECK_EQUAL( explicitCacheValue,
+                       computeGeodesyLegendrePolynomial( 10, 3, polynomialParameter ) );
+
+    // Each intermediate polynomial is computed once, and then stored in the cache.
+    BOOST_CHECK( explicitCache.getNumberOfMisses( ) > 0 );
+    BOOST_CHECK_EQUAL( explicitCache.getNumberOfMisses( ), explicitCache.getNumberOfEntries( ) );
+
+    // Repeated computation of same polynomial should only use cached values.
+    explicitCache.resetStatistics( );
+    computeGeodesyLegendrePolynomial( 10, 3, polynomialParameter, explicitCache );
+    BOOST_CHECK_EQUAL( explicitCache.getNumberOfMisses( ), 0u );
+    BOOST_CHECK_EQUAL( explicitCache.getNumberOfHits( ), 2u );
+
+    // Check that cache does not exceed maximum size.
+    computeGeodesyLegendrePolynomial( 150, 60, polynomialParameter, explicitCache );
+    BOOST_CHECK_EQUAL( explicitCache.getNumberOfEntries( ), 100u );
+
+    // Check that clearing cache removes all entries.
+    explicitCache.clear( );
+    BOOST_CHECK_EQUAL( explicitCache.getNumberOfEntries( ), 0u );
+}
+
+//! Compute set of Legendre polynomials, for use in separate thread.
+void computeLegendrePolynomialsInThread( const double polynomialParameter,
+                                         Eigen::MatrixXd& legendrePolynomials,
+                                         basic_mathematics::LegendreCache*& threadCache )
+{
+    for ( int degree = 0; degree < legendrePolynomials.rows( ); degree++ )
+    {
+        for ( int order = 0; order < legendrePolynomials.cols( ); order++ )
+        {
+            legendrePolynomials( degree, order )
+                    = basic_mathematics::computeGeodesyLegendrePolynomial(
+                        degree, order, polynomialParameter )
+                    + basic_mathematics::computeLegendrePolynomial(
+                        degree, order, polynomialParameter );
+        }
+    }
+    threadCache = &basic_mathematics::getGeodesyLegendreCache( );
+}
+
+BOOST_AUTO_TEST_CASE( test_LegendreCacheMultiThreaded )
+{
+    // Compute polynomials concurrently in multiple threads.
+    const int numberOfThreads = 4;
+    std::vector< Eigen::MatrixXd > legendrePolynomials(
+                numberOfThreads, Eigen::MatrixXd::Zero( 40, 40 ) );
+    std::vector< basic_mathematics::LegendreCache* > threadCaches( numberOfThreads );
+    std::vector< std::thread > threads;
+    for ( int i = 0; i < numberOfThreads; i++ )
+    {
+        threads.push_back( std::thread( &computeLegendrePolynomialsInThread,
+                                        0.1 * static_cast< double >( i + 1 ),
+                                        std::ref( legendrePolynomials[ i ] ),
+                                        std::ref( threadCaches[ i ] ) ) );
+    }
+    for ( int i = 0; i < numberOfThreads; i++ )
+    {
+        threads[ i ].join( );
+    }
+
+    // Check results against computation in main thread, and check that caches are distinct.
+    for ( int i = 0; i < numberOfThreads; i++ )
+    {
+        Eigen::MatrixXd expectedLegendrePolynomials = Eigen::MatrixXd::Zero( 40, 40 );
+        basic_mathematics::LegendreCache* mainThreadCache = NULL;
+        computeLegendrePolynomialsInThread( 0.1 * static_cast< double >( i + 1 ),
+                                            expectedLegendrePolynomials, mainThreadCache );
+        BOOST_CHECK( threadCaches[ i ] != mainThreadCache );
+        BOOST_CHECK( legendrePolynomials[ i ] == expectedLegendrePolynomials );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
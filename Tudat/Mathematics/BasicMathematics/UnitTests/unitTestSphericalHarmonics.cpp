@@ -25,6 +25,7 @@
  *    Changelog
  *      YYMMDD    Author            Comment
  *      120926    E. Dekens         File created.
+ *      261018                      Added test of spherical harmonics workspace.
  *
  *    References
  *
@@ -34,6 +35,8 @@
 
 #define BOOST_TEST_MAIN
 
+#include <cmath>
+
 #include <boost/test/floating_point_comparison.hpp>
 #include <boost/test/unit_test.hpp>
 
@@ -41,6 +44,7 @@
 
 #include "Tudat/Basics/testMacros.h"
 
+#include "Tudat/Mathematics/BasicMathematics/legendrePolynomials.h"
 #include "Tudat/Mathematics/BasicMathematics/sphericalHarmonics.h"
 
 namespace tudat
@@ -199,6 +203,61 @@ BOOST_AUTO_TEST_CASE( test_SphericalHarmonics_PotentialGradient )
     TUDAT_CHECK_MATRIX_CLOSE_FRACTION( testPotentialGradient, expectedValues, 1.0e-15 );
 }
 
+//! Test single-pass evaluation of spherical harmonics terms against recursive functions.
+BOOST_AUTO_TEST_CASE( test_SphericalHarmonics_Workspace )
+{
+    using namespace basic_mathematics;
+
+    const int maximumDegree = 50;
+    const int maximumOrder = 50;
+    const double referenceRadius = 6378137.0;
+
+    // Define an arbitrary position, and compute its latitude and longitude.
+    const Eigen::Vector3d position( 4.2E6, -5.3E6, 3.1E6 );
+    const double radius = position.norm( );
+    const double latitude = std::asin( position.z( ) / radius );
+    const double longitude = std::atan2( position.y( ), position.x( ) );
+
+    SphericalHarmonicsWorkspace sphericalHarmonicsWorkspace( maximumDegree, maximumOrder );
+    sphericalHarmonicsWorkspace.update( position, referenceRadius );
+
+    BOOST_CHECK_CLOSE_FRACTION( sphericalHarmonicsWorkspace.getRadius( ), radius, 1.0E-15 );
+
+    for ( int degree = 0; degree <= maximumDegree; degree++ )
+    {
+        BOOST_CHECK_CLOSE_FRACTION( sphericalHarmonicsWorkspace.getRadiusRatioPower( degree ),
+                                    std::pow( referenceRadius / radius, degree ), 1.0E-13 );
+
+        for ( int order = 0; order <= degree; order++ )
+        {
+            // Compute Legendre polynomial and derivative w.r.t. latitude with recursive functions.
+            const double expectedLegendrePolynomial = computeGeodesyLegendrePolynomial(
+                        degree, order, std::sin( latitude ) );
+            const double expectedLegendrePolynomialDerivative
+                    = computeGeodesyLegendrePolynomialDerivative(
+                        degree, order, std::sin( latitude ), expectedLegendrePolynomial,
+                        computeGeodesyLegendrePolynomial( degree, order + 1,
+                                                          std::sin( latitude ) ) )
+                    * std::cos( latitude );
+
+            // Compare values, relative to typical magnitude of normalized polynomials.
+            BOOST_CHECK_SMALL( sphericalHarmonicsWorkspace.getLegendrePolynomial( degree, order )
+                               - expectedLegendrePolynomial, 1.0E-11 );
+            BOOST_CHECK_SMALL( sphericalHarmonicsWorkspace.getLegendrePolynomialDerivative(
+                                   degree, order ) - expectedLegendrePolynomialDerivative,
+                               1.0E-11 * ( degree + 1 ) );
+        }
+    }
+
+    for ( int order = 0; order <= maximumOrder; order++ )
+    {
+        BOOST_CHECK_SMALL( sphericalHarmonicsWorkspace.getCosineOfMultipleLongitude( order )
+                           - std::cos( order * longitude ), 1.0E-13 );
+        BOOST_CHECK_SMALL( sphericalHarmonicsWorkspace.getSineOfMultipleLongitude( order )
+                           - std::sin( order * longitude ), 1.0E-13 );
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END( )
 
 } // namespace unit_tests
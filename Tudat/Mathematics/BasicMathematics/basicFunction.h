@@ -27,6 +27,7 @@
  *      120208    S. Billemont      File created.
  *      120402    T. Secretin       Code-check.
  *      140124    H.P. Gijsen       fixed Doxygen warnings
+ *      261018                      Made step size of type of independent variable.
  *
  *    References
  *
@@ -98,7 +99,7 @@ public:
         }
 
         // Define step size to the left and right.
-        double stepSize = sqrt_epsilon_double * independentVariable;
+        IndependentVariable stepSize = sqrt_epsilon_double * independentVariable;
 
         // Return derivative according to formula:
         // f'(x) = [f(x+h)-f(x-h)]/2h
@@ -48,6 +48,7 @@
  *                                  backwards compatibility.
  *      121205    D. Dirkx          Migrated namespace to directory-based protocol and added
  *                                  backwards compatibility.
+ *      261018                      Made computeModulo usable with dual numbers.
  *
  *    References
  *      Press W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing. Cambridge
@@ -99,7 +100,9 @@ GlobalRandomNumberGeneratorType& getGlobalRandomNumberGenerator( );
 template< typename ScalarType = double >
 ScalarType computeModulo( const ScalarType dividend, const ScalarType divisor )
 {
-    return dividend - divisor * std::floor( dividend / divisor );
+    using std::floor;
+
+    return dividend - divisor * floor( dividend / divisor );
 }
 
 } // namespace basic_mathematics
@@ -0,0 +1,763 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Defined derivatives of power functions for zero base.
+ *
+ *    References
+ *      Griewank, A., Walther, A. Evaluating Derivatives: Principles and Techniques of
+ *          Algorithmic Differentiation, 2nd edition, SIAM, 2008.
+ *
+ *    Notes
+ *      The mathematical functions for dual numbers are defined as friends of the DualNumber
+ *      class, so that they are found by argument-dependent lookup only. Templated code that is
+ *      to be used with dual numbers must therefore call these functions unqualified, after a
+ *      using-declaration of the standard library function (i.e. using std::sin; sin( x )), in
+ *      the same way as is done in Eigen.
+ *
+ *      No conversion from a dual number to its underlying scalar type is provided, as this would
+ *      silently discard the derivatives.
+ *
+ */
+
+#ifndef TUDAT_DUAL_NUMBER_H
+#define TUDAT_DUAL_NUMBER_H
+
+#include <cmath>
+#include <ostream>
+#include <limits>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+namespace basic_mathematics
+{
+
+//! Dual number class for forward-mode automatic differentiation.
+/*!
+ * Multivariate dual number, consisting of a value and the partial derivatives of this value
+ * w.r.t. a fixed number of independent variables. All arithmetic operations and elementary
+ * functions propagate the derivatives by the chain rule, so that evaluating a function that is
+ * templated on its scalar type with dual numbers yields its value and exact (to round-off)
+ * partial derivatives in a single pass (Griewank & Walther, 2008). The value is computed with the
+ * same operations as for the underlying scalar type, and comparisons only consider the value, so
+ * that the same branches are taken as when evaluating the function with the scalar type.
+ * \tparam NumberOfDerivatives Number of independent variables w.r.t. which derivatives are
+ *          propagated.
+ * \tparam ScalarType Scalar type of value and derivatives (default = double).
+ */
+template< int NumberOfDerivatives, typename ScalarType = double >
+class DualNumber
+{
+public:
+
+    //! Typedef for vector of partial derivatives.
+    /*!
+     * Typedef for vector of partial derivatives. The vector is not aligned, so that dual numbers
+     * (and Eigen matrices of dual numbers) can be stored and allocated without alignment
+     * restrictions.
+     */
+    typedef Eigen::Matrix< ScalarType, NumberOfDerivatives, 1, Eigen::DontAlign >
+    DerivativeVector;
+
+    //! Default constructor.
+    /*!
+     * Default constructor, sets value and derivatives to zero.
+     */
+    DualNumber( )
+        : value_( static_cast< ScalarType >( 0 ) ), derivatives_( DerivativeVector::Zero( ) )
+    { }
+
+    //! Constructor for constant.
+    /*!
+     * Constructor for a constant, i.e. a dual number of which all derivatives are zero. This
+     * constructor is not explicit, so that scalars (and integers, as used in
+     * mathematical_constants::getFloatingInteger) can be used directly in dual number
+     * expressions.
+     * \param value Value of constant.
+     */
+    DualNumber( const ScalarType value )
+        : value_( value ), derivatives_( DerivativeVector::Zero( ) )
+    { }
+
+    //! Constructor for independent variable.
+    /*!
+     * Constructor for an independent variable, i.e. a dual number of which the derivative w.r.t.
+     * itself is one, and all other derivatives are zero.
+     * \param value Value of independent variable.
+     * \param derivativeIndex Index of independent variable in derivative vector.
+     */
+    DualNumber( const ScalarType value, const int derivativeIndex )
+        : value_( value ), derivatives_( DerivativeVector::Unit( derivativeIndex ) )
+    { }
+
+    //! Constructor from value and derivatives.
+    /*!
+     * Constructor from value and partial derivatives.
+     * \param value Value of dual number.
+     * \param derivatives Partial derivatives of dual number.
+     */
+    DualNumber( const ScalarType value, const DerivativeVector& derivatives )
+        : value_( value ), derivatives_( derivatives )
+    { }
+
+    //! Get value.
+    /*!
+     * Returns the value of the dual number.
+     * \return Value of dual number.
+     */
+    ScalarType getValue( ) const { return value_; }
+
+    //! Get partial derivatives.
+    /*!
+     * Returns the partial derivatives of the dual number w.r.t. the independent variables.
+     * \return Partial derivatives of dual number.
+     */
+    const DerivativeVector& getDerivatives( ) const { return derivatives_; }
+
+    //! Get partial derivative.
+    /*!
+     * Returns the partial derivative of the dual number w.r.t. a single independent variable.
+     * \param derivativeIndex Index of independent variable.
+     * \return Partial derivative of dual number.
+     */
+    ScalarType getDerivative( const int derivativeIndex ) const
+    {
+        return derivatives_( derivativeIndex );
+    }
+
+    //! Add dual number to this dual number.
+    DualNumber& operator+=( const DualNumber& dualNumber )
+    {
+        value_ += dualNumber.value_;
+        derivatives_ += dualNumber.derivatives_;
+        return *this;
+    }
+
+    //! Add scalar to this dual number.
+    DualNumber& operator+=( const ScalarType scalar )
+    {
+        value_ += scalar;
+        return *this;
+    }
+
+    //! Subtract dual number from this dual number.
+    DualNumber& operator-=( const DualNumber& dualNumber )
+    {
+        value_ -= dualNumber.value_;
+        derivatives_ -= dualNumber.derivatives_;
+        return *this;
+    }
+
+    //! Subtract scalar from this dual number.
+    DualNumber& operator-=( const ScalarType scalar )
+    {
+        value_ -= scalar;
+        return *this;
+    }
+
+    //! Multiply this dual number by dual number.
+    DualNumber& operator*=( const DualNumber& dualNumber )
+    {
+        derivatives_ = dualNumber.value_ * derivatives_ + value_ * dualNumber.derivatives_;
+        value_ *= dualNumber.value_;
+        return *this;
+    }
+
+    //! Multiply this dual number by scalar.
+    DualNumber& operator*=( const ScalarType scalar )
+    {
+        value_ *= scalar;
+        derivatives_ *= scalar;
+        return *this;
+    }
+
+    //! Divide this dual number by dual number.
+    DualNumber& operator/=( const DualNumber& dualNumber )
+    {
+        value_ /= dualNumber.value_;
+        derivatives_ = ( derivatives_ - value_ * dualNumber.derivatives_ )
+                * ( static_cast< ScalarType >( 1 ) / dualNumber.value_ );
+        return *this;
+    }
+
+    //! Divide this dual number by scalar.
+    DualNumber& operator/=( const ScalarType scalar )
+    {
+        value_ /= scalar;
+        derivatives_ /= scalar;
+        return *this;
+    }
+
+    //! Unary plus operator.
+    friend DualNumber operator+( const DualNumber& dualNumber )
+    {
+        return dualNumber;
+    }
+
+    //! Unary minus operator.
+    friend DualNumber operator-( const DualNumber& dualNumber )
+    {
+        return DualNumber( -dualNumber.value_, -dualNumber.derivatives_ );
+    }
+
+    //! Addition operator.
+    friend DualNumber operator+( const DualNumber& left, const DualNumber& right )
+    {
+        return DualNumber( left.value_ + right.value_, left.derivatives_ + right.derivatives_ );
+    }
+
+    //! Addition operator with scalar right-hand side.
+    friend DualNumber operator+( const DualNumber& left, const ScalarType right )
+    {
+        return DualNumber( left.value_ + right, left.derivatives_ );
+    }
+
+    //! Addition operator with scalar left-hand side.
+    friend DualNumber operator+( const ScalarType left, const DualNumber& right )
+    {
+        return DualNumber( left + right.value_, right.derivatives_ );
+    }
+
+    //! Subtraction operator.
+    friend DualNumber operator-( const DualNumber& left, const DualNumber& right )
+    {
+        return DualNumber( left.value_ - right.value_, left.derivatives_ - right.derivatives_ );
+    }
+
+    //! Subtraction operator with scalar right-hand side.
+    friend DualNumber operator-( const DualNumber& left, const ScalarType right )
+    {
+        return DualNumber( left.value_ - right, left.derivatives_ );
+    }
+
+    //! Subtraction operator with scalar left-hand side.
+    friend DualNumber operator-( const ScalarType left, const DualNumber& right )
+    {
+        return DualNumber( left - right.value_, -right.derivatives_ );
+    }
+
+    //! Multiplication operator.
+    friend DualNumber operator*( const DualNumber& left, const DualNumber& right )
+    {
+        return DualNumber( left.value_ * right.value_,
+                           right.value_ * left.derivatives_ + left.value_ * right.derivatives_ );
+    }
+
+    //! Multiplication operator with scalar right-hand side.
+    friend DualNumber operator*( const DualNumber& left, const ScalarType right )
+    {
+        return DualNumber( left.value_ * right, right * left.derivatives_ );
+    }
+
+    //! Multiplication operator with scalar left-hand side.
+    friend DualNumber operator*( const ScalarType left, const DualNumber& right )
+    {
+        return DualNumber( left * right.value_, left * right.derivatives_ );
+    }
+
+    //! Division operator.
+    friend DualNumber operator/( const DualNumber& left, const DualNumber& right )
+    {
+        const ScalarType quotient = left.value_ / right.value_;
+        return DualNumber( quotient, ( left.derivatives_ - quotient * right.derivatives_ )
+                           * ( static_cast< ScalarType >( 1 ) / right.value_ ) );
+    }
+
+    //! Division operator with scalar right-hand side.
+    friend DualNumber operator/( const DualNumber& left, const ScalarType right )
+    {
+        return DualNumber( left.value_ / right, left.derivatives_ / right );
+    }
+
+    //! Division operator with scalar left-hand side.
+    friend DualNumber operator/( const ScalarType left, const DualNumber& right )
+    {
+        const ScalarType quotient = left / right.value_;
+        return DualNumber( quotient, ( -quotient / right.value_ ) * right.derivatives_ );
+    }
+
+    //! Comparison operators, which compare the values of dual numbers (and scalars) only.
+    friend bool operator==( const DualNumber& left, const DualNumber& right )
+    { return left.value_ == right.value_; }
+    friend bool operator!=( const DualNumber& left, const DualNumber& right )
+    { return left.value_ != right.value_; }
+    friend bool operator<( const DualNumber& left, const DualNumber& right )
+    { return left.value_ < right.value_; }
+    friend bool operator<=( const DualNumber& left, const DualNumber& right )
+    { return left.value_ <= right.value_; }
+    friend bool operator>( const DualNumber& left, const DualNumber& right )
+    { return left.value_ > right.value_; }
+    friend bool operator>=( const DualNumber& left, const DualNumber& right )
+    { return left.value_ >= right.value_; }
+    friend bool operator==( const DualNumber& left, const ScalarType right )
+    { return left.value_ == right; }
+    friend bool operator!=( const DualNumber& left, const ScalarType right )
+    { return left.value_ != right; }
+    friend bool operator<( const DualNumber& left, const ScalarType right )
+    { return left.value_ < right; }
+    friend bool operator<=( const DualNumber& left, const ScalarType right )
+    { return left.value_ <= right; }
+    friend bool operator>( const DualNumber& left, const ScalarType right )
+    { return left.value_ > right; }
+    friend bool operator>=( const DualNumber& left, const ScalarType right )
+    { return left.value_ >= right; }
+    friend bool operator==( const ScalarType left, const DualNumber& right )
+    { return left == right.value_; }
+    friend bool operator!=( const ScalarType left, const DualNumber& right )
+    { return left != right.value_; }
+    friend bool operator<( const ScalarType left, const DualNumber& right )
+    { return left < right.value_; }
+    friend bool operator<=( const ScalarType left, const DualNumber& right )
+    { return left <= right.value_; }
+    friend bool operator>( const ScalarType left, const DualNumber& right )
+    { return left > right.value_; }
+    friend bool operator>=( const ScalarType left, const DualNumber& right )
+    { return left >= right.value_; }
+
+    //! Stream operator, which writes the value of the dual number.
+    friend std::ostream& operator<<( std::ostream& stream, const DualNumber& dualNumber )
+    {
+        stream << dualNumber.value_;
+        return stream;
+    }
+
+    //! Square root function.
+    friend DualNumber sqrt( const DualNumber& dualNumber )
+    {
+        using std::sqrt;
+        const ScalarType squareRoot = sqrt( dualNumber.value_ );
+        return dualNumber.createFromChainRule(
+                    squareRoot, static_cast< ScalarType >( 1 )
+                    / ( static_cast< ScalarType >( 2 ) * squareRoot ) );
+    }
+
+    //! Cube root function.
+    friend DualNumber cbrt( const DualNumber& dualNumber )
+    {
+        using std::cbrt;
+        const ScalarType cubeRoot = cbrt( dualNumber.value_ );
+        return dualNumber.createFromChainRule(
+                    cubeRoot, static_cast< ScalarType >( 1 )
+                    / ( static_cast< ScalarType >( 3 ) * cubeRoot * cubeRoot ) );
+    }
+
+    //! Exponential function.
+    friend DualNumber exp( const DualNumber& dualNumber )
+    {
+        using std::exp;
+        const ScalarType exponential = exp( dualNumber.value_ );
+        return dualNumber.createFromChainRule( exponential, exponential );
+    }
+
+    //! Natural logarithm function.
+    friend DualNumber log( const DualNumber& dualNumber )
+    {
+        using std::log;
+        return dualNumber.createFromChainRule(
+                    log( dualNumber.value_ ), static_cast< ScalarType >( 1 ) / dualNumber.value_ );
+    }
+
+    //! Power function with dual number base and scalar exponent.
+    friend DualNumber pow( const DualNumber& base, const ScalarType exponent )
+    {
+        using std::pow;
+        // Compute derivative without dividing by base, so that it is also defined for zero base.
+        return base.createFromChainRule(
+                    pow( base.value_, exponent ),
+                    exponent * pow( base.value_, exponent - static_cast< ScalarType >( 1 ) ) );
+    }
+
+    //! Power function with scalar base and dual number exponent.
+    friend DualNumber pow( const ScalarType base, const DualNumber& exponent )
+    {
+        using std::log;
+        using std::pow;
+        const ScalarType power = pow( base, exponent.value_ );
+        return exponent.createFromChainRule( power, power * log( base ) );
+    }
+
+    //! Power function with dual number base and exponent.
+    friend DualNumber pow( const DualNumber& base, const DualNumber& exponent )
+    {
+        using std::log;
+        using std::pow;
+        const ScalarType power = pow( base.value_, exponent.value_ );
+        DerivativeVector derivatives
+                = ( exponent.value_ * pow( base.value_,
+                                           exponent.value_ - static_cast< ScalarType >( 1 ) ) )
+                * base.derivatives_;
+
+        // Add logarithmic term only if exponent depends on the variables, since the logarithm is
+        // not defined for a zero (or negative) base.
+        if ( ( exponent.derivatives_.array( ) != static_cast< ScalarType >( 0 ) ).any( ) )
+        {
+            derivatives += ( power * log( base.value_ ) ) * exponent.derivatives_;
+        }
+        return DualNumber( power, derivatives );
+    }
+
+    //! Sine function.
+    friend DualNumber sin( const DualNumber& dualNumber )
+    {
+        using std::cos;
+        using std::sin;
+        return dualNumber.createFromChainRule( sin( dualNumber.value_ ),
+                                               cos( dualNumber.value_ ) );
+    }
+
+    //! Cosine function.
+    friend DualNumber cos( const DualNumber& dualNumber )
+    {
+        using std::cos;
+        using std::sin;
+        return dualNumber.createFromChainRule( cos( dualNumber.value_ ),
+                                               -sin( dualNumber.value_ ) );
+    }
+
+    //! Tangent function.
+    friend DualNumber tan( const DualNumber& dualNumber )
+    {
+        using std::tan;
+        const ScalarType tangent = tan( dualNumber.value_ );
+        return dualNumber.createFromChainRule(
+                    tangent, static_cast< ScalarType >( 1 ) + tangent * tangent );
+    }
+
+    //! Inverse sine function.
+    friend DualNumber asin( const DualNumber& dualNumber )
+    {
+        using std::asin;
+        using std::sqrt;
+        return dualNumber.createFromChainRule(
+                    asin( dualNumber.value_ ), static_cast< ScalarType >( 1 ) / sqrt(
+                        static_cast< ScalarType >( 1 ) - dualNumber.value_ * dualNumber.value_ ) );
+    }
+
+    //! Inverse cosine function.
+    friend DualNumber acos( const DualNumber& dualNumber )
+    {
+        using std::acos;
+        using std::sqrt;
+        return dualNumber.createFromChainRule(
+                    acos( dualNumber.value_ ), static_cast< ScalarType >( -1 ) / sqrt(
+                        static_cast< ScalarType >( 1 ) - dualNumber.value_ * dualNumber.value_ ) );
+    }
+
+    //! Inverse tangent function.
+    friend DualNumber atan( const DualNumber& dualNumber )
+    {
+        using std::atan;
+        return dualNumber.createFromChainRule(
+                    atan( dualNumber.value_ ), static_cast< ScalarType >( 1 ) / (
+                        static_cast< ScalarType >( 1 ) + dualNumber.value_ * dualNumber.value_ ) );
+    }
+
+    //! Two-argument inverse tangent function.
+    friend DualNumber atan2( const DualNumber& y, const DualNumber& x )
+    {
+        using std::atan2;
+        const ScalarType inverseSquaredNorm
+                = static_cast< ScalarType >( 1 ) / ( x.value_ * x.value_ + y.value_ * y.value_ );
+        return DualNumber( atan2( y.value_, x.value_ ),
+                           ( x.value_ * inverseSquaredNorm ) * y.derivatives_
+                           - ( y.value_ * inverseSquaredNorm ) * x.derivatives_ );
+    }
+
+    //! Hyperbolic sine function.
+    friend DualNumber sinh( const DualNumber& dualNumber )
+    {
+        using std::cosh;
+        using std::sinh;
+        return dualNumber.createFromChainRule( sinh( dualNumber.value_ ),
+                                               cosh( dualNumber.value_ ) );
+    }
+
+    //! Hyperbolic cosine function.
+    friend DualNumber cosh( const DualNumber& dualNumber )
+    {
+        using std::cosh;
+        using std::sinh;
+        return dualNumber.createFromChainRule( cosh( dualNumber.value_ ),
+                                               sinh( dualNumber.value_ ) );
+    }
+
+    //! Hyperbolic tangent function.
+    friend DualNumber tanh( const DualNumber& dualNumber )
+    {
+        using std::tanh;
+        const ScalarType hyperbolicTangent = tanh( dualNumber.value_ );
+        return dualNumber.createFromChainRule(
+                    hyperbolicTangent,
+                    static_cast< ScalarType >( 1 ) - hyperbolicTangent * hyperbolicTangent );
+    }
+
+    //! Inverse hyperbolic sine function.
+    friend DualNumber asinh( const DualNumber& dualNumber )
+    {
+        using std::asinh;
+        using std::sqrt;
+        return dualNumber.createFromChainRule(
+                    asinh( dualNumber.value_ ), static_cast< ScalarType >( 1 ) / sqrt(
+                        dualNumber.value_ * dualNumber.value_ + static_cast< ScalarType >( 1 ) ) );
+    }
+
+    //! Inverse hyperbolic cosine function.
+    friend DualNumber acosh( const DualNumber& dualNumber )
+    {
+        using std::acosh;
+        using std::sqrt;
+        return dualNumber.createFromChainRule(
+                    acosh( dualNumber.value_ ), static_cast< ScalarType >( 1 ) / sqrt(
+                        dualNumber.value_ * dualNumber.value_ - static_cast< ScalarType >( 1 ) ) );
+    }
+
+    //! Inverse hyperbolic tangent function.
+    friend DualNumber atanh( const DualNumber& dualNumber )
+    {
+        using std::atanh;
+        return dualNumber.createFromChainRule(
+                    atanh( dualNumber.value_ ), static_cast< ScalarType >( 1 ) / (
+                        static_cast< ScalarType >( 1 ) - dualNumber.value_ * dualNumber.value_ ) );
+    }
+
+    //! Absolute value function.
+    friend DualNumber abs( const DualNumber& dualNumber )
+    {
+        return ( dualNumber.value_ < static_cast< ScalarType >( 0 ) ) ? -dualNumber : dualNumber;
+    }
+
+    //! Absolute value function.
+    friend DualNumber fabs( const DualNumber& dualNumber )
+    {
+        return abs( dualNumber );
+    }
+
+    //! Floor function, of which the derivatives are zero (where defined).
+    friend DualNumber floor( const DualNumber& dualNumber )
+    {
+        using std::floor;
+        return DualNumber( floor( dualNumber.value_ ) );
+    }
+
+    //! Ceiling function, of which the derivatives are zero (where defined).
+    friend DualNumber ceil( const DualNumber& dualNumber )
+    {
+        using std::ceil;
+        return DualNumber( ceil( dualNumber.value_ ) );
+    }
+
+    //! Floating point remainder function.
+    friend DualNumber fmod( const DualNumber& dividend, const DualNumber& divisor )
+    {
+        using std::fmod;
+        using std::trunc;
+        return DualNumber( fmod( dividend.value_, divisor.value_ ),
+                           dividend.derivatives_ - trunc( dividend.value_ / divisor.value_ )
+                           * divisor.derivatives_ );
+    }
+
+    //! Not-a-number check function.
+    friend bool isnan( const DualNumber& dualNumber )
+    {
+        using std::isnan;
+        return isnan( dualNumber.value_ );
+    }
+
+    //! Finiteness check function.
+    friend bool isfinite( const DualNumber& dualNumber )
+    {
+        using std::isfinite;
+        return isfinite( dualNumber.value_ );
+    }
+
+protected:
+
+private:
+
+    //! Create dual number from result of scalar function, using chain rule.
+    /*!
+     * Creates the dual number resulting from applying a scalar function to this dual number,
+     * from the value and derivative of the function at the value of this dual number.
+     * \param functionValue Value of function.
+     * \param functionDerivative Derivative of function.
+     * \return Dual number resulting from applying function to this dual number.
+     */
+    DualNumber createFromChainRule( const ScalarType functionValue,
+                                    const ScalarType functionDerivative ) const
+    {
+        return DualNumber( functionValue, functionDerivative * derivatives_ );
+    }
+
+    //! Value of dual number.
+    ScalarType value_;
+
+    //! Partial derivatives of dual number w.r.t. independent variables.
+    DerivativeVector derivatives_;
+};
+
+//! Create vector of independent dual number variables.
+/*!
+ * Creates a vector of dual numbers with the given values, each of which is an independent
+ * variable, i.e. the derivative of the i-th entry w.r.t. the i-th variable is one, and all other
+ * derivatives are zero. Evaluating a function of this vector gives the Jacobian of the function
+ * (see getDualNumberJacobian).
+ * \param values Values of independent variables.
+ * \return Vector of independent dual number variables.
+ */
+template< int NumberOfDerivatives, typename ScalarType >
+Eigen::Matrix< DualNumber< NumberOfDerivatives, ScalarType >, NumberOfDerivatives, 1 >
+createIndependentDualNumbers( const Eigen::Matrix< ScalarType, NumberOfDerivatives, 1 >& values )
+{
+    Eigen::Matrix< DualNumber< NumberOfDerivatives, ScalarType >, NumberOfDerivatives, 1 >
+            dualNumbers;
+    for ( int i = 0; i < NumberOfDerivatives; i++ )
+    {
+        dualNumbers( i ) = DualNumber< NumberOfDerivatives, ScalarType >( values( i ), i );
+    }
+    return dualNumbers;
+}
+
+//! Get values of vector of dual numbers.
+/*!
+ * Returns the values of a vector of dual numbers.
+ * \param dualNumbers Vector of dual numbers.
+ * \return Values of dual numbers.
+ */
+template< int NumberOfDerivatives, typename ScalarType, int NumberOfRows >
+Eigen::Matrix< ScalarType, NumberOfRows, 1 > getDualNumberValues(
+        const Eigen::Matrix< DualNumber< NumberOfDerivatives, ScalarType >,
+                             NumberOfRows, 1 >& dualNumbers )
+{
+    Eigen::Matrix< ScalarType, NumberOfRows, 1 > values( dualNumbers.rows( ) );
+    for ( int i = 0; i < dualNumbers.rows( ); i++ )
+    {
+        values( i ) = dualNumbers( i ).getValue( );
+    }
+    return values;
+}
+
+//! Get Jacobian from vector of dual numbers.
+/*!
+ * Returns the partial derivatives of a vector of dual numbers, with the derivatives of the i-th
+ * dual number in the i-th row.
+ * \param dualNumbers Vector of dual numbers.
+ * \return Jacobian of dual numbers w.r.t. independent variables.
+ */
+template< int NumberOfDerivatives, typename ScalarType, int NumberOfRows >
+Eigen::Matrix< ScalarType, NumberOfRows, NumberOfDerivatives > getDualNumberJacobian(
+        const Eigen::Matrix< DualNumber< NumberOfDerivatives, ScalarType >,
+                             NumberOfRows, 1 >& dualNumbers )
+{
+    Eigen::Matrix< ScalarType, NumberOfRows, NumberOfDerivatives > jacobian(
+                dualNumbers.rows( ), NumberOfDerivatives );
+    for ( int i = 0; i < dualNumbers.rows( ); i++ )
+    {
+        jacobian.row( i ) = dualNumbers( i ).getDerivatives( ).transpose( );
+    }
+    return jacobian;
+}
+
+} // namespace basic_mathematics
+} // namespace tudat
+
+namespace std
+{
+
+//! Numeric limits of dual number, which are those of its scalar type.
+template< int NumberOfDerivatives, typename ScalarType >
+class numeric_limits< tudat::basic_mathematics::DualNumber< NumberOfDerivatives, ScalarType > >
+        : public numeric_limits< ScalarType >
+{
+public:
+
+    //! Typedef for dual number.
+    typedef tudat::basic_mathematics::DualNumber< NumberOfDerivatives, ScalarType > DualNumber;
+
+    static DualNumber min( ) { return numeric_limits< ScalarType >::min( ); }
+    static DualNumber max( ) { return numeric_limits< ScalarType >::max( ); }
+    static DualNumber lowest( ) { return numeric_limits< ScalarType >::lowest( ); }
+    static DualNumber epsilon( ) { return numeric_limits< ScalarType >::epsilon( ); }
+    static DualNumber round_error( ) { return numeric_limits< ScalarType >::round_error( ); }
+    static DualNumber infinity( ) { return numeric_limits< ScalarType >::infinity( ); }
+    static DualNumber quiet_NaN( ) { return numeric_limits< ScalarType >::quiet_NaN( ); }
+    static DualNumber signaling_NaN( ) { return numeric_limits< ScalarType >::signaling_NaN( ); }
+    static DualNumber denorm_min( ) { return numeric_limits< ScalarType >::denorm_min( ); }
+};
+
+} // namespace std
+
+namespace Eigen
+{
+
+//! Numerical traits of dual number, required to use dual numbers as Eigen scalar type.
+template< int NumberOfDerivatives, typename ScalarType >
+struct NumTraits< tudat::basic_mathematics::DualNumber< NumberOfDerivatives, ScalarType > >
+        : GenericNumTraits< tudat::basic_mathematics::DualNumber< NumberOfDerivatives,
+                                                                  ScalarType > >
+{
+    typedef tudat::basic_mathematics::DualNumber< NumberOfDerivatives, ScalarType > Real;
+    typedef tudat::basic_mathematics::DualNumber< NumberOfDerivatives, ScalarType > NonInteger;
+    typedef tudat::basic_mathematics::DualNumber< NumberOfDerivatives, ScalarType > Literal;
+    typedef tudat::basic_mathematics::DualNumber< NumberOfDerivatives, ScalarType > Nested;
+
+    enum
+    {
+        IsComplex = 0,
+        IsInteger = 0,
+        IsSigned = 1,
+        RequireInitialization = 1,
+        ReadCost = ( NumberOfDerivatives + 1 ) * NumTraits< ScalarType >::ReadCost,
+        AddCost = ( NumberOfDerivatives + 1 ) * NumTraits< ScalarType >::AddCost,
+        MulCost = ( 2 * NumberOfDerivatives + 1 ) * NumTraits< ScalarType >::MulCost
+    };
+
+    static inline int digits10( ) { return NumTraits< ScalarType >::digits10( ); }
+};
+
+//! Traits for binary operations of dual numbers (left) and scalars (right) in Eigen expressions.
+template< int NumberOfDerivatives, typename ScalarType, typename BinaryOperation >
+struct ScalarBinaryOpTraits< tudat::basic_mathematics::DualNumber< NumberOfDerivatives,
+                                                                   ScalarType >,
+                             ScalarType, BinaryOperation >
+{
+    typedef tudat::basic_mathematics::DualNumber< NumberOfDerivatives, ScalarType > ReturnType;
+};
+
+//! Traits for binary operations of scalars (left) and dual numbers (right) in Eigen expressions.
+template< int NumberOfDerivatives, typename ScalarType, typename BinaryOperation >
+struct ScalarBinaryOpTraits< ScalarType,
+                             tudat::basic_mathematics::DualNumber< NumberOfDerivatives,
+                                                                   ScalarType >,
+                             BinaryOperation >
+{
+    typedef tudat::basic_mathematics::DualNumber< NumberOfDerivatives, ScalarType > ReturnType;
+};
+
+} // namespace Eigen
+
+#endif // TUDAT_DUAL_NUMBER_H
@@ -0,0 +1,331 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Reject empty input; added minimum number of columns per thread.
+ *
+ *    References
+ *      Fornberg, B., "Generation of Finite Difference Formulas on Arbitrarily Spaced Grids",
+ *          Mathematics of Computation, October 1988.
+ *      Press W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing. Cambridge
+ *          University Press, February 2002.
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include <boost/exception/all.hpp>
+
+#include "Tudat/Mathematics/BasicMathematics/jacobianEngine.h"
+
+namespace tudat
+{
+namespace numerical_derivatives
+{
+
+//! Get offsets and weights of finite difference scheme.
+void getFiniteDifferenceCoefficients( const FiniteDifferenceScheme scheme, const int order,
+                                      std::vector< int >& offsets,
+                                      std::vector< double >& weights )
+{
+    offsets.clear( );
+    weights.clear( );
+
+    if ( scheme == forwardDifferenceScheme )
+    {
+        switch ( order )
+        {
+        case 1:
+            offsets = { 0, 1 };
+            weights = { -1.0, 1.0 };
+            break;
+        case 2:
+            offsets = { 0, 1, 2 };
+            weights = { -3.0 / 2.0, 2.0, -1.0 / 2.0 };
+            break;
+        case 3:
+            offsets = { 0, 1, 2, 3 };
+            weights = { -11.0 / 6.0, 3.0, -3.0 / 2.0, 1.0 / 3.0 };
+            break;
+        }
+    }
+    else if ( scheme == centralDifferenceScheme )
+    {
+        switch ( order )
+        {
+        case 2:
+            offsets = { -1, 1 };
+            weights = { -1.0 / 2.0, 1.0 / 2.0 };
+            break;
+        case 4:
+            offsets = { -2, -1, 1, 2 };
+            weights = { 1.0 / 12.0, -2.0 / 3.0, 2.0 / 3.0, -1.0 / 12.0 };
+            break;
+        case 6:
+            offsets = { -3, -2, -1, 1, 2, 3 };
+            weights = { -1.0 / 60.0, 3.0 / 20.0, -3.0 / 4.0, 3.0 / 4.0, -3.0 / 20.0, 1.0 / 60.0 };
+            break;
+        case 8:
+            offsets = { -4, -3, -2, -1, 1, 2, 3, 4 };
+            weights = { 1.0 / 280.0, -4.0 / 105.0, 1.0 / 5.0, -4.0 / 5.0,
+                        4.0 / 5.0, -1.0 / 5.0, 4.0 / 105.0, -1.0 / 280.0 };
+            break;
+        }
+    }
+
+    if ( offsets.empty( ) )
+    {
+        std::stringstream errorMessage;
+        errorMessage << "Error, finite difference order " << order
+                     << " is not available for the requested scheme." << std::endl;
+        boost::throw_exception( boost::enable_error_info(
+                                    std::runtime_error( errorMessage.str( ) ) ) );
+    }
+}
+
+//! Constructor.
+FiniteDifferenceJacobianEngine::FiniteDifferenceJacobianEngine(
+        const VectorFunction& function,
+        const FiniteDifferenceScheme scheme,
+        const int order,
+        const int numberOfThreads,
+        const double minimumStep,
+        const double relativeStep )
+    : function_( function ),
+      numberOfThreads_( std::max( 1, numberOfThreads ) ),
+      minimumNumberOfColumnsPerThread_( 4 ),
+      minimumStep_( minimumStep ),
+      relativeStep_( relativeStep ),
+      numberOfFunctionEvaluations_( 0 )
+{
+    getFiniteDifferenceCoefficients( scheme, order, offsets_, weights_ );
+    isBaseFunctionValueUsed_ = ( std::find( offsets_.begin( ), offsets_.end( ), 0 )
+                                 != offsets_.end( ) );
+
+    // Allocate work buffers of all threads.
+    perturbedInputs_.resize( numberOfThreads_ );
+    columnBuffers_.resize( numberOfThreads_ );
+    threadExceptions_.resize( numberOfThreads_ );
+}
+
+//! Compute Jacobian.
+const Eigen::MatrixXd& FiniteDifferenceJacobianEngine::computeJacobian(
+        const Eigen::VectorXd& input )
+{
+    checkInput( input );
+    numberOfFunctionEvaluations_ = 0;
+
+    if ( isBaseFunctionValueUsed_ )
+    {
+        baseFunctionValue_ = function_( input );
+        numberOfFunctionEvaluations_++;
+    }
+
+    computeJacobianFromBasePoint( input );
+    return jacobian_;
+}
+
+//! Compute Jacobian, using given function value at base point.
+const Eigen::MatrixXd& FiniteDifferenceJacobianEngine::computeJacobian(
+        const Eigen::VectorXd& input, const Eigen::VectorXd& baseFunctionValue )
+{
+    checkInput( input );
+    numberOfFunctionEvaluations_ = 0;
+
+    if ( isBaseFunctionValueUsed_ )
+    {
+        baseFunctionValue_ = baseFunctionValue;
+    }
+
+    computeJacobianFromBasePoint( input );
+    return jacobian_;
+}
+
+//! Check input vector.
+void FiniteDifferenceJacobianEngine::checkInput( const Eigen::VectorXd& input )
+{
+    if ( input.rows( ) == 0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, input of finite difference Jacobian engine is empty." ) ) );
+    }
+}
+
+//! Compute Jacobian, with function value at base point already set (if required).
+void FiniteDifferenceJacobianEngine::computeJacobianFromBasePoint( const Eigen::VectorXd& input )
+{
+    const int numberOfInputs = input.rows( );
+    int firstParallelColumn = 0;
+
+    // Set size of Jacobian. If the number of outputs is not known, compute first column on the
+    // calling thread.
+    if ( isBaseFunctionValueUsed_ )
+    {
+        jacobian_.resize( baseFunctionValue_.rows( ), numberOfInputs );
+    }
+    else if ( jacobian_.rows( ) == 0 || jacobian_.cols( ) != numberOfInputs )
+    {
+        computeJacobianColumn( input, 0, 0 );
+        jacobian_.resize( columnBuffers_[ 0 ].rows( ), numberOfInputs );
+        jacobian_.col( 0 ) = columnBuffers_[ 0 ];
+        firstParallelColumn = 1;
+    }
+
+    // Divide columns over threads, such that each thread computes at least the minimum number
+    // of columns, and compute first range on calling thread.
+    const int numberOfColumns = numberOfInputs - firstParallelColumn;
+    const int numberOfUsedThreads = std::max(
+                1, std::min( numberOfThreads_,
+                             numberOfColumns / minimumNumberOfColumnsPerThread_ ) );
+    const int columnsPerThread
+            = ( numberOfColumns + numberOfUsedThreads - 1 ) / numberOfUsedThreads;
+
+    std::vector< std::thread > threads;
+    for ( int thread = 1; thread < numberOfUsedThreads; thread++ )
+    {
+        threads.push_back( std::thread(
+                               &FiniteDifferenceJacobianEngine::computeJacobianColumns, this,
+                               std::cref( input ),
+                               firstParallelColumn + std::min( thread * columnsPerThread,
+                                                               numberOfColumns ),
+                               firstParallelColumn + std::min( ( thread + 1 ) * columnsPerThread,
+                                                               numberOfColumns ),
+                               thread ) );
+    }
+
+    computeJacobianColumns( input, firstParallelColumn,
+                            firstParallelColumn + std::min( columnsPerThread, numberOfColumns ),
+                            0 );
+
+    for ( unsigned int i = 0; i < threads.size( ); i++ )
+    {
+        threads[ i ].join( );
+    }
+
+    // Rethrow exceptions thrown on any of the threads.
+    for ( int thread = 0; thread < numberOfUsedThreads; thread++ )
+    {
+        if ( threadExceptions_[ thread ] )
+        {
+            std::exception_ptr threadException = threadExceptions_[ thread ];
+            threadExceptions_[ thread ] = std::exception_ptr( );
+            std::rethrow_exception( threadException );
+        }
+    }
+
+    // Count number of function evaluations for the perturbed inputs.
+    const int numberOfPerturbedEvaluationsPerColumn
+            = static_cast< int >( offsets_.size( ) ) - ( isBaseFunctionValueUsed_ ? 1 : 0 );
+    numberOfFunctionEvaluations_ += numberOfPerturbedEvaluationsPerColumn * numberOfInputs;
+}
+
+//! Compute column of Jacobian.
+void FiniteDifferenceJacobianEngine::computeJacobianColumn( const Eigen::VectorXd& input,
+                                                            const int column,
+                                                            const int threadIndex )
+{
+    Eigen::VectorXd& perturbedInput = perturbedInputs_[ threadIndex ];
+    Eigen::VectorXd& columnBuffer = columnBuffers_[ threadIndex ];
+    perturbedInput = input;
+
+    // Ensure proper rounding by storing the step in a temporary volatile, see
+    // (Press W.H., et al., 2002).
+    const volatile double temporaryVariable = input( column ) +
+            std::max( minimumStep_, std::fabs( relativeStep_ * input( column ) ) );
+    const double realStepSize = temporaryVariable - input( column );
+
+    // Accumulate weighted function values at all evaluation points.
+    bool isColumnBufferInitialized = false;
+    for ( unsigned int i = 0; i < offsets_.size( ); i++ )
+    {
+        const double weight = weights_[ i ] / realStepSize;
+        if ( offsets_[ i ] == 0 )
+        {
+            if ( isColumnBufferInitialized )
+            {
+                columnBuffer += weight * baseFunctionValue_;
+            }
+            else
+            {
+                columnBuffer = weight * baseFunctionValue_;
+            }
+        }
+        else
+        {
+            perturbedInput( column ) = input( column ) + offsets_[ i ] * realStepSize;
+            if ( isColumnBufferInitialized )
+            {
+                columnBuffer += weight * function_( perturbedInput );
+            }
+            else
+            {
+                columnBuffer = weight * function_( perturbedInput );
+            }
+        }
+        isColumnBufferInitialized = true;
+    }
+}
+
+//! Compute range of columns of Jacobian.
+void FiniteDifferenceJacobianEngine::computeJacobianColumns( const Eigen::VectorXd& input,
+                                                             const int firstColumn,
+                                                             const int endColumn,
+                                                             const int threadIndex )
+{
+    try
+    {
+        for ( int column = firstColumn; column < endColumn; column++ )
+        {
+            computeJacobianColumn( input, column, threadIndex );
+
+            if ( columnBuffers_[ threadIndex ].rows( ) != jacobian_.rows( ) )
+            {
+                boost::throw_exception(
+                            boost::enable_error_info(
+                                std::runtime_error(
+                                    "Error, size of function output is inconsistent in "
+                                    "finite difference Jacobian engine." ) ) );
+            }
+            jacobian_.col( column ) = columnBuffers_[ threadIndex ];
+        }
+    }
+    catch ( ... )
+    {
+        threadExceptions_[ threadIndex ] = std::current_exception( );
+    }
+}
+
+} // namespace numerical_derivatives
+} // namespace tudat
@@ -0,0 +1,323 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Reject empty input; added minimum number of columns per thread.
+ *
+ *    References
+ *      Fornberg, B., "Generation of Finite Difference Formulas on Arbitrarily Spaced Grids",
+ *          Mathematics of Computation, October 1988.
+ *      Press W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing. Cambridge
+ *          University Press, February 2002.
+ *      Martins, J.R.R.A., Sturdza, P., Alonso, J.J., "The Complex-Step Derivative
+ *          Approximation", ACM Transactions on Mathematical Software, 29(3), 245-262, 2003.
+ *
+ *    Notes
+ *      The FiniteDifferenceJacobianEngine evaluates the columns of the Jacobian on a number of
+ *      threads. The function of which the Jacobian is computed must therefore be safe to call
+ *      concurrently from different threads (i.e., it should not modify shared state) if more than
+ *      one thread is used.
+ *
+ */
+
+#ifndef TUDAT_JACOBIAN_ENGINE_H
+#define TUDAT_JACOBIAN_ENGINE_H
+
+#include <algorithm>
+#include <complex>
+#include <exception>
+#include <vector>
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+namespace numerical_derivatives
+{
+
+//! Finite difference schemes available for the computation of Jacobians.
+enum FiniteDifferenceScheme
+{
+    //! Forward differences, of order 1, 2 or 3; using the function value at the base point.
+    forwardDifferenceScheme,
+
+    //! Central differences, of order 2, 4, 6 or 8.
+    centralDifferenceScheme
+};
+
+//! Get offsets and weights of finite difference scheme.
+/*!
+ * Gets the offsets (in units of the step size) and weights of a finite difference
+ * approximation of the first derivative (Fornberg, 1988), such that:
+ * \f[
+ *      f'(x) \approx \frac{1}{h} \sum_{i} w_{i} f( x + k_{i} h )
+ * \f]
+ * \param scheme Finite difference scheme.
+ * \param order Order of the finite difference scheme (1, 2 or 3 for forward differences; 2, 4, 6
+ *          or 8 for central differences).
+ * \param offsets Offsets of the evaluation points, in units of the step size (returned by
+ *          reference).
+ * \param weights Weights of the function values at the evaluation points (returned by
+ *          reference).
+ * \throws std::runtime_error If the order is not available for the requested scheme.
+ */
+void getFiniteDifferenceCoefficients( const FiniteDifferenceScheme scheme, const int order,
+                                      std::vector< int >& offsets,
+                                      std::vector< double >& weights );
+
+//! Finite difference Jacobian engine.
+/*!
+ * Engine for the computation of the Jacobian of a vector function with vector input, using
+ * forward or central finite differences of selectable order. The columns of the Jacobian are
+ * distributed over a user-specified number of threads, and the Jacobian and all work buffers are
+ * allocated once and reused for subsequent calls. The worker threads are created (and joined) in
+ * each call to computeJacobian(); to prevent this overhead from dominating for small Jacobians,
+ * each thread computes at least a minimum number of columns (see
+ * setMinimumNumberOfColumnsPerThread()), so that Jacobians with few columns are computed entirely
+ * on the calling thread. For forward differences, the function value at
+ * the base point is evaluated once for all columns, or can be supplied by the user if it is
+ * already available (e.g., as the residual in a differential correction). The step size for each
+ * element of the input is computed as in computeCentralDifference(), i.e.:
+ * \f[
+ *      h_{j} = \max( h_{min}, | \epsilon x_{j} | )
+ * \f]
+ * rounded such that \f$ x_{j} + h_{j} \f$ is exactly representable (Press et al., 2002).
+ */
+class FiniteDifferenceJacobianEngine
+{
+public:
+
+    //! Typedef for vector function of which the Jacobian is computed.
+    typedef boost::function< Eigen::VectorXd( const Eigen::VectorXd& ) > VectorFunction;
+
+    //! Constructor.
+    /*!
+     * Constructor, sets the function of which the Jacobian is computed, and the settings of the
+     * finite difference scheme.
+     * \param function Function of which the Jacobian is computed.
+     * \param scheme Finite difference scheme (default = central differences).
+     * \param order Order of the finite difference scheme (default = 2).
+     * \param numberOfThreads Number of threads used to evaluate the columns of the Jacobian
+     *          (default = 1).
+     * \param minimumStep Absolute minimum step size (default = 2^-13).
+     * \param relativeStep Relative step size (default = 2^-26).
+     * \throws std::runtime_error If the order is not available for the requested scheme.
+     */
+    FiniteDifferenceJacobianEngine( const VectorFunction& function,
+                                    const FiniteDifferenceScheme scheme = centralDifferenceScheme,
+                                    const int order = 2,
+                                    const int numberOfThreads = 1,
+                                    const double minimumStep = 1.0 / 8192.0,
+                                    const double relativeStep = 1.0 / 67108864.0 );
+
+    //! Compute Jacobian.
+    /*!
+     * Computes the Jacobian of the function at the given input. For forward differences, the
+     * function value at the input is evaluated first.
+     * \param input Input vector at which the Jacobian is computed.
+     * \throws std::runtime_error If the input vector is empty.
+     * \return Jacobian of the function at the input (reference to internal buffer, which is
+     *          overwritten by the next call).
+     */
+    const Eigen::MatrixXd& computeJacobian( const Eigen::VectorXd& input );
+
+    //! Compute Jacobian, using given function value at base point.
+    /*!
+     * Computes the Jacobian of the function at the given input, using the given function value at
+     * the input for forward differences, so that it is not re-evaluated. For central differences,
+     * the function value at the input is not used.
+     * \param input Input vector at which the Jacobian is computed.
+     * \param baseFunctionValue Function value at the input.
+     * \throws std::runtime_error If the input vector is empty.
+     * \return Jacobian of the function at the input (reference to internal buffer, which is
+     *          overwritten by the next call).
+     */
+    const Eigen::MatrixXd& computeJacobian( const Eigen::VectorXd& input,
+                                            const Eigen::VectorXd& baseFunctionValue );
+
+    //! Get function value at base point.
+    /*!
+     * Returns the function value at the input of the last call to computeJacobian(), if it was
+     * evaluated or supplied (i.e., only for forward differences).
+     * \return Function value at base point.
+     */
+    const Eigen::VectorXd& getBaseFunctionValue( ) { return baseFunctionValue_; }
+
+    //! Set minimum number of columns per thread.
+    /*!
+     * Sets the minimum number of columns of the Jacobian that is computed by each thread. The
+     * number of threads that is used is reduced such that each thread computes at least this
+     * number of columns, so that no threads are created for Jacobians with fewer columns than
+     * twice this number.
+     * \param minimumNumberOfColumnsPerThread Minimum number of columns per thread.
+     */
+    void setMinimumNumberOfColumnsPerThread( const int minimumNumberOfColumnsPerThread )
+    {
+        minimumNumberOfColumnsPerThread_ = std::max( 1, minimumNumberOfColumnsPerThread );
+    }
+
+    //! Get number of function evaluations.
+    /*!
+     * Returns the number of function evaluations during the last call to computeJacobian().
+     * \return Number of function evaluations.
+     */
+    int getNumberOfFunctionEvaluations( ) { return numberOfFunctionEvaluations_; }
+
+protected:
+
+private:
+
+    //! Check input vector.
+    /*!
+     * Checks whether the input vector is not empty, and throws an exception otherwise.
+     * \param input Input vector at which the Jacobian is computed.
+     */
+    void checkInput( const Eigen::VectorXd& input );
+
+    //! Compute Jacobian, with function value at base point already set (if required).
+    void computeJacobianFromBasePoint( const Eigen::VectorXd& input );
+
+    //! Compute column of Jacobian.
+    /*!
+     * Computes a single column of the Jacobian, using the work buffers of a given thread, and
+     * stores it in the column buffer of that thread.
+     * \param input Input vector at which the Jacobian is computed.
+     * \param column Index of the column (input element) that is computed.
+     * \param threadIndex Index of the thread, of which the work buffers are used.
+     */
+    void computeJacobianColumn( const Eigen::VectorXd& input, const int column,
+                                const int threadIndex );
+
+    //! Compute range of columns of Jacobian.
+    /*!
+     * Computes a range of columns of the Jacobian, using the work buffers of a given thread. Any
+     * exception thrown by the function is stored, so that it can be rethrown on the calling
+     * thread. This function is used as the worker function of the threads.
+     * \param input Input vector at which the Jacobian is computed.
+     * \param firstColumn Index of first column that is computed.
+     * \param endColumn Index one past the last column that is computed.
+     * \param threadIndex Index of the thread, of which the work buffers are used.
+     */
+    void computeJacobianColumns( const Eigen::VectorXd& input, const int firstColumn,
+                                 const int endColumn, const int threadIndex );
+
+    //! Function of which the Jacobian is computed.
+    VectorFunction function_;
+
+    //! Offsets of the evaluation points, in units of the step size.
+    std::vector< int > offsets_;
+
+    //! Weights of the function values at the evaluation points.
+    std::vector< double > weights_;
+
+    //! Flag indicating whether function value at base point is used by the scheme.
+    bool isBaseFunctionValueUsed_;
+
+    //! Number of threads used to evaluate the columns of the Jacobian.
+    int numberOfThreads_;
+
+    //! Minimum number of columns of the Jacobian computed by each thread.
+    int minimumNumberOfColumnsPerThread_;
+
+    //! Absolute minimum step size.
+    double minimumStep_;
+
+    //! Relative step size.
+    double relativeStep_;
+
+    //! Function value at base point.
+    Eigen::VectorXd baseFunctionValue_;
+
+    //! Jacobian computed during last call to computeJacobian().
+    Eigen::MatrixXd jacobian_;
+
+    //! Perturbed input vectors, one per thread.
+    std::vector< Eigen::VectorXd > perturbedInputs_;
+
+    //! Buffers for the column of the Jacobian that is being computed, one per thread.
+    std::vector< Eigen::VectorXd > columnBuffers_;
+
+    //! Exceptions thrown on each thread during the last call to computeJacobian().
+    std::vector< std::exception_ptr > threadExceptions_;
+
+    //! Number of function evaluations during last call to computeJacobian().
+    int numberOfFunctionEvaluations_;
+};
+
+//! Typedef for shared-pointer to FiniteDifferenceJacobianEngine.
+typedef boost::shared_ptr< FiniteDifferenceJacobianEngine > FiniteDifferenceJacobianEnginePointer;
+
+//! Compute Jacobian using the complex-step method.
+/*!
+ * Computes the Jacobian of a vector function with vector input using the complex-step method
+ * (Martins et al., 2003):
+ * \f[
+ *      \frac{\partial f}{\partial x_{j}} = \frac{\mathrm{Im}[ f( x + i h e_{j} ) ]}{h}
+ * \f]
+ * Since no differences are taken, there is no cancellation error, and a tiny step size can be
+ * used, which results in a Jacobian that is accurate to machine precision. The function must be
+ * templated on its scalar type (or at least be callable with a complex vector), and must be
+ * complex-analytic, i.e., only use operations that have a complex extension (no abs(), or
+ * comparisons, on the perturbed values).
+ * \tparam ComplexVectorFunction Type of function object, which is called with an
+ *          Eigen::VectorXcd and returns an Eigen::VectorXcd.
+ * \param function Function of which the Jacobian is computed.
+ * \param input Input vector at which the Jacobian is computed.
+ * \param stepSize Imaginary step size (default = 1.0e-100).
+ * \return Jacobian of the function at the input.
+ */
+template< typename ComplexVectorFunction >
+Eigen::MatrixXd computeComplexStepJacobian( const ComplexVectorFunction& function,
+                                            const Eigen::VectorXd& input,
+                                            const double stepSize = 1.0e-100 )
+{
+    Eigen::VectorXcd perturbedInput = input.cast< std::complex< double > >( );
+    Eigen::MatrixXd jacobian;
+
+    for ( int column = 0; column < input.rows( ); column++ )
+    {
+        perturbedInput( column ) = std::complex< double >( input( column ), stepSize );
+        const Eigen::VectorXcd perturbedResult = function( perturbedInput );
+        perturbedInput( column ) = input( column );
+
+        // Allocate Jacobian once number of outputs is known.
+        if ( column == 0 )
+        {
+            jacobian.resize( perturbedResult.rows( ), input.rows( ) );
+        }
+        jacobian.col( column ) = perturbedResult.imag( ) / stepSize;
+    }
+
+    return jacobian;
+}
+
+} // namespace numerical_derivatives
+} // namespace tudat
+
+#endif // TUDAT_JACOBIAN_ENGINE_H
@@ -27,6 +27,8 @@
  *      120926    E. Dekens         File created.
  *      121218    S. Billemont      Added output fuctions to display Legendre polynomial data,
  *                                  for debugging.
+ *      261018                      Replaced global caches by thread-local caches, added overloads
+ *                                  taking explicit cache, and added cache statistics.
  *
  *    References
  *
@@ -55,6 +57,15 @@ namespace basic_mathematics
 double computeLegendrePolynomial( const int degree,
                                   const int order,
                                   const double polynomialParameter )
+{
+    return computeLegendrePolynomial( degree, order, polynomialParameter, getLegendreCache( ) );
+}
+
+//! Compute unnormalized associated Legendre polynomial, using given cache.
+double computeLegendrePolynomial( const int degree,
+                                  const int order,
+                                  const double polynomialParameter,
+                                  LegendreCache& legendreCache )
 {
     // If degree or order is negative...
     if ( degree < 0 || order < 0 )
@@ -123,6 +134,16 @@ double computeLegendrePolynomial( const int degree,
 double computeGeodesyLegendrePolynomial( const int degree,
                                          const int order,
                                          const double polynomialParameter )
+{
+    return computeGeodesyLegendrePolynomial( degree, order, polynomialParameter,
+                                             getGeodesyLegendreCache( ) );
+}
+
+//! Compute geodesy-normalized associated Legendre polynomial, using given cache.
+double computeGeodesyLegendrePolynomial( const int degree,
+                                         const int order,
+                                         const double polynomialParameter,
+                                         LegendreCache& geodesyLegendreCache )
 {
     // If degree or order is negative...
     if ( degree < 0 || order < 0 )
@@ -391,6 +412,7 @@ double LegendreCache::getOrElseUpdate(
     // If the requested polynomial was not found in cache, compute polynomial.
     if ( cachedEntry == backendCache.end( ) )
     {
+        numberOfMisses++;
         double legendrePolynomial = legendrePolynomialFunction( degree, order,
                                                                 polynomialParameter );
         // If cache is full, remove the oldest element.
@@ -412,12 +434,78 @@ double LegendreCache::getOrElseUpdate(
     // Else the requested polynomial was found in cache; return polynomial value from cache entry.
     else
     {
+        numberOfHits++;
+        return cachedEntry->second;
+    }
+}
+
+//! Get Legendre polynomial from cache when possible, and from computation using this cache
+//! otherwise.
+double LegendreCache::getOrElseUpdate(
+        const int degree, const int order, const double polynomialParameter,
+        const CachedLegendrePolynomialFunction legendrePolynomialFunction )
+{
+    // Initialize structure with polynomial arguments.
+    Point polynomialArguments( degree, order, polynomialParameter );
+
+    // Initialize cache iterator.
+    CacheTable::iterator cachedEntry = backendCache.find( polynomialArguments );
+
+    // If the requested polynomial was found in cache, return polynomial value from cache entry.
+    if ( cachedEntry != backendCache.end( ) )
+    {
+        numberOfHits++;
         return cachedEntry->second;
     }
+
+    // Else compute polynomial, using this cache for intermediate results.
+    numberOfMisses++;
+    const double legendrePolynomial = legendrePolynomialFunction( degree, order,
+                                                                  polynomialParameter, *this );
+
+    // If cache is full, remove the oldest element.
+    if ( history.full( ) )
+    {
+        backendCache.erase( backendCache.find( history[ 0 ] ) );
+        history.pop_front( );
+    }
+
+    // Insert computed polynomial into cache.
+    backendCache.insert( std::pair< Point, double >( polynomialArguments, legendrePolynomial ) );
+    history.push_back( polynomialArguments );
+
+    return legendrePolynomial;
 }
 
 //! Initialize LegendreCache objects.
-LegendreCache::LegendreCache( ) : history( MAXIMUM_CACHE_ENTRIES ) { }
+LegendreCache::LegendreCache( )
+    : history( MAXIMUM_CACHE_ENTRIES ), numberOfHits( 0 ), numberOfMisses( 0 )
+{ }
+
+//! Initialize LegendreCache objects with given maximum number of entries.
+LegendreCache::LegendreCache( const int maximumNumberOfEntries )
+    : history( maximumNumberOfEntries ), numberOfHits( 0 ), numberOfMisses( 0 )
+{
+    if ( maximumNumberOfEntries < 1 )
+    {
+        boost::throw_exception( boost::enable_error_info( std::runtime_error(
+               "Error: Legendre polynomial cache must have at least one entry." ) ) );
+    }
+}
+
+//! Get cache for unnormalized Legendre polynomials of current thread.
+LegendreCache& getLegendreCache( )
+{
+    static thread_local LegendreCache legendreCache;
+    return legendreCache;
+}
+
+//! Get cache for geodesy-normalized Legendre polynomials of current thread.
+LegendreCache& getGeodesyLegendreCache( )
+{
+    static thread_local LegendreCache geodesyLegendreCache;
+    return geodesyLegendreCache;
+}
 
 //! Write contents of Legendre polynomial structure to string.
 std::string writeLegendrePolynomialStructureToString( const Point legendrePolynomialStructure )
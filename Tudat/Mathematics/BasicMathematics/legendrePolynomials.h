@@ -28,6 +28,8 @@
  *      121218    S. Billemont      Added output fuctions to display Legendre polynomial data,
  *                                  for debugging.
  *      130121    K. Kumar          Added shared-ptr typedefs.
+ *      261018                      Replaced global caches by thread-local caches, added overloads
+ *                                  taking explicit cache, and added cache statistics.
  *
  *    References
  *      Eberly, D. Spherical Harmonics. Help documentation of Geometric Tools, 2008. Available at
@@ -46,6 +48,11 @@
  *    Notes
  *      For information on how the caching mechanism works, please contact S. Billemont
  *      (S.Billemont@studelft.tudelft.nl).
+ *      The functions that do not take a cache as argument use a cache that is local to the
+ *      calling thread (see getLegendreCache() and getGeodesyLegendreCache()), so that they can be
+ *      called concurrently from multiple threads. Alternatively, a LegendreCache object can be
+ *      passed explicitly, which gives the caller full control over its lifetime and size. A single
+ *      LegendreCache object must not be used by multiple threads simultaneously.
  *
  */
 
@@ -85,7 +92,8 @@ namespace basic_mathematics
  *
  * This function has been optimized for repeated calls with varying 'degree' and 'order' arguments
  * (but with identical 'polynomialParameter' argument). To this end the function maintains a
- * back-end cache with intermediate results which is automatically carried over between calls.
+ * back-end cache with intermediate results which is automatically carried over between calls;
+ * each thread uses its own cache.
  * \param degree Degree of requested Legendre polynomial.
  * \param order Order of requested Legendre polynomial.
  * \param polynomialParameter Free variable  of requested Legendre polynomial.
@@ -128,7 +136,8 @@ double computeLegendrePolynomial( const int degree,
  *
  * This function has been optimized for repeated calls with varying 'degree' and 'order' arguments
  * (but with identical 'polynomialParameter' argument). To this end the function maintains a
- * back-end cache with intermediate results which is automatically carried over between calls.
+ * back-end cache with intermediate results which is automatically carried over between calls;
+ * each thread uses its own cache.
  * \param degree Degree of requested Legendre polynomial.
  * \param order Order of requested Legendre polynomial.
  * \param polynomialParameter Free variable of requested Legendre polynomial.
@@ -363,6 +372,10 @@ private:
     //! Define Legendre polynomial function pointer.
     typedef boost::function< double ( int, int, double ) > LegendrePolynomialFunction;
 
+    //! Define pointer to Legendre polynomial function that uses an explicit cache.
+    typedef double ( *CachedLegendrePolynomialFunction )( const int, const int, const double,
+                                                          LegendreCache& );
+
     //! Define map variables type.
     typedef boost::unordered_map< Point, double > CacheTable;
 
@@ -372,8 +385,19 @@ private:
 public:
 
     //! Initialize LegendreCache instance.
+    /*!
+     * Initializes LegendreCache instance, with the maximum number of entries given by
+     * MAXIMUM_CACHE_ENTRIES.
+     */
     LegendreCache( );
 
+    //! Initialize LegendreCache instance with given maximum number of entries.
+    /*!
+     * Initializes LegendreCache instance, with the given maximum number of entries.
+     * \param maximumNumberOfEntries Maximum number of entries in the cache.
+     */
+    explicit LegendreCache( const int maximumNumberOfEntries );
+
     //! Get Legendre polynomial value from either cache or from computation.
     /*!
     * \param degree Degree of requested Legendre polynomial.
@@ -387,6 +411,70 @@ public:
     double getOrElseUpdate( const int degree, const int order, const double polynomialParameter,
                             const LegendrePolynomialFunction legendrePolynomialFunction );
 
+    //! Get Legendre polynomial value from either cache or from computation using this cache.
+    /*!
+    * \param degree Degree of requested Legendre polynomial.
+    * \param order Order of requested Legendre polynomial.
+    * \param polynomialParameter Free variable  of requested Legendre polynomial.
+    * \param legendrePolynomialFunction Function which takes degree, order, polynomialParameter
+    *          and cache as arguments. The function is called with this object as cache, and must
+    *          return the corresponding Legendre polynomial value.
+    * \return Legendre polynomial value.
+    */
+    double getOrElseUpdate( const int degree, const int order, const double polynomialParameter,
+                            const CachedLegendrePolynomialFunction legendrePolynomialFunction );
+
+    //! Get number of cache hits.
+    /*!
+     * Returns the number of requests that were answered from the cache since construction or the
+     * last call to resetStatistics().
+     * \return Number of cache hits.
+     */
+    std::size_t getNumberOfHits( ) const { return numberOfHits; }
+
+    //! Get number of cache misses.
+    /*!
+     * Returns the number of requests that required computation of the polynomial since
+     * construction or the last call to resetStatistics().
+     * \return Number of cache misses.
+     */
+    std::size_t getNumberOfMisses( ) const { return numberOfMisses; }
+
+    //! Get number of entries currently in cache.
+    /*!
+     * Returns the number of polynomial values that are currently stored in the cache.
+     * \return Number of entries in cache.
+     */
+    std::size_t getNumberOfEntries( ) const { return backendCache.size( ); }
+
+    //! Get maximum number of entries in cache.
+    /*!
+     * Returns the maximum number of polynomial values that are stored in the cache, after which
+     * the oldest entries are removed.
+     * \return Maximum number of entries in cache.
+     */
+    std::size_t getMaximumNumberOfEntries( ) const { return history.capacity( ); }
+
+    //! Reset cache statistics.
+    /*!
+     * Resets the number of cache hits and misses to zero.
+     */
+    void resetStatistics( )
+    {
+        numberOfHits = 0;
+        numberOfMisses = 0;
+    }
+
+    //! Clear cache.
+    /*!
+     * Removes all entries from the cache; the statistics are not reset.
+     */
+    void clear( )
+    {
+        backendCache.clear( );
+        history.clear( );
+    }
+
 private:
 
     //! Hashmap which links a specific degree, order and polynomial parameter to its
@@ -395,16 +483,63 @@ private:
 
     //! History buffer.
     CacheHistory history;
+
+    //! Number of requests answered from cache.
+    std::size_t numberOfHits;
+
+    //! Number of requests that required computation.
+    std::size_t numberOfMisses;
 };
 
 //! Typedef shared-pointer to LegendreCache object.
 typedef boost::shared_ptr< LegendreCache > LegendreCachePointer;
 
-//! Global instances of LegendreCache class for unnormalized polynomials.
-static LegendreCache legendreCache;
+//! Get cache for unnormalized Legendre polynomials of current thread.
+/*!
+ * Returns the LegendreCache that is used by computeLegendrePolynomial() when no cache is passed
+ * explicitly. Each thread has its own instance, so that no synchronization is required.
+ * \return Unnormalized Legendre polynomial cache of current thread.
+ */
+LegendreCache& getLegendreCache( );
+
+//! Get cache for geodesy-normalized Legendre polynomials of current thread.
+/*!
+ * Returns the LegendreCache that is used by computeGeodesyLegendrePolynomial() when no cache is
+ * passed explicitly. Each thread has its own instance, so that no synchronization is required.
+ * \return Geodesy-normalized Legendre polynomial cache of current thread.
+ */
+LegendreCache& getGeodesyLegendreCache( );
 
-//! Global instances of LegendreCache class for geodesy-normalized polynomials.
-static LegendreCache geodesyLegendreCache;
+//! Compute unnormalized associated Legendre polynomial, using given cache.
+/*!
+ * Computes unnormalized associated Legendre polynomial, as computeLegendrePolynomial( ), but
+ * uses the given cache for intermediate results, instead of the cache of the current thread.
+ * \param degree Degree of requested Legendre polynomial.
+ * \param order Order of requested Legendre polynomial.
+ * \param polynomialParameter Free variable  of requested Legendre polynomial.
+ * \param legendreCache Cache used for intermediate results.
+ * \return Unnormalized Legendre polynomial.
+ */
+double computeLegendrePolynomial( const int degree,
+                                  const int order,
+                                  const double polynomialParameter,
+                                  LegendreCache& legendreCache );
+
+//! Compute geodesy-normalized associated Legendre polynomial, using given cache.
+/*!
+ * Computes geodesy-normalized associated Legendre polynomial, as
+ * computeGeodesyLegendrePolynomial( ), but uses the given cache for intermediate results, instead
+ * of the cache of the current thread.
+ * \param degree Degree of requested Legendre polynomial.
+ * \param order Order of requested Legendre polynomial.
+ * \param polynomialParameter Free variable of requested Legendre polynomial.
+ * \param geodesyLegendreCache Cache used for intermediate results.
+ * \return Geodesy-normalized Legendre polynomial.
+ */
+double computeGeodesyLegendrePolynomial( const int degree,
+                                         const int order,
+                                         const double polynomialParameter,
+                                         LegendreCache& geodesyLegendreCache );
 
 //! Write contents of Legendre polynomial structure to string.
 /*!
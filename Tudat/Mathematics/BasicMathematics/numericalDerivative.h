@@ -28,6 +28,7 @@
  *      120324    K. Kumar          Made minor layout corrections; updated file header to new
  *                                  standard.
  *      120522    E. Heeren         Modified namespace; minor corrections in comments.
+ *      261018                      Corrected 6th-order central difference coefficients.
  *
  *    References
  *      Press W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing. Cambridge
@@ -94,9 +95,9 @@ const std::map< int, double >& getCentralDifferenceCoefficients( CentralDifferen
         coefficients[ order6 ][ -3 ] = -1.0 / 60.0;
         coefficients[ order6 ][ -2 ] = 3.0 / 20.0;
         coefficients[ order6 ][ -1 ] = -3.0 / 4.0;
-        coefficients[ order6 ][ 1 ] = 1.0 / 60.0;
+        coefficients[ order6 ][ 1 ] = 3.0 / 4.0;
         coefficients[ order6 ][ 2 ] = -3.0 / 20.0;
-        coefficients[ order6 ][ 3 ] = 3.0 / 4.0;
+        coefficients[ order6 ][ 3 ] = 1.0 / 60.0;
 
         coefficients[ order8 ] = std::map< int, double >( );
         coefficients[ order8 ][ -4 ] = 1.0 / 280.0;
@@ -25,6 +25,10 @@
  *    Changelog
  *      YYMMDD    Author            Comment
  *      120926    E. Dekens         File created.
+ *      261018                      Added SphericalHarmonicsWorkspace.
+ *      261018                      Added truncation of workspace update.
+ *      261018                      Made latitude derivatives regular on polar axis, and added
+ *                                  thread-local workspace.
  *
  *    References
  *
@@ -32,7 +36,11 @@
  *
  */
 
+#include <algorithm>
 #include <cmath>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
 
 #include <Eigen/Core>
 
@@ -92,5 +100,204 @@ Eigen::Vector3d computePotentialGradient(
     return potentialGradient;
 }
 
+//! Constructor.
+SphericalHarmonicsWorkspace::SphericalHarmonicsWorkspace( const int maximumDegree,
+                                                          const int maximumOrder )
+    : maximumDegree_( maximumDegree ),
+      maximumOrder_( maximumOrder ),
+      radius_( 0.0 ),
+      sineOfLatitude_( 0.0 ),
+      cosineOfLatitude_( 1.0 ),
+      sineOfLongitude_( 0.0 ),
+      cosineOfLongitude_( 1.0 )
+{
+    if ( maximumDegree_ < 0 || maximumOrder_ < 0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, maximum degree and order of spherical harmonics workspace "
+                            "must be non-negative." ) ) );
+    }
+
+    // Legendre polynomials are computed up to one order higher than requested, since these are
+    // needed for the derivatives.
+    const int numberOfOrders = maximumOrder_ + 2;
+
+    verticalRecurrenceFactors_ = Eigen::MatrixXd::Zero( maximumDegree_ + 1, numberOfOrders );
+    secondVerticalRecurrenceFactors_
+            = Eigen::MatrixXd::Zero( maximumDegree_ + 1, numberOfOrders );
+    sectoralRecurrenceFactors_ = Eigen::VectorXd::Zero( numberOfOrders );
+    derivativeFactors_ = Eigen::MatrixXd::Zero( maximumDegree_ + 1, maximumOrder_ + 1 );
+
+    legendrePolynomials_ = Eigen::MatrixXd::Zero( maximumDegree_ + 1, numberOfOrders );
+    firstOrderLegendrePolynomialsOverCosineOfLatitude_
+            = Eigen::VectorXd::Zero( maximumDegree_ + 1 );
+    legendrePolynomialDerivatives_
+            = Eigen::MatrixXd::Zero( maximumDegree_ + 1, maximumOrder_ + 1 );
+    cosineOfMultipleLongitude_ = Eigen::VectorXd::Zero( maximumOrder_ + 1 );
+    sineOfMultipleLongitude_ = Eigen::VectorXd::Zero( maximumOrder_ + 1 );
+    radiusRatioPowers_ = Eigen::VectorXd::Zero( maximumDegree_ + 1 );
+
+    // Precompute recurrence factors.
+    for ( int order = 1; order < numberOfOrders; order++ )
+    {
+        const double m = static_cast< double >( order );
+        sectoralRecurrenceFactors_( order ) = ( order == 1 ) ?
+                    std::sqrt( 3.0 ) : std::sqrt( ( 2.0 * m + 1.0 ) / ( 2.0 * m ) );
+    }
+
+    for ( int degree = 1; degree <= maximumDegree_; degree++ )
+    {
+        const double n = static_cast< double >( degree );
+        for ( int order = 0; order < degree && order < numberOfOrders; order++ )
+        {
+            const double m = static_cast< double >( order );
+            verticalRecurrenceFactors_( degree, order ) = std::sqrt(
+                        ( 2.0 * n - 1.0 ) * ( 2.0 * n + 1.0 ) / ( ( n - m ) * ( n + m ) ) );
+
+            if ( degree > order + 1 )
+            {
+                secondVerticalRecurrenceFactors_( degree, order ) = std::sqrt(
+                            ( 2.0 * n + 1.0 ) * ( n + m - 1.0 ) * ( n - m - 1.0 )
+                            / ( ( n - m ) * ( n + m ) * ( 2.0 * n - 3.0 ) ) );
+            }
+        }
+
+        for ( int order = 0; order < degree && order <= maximumOrder_; order++ )
+        {
+            const double m = static_cast< double >( order );
+            derivativeFactors_( degree, order ) = std::sqrt( ( n - m ) * ( n + m + 1.0 ) );
+            if ( order == 0 )
+            {
+                derivativeFactors_( degree, order ) *= std::sqrt( 0.5 );
+            }
+        }
+    }
+}
+
+//! Update workspace to new position.
+void SphericalHarmonicsWorkspace::update( const Eigen::Vector3d& cartesianPosition,
+                                          const double referenceRadius,
+                                          const int truncationDegree,
+                                          const int truncationOrder )
+{
+    // Determine degree and order up to which terms are evaluated.
+    const int evaluatedMaximumDegree = ( truncationDegree < 0 )
+            ? maximumDegree_ : std::min( truncationDegree, maximumDegree_ );
+    const int evaluatedMaximumOrder = ( truncationOrder < 0 )
+            ? maximumOrder_ : std::min( truncationOrder, maximumOrder_ );
+
+    // Compute radius, latitude and longitude terms directly from Cartesian position.
+    radius_ = cartesianPosition.norm( );
+    const double distanceFromPolarAxis = std::sqrt(
+                cartesianPosition.x( ) * cartesianPosition.x( )
+                + cartesianPosition.y( ) * cartesianPosition.y( ) );
+    sineOfLatitude_ = cartesianPosition.z( ) / radius_;
+    cosineOfLatitude_ = distanceFromPolarAxis / radius_;
+
+    cosineOfLongitude_ = 1.0;
+    sineOfLongitude_ = 0.0;
+    if ( distanceFromPolarAxis > 0.0 )
+    {
+        cosineOfLongitude_ = cartesianPosition.x( ) / distanceFromPolarAxis;
+        sineOfLongitude_ = cartesianPosition.y( ) / distanceFromPolarAxis;
+    }
+
+    // Compute powers of radius ratio.
+    const double radiusRatio = referenceRadius / radius_;
+    radiusRatioPowers_( 0 ) = 1.0;
+    for ( int degree = 1; degree <= evaluatedMaximumDegree; degree++ )
+    {
+        radiusRatioPowers_( degree ) = radiusRatioPowers_( degree - 1 ) * radiusRatio;
+    }
+
+    // Compute multiple-angle trigonometric terms of longitude.
+    cosineOfMultipleLongitude_( 0 ) = 1.0;
+    sineOfMultipleLongitude_( 0 ) = 0.0;
+    for ( int order = 1; order <= evaluatedMaximumOrder; order++ )
+    {
+        cosineOfMultipleLongitude_( order )
+                = cosineOfMultipleLongitude_( order - 1 ) * cosineOfLongitude_
+                - sineOfMultipleLongitude_( order - 1 ) * sineOfLongitude_;
+        sineOfMultipleLongitude_( order )
+                = sineOfMultipleLongitude_( order - 1 ) * cosineOfLongitude_
+                + cosineOfMultipleLongitude_( order - 1 ) * sineOfLongitude_;
+    }
+
+    // Compute Legendre polynomials column-wise, starting each column from the sectoral term.
+    const int highestOrder = std::min( evaluatedMaximumOrder + 1, evaluatedMaximumDegree );
+    legendrePolynomials_( 0, 0 ) = 1.0;
+    for ( int order = 0; order <= highestOrder; order++ )
+    {
+        if ( order > 0 )
+        {
+            legendrePolynomials_( order, order ) = sectoralRecurrenceFactors_( order )
+                    * cosineOfLatitude_ * legendrePolynomials_( order - 1, order - 1 );
+        }
+
+        if ( order < evaluatedMaximumDegree )
+        {
+            legendrePolynomials_( order + 1, order ) = verticalRecurrenceFactors_(
+                        order + 1, order ) * sineOfLatitude_
+                    * legendrePolynomials_( order, order );
+        }
+
+        for ( int degree = order + 2; degree <= evaluatedMaximumDegree; degree++ )
+        {
+            legendrePolynomials_( degree, order )
+                    = verticalRecurrenceFactors_( degree, order ) * sineOfLatitude_
+                    * legendrePolynomials_( degree - 1, order )
+                    - secondVerticalRecurrenceFactors_( degree, order )
+                    * legendrePolynomials_( degree - 2, order );
+        }
+    }
+
+    // Compute Legendre polynomials of order one divided by cosine of latitude, which are regular
+    // on the polar axis, with the same recurrence, starting from P_{1,1} / cos( latitude ).
+    if ( evaluatedMaximumDegree > 0 )
+    {
+        firstOrderLegendrePolynomialsOverCosineOfLatitude_( 1 ) = sectoralRecurrenceFactors_( 1 );
+        for ( int degree = 2; degree <= evaluatedMaximumDegree; degree++ )
+        {
+            firstOrderLegendrePolynomialsOverCosineOfLatitude_( degree )
+                    = verticalRecurrenceFactors_( degree, 1 ) * sineOfLatitude_
+                    * firstOrderLegendrePolynomialsOverCosineOfLatitude_( degree - 1 )
+                    - secondVerticalRecurrenceFactors_( degree, 1 )
+                    * firstOrderLegendrePolynomialsOverCosineOfLatitude_( degree - 2 );
+        }
+    }
+
+    // Compute derivatives of Legendre polynomials w.r.t. latitude.
+    for ( int degree = 0; degree <= evaluatedMaximumDegree; degree++ )
+    {
+        legendrePolynomialDerivatives_( degree, 0 )
+                = derivativeFactors_( degree, 0 ) * legendrePolynomials_( degree, 1 );
+        for ( int order = 1; order <= degree && order <= evaluatedMaximumOrder; order++ )
+        {
+            legendrePolynomialDerivatives_( degree, order )
+                    = derivativeFactors_( degree, order )
+                    * legendrePolynomials_( degree, order + 1 )
+                    - static_cast< double >( order ) * sineOfLatitude_
+                    * getLegendrePolynomialOverCosineOfLatitude( degree, order );
+        }
+    }
+}
+
+//! Get spherical harmonics workspace of current thread.
+SphericalHarmonicsWorkspace& getSphericalHarmonicsWorkspace( const int maximumDegree,
+                                                             const int maximumOrder )
+{
+    static thread_local SphericalHarmonicsWorkspace sphericalHarmonicsWorkspace( 0, 0 );
+    if ( sphericalHarmonicsWorkspace.getMaximumDegree( ) < maximumDegree
+         || sphericalHarmonicsWorkspace.getMaximumOrder( ) < maximumOrder )
+    {
+        sphericalHarmonicsWorkspace = SphericalHarmonicsWorkspace(
+                    std::max( maximumDegree, sphericalHarmonicsWorkspace.getMaximumDegree( ) ),
+                    std::max( maximumOrder, sphericalHarmonicsWorkspace.getMaximumOrder( ) ) );
+    }
+    return sphericalHarmonicsWorkspace;
+}
+
 } // namespace basic_mathematics
 } // namespace tudat
@@ -25,8 +25,16 @@
  *    Changelog
  *      YYMMDD    Author            Comment
  *      120926    E. Dekens         File created.
+ *      261018                      Added SphericalHarmonicsWorkspace for single-pass evaluation of
+ *                                  Legendre polynomials and trigonometric terms.
+ *      261018                      Added truncation of workspace update.
+ *      261018                      Made latitude derivatives regular on polar axis, and added
+ *                                  thread-local workspace.
  *
  *    References
+ *      Holmes, S.A., Featherstone, W.E. A unified approach to the Clenshaw summation and the
+ *          recursive computation of very high degree and order normalised associated Legendre
+ *          functions, Journal of Geodesy, 76, 279-299, 2002.
  *
  *    Notes
  *
@@ -35,6 +43,8 @@
 #ifndef TUDAT_SPHERICAL_HARMONICS_H
 #define TUDAT_SPHERICAL_HARMONICS_H
 
+#include <boost/shared_ptr.hpp>
+
 #include <Eigen/Core>
 
 namespace tudat
@@ -110,6 +120,273 @@ Eigen::Vector3d computePotentialGradient( const Eigen::Vector3d& sphericalPositi
                                           const double legendrePolynomial,
                                           const double legendrePolynomialDerivative );
 
+//! Workspace for single-pass evaluation of geodesy-normalized spherical harmonics terms.
+/*!
+ * This class evaluates, in a single pass, all quantities that are required to sum a spherical
+ * harmonics expansion up to a given maximum degree and order at a given position: the
+ * geodesy-normalized associated Legendre polynomials \f$ \bar{P}_{n,m}( \sin\phi ) \f$, their
+ * derivatives w.r.t. latitude, \f$ \cos( m \lambda ) \f$, \f$ \sin( m \lambda ) \f$ and
+ * \f$ ( R / r )^{ n } \f$. The Legendre polynomials are computed column-wise (i.e. per order)
+ * using the standard forward column recurrences (Holmes & Featherstone, 2002):
+ * \f{eqnarray*}{
+ *     \bar{P}_{m,m} &=& \sqrt{ \frac{ 2m + 1 }{ 2m } } \cos\phi \bar{P}_{m-1,m-1} \\
+ *     \bar{P}_{n,m} &=& a_{n,m} \sin\phi \bar{P}_{n-1,m} - b_{n,m} \bar{P}_{n-2,m}
+ * \f}
+ * with \f$ \bar{P}_{0,0} = 1 \f$, \f$ \bar{P}_{1,1} = \sqrt{ 3 } \cos\phi \f$ and
+ * \f[
+ *     a_{n,m} = \sqrt{ \frac{ ( 2n - 1 )( 2n + 1 ) }{ ( n - m )( n + m ) } } \qquad
+ *     b_{n,m} = \sqrt{ \frac{ ( 2n + 1 )( n + m - 1 )( n - m - 1 ) }
+ *                           { ( n - m )( n + m )( 2n - 3 ) } }
+ * \f]
+ * No extended-range scaling (as proposed by Holmes & Featherstone, 2002) is applied, so that the
+ * sectoral terms may underflow for orders above approximately 1000 close to the poles. The
+ * derivatives w.r.t. latitude are computed from
+ * \f[
+ *     \frac{ d\bar{P}_{n,m} }{ d\phi } = \sqrt{ ( n - m )( n + m + 1 ) } \bar{P}_{n,m+1}
+ *         - m \sin\phi \frac{ \bar{P}_{n,m} }{ \cos\phi }
+ * \f]
+ * (with an additional factor \f$ \sqrt{ 1 / 2 } \f$ for m = 0), in which the ratio of the
+ * Legendre polynomial and the cosine of latitude is computed with its own recurrence for m = 1,
+ * so that the derivatives are regular on the polar axis. The trigonometric terms are computed
+ * using the angle-addition recurrence, starting from the Cartesian position, so that no
+ * trigonometric functions need to be called. All normalization factors are precomputed when the
+ * workspace is constructed, so that an object of this class should be created once per
+ * expansion, and reused for each evaluation (see also getSphericalHarmonicsWorkspace( )).
+ */
+class SphericalHarmonicsWorkspace
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, allocates memory and precomputes all normalization factors for the given
+     * maximum degree and order.
+     * \param maximumDegree Maximum degree of spherical harmonics terms that are evaluated.
+     * \param maximumOrder Maximum order of spherical harmonics terms that are evaluated.
+     */
+    SphericalHarmonicsWorkspace( const int maximumDegree, const int maximumOrder );
+
+    //! Update workspace to new position.
+    /*!
+     * Computes the Legendre polynomials, their derivatives, trigonometric terms and radius
+     * ratio powers at the given position, up to the maximum degree and order, or up to the
+     * given (lower) truncation degree and order. In the latter case, only the terms up to the
+     * truncation degree and order are valid after the update.
+     * \param cartesianPosition Cartesian position, in the frame in which the spherical harmonics
+     *          expansion is defined.
+     * \param referenceRadius Reference radius of the spherical harmonics expansion.
+     * \param truncationDegree Degree up to which terms are evaluated; a negative value denotes
+     *          the maximum degree of the workspace (default = -1).
+     * \param truncationOrder Order up to which terms are evaluated; a negative value denotes
+     *          the maximum order of the workspace (default = -1).
+     */
+    void update( const Eigen::Vector3d& cartesianPosition, const double referenceRadius,
+                 const int truncationDegree = -1, const int truncationOrder = -1 );
+
+    //! Get maximum degree.
+    /*!
+     * Returns the maximum degree for which the workspace computes terms.
+     * \return Maximum degree.
+     */
+    int getMaximumDegree( ) const { return maximumDegree_; }
+
+    //! Get maximum order.
+    /*!
+     * Returns the maximum order for which the workspace computes terms.
+     * \return Maximum order.
+     */
+    int getMaximumOrder( ) const { return maximumOrder_; }
+
+    //! Get geodesy-normalized Legendre polynomial.
+    /*!
+     * Returns geodesy-normalized Legendre polynomial of sine of latitude, at the position of the
+     * last update. The polynomial is zero if the order exceeds the degree.
+     * \param degree Degree of polynomial.
+     * \param order Order of polynomial.
+     * \return Legendre polynomial.
+     */
+    double getLegendrePolynomial( const int degree, const int order ) const
+    {
+        return legendrePolynomials_( degree, order );
+    }
+
+    //! Get derivative of geodesy-normalized Legendre polynomial w.r.t. latitude.
+    /*!
+     * Returns derivative of geodesy-normalized Legendre polynomial w.r.t. latitude (i.e. not
+     * w.r.t. the sine of latitude), at the position of the last update.
+     * \param degree Degree of polynomial.
+     * \param order Order of polynomial.
+     * \return Derivative of Legendre polynomial w.r.t. latitude.
+     */
+    double getLegendrePolynomialDerivative( const int degree, const int order ) const
+    {
+        return legendrePolynomialDerivatives_( degree, order );
+    }
+
+    //! Get ratio of geodesy-normalized Legendre polynomial and cosine of latitude.
+    /*!
+     * Returns geodesy-normalized Legendre polynomial of sine of latitude, divided by cosine of
+     * latitude, at the position of the last update. For orders of at least one, this ratio is
+     * regular on the polar axis, where its limit is returned.
+     * \param degree Degree of polynomial.
+     * \param order Order of polynomial; must be at least one.
+     * \return Ratio of Legendre polynomial and cosine of latitude.
+     */
+    double getLegendrePolynomialOverCosineOfLatitude( const int degree, const int order ) const
+    {
+        if ( order == 1 )
+        {
+            return firstOrderLegendrePolynomialsOverCosineOfLatitude_( degree );
+        }
+
+        // Polynomials of order two and higher contain at least the square of the cosine of
+        // latitude as factor, so that the limit on the polar axis is zero.
+        return ( cosineOfLatitude_ > 0.0 )
+                ? legendrePolynomials_( degree, order ) / cosineOfLatitude_ : 0.0;
+    }
+
+    //! Get cosine of order times longitude.
+    /*!
+     * Returns cosine of order times longitude, at the position of the last update.
+     * \param order Order.
+     * \return Cosine of order times longitude.
+     */
+    double getCosineOfMultipleLongitude( const int order ) const
+    {
+        return cosineOfMultipleLongitude_( order );
+    }
+
+    //! Get sine of order times longitude.
+    /*!
+     * Returns sine of order times longitude, at the position of the last update.
+     * \param order Order.
+     * \return Sine of order times longitude.
+     */
+    double getSineOfMultipleLongitude( const int order ) const
+    {
+        return sineOfMultipleLongitude_( order );
+    }
+
+    //! Get power of ratio of reference radius and radius.
+    /*!
+     * Returns ratio of reference radius and radius to the power degree, at the position of the
+     * last update.
+     * \param degree Degree.
+     * \return (R/r)^degree.
+     */
+    double getRadiusRatioPower( const int degree ) const
+    {
+        return radiusRatioPowers_( degree );
+    }
+
+    //! Get radius.
+    /*!
+     * Returns radial distance of the position of the last update.
+     * \return Radius.
+     */
+    double getRadius( ) const { return radius_; }
+
+    //! Get sine of latitude.
+    /*!
+     * Returns sine of latitude of the position of the last update.
+     * \return Sine of latitude.
+     */
+    double getSineOfLatitude( ) const { return sineOfLatitude_; }
+
+    //! Get cosine of latitude.
+    /*!
+     * Returns cosine of latitude of the position of the last update.
+     * \return Cosine of latitude.
+     */
+    double getCosineOfLatitude( ) const { return cosineOfLatitude_; }
+
+    //! Get sine of longitude.
+    /*!
+     * Returns sine of longitude of the position of the last update (zero on the polar axis).
+     * \return Sine of longitude.
+     */
+    double getSineOfLongitude( ) const { return sineOfLongitude_; }
+
+    //! Get cosine of longitude.
+    /*!
+     * Returns cosine of longitude of the position of the last update (one on the polar axis).
+     * \return Cosine of longitude.
+     */
+    double getCosineOfLongitude( ) const { return cosineOfLongitude_; }
+
+protected:
+
+private:
+
+    //! Maximum degree of spherical harmonics terms.
+    int maximumDegree_;
+
+    //! Maximum order of spherical harmonics terms.
+    int maximumOrder_;
+
+    //! Factors a_{n,m} of vertical Legendre polynomial recurrence.
+    Eigen::MatrixXd verticalRecurrenceFactors_;
+
+    //! Factors b_{n,m} of vertical Legendre polynomial recurrence.
+    Eigen::MatrixXd secondVerticalRecurrenceFactors_;
+
+    //! Factors of sectoral Legendre polynomial recurrence, per order.
+    Eigen::VectorXd sectoralRecurrenceFactors_;
+
+    //! Factors with which P_{n,m+1} is multiplied to obtain latitude derivative of P_{n,m}.
+    Eigen::MatrixXd derivativeFactors_;
+
+    //! Geodesy-normalized Legendre polynomials (up to order maximumOrder + 1).
+    Eigen::MatrixXd legendrePolynomials_;
+
+    //! Geodesy-normalized Legendre polynomials of order one, divided by cosine of latitude.
+    Eigen::VectorXd firstOrderLegendrePolynomialsOverCosineOfLatitude_;
+
+    //! Derivatives of geodesy-normalized Legendre polynomials w.r.t. latitude.
+    Eigen::MatrixXd legendrePolynomialDerivatives_;
+
+    //! Cosines of order times longitude.
+    Eigen::VectorXd cosineOfMultipleLongitude_;
+
+    //! Sines of order times longitude.
+    Eigen::VectorXd sineOfMultipleLongitude_;
+
+    //! Powers of ratio of reference radius and radius.
+    Eigen::VectorXd radiusRatioPowers_;
+
+    //! Radius at last update.
+    double radius_;
+
+    //! Sine of latitude at last update.
+    double sineOfLatitude_;
+
+    //! Cosine of latitude at last update.
+    double cosineOfLatitude_;
+
+    //! Sine of longitude at last update.
+    double sineOfLongitude_;
+
+    //! Cosine of longitude at last update.
+    double cosineOfLongitude_;
+};
+
+//! Typedef for shared-pointer to SphericalHarmonicsWorkspace.
+typedef boost::shared_ptr< SphericalHarmonicsWorkspace > SphericalHarmonicsWorkspacePointer;
+
+//! Get spherical harmonics workspace of current thread.
+/*!
+ * Returns workspace of the current thread, with a maximum degree and order of at least the given
+ * values. The workspace is only reallocated if it is smaller than requested, so that functions
+ * to which no workspace is passed explicitly do not recompute the normalization factors at each
+ * call. Each thread has its own instance, so that no synchronization is required. Since the
+ * workspace may be larger than requested, it should be updated with truncation degree and order.
+ * \param maximumDegree Minimum required maximum degree of workspace.
+ * \param maximumOrder Minimum required maximum order of workspace.
+ * \return Spherical harmonics workspace of current thread.
+ */
+SphericalHarmonicsWorkspace& getSphericalHarmonicsWorkspace( const int maximumDegree,
+                                                             const int maximumOrder );
+
 } // namespace basic_mathematics
 } // namespace tudat
 
@@ -0,0 +1,295 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      Unit test created.
+ *      261018                      Added test of quaternion continuity at segment boundaries.
+ *
+ *    References
+ *      Mason, J.C., Handscomb, D.C. Chebyshev Polynomials. Chapman & Hall/CRC, 2003.
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/math/special_functions/bessel.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+#include "Tudat/Mathematics/Interpolators/chebyshevApproximation.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Angular frequency of test functions [rad/s].
+const double testAngularFrequency = 2.0 * mathematical_constants::PI / 5400.0;
+
+//! Get value of vector test function.
+Eigen::VectorXd getTestFunctionValue( const double time )
+{
+    Eigen::VectorXd value( 2 );
+    value << 7.0E3 * std::cos( testAngularFrequency * time ),
+            std::sin( 2.0 * testAngularFrequency * time ) + 1.0E-4 * time;
+    return value;
+}
+
+//! Get first derivative of vector test function.
+Eigen::VectorXd getTestFunctionDerivative( const double time )
+{
+    Eigen::VectorXd derivative( 2 );
+    derivative << -7.0E3 * testAngularFrequency * std::sin( testAngularFrequency * time ),
+            2.0 * testAngularFrequency * std::cos( 2.0 * testAngularFrequency * time ) + 1.0E-4;
+    return derivative;
+}
+
+//! Get second derivative of vector test function.
+Eigen::VectorXd getTestFunctionSecondDerivative( const double time )
+{
+    Eigen::VectorXd secondDerivative( 2 );
+    secondDerivative << -7.0E3 * testAngularFrequency * testAngularFrequency
+                        * std::cos( testAngularFrequency * time ),
+            -4.0 * testAngularFrequency * testAngularFrequency
+            * std::sin( 2.0 * testAngularFrequency * time );
+    return secondDerivative;
+}
+
+//! Get test rotation, with sign of quaternion changing every 1000 s.
+Eigen::Quaterniond getTestRotation( const double time )
+{
+    Eigen::Quaterniond rotation(
+                Eigen::AngleAxisd( testAngularFrequency * time,
+                                   Eigen::Vector3d( 0.2, -0.4, 1.0 ).normalized( ) )
+                * Eigen::AngleAxisd( 0.4, Eigen::Vector3d::UnitX( ) ) );
+    if ( static_cast< int >( std::floor( time / 1000.0 ) ) % 2 == 1 )
+    {
+        rotation.coeffs( ) *= -1.0;
+    }
+    return rotation;
+}
+
+BOOST_AUTO_TEST_SUITE( test_chebyshev_approximation )
+
+//! Test Chebyshev coefficients and series evaluation for exponential function.
+BOOST_AUTO_TEST_CASE( testChebyshevSeriesOfExponential )
+{
+    using namespace interpolators;
+
+    // Fit exponential on [-1, 1], of which the Chebyshev coefficients are 2 I_k( 1 )
+    // (Mason & Handscomb, 2003).
+    const int numberOfCoefficients = 16;
+    const Eigen::VectorXd nodes = computeChebyshevNodes( -1.0, 1.0, numberOfCoefficients );
+    const Eigen::MatrixXd valuesAtNodes = nodes.array( ).exp( ).matrix( ).transpose( );
+    const Eigen::MatrixXd coefficients = computeChebyshevCoefficients( valuesAtNodes );
+
+    BOOST_CHECK_EQUAL( coefficients.rows( ), 1 );
+    BOOST_CHECK_EQUAL( coefficients.cols( ), numberOfCoefficients );
+    for ( int k = 0; k < numberOfCoefficients; k++ )
+    {
+        const double expectedCoefficient = ( k == 0 ? 1.0 : 2.0 )
+                * boost::math::cyl_bessel_i( k, 1.0 );
+        BOOST_CHECK_SMALL( coefficients( 0, k ) - expectedCoefficient, 1.0E-15 );
+    }
+
+    // Check series evaluation of function and its derivative.
+    const Eigen::VectorXd scalarCoefficients = coefficients.row( 0 ).transpose( );
+    const Eigen::MatrixXd derivativeCoefficients
+            = computeChebyshevDerivativeCoefficients( coefficients );
+    for ( int i = 0; i <= 20; i++ )
+    {
+        const double x = -1.0 + 0.1 * static_cast< double >( i );
+        BOOST_CHECK_CLOSE_FRACTION( evaluateChebyshevSeries( scalarCoefficients, x ),
+                                    std::exp( x ), 5.0E-15 );
+        BOOST_CHECK_CLOSE_FRACTION( evaluateVectorChebyshevSeries( coefficients, x )( 0 ),
+                                    std::exp( x ), 5.0E-15 );
+        BOOST_CHECK_CLOSE_FRACTION(
+                    evaluateVectorChebyshevSeries( derivativeCoefficients, x )( 0 ), std::exp( x ),
+                    2.0E-13 );
+    }
+}
+
+//! Test adaptive piecewise Chebyshev approximation and its derivatives.
+BOOST_AUTO_TEST_CASE( testAdaptiveChebyshevApproximation )
+{
+    using namespace interpolators;
+
+    const double lowerBound = -1.0E3;
+    const double upperBound = 86400.0;
+    const double tolerance = 1.0E-10;
+
+    ChebyshevApproximation approximation = createChebyshevApproximation(
+                &getTestFunctionValue, lowerBound, upperBound, tolerance );
+    BOOST_CHECK( approximation.getNumberOfSegments( ) > 1 );
+    BOOST_CHECK_EQUAL( approximation.getNumberOfComponents( ), 2 );
+    BOOST_CHECK_EQUAL( approximation.getSegmentBoundaries( ).front( ), lowerBound );
+    BOOST_CHECK_EQUAL( approximation.getSegmentBoundaries( ).back( ), upperBound );
+
+    ChebyshevApproximation derivativeApproximation
+            = approximation.computeDerivativeApproximation( );
+    ChebyshevApproximation secondDerivativeApproximation
+            = derivativeApproximation.computeDerivativeApproximation( );
+
+    // Check approximations in forward and backward order, to exercise segment look-up.
+    for ( int direction = 0; direction < 2; direction++ )
+    {
+        for ( int i = 0; i <= 10000; i++ )
+        {
+            const double time = lowerBound + ( upperBound - lowerBound )
+                    * static_cast< double >( direction == 0 ? i : 10000 - i ) / 10000.0;
+
+            const Eigen::VectorXd valueError
+                    = approximation.evaluate( time ) - getTestFunctionValue( time );
+            const Eigen::VectorXd derivativeError = derivativeApproximation.evaluate( time )
+                    - getTestFunctionDerivative( time );
+            const Eigen::VectorXd secondDerivativeError
+                    = secondDerivativeApproximation.evaluate( time )
+                    - getTestFunctionSecondDerivative( time );
+
+            // Error estimate of segments is approximate, so that tolerance may be slightly
+            // exceeded.
+            BOOST_CHECK_SMALL( valueError.cwiseAbs( ).maxCoeff( ), 2.0 * tolerance );
+            BOOST_CHECK_SMALL( derivativeError.cwiseAbs( ).maxCoeff( ), 5.0E-11 );
+            BOOST_CHECK_SMALL( secondDerivativeError.cwiseAbs( ).maxCoeff( ), 2.0E-12 );
+        }
+    }
+
+    // Check that binary search look-up gives identical results.
+    ChebyshevApproximation binarySearchApproximation(
+                approximation.getSegmentBoundaries( ), approximation.getSegmentCoefficients( ),
+                binarySearch );
+    for ( int i = 0; i <= 100; i++ )
+    {
+        const double time = upperBound - 873.1 * static_cast< double >( i );
+        BOOST_CHECK( binarySearchApproximation.evaluate( time ) == approximation.evaluate( time ) );
+    }
+}
+
+//! Test Chebyshev approximation of quaternion with discontinuous sign.
+BOOST_AUTO_TEST_CASE( testQuaternionChebyshevApproximation )
+{
+    using namespace interpolators;
+
+    ChebyshevApproximation approximation = createQuaternionChebyshevApproximation(
+                &getTestRotation, 0.0, 20000.0, 1.0E-12 );
+    BOOST_CHECK_EQUAL( approximation.getNumberOfComponents( ), 4 );
+
+    for ( int i = 0; i <= 2000; i++ )
+    {
+        const double time = 10.0 * static_cast< double >( i );
+        BOOST_CHECK_SMALL( approximation.evaluateQuaternion( time ).angularDistance(
+                               getTestRotation( time ) ), 1.0E-11 );
+    }
+
+    // Check that quaternion components are continuous at segment boundaries, i.e., that the value
+    // at the upper end of each segment (sum of coefficients) equals that at the lower end of the
+    // next segment (alternating sum of coefficients).
+    const std::vector< Eigen::MatrixXd >& segmentCoefficients
+            = approximation.getSegmentCoefficients( );
+    BOOST_CHECK( segmentCoefficients.size( ) > 1 );
+    for ( unsigned int i = 1; i < segmentCoefficients.size( ); i++ )
+    {
+        const Eigen::VectorXd previousSegmentEndValue
+                = segmentCoefficients[ i - 1 ].rowwise( ).sum( );
+        Eigen::VectorXd segmentStartValue = Eigen::VectorXd::Zero( 4 );
+        for ( int k = 0; k < segmentCoefficients[ i ].cols( ); k++ )
+        {
+            segmentStartValue += ( k % 2 == 0 ? 1.0 : -1.0 ) * segmentCoefficients[ i ].col( k );
+        }
+        BOOST_CHECK_SMALL( ( segmentStartValue - previousSegmentEndValue ).norm( ), 1.0E-10 );
+    }
+
+    // Check that evaluation as quaternion requires four components.
+    ChebyshevApproximation vectorApproximation = createChebyshevApproximation(
+                &getTestFunctionValue, 0.0, 1000.0, 1.0E-8 );
+    BOOST_CHECK_THROW( vectorApproximation.evaluateQuaternion( 10.0 ), std::runtime_error );
+}
+
+//! Test serialization of Chebyshev approximation.
+BOOST_AUTO_TEST_CASE( testChebyshevApproximationSerialization )
+{
+    using namespace interpolators;
+
+    ChebyshevApproximation approximation = createChebyshevApproximation(
+                &getTestFunctionValue, 0.0, 20000.0, 1.0E-8, 12 );
+    const std::vector< double > serializedForm = approximation.getSerializedForm( );
+
+    // Check size of serialized form: header, boundaries and coefficients.
+    const int numberOfSegments = approximation.getNumberOfSegments( );
+    BOOST_CHECK_EQUAL( serializedForm.size( ),
+                       static_cast< unsigned int >( 3 + numberOfSegments + 1
+                                                    + numberOfSegments * 2 * 12 ) );
+
+    // Check that reconstructed approximation is identical.
+    ChebyshevApproximation reconstructedApproximation( serializedForm );
+    BOOST_CHECK( reconstructedApproximation.getSegmentBoundaries( )
+                 == approximation.getSegmentBoundaries( ) );
+    for ( int i = 0; i <= 200; i++ )
+    {
+        const double time = 100.0 * static_cast< double >( i );
+        BOOST_CHECK( reconstructedApproximation.evaluate( time )
+                     == approximation.evaluate( time ) );
+    }
+
+    // Check that inconsistent serialized form is rejected.
+    std::vector< double > truncatedSerializedForm = serializedForm;
+    truncatedSerializedForm.pop_back( );
+    BOOST_CHECK_THROW( ChebyshevApproximation invalidApproximation( truncatedSerializedForm ),
+                       std::runtime_error );
+}
+
+//! Test error handling of Chebyshev approximation.
+BOOST_AUTO_TEST_CASE( testChebyshevApproximationErrorHandling )
+{
+    using namespace interpolators;
+
+    ChebyshevApproximation approximation = createChebyshevApproximation(
+                &getTestFunctionValue, 0.0, 1000.0, 1.0E-8 );
+
+    // Check that evaluation outside interval is rejected.
+    BOOST_CHECK_THROW( approximation.evaluate( -1.0E-3 ), std::runtime_error );
+    BOOST_CHECK_THROW( approximation.evaluate( 1000.1 ), std::runtime_error );
+    BOOST_CHECK_NO_THROW( approximation.evaluate( 1000.0 ) );
+
+    // Check that unreachable tolerance is reported.
+    BOOST_CHECK_THROW( createChebyshevApproximation( &getTestFunctionValue, 0.0, 86400.0, 1.0E-10,
+                                                     16, 10 ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,516 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Align quaternion signs across segment boundaries.
+ *
+ *    References
+ *      Press W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing. Cambridge
+ *          University Press, February 2002.
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/exception/all.hpp>
+
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+#include "Tudat/Mathematics/Interpolators/chebyshevApproximation.h"
+
+namespace tudat
+{
+namespace interpolators
+{
+
+//! Compute Chebyshev nodes on interval.
+Eigen::VectorXd computeChebyshevNodes( const double lowerBound, const double upperBound,
+                                       const int numberOfNodes )
+{
+    const double halfWidth = 0.5 * ( upperBound - lowerBound );
+    const double midpoint = 0.5 * ( upperBound + lowerBound );
+
+    Eigen::VectorXd nodes( numberOfNodes );
+    for ( int j = 0; j < numberOfNodes; j++ )
+    {
+        nodes( j ) = midpoint + halfWidth * std::cos(
+                    mathematical_constants::PI * ( static_cast< double >( j ) + 0.5 )
+                    / static_cast< double >( numberOfNodes ) );
+    }
+    return nodes;
+}
+
+//! Compute Chebyshev coefficients from values at Chebyshev nodes.
+Eigen::MatrixXd computeChebyshevCoefficients( const Eigen::MatrixXd& valuesAtNodes )
+{
+    const int numberOfNodes = valuesAtNodes.cols( );
+    const double inverseNumberOfNodes = 1.0 / static_cast< double >( numberOfNodes );
+
+    Eigen::MatrixXd coefficients = Eigen::MatrixXd::Zero( valuesAtNodes.rows( ), numberOfNodes );
+    for ( int k = 0; k < numberOfNodes; k++ )
+    {
+        for ( int j = 0; j < numberOfNodes; j++ )
+        {
+            coefficients.col( k ) += std::cos(
+                        mathematical_constants::PI * static_cast< double >( k )
+                        * ( static_cast< double >( j ) + 0.5 ) * inverseNumberOfNodes )
+                    * valuesAtNodes.col( j );
+        }
+        coefficients.col( k ) *= 2.0 * inverseNumberOfNodes;
+    }
+
+    // Constant term is not doubled in series f(x) = sum_k c_k T_k(x).
+    coefficients.col( 0 ) *= 0.5;
+
+    return coefficients;
+}
+
+//! Compute coefficients of derivative of Chebyshev series.
+Eigen::MatrixXd computeChebyshevDerivativeCoefficients( const Eigen::MatrixXd& coefficients )
+{
+    const int numberOfCoefficients = coefficients.cols( );
+
+    // Derivative of constant is zero.
+    if ( numberOfCoefficients < 2 )
+    {
+        return Eigen::MatrixXd::Zero( coefficients.rows( ), 1 );
+    }
+
+    // Apply recurrence relation, with derivative coefficients stored one column further, so that
+    // the c'_{n} and c'_{n-1} (both zero) need not be treated separately.
+    Eigen::MatrixXd derivativeCoefficients
+            = Eigen::MatrixXd::Zero( coefficients.rows( ), numberOfCoefficients + 1 );
+    for ( int k = numberOfCoefficients - 1; k >= 1; k-- )
+    {
+        derivativeCoefficients.col( k - 1 ) = derivativeCoefficients.col( k + 1 )
+                + 2.0 * static_cast< double >( k ) * coefficients.col( k );
+    }
+
+    // Constant term is not doubled in series f(x) = sum_k c_k T_k(x).
+    derivativeCoefficients.col( 0 ) *= 0.5;
+
+    return derivativeCoefficients.leftCols( numberOfCoefficients - 1 );
+}
+
+//! Evaluate Chebyshev series.
+double evaluateChebyshevSeries( const Eigen::VectorXd& coefficients,
+                                const double scaledIndependentVariable )
+{
+    const double twiceIndependentVariable = 2.0 * scaledIndependentVariable;
+
+    // Perform Clenshaw recurrence b_k = c_k + 2 x b_{k+1} - b_{k+2}.
+    double firstRecurrenceTerm = 0.0;
+    double secondRecurrenceTerm = 0.0;
+    for ( int k = coefficients.rows( ) - 1; k >= 1; k-- )
+    {
+        const double newRecurrenceTerm = coefficients( k )
+                + twiceIndependentVariable * firstRecurrenceTerm - secondRecurrenceTerm;
+        secondRecurrenceTerm = firstRecurrenceTerm;
+        firstRecurrenceTerm = newRecurrenceTerm;
+    }
+
+    return coefficients( 0 ) + scaledIndependentVariable * firstRecurrenceTerm
+            - secondRecurrenceTerm;
+}
+
+//! Evaluate vector-valued Chebyshev series.
+Eigen::VectorXd evaluateVectorChebyshevSeries( const Eigen::MatrixXd& coefficients,
+                                               const double scaledIndependentVariable )
+{
+    const double twiceIndependentVariable = 2.0 * scaledIndependentVariable;
+
+    // Perform Clenshaw recurrence b_k = c_k + 2 x b_{k+1} - b_{k+2}.
+    Eigen::VectorXd firstRecurrenceTerm = Eigen::VectorXd::Zero( coefficients.rows( ) );
+    Eigen::VectorXd secondRecurrenceTerm = Eigen::VectorXd::Zero( coefficients.rows( ) );
+    for ( int k = coefficients.cols( ) - 1; k >= 1; k-- )
+    {
+        secondRecurrenceTerm = coefficients.col( k )
+                + twiceIndependentVariable * firstRecurrenceTerm - secondRecurrenceTerm;
+        firstRecurrenceTerm.swap( secondRecurrenceTerm );
+    }
+
+    return coefficients.col( 0 ) + scaledIndependentVariable * firstRecurrenceTerm
+            - secondRecurrenceTerm;
+}
+
+//! Constructor from segment boundaries and coefficients.
+ChebyshevApproximation::ChebyshevApproximation(
+        const std::vector< double >& segmentBoundaries,
+        const std::vector< Eigen::MatrixXd >& segmentCoefficients,
+        const AvailableLookupScheme selectedLookupScheme )
+    : segmentBoundaries_( segmentBoundaries ),
+      segmentCoefficients_( segmentCoefficients )
+{
+    initialize( selectedLookupScheme );
+}
+
+//! Constructor from serialized form.
+ChebyshevApproximation::ChebyshevApproximation(
+        const std::vector< double >& serializedForm,
+        const AvailableLookupScheme selectedLookupScheme )
+{
+    // Retrieve and check sizes from header.
+    if ( serializedForm.size( ) < 3 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, serialized form of Chebyshev approximation is too short." ) ) );
+    }
+
+    const int numberOfComponents = static_cast< int >( serializedForm[ 0 ] );
+    const int numberOfCoefficients = static_cast< int >( serializedForm[ 1 ] );
+    const int numberOfSegments = static_cast< int >( serializedForm[ 2 ] );
+    const int segmentSize = numberOfComponents * numberOfCoefficients;
+
+    if ( numberOfComponents < 1 || numberOfCoefficients < 1 || numberOfSegments < 1 ||
+         static_cast< int >( serializedForm.size( ) )
+         != 3 + numberOfSegments + 1 + numberOfSegments * segmentSize )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, serialized form of Chebyshev approximation is "
+                            "inconsistent." ) ) );
+    }
+
+    // Retrieve segment boundaries and coefficients.
+    std::vector< double >::const_iterator currentEntry = serializedForm.begin( ) + 3;
+    segmentBoundaries_.assign( currentEntry, currentEntry + numberOfSegments + 1 );
+    currentEntry += numberOfSegments + 1;
+
+    segmentCoefficients_.resize( numberOfSegments );
+    for ( int i = 0; i < numberOfSegments; i++ )
+    {
+        segmentCoefficients_[ i ] = Eigen::Map< const Eigen::MatrixXd >(
+                    &( *currentEntry ), numberOfComponents, numberOfCoefficients );
+        currentEntry += segmentSize;
+    }
+
+    initialize( selectedLookupScheme );
+}
+
+//! Evaluate approximation.
+Eigen::VectorXd ChebyshevApproximation::evaluate( const double independentVariable )
+{
+    if ( !( independentVariable >= segmentBoundaries_.front( ) &&
+            independentVariable <= segmentBoundaries_.back( ) ) )
+    {
+        std::stringstream errorMessage;
+        errorMessage << "Error, requested value " << independentVariable
+                     << " is outside interval of Chebyshev approximation ["
+                     << segmentBoundaries_.front( ) << ", " << segmentBoundaries_.back( ) << "]."
+                     << std::endl;
+        boost::throw_exception( boost::enable_error_info( std::runtime_error(
+                                                              errorMessage.str( ) ) ) );
+    }
+
+    // Find segment, and scale independent variable to [-1, 1].
+    const int segmentIndex = lookUpScheme_->findNearestLowerNeighbour( independentVariable );
+    const double lowerBound = segmentBoundaries_[ segmentIndex ];
+    const double upperBound = segmentBoundaries_[ segmentIndex + 1 ];
+    const double scaledIndependentVariable
+            = ( 2.0 * independentVariable - lowerBound - upperBound ) / ( upperBound - lowerBound );
+    const double twiceScaledIndependentVariable = 2.0 * scaledIndependentVariable;
+    const Eigen::MatrixXd& coefficients = segmentCoefficients_[ segmentIndex ];
+
+    // Perform Clenshaw recurrence b_k = c_k + 2 x b_{k+1} - b_{k+2}, using member buffers.
+    firstRecurrenceBuffer_.setZero( );
+    secondRecurrenceBuffer_.setZero( );
+    for ( int k = numberOfCoefficients_ - 1; k >= 1; k-- )
+    {
+        secondRecurrenceBuffer_ = coefficients.col( k )
+                + twiceScaledIndependentVariable * firstRecurrenceBuffer_
+                - secondRecurrenceBuffer_;
+        firstRecurrenceBuffer_.swap( secondRecurrenceBuffer_ );
+    }
+
+    return coefficients.col( 0 ) + scaledIndependentVariable * firstRecurrenceBuffer_
+            - secondRecurrenceBuffer_;
+}
+
+//! Evaluate approximation of quaternion.
+Eigen::Quaterniond ChebyshevApproximation::evaluateQuaternion( const double independentVariable )
+{
+    if ( numberOfComponents_ != 4 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, Chebyshev approximation of quaternion must have four "
+                            "components." ) ) );
+    }
+
+    const Eigen::VectorXd quaternionComponents = evaluate( independentVariable );
+    return Eigen::Quaterniond( quaternionComponents( 0 ), quaternionComponents( 1 ),
+                               quaternionComponents( 2 ), quaternionComponents( 3 ) ).normalized( );
+}
+
+//! Compute approximation of derivative.
+ChebyshevApproximation ChebyshevApproximation::computeDerivativeApproximation( ) const
+{
+    // Differentiate each segment, and apply chain rule for scaling of independent variable.
+    std::vector< Eigen::MatrixXd > derivativeCoefficients( segmentCoefficients_.size( ) );
+    for ( unsigned int i = 0; i < segmentCoefficients_.size( ); i++ )
+    {
+        const double segmentWidth = segmentBoundaries_[ i + 1 ] - segmentBoundaries_[ i ];
+        derivativeCoefficients[ i ] = 2.0 / segmentWidth
+                * computeChebyshevDerivativeCoefficients( segmentCoefficients_[ i ] );
+    }
+
+    return ChebyshevApproximation( segmentBoundaries_, derivativeCoefficients,
+                                   selectedLookupScheme_ );
+}
+
+//! Get serialized form.
+std::vector< double > ChebyshevApproximation::getSerializedForm( ) const
+{
+    const int segmentSize = numberOfComponents_ * numberOfCoefficients_;
+
+    std::vector< double > serializedForm;
+    serializedForm.reserve( 3 + segmentBoundaries_.size( )
+                            + segmentCoefficients_.size( ) * segmentSize );
+
+    // Add header and segment boundaries.
+    serializedForm.push_back( static_cast< double >( numberOfComponents_ ) );
+    serializedForm.push_back( static_cast< double >( numberOfCoefficients_ ) );
+    serializedForm.push_back( static_cast< double >( segmentCoefficients_.size( ) ) );
+    serializedForm.insert( serializedForm.end( ), segmentBoundaries_.begin( ),
+                           segmentBoundaries_.end( ) );
+
+    // Add coefficients, in column-major order.
+    for ( unsigned int i = 0; i < segmentCoefficients_.size( ); i++ )
+    {
+        serializedForm.insert( serializedForm.end( ), segmentCoefficients_[ i ].data( ),
+                               segmentCoefficients_[ i ].data( ) + segmentSize );
+    }
+
+    return serializedForm;
+}
+
+//! Initialize approximation.
+void ChebyshevApproximation::initialize( const AvailableLookupScheme selectedLookupScheme )
+{
+    // Check consistency of segments.
+    if ( segmentCoefficients_.empty( ) ||
+         segmentBoundaries_.size( ) != segmentCoefficients_.size( ) + 1 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, number of segment boundaries of Chebyshev approximation must "
+                            "be one more than (non-zero) number of segments." ) ) );
+    }
+
+    numberOfComponents_ = segmentCoefficients_.front( ).rows( );
+    numberOfCoefficients_ = segmentCoefficients_.front( ).cols( );
+
+    for ( unsigned int i = 0; i < segmentCoefficients_.size( ); i++ )
+    {
+        if ( segmentCoefficients_[ i ].rows( ) != numberOfComponents_ ||
+             segmentCoefficients_[ i ].cols( ) != numberOfCoefficients_ ||
+             numberOfComponents_ < 1 || numberOfCoefficients_ < 1 )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error(
+                                "Error, all segments of Chebyshev approximation must have the "
+                                "same (non-zero) number of components and coefficients." ) ) );
+        }
+
+        if ( !( segmentBoundaries_[ i + 1 ] > segmentBoundaries_[ i ] ) )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error(
+                                "Error, segment boundaries of Chebyshev approximation must be "
+                                "strictly ascending." ) ) );
+        }
+    }
+
+    // Create look-up scheme.
+    selectedLookupScheme_ = selectedLookupScheme;
+    switch( selectedLookupScheme )
+    {
+    case binarySearch:
+
+        lookUpScheme_ = boost::shared_ptr< LookUpScheme< double > >(
+                    new BinarySearchLookupScheme< double >( segmentBoundaries_ ) );
+        break;
+
+    case huntingAlgorithm:
+
+        lookUpScheme_ = boost::shared_ptr< LookUpScheme< double > >(
+                    new HuntingAlgorithmLookupScheme< double >( segmentBoundaries_ ) );
+        break;
+
+    default:
+
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, look-up scheme of Chebyshev approximation not "
+                            "recognized." ) ) );
+    }
+
+    // Allocate buffers for Clenshaw recurrence.
+    firstRecurrenceBuffer_.resize( numberOfComponents_ );
+    secondRecurrenceBuffer_.resize( numberOfComponents_ );
+}
+
+//! Create piecewise Chebyshev approximation to given tolerance.
+ChebyshevApproximation createChebyshevApproximation(
+        const boost::function< Eigen::VectorXd( const double ) > function,
+        const double lowerBound, const double upperBound, const double tolerance,
+        const int numberOfCoefficients, const int maximumNumberOfSegments,
+        const bool alignQuaternionSigns )
+{
+    if ( !( upperBound > lowerBound ) || numberOfCoefficients < 2 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, Chebyshev approximation requires upper bound larger than lower "
+                            "bound, and at least two coefficients." ) ) );
+    }
+
+    std::vector< double > segmentBoundaries;
+    segmentBoundaries.push_back( lowerBound );
+    std::vector< Eigen::MatrixXd > segmentCoefficients;
+
+    // Process segments from left to right, using stack of upper bounds of segments that remain
+    // to be fitted; the lower bound of the current segment is the last accepted boundary.
+    std::vector< double > pendingUpperBounds;
+    pendingUpperBounds.push_back( upperBound );
+
+    Eigen::MatrixXd valuesAtNodes;
+    Eigen::VectorXd previousSegmentEndValue;
+    while ( !pendingUpperBounds.empty( ) )
+    {
+        const double segmentLowerBound = segmentBoundaries.back( );
+        const double segmentUpperBound = pendingUpperBounds.back( );
+
+        // Evaluate function at Chebyshev nodes of segment.
+        const Eigen::VectorXd nodes = computeChebyshevNodes(
+                    segmentLowerBound, segmentUpperBound, numberOfCoefficients );
+        for ( int j = 0; j < numberOfCoefficients; j++ )
+        {
+            const Eigen::VectorXd functionValue = function( nodes( j ) );
+            if ( j == 0 )
+            {
+                valuesAtNodes.resize( functionValue.rows( ), numberOfCoefficients );
+            }
+            valuesAtNodes.col( j ) = functionValue;
+        }
+
+        // Flip sign of quaternions that are not in same hemisphere as preceding sample, starting
+        // from the end of the previous segment. The nodes are in descending order.
+        if ( alignQuaternionSigns )
+        {
+            for ( int j = numberOfCoefficients - 1; j >= 0; j-- )
+            {
+                const bool isFirstSample = ( j == numberOfCoefficients - 1 );
+                if ( isFirstSample && previousSegmentEndValue.rows( ) == 0 )
+                {
+                    continue;
+                }
+
+                const double projectionOnPrecedingValue = isFirstSample
+                        ? valuesAtNodes.col( j ).dot( previousSegmentEndValue )
+                        : valuesAtNodes.col( j ).dot( valuesAtNodes.col( j + 1 ) );
+                if ( projectionOnPrecedingValue < 0.0 )
+                {
+                    valuesAtNodes.col( j ) *= -1.0;
+                }
+            }
+        }
+
+        // Fit segment, and estimate error from highest-order coefficients.
+        const Eigen::MatrixXd coefficients = computeChebyshevCoefficients( valuesAtNodes );
+        const double estimatedError
+                = ( coefficients.col( numberOfCoefficients - 1 ).cwiseAbs( )
+                    + coefficients.col( numberOfCoefficients - 2 ).cwiseAbs( ) ).maxCoeff( );
+
+        if ( estimatedError <= tolerance )
+        {
+            segmentBoundaries.push_back( segmentUpperBound );
+            segmentCoefficients.push_back( coefficients );
+            pendingUpperBounds.pop_back( );
+            previousSegmentEndValue = valuesAtNodes.col( 0 );
+        }
+        else
+        {
+            const double segmentMidpoint = 0.5 * ( segmentLowerBound + segmentUpperBound );
+            if ( static_cast< int >( segmentCoefficients.size( ) + pendingUpperBounds.size( ) )
+                 >= maximumNumberOfSegments ||
+                 !( segmentMidpoint > segmentLowerBound && segmentMidpoint < segmentUpperBound ) )
+            {
+                std::stringstream errorMessage;
+                errorMessage << "Error, Chebyshev approximation could not reach tolerance "
+                             << tolerance << " with at most " << maximumNumberOfSegments
+                             << " segments; estimated error in segment [" << segmentLowerBound
+                             << ", " << segmentUpperBound << "] is " << estimatedError << "."
+                             << std::endl;
+                boost::throw_exception( boost::enable_error_info( std::runtime_error(
+                                                                      errorMessage.str( ) ) ) );
+            }
+            pendingUpperBounds.push_back( segmentMidpoint );
+        }
+    }
+
+    return ChebyshevApproximation( segmentBoundaries, segmentCoefficients );
+}
+
+//! Evaluate quaternion function and return its components.
+Eigen::VectorXd evaluateQuaternionComponents(
+        const boost::function< Eigen::Quaterniond( const double ) > quaternionFunction,
+        const double independentVariable )
+{
+    const Eigen::Quaterniond quaternion = quaternionFunction( independentVariable );
+
+    Eigen::VectorXd quaternionComponents( 4 );
+    quaternionComponents << quaternion.w( ), quaternion.x( ), quaternion.y( ), quaternion.z( );
+    return quaternionComponents;
+}
+
+//! Create piecewise Chebyshev approximation of quaternion to given tolerance.
+ChebyshevApproximation createQuaternionChebyshevApproximation(
+        const boost::function< Eigen::Quaterniond( const double ) > function,
+        const double lowerBound, const double upperBound, const double tolerance,
+        const int numberOfCoefficients, const int maximumNumberOfSegments )
+{
+    return createChebyshevApproximation(
+                boost::bind( &evaluateQuaternionComponents, function, _1 ),
+                lowerBound, upperBound, tolerance, numberOfCoefficients, maximumNumberOfSegments,
+                true );
+}
+
+} // namespace interpolators
+} // namespace tudat
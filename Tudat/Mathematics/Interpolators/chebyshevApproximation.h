@@ -0,0 +1,340 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Align quaternion signs across segment boundaries.
+ *
+ *    References
+ *      Press W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing. Cambridge
+ *          University Press, February 2002.
+ *      Mason, J.C., Handscomb, D.C. Chebyshev Polynomials. Chapman & Hall/CRC, 2003.
+ *      Newhall, X.X. Numerical Representation of Planetary Ephemerides. Celestial Mechanics,
+ *          45, 305-310, 1989.
+ *
+ *    Notes
+ *      The ChebyshevApproximation is intended to replace a smooth, but expensive, function of
+ *      time (e.g., an ephemeris or rotation model) over a given interval, in the same manner as
+ *      the JPL ephemerides are distributed (Newhall, 1989). The error of each segment is
+ *      estimated from the magnitude of its highest-order coefficients; the approximated function
+ *      should therefore be smooth (i.e., have continuous derivatives of high order) within each
+ *      segment. Discontinuities (e.g., impulsive shots) should be placed on segment boundaries
+ *      by creating a separate approximation for each arc.
+ *
+ */
+
+#ifndef TUDAT_CHEBYSHEV_APPROXIMATION_H
+#define TUDAT_CHEBYSHEV_APPROXIMATION_H
+
+#include <vector>
+
+#include <boost/function.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+
+#include "Tudat/Mathematics/Interpolators/lookupScheme.h"
+
+namespace tudat
+{
+namespace interpolators
+{
+
+//! Compute Chebyshev nodes on interval.
+/*!
+ * Computes the Chebyshev nodes (zeros of the Chebyshev polynomial of the first kind of degree
+ * numberOfNodes) mapped to the interval [lowerBound, upperBound]. The nodes are returned in
+ * descending order, i.e. node j corresponds to \f$\cos( \pi( j + 1/2 ) / n )\f$ on [-1, 1].
+ * \param lowerBound Lower bound of interval.
+ * \param upperBound Upper bound of interval.
+ * \param numberOfNodes Number of nodes.
+ * \return Chebyshev nodes on interval, in descending order.
+ */
+Eigen::VectorXd computeChebyshevNodes( const double lowerBound, const double upperBound,
+                                       const int numberOfNodes );
+
+//! Compute Chebyshev coefficients from values at Chebyshev nodes.
+/*!
+ * Computes the coefficients of the Chebyshev series that interpolates the given function values
+ * at the Chebyshev nodes, as returned by computeChebyshevNodes( ) (Press et al., 2002).
+ * \param valuesAtNodes Function values at nodes; each column contains the (vector) function
+ *          value at a single node.
+ * \return Chebyshev coefficients; each column contains the coefficients of a single degree
+ *          for all components, such that column k multiplies \f$T_{k}\f$.
+ */
+Eigen::MatrixXd computeChebyshevCoefficients( const Eigen::MatrixXd& valuesAtNodes );
+
+//! Compute coefficients of derivative of Chebyshev series.
+/*!
+ * Computes the coefficients of the derivative of a Chebyshev series w.r.t. its argument on the
+ * interval [-1, 1], using the recurrence relation
+ * \f$c'_{k-1} = c'_{k+1} + 2kc_{k}\f$ (Press et al., 2002). The derivative w.r.t. the
+ * (unscaled) independent variable on the interval [a, b] is obtained by multiplying the result
+ * by 2 / ( b - a ).
+ * \param coefficients Chebyshev coefficients, with layout as returned by
+ *          computeChebyshevCoefficients( ).
+ * \return Chebyshev coefficients of derivative; the number of columns is one less than that of
+ *          the input (but at least one).
+ */
+Eigen::MatrixXd computeChebyshevDerivativeCoefficients( const Eigen::MatrixXd& coefficients );
+
+//! Evaluate Chebyshev series.
+/*!
+ * Evaluates a scalar Chebyshev series \f$f(x) = \sum_{k} c_{k}T_{k}(x)\f$ using the Clenshaw
+ * recurrence (Press et al., 2002).
+ * \param coefficients Chebyshev coefficients, entry k multiplying \f$T_{k}\f$.
+ * \param scaledIndependentVariable Independent variable, scaled to the interval [-1, 1].
+ * \return Value of Chebyshev series.
+ */
+double evaluateChebyshevSeries( const Eigen::VectorXd& coefficients,
+                                const double scaledIndependentVariable );
+
+//! Evaluate vector-valued Chebyshev series.
+/*!
+ * Evaluates a vector-valued Chebyshev series using the Clenshaw recurrence (Press et al., 2002).
+ * \param coefficients Chebyshev coefficients, with layout as returned by
+ *          computeChebyshevCoefficients( ).
+ * \param scaledIndependentVariable Independent variable, scaled to the interval [-1, 1].
+ * \return Value of Chebyshev series.
+ */
+Eigen::VectorXd evaluateVectorChebyshevSeries( const Eigen::MatrixXd& coefficients,
+                                               const double scaledIndependentVariable );
+
+//! Piecewise Chebyshev approximation class.
+/*!
+ * Piecewise Chebyshev approximation of a (vector-valued) function of a single independent
+ * variable (typically time). The interval over which the function is approximated is divided
+ * into contiguous segments, on each of which the function is represented by a Chebyshev series
+ * of the same number of coefficients. The segment in which the approximation is evaluated is
+ * found by a look-up scheme, after which the series is evaluated by the Clenshaw recurrence
+ * using internal buffers, so that no memory is allocated apart from the returned vector.
+ * Approximations are normally created by createChebyshevApproximation( ) or
+ * createQuaternionChebyshevApproximation( ).
+ */
+class ChebyshevApproximation
+{
+public:
+
+    //! Constructor from segment boundaries and coefficients.
+    /*!
+     * Constructor from segment boundaries and coefficients.
+     * \param segmentBoundaries Boundaries of segments, in ascending order (size is number of
+     *          segments plus one).
+     * \param segmentCoefficients Chebyshev coefficients of each segment, with layout as returned
+     *          by computeChebyshevCoefficients( ). All segments must have the same number of
+     *          components and coefficients.
+     * \param selectedLookupScheme Look-up scheme used to find segment in which approximation is
+     *          evaluated (default hunting algorithm).
+     */
+    ChebyshevApproximation( const std::vector< double >& segmentBoundaries,
+                            const std::vector< Eigen::MatrixXd >& segmentCoefficients,
+                            const AvailableLookupScheme selectedLookupScheme = huntingAlgorithm );
+
+    //! Constructor from serialized form.
+    /*!
+     * Constructor from serialized form, as returned by getSerializedForm( ).
+     * \param serializedForm Serialized form of Chebyshev approximation.
+     * \param selectedLookupScheme Look-up scheme used to find segment in which approximation is
+     *          evaluated (default hunting algorithm).
+     */
+    ChebyshevApproximation( const std::vector< double >& serializedForm,
+                            const AvailableLookupScheme selectedLookupScheme = huntingAlgorithm );
+
+    //! Evaluate approximation.
+    /*!
+     * Evaluates approximation at given value of independent variable.
+     * \param independentVariable Value of independent variable, which must be within the
+     *          approximated interval.
+     * \return Value of approximated function.
+     */
+    Eigen::VectorXd evaluate( const double independentVariable );
+
+    //! Evaluate approximation of quaternion.
+    /*!
+     * Evaluates approximation of a quaternion, and normalizes the result. The approximated
+     * function must have four components, ordered as (w, x, y, z), as is the case for
+     * approximations created by createQuaternionChebyshevApproximation( ).
+     * \param independentVariable Value of independent variable, which must be within the
+     *          approximated interval.
+     * \return Normalized quaternion.
+     */
+    Eigen::Quaterniond evaluateQuaternion( const double independentVariable );
+
+    //! Compute approximation of derivative.
+    /*!
+     * Computes the Chebyshev approximation of the derivative of this approximation w.r.t. the
+     * independent variable, analytically from the coefficients of each segment. Derivatives of
+     * higher order are obtained by repeated calls.
+     * \return Approximation of derivative.
+     */
+    ChebyshevApproximation computeDerivativeApproximation( ) const;
+
+    //! Get serialized form.
+    /*!
+     * Returns serialized form of approximation, which contains (in this order): the number of
+     * components, the number of coefficients per segment, the number of segments, the segment
+     * boundaries and the coefficients of each segment (column-major). The approximation can be
+     * reconstructed from it by the corresponding constructor.
+     * \return Serialized form of approximation.
+     */
+    std::vector< double > getSerializedForm( ) const;
+
+    //! Get segment boundaries.
+    /*!
+     * Returns boundaries of segments, in ascending order.
+     * \return Segment boundaries.
+     */
+    const std::vector< double >& getSegmentBoundaries( ) const { return segmentBoundaries_; }
+
+    //! Get coefficients of all segments.
+    /*!
+     * Returns Chebyshev coefficients of all segments.
+     * \return Segment coefficients.
+     */
+    const std::vector< Eigen::MatrixXd >& getSegmentCoefficients( ) const
+    {
+        return segmentCoefficients_;
+    }
+
+    //! Get number of segments.
+    /*!
+     * Returns number of segments.
+     * \return Number of segments.
+     */
+    int getNumberOfSegments( ) const { return static_cast< int >( segmentCoefficients_.size( ) ); }
+
+    //! Get number of components.
+    /*!
+     * Returns number of components of approximated function.
+     * \return Number of components.
+     */
+    int getNumberOfComponents( ) const { return numberOfComponents_; }
+
+protected:
+
+private:
+
+    //! Initialize approximation.
+    /*!
+     * Checks consistency of segment boundaries and coefficients, and creates look-up scheme and
+     * evaluation buffers.
+     * \param selectedLookupScheme Look-up scheme used to find segment.
+     */
+    void initialize( const AvailableLookupScheme selectedLookupScheme );
+
+    //! Boundaries of segments, in ascending order.
+    std::vector< double > segmentBoundaries_;
+
+    //! Chebyshev coefficients of each segment.
+    std::vector< Eigen::MatrixXd > segmentCoefficients_;
+
+    //! Number of components of approximated function.
+    int numberOfComponents_;
+
+    //! Number of Chebyshev coefficients per segment.
+    int numberOfCoefficients_;
+
+    //! Look-up scheme used to find segment in which approximation is evaluated.
+    boost::shared_ptr< LookUpScheme< double > > lookUpScheme_;
+
+    //! Type of look-up scheme, retained for approximations derived from this one.
+    AvailableLookupScheme selectedLookupScheme_;
+
+    //! First buffer for Clenshaw recurrence.
+    Eigen::VectorXd firstRecurrenceBuffer_;
+
+    //! Second buffer for Clenshaw recurrence.
+    Eigen::VectorXd secondRecurrenceBuffer_;
+};
+
+//! Typedef for shared-pointer to ChebyshevApproximation.
+typedef boost::shared_ptr< ChebyshevApproximation > ChebyshevApproximationPointer;
+
+//! Create piecewise Chebyshev approximation to given tolerance.
+/*!
+ * Creates piecewise Chebyshev approximation of a (vector-valued) function over a given interval.
+ * Starting from a single segment, each segment is fitted at its Chebyshev nodes, and bisected if
+ * the estimated error exceeds the tolerance. The error of a segment is estimated as the sum of
+ * the absolute values of its two highest-order coefficients (maximum over all components).
+ * \param function Function to approximate; it is evaluated numberOfCoefficients times per
+ *          fitted segment.
+ * \param lowerBound Lower bound of approximated interval.
+ * \param upperBound Upper bound of approximated interval.
+ * \param tolerance Absolute tolerance on each component of the approximated function.
+ * \param numberOfCoefficients Number of Chebyshev coefficients per segment (default 16).
+ * \param maximumNumberOfSegments Maximum number of segments, after which an exception is thrown
+ *          (default 100000).
+ * \param alignQuaternionSigns Boolean denoting whether the function returns quaternions
+ *          (w, x, y, z), of which the sign is to be made continuous over all segments, see
+ *          createQuaternionChebyshevApproximation( ) (default false).
+ * \return Piecewise Chebyshev approximation.
+ */
+ChebyshevApproximation createChebyshevApproximation(
+        const boost::function< Eigen::VectorXd( const double ) > function,
+        const double lowerBound, const double upperBound, const double tolerance,
+        const int numberOfCoefficients = 16, const int maximumNumberOfSegments = 100000,
+        const bool alignQuaternionSigns = false );
+
+//! Evaluate quaternion function and return its components.
+/*!
+ * Evaluates function returning a quaternion, and returns its components in the order
+ * (w, x, y, z). Used to approximate quaternion functions by a Chebyshev approximation.
+ * \param quaternionFunction Function returning quaternion.
+ * \param independentVariable Value of independent variable at which function is evaluated.
+ * \return Quaternion components (w, x, y, z).
+ */
+Eigen::VectorXd evaluateQuaternionComponents(
+        const boost::function< Eigen::Quaterniond( const double ) > quaternionFunction,
+        const double independentVariable );
+
+//! Create piecewise Chebyshev approximation of quaternion to given tolerance.
+/*!
+ * Creates piecewise Chebyshev approximation of a rotation (quaternion) as a function of the
+ * independent variable. Since q and -q represent the same rotation, the quaternions returned by
+ * the function may change sign discontinuously. Therefore, the samples are processed in order of
+ * increasing independent variable, and the sign of each sample is chosen such that it is in the
+ * same hemisphere as the previous sample. The first sample of each segment is aligned to the
+ * last sample of the previous segment, so that the approximation is also continuous across
+ * segment boundaries. The approximation is to be evaluated by
+ * ChebyshevApproximation::evaluateQuaternion( ), which normalizes the result.
+ * \param function Function returning quaternion to approximate.
+ * \param lowerBound Lower bound of approximated interval.
+ * \param upperBound Upper bound of approximated interval.
+ * \param tolerance Absolute tolerance on each quaternion component.
+ * \param numberOfCoefficients Number of Chebyshev coefficients per segment (default 16).
+ * \param maximumNumberOfSegments Maximum number of segments, after which an exception is thrown
+ *          (default 100000).
+ * \return Piecewise Chebyshev approximation of quaternion components (w, x, y, z).
+ */
+ChebyshevApproximation createQuaternionChebyshevApproximation(
+        const boost::function< Eigen::Quaterniond( const double ) > function,
+        const double lowerBound, const double upperBound, const double tolerance,
+        const int numberOfCoefficients = 16, const int maximumNumberOfSegments = 100000 );
+
+} // namespace interpolators
+} // namespace tudat
+
+#endif // TUDAT_CHEBYSHEV_APPROXIMATION_H
@@ -0,0 +1,209 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      Unit test created.
+ *      261018                      Defined root function of exception test outside of check.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Mathematics/RootFinders/batchRootFindingAlgorithms.h"
+#include "Tudat/Mathematics/RootFinders/rootFindingAlgorithms.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Batch function object for Kepler's equation, f(E) = E - e sin(E) - M, and its derivatives.
+struct KeplerEquationBatchFunctor
+{
+    //! Constructor, taking eccentricities and mean anomalies of all lanes.
+    KeplerEquationBatchFunctor( const Eigen::ArrayXd& someEccentricities,
+                                const Eigen::ArrayXd& someMeanAnomalies )
+        : eccentricities( someEccentricities ), meanAnomalies( someMeanAnomalies )
+    { }
+
+    //! Evaluate function values and first derivatives.
+    void operator( )( const Eigen::ArrayXd& eccentricAnomalies, Eigen::ArrayXd& functionValues,
+                      Eigen::ArrayXd& firstDerivativeValues ) const
+    {
+        functionValues = eccentricAnomalies - eccentricities * eccentricAnomalies.sin( )
+                - meanAnomalies;
+        firstDerivativeValues = 1.0 - eccentricities * eccentricAnomalies.cos( );
+    }
+
+    //! Evaluate function values, and first and second derivatives.
+    void operator( )( const Eigen::ArrayXd& eccentricAnomalies, Eigen::ArrayXd& functionValues,
+                      Eigen::ArrayXd& firstDerivativeValues,
+                      Eigen::ArrayXd& secondDerivativeValues ) const
+    {
+        secondDerivativeValues = eccentricities * eccentricAnomalies.sin( );
+        functionValues = eccentricAnomalies - secondDerivativeValues - meanAnomalies;
+        firstDerivativeValues = 1.0 - eccentricities * eccentricAnomalies.cos( );
+    }
+
+    //! Eccentricities of all lanes.
+    Eigen::ArrayXd eccentricities;
+
+    //! Mean anomalies of all lanes.
+    Eigen::ArrayXd meanAnomalies;
+};
+
+BOOST_AUTO_TEST_SUITE( testsuite_rootfinders )
+
+using namespace root_finders;
+using namespace root_finders::termination_conditions;
+
+//! Check if batch root-finders reproduce scalar root-finders for Kepler's equation.
+BOOST_AUTO_TEST_CASE( test_batchRootFinding_keplerEquation )
+{
+    // Generate catalog of eccentricities and mean anomalies.
+    const int numberOfLanes = 1000;
+    boost::mt19937 generator( 42 );
+    boost::random::uniform_real_distribution< > eccentricityDistribution( 0.0, 0.9 );
+    boost::random::uniform_real_distribution< > meanAnomalyDistribution( 0.0, 6.0 );
+    Eigen::ArrayXd eccentricities( numberOfLanes );
+    Eigen::ArrayXd meanAnomalies( numberOfLanes );
+    for( int i = 0; i < numberOfLanes; i++ )
+    {
+        eccentricities( i ) = eccentricityDistribution( generator );
+        meanAnomalies( i ) = meanAnomalyDistribution( generator );
+    }
+    const KeplerEquationBatchFunctor keplerEquation( eccentricities, meanAnomalies );
+
+    // Solve Kepler's equation for all lanes, starting from E = M + e sin( M ).
+    const Eigen::ArrayXd initialGuesses = meanAnomalies + eccentricities * meanAnomalies.sin( );
+    const RootToleranceTerminationFunctor< > terminationCondition( 1.0e-14, 0.0, 50 );
+    const BatchRootFindingResult< > newtonRaphsonResult = findRootsWithNewtonRaphsonBatch(
+                keplerEquation, initialGuesses, terminationCondition );
+    const BatchRootFindingResult< > halleyResult = findRootsWithHalleyBatch(
+                keplerEquation, initialGuesses, terminationCondition );
+
+    BOOST_CHECK( newtonRaphsonResult.haveAllLanesConverged( ) );
+    BOOST_CHECK( halleyResult.haveAllLanesConverged( ) );
+
+    // Compare with scalar root-finders, lane by lane.
+    for( int i = 0; i < numberOfLanes; i++ )
+    {
+        const double eccentricity = eccentricities( i );
+        const double meanAnomaly = meanAnomalies( i );
+        auto scalarKeplerEquation = [ eccentricity, meanAnomaly ](
+                const double x, double& value, double& firstDerivative )
+        {
+            value = x - eccentricity * std::sin( x ) - meanAnomaly;
+            firstDerivative = 1.0 - eccentricity * std::cos( x );
+        };
+
+        // Record number of iterations of scalar root-finder.
+        unsigned int numberOfIterations = 0;
+        auto countingTerminationCondition = [ &numberOfIterations, &terminationCondition ](
+                const double currentRoot, const double previousRoot, const double currentValue,
+                const double previousValue, const unsigned int counter )
+        {
+            numberOfIterations = counter - 1;
+            return terminationCondition( currentRoot, previousRoot, currentValue, previousValue,
+                                         counter );
+        };
+
+        const double scalarRoot = findRootWithNewtonRaphson(
+                    scalarKeplerEquation, initialGuesses( i ), countingTerminationCondition );
+
+        BOOST_CHECK_EQUAL( newtonRaphsonResult.roots( i ), scalarRoot );
+        BOOST_CHECK_EQUAL( newtonRaphsonResult.numberOfIterations( i ),
+                           static_cast< int >( numberOfIterations ) );
+        BOOST_CHECK_CLOSE_FRACTION( halleyResult.roots( i ), scalarRoot, 1.0e-14 );
+        BOOST_CHECK_LE( halleyResult.numberOfIterations( i ),
+                        newtonRaphsonResult.numberOfIterations( i ) );
+    }
+}
+
+//! Check if failing lanes are reported, without affecting the other lanes.
+BOOST_AUTO_TEST_CASE( test_batchRootFinding_failingLanes )
+{
+    // Equation f(x) = x^2 - a, which has no real root for a < 0.
+    auto squareRootEquation = [ ]( const Eigen::ArrayXd& x, Eigen::ArrayXd& values,
+            Eigen::ArrayXd& firstDerivatives )
+    {
+        Eigen::ArrayXd constants( 4 );
+        constants << 2.0, -1.0, 9.0, 0.0;
+        values = x.square( ) - constants;
+        firstDerivatives = 2.0 * x;
+    };
+
+    Eigen::ArrayXd initialGuesses( 4 );
+    initialGuesses << 1.0, 0.3, 1.0, 0.0;
+
+    // Without run-time exception, failing lanes are flagged.
+    const BatchRootFindingResult< > result = findRootsWithNewtonRaphsonBatch(
+                squareRootEquation, initialGuesses,
+                RootToleranceTerminationFunctor< >( 1.0e-15, 0.0, 30, false ) );
+
+    BOOST_CHECK( result.isConverged( 0 ) );
+    BOOST_CHECK( !result.isConverged( 1 ) );
+    BOOST_CHECK( result.isConverged( 2 ) );
+    BOOST_CHECK( !result.isConverged( 3 ) );
+    BOOST_CHECK( !result.haveAllLanesConverged( ) );
+    BOOST_CHECK_CLOSE_FRACTION( result.roots( 0 ), std::sqrt( 2.0 ), 1.0e-15 );
+    BOOST_CHECK_CLOSE_FRACTION( result.roots( 2 ), 3.0, 1.0e-15 );
+
+    // Lane with non-finite update is stopped immediately, lane without root uses all iterations.
+    BOOST_CHECK_EQUAL( result.numberOfIterations( 1 ), 30 );
+    BOOST_CHECK_EQUAL( result.numberOfIterations( 3 ), 0 );
+    BOOST_CHECK_EQUAL( result.roots( 3 ), 0.0 );
+
+    // With run-time exception, an exception is thrown for equation f(x) = x^2 + 1.
+    auto noRootEquation = [ ]( const Eigen::ArrayXd& x, Eigen::ArrayXd& values,
+            Eigen::ArrayXd& firstDerivatives, Eigen::ArrayXd& secondDerivatives )
+    {
+        values = x.square( ) + 1.0;
+        firstDerivatives = 2.0 * x;
+        secondDerivatives = Eigen::ArrayXd::Constant( x.rows( ), 2.0 );
+    };
+
+    BOOST_CHECK_THROW( findRootsWithHalleyBatch(
+                           noRootEquation, Eigen::ArrayXd::Constant( 3, 0.5 ).eval( ),
+                           RootToleranceTerminationFunctor< >( 1.0e-15, 0.0, 30 ) ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( ) // testsuite_rootfinders
+
+} // namespace unit_tests
+} // namespace tudat
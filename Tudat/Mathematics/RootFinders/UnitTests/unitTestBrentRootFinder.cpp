@@ -0,0 +1,185 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      Unit test created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Mathematics/RootFinders/bisection.h"
+#include "Tudat/Mathematics/RootFinders/brentRootFinder.h"
+#include "Tudat/Mathematics/RootFinders/UnitTests/testFunction1.h"
+#include "Tudat/Mathematics/RootFinders/UnitTests/testFunction2.h"
+#include "Tudat/Mathematics/RootFinders/UnitTests/testFunction3.h"
+#include "Tudat/Mathematics/RootFinders/UnitTests/testFunctionWithLargeRootDifference.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( testsuite_rootfinders )
+
+using namespace root_finders;
+using namespace root_finders::termination_conditions;
+
+//! Check if Brent's method converges on a test function, within its true root accuracy.
+template< typename TestFunctionType >
+void checkBrentRootFinderConvergence( )
+{
+    // Create object containing the test function.
+    boost::shared_ptr< TestFunctionType > testFunction =
+            boost::make_shared< TestFunctionType >( 1 );
+
+    // The termination condition.
+    BrentRootFinder::TerminationFunction terminationConditionFunction =
+            boost::bind( &RootAbsoluteToleranceTerminationCondition< double >::
+                         checkTerminationCondition,
+                         boost::make_shared< RootAbsoluteToleranceTerminationCondition< double > >(
+                             testFunction->getTrueRootAccuracy( ) ), _1, _2, _3, _4, _5 );
+
+    // Let Brent's method search for the root.
+    BrentRootFinder brent( terminationConditionFunction,
+                           testFunction->getLowerBound( ), testFunction->getUpperBound( ) );
+    const double root = brent.execute( testFunction );
+
+    // Check if the result is within the requested accuracy.
+    BOOST_CHECK_CLOSE_FRACTION( root, testFunction->getTrueRootLocation( ), 1.0e-15 );
+}
+
+//! Check if Brent's method converges on test functions #1, #2 and #3.
+BOOST_AUTO_TEST_CASE( test_brent_testFunctions )
+{
+    checkBrentRootFinderConvergence< TestFunction1 >( );
+    checkBrentRootFinderConvergence< TestFunction2 >( );
+    checkBrentRootFinderConvergence< TestFunction3 >( );
+}
+
+//! Check if Brent's method converges on function with large root difference
+//! (testFunctionWithLargeRootDifference).
+BOOST_AUTO_TEST_CASE( test_brent_testFunctionWithLargeRootDifference )
+{
+    // Declare expected roots, and bracket.
+    const double expectedRootLowCase = 1.00000000793634;
+    const double expectedRootHighCase = 7937.3386333591;
+    const double lowerBound = 1.0;
+    const double upperBound = 10000.0;
+
+    // Create objects containing the test functions.
+    boost::shared_ptr< TestFunctionWithLargeRootDifference > testFunctionLowCase =
+            boost::make_shared< TestFunctionWithLargeRootDifference >
+            ( 1, -3.24859999867635e18, -3248600.0, 1.5707963267949 );
+    boost::shared_ptr< TestFunctionWithLargeRootDifference > testFunctionHighCase =
+            boost::make_shared< TestFunctionWithLargeRootDifference >
+            ( 1, -3248600.0, -3.24859999867635e18, 1.5707963267949 );
+
+    // Let Brent's method search for the root for both cases.
+    BrentRootFinder brent( 1.0e-12, 100, lowerBound, upperBound );
+    BOOST_CHECK_CLOSE_FRACTION( brent.execute( testFunctionLowCase ), expectedRootLowCase,
+                                1.0e-10 );
+    BOOST_CHECK_CLOSE_FRACTION( brent.execute( testFunctionHighCase ), expectedRootHighCase,
+                                1.0e-10 );
+}
+
+//! Check if Brent's method requires significantly fewer function evaluations than bisection.
+BOOST_AUTO_TEST_CASE( test_brent_numberOfFunctionEvaluations )
+{
+    boost::shared_ptr< TestFunction3 > testFunction = boost::make_shared< TestFunction3 >( 1 );
+    const double relativeTolerance = 1.0e-14;
+
+    // Brent's method, using class interface.
+    BrentRootFinder brent( relativeTolerance, 100, testFunction->getLowerBound( ),
+                           testFunction->getUpperBound( ) );
+    const double brentRoot = brent.execute( testFunction );
+
+    // Bisection method, counting function evaluations with template interface.
+    const RootFunctionValueEvaluator< double > functionEvaluator( testFunction );
+    const FunctionEvaluationCounter< RootFunctionValueEvaluator< double > > bisectionCounter
+            = countFunctionEvaluations( functionEvaluator );
+    const double bisectionRoot = findRootWithBisection(
+                bisectionCounter, testFunction->getLowerBound( ), testFunction->getUpperBound( ),
+                RootToleranceTerminationFunctor< >( relativeTolerance, 0.0, 100 ) );
+
+    BOOST_CHECK_CLOSE_FRACTION( brentRoot, testFunction->getTrueRootLocation( ), 1.0e-15 );
+    BOOST_CHECK_CLOSE_FRACTION( bisectionRoot, testFunction->getTrueRootLocation( ), 1.0e-13 );
+    BOOST_CHECK_LE( brent.getNumberOfFunctionEvaluations( ), 12 );
+    BOOST_CHECK_GE( bisectionCounter.numberOfFunctionEvaluations, 45 );
+}
+
+//! Check if Brent's method converges using the template interface, with a function object.
+BOOST_AUTO_TEST_CASE( test_brent_templateInterface )
+{
+    // Light-time-like equation with root at t = 500 / ( 1 + 1.0e-3 ).
+    auto lightTimeEquation = [ ]( const double lightTime )
+    {
+        return lightTime - ( 500.0 - 1.0e-3 * lightTime ) + 1.0e-7 * std::sin( lightTime );
+    };
+
+    const FunctionEvaluationCounter< decltype( lightTimeEquation ) > countedLightTimeEquation
+            = countFunctionEvaluations( lightTimeEquation );
+    const double root = findRootWithBrent( countedLightTimeEquation, 0.0, 1000.0,
+                                           RootToleranceTerminationFunctor< >( 1.0e-15 ) );
+
+    BOOST_CHECK_SMALL( lightTimeEquation( root ), 1.0e-12 );
+    BOOST_CHECK_LE( countedLightTimeEquation.numberOfFunctionEvaluations, 10 );
+}
+
+//! Check if Brent's method returns exact root at bound of interval.
+BOOST_AUTO_TEST_CASE( test_brent_rootAtBound )
+{
+    auto linearFunction = [ ]( const double x ) { return x - 2.0; };
+    const RootToleranceTerminationFunctor< > terminationCondition( 1.0e-12 );
+    BOOST_CHECK_EQUAL( findRootWithBrent( linearFunction, 2.0, 3.0, terminationCondition ), 2.0 );
+    BOOST_CHECK_EQUAL( findRootWithBrent( linearFunction, 1.0, 2.0, terminationCondition ), 2.0 );
+}
+
+//! Check expected functionality. Test interval that does not bracket the root.
+BOOST_AUTO_TEST_CASE( test_brent_wrongBracket )
+{
+    boost::shared_ptr< TestFunction1 > testFunction = boost::make_shared< TestFunction1 >( 1 );
+
+    // Test Brent object. The input interval does not bracket the solution.
+    BrentRootFinder brent( 1.0e-12, 100, testFunction->getLowerBound( ), 0.0 );
+
+    // Check if a runtime error is thrown if the root finder is executed.
+    BOOST_CHECK_THROW( brent.execute( testFunction ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( ) // testsuite_rootfinders
+
+} // namespace unit_tests
+} // namespace tudat
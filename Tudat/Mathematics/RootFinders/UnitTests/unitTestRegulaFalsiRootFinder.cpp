@@ -0,0 +1,189 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      Unit test created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Mathematics/RootFinders/regulaFalsiRootFinder.h"
+#include "Tudat/Mathematics/RootFinders/UnitTests/testFunction1.h"
+#include "Tudat/Mathematics/RootFinders/UnitTests/testFunction2.h"
+#include "Tudat/Mathematics/RootFinders/UnitTests/testFunction3.h"
+#include "Tudat/Mathematics/RootFinders/UnitTests/testFunctionWithLargeRootDifference.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( testsuite_rootfinders )
+
+using namespace root_finders;
+using namespace root_finders::termination_conditions;
+
+//! Check if regula falsi method converges on a test function, within its true root accuracy.
+template< typename TestFunctionType >
+void checkRegulaFalsiRootFinderConvergence( const RegulaFalsiVariant variant )
+{
+    // Create object containing the test function.
+    boost::shared_ptr< TestFunctionType > testFunction =
+            boost::make_shared< TestFunctionType >( 1 );
+
+    // The termination condition.
+    RegulaFalsiRootFinder::TerminationFunction terminationConditionFunction =
+            boost::bind( &RootAbsoluteToleranceTerminationCondition< double >::
+                         checkTerminationCondition,
+                         boost::make_shared< RootAbsoluteToleranceTerminationCondition< double > >(
+                             testFunction->getTrueRootAccuracy( ) ), _1, _2, _3, _4, _5 );
+
+    // Let the regula falsi method search for the root.
+    RegulaFalsiRootFinder regulaFalsi( terminationConditionFunction,
+                                       testFunction->getLowerBound( ),
+                                       testFunction->getUpperBound( ), variant );
+    const double root = regulaFalsi.execute( testFunction );
+
+    // Check if the result is within the requested accuracy.
+    BOOST_CHECK_CLOSE_FRACTION( root, testFunction->getTrueRootLocation( ), 1.0e-15 );
+}
+
+//! Check if Illinois and Anderson-Bjorck methods converge on test functions #1, #2 and #3.
+BOOST_AUTO_TEST_CASE( test_regulaFalsi_testFunctions )
+{
+    checkRegulaFalsiRootFinderConvergence< TestFunction1 >( illinoisRegulaFalsi );
+    checkRegulaFalsiRootFinderConvergence< TestFunction2 >( illinoisRegulaFalsi );
+    checkRegulaFalsiRootFinderConvergence< TestFunction3 >( illinoisRegulaFalsi );
+
+    checkRegulaFalsiRootFinderConvergence< TestFunction1 >( andersonBjorckRegulaFalsi );
+    checkRegulaFalsiRootFinderConvergence< TestFunction2 >( andersonBjorckRegulaFalsi );
+    checkRegulaFalsiRootFinderConvergence< TestFunction3 >( andersonBjorckRegulaFalsi );
+}
+
+//! Check if regula falsi method converges on function with large root difference
+//! (testFunctionWithLargeRootDifference).
+BOOST_AUTO_TEST_CASE( test_regulaFalsi_testFunctionWithLargeRootDifference )
+{
+    // Declare expected roots, and bracket.
+    const double expectedRootLowCase = 1.00000000793634;
+    const double expectedRootHighCase = 7937.3386333591;
+    const double lowerBound = 1.0;
+    const double upperBound = 10000.0;
+
+    // Create objects containing the test functions.
+    boost::shared_ptr< TestFunctionWithLargeRootDifference > testFunctionLowCase =
+            boost::make_shared< TestFunctionWithLargeRootDifference >
+            ( 1, -3.24859999867635e18, -3248600.0, 1.5707963267949 );
+    boost::shared_ptr< TestFunctionWithLargeRootDifference > testFunctionHighCase =
+            boost::make_shared< TestFunctionWithLargeRootDifference >
+            ( 1, -3248600.0, -3.24859999867635e18, 1.5707963267949 );
+
+    // Let both variants search for the root for both cases.
+    RegulaFalsiRootFinder regulaFalsi( 1.0e-12, 200, lowerBound, upperBound,
+                                       illinoisRegulaFalsi );
+    BOOST_CHECK_CLOSE_FRACTION( regulaFalsi.execute( testFunctionLowCase ), expectedRootLowCase,
+                                1.0e-10 );
+    BOOST_CHECK_CLOSE_FRACTION( regulaFalsi.execute( testFunctionHighCase ),
+                                expectedRootHighCase, 1.0e-10 );
+
+    regulaFalsi.setVariant( andersonBjorckRegulaFalsi );
+    BOOST_CHECK_CLOSE_FRACTION( regulaFalsi.execute( testFunctionLowCase ), expectedRootLowCase,
+                                1.0e-10 );
+    BOOST_CHECK_CLOSE_FRACTION( regulaFalsi.execute( testFunctionHighCase ),
+                                expectedRootHighCase, 1.0e-10 );
+}
+
+//! Check number of function evaluations of Illinois and Anderson-Bjorck methods.
+BOOST_AUTO_TEST_CASE( test_regulaFalsi_numberOfFunctionEvaluations )
+{
+    boost::shared_ptr< TestFunction3 > testFunction = boost::make_shared< TestFunction3 >( 1 );
+
+    // Illinois method.
+    RegulaFalsiRootFinder illinois( 1.0e-14, 100, testFunction->getLowerBound( ),
+                                    testFunction->getUpperBound( ), illinoisRegulaFalsi );
+    BOOST_CHECK_CLOSE_FRACTION( illinois.execute( testFunction ),
+                                testFunction->getTrueRootLocation( ), 1.0e-15 );
+    BOOST_CHECK_LE( illinois.getNumberOfFunctionEvaluations( ), 12 );
+
+    // Anderson-Bjorck method.
+    RegulaFalsiRootFinder andersonBjorck( 1.0e-14, 100, testFunction->getLowerBound( ),
+                                          testFunction->getUpperBound( ),
+                                          andersonBjorckRegulaFalsi );
+    BOOST_CHECK_CLOSE_FRACTION( andersonBjorck.execute( testFunction ),
+                                testFunction->getTrueRootLocation( ), 1.0e-15 );
+    BOOST_CHECK_LE( andersonBjorck.getNumberOfFunctionEvaluations( ), 12 );
+}
+
+//! Check if regula falsi method converges on convex function, on which the classical regula falsi
+//! method converges only linearly.
+BOOST_AUTO_TEST_CASE( test_regulaFalsi_convexFunction )
+{
+    auto convexFunction = [ ]( const double x ) { return std::exp( x ) - 10.0; };
+    const double expectedRoot = std::log( 10.0 );
+    const RootToleranceTerminationFunctor< > terminationCondition( 1.0e-15, 0.0, 100 );
+
+    const FunctionEvaluationCounter< decltype( convexFunction ) > illinoisCounter
+            = countFunctionEvaluations( convexFunction );
+    BOOST_CHECK_CLOSE_FRACTION( findRootWithRegulaFalsi( illinoisCounter, 0.0, 5.0,
+                                                         terminationCondition,
+                                                         illinoisRegulaFalsi ),
+                                expectedRoot, 1.0e-15 );
+    BOOST_CHECK_LE( illinoisCounter.numberOfFunctionEvaluations, 15 );
+
+    const FunctionEvaluationCounter< decltype( convexFunction ) > andersonBjorckCounter
+            = countFunctionEvaluations( convexFunction );
+    BOOST_CHECK_CLOSE_FRACTION( findRootWithRegulaFalsi( andersonBjorckCounter, 0.0, 5.0,
+                                                         terminationCondition ),
+                                expectedRoot, 1.0e-15 );
+    BOOST_CHECK_LE( andersonBjorckCounter.numberOfFunctionEvaluations, 15 );
+}
+
+//! Check expected functionality. Test interval that does not bracket the root.
+BOOST_AUTO_TEST_CASE( test_regulaFalsi_wrongBracket )
+{
+    boost::shared_ptr< TestFunction1 > testFunction = boost::make_shared< TestFunction1 >( 1 );
+
+    // Test regula falsi object. The input interval does not bracket the solution.
+    RegulaFalsiRootFinder regulaFalsi( 1.0e-12, 100, testFunction->getLowerBound( ), 0.0 );
+
+    // Check if a runtime error is thrown if the root finder is executed.
+    BOOST_CHECK_THROW( regulaFalsi.execute( testFunction ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( ) // testsuite_rootfinders
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,221 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      Unit test created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/make_shared.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Mathematics/RootFinders/bisection.h"
+#include "Tudat/Mathematics/RootFinders/halleyRootFinder.h"
+#include "Tudat/Mathematics/RootFinders/newtonRaphson.h"
+#include "Tudat/Mathematics/RootFinders/rootFindingAlgorithms.h"
+#include "Tudat/Mathematics/RootFinders/secantRootFinder.h"
+#include "Tudat/Mathematics/RootFinders/terminationConditions.h"
+#include "Tudat/Mathematics/RootFinders/UnitTests/testFunction3.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Function object for Kepler's equation, f(E) = E - e sin(E) - M, and its derivatives.
+struct KeplerEquationFunctor
+{
+    //! Constructor, taking eccentricity and mean anomaly.
+    KeplerEquationFunctor( const double anEccentricity, const double aMeanAnomaly )
+        : eccentricity( anEccentricity ), meanAnomaly( aMeanAnomaly )
+    { }
+
+    //! Evaluate function value.
+    double operator( )( const double eccentricAnomaly ) const
+    {
+        return eccentricAnomaly - eccentricity * std::sin( eccentricAnomaly ) - meanAnomaly;
+    }
+
+    //! Evaluate function value and first derivative.
+    void operator( )( const double eccentricAnomaly, double& functionValue,
+                      double& firstDerivativeValue ) const
+    {
+        const double sineOfEccentricAnomaly = std::sin( eccentricAnomaly );
+        functionValue = eccentricAnomaly - eccentricity * sineOfEccentricAnomaly - meanAnomaly;
+        firstDerivativeValue = 1.0 - eccentricity * std::cos( eccentricAnomaly );
+    }
+
+    //! Evaluate function value, and first and second derivative.
+    void operator( )( const double eccentricAnomaly, double& functionValue,
+                      double& firstDerivativeValue, double& secondDerivativeValue ) const
+    {
+        const double sineOfEccentricAnomaly = std::sin( eccentricAnomaly );
+        functionValue = eccentricAnomaly - eccentricity * sineOfEccentricAnomaly - meanAnomaly;
+        firstDerivativeValue = 1.0 - eccentricity * std::cos( eccentricAnomaly );
+        secondDerivativeValue = eccentricity * sineOfEccentricAnomaly;
+    }
+
+    //! Eccentricity.
+    double eccentricity;
+
+    //! Mean anomaly.
+    double meanAnomaly;
+};
+
+BOOST_AUTO_TEST_SUITE( testsuite_rootfinders )
+
+using namespace root_finders;
+using namespace root_finders::termination_conditions;
+
+//! Check if template root-finding functions converge on Kepler's equation.
+BOOST_AUTO_TEST_CASE( test_rootFindingAlgorithms_keplerEquation )
+{
+    const KeplerEquationFunctor keplerEquation( 0.7, 2.3 );
+    const RootToleranceTerminationFunctor< > terminationCondition( 1.0e-14, 0.0, 100 );
+
+    const double newtonRaphsonRoot
+            = findRootWithNewtonRaphson( keplerEquation, 2.3, terminationCondition );
+    const double halleyRoot = findRootWithHalley( keplerEquation, 2.3, terminationCondition );
+    const double secantRoot
+            = findRootWithSecant( keplerEquation, 2.0, 2.3, terminationCondition );
+    const double bisectionRoot
+            = findRootWithBisection( keplerEquation, 0.0, 4.0, terminationCondition );
+
+    // Check that roots agree with each other, and that the residual is small.
+    BOOST_CHECK_SMALL( keplerEquation( newtonRaphsonRoot ), 1.0e-15 );
+    BOOST_CHECK_CLOSE_FRACTION( halleyRoot, newtonRaphsonRoot, 1.0e-14 );
+    BOOST_CHECK_CLOSE_FRACTION( secantRoot, newtonRaphsonRoot, 1.0e-14 );
+    BOOST_CHECK_CLOSE_FRACTION( bisectionRoot, newtonRaphsonRoot, 1.0e-13 );
+}
+
+//! Check if template root-finding functions reproduce the root-finder classes.
+BOOST_AUTO_TEST_CASE( test_rootFindingAlgorithms_comparisonWithClasses )
+{
+    boost::shared_ptr< TestFunction3 > testFunction = boost::make_shared< TestFunction3 >( 2 );
+    const double relativeTolerance = 1.0e-13;
+    const unsigned int maximumNumberOfIterations = 100;
+
+    // Define the test function as a C++11 lambda.
+    const double trueRoot = testFunction->getTrueRootLocation( );
+    auto functionValue = [ ]( const double x ) { return std::cos( x ) - x; };
+    auto functionDerivatives = [ ]( const double x, double& value, double& firstDerivative,
+            double& secondDerivative )
+    {
+        value = std::cos( x ) - x;
+        firstDerivative = -1.0 - std::sin( x );
+        secondDerivative = -std::cos( x );
+    };
+    auto functionFirstDerivative = [ ]( const double x, double& value, double& firstDerivative )
+    {
+        value = std::cos( x ) - x;
+        firstDerivative = -1.0 - std::sin( x );
+    };
+
+    const RootToleranceTerminationFunctor< > terminationCondition(
+                relativeTolerance, 0.0, maximumNumberOfIterations );
+
+    // Newton-Raphson.
+    NewtonRaphson newtonRaphson( relativeTolerance, maximumNumberOfIterations );
+    BOOST_CHECK_EQUAL( findRootWithNewtonRaphson( functionFirstDerivative, -2.0,
+                                                  terminationCondition ),
+                       newtonRaphson.execute( testFunction, -2.0 ) );
+
+    // Halley.
+    HalleyRootFinder halley( relativeTolerance, maximumNumberOfIterations );
+    BOOST_CHECK_EQUAL( findRootWithHalley( functionDerivatives, -2.0, terminationCondition ),
+                       halley.execute( testFunction, -2.0 ) );
+
+    // Secant.
+    SecantRootFinder secant( relativeTolerance, maximumNumberOfIterations, 0.5 );
+    BOOST_CHECK_EQUAL( findRootWithSecant( functionValue, 0.5, 1.0, terminationCondition ),
+                       secant.execute( testFunction, 1.0 ) );
+
+    // Bisection.
+    Bisection bisection( relativeTolerance, maximumNumberOfIterations, -1.0, 2.0 );
+    BOOST_CHECK_EQUAL( findRootWithBisection( functionValue, -1.0, 2.0, terminationCondition ),
+                       bisection.execute( testFunction ) );
+
+    // Check accuracy of roots.
+    BOOST_CHECK_CLOSE_FRACTION( newtonRaphson.execute( testFunction, -2.0 ), trueRoot, 1.0e-15 );
+    BOOST_CHECK_CLOSE_FRACTION( halley.execute( testFunction, -2.0 ), trueRoot, 1.0e-15 );
+    BOOST_CHECK_CLOSE_FRACTION( secant.execute( testFunction, 1.0 ), trueRoot, 1.0e-15 );
+    BOOST_CHECK_CLOSE_FRACTION( bisection.execute( testFunction ), trueRoot, 1.0e-12 );
+}
+
+//! Check if the number of iterations is passed to the termination condition correctly.
+BOOST_AUTO_TEST_CASE( test_rootFindingAlgorithms_iterationCount )
+{
+    const KeplerEquationFunctor keplerEquation( 0.1, 1.0 );
+
+    // Terminate after a fixed number of iterations, and record the iteration count.
+    unsigned int numberOfIterations = 0;
+    auto terminationCondition = [ &numberOfIterations ](
+            const double, const double, const double, const double, const unsigned int counter )
+    {
+        numberOfIterations = counter;
+        return counter >= 4;
+    };
+
+    // Three bisection iterations should reduce the bracket [0, 2] to [1, 1.25].
+    const double bisectionRoot
+            = findRootWithBisection( keplerEquation, 0.0, 2.0, terminationCondition );
+    BOOST_CHECK_EQUAL( numberOfIterations, 4 );
+    BOOST_CHECK_EQUAL( bisectionRoot, 1.125 );
+}
+
+//! Check if exceptions are thrown for invalid bracket and non-convergence.
+BOOST_AUTO_TEST_CASE( test_rootFindingAlgorithms_exceptions )
+{
+    const KeplerEquationFunctor keplerEquation( 0.5, 1.0 );
+
+    // Bracket does not contain root.
+    BOOST_CHECK_THROW( findRootWithBisection( keplerEquation, 2.0, 3.0,
+                                              RootToleranceTerminationFunctor< >( ) ),
+                       std::runtime_error );
+
+    // Maximum number of iterations too small for required tolerance.
+    BOOST_CHECK_THROW( findRootWithNewtonRaphson( keplerEquation, 3.0,
+                                                  RootToleranceTerminationFunctor< >(
+                                                      1.0e-15, 0.0, 2 ) ),
+                       std::runtime_error );
+
+    // No exception, if run-time exception flag is not set.
+    BOOST_CHECK_NO_THROW( findRootWithNewtonRaphson( keplerEquation, 3.0,
+                                                     RootToleranceTerminationFunctor< >(
+                                                         1.0e-15, 0.0, 2, false ) ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END( ) // testsuite_rootfinders
+
+} // namespace unit_tests
+} // namespace tudat
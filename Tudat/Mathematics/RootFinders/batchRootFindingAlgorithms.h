@@ -0,0 +1,313 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Store intermediate arrays of lane update in workspace.
+ *
+ *    References
+ *
+ *    Notes
+ *      The batch root-finders in this file solve a set of independent scalar equations (e.g.,
+ *      Kepler's equation for a catalog of orbits) simultaneously. All lanes (equations) are
+ *      iterated together, using Eigen array expressions that the compiler can vectorize, instead
+ *      of solving the equations one by one in branchy scalar loops. Lanes that have converged (or
+ *      failed) are masked out, i.e., their root values are no longer updated, while the iteration
+ *      continues until all lanes are inactive or the maximum number of iterations is reached.
+ *
+ *      The root function is evaluated for all lanes in each iteration, including the inactive
+ *      ones, so that its evaluation remains a single vectorized expression. It should therefore
+ *      be safe to evaluate at the (frozen) root values of inactive lanes.
+ *
+ */
+
+#ifndef TUDAT_BATCH_ROOT_FINDING_ALGORITHMS_H
+#define TUDAT_BATCH_ROOT_FINDING_ALGORITHMS_H
+
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Mathematics/RootFinders/terminationConditions.h"
+
+namespace tudat
+{
+namespace root_finders
+{
+
+//! Result of batch root-finding.
+/*!
+ * Result of batch root-finding, containing the root, number of iterations and convergence flag of
+ * each lane.
+ * \tparam ScalarType Data type used to represent floating-point values.
+ */
+template< typename ScalarType = double >
+struct BatchRootFindingResult
+{
+    //! Typedef for array of floating-point values.
+    typedef Eigen::Array< ScalarType, Eigen::Dynamic, 1 > ScalarArray;
+
+    //! Constructor.
+    /*!
+     * Constructor, initializing the roots to the initial guesses, the number of iterations to
+     * zero, and the convergence flags to false.
+     * \param initialGuesses Initial guesses of the roots of all lanes.
+     */
+    BatchRootFindingResult( const ScalarArray& initialGuesses )
+        : roots( initialGuesses ),
+          numberOfIterations( Eigen::ArrayXi::Zero( initialGuesses.rows( ) ) ),
+          isConverged( Eigen::Array< bool, Eigen::Dynamic, 1 >::Constant(
+                           initialGuesses.rows( ), false ) )
+    { }
+
+    //! Check whether all lanes have converged.
+    /*!
+     * Checks whether all lanes have converged.
+     * \return True if all lanes have converged.
+     */
+    bool haveAllLanesConverged( ) const
+    {
+        return isConverged.all( );
+    }
+
+    //! Roots found for all lanes (last iterate for lanes that did not converge).
+    ScalarArray roots;
+
+    //! Number of iterations (root updates) performed for each lane.
+    Eigen::ArrayXi numberOfIterations;
+
+    //! Flags indicating whether each lane has converged.
+    Eigen::Array< bool, Eigen::Dynamic, 1 > isConverged;
+};
+
+//! Workspace of batch root-finding.
+/*!
+ * Workspace of batch root-finding, containing the intermediate arrays of the update of the lanes,
+ * which are allocated once by the root-finder, instead of in each iteration.
+ * \tparam ScalarType Data type used to represent floating-point values.
+ */
+template< typename ScalarType = double >
+struct BatchRootFindingWorkspace
+{
+    //! Constructor.
+    /*!
+     * Constructor, allocating the arrays for the given number of lanes.
+     * \param numberOfLanes Number of lanes (equations) that are solved simultaneously.
+     */
+    BatchRootFindingWorkspace( const int numberOfLanes )
+        : nextRoots( numberOfLanes ), rootChanges( numberOfLanes ),
+          isLaneUpdated( numberOfLanes ), hasLaneConverged( numberOfLanes )
+    { }
+
+    //! Roots of all lanes after current update.
+    Eigen::Array< ScalarType, Eigen::Dynamic, 1 > nextRoots;
+
+    //! Changes of roots of all lanes in current update.
+    Eigen::Array< ScalarType, Eigen::Dynamic, 1 > rootChanges;
+
+    //! Flags indicating whether root of each lane is updated in current update.
+    Eigen::Array< bool, Eigen::Dynamic, 1 > isLaneUpdated;
+
+    //! Flags indicating whether each lane has converged in current update.
+    Eigen::Array< bool, Eigen::Dynamic, 1 > hasLaneConverged;
+};
+
+//! Update roots of active lanes in batch root-finding.
+/*!
+ * Updates the roots of the active lanes in batch root-finding, and checks for convergence and
+ * failure of each lane. The convergence check is identical to that of the
+ * RootToleranceTerminationFunctor, i.e., a lane has converged if the absolute or relative
+ * tolerance for the root value is achieved. A lane fails if its updated root is not finite, in
+ * which case the last finite root value is retained.
+ * \param rootUpdates Updates to be subtracted from the roots of all lanes.
+ * \param terminationCondition Termination condition, of which the tolerances are used.
+ * \param result Batch root-finding result, of which the roots, number of iterations and
+ *          convergence flags are updated (returned by reference).
+ * \param isLaneActive Flags indicating whether each lane is active, updated to deactivate lanes
+ *          that have converged or failed (returned by reference).
+ * \param workspace Workspace in which the intermediate arrays of the update are stored, sized to
+ *          the number of lanes (returned by reference).
+ */
+template< typename ScalarType >
+inline void updateBatchRootFindingLanes(
+        const Eigen::Array< ScalarType, Eigen::Dynamic, 1 >& rootUpdates,
+        const termination_conditions::RootToleranceTerminationFunctor< ScalarType >&
+        terminationCondition,
+        BatchRootFindingResult< ScalarType >& result,
+        Eigen::Array< bool, Eigen::Dynamic, 1 >& isLaneActive,
+        BatchRootFindingWorkspace< ScalarType >& workspace )
+{
+    workspace.nextRoots = result.roots - rootUpdates;
+    workspace.rootChanges = workspace.nextRoots - result.roots;
+    workspace.isLaneUpdated = isLaneActive && workspace.nextRoots.isFinite( );
+    workspace.hasLaneConverged
+            = workspace.isLaneUpdated
+            && ( ( workspace.rootChanges.abs( ) < terminationCondition.absoluteTolerance )
+                 || ( ( workspace.rootChanges / workspace.nextRoots ).abs( )
+                      < terminationCondition.relativeTolerance ) );
+
+    result.roots = workspace.isLaneUpdated.select( workspace.nextRoots, result.roots );
+    result.numberOfIterations += workspace.isLaneUpdated.template cast< int >( );
+    result.isConverged = result.isConverged || workspace.hasLaneConverged;
+    isLaneActive = workspace.isLaneUpdated && !workspace.hasLaneConverged;
+}
+
+//! Check whether all lanes in batch root-finding have converged.
+/*!
+ * Checks whether all lanes in batch root-finding have converged, and throws an exception if this
+ * is not the case and the termination condition requires run-time exceptions to be thrown.
+ * \param result Batch root-finding result.
+ * \param terminationCondition Termination condition.
+ * \throws std::runtime_error If any lane did not converge, and the run-time exception flag of the
+ *          termination condition is set.
+ */
+template< typename ScalarType >
+inline void checkBatchRootFindingConvergence(
+        const BatchRootFindingResult< ScalarType >& result,
+        const termination_conditions::RootToleranceTerminationFunctor< ScalarType >&
+        terminationCondition )
+{
+    if( terminationCondition.throwRunTimeException && !result.haveAllLanesConverged( ) )
+    {
+        std::stringstream errorMessage;
+        errorMessage << "Batch root-finder did not converge for "
+                     << ( !result.isConverged ).count( ) << " of " << result.isConverged.rows( )
+                     << " lanes within maximum number of iterations!" << std::endl;
+        boost::throw_exception( boost::enable_error_info(
+                                    std::runtime_error( errorMessage.str( ) ) ) );
+    }
+}
+
+//! Find roots of a batch of independent scalar equations using the Newton-Raphson method.
+/*!
+ * Finds roots of a batch of independent scalar equations using the Newton-Raphson method, in
+ * which all lanes are iterated simultaneously (see file notes). Each lane is iterated until the
+ * absolute or relative tolerance of the termination condition is achieved, or until the maximum
+ * number of iterations of the termination condition has been performed.
+ * \tparam ScalarType Data type used to represent floating-point values.
+ * \tparam BatchRootFunction Type of function object, which is called as
+ *          rootFunction( x, functionValues, firstDerivativeValues ) with Eigen arrays of type
+ *          Eigen::Array< ScalarType, Eigen::Dynamic, 1 >, and sets the function values and their
+ *          first derivatives at x in the last two (reference) arguments, for all lanes.
+ * \param rootFunction Function to find roots of.
+ * \param initialGuesses Initial guesses of the roots of all lanes.
+ * \param terminationCondition Termination condition, specifying the tolerances, maximum number
+ *          of iterations, and whether an exception is thrown if any lane does not converge.
+ * \throws std::runtime_error If any lane did not converge, and the run-time exception flag of the
+ *          termination condition is set.
+ * \return Roots, number of iterations and convergence flag of all lanes.
+ */
+template< typename ScalarType, typename BatchRootFunction >
+BatchRootFindingResult< ScalarType > findRootsWithNewtonRaphsonBatch(
+        const BatchRootFunction& rootFunction,
+        const Eigen::Array< ScalarType, Eigen::Dynamic, 1 >& initialGuesses,
+        const termination_conditions::RootToleranceTerminationFunctor< ScalarType >&
+        terminationCondition )
+{
+    BatchRootFindingResult< ScalarType > result( initialGuesses );
+    Eigen::Array< bool, Eigen::Dynamic, 1 > isLaneActive = initialGuesses.isFinite( );
+
+    // Allocate buffers for function values, derivatives and lane updates once.
+    Eigen::Array< ScalarType, Eigen::Dynamic, 1 > functionValues( initialGuesses.rows( ) );
+    Eigen::Array< ScalarType, Eigen::Dynamic, 1 > firstDerivativeValues( initialGuesses.rows( ) );
+    Eigen::Array< ScalarType, Eigen::Dynamic, 1 > rootUpdates( initialGuesses.rows( ) );
+    BatchRootFindingWorkspace< ScalarType > workspace( initialGuesses.rows( ) );
+
+    for( unsigned int iteration = 0; iteration < terminationCondition.maximumNumberOfIterations
+         && isLaneActive.any( ); iteration++ )
+    {
+        rootFunction( result.roots, functionValues, firstDerivativeValues );
+        rootUpdates = functionValues / firstDerivativeValues;
+        updateBatchRootFindingLanes( rootUpdates, terminationCondition, result, isLaneActive,
+                                     workspace );
+    }
+
+    checkBatchRootFindingConvergence( result, terminationCondition );
+
+    return result;
+}
+
+//! Find roots of a batch of independent scalar equations using Halley's method.
+/*!
+ * Finds roots of a batch of independent scalar equations using Halley's method, in which all
+ * lanes are iterated simultaneously (see file notes). Each lane is iterated until the absolute or
+ * relative tolerance of the termination condition is achieved, or until the maximum number of
+ * iterations of the termination condition has been performed.
+ * \tparam ScalarType Data type used to represent floating-point values.
+ * \tparam BatchRootFunction Type of function object, which is called as
+ *          rootFunction( x, functionValues, firstDerivativeValues, secondDerivativeValues ) with
+ *          Eigen arrays of type Eigen::Array< ScalarType, Eigen::Dynamic, 1 >, and sets the
+ *          function values and their first and second derivatives at x in the last three
+ *          (reference) arguments, for all lanes.
+ * \param rootFunction Function to find roots of.
+ * \param initialGuesses Initial guesses of the roots of all lanes.
+ * \param terminationCondition Termination condition, specifying the tolerances, maximum number
+ *          of iterations, and whether an exception is thrown if any lane does not converge.
+ * \throws std::runtime_error If any lane did not converge, and the run-time exception flag of the
+ *          termination condition is set.
+ * \return Roots, number of iterations and convergence flag of all lanes.
+ */
+template< typename ScalarType, typename BatchRootFunction >
+BatchRootFindingResult< ScalarType > findRootsWithHalleyBatch(
+        const BatchRootFunction& rootFunction,
+        const Eigen::Array< ScalarType, Eigen::Dynamic, 1 >& initialGuesses,
+        const termination_conditions::RootToleranceTerminationFunctor< ScalarType >&
+        terminationCondition )
+{
+    BatchRootFindingResult< ScalarType > result( initialGuesses );
+    Eigen::Array< bool, Eigen::Dynamic, 1 > isLaneActive = initialGuesses.isFinite( );
+
+    // Allocate buffers for function values and derivatives once.
+    Eigen::Array< ScalarType, Eigen::Dynamic, 1 > functionValues( initialGuesses.rows( ) );
+    Eigen::Array< ScalarType, Eigen::Dynamic, 1 > firstDerivativeValues( initialGuesses.rows( ) );
+    Eigen::Array< ScalarType, Eigen::Dynamic, 1 > secondDerivativeValues(
+                initialGuesses.rows( ) );
+    Eigen::Array< ScalarType, Eigen::Dynamic, 1 > rootUpdates( initialGuesses.rows( ) );
+    BatchRootFindingWorkspace< ScalarType > workspace( initialGuesses.rows( ) );
+
+    for( unsigned int iteration = 0; iteration < terminationCondition.maximumNumberOfIterations
+         && isLaneActive.any( ); iteration++ )
+    {
+        rootFunction( result.roots, functionValues, firstDerivativeValues,
+                      secondDerivativeValues );
+        rootUpdates = 2.0 * functionValues * firstDerivativeValues
+                / ( 2.0 * firstDerivativeValues.square( )
+                    - functionValues * secondDerivativeValues );
+        updateBatchRootFindingLanes( rootUpdates, terminationCondition, result, isLaneActive,
+                                     workspace );
+    }
+
+    checkBatchRootFindingConvergence( result, terminationCondition );
+
+    return result;
+}
+
+} // namespace root_finders
+} // namespace tudat
+
+#endif // TUDAT_BATCH_ROOT_FINDING_ALGORITHMS_H
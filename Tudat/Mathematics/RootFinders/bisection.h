@@ -27,6 +27,8 @@
  *      120208    S. Billemont      Creation of code.
  *      140219    E. Brandon        Adapted to current Tudat root-finder structure.
  *      150417    D. Dirkx          Made modifications for templated root finding.
+ *      261018                      Made adapter of template root-finding function.
+ *      261018                      Made type of bounds equal to root finder data type.
  *
  *    References
  *      Press W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing. Cambridge
@@ -54,6 +56,7 @@
 
 #include "Tudat/Basics/utilityMacros.h"
 #include "Tudat/Mathematics/RootFinders/rootFinder.h"
+#include "Tudat/Mathematics/RootFinders/rootFindingAlgorithms.h"
 #include "Tudat/Mathematics/RootFinders/terminationConditions.h"
 
 namespace tudat
@@ -162,79 +165,11 @@ public:
         // Set the root function.
         this->rootFunction = rootFunction;
 
-        // Initialize previous values.
-        DataType previousRootValue = TUDAT_NAN;
-        DataType previousRootFunctionValue = TUDAT_NAN;
-
-        // Duplicate the interval and use this duplicate to shrink the interval.
-        // Compute the midpoint of the interval, and take this as the current root.
-        DataType currentLowerBound = lowerBound_;
-        DataType currentUpperBound = upperBound_;
-        DataType rootValue = ( currentLowerBound + currentUpperBound ) / 2.0;
-
-        // Find the corresponding function values at the important interval points (lower bound,
-        // upper bound and midpoint).
-        DataType currentLowerBoundFunctionValue = this->rootFunction->evaluate( currentLowerBound );
-        DataType currentUpperBoundFunctionValue = this->rootFunction->evaluate( currentUpperBound );
-        DataType rootFunctionValue = this->rootFunction->evaluate( rootValue );
-
-        // Validate that upperbound and lowerbound function values have different signs
-        // (requirement).
-        if( currentLowerBoundFunctionValue * currentUpperBoundFunctionValue > 0.0 )
-        {
-            boost::throw_exception( boost::enable_error_info( std::runtime_error(
-                                                                  boost::str( boost::format(
-                                                                                  "The Bisection algorithm requires that the values at the upper "
-                                                                                  "and lower bounds have a different sign." ) ) ) ) );
-        }
-
-        // Loop counter.
-        unsigned int counter = 1;
-
-        // Loop until we have a solution with sufficient accuracy.
-        do
-        {
-            // Save old values.
-            previousRootValue = rootValue;
-            previousRootFunctionValue = rootFunctionValue;
-
-            // Check which subinterval to keep, by maintaining endpoints with opposite function
-            // value signs.
-            if( rootFunctionValue * currentLowerBoundFunctionValue < 0.0 )
-            {
-                // Different sign, hence the upper bound is replaced.
-                currentUpperBound = rootValue;
-                currentUpperBoundFunctionValue = rootFunctionValue;
-            }
-            else
-            {
-                // Same sign, hence the lower bound is replaced.
-                currentLowerBound = rootValue;
-                currentLowerBoundFunctionValue = rootFunctionValue;
-            }
-
-            // Compute the new midpoint of the interval and its function value.
-            rootValue = ( currentLowerBound + currentUpperBound ) / 2.0;
-            rootFunctionValue = this->rootFunction->evaluate( rootValue );
-
-            // Sanity check.
-            if( currentLowerBoundFunctionValue * currentUpperBoundFunctionValue > 0.0 )
-            {
-                boost::throw_exception( boost::enable_error_info( std::runtime_error(
-                                                                      boost::str( boost::format(
-                                                                                      "The Bisection algorithm requires that the values at the upper "
-                                                                                      "and lower bounds have a different sign, error during iteration." ) ) ) ) );
-            }
-
-            counter++;
-        }
-        while( !this->terminationFunction( rootValue, previousRootValue, rootFunctionValue,
-                                           previousRootFunctionValue, counter ) );
-
-        //std::cout<<"Ecc B: "<<rootValue<<" "<<this->rootFunction->evaluate( rootValue )<<std::endl;
-
-        return rootValue;
-
+        // Find root using the template root-finding function.
+        return findRootWithBisection(
+                    RootFunctionValueEvaluator< DataType >( this->rootFunction ),
+                    static_cast< DataType >( lowerBound_ ), static_cast< DataType >( upperBound_ ),
+                    this->terminationFunction );
     }
 
     //! Reset the bracket of the solution.
@@ -256,10 +191,10 @@ protected:
 private:
 
     //! Lower bound of the bracket containing the solution.
-    double lowerBound_;
+    DataType lowerBound_;
 
     //! Upper bound of the bracket containing the solution.
-    double upperBound_;
+    DataType upperBound_;
 
 };
 
@@ -0,0 +1,208 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *
+ *    References
+ *      Brent, R.P. Algorithms for Minimization without Derivatives, Prentice-Hall, 1973.
+ *      Press W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing. Cambridge
+ *          University Press, February 2002.
+ *
+ *    Notes
+ *
+ */
+
+#ifndef TUDAT_BRENT_ROOT_FINDER_H
+#define TUDAT_BRENT_ROOT_FINDER_H
+
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "Tudat/Basics/utilityMacros.h"
+#include "Tudat/Mathematics/RootFinders/rootFinder.h"
+#include "Tudat/Mathematics/RootFinders/rootFindingAlgorithms.h"
+#include "Tudat/Mathematics/RootFinders/terminationConditions.h"
+
+namespace tudat
+{
+namespace root_finders
+{
+
+//! Brent's root-finding method.
+/*!
+ * Brent's root-finding method (Brent, 1973), a bracketed root-finder that combines the robustness
+ * of bisection with the superlinear convergence of inverse quadratic interpolation. Like
+ * bisection, it requires only the function of which the zero is sought (no derivatives), and a
+ * lower and upper bound at which the function values have an opposite sign. For smooth
+ * functions, it typically requires only a fraction of the function evaluations of the bisection
+ * method. See findRootWithBrent() for details of the algorithm.
+ *
+ * Defined shorthand notations:
+ *  BrentRootFinderCore< double >   =>   BrentRootFinder
+ *
+ * \tparam DataType Data type used to represent floating-point values.
+ */
+template< typename DataType = double >
+class BrentRootFinderCore : public RootFinderCore< DataType >
+{
+public:
+
+    //! Useful type definition for the function pointer (from base class).
+    typedef typename RootFinderCore< DataType >::FunctionPointer FunctionPointer;
+
+    //! Useful type definition for the termination function (from base class).
+    typedef typename RootFinderCore< DataType >::TerminationFunction TerminationFunction;
+
+    //! Constructor taking a general termination function and the bracket of the solution.
+    /*!
+     * Constructor of the Brent root-finder, taking the termination function (function
+     * determining whether to terminate the root-finding process) and the search interval with an
+     * upper and lower bound. It is required that the function values at upper and lower bound have
+     * an opposite sign. The default interval is [-1, 1].
+     *
+     * \param terminationFunction The function specifying the termination conditions of the
+     *          root-finding process. \sa RootFinderCore::terminationFunction
+     * \param lowerBound Lower bound of the interval containing a root. (Default is -1.0).
+     * \param upperBound Upper bound of the interval containing a root. (Default is 1.0).
+     */
+    BrentRootFinderCore( const TerminationFunction terminationFunction,
+                         const DataType lowerBound = -1.0,
+                         const DataType upperBound = 1.0 )
+        : RootFinderCore< DataType >( terminationFunction ),
+          lowerBound_( lowerBound ),
+          upperBound_( upperBound ),
+          numberOfFunctionEvaluations_( 0 )
+    { }
+
+    //! Constructor taking typical convergence criteria and the bracket of the solution.
+    /*!
+     * Constructor of the Brent root-finder, taking the maximum number of iterations, the
+     * relative tolerance for the independent variable, and the search interval with upper and
+     * lower bound. It is required that the function values at upper and lower bound have an
+     * opposite sign. The default interval is [-1, 1]. If desired, a custom convergence function
+     * can be provided to the alternative constructor.
+     *
+     * \param relativeXTolerance Relative difference between the root solution of two subsequent
+     *          solutions below which convergence is reached.
+     * \param maxIterations Maximum number of iterations after which the root finder is
+     *          terminated, i.e. convergence is assumed.
+     * \param lowerBound Lower bound of the interval containing a root. (Default is -1.0).
+     * \param upperBound Upper bound of the interval containing a root. (Default is 1.0).
+     */
+    BrentRootFinderCore( const DataType relativeXTolerance, const unsigned int maxIterations,
+                         const DataType lowerBound = -1.0, const DataType upperBound = 1.0 )
+        : RootFinderCore< DataType >(
+              boost::bind(
+                  &termination_conditions::RootRelativeToleranceTerminationCondition< DataType >::
+                  checkTerminationCondition, boost::make_shared<
+                  termination_conditions::RootRelativeToleranceTerminationCondition< DataType > >(
+                      relativeXTolerance, maxIterations ), _1, _2, _3, _4, _5 ) ),
+          lowerBound_( lowerBound ),
+          upperBound_( upperBound ),
+          numberOfFunctionEvaluations_( 0 )
+    { }
+
+    //! Default destructor.
+    ~BrentRootFinderCore( ) { }
+
+    //! Find a root of the function provided as input.
+    /*!
+     * Find a root of the function provided as input, using the termination function set by the
+     * constructor. (Note that the initial guess is not used, but is a requirement of the
+     * root-finder architecture.)
+     *
+     * \param rootFunction Function to find the root of.
+     * \param initialGuess The initial guess of the root. (Not used, default is 0.0).
+     * \return Root of the rootFunction that is found.
+     *
+     * \throws std::runtime_error If the interval does not bracket the root.
+     */
+    DataType execute( const FunctionPointer rootFunction, const DataType initialGuess = 0.0 )
+    {
+        // The value of the initialGuess is not used.
+        TUDAT_UNUSED_PARAMETER( initialGuess );
+
+        // Set the root function.
+        this->rootFunction = rootFunction;
+
+        // Find root using the template root-finding function, counting the function evaluations.
+        const RootFunctionValueEvaluator< DataType > functionEvaluator( this->rootFunction );
+        const FunctionEvaluationCounter< RootFunctionValueEvaluator< DataType > >
+                countedFunctionEvaluator( functionEvaluator );
+        numberOfFunctionEvaluations_ = 0;
+        const DataType root = findRootWithBrent(
+                    countedFunctionEvaluator, static_cast< DataType >( lowerBound_ ),
+                    static_cast< DataType >( upperBound_ ), this->terminationFunction );
+        numberOfFunctionEvaluations_ = countedFunctionEvaluator.numberOfFunctionEvaluations;
+
+        return root;
+    }
+
+    //! Reset the bracket of the solution.
+    /*!
+     * Resets the search interval with an upper and lower bound. It is required that the function
+     * values at upper and lower bound have an opposite sign.
+     *
+     * \param lowerBound Lower bound of the interval containing a root.
+     * \param upperBound Upper bound of the interval containing a root.
+     */
+    void resetBoundaries( const DataType lowerBound, const DataType upperBound )
+    {
+        this->lowerBound_ = lowerBound;
+        this->upperBound_ = upperBound;
+    }
+
+    //! Get number of function evaluations.
+    /*!
+     * Returns the number of function evaluations during the last successful call to execute().
+     * \return Number of function evaluations.
+     */
+    unsigned int getNumberOfFunctionEvaluations( ) { return numberOfFunctionEvaluations_; }
+
+protected:
+
+private:
+
+    //! Lower bound of the bracket containing the solution.
+    DataType lowerBound_;
+
+    //! Upper bound of the bracket containing the solution.
+    DataType upperBound_;
+
+    //! Number of function evaluations during last call to execute().
+    unsigned int numberOfFunctionEvaluations_;
+
+};
+
+// Some handy typedefs.
+typedef BrentRootFinderCore< double > BrentRootFinder;
+typedef boost::shared_ptr< BrentRootFinder > BrentRootFinderPointer;
+
+} // namespace root_finders
+} // namespace tudat
+
+#endif // TUDAT_BRENT_ROOT_FINDER_H
@@ -27,6 +27,7 @@
  *      120208    S. Billemont      Creation of code.
  *      140219    E. Brandon        Adapted to current Tudat root-finder structure.
  *      150417    D. Dirkx          Made modifications for templated root finding.
+ *      261018                      Made adapter of template root-finding function.
  *
  *    References
  *      Press W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing. Cambridge
@@ -50,6 +51,7 @@
 #include <boost/shared_ptr.hpp>
 
 #include "Tudat/Mathematics/RootFinders/rootFinder.h"
+#include "Tudat/Mathematics/RootFinders/rootFindingAlgorithms.h"
 #include "Tudat/Mathematics/RootFinders/terminationConditions.h"
 
 namespace tudat
@@ -145,46 +147,10 @@ public:
         // Set the root function.
         this->rootFunction = rootFunction;
 
-        // Start at initial guess, and compute the function value, its first and second derivative.
-        DataType currentRootValue             = TUDAT_NAN;
-        DataType nextRootValue                = initialGuess;
-        DataType currentFunctionValue         = TUDAT_NAN;
-        DataType nextFunctionValue            = this->rootFunction->evaluate( nextRootValue );
-        DataType currentFirstDerivativeValue  = TUDAT_NAN;
-        DataType nextFirstDerivativeValue     = this->rootFunction->
-                computeDerivative( 1, nextRootValue );
-        DataType currentSecondDerivativeValue = TUDAT_NAN;
-        DataType nextSecondDerivativeValue    = this->rootFunction->
-                computeDerivative( 2, nextRootValue );
-
-        // Loop counter.
-        unsigned int counter = 1;
-
-        // Loop until we have a solution with sufficient accuracy.
-        do
-        {
-            // Save the old values.
-            currentRootValue             = nextRootValue;
-            currentFunctionValue         = nextFunctionValue;
-            currentFirstDerivativeValue  = nextFirstDerivativeValue;
-            currentSecondDerivativeValue = nextSecondDerivativeValue;
-
-            // Compute next value of root using the following algorithm (see class documentation):
-            nextRootValue               = currentRootValue
-                    - ( ( 2.0 * currentFunctionValue * currentFirstDerivativeValue )
-                        / ( 2.0 * currentFirstDerivativeValue * currentFirstDerivativeValue
-                            - currentFunctionValue * currentSecondDerivativeValue ) );
-            nextFunctionValue           = this->rootFunction->evaluate( nextRootValue );
-            nextFirstDerivativeValue    = this->rootFunction->computeDerivative( 1, nextRootValue );
-            nextSecondDerivativeValue   = this->rootFunction->computeDerivative( 2, nextRootValue );
-
-            // Update the counter.
-            counter++;
-        }
-        while( !this->terminationFunction( nextRootValue, currentRootValue, nextFunctionValue,
-                                           currentFunctionValue, counter ) );
-
-        return nextRootValue;
+        // Find root using the template root-finding function.
+        return findRootWithHalley(
+                    RootFunctionDerivativeEvaluator< DataType >( this->rootFunction ),
+                    initialGuess, this->terminationFunction );
     }
 
 protected:
@@ -43,6 +43,7 @@
  *      140312    E. Brandon        Removed unneccesary include statement, minor correction Doxygen
  *                                  comments.
  *      150417    D. Dirkx          Made modifications for templated root finding.
+ *      261018                      Made adapter of template root-finding function.
  *
  *    References
  *
@@ -60,6 +61,7 @@
 #include <boost/shared_ptr.hpp>
 
 #include "Tudat/Mathematics/RootFinders/rootFinder.h"
+#include "Tudat/Mathematics/RootFinders/rootFindingAlgorithms.h"
 #include "Tudat/Mathematics/RootFinders/terminationConditions.h"
 #include "Tudat/Mathematics/BasicMathematics/convergenceException.h"
 
@@ -144,39 +146,10 @@ public:
         // Set the root function.
         this->rootFunction = rootFunction;
 
-        // Start at initial guess, and compute the function value and its first derivative.
-        DataType currentRootValue       = TUDAT_NAN;
-        DataType nextRootValue          = initialGuess;
-        DataType currentFunctionValue   = TUDAT_NAN;
-        DataType nextFunctionValue      = this->rootFunction->evaluate( nextRootValue );
-        DataType currentDerivativeValue = TUDAT_NAN;
-        DataType nextDerivativeValue    = this->rootFunction->
-                computeDerivative( 1, nextRootValue );
-
-        // Loop counter.
-        unsigned int counter = 1;
-
-        // Loop until we have a solution with sufficient accuracy.
-        do
-        {
-            // Save the old values.
-            currentRootValue       = nextRootValue;
-            currentFunctionValue   = nextFunctionValue;
-            currentDerivativeValue = nextDerivativeValue;
-
-            // Compute next value of root using the following algorithm (see class documentation):
-            nextRootValue          = currentRootValue -
-                    currentFunctionValue / currentDerivativeValue;
-            nextFunctionValue      = this->rootFunction->evaluate( nextRootValue );
-            nextDerivativeValue    = this->rootFunction->computeDerivative( 1, nextRootValue );
-
-            // Update the counter.
-            counter++;
-        }
-        while( !this->terminationFunction( nextRootValue, currentRootValue, nextFunctionValue,
-                                           currentFunctionValue, counter ) );
-
-        return nextRootValue;
+        // Find root using the template root-finding function.
+        return findRootWithNewtonRaphson(
+                    RootFunctionDerivativeEvaluator< DataType >( this->rootFunction ),
+                    initialGuess, this->terminationFunction );
     }
 
 protected:
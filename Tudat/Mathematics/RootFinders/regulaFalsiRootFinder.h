@@ -0,0 +1,231 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *
+ *    References
+ *      Dowell, M., Jarratt, P. A modified regula falsi method for computing the root of an
+ *          equation, BIT Numerical Mathematics, 11(2), 168-174, 1971.
+ *      Anderson, N., Bjorck, A. A new high order method of regula falsi type for computing a root
+ *          of an equation, BIT Numerical Mathematics, 13(3), 253-264, 1973.
+ *
+ *    Notes
+ *
+ */
+
+#ifndef TUDAT_REGULA_FALSI_ROOT_FINDER_H
+#define TUDAT_REGULA_FALSI_ROOT_FINDER_H
+
+#include <boost/bind.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include "Tudat/Basics/utilityMacros.h"
+#include "Tudat/Mathematics/RootFinders/rootFinder.h"
+#include "Tudat/Mathematics/RootFinders/rootFindingAlgorithms.h"
+#include "Tudat/Mathematics/RootFinders/terminationConditions.h"
+
+namespace tudat
+{
+namespace root_finders
+{
+
+//! Regula falsi root-finding method.
+/*!
+ * Modified regula falsi (false position) root-finding method, a bracketed root-finder that
+ * replaces the midpoint of the bisection method by the root of the secant through the bounds of
+ * the bracket. The Illinois (Dowell & Jarratt, 1971) and Anderson-Bjorck (Anderson & Bjorck,
+ * 1973) modifications of the method are implemented, which scale the function value at a bound
+ * that is retained repeatedly, to obtain superlinear convergence. Like bisection, it requires
+ * only the function of which the zero is sought (no derivatives), and a lower and upper bound at
+ * which the function values have an opposite sign. See findRootWithRegulaFalsi() for details of
+ * the algorithm.
+ *
+ * Defined shorthand notations:
+ *  RegulaFalsiRootFinderCore< double >   =>   RegulaFalsiRootFinder
+ *
+ * \tparam DataType Data type used to represent floating-point values.
+ */
+template< typename DataType = double >
+class RegulaFalsiRootFinderCore : public RootFinderCore< DataType >
+{
+public:
+
+    //! Useful type definition for the function pointer (from base class).
+    typedef typename RootFinderCore< DataType >::FunctionPointer FunctionPointer;
+
+    //! Useful type definition for the termination function (from base class).
+    typedef typename RootFinderCore< DataType >::TerminationFunction TerminationFunction;
+
+    //! Constructor taking a general termination function and the bracket of the solution.
+    /*!
+     * Constructor of the regula falsi root-finder, taking the termination function (function
+     * determining whether to terminate the root-finding process) and the search interval with an
+     * upper and lower bound. It is required that the function values at upper and lower bound have
+     * an opposite sign. The default interval is [-1, 1].
+     *
+     * \param terminationFunction The function specifying the termination conditions of the
+     *          root-finding process. \sa RootFinderCore::terminationFunction
+     * \param lowerBound Lower bound of the interval containing a root. (Default is -1.0).
+     * \param upperBound Upper bound of the interval containing a root. (Default is 1.0).
+     * \param variant Variant of the regula falsi method that is used. (Default is
+     *          Anderson-Bjorck).
+     */
+    RegulaFalsiRootFinderCore( const TerminationFunction terminationFunction,
+                               const DataType lowerBound = -1.0,
+                               const DataType upperBound = 1.0,
+                               const RegulaFalsiVariant variant = andersonBjorckRegulaFalsi )
+        : RootFinderCore< DataType >( terminationFunction ),
+          lowerBound_( lowerBound ),
+          upperBound_( upperBound ),
+          variant_( variant ),
+          numberOfFunctionEvaluations_( 0 )
+    { }
+
+    //! Constructor taking typical convergence criteria and the bracket of the solution.
+    /*!
+     * Constructor of the regula falsi root-finder, taking the maximum number of iterations, the
+     * relative tolerance for the independent variable, and the search interval with upper and
+     * lower bound. It is required that the function values at upper and lower bound have an
+     * opposite sign. The default interval is [-1, 1]. If desired, a custom convergence function
+     * can be provided to the alternative constructor.
+     *
+     * \param relativeXTolerance Relative difference between the root solution of two subsequent
+     *          solutions below which convergence is reached.
+     * \param maxIterations Maximum number of iterations after which the root finder is
+     *          terminated, i.e. convergence is assumed.
+     * \param lowerBound Lower bound of the interval containing a root. (Default is -1.0).
+     * \param upperBound Upper bound of the interval containing a root. (Default is 1.0).
+     * \param variant Variant of the regula falsi method that is used. (Default is
+     *          Anderson-Bjorck).
+     */
+    RegulaFalsiRootFinderCore( const DataType relativeXTolerance,
+                               const unsigned int maxIterations,
+                               const DataType lowerBound = -1.0,
+                               const DataType upperBound = 1.0,
+                               const RegulaFalsiVariant variant = andersonBjorckRegulaFalsi )
+        : RootFinderCore< DataType >(
+              boost::bind(
+                  &termination_conditions::RootRelativeToleranceTerminationCondition< DataType >::
+                  checkTerminationCondition, boost::make_shared<
+                  termination_conditions::RootRelativeToleranceTerminationCondition< DataType > >(
+                      relativeXTolerance, maxIterations ), _1, _2, _3, _4, _5 ) ),
+          lowerBound_( lowerBound ),
+          upperBound_( upperBound ),
+          variant_( variant ),
+          numberOfFunctionEvaluations_( 0 )
+    { }
+
+    //! Default destructor.
+    ~RegulaFalsiRootFinderCore( ) { }
+
+    //! Find a root of the function provided as input.
+    /*!
+     * Find a root of the function provided as input, using the termination function set by the
+     * constructor. (Note that the initial guess is not used, but is a requirement of the
+     * root-finder architecture.)
+     *
+     * \param rootFunction Function to find the root of.
+     * \param initialGuess The initial guess of the root. (Not used, default is 0.0).
+     * \return Root of the rootFunction that is found.
+     *
+     * \throws std::runtime_error If the interval does not bracket the root.
+     */
+    DataType execute( const FunctionPointer rootFunction, const DataType initialGuess = 0.0 )
+    {
+        // The value of the initialGuess is not used.
+        TUDAT_UNUSED_PARAMETER( initialGuess );
+
+        // Set the root function.
+        this->rootFunction = rootFunction;
+
+        // Find root using the template root-finding function, counting the function evaluations.
+        const RootFunctionValueEvaluator< DataType > functionEvaluator( this->rootFunction );
+        const FunctionEvaluationCounter< RootFunctionValueEvaluator< DataType > >
+                countedFunctionEvaluator( functionEvaluator );
+        numberOfFunctionEvaluations_ = 0;
+        const DataType root = findRootWithRegulaFalsi(
+                    countedFunctionEvaluator, static_cast< DataType >( lowerBound_ ),
+                    static_cast< DataType >( upperBound_ ), this->terminationFunction, variant_ );
+        numberOfFunctionEvaluations_ = countedFunctionEvaluator.numberOfFunctionEvaluations;
+
+        return root;
+    }
+
+    //! Reset the bracket of the solution.
+    /*!
+     * Resets the search interval with an upper and lower bound. It is required that the function
+     * values at upper and lower bound have an opposite sign.
+     *
+     * \param lowerBound Lower bound of the interval containing a root.
+     * \param upperBound Upper bound of the interval containing a root.
+     */
+    void resetBoundaries( const DataType lowerBound, const DataType upperBound )
+    {
+        this->lowerBound_ = lowerBound;
+        this->upperBound_ = upperBound;
+    }
+
+    //! Set variant of the regula falsi method.
+    /*!
+     * Sets the variant of the regula falsi method that is used.
+     * \param variant Variant of the regula falsi method.
+     */
+    void setVariant( const RegulaFalsiVariant variant ) { variant_ = variant; }
+
+    //! Get number of function evaluations.
+    /*!
+     * Returns the number of function evaluations during the last successful call to execute().
+     * \return Number of function evaluations.
+     */
+    unsigned int getNumberOfFunctionEvaluations( ) { return numberOfFunctionEvaluations_; }
+
+protected:
+
+private:
+
+    //! Lower bound of the bracket containing the solution.
+    DataType lowerBound_;
+
+    //! Upper bound of the bracket containing the solution.
+    DataType upperBound_;
+
+    //! Variant of the regula falsi method that is used.
+    RegulaFalsiVariant variant_;
+
+    //! Number of function evaluations during last call to execute().
+    unsigned int numberOfFunctionEvaluations_;
+
+};
+
+// Some handy typedefs.
+typedef RegulaFalsiRootFinderCore< double > RegulaFalsiRootFinder;
+typedef boost::shared_ptr< RegulaFalsiRootFinder > RegulaFalsiRootFinderPointer;
+
+} // namespace root_finders
+} // namespace tudat
+
+#endif // TUDAT_REGULA_FALSI_ROOT_FINDER_H
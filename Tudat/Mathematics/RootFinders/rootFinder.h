@@ -44,6 +44,8 @@
  *      120402    T. Secretin       Code-check.
  *      120726    S. Billemont      Restructuring. Implemented new termination conditions.
  *      120810    P. Musegaas       Code-check, various edits.
+ *      261018                      Added function object adapters for template root-finding
+ *                                  functions.
  *
  *    References
  *
@@ -67,6 +69,96 @@ namespace tudat
 namespace root_finders
 {
 
+//! Function object evaluating the value of a root function.
+/*!
+ * Function object evaluating the value of a basic_mathematics::Function, used to pass it to the
+ * template root-finding functions in rootFindingAlgorithms.h.
+ * \tparam DataType Data type used to represent floating-point values.
+ */
+template< typename DataType = double >
+struct RootFunctionValueEvaluator
+{
+    //! Constructor.
+    /*!
+     * Constructor.
+     * \param aRootFunction Function to be evaluated.
+     */
+    RootFunctionValueEvaluator(
+            const boost::shared_ptr< basic_mathematics::Function< DataType, DataType > >&
+            aRootFunction )
+        : rootFunction( aRootFunction )
+    { }
+
+    //! Evaluate function value.
+    /*!
+     * Evaluates function value.
+     * \param inputValue Value of independent variable.
+     * \return Function value.
+     */
+    DataType operator( )( const DataType inputValue ) const
+    {
+        return rootFunction->evaluate( inputValue );
+    }
+
+    //! Function to be evaluated.
+    const boost::shared_ptr< basic_mathematics::Function< DataType, DataType > > rootFunction;
+};
+
+//! Function object evaluating the value of a root function and its derivatives.
+/*!
+ * Function object evaluating the value of a basic_mathematics::Function and its first (and,
+ * optionally, second) derivative, used to pass it to the template root-finding functions in
+ * rootFindingAlgorithms.h.
+ * \tparam DataType Data type used to represent floating-point values.
+ */
+template< typename DataType = double >
+struct RootFunctionDerivativeEvaluator
+{
+    //! Constructor.
+    /*!
+     * Constructor.
+     * \param aRootFunction Function to be evaluated.
+     */
+    RootFunctionDerivativeEvaluator(
+            const boost::shared_ptr< basic_mathematics::Function< DataType, DataType > >&
+            aRootFunction )
+        : rootFunction( aRootFunction )
+    { }
+
+    //! Evaluate function value and first derivative.
+    /*!
+     * Evaluates function value and first derivative.
+     * \param inputValue Value of independent variable.
+     * \param functionValue Function value (returned by reference).
+     * \param firstDerivativeValue First derivative of function (returned by reference).
+     */
+    void operator( )( const DataType inputValue, DataType& functionValue,
+                      DataType& firstDerivativeValue ) const
+    {
+        functionValue = rootFunction->evaluate( inputValue );
+        firstDerivativeValue = rootFunction->computeDerivative( 1, inputValue );
+    }
+
+    //! Evaluate function value, and first and second derivative.
+    /*!
+     * Evaluates function value, and first and second derivative.
+     * \param inputValue Value of independent variable.
+     * \param functionValue Function value (returned by reference).
+     * \param firstDerivativeValue First derivative of function (returned by reference).
+     * \param secondDerivativeValue Second derivative of function (returned by reference).
+     */
+    void operator( )( const DataType inputValue, DataType& functionValue,
+                      DataType& firstDerivativeValue, DataType& secondDerivativeValue ) const
+    {
+        functionValue = rootFunction->evaluate( inputValue );
+        firstDerivativeValue = rootFunction->computeDerivative( 1, inputValue );
+        secondDerivativeValue = rootFunction->computeDerivative( 2, inputValue );
+    }
+
+    //! Function to be evaluated.
+    const boost::shared_ptr< basic_mathematics::Function< DataType, DataType > > rootFunction;
+};
+
 //! Root-finder class.
 /*!
  * A description of root-finding algorithms. These algorihms take a Function, and find a root
@@ -0,0 +1,743 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Added Brent and regula falsi (Illinois and Anderson-Bjorck)
+ *                                  methods, and function evaluation counter.
+ *      261018                      Made functions usable with dual numbers.
+ *
+ *    References
+ *      Brent, R.P. Algorithms for Minimization without Derivatives, Prentice-Hall, 1973.
+ *      Press W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing. Cambridge
+ *          University Press, February 2002.
+ *      Dowell, M., Jarratt, P. A modified regula falsi method for computing the root of an
+ *          equation, BIT Numerical Mathematics, 11(2), 168-174, 1971.
+ *      Anderson, N., Bjorck, A. A new high order method of regula falsi type for computing a root
+ *          of an equation, BIT Numerical Mathematics, 13(3), 253-264, 1973.
+ *
+ *    Notes
+ *      The functions in this file are the algorithmic core of the root-finder classes
+ *      (NewtonRaphsonCore, HalleyRootFinderCore, SecantRootFinderCore and BisectionCore), which are
+ *      thin adapters over them. The root function and termination condition are template
+ *      parameters, so that any function object (including C++11 lambdas) can be passed without
+ *      wrapping it in a heap-allocated basic_mathematics::Function, and the function evaluations
+ *      and termination checks can be fully inlined by the compiler.
+ *
+ *      The termination condition is called with the same five arguments as the
+ *      RootFinderCore::TerminationFunction, i.e., current root value, previous root value, current
+ *      function value, previous function value and number of iterations. Both the root function
+ *      and the termination condition must have a const call operator.
+ *
+ */
+
+#ifndef TUDAT_ROOT_FINDING_ALGORITHMS_H
+#define TUDAT_ROOT_FINDING_ALGORITHMS_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+#include <boost/exception/all.hpp>
+
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+namespace tudat
+{
+namespace root_finders
+{
+
+//! Variants of the regula falsi method.
+enum RegulaFalsiVariant
+{
+    //! Illinois variant, halving the retained function value.
+    illinoisRegulaFalsi,
+
+    //! Anderson-Bjorck variant, scaling the retained function value by the relative change of the
+    //! function value at the most recent iterate.
+    andersonBjorckRegulaFalsi
+};
+
+//! Function object counting the number of evaluations of a root function.
+/*!
+ * Function object wrapping a root function, which counts the number of times it is evaluated
+ * (including evaluations of its derivatives). It can be passed to any of the template
+ * root-finding functions in this file, after which the number of function evaluations can be
+ * retrieved.
+ * \tparam RootFunction Type of wrapped function object.
+ */
+template< typename RootFunction >
+struct FunctionEvaluationCounter
+{
+    //! Constructor.
+    /*!
+     * Constructor.
+     * \param aRootFunction Function object to wrap, which should outlive this object.
+     */
+    FunctionEvaluationCounter( const RootFunction& aRootFunction )
+        : rootFunction( aRootFunction ), numberOfFunctionEvaluations( 0 )
+    { }
+
+    //! Evaluate function value.
+    template< typename DataType >
+    DataType operator( )( const DataType inputValue ) const
+    {
+        numberOfFunctionEvaluations++;
+        return rootFunction( inputValue );
+    }
+
+    //! Evaluate function value and first derivative.
+    template< typename DataType >
+    void operator( )( const DataType inputValue, DataType& functionValue,
+                      DataType& firstDerivativeValue ) const
+    {
+        numberOfFunctionEvaluations++;
+        rootFunction( inputValue, functionValue, firstDerivativeValue );
+    }
+
+    //! Evaluate function value, and first and second derivative.
+    template< typename DataType >
+    void operator( )( const DataType inputValue, DataType& functionValue,
+                      DataType& firstDerivativeValue, DataType& secondDerivativeValue ) const
+    {
+        numberOfFunctionEvaluations++;
+        rootFunction( inputValue, functionValue, firstDerivativeValue, secondDerivativeValue );
+    }
+
+    //! Wrapped function object.
+    const RootFunction& rootFunction;
+
+    //! Number of function evaluations since construction.
+    mutable unsigned int numberOfFunctionEvaluations;
+};
+
+//! Create function object counting the number of evaluations of a root function.
+/*!
+ * Creates function object counting the number of evaluations of a root function.
+ * \param rootFunction Function object to wrap, which should outlive the returned object.
+ * \return Function evaluation counter wrapping rootFunction.
+ */
+template< typename RootFunction >
+inline FunctionEvaluationCounter< RootFunction > countFunctionEvaluations(
+        const RootFunction& rootFunction )
+{
+    return FunctionEvaluationCounter< RootFunction >( rootFunction );
+}
+
+//! Check whether function values at bounds of a bracket have a different sign.
+/*!
+ * Checks whether function values at bounds of a bracket have a different sign, and throws an
+ * exception if this is not the case.
+ * \param lowerBoundFunctionValue Function value at lower bound of bracket.
+ * \param upperBoundFunctionValue Function value at upper bound of bracket.
+ * \param rootFinderName Name of the root-finder, used in the error message.
+ * \throws std::runtime_error If the function values have the same sign.
+ */
+template< typename DataType >
+inline void checkRootBracket( const DataType lowerBoundFunctionValue,
+                              const DataType upperBoundFunctionValue,
+                              const std::string& rootFinderName )
+{
+    if( lowerBoundFunctionValue * upperBoundFunctionValue > 0.0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "The " + rootFinderName + " algorithm requires that the values at "
+                            "the upper and lower bounds have a different sign." ) ) );
+    }
+}
+
+//! Find a root of a function using the Newton-Raphson method.
+/*!
+ * Finds a root of a function using the Newton-Raphson method, starting from a single initial
+ * guess. The iterative scheme is given by:
+ * \f[
+ *  x_{n+1} = x_n - \frac{F\left(x_n\right)}{F'\left(x_n\right)}
+ * \f]
+ * \tparam DataType Data type used to represent floating-point values.
+ * \tparam RootFunction Type of function object, which is called as
+ *          rootFunction( x, functionValue, firstDerivativeValue ), and sets the function value and
+ *          its first derivative at x in the last two (reference) arguments.
+ * \tparam TerminationCondition Type of termination condition, callable with the same arguments
+ *          as RootFinderCore::TerminationFunction.
+ * \param rootFunction Function to find root of.
+ * \param initialGuess The initial guess of the root.
+ * \param terminationCondition Termination condition of the root-finding process.
+ * \return Root of the rootFunction that is found.
+ */
+template< typename DataType, typename RootFunction, typename TerminationCondition >
+inline DataType findRootWithNewtonRaphson( const RootFunction& rootFunction,
+                                           const DataType initialGuess,
+                                           const TerminationCondition& terminationCondition )
+{
+    // Start at initial guess, and compute the function value and its first derivative.
+    DataType currentRootValue = TUDAT_NAN;
+    DataType nextRootValue = initialGuess;
+    DataType currentFunctionValue = TUDAT_NAN;
+    DataType nextFunctionValue = TUDAT_NAN;
+    DataType nextDerivativeValue = TUDAT_NAN;
+    rootFunction( nextRootValue, nextFunctionValue, nextDerivativeValue );
+
+    // Loop counter.
+    unsigned int counter = 1;
+
+    // Loop until we have a solution with sufficient accuracy.
+    do
+    {
+        // Save the old values.
+        currentRootValue = nextRootValue;
+        currentFunctionValue = nextFunctionValue;
+
+        // Compute next value of root, and its function value and first derivative.
+        nextRootValue = currentRootValue - currentFunctionValue / nextDerivativeValue;
+        rootFunction( nextRootValue, nextFunctionValue, nextDerivativeValue );
+
+        // Update the counter.
+        counter++;
+    }
+    while( !terminationCondition( nextRootValue, currentRootValue, nextFunctionValue,
+                                  currentFunctionValue, counter ) );
+
+    return nextRootValue;
+}
+
+//! Find a root of a function using Halley's method.
+/*!
+ * Finds a root of a function using Halley's method, starting from a single initial guess. The
+ * iterative scheme is given by:
+ * \f[
+ *  x_{n+1} = x_n - \frac{2 F\left(x_n\right) F'\left(x_n\right)}
+ *                  {2 F'\left(x_n\right)^2 - F\left(x_n\right) F''\left(x_n\right)}
+ * \f]
+ * \tparam DataType Data type used to represent floating-point values.
+ * \tparam RootFunction Type of function object, which is called as
+ *          rootFunction( x, functionValue, firstDerivativeValue, secondDerivativeValue ), and
+ *          sets the function value and its first and second derivative at x in the last three
+ *          (reference) arguments.
+ * \tparam TerminationCondition Type of termination condition, callable with the same arguments
+ *          as RootFinderCore::TerminationFunction.
+ * \param rootFunction Function to find root of.
+ * \param initialGuess The initial guess of the root.
+ * \param terminationCondition Termination condition of the root-finding process.
+ * \return Root of the rootFunction that is found.
+ */
+template< typename DataType, typename RootFunction, typename TerminationCondition >
+inline DataType findRootWithHalley( const RootFunction& rootFunction,
+                                    const DataType initialGuess,
+                                    const TerminationCondition& terminationCondition )
+{
+    // Start at initial guess, and compute the function value, its first and second derivative.
+    DataType currentRootValue = TUDAT_NAN;
+    DataType nextRootValue = initialGuess;
+    DataType currentFunctionValue = TUDAT_NAN;
+    DataType nextFunctionValue = TUDAT_NAN;
+    DataType nextFirstDerivativeValue = TUDAT_NAN;
+    DataType nextSecondDerivativeValue = TUDAT_NAN;
+    rootFunction( nextRootValue, nextFunctionValue, nextFirstDerivativeValue,
+                  nextSecondDerivativeValue );
+
+    // Loop counter.
+    unsigned int counter = 1;
+
+    // Loop until we have a solution with sufficient accuracy.
+    do
+    {
+        // Save the old values.
+        currentRootValue = nextRootValue;
+        currentFunctionValue = nextFunctionValue;
+
+        // Compute next value of root, and its function value and derivatives.
+        nextRootValue = currentRootValue
+                - ( ( 2.0 * currentFunctionValue * nextFirstDerivativeValue )
+                    / ( 2.0 * nextFirstDerivativeValue * nextFirstDerivativeValue
+                        - currentFunctionValue * nextSecondDerivativeValue ) );
+        rootFunction( nextRootValue, nextFunctionValue, nextFirstDerivativeValue,
+                      nextSecondDerivativeValue );
+
+        // Update the counter.
+        counter++;
+    }
+    while( !terminationCondition( nextRootValue, currentRootValue, nextFunctionValue,
+                                  currentFunctionValue, counter ) );
+
+    return nextRootValue;
+}
+
+//! Find a root of a function using the secant method.
+/*!
+ * Finds a root of a function using the secant method, starting from two initial guesses. The
+ * guess with the smallest absolute function value is used as the most recent iterate. The
+ * iterative scheme is given by:
+ * \f[
+ *  x_{n+1} = x_n - F\left(x_n\right) \frac{x_n - x_{n-1}}{F\left(x_n\right)
+ *            - F\left(x_{n-1}\right)}
+ * \f]
+ * \tparam DataType Data type used to represent floating-point values.
+ * \tparam RootFunction Type of function object, which is called as rootFunction( x ) and returns
+ *          the function value at x.
+ * \tparam TerminationCondition Type of termination condition, callable with the same arguments
+ *          as RootFinderCore::TerminationFunction.
+ * \param rootFunction Function to find root of.
+ * \param firstInitialGuess First initial guess of the root (least accurate guess).
+ * \param secondInitialGuess Second initial guess of the root.
+ * \param terminationCondition Termination condition of the root-finding process.
+ * \return Root of the rootFunction that is found.
+ */
+template< typename DataType, typename RootFunction, typename TerminationCondition >
+inline DataType findRootWithSecant( const RootFunction& rootFunction,
+                                    const DataType firstInitialGuess,
+                                    const DataType secondInitialGuess,
+                                    const TerminationCondition& terminationCondition )
+{
+    using std::fabs;
+
+    // Start at the two initial values that are used in the algorithm, and compute the function
+    // values.
+    DataType lastRootValue = TUDAT_NAN;
+    DataType currentRootValue = firstInitialGuess;
+    DataType nextRootValue = secondInitialGuess;
+    DataType lastFunctionValue = TUDAT_NAN;
+    DataType currentFunctionValue = rootFunction( currentRootValue );
+    DataType nextFunctionValue = rootFunction( nextRootValue );
+
+    // Check if the next root value is the most accurate guess. If not, switch the values.
+    if( fabs( currentFunctionValue ) < fabs( nextFunctionValue ) )
+    {
+        std::swap( currentRootValue, nextRootValue );
+        std::swap( currentFunctionValue, nextFunctionValue );
+    }
+
+    // Loop counter.
+    unsigned int counter = 1;
+
+    // Loop until we have a solution with sufficient accuracy.
+    do
+    {
+        // Save the old values.
+        lastRootValue = currentRootValue;
+        lastFunctionValue = currentFunctionValue;
+        currentRootValue = nextRootValue;
+        currentFunctionValue = nextFunctionValue;
+
+        // Compute next value of root, and its function value.
+        nextRootValue = currentRootValue - currentFunctionValue
+                * ( currentRootValue - lastRootValue )
+                / ( currentFunctionValue - lastFunctionValue );
+        nextFunctionValue = rootFunction( nextRootValue );
+
+        // Update the counter.
+        counter++;
+    }
+    while( !terminationCondition( nextRootValue, currentRootValue, nextFunctionValue,
+                                  currentFunctionValue, counter ) );
+
+    return nextRootValue;
+}
+
+//! Find a root of a function using the bisection method.
+/*!
+ * Finds a root of a function using the bisection method, starting from a bracket of the root.
+ * In each iteration, the bracket is halved, keeping the half in which the function changes sign.
+ * The midpoint of the bracket is used as the current root value.
+ * \tparam DataType Data type used to represent floating-point values.
+ * \tparam RootFunction Type of function object, which is called as rootFunction( x ) and returns
+ *          the function value at x.
+ * \tparam TerminationCondition Type of termination condition, callable with the same arguments
+ *          as RootFinderCore::TerminationFunction.
+ * \param rootFunction Function to find root of.
+ * \param lowerBound Lower bound of the bracket containing the root.
+ * \param upperBound Upper bound of the bracket containing the root.
+ * \param terminationCondition Termination condition of the root-finding process.
+ * \throws std::runtime_error If the function values at the bounds of the bracket have the same
+ *          sign.
+ * \return Root of the rootFunction that is found.
+ */
+template< typename DataType, typename RootFunction, typename TerminationCondition >
+inline DataType findRootWithBisection( const RootFunction& rootFunction,
+                                       const DataType lowerBound,
+                                       const DataType upperBound,
+                                       const TerminationCondition& terminationCondition )
+{
+    // Initialize previous values.
+    DataType previousRootValue = TUDAT_NAN;
+    DataType previousRootFunctionValue = TUDAT_NAN;
+
+    // Duplicate the interval and use this duplicate to shrink the interval.
+    // Compute the midpoint of the interval, and take this as the current root.
+    DataType currentLowerBound = lowerBound;
+    DataType currentUpperBound = upperBound;
+    DataType rootValue = ( currentLowerBound + currentUpperBound ) / 2.0;
+
+    // Find the corresponding function values at the important interval points (lower bound,
+    // upper bound and midpoint).
+    DataType currentLowerBoundFunctionValue = rootFunction( currentLowerBound );
+    DataType currentUpperBoundFunctionValue = rootFunction( currentUpperBound );
+    DataType rootFunctionValue = rootFunction( rootValue );
+
+    // Validate that upperbound and lowerbound function values have different signs
+    // (requirement).
+    if( currentLowerBoundFunctionValue * currentUpperBoundFunctionValue > 0.0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "The Bisection algorithm requires that the values at the upper "
+                            "and lower bounds have a different sign." ) ) );
+    }
+
+    // Loop counter.
+    unsigned int counter = 1;
+
+    // Loop until we have a solution with sufficient accuracy.
+    do
+    {
+        // Save old values.
+        previousRootValue = rootValue;
+        previousRootFunctionValue = rootFunctionValue;
+
+        // Check which subinterval to keep, by maintaining endpoints with opposite function
+        // value signs.
+        if( rootFunctionValue * currentLowerBoundFunctionValue < 0.0 )
+        {
+            // Different sign, hence the upper bound is replaced.
+            currentUpperBound = rootValue;
+            currentUpperBoundFunctionValue = rootFunctionValue;
+        }
+        else
+        {
+            // Same sign, hence the lower bound is replaced.
+            currentLowerBound = rootValue;
+            currentLowerBoundFunctionValue = rootFunctionValue;
+        }
+
+        // Compute the new midpoint of the interval and its function value.
+        rootValue = ( currentLowerBound + currentUpperBound ) / 2.0;
+        rootFunctionValue = rootFunction( rootValue );
+
+        // Sanity check.
+        if( currentLowerBoundFunctionValue * currentUpperBoundFunctionValue > 0.0 )
+        {
+            boost::throw_exception(
+                        boost::enable_error_info(
+                            std::runtime_error(
+                                "The Bisection algorithm requires that the values at the upper "
+                                "and lower bounds have a different sign, error during "
+                                "iteration." ) ) );
+        }
+
+        counter++;
+    }
+    while( !terminationCondition( rootValue, previousRootValue, rootFunctionValue,
+                                  previousRootFunctionValue, counter ) );
+
+    return rootValue;
+}
+
+//! Find a root of a function using Brent's method.
+/*!
+ * Finds a root of a function using Brent's method (Brent, 1973), starting from a bracket of the
+ * root. In each iteration, the root is estimated by inverse quadratic interpolation (or linear
+ * interpolation, if only two distinct points are available), while a bracket of the root is
+ * maintained. If the interpolated point falls outside of the bracket, or the bracket does not
+ * shrink sufficiently fast, a bisection step is taken instead. Therefore, the method is as robust
+ * as bisection, but converges superlinearly for smooth functions. Its implementation follows
+ * Press et al. (2002). Apart from the termination condition, the iteration is stopped if the
+ * function value is exactly zero, or if the bracket can not be reduced further in the precision
+ * of DataType.
+ * \tparam DataType Data type used to represent floating-point values.
+ * \tparam RootFunction Type of function object, which is called as rootFunction( x ) and returns
+ *          the function value at x.
+ * \tparam TerminationCondition Type of termination condition, callable with the same arguments
+ *          as RootFinderCore::TerminationFunction.
+ * \param rootFunction Function to find root of.
+ * \param lowerBound Lower bound of the bracket containing the root.
+ * \param upperBound Upper bound of the bracket containing the root.
+ * \param terminationCondition Termination condition of the root-finding process.
+ * \throws std::runtime_error If the function values at the bounds of the bracket have the same
+ *          sign.
+ * \return Root of the rootFunction that is found.
+ */
+template< typename DataType, typename RootFunction, typename TerminationCondition >
+inline DataType findRootWithBrent( const RootFunction& rootFunction,
+                                   const DataType lowerBound,
+                                   const DataType upperBound,
+                                   const TerminationCondition& terminationCondition )
+{
+    using std::fabs;
+
+    // Current best estimate of root (b), previous estimate (a) and counterpoint (c), such that
+    // the root is bracketed by b and c.
+    DataType previousRootValue = lowerBound;
+    DataType rootValue = upperBound;
+    DataType previousFunctionValue = rootFunction( previousRootValue );
+    DataType rootFunctionValue = rootFunction( rootValue );
+
+    checkRootBracket( previousFunctionValue, rootFunctionValue, std::string( "Brent" ) );
+
+    if( previousFunctionValue == 0.0 )
+    {
+        return previousRootValue;
+    }
+
+    DataType counterpointValue = rootValue;
+    DataType counterpointFunctionValue = rootFunctionValue;
+
+    // Current and previous step size.
+    DataType stepSize = upperBound - lowerBound;
+    DataType previousStepSize = stepSize;
+
+    // Loop counter.
+    unsigned int counter = 1;
+
+    // Loop until we have a solution with sufficient accuracy.
+    do
+    {
+        // Ensure that the root is bracketed by the current estimate and the counterpoint.
+        if( ( rootFunctionValue > 0.0 && counterpointFunctionValue > 0.0 ) ||
+                ( rootFunctionValue < 0.0 && counterpointFunctionValue < 0.0 ) )
+        {
+            counterpointValue = previousRootValue;
+            counterpointFunctionValue = previousFunctionValue;
+            stepSize = rootValue - previousRootValue;
+            previousStepSize = stepSize;
+        }
+
+        // Ensure that the current estimate is the best estimate of the root.
+        if( fabs( counterpointFunctionValue ) < fabs( rootFunctionValue ) )
+        {
+            previousRootValue = rootValue;
+            rootValue = counterpointValue;
+            counterpointValue = previousRootValue;
+            previousFunctionValue = rootFunctionValue;
+            rootFunctionValue = counterpointFunctionValue;
+            counterpointFunctionValue = previousFunctionValue;
+        }
+
+        // Stop if the root is found exactly, or the bracket can not be reduced further.
+        const DataType minimumStepSize = 2.0 * std::numeric_limits< DataType >::epsilon( )
+                * fabs( rootValue ) + std::numeric_limits< DataType >::min( );
+        const DataType halfBracketSize = 0.5 * ( counterpointValue - rootValue );
+        if( rootFunctionValue == 0.0 || fabs( halfBracketSize ) <= minimumStepSize )
+        {
+            break;
+        }
+
+        // Attempt interpolation, if previous step was sufficiently large and function value
+        // decreased.
+        if( fabs( previousStepSize ) >= minimumStepSize &&
+                fabs( previousFunctionValue ) > fabs( rootFunctionValue ) )
+        {
+            const DataType functionValueRatio = rootFunctionValue / previousFunctionValue;
+            DataType numerator, denominator;
+            if( previousRootValue == counterpointValue )
+            {
+                // Linear interpolation (secant step).
+                numerator = 2.0 * halfBracketSize * functionValueRatio;
+                denominator = 1.0 - functionValueRatio;
+            }
+            else
+            {
+                // Inverse quadratic interpolation.
+                const DataType previousToCounterpointRatio
+                        = previousFunctionValue / counterpointFunctionValue;
+                const DataType currentToCounterpointRatio
+                        = rootFunctionValue / counterpointFunctionValue;
+                numerator = functionValueRatio * (
+                            2.0 * halfBracketSize * previousToCounterpointRatio
+                            * ( previousToCounterpointRatio - currentToCounterpointRatio )
+                            - ( rootValue - previousRootValue )
+                            * ( currentToCounterpointRatio - 1.0 ) );
+                denominator = ( previousToCounterpointRatio - 1.0 )
+                        * ( currentToCounterpointRatio - 1.0 ) * ( functionValueRatio - 1.0 );
+            }
+
+            // Ensure that the step is directed into the bracket.
+            if( numerator > 0.0 )
+            {
+                denominator = -denominator;
+            }
+            numerator = fabs( numerator );
+
+            // Accept interpolation if it falls within the bracket and converges sufficiently fast,
+            // otherwise use bisection.
+            if( 2.0 * numerator < std::min(
+                        3.0 * halfBracketSize * denominator
+                        - fabs( minimumStepSize * denominator ),
+                        fabs( previousStepSize * denominator ) ) )
+            {
+                previousStepSize = stepSize;
+                stepSize = numerator / denominator;
+            }
+            else
+            {
+                stepSize = halfBracketSize;
+                previousStepSize = stepSize;
+            }
+        }
+        else
+        {
+            stepSize = halfBracketSize;
+            previousStepSize = stepSize;
+        }
+
+        // Save the old values.
+        previousRootValue = rootValue;
+        previousFunctionValue = rootFunctionValue;
+
+        // Compute next value of root (taking at least the minimum step size), and its function
+        // value.
+        if( fabs( stepSize ) > minimumStepSize )
+        {
+            rootValue += stepSize;
+        }
+        else
+        {
+            rootValue += ( halfBracketSize > 0.0 ) ? minimumStepSize : -minimumStepSize;
+        }
+        rootFunctionValue = rootFunction( rootValue );
+
+        // Update the counter.
+        counter++;
+    }
+    while( !terminationCondition( rootValue, previousRootValue, rootFunctionValue,
+                                  previousFunctionValue, counter ) );
+
+    return rootValue;
+}
+
+//! Find a root of a function using a modified regula falsi method.
+/*!
+ * Finds a root of a function using a modified regula falsi (false position) method, starting
+ * from a bracket of the root. In each iteration, the root is estimated by the secant through the
+ * bounds of the bracket, after which the bound at which the function has the same sign as at
+ * the new estimate is replaced. To prevent one of the bounds from being retained indefinitely
+ * (which reduces the convergence of the classical regula falsi method to linear), the function
+ * value at the retained bound is scaled down, if the same bound is retained twice in a row. In the
+ * Illinois variant (Dowell & Jarratt, 1971), it is halved; in the Anderson-Bjorck variant
+ * (Anderson & Bjorck, 1973), it is scaled by \f$ 1 - F(x_{n+1}) / F(x_n) \f$ (or halved, if
+ * this factor is not positive). Apart from the termination condition, the iteration is stopped if
+ * the function value is exactly zero.
+ * \tparam DataType Data type used to represent floating-point values.
+ * \tparam RootFunction Type of function object, which is called as rootFunction( x ) and returns
+ *          the function value at x.
+ * \tparam TerminationCondition Type of termination condition, callable with the same arguments
+ *          as RootFinderCore::TerminationFunction.
+ * \param rootFunction Function to find root of.
+ * \param lowerBound Lower bound of the bracket containing the root.
+ * \param upperBound Upper bound of the bracket containing the root.
+ * \param terminationCondition Termination condition of the root-finding process.
+ * \param variant Variant of the regula falsi method that is used (default Anderson-Bjorck).
+ * \throws std::runtime_error If the function values at the bounds of the bracket have the same
+ *          sign.
+ * \return Root of the rootFunction that is found.
+ */
+template< typename DataType, typename RootFunction, typename TerminationCondition >
+inline DataType findRootWithRegulaFalsi(
+        const RootFunction& rootFunction,
+        const DataType lowerBound,
+        const DataType upperBound,
+        const TerminationCondition& terminationCondition,
+        const RegulaFalsiVariant variant = andersonBjorckRegulaFalsi )
+{
+    // Retained bound, and most recent estimate of the root.
+    DataType retainedBoundValue = lowerBound;
+    DataType rootValue = upperBound;
+    DataType retainedBoundFunctionValue = rootFunction( retainedBoundValue );
+    DataType rootFunctionValue = rootFunction( rootValue );
+
+    checkRootBracket( retainedBoundFunctionValue, rootFunctionValue,
+                      std::string( "regula falsi" ) );
+
+    if( retainedBoundFunctionValue == 0.0 )
+    {
+        return retainedBoundValue;
+    }
+    else if( rootFunctionValue == 0.0 )
+    {
+        return rootValue;
+    }
+
+    DataType previousRootValue = TUDAT_NAN;
+    DataType previousFunctionValue = TUDAT_NAN;
+
+    // Loop counter.
+    unsigned int counter = 1;
+
+    // Loop until we have a solution with sufficient accuracy.
+    do
+    {
+        // Save the old values.
+        previousRootValue = rootValue;
+        previousFunctionValue = rootFunctionValue;
+
+        // Compute next value of root from secant through bounds, and its function value.
+        rootValue = previousRootValue - previousFunctionValue
+                * ( previousRootValue - retainedBoundValue )
+                / ( previousFunctionValue - retainedBoundFunctionValue );
+        rootFunctionValue = rootFunction( rootValue );
+
+        // Update the counter.
+        counter++;
+
+        if( rootFunctionValue == 0.0 )
+        {
+            break;
+        }
+
+        // Update the bracket.
+        if( rootFunctionValue * previousFunctionValue < 0.0 )
+        {
+            // Sign change between previous and current estimate, previous estimate is retained.
+            retainedBoundValue = previousRootValue;
+            retainedBoundFunctionValue = previousFunctionValue;
+        }
+        else
+        {
+            // Retained bound is kept, scale its function value.
+            DataType scalingFactor = 0.5;
+            if( variant == andersonBjorckRegulaFalsi )
+            {
+                scalingFactor = 1.0 - rootFunctionValue / previousFunctionValue;
+                if( scalingFactor <= 0.0 )
+                {
+                    scalingFactor = 0.5;
+                }
+            }
+            retainedBoundFunctionValue *= scalingFactor;
+        }
+    }
+    while( !terminationCondition( rootValue, previousRootValue, rootFunctionValue,
+                                  previousFunctionValue, counter ) );
+
+    return rootValue;
+}
+
+} // namespace root_finders
+} // namespace tudat
+
+#endif // TUDAT_ROOT_FINDING_ALGORITHMS_H
@@ -27,6 +27,7 @@
  *      120208    S. Billemont      Creation of code.
  *      140219    E. Brandon        Adapted to current Tudat root-finder structure.
  *      150417    D. Dirkx          Made modifications for templated root finding.
+ *      261018                      Made adapter of template root-finding function.
  *
  *    References
  *      Press W.H., et al. Numerical Recipes in C++: The Art of Scientific Computing. Cambridge
@@ -50,6 +51,7 @@
 #include <boost/shared_ptr.hpp>
 
 #include "Tudat/Mathematics/RootFinders/rootFinder.h"
+#include "Tudat/Mathematics/RootFinders/rootFindingAlgorithms.h"
 #include "Tudat/Mathematics/RootFinders/terminationConditions.h"
 
 namespace tudat
@@ -157,55 +159,11 @@ public:
         // Set the root function.
         this->rootFunction = rootFunction;
 
-        // Start at the two initial values that are used in the algorithm, and compute the function
-        // values.
-        DataType lastRootValue          = TUDAT_NAN;
-        DataType currentRootValue       = initialGuessOfRootOne_;
-        DataType nextRootValue          = initialGuess;
-        DataType lastFunctionValue      = TUDAT_NAN;
-        DataType currentFunctionValue   = this->rootFunction->evaluate( currentRootValue );
-        DataType nextFunctionValue      = this->rootFunction->evaluate( nextRootValue );
-
-        // Check if the next root value is the most accurate guess. If not, switch the values.
-        if( std::fabs( currentFunctionValue ) < std::fabs( nextFunctionValue ) )
-        {
-            // Switch the root value.
-            DataType temporaryRoot  = currentRootValue;
-            currentRootValue        = nextRootValue;
-            nextRootValue           = temporaryRoot;
-
-            // Switch the function value
-            DataType temporaryValue = currentFunctionValue;
-            currentFunctionValue    = nextFunctionValue;
-            nextFunctionValue       = temporaryValue;
-        }
-
-        // Loop counter.
-        unsigned int counter = 1;
-
-        // Loop until we have a solution with sufficient accuracy.
-        do
-        {
-            // Save the old values.
-            lastRootValue           = currentRootValue;
-            lastFunctionValue       = currentFunctionValue;
-            currentRootValue        = nextRootValue;
-            currentFunctionValue    = nextFunctionValue;
-
-            // Compute next value of root using the following algorithm (see class documentation):
-            nextRootValue           = currentRootValue - currentFunctionValue
-                    * ( currentRootValue - lastRootValue )
-                    / ( currentFunctionValue - lastFunctionValue );
-            nextFunctionValue       = this->rootFunction->evaluate( nextRootValue );
-
-            // Update the counter.
-            counter++;
-        }
-        while( !this->terminationFunction( nextRootValue, currentRootValue, nextFunctionValue,
-                                           currentFunctionValue, counter ) );
-
-        return nextRootValue;
-
+        // Find root using the template root-finding function.
+        return findRootWithSecant(
+                    RootFunctionValueEvaluator< DataType >( this->rootFunction ),
+                    static_cast< DataType >( initialGuessOfRootOne_ ), initialGuess,
+                    this->terminationFunction );
     }
 
     //! Set a new value for the first point used in the Secant algorithm.
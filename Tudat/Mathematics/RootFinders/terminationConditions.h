@@ -29,6 +29,8 @@
  *      120923    K. Kumar          Implemented simplified termination conditions instead of
  *                                  Boost::Phoenix solution as short-term solution.
  *      130121    K. Kumar          Added shared-ptr typedefs.
+ *      261018                      Added RootToleranceTerminationFunctor.
+ *      261018                      Made root tolerance checks usable with dual numbers.
  *
  *    References
  *
@@ -100,7 +102,9 @@ inline bool checkRootAbsoluteTolerance( const ScalarType currentRootGuess,
                                         const ScalarType previousRootGuess,
                                         const ScalarType absoluteTolerance )
 {
-    return std::fabs( currentRootGuess - previousRootGuess ) < absoluteTolerance;
+    using std::fabs;
+
+    return fabs( currentRootGuess - previousRootGuess ) < absoluteTolerance;
 }
 
 //! Check if relative tolerance for root value has been achieved.
@@ -117,8 +121,10 @@ inline bool checkRootRelativeTolerance( const ScalarType currentRootGuess,
                                         const ScalarType previousRootGuess,
                                         const ScalarType relativeTolerance )
 {
-    return std::fabs( ( currentRootGuess - previousRootGuess )
-                      / currentRootGuess ) < relativeTolerance;
+    using std::fabs;
+
+    return fabs( ( currentRootGuess - previousRootGuess )
+                 / currentRootGuess ) < relativeTolerance;
 }
 
 //! Termination condition base class.
@@ -421,6 +427,77 @@ private:
     const bool throwRunTimeException;
 };
 
+//! Inline root tolerance termination functor.
+/*!
+ * Lightweight, non-virtual termination condition for use with the template root-finding
+ * functions in rootFindingAlgorithms.h. The termination condition is reached if the absolute or
+ * relative tolerance for the root value is achieved, or if the maximum number of iterations has
+ * been exceeded. Since the check is performed by a const call operator, it can be passed by value
+ * or as a temporary, and is fully inlined by the root-finder.
+ */
+template< typename ScalarType = double >
+struct RootToleranceTerminationFunctor
+{
+    //! Default constructor, taking root relative and absolute tolerances, maximum number of
+    //! iterations and run-time exception flag.
+    /*!
+     * Default constructor, taking a root relative tolerance (default=1.0e-12), root absolute
+     * tolerance (default=0.0, i.e. no absolute tolerance check), a specified maximum number of
+     * iterations (default=1000) and a flag indicating if a run-time exception should be thrown if
+     * this number is exceeded (default=true).
+     * \param aRelativeTolerance A relative tolerance (default=1.0e-12).
+     * \param anAbsoluteTolerance A absolute tolerance (default=0.0).
+     * \param aMaximumNumberOfIterations Maximum number of iterations (default=1000).
+     * \param aThrowRunTimeExceptionFlag Flag that indicates if run-time error should be triggered
+     *        if maximum number of iterations is exceeded (default=true).
+     */
+    RootToleranceTerminationFunctor( const ScalarType aRelativeTolerance = 1.0e-12,
+                                     const ScalarType anAbsoluteTolerance = 0.0,
+                                     const unsigned int aMaximumNumberOfIterations = 1000,
+                                     const bool aThrowRunTimeExceptionFlag = true )
+        : relativeTolerance( aRelativeTolerance ),
+          absoluteTolerance( anAbsoluteTolerance ),
+          maximumNumberOfIterations( aMaximumNumberOfIterations ),
+          throwRunTimeException( aThrowRunTimeExceptionFlag )
+    { }
+
+    //! Check termination condition.
+    /*!
+     * Check termination condition (combined absolute and relative tolerance and maximum number
+     * of iterations).
+     * \param currentRootGuess Current root value.
+     * \param previousRootGuess Previous root value.
+     * \param currentRootFunctionValue Current root function value (not used).
+     * \param previousRootFunctionValue Previous root function value (not used).
+     * \param numberOfIterations Number of iterations that have been completed.
+     * \return Flag indicating if termination condition has been reached.
+     */
+    bool operator( )( const ScalarType currentRootGuess,
+                      const ScalarType previousRootGuess,
+                      const ScalarType currentRootFunctionValue,
+                      const ScalarType previousRootFunctionValue,
+                      const unsigned int numberOfIterations ) const
+    {
+        return checkRootAbsoluteTolerance( currentRootGuess, previousRootGuess, absoluteTolerance )
+                || checkRootRelativeTolerance( currentRootGuess, previousRootGuess,
+                                               relativeTolerance )
+                || checkMaximumIterationsExceeded(
+                    numberOfIterations, maximumNumberOfIterations, throwRunTimeException );
+    }
+
+    //! Relative tolerance.
+    ScalarType relativeTolerance;
+
+    //! Absolute tolerance.
+    ScalarType absoluteTolerance;
+
+    //! Maximum number of iterations.
+    unsigned int maximumNumberOfIterations;
+
+    //! Flag indicating if run-time exception should be thrown.
+    bool throwRunTimeException;
+};
+
 //! Typedef for shared-pointer to MaximumIterationsTerminationCondition object.
 typedef boost::shared_ptr< MaximumIterationsTerminationCondition >
 MaximumIterationsTerminationConditionPointer;
@@ -0,0 +1,324 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      Unit test created.
+ *      261018                      Added tests of uniform number bits and singular covariance.
+ *
+ *    References
+ *      Salmon, J.K., et al. Random123 known-answer test vectors (kat_vectors), version 1.09.
+ *      Joe, S., Kuo, F.Y. Sobol sequence generator, http://web.maths.unsw.edu.au/~fkuo/sobol/,
+ *          last accessed: 18 October, 2026.
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Basics/testMacros.h"
+
+#include "Tudat/Mathematics/Statistics/monteCarloSampling.h"
+#include "Tudat/Mathematics/Statistics/randomNumberStreams.h"
+#include "Tudat/Mathematics/Statistics/statisticsAccumulators.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+BOOST_AUTO_TEST_SUITE( test_monte_carlo_sampling )
+
+//! Test Philox generator against known-answer test vectors.
+BOOST_AUTO_TEST_CASE( testPhiloxKnownAnswers )
+{
+    using namespace statistics;
+
+    const boost::uint32_t counters[ 3 ][ 4 ] =
+    {
+        { 0x00000000, 0x00000000, 0x00000000, 0x00000000 },
+        { 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF, 0xFFFFFFFF },
+        { 0x243F6A88, 0x85A308D3, 0x13198A2E, 0x03707344 }
+    };
+    const boost::uint32_t keys[ 3 ][ 2 ] =
+    {
+        { 0x00000000, 0x00000000 },
+        { 0xFFFFFFFF, 0xFFFFFFFF },
+        { 0xA4093822, 0x299F31D0 }
+    };
+    const boost::uint32_t expectedBlocks[ 3 ][ 4 ] =
+    {
+        { 0x6627E8D5, 0xE169C58D, 0xBC57AC4C, 0x9B00DBD8 },
+        { 0x408F276D, 0x41C83B0E, 0xA20BC7C6, 0x6D5451FD },
+        { 0xD16CFE09, 0x94FDCCEB, 0x5001E420, 0x24126EA1 }
+    };
+
+    for ( int i = 0; i < 3; i++ )
+    {
+        PhiloxCounter counter;
+        PhiloxKey key;
+        std::copy( counters[ i ], counters[ i ] + 4, counter.begin( ) );
+        std::copy( keys[ i ], keys[ i ] + 2, key.begin( ) );
+
+        const PhiloxCounter block = computePhilox4x32Block( counter, key );
+        for ( int j = 0; j < 4; j++ )
+        {
+            BOOST_CHECK_EQUAL( block[ j ], expectedBlocks[ i ][ j ] );
+        }
+    }
+}
+
+//! Test properties of random number streams.
+BOOST_AUTO_TEST_CASE( testRandomNumberStreams )
+{
+    using namespace statistics;
+
+    // Check that streams are reproducible, and differ for different seeds and stream indices.
+    RandomNumberStream firstStream( 42, 7 );
+    RandomNumberStream secondStream( 42, 7 );
+    RandomNumberStream otherIndexStream( 42, 8 );
+    RandomNumberStream otherSeedStream( 43, 7 );
+    int numberOfEqualNumbers = 0;
+    for ( int i = 0; i < 1000; i++ )
+    {
+        const boost::uint32_t randomInteger = firstStream( );
+        BOOST_CHECK_EQUAL( randomInteger, secondStream( ) );
+        numberOfEqualNumbers += ( randomInteger == otherIndexStream( ) );
+        numberOfEqualNumbers += ( randomInteger == otherSeedStream( ) );
+    }
+    BOOST_CHECK_EQUAL( numberOfEqualNumbers, 0 );
+
+    // Check that uniform random numbers are formed from upper 52 bits of two random integers.
+    RandomNumberStream randomNumberStream( 1234, 0 );
+    RandomNumberStream randomIntegerStream( 1234, 0 );
+    for ( int i = 0; i < 16; i++ )
+    {
+        const boost::uint64_t upperBits = randomIntegerStream( );
+        const boost::uint64_t randomBits = ( upperBits << 32 ) | randomIntegerStream( );
+        BOOST_CHECK_EQUAL( randomNumberStream.generateUniform( ),
+                           ( static_cast< double >( randomBits >> 12 ) + 0.5 )
+                           / 4503599627370496.0 );
+    }
+
+    // Check moments of uniform and standard normal random numbers.
+    const int numberOfSamples = 1000000;
+    ScalarStatisticsAccumulator uniformStatistics;
+    ScalarStatisticsAccumulator normalStatistics;
+    for ( int i = 0; i < numberOfSamples; i++ )
+    {
+        const double uniformNumber = randomNumberStream.generateUniform( );
+        BOOST_CHECK( uniformNumber > 0.0 && uniformNumber < 1.0 );
+        uniformStatistics.addSample( uniformNumber );
+        normalStatistics.addSample( randomNumberStream.generateStandardNormal( ) );
+    }
+
+    // Tolerances are five times the standard errors.
+    BOOST_CHECK_SMALL( uniformStatistics.getSampleMean( ) - 0.5, 5.0 * 0.29 / 1000.0 );
+    BOOST_CHECK_SMALL( uniformStatistics.getSampleVariance( ) - 1.0 / 12.0, 5.0 * 0.075 / 1000.0 );
+    BOOST_CHECK_SMALL( normalStatistics.getSampleMean( ), 5.0 / 1000.0 );
+    BOOST_CHECK_SMALL( normalStatistics.getSampleVariance( ) - 1.0, 5.0 * 1.42 / 1000.0 );
+    BOOST_CHECK_SMALL( normalStatistics.getSkewness( ), 5.0 * 2.45 / 1000.0 );
+
+    // Check that stream can be used with Boost distributions.
+    RandomNumberStream boostStream( 1234, 1 );
+    boost::variate_generator< RandomNumberStream&, boost::normal_distribution< > >
+            normalGenerator( boostStream, boost::normal_distribution< >( 3.0, 2.0 ) );
+    ScalarStatisticsAccumulator boostNormalStatistics;
+    for ( int i = 0; i < 10000; i++ )
+    {
+        boostNormalStatistics.addSample( normalGenerator( ) );
+    }
+    BOOST_CHECK_SMALL( boostNormalStatistics.getSampleMean( ) - 3.0, 5.0 * 2.0 / 100.0 );
+}
+
+//! Test multivariate normal sampling, including independence of number of threads.
+BOOST_AUTO_TEST_CASE( testMultivariateNormalSampling )
+{
+    using namespace statistics;
+
+    Eigen::Vector3d mean( 1.0, -2.0, 1.0E3 );
+    Eigen::Matrix3d covarianceMatrix;
+    covarianceMatrix << 4.0, 1.2, -0.5,
+            1.2, 1.0, 0.1,
+            -0.5, 0.1, 9.0;
+    const MultivariateNormalSampler sampler( mean, covarianceMatrix );
+
+    // Check that samples are bit-identical, regardless of the number of threads.
+    const int numberOfSamples = 200000;
+    const Eigen::MatrixXd samples = sampler.generateSamples( 2026, 0, numberOfSamples, 1 );
+    for ( int numberOfThreads = 2; numberOfThreads <= 7; numberOfThreads += 5 )
+    {
+        const Eigen::MatrixXd parallelSamples = sampler.generateSamples(
+                    2026, 0, numberOfSamples, numberOfThreads );
+        BOOST_CHECK( parallelSamples == samples );
+    }
+
+    // Check that a sub-range, and individual samples, are identical to the full set.
+    const Eigen::MatrixXd subRangeSamples = sampler.generateSamples( 2026, 1000, 10, 3 );
+    BOOST_CHECK( subRangeSamples == samples.block( 0, 1000, 3, 10 ) );
+    BOOST_CHECK( sampler.generateSample( 2026, 12345 ) == samples.col( 12345 ) );
+
+    // Check sample mean and covariance.
+    VectorStatisticsAccumulator sampleStatistics( 3 );
+    for ( int i = 0; i < numberOfSamples; i++ )
+    {
+        sampleStatistics.addSample( samples.col( i ) );
+    }
+    const Eigen::Vector3d sampleMean = sampleStatistics.getSampleMean( );
+    const Eigen::Matrix3d sampleCovarianceMatrix = sampleStatistics.getSampleCovarianceMatrix( );
+    TUDAT_CHECK_MATRIX_BASE( sampleCovarianceMatrix, covarianceMatrix )
+            BOOST_CHECK_SMALL( sampleCovarianceMatrix( row, col ) - covarianceMatrix( row, col ),
+                               5.0 * std::sqrt( 2.0 * covarianceMatrix( row, row )
+                                                * covarianceMatrix( col, col )
+                                                / numberOfSamples ) );
+    for ( int i = 0; i < 3; i++ )
+    {
+        BOOST_CHECK_SMALL( sampleMean( i ) - mean( i ),
+                           5.0 * std::sqrt( covarianceMatrix( i, i ) / numberOfSamples ) );
+    }
+
+    // Check transformation of standard normal samples.
+    const Eigen::Matrix3d identityMatrix = Eigen::Matrix3d::Identity( );
+    const Eigen::MatrixXd transformedSamples
+            = sampler.transformStandardNormalSamples( identityMatrix );
+    const Eigen::MatrixXd expectedTransformedSamples
+            = sampler.getCovarianceFactor( ).colwise( ) + mean;
+    BOOST_CHECK( transformedSamples.isApprox( expectedTransformedSamples, 1.0E-15 ) );
+
+    // Check that singular (positive semi-definite) covariance matrix is accepted, for which the
+    // first and third variables are fully correlated.
+    Eigen::Matrix3d singularCovarianceMatrix;
+    singularCovarianceMatrix << 4.0, 1.2, -6.0,
+            1.2, 1.0, -1.8,
+            -6.0, -1.8, 9.0;
+    const MultivariateNormalSampler singularSampler( mean, singularCovarianceMatrix );
+    const Eigen::MatrixXd covarianceFactor = singularSampler.getCovarianceFactor( );
+    BOOST_CHECK( ( covarianceFactor * covarianceFactor.transpose( ) ).isApprox(
+                     singularCovarianceMatrix, 1.0E-14 ) );
+    const Eigen::MatrixXd singularSamples = singularSampler.generateSamples( 2026, 0, 100, 1 );
+    for ( int i = 0; i < singularSamples.cols( ); i++ )
+    {
+        BOOST_CHECK_SMALL( 1.5 * ( singularSamples( 0, i ) - mean( 0 ) )
+                           + ( singularSamples( 2, i ) - mean( 2 ) ), 1.0E-12 );
+    }
+
+    // Check that invalid covariance matrices are rejected.
+    Eigen::Matrix3d indefiniteCovarianceMatrix = covarianceMatrix;
+    indefiniteCovarianceMatrix( 1, 1 ) = -1.0;
+    BOOST_CHECK_THROW( MultivariateNormalSampler( mean, indefiniteCovarianceMatrix ),
+                       std::runtime_error );
+    BOOST_CHECK_THROW( MultivariateNormalSampler( mean, Eigen::Matrix2d::Identity( ) ),
+                       std::runtime_error );
+}
+
+//! Test Latin hypercube sampling.
+BOOST_AUTO_TEST_CASE( testLatinHypercubeSampling )
+{
+    using namespace statistics;
+
+    const int numberOfSamples = 100;
+    const int numberOfDimensions = 4;
+    const Eigen::MatrixXd samples
+            = generateLatinHypercubeSamples( numberOfSamples, numberOfDimensions, 99 );
+    BOOST_CHECK( samples == generateLatinHypercubeSamples( numberOfSamples,
+                                                           numberOfDimensions, 99 ) );
+    BOOST_CHECK( samples != generateLatinHypercubeSamples( numberOfSamples,
+                                                           numberOfDimensions, 100 ) );
+
+    // Check that each stratum of each dimension contains exactly one sample.
+    for ( int dimension = 0; dimension < numberOfDimensions; dimension++ )
+    {
+        std::vector< int > samplesPerStratum( numberOfSamples, 0 );
+        for ( int i = 0; i < numberOfSamples; i++ )
+        {
+            BOOST_CHECK( samples( dimension, i ) > 0.0 && samples( dimension, i ) < 1.0 );
+            samplesPerStratum[ static_cast< int >( samples( dimension, i )
+                                                   * numberOfSamples ) ]++;
+        }
+        BOOST_CHECK( samplesPerStratum == std::vector< int >( numberOfSamples, 1 ) );
+    }
+
+    // Check conversion to standard normal samples.
+    const Eigen::MatrixXd normalSamples = convertUniformToStandardNormalSamples( samples );
+    BOOST_CHECK_SMALL( normalSamples.row( 0 ).mean( ), 1.0E-2 );
+    Eigen::MatrixXd invalidSamples = samples;
+    invalidSamples( 2, 3 ) = 0.0;
+    BOOST_CHECK_THROW( convertUniformToStandardNormalSamples( invalidSamples ),
+                       std::runtime_error );
+
+    BOOST_CHECK_THROW( generateLatinHypercubeSamples( 0, 2, 1 ), std::runtime_error );
+}
+
+//! Test Sobol sequence.
+BOOST_AUTO_TEST_CASE( testSobolSequence )
+{
+    using namespace statistics;
+
+    // Check first points against output of sobol.cc of Joe & Kuo.
+    const SobolSequenceGenerator threeDimensionalGenerator( 3 );
+    Eigen::MatrixXd expectedPoints( 3, 8 );
+    expectedPoints << 0.0, 0.5, 0.75, 0.25, 0.375, 0.875, 0.625, 0.125,
+            0.0, 0.5, 0.25, 0.75, 0.375, 0.875, 0.125, 0.625,
+            0.0, 0.5, 0.25, 0.75, 0.625, 0.125, 0.875, 0.375;
+    const Eigen::MatrixXd computedPoints = threeDimensionalGenerator.getPoints( 0, 8 );
+    BOOST_CHECK( computedPoints == expectedPoints );
+
+    // Check that each one-dimensional projection of the first 2^k points is stratified, and that
+    // the points are unique in each two-dimensional projection.
+    const int numberOfPoints = 1024;
+    const SobolSequenceGenerator generator( SobolSequenceGenerator::maximumNumberOfDimensions );
+    const Eigen::MatrixXd points = generator.getPoints( 0, numberOfPoints );
+    for ( int dimension = 0; dimension < generator.getNumberOfDimensions( ); dimension++ )
+    {
+        std::vector< int > pointsPerStratum( numberOfPoints, 0 );
+        for ( int i = 0; i < numberOfPoints; i++ )
+        {
+            pointsPerStratum[ static_cast< int >( points( dimension, i ) * numberOfPoints ) ]++;
+        }
+        BOOST_CHECK( pointsPerStratum == std::vector< int >( numberOfPoints, 1 ) );
+    }
+
+    // Check that range of points is independent of first index.
+    BOOST_CHECK( generator.getPoints( 100, 50 ) == points.block( 0, 100, 16, 50 ) );
+    BOOST_CHECK( generator.getPoint( 777 ) == points.col( 777 ) );
+
+    BOOST_CHECK_THROW( SobolSequenceGenerator( 17 ), std::runtime_error );
+    BOOST_CHECK_THROW( SobolSequenceGenerator( 0 ), std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,279 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      Unit test created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/uniform_real_distribution.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "Tudat/Mathematics/Statistics/histogram.h"
+#include "Tudat/Mathematics/Statistics/tDigest.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Generate normally distributed test samples.
+std::vector< double > generateNormalTestSamples( const int numberOfSamples )
+{
+    boost::mt19937 randomNumberGenerator( 42 );
+    boost::variate_generator< boost::mt19937&, boost::normal_distribution< double > >
+            normalGenerator( randomNumberGenerator, boost::normal_distribution< double >( ) );
+
+    std::vector< double > samples( numberOfSamples );
+    for ( int i = 0; i < numberOfSamples; i++ )
+    {
+        samples[ i ] = normalGenerator( );
+    }
+    return samples;
+}
+
+//! Compute exact quantile of sorted samples.
+double computeExactQuantile( const std::vector< double >& sortedSamples, const double quantile )
+{
+    return sortedSamples[ static_cast< int >(
+                quantile * static_cast< double >( sortedSamples.size( ) - 1 ) + 0.5 ) ];
+}
+
+BOOST_AUTO_TEST_SUITE( test_quantile_sketches )
+
+//! Test quantiles of t-digest against exact quantiles.
+BOOST_AUTO_TEST_CASE( testTDigestQuantiles )
+{
+    using statistics::TDigest;
+
+    const int numberOfSamples = 1000000;
+    std::vector< double > samples = generateNormalTestSamples( numberOfSamples );
+
+    TDigest digest;
+    for ( int i = 0; i < numberOfSamples; i++ )
+    {
+        digest.addSample( samples[ i ] );
+    }
+
+    // Check that memory is bounded by compression parameter.
+    BOOST_CHECK_LE( digest.getNumberOfCentroids( ), digest.getCompression( ) );
+    BOOST_CHECK_EQUAL( digest.getTotalWeight( ), static_cast< double >( numberOfSamples ) );
+
+    std::sort( samples.begin( ), samples.end( ) );
+    BOOST_CHECK_EQUAL( digest.getQuantile( 0.0 ), samples.front( ) );
+    BOOST_CHECK_EQUAL( digest.getQuantile( 1.0 ), samples.back( ) );
+
+    // Check quantiles, in terms of error in rank, which should be small in the tails.
+    const double quantiles[ ] = { 0.001, 0.01, 0.1, 0.5, 0.9, 0.99, 0.997, 0.999 };
+    for ( unsigned int i = 0; i < sizeof( quantiles ) / sizeof( quantiles[ 0 ] ); i++ )
+    {
+        const double estimatedQuantile = digest.getQuantile( quantiles[ i ] );
+        const double rank = static_cast< double >(
+                    std::lower_bound( samples.begin( ), samples.end( ), estimatedQuantile )
+                    - samples.begin( ) ) / static_cast< double >( numberOfSamples );
+
+        BOOST_CHECK_SMALL( rank - quantiles[ i ],
+                           5.0E-3 * std::sqrt( quantiles[ i ] * ( 1.0 - quantiles[ i ] ) ) );
+        BOOST_CHECK_SMALL( estimatedQuantile - computeExactQuantile( samples, quantiles[ i ] ),
+                           5.0E-2 );
+
+        BOOST_CHECK_SMALL( digest.getCumulativeDistributionValue( estimatedQuantile )
+                           - quantiles[ i ], 1.0E-6 );
+    }
+}
+
+//! Test merging and serialization of t-digests.
+BOOST_AUTO_TEST_CASE( testTDigestMergeAndSerialization )
+{
+    using statistics::TDigest;
+
+    const int numberOfSamples = 200000;
+    const int numberOfChunks = 8;
+    const std::vector< double > samples = generateNormalTestSamples( numberOfSamples );
+
+    // Fill one digest per chunk, as would be done by separate threads, and merge them.
+    std::vector< TDigest > chunkDigests( numberOfChunks );
+    for ( int i = 0; i < numberOfSamples; i++ )
+    {
+        chunkDigests[ i % numberOfChunks ].addSample( samples[ i ] );
+    }
+    TDigest mergedDigest;
+    for ( int i = 0; i < numberOfChunks; i++ )
+    {
+        mergedDigest.merge( chunkDigests[ i ] );
+    }
+
+    TDigest directDigest;
+    for ( int i = 0; i < numberOfSamples; i++ )
+    {
+        directDigest.addSample( samples[ i ] );
+    }
+
+    BOOST_CHECK_EQUAL( mergedDigest.getTotalWeight( ), directDigest.getTotalWeight( ) );
+    BOOST_CHECK_EQUAL( mergedDigest.getMinimum( ), directDigest.getMinimum( ) );
+    BOOST_CHECK_EQUAL( mergedDigest.getMaximum( ), directDigest.getMaximum( ) );
+    for ( double quantile = 0.005; quantile < 1.0; quantile += 0.01 )
+    {
+        BOOST_CHECK_SMALL( mergedDigest.getQuantile( quantile )
+                           - directDigest.getQuantile( quantile ), 2.0E-2 );
+    }
+
+    // Write merged digest to binary stream, and read it back.
+    std::stringstream stream( std::ios::in | std::ios::out | std::ios::binary );
+    mergedDigest.writeToBinaryStream( stream );
+    TDigest readDigest( stream );
+
+    BOOST_CHECK_EQUAL( readDigest.getCompression( ), mergedDigest.getCompression( ) );
+    BOOST_CHECK_EQUAL( readDigest.getTotalWeight( ), mergedDigest.getTotalWeight( ) );
+    BOOST_CHECK_EQUAL( readDigest.getNumberOfCentroids( ), mergedDigest.getNumberOfCentroids( ) );
+    for ( double quantile = 0.0; quantile <= 1.0; quantile += 0.05 )
+    {
+        BOOST_CHECK_EQUAL( readDigest.getQuantile( quantile ),
+                           mergedDigest.getQuantile( quantile ) );
+    }
+
+    // Check that truncated stream is rejected.
+    std::stringstream truncatedStream( stream.str( ).substr( 0, 20 ),
+                                       std::ios::in | std::ios::binary );
+    BOOST_CHECK_THROW( TDigest truncatedDigest( truncatedStream ), std::runtime_error );
+}
+
+//! Test error handling of t-digest.
+BOOST_AUTO_TEST_CASE( testTDigestErrorHandling )
+{
+    using statistics::TDigest;
+
+    BOOST_CHECK_THROW( TDigest( 1.0 ), std::runtime_error );
+
+    TDigest digest;
+    BOOST_CHECK_THROW( digest.getQuantile( 0.5 ), std::runtime_error );
+    BOOST_CHECK_THROW( digest.addSample( 1.0, 0.0 ), std::runtime_error );
+
+    // Check that not-a-number samples are ignored.
+    digest.addSample( std::numeric_limits< double >::quiet_NaN( ) );
+    digest.addSample( 3.0 );
+    BOOST_CHECK_EQUAL( digest.getTotalWeight( ), 1.0 );
+    BOOST_CHECK_EQUAL( digest.getQuantile( 0.5 ), 3.0 );
+    BOOST_CHECK_THROW( digest.getQuantile( 1.5 ), std::runtime_error );
+}
+
+//! Test histogram with linear bins.
+BOOST_AUTO_TEST_CASE( testLinearHistogram )
+{
+    using statistics::Histogram;
+
+    Histogram histogram( 0.0, 10.0, 10 );
+    const double samples[ ] = { -1.0, 0.0, 0.5, 2.5, 2.7, 9.999, 10.0, 12.0,
+                                std::numeric_limits< double >::quiet_NaN( ) };
+    for ( unsigned int i = 0; i < sizeof( samples ) / sizeof( samples[ 0 ] ); i++ )
+    {
+        histogram.addSample( samples[ i ] );
+    }
+
+    BOOST_CHECK_EQUAL( histogram.getUnderflowCount( ), 1u );
+    BOOST_CHECK_EQUAL( histogram.getOverflowCount( ), 2u );
+    BOOST_CHECK_EQUAL( histogram.getNumberOfSamples( ), 8u );
+    BOOST_CHECK_EQUAL( histogram.getBinCounts( )[ 0 ], 2u );
+    BOOST_CHECK_EQUAL( histogram.getBinCounts( )[ 2 ], 2u );
+    BOOST_CHECK_EQUAL( histogram.getBinCounts( )[ 9 ], 1u );
+
+    const std::vector< double > binEdges = histogram.getBinEdges( );
+    BOOST_CHECK_EQUAL( binEdges.size( ), 11u );
+    BOOST_CHECK_CLOSE_FRACTION( binEdges[ 3 ], 3.0, std::numeric_limits< double >::epsilon( ) );
+
+    // Check quantile interpolation: fourth and fifth samples are in bin [2, 3).
+    BOOST_CHECK_CLOSE_FRACTION( histogram.getQuantile( 3.0 / 8.0 ), 1.0, 1.0E-15 );
+    BOOST_CHECK_CLOSE_FRACTION( histogram.getQuantile( 4.0 / 8.0 ), 2.5, 1.0E-15 );
+    BOOST_CHECK_EQUAL( histogram.getQuantile( 0.1 ), 0.0 );
+    BOOST_CHECK_EQUAL( histogram.getQuantile( 0.9 ), 10.0 );
+
+    // Check that histograms with different bins cannot be merged.
+    Histogram otherHistogram( 0.0, 10.0, 20 );
+    BOOST_CHECK_THROW( histogram.merge( otherHistogram ), std::runtime_error );
+
+    BOOST_CHECK_THROW( Histogram( 1.0, 1.0, 10 ), std::runtime_error );
+    BOOST_CHECK_THROW( Histogram( 0.0, 1.0, 0 ), std::runtime_error );
+}
+
+//! Test histogram with logarithmic bins, including merging and serialization.
+BOOST_AUTO_TEST_CASE( testLogarithmicHistogram )
+{
+    using statistics::Histogram;
+
+    BOOST_CHECK_THROW( Histogram( 0.0, 1.0E3, 10, statistics::logarithmicBinSpacing ),
+                       std::runtime_error );
+
+    // Fill histograms with one sample per decade, from separate (sub)sets of samples.
+    Histogram firstHistogram( 1.0E-3, 1.0E3, 6, statistics::logarithmicBinSpacing );
+    Histogram secondHistogram( 1.0E-3, 1.0E3, 6, statistics::logarithmicBinSpacing );
+    for ( int i = 0; i < 6; i++ )
+    {
+        const double sample = 2.0 * std::pow( 10.0, i - 3 );
+        ( ( i % 2 == 0 ) ? firstHistogram : secondHistogram ).addSample( sample );
+    }
+    firstHistogram.merge( secondHistogram );
+
+    for ( int i = 0; i < 6; i++ )
+    {
+        BOOST_CHECK_EQUAL( firstHistogram.getBinCounts( )[ i ], 1u );
+        BOOST_CHECK_CLOSE_FRACTION( firstHistogram.getBinEdges( )[ i ], std::pow( 10.0, i - 3 ),
+                                    1.0E-14 );
+    }
+
+    // Median is at edge between third and fourth bin.
+    BOOST_CHECK_CLOSE_FRACTION( firstHistogram.getQuantile( 0.5 ), 1.0, 1.0E-14 );
+
+    // Write histogram to binary stream, and read it back.
+    std::stringstream stream( std::ios::in | std::ios::out | std::ios::binary );
+    firstHistogram.writeToBinaryStream( stream );
+    Histogram readHistogram( stream );
+
+    BOOST_CHECK_EQUAL( readHistogram.getNumberOfBins( ), firstHistogram.getNumberOfBins( ) );
+    BOOST_CHECK_EQUAL( readHistogram.getNumberOfSamples( ), firstHistogram.getNumberOfSamples( ) );
+    BOOST_CHECK( readHistogram.getBinCounts( ) == firstHistogram.getBinCounts( ) );
+    BOOST_CHECK_EQUAL( readHistogram.getQuantile( 0.3 ), firstHistogram.getQuantile( 0.3 ) );
+    BOOST_CHECK_NO_THROW( readHistogram.merge( firstHistogram ) );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
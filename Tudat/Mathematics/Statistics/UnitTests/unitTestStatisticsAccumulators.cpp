@@ -0,0 +1,311 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      Unit test created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#define BOOST_TEST_MAIN
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <boost/random/mersenne_twister.hpp>
+#include <boost/random/normal_distribution.hpp>
+#include <boost/random/variate_generator.hpp>
+#include <boost/test/floating_point_comparison.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Basics/testMacros.h"
+#include "Tudat/Mathematics/Statistics/basicStatistics.h"
+#include "Tudat/Mathematics/Statistics/statisticsAccumulators.h"
+
+namespace tudat
+{
+namespace unit_tests
+{
+
+//! Generate skewed, large-offset test samples.
+/*!
+ * Generates test samples from a log-normal distribution with a large offset, so that the higher
+ * moments are non-zero, and a naive one-pass computation of the variance would be inaccurate.
+ * \param numberOfSamples Number of samples to generate.
+ * \return Generated samples.
+ */
+std::vector< double > generateScalarTestSamples( const int numberOfSamples )
+{
+    boost::mt19937 randomNumberGenerator( 42 );
+    boost::variate_generator< boost::mt19937&, boost::normal_distribution< > >
+            normalGenerator( randomNumberGenerator, boost::normal_distribution< >( 0.0, 0.5 ) );
+
+    std::vector< double > samples( numberOfSamples );
+    for ( int i = 0; i < numberOfSamples; i++ )
+    {
+        samples[ i ] = 1.0E6 + std::exp( normalGenerator( ) );
+    }
+    return samples;
+}
+
+//! Generate correlated test sample vectors.
+/*!
+ * Generates correlated test sample vectors, as the columns of a matrix.
+ * \param numberOfSamples Number of samples to generate.
+ * \return Generated samples (one per column).
+ */
+Eigen::MatrixXd generateVectorTestSamples( const int numberOfSamples )
+{
+    boost::mt19937 randomNumberGenerator( 1 );
+    boost::variate_generator< boost::mt19937&, boost::normal_distribution< > >
+            normalGenerator( randomNumberGenerator, boost::normal_distribution< >( ) );
+
+    Eigen::MatrixXd mixingMatrix( 4, 4 );
+    mixingMatrix << 1.0E3, 0.0, 0.0, 0.0,
+            2.0E2, 5.0E2, 0.0, 0.0,
+            -1.0, 0.3, 2.0, 0.0,
+            1.0E-3, -2.0E-3, 1.0E-4, 5.0E-3;
+    Eigen::VectorXd offset( 4 );
+    offset << 7.0E6, -3.0E6, 7.5E3, 1.0;
+
+    Eigen::MatrixXd samples( 4, numberOfSamples );
+    Eigen::VectorXd independentSample( 4 );
+    for ( int i = 0; i < numberOfSamples; i++ )
+    {
+        for ( int j = 0; j < 4; j++ )
+        {
+            independentSample( j ) = normalGenerator( );
+        }
+        samples.col( i ) = offset + mixingMatrix * independentSample;
+    }
+    return samples;
+}
+
+BOOST_AUTO_TEST_SUITE( test_statistics_accumulators )
+
+//! Test if scalar accumulator reproduces two-pass statistics.
+BOOST_AUTO_TEST_CASE( testScalarStatisticsAccumulator )
+{
+    using namespace statistics;
+
+    const std::vector< double > samples = generateScalarTestSamples( 100000 );
+
+    ScalarStatisticsAccumulator accumulator;
+    for ( unsigned int i = 0; i < samples.size( ); i++ )
+    {
+        accumulator.addSample( samples[ i ] );
+    }
+
+    // Compute expected statistics with two passes over samples.
+    const double expectedMean = computeSampleMean( samples );
+    double expectedSecondMoment = 0.0;
+    double expectedThirdMoment = 0.0;
+    double expectedFourthMoment = 0.0;
+    double expectedMinimum = samples[ 0 ];
+    double expectedMaximum = samples[ 0 ];
+    for ( unsigned int i = 0; i < samples.size( ); i++ )
+    {
+        const double deviation = samples[ i ] - expectedMean;
+        expectedSecondMoment += deviation * deviation;
+        expectedThirdMoment += deviation * deviation * deviation;
+        expectedFourthMoment += deviation * deviation * deviation * deviation;
+        expectedMinimum = std::min( expectedMinimum, samples[ i ] );
+        expectedMaximum = std::max( expectedMaximum, samples[ i ] );
+    }
+    const double numberOfSamples = static_cast< double >( samples.size( ) );
+
+    BOOST_CHECK_EQUAL( accumulator.getNumberOfSamples( ), samples.size( ) );
+    BOOST_CHECK_CLOSE_FRACTION( accumulator.getSampleMean( ), expectedMean, 1.0E-14 );
+    BOOST_CHECK_CLOSE_FRACTION( accumulator.getSampleVariance( ),
+                                computeSampleVariance( samples ), 1.0E-10 );
+    BOOST_CHECK_CLOSE_FRACTION( accumulator.getSkewness( ),
+                                std::sqrt( numberOfSamples ) * expectedThirdMoment
+                                / std::pow( expectedSecondMoment, 1.5 ), 1.0E-7 );
+    BOOST_CHECK_CLOSE_FRACTION( accumulator.getExcessKurtosis( ),
+                                numberOfSamples * expectedFourthMoment
+                                / ( expectedSecondMoment * expectedSecondMoment ) - 3.0,
+                                1.0E-7 );
+    BOOST_CHECK_EQUAL( accumulator.getMinimum( ), expectedMinimum );
+    BOOST_CHECK_EQUAL( accumulator.getMaximum( ), expectedMaximum );
+
+    // Check that a log-normal distribution is positively skewed.
+    BOOST_CHECK( accumulator.getSkewness( ) > 1.0 );
+}
+
+//! Test if merged scalar accumulators reproduce statistics of all samples.
+BOOST_AUTO_TEST_CASE( testScalarStatisticsAccumulatorMerging )
+{
+    using namespace statistics;
+
+    const std::vector< double > samples = generateScalarTestSamples( 100000 );
+
+    // Fill single accumulator, and accumulators for chunks of unequal size (as for threads).
+    ScalarStatisticsAccumulator accumulator;
+    std::vector< ScalarStatisticsAccumulator > chunkAccumulators( 7 );
+    for ( unsigned int i = 0; i < samples.size( ); i++ )
+    {
+        accumulator.addSample( samples[ i ] );
+        chunkAccumulators[ ( i * i ) % 7 ].addSample( samples[ i ] );
+    }
+
+    // Add empty accumulator, which should not affect result.
+    chunkAccumulators.push_back( ScalarStatisticsAccumulator( ) );
+
+    // Merge sequentially, and pairwise.
+    ScalarStatisticsAccumulator sequentiallyMergedAccumulator;
+    for ( unsigned int i = 0; i < chunkAccumulators.size( ); i++ )
+    {
+        sequentiallyMergedAccumulator.merge( chunkAccumulators[ i ] );
+    }
+    const ScalarStatisticsAccumulator pairwiseMergedAccumulator
+            = mergeStatisticsAccumulators( chunkAccumulators );
+
+    std::vector< ScalarStatisticsAccumulator > mergedAccumulators;
+    mergedAccumulators.push_back( sequentiallyMergedAccumulator );
+    mergedAccumulators.push_back( pairwiseMergedAccumulator );
+    for ( unsigned int i = 0; i < mergedAccumulators.size( ); i++ )
+    {
+        BOOST_CHECK_EQUAL( mergedAccumulators[ i ].getNumberOfSamples( ), samples.size( ) );
+        BOOST_CHECK_CLOSE_FRACTION( mergedAccumulators[ i ].getSampleMean( ),
+                                    accumulator.getSampleMean( ), 1.0E-14 );
+        BOOST_CHECK_CLOSE_FRACTION( mergedAccumulators[ i ].getSampleVariance( ),
+                                    accumulator.getSampleVariance( ), 1.0E-10 );
+        BOOST_CHECK_CLOSE_FRACTION( mergedAccumulators[ i ].getSkewness( ),
+                                    accumulator.getSkewness( ), 1.0E-7 );
+        BOOST_CHECK_CLOSE_FRACTION( mergedAccumulators[ i ].getExcessKurtosis( ),
+                                    accumulator.getExcessKurtosis( ), 1.0E-7 );
+        BOOST_CHECK_EQUAL( mergedAccumulators[ i ].getMinimum( ), accumulator.getMinimum( ) );
+        BOOST_CHECK_EQUAL( mergedAccumulators[ i ].getMaximum( ), accumulator.getMaximum( ) );
+    }
+
+    // Check that pairwise merging is reproducible.
+    const ScalarStatisticsAccumulator repeatedPairwiseMergedAccumulator
+            = mergeStatisticsAccumulators( chunkAccumulators );
+    BOOST_CHECK_EQUAL( repeatedPairwiseMergedAccumulator.getSampleVariance( ),
+                       pairwiseMergedAccumulator.getSampleVariance( ) );
+    BOOST_CHECK_EQUAL( repeatedPairwiseMergedAccumulator.getSumOfFourthPowerDeviations( ),
+                       pairwiseMergedAccumulator.getSumOfFourthPowerDeviations( ) );
+
+    // Check that accumulator can be reconstructed from its state (e.g., after transfer between
+    // processes).
+    const ScalarStatisticsAccumulator reconstructedAccumulator(
+                accumulator.getNumberOfSamples( ), accumulator.getSampleMean( ),
+                accumulator.getSumOfSquaredDeviations( ), accumulator.getSumOfCubedDeviations( ),
+                accumulator.getSumOfFourthPowerDeviations( ), accumulator.getMinimum( ),
+                accumulator.getMaximum( ) );
+    BOOST_CHECK_EQUAL( reconstructedAccumulator.getExcessKurtosis( ),
+                       accumulator.getExcessKurtosis( ) );
+}
+
+//! Test if vector accumulator reproduces two-pass statistics, also when merged.
+BOOST_AUTO_TEST_CASE( testVectorStatisticsAccumulator )
+{
+    using namespace statistics;
+
+    const int numberOfSamples = 50000;
+    const Eigen::MatrixXd samples = generateVectorTestSamples( numberOfSamples );
+
+    VectorStatisticsAccumulator accumulator( 4 );
+    std::vector< VectorStatisticsAccumulator > chunkAccumulators(
+                5, VectorStatisticsAccumulator( 4 ) );
+    for ( int i = 0; i < numberOfSamples; i++ )
+    {
+        accumulator.addSample( samples.col( i ) );
+        chunkAccumulators[ ( i / 1000 ) % 5 ].addSample( samples.col( i ) );
+    }
+    const VectorStatisticsAccumulator mergedAccumulator
+            = mergeStatisticsAccumulators( chunkAccumulators );
+
+    // Compute expected statistics with two passes over samples.
+    const Eigen::VectorXd expectedMean = samples.rowwise( ).mean( );
+    const Eigen::MatrixXd centeredSamples = samples.colwise( ) - expectedMean;
+    const Eigen::MatrixXd expectedCovariance = centeredSamples * centeredSamples.transpose( )
+            / static_cast< double >( numberOfSamples - 1 );
+
+    // Check mean and covariance of single and merged accumulator.
+    for ( int i = 0; i < 2; i++ )
+    {
+        const VectorStatisticsAccumulator& currentAccumulator
+                = ( i == 0 ) ? accumulator : mergedAccumulator;
+
+        const Eigen::VectorXd computedMean = currentAccumulator.getSampleMean( );
+        TUDAT_CHECK_MATRIX_CLOSE_FRACTION( computedMean, expectedMean, 1.0E-13 );
+
+        const Eigen::MatrixXd computedCovariance
+                = currentAccumulator.getSampleCovarianceMatrix( );
+        TUDAT_CHECK_MATRIX_BASE( computedCovariance, expectedCovariance )
+                BOOST_CHECK_SMALL( computedCovariance( row, col )
+                                   - expectedCovariance( row, col ),
+                                   1.0E-11 * std::sqrt( expectedCovariance( row, row )
+                                                        * expectedCovariance( col, col ) ) );
+    }
+
+    // Check correlation matrix, standard deviations and extrema.
+    const Eigen::MatrixXd correlationMatrix = accumulator.getSampleCorrelationMatrix( );
+    for ( int i = 0; i < 4; i++ )
+    {
+        BOOST_CHECK_CLOSE_FRACTION( correlationMatrix( i, i ), 1.0, 1.0E-15 );
+        BOOST_CHECK_CLOSE_FRACTION( accumulator.getSampleStandardDeviations( )( i ),
+                                    std::sqrt( expectedCovariance( i, i ) ), 1.0E-11 );
+        BOOST_CHECK_EQUAL( accumulator.getMinimum( )( i ), samples.row( i ).minCoeff( ) );
+        BOOST_CHECK_EQUAL( accumulator.getMaximum( )( i ), samples.row( i ).maxCoeff( ) );
+        BOOST_CHECK_EQUAL( mergedAccumulator.getMinimum( )( i ), samples.row( i ).minCoeff( ) );
+        BOOST_CHECK_EQUAL( mergedAccumulator.getMaximum( )( i ), samples.row( i ).maxCoeff( ) );
+    }
+    BOOST_CHECK_CLOSE_FRACTION( correlationMatrix( 0, 1 ), 200.0 / std::sqrt( 290000.0 ), 1.0E-2 );
+}
+
+//! Test error handling of statistics accumulators.
+BOOST_AUTO_TEST_CASE( testStatisticsAccumulatorErrorHandling )
+{
+    using namespace statistics;
+
+    // Check that statistics require sufficient samples.
+    ScalarStatisticsAccumulator scalarAccumulator;
+    BOOST_CHECK_THROW( scalarAccumulator.getSampleMean( ), std::runtime_error );
+    scalarAccumulator.addSample( 1.0 );
+    BOOST_CHECK_EQUAL( scalarAccumulator.getSampleMean( ), 1.0 );
+    BOOST_CHECK_THROW( scalarAccumulator.getSampleVariance( ), std::runtime_error );
+
+    VectorStatisticsAccumulator vectorAccumulator( 3 );
+    BOOST_CHECK_THROW( vectorAccumulator.getMinimum( ), std::runtime_error );
+
+    // Check that inconsistent sizes are rejected.
+    BOOST_CHECK_THROW( vectorAccumulator.addSample( Eigen::VectorXd::Zero( 4 ) ),
+                       std::runtime_error );
+    BOOST_CHECK_THROW( vectorAccumulator.merge( VectorStatisticsAccumulator( 2 ) ),
+                       std::runtime_error );
+}
+
+BOOST_AUTO_TEST_SUITE_END( )
+
+} // namespace unit_tests
+} // namespace tudat
@@ -0,0 +1,214 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *
+ *    References
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include "Tudat/InputOutput/binaryInputOutput.h"
+#include "Tudat/Mathematics/Statistics/histogram.h"
+
+namespace tudat
+{
+namespace statistics
+{
+
+//! Constructor.
+Histogram::Histogram( const double lowerBound, const double upperBound, const int numberOfBins,
+                      const HistogramBinSpacing binSpacing )
+    : lowerBound_( lowerBound ),
+      upperBound_( upperBound ),
+      binSpacing_( binSpacing ),
+      binCounts_( std::max( numberOfBins, 0 ), 0 ),
+      underflowCount_( 0 ),
+      overflowCount_( 0 )
+{
+    initialize( );
+}
+
+//! Constructor from binary stream.
+Histogram::Histogram( std::istream& stream )
+{
+    lowerBound_ = input_output::readValueFromBinaryStream< double >( stream );
+    upperBound_ = input_output::readValueFromBinaryStream< double >( stream );
+    binSpacing_ = static_cast< HistogramBinSpacing >(
+                input_output::readValueFromBinaryStream< boost::int32_t >( stream ) );
+    underflowCount_ = input_output::readValueFromBinaryStream< CountType >( stream );
+    overflowCount_ = input_output::readValueFromBinaryStream< CountType >( stream );
+    binCounts_ = input_output::readVectorFromBinaryStream< CountType >( stream );
+
+    initialize( );
+}
+
+//! Merge with other histogram.
+void Histogram::merge( const Histogram& otherHistogram )
+{
+    if ( otherHistogram.lowerBound_ != lowerBound_ || otherHistogram.upperBound_ != upperBound_ ||
+         otherHistogram.binSpacing_ != binSpacing_ ||
+         otherHistogram.binCounts_.size( ) != binCounts_.size( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error, cannot merge histograms with different "
+                                            "bins." ) ) );
+    }
+
+    for ( unsigned int i = 0; i < binCounts_.size( ); i++ )
+    {
+        binCounts_[ i ] += otherHistogram.binCounts_[ i ];
+    }
+    underflowCount_ += otherHistogram.underflowCount_;
+    overflowCount_ += otherHistogram.overflowCount_;
+}
+
+//! Get quantile.
+double Histogram::getQuantile( const double quantile ) const
+{
+    const CountType numberOfSamples = getNumberOfSamples( );
+    if ( numberOfSamples == 0 || !( quantile >= 0.0 && quantile <= 1.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error, histogram quantile requires samples, and "
+                                            "quantile between 0 and 1." ) ) );
+    }
+
+    const double targetCount = quantile * static_cast< double >( numberOfSamples );
+    double countSoFar = static_cast< double >( underflowCount_ );
+    if ( targetCount <= countSoFar )
+    {
+        return lowerBound_;
+    }
+
+    // Find bin in which quantile is located, and interpolate within it (linearly in the sample
+    // value, or its logarithm).
+    for ( unsigned int i = 0; i < binCounts_.size( ); i++ )
+    {
+        const double binCount = static_cast< double >( binCounts_[ i ] );
+        if ( binCount > 0.0 && targetCount <= countSoFar + binCount )
+        {
+            const double scaledValue = scaledLowerBound_
+                    + ( static_cast< double >( i ) + ( targetCount - countSoFar ) / binCount )
+                    / binScaling_;
+            return ( binSpacing_ == logarithmicBinSpacing ) ? std::exp( scaledValue )
+                                                            : scaledValue;
+        }
+        countSoFar += binCount;
+    }
+
+    return upperBound_;
+}
+
+//! Write to binary stream.
+void Histogram::writeToBinaryStream( std::ostream& stream ) const
+{
+    input_output::writeValueToBinaryStream( stream, lowerBound_ );
+    input_output::writeValueToBinaryStream( stream, upperBound_ );
+    input_output::writeValueToBinaryStream( stream, static_cast< boost::int32_t >( binSpacing_ ) );
+    input_output::writeValueToBinaryStream( stream, underflowCount_ );
+    input_output::writeValueToBinaryStream( stream, overflowCount_ );
+    input_output::writeVectorToBinaryStream( stream, binCounts_ );
+}
+
+//! Get bin edges.
+std::vector< double > Histogram::getBinEdges( ) const
+{
+    std::vector< double > binEdges( binCounts_.size( ) + 1 );
+    for ( unsigned int i = 0; i < binEdges.size( ); i++ )
+    {
+        const double scaledEdge = scaledLowerBound_ + static_cast< double >( i ) / binScaling_;
+        binEdges[ i ] = ( binSpacing_ == logarithmicBinSpacing ) ? std::exp( scaledEdge )
+                                                                 : scaledEdge;
+    }
+
+    // Set outer edges exactly.
+    binEdges.front( ) = lowerBound_;
+    binEdges.back( ) = upperBound_;
+
+    return binEdges;
+}
+
+//! Get total number of samples.
+Histogram::CountType Histogram::getNumberOfSamples( ) const
+{
+    CountType numberOfSamples = underflowCount_ + overflowCount_;
+    for ( unsigned int i = 0; i < binCounts_.size( ); i++ )
+    {
+        numberOfSamples += binCounts_[ i ];
+    }
+    return numberOfSamples;
+}
+
+//! Initialize histogram.
+void Histogram::initialize( )
+{
+    if ( binCounts_.empty( ) || !( upperBound_ > lowerBound_ ) ||
+         ( binSpacing_ == logarithmicBinSpacing && !( lowerBound_ > 0.0 ) ) ||
+         ( binSpacing_ != linearBinSpacing && binSpacing_ != logarithmicBinSpacing ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, histogram requires at least one bin, upper bound larger than "
+                            "lower bound, and positive lower bound for logarithmic bins." ) ) );
+    }
+
+    const double numberOfBins = static_cast< double >( binCounts_.size( ) );
+    if ( binSpacing_ == logarithmicBinSpacing )
+    {
+        scaledLowerBound_ = std::log( lowerBound_ );
+        binScaling_ = numberOfBins / ( std::log( upperBound_ ) - scaledLowerBound_ );
+    }
+    else
+    {
+        scaledLowerBound_ = lowerBound_;
+        binScaling_ = numberOfBins / ( upperBound_ - lowerBound_ );
+    }
+}
+
+//! Compute index of bin.
+int Histogram::computeBinIndex( const double sample ) const
+{
+    const double scaledSample = ( binSpacing_ == logarithmicBinSpacing ) ? std::log( sample )
+                                                                         : sample;
+
+    // Limit index to last bin, in case of round-off for samples close to upper bound.
+    return std::min( static_cast< int >( ( scaledSample - scaledLowerBound_ ) * binScaling_ ),
+                     static_cast< int >( binCounts_.size( ) ) - 1 );
+}
+
+} // namespace statistics
+} // namespace tudat
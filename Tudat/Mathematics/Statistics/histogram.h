@@ -0,0 +1,234 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *
+ *    References
+ *
+ *    Notes
+ *      A Histogram is not safe to fill concurrently from multiple threads. Instead, each thread
+ *      should fill its own Histogram (with identical bins), after which these are merged. Since
+ *      the bin counts are integers, the merged result is independent of the merge order.
+ *
+ */
+
+#ifndef TUDAT_HISTOGRAM_H
+#define TUDAT_HISTOGRAM_H
+
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace tudat
+{
+namespace statistics
+{
+
+//! Enum of available histogram bin spacings.
+/*!
+ * Enum of available histogram bin spacings.
+ */
+enum HistogramBinSpacing
+{
+    linearBinSpacing,
+    logarithmicBinSpacing
+};
+
+//! Histogram class.
+/*!
+ * Histogram with a fixed number of bins between a lower and upper bound, of which the width is
+ * either constant (linear bin spacing), or increases geometrically (logarithmic bin spacing, for
+ * quantities spanning several orders of magnitude, such as miss distances). Samples are added in
+ * O(1) time, and samples outside the bounds are counted separately.
+ */
+class Histogram
+{
+public:
+
+    //! Typedef for count of samples.
+    typedef boost::uint64_t CountType;
+
+    //! Constructor.
+    /*!
+     * Constructor, creates histogram without samples.
+     * \param lowerBound Lower bound of first bin; must be positive for logarithmic bin spacing.
+     * \param upperBound Upper bound of last bin.
+     * \param numberOfBins Number of bins.
+     * \param binSpacing Spacing of bins (default linear).
+     */
+    Histogram( const double lowerBound, const double upperBound, const int numberOfBins,
+               const HistogramBinSpacing binSpacing = linearBinSpacing );
+
+    //! Constructor from binary stream.
+    /*!
+     * Constructor, reads histogram from binary stream, as written by writeToBinaryStream( ).
+     * \param stream Stream from which histogram is read (opened in binary mode).
+     */
+    Histogram( std::istream& stream );
+
+    //! Add sample.
+    /*!
+     * Adds sample to histogram. Samples that are smaller than the lower bound or larger than (or
+     * equal to) the upper bound are added to the underflow or overflow count, respectively.
+     * Not-a-number values are ignored.
+     * \param sample Sample value.
+     */
+    void addSample( const double sample )
+    {
+        if ( sample < lowerBound_ )
+        {
+            underflowCount_++;
+        }
+        else if ( sample >= upperBound_ )
+        {
+            overflowCount_++;
+        }
+        else if ( sample == sample )
+        {
+            binCounts_[ computeBinIndex( sample ) ]++;
+        }
+    }
+
+    //! Merge with other histogram.
+    /*!
+     * Adds the counts of another histogram, which must have identical bins, to this one.
+     * \param otherHistogram Histogram to merge into this one.
+     */
+    void merge( const Histogram& otherHistogram );
+
+    //! Get quantile.
+    /*!
+     * Estimates quantile of samples, by linear interpolation within the bin in which it is
+     * located. Samples outside the bounds are included in the total number of samples; if the
+     * quantile lies outside the bounds, the corresponding bound is returned.
+     * \param quantile Quantile, between 0 and 1.
+     * \return Estimated value of quantile.
+     */
+    double getQuantile( const double quantile ) const;
+
+    //! Write to binary stream.
+    /*!
+     * Writes histogram to binary stream, from which it can be read by the corresponding
+     * constructor.
+     * \param stream Stream to which histogram is written (opened in binary mode).
+     */
+    void writeToBinaryStream( std::ostream& stream ) const;
+
+    //! Get bin edges.
+    /*!
+     * Returns edges of bins, such that bin i spans [ edge i, edge i + 1 ).
+     * \return Bin edges (size is number of bins plus one).
+     */
+    std::vector< double > getBinEdges( ) const;
+
+    //! Get bin counts.
+    /*!
+     * Returns number of samples in each bin.
+     * \return Bin counts.
+     */
+    const std::vector< CountType >& getBinCounts( ) const { return binCounts_; }
+
+    //! Get underflow count.
+    /*!
+     * Returns number of samples smaller than lower bound.
+     * \return Underflow count.
+     */
+    CountType getUnderflowCount( ) const { return underflowCount_; }
+
+    //! Get overflow count.
+    /*!
+     * Returns number of samples larger than or equal to upper bound.
+     * \return Overflow count.
+     */
+    CountType getOverflowCount( ) const { return overflowCount_; }
+
+    //! Get total number of samples.
+    /*!
+     * Returns total number of samples, including those outside the bounds.
+     * \return Total number of samples.
+     */
+    CountType getNumberOfSamples( ) const;
+
+    //! Get number of bins.
+    /*!
+     * Returns number of bins.
+     * \return Number of bins.
+     */
+    int getNumberOfBins( ) const { return static_cast< int >( binCounts_.size( ) ); }
+
+protected:
+
+private:
+
+    //! Initialize histogram.
+    /*!
+     * Checks bounds and bin spacing, and computes scaling used to determine bin index.
+     */
+    void initialize( );
+
+    //! Compute index of bin.
+    /*!
+     * Computes index of bin in which sample falls; sample must be within bounds.
+     * \param sample Sample value.
+     * \return Index of bin.
+     */
+    int computeBinIndex( const double sample ) const;
+
+    //! Lower bound of first bin.
+    double lowerBound_;
+
+    //! Upper bound of last bin.
+    double upperBound_;
+
+    //! Spacing of bins.
+    HistogramBinSpacing binSpacing_;
+
+    //! Number of bins per unit of (logarithm of) sample value.
+    double binScaling_;
+
+    //! Lower bound in which bins are uniform (lower bound or its logarithm).
+    double scaledLowerBound_;
+
+    //! Number of samples in each bin.
+    std::vector< CountType > binCounts_;
+
+    //! Number of samples smaller than lower bound.
+    CountType underflowCount_;
+
+    //! Number of samples larger than or equal to upper bound.
+    CountType overflowCount_;
+};
+
+//! Typedef for shared-pointer to Histogram.
+typedef boost::shared_ptr< Histogram > HistogramPointer;
+
+} // namespace statistics
+} // namespace tudat
+
+#endif // TUDAT_HISTOGRAM_H
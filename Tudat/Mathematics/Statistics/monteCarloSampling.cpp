@@ -0,0 +1,371 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Accept positive semi-definite covariance matrices.
+ *
+ *    References
+ *      Joe, S., Kuo, F.Y. Constructing Sobol Sequences with Better Two-Dimensional Projections.
+ *          SIAM Journal on Scientific Computing, 30(5), 2635-2654, 2008.
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+#include <boost/exception/all.hpp>
+#include <boost/math/distributions/normal.hpp>
+
+#include <Eigen/Cholesky>
+
+#include "Tudat/Mathematics/Statistics/monteCarloSampling.h"
+
+namespace tudat
+{
+namespace statistics
+{
+
+//! Constructor.
+MultivariateNormalSampler::MultivariateNormalSampler( const Eigen::VectorXd& mean,
+                                                      const Eigen::MatrixXd& covarianceMatrix )
+    : mean_( mean )
+{
+    if ( covarianceMatrix.rows( ) != mean.rows( ) || covarianceMatrix.cols( ) != mean.rows( ) )
+    {
+        std::stringstream errorMessage;
+        errorMessage << "Error, covariance matrix of size " << covarianceMatrix.rows( ) << "x"
+                     << covarianceMatrix.cols( ) << " is inconsistent with mean of size "
+                     << mean.rows( ) << "." << std::endl;
+        boost::throw_exception( boost::enable_error_info( std::runtime_error(
+                                                              errorMessage.str( ) ) ) );
+    }
+
+    // Use Cholesky factor for positive definite covariance matrix.
+    const Eigen::LLT< Eigen::MatrixXd > choleskyDecomposition( covarianceMatrix );
+    if ( choleskyDecomposition.info( ) == Eigen::Success )
+    {
+        covarianceFactor_ = choleskyDecomposition.matrixL( );
+        return;
+    }
+
+    // Otherwise, use pivoted LDLT decomposition P^T L D L^T P, which exists for positive
+    // semi-definite matrices, and reject matrices with a significantly negative diagonal entry.
+    // The status of the decomposition is not used, since zero pivots are reported as a numerical
+    // issue.
+    const Eigen::LDLT< Eigen::MatrixXd > ldltDecomposition( covarianceMatrix );
+    Eigen::VectorXd diagonal = ldltDecomposition.vectorD( );
+    const double tolerance = static_cast< double >( mean.rows( ) )
+            * std::numeric_limits< double >::epsilon( ) * diagonal.cwiseAbs( ).maxCoeff( );
+    if ( !( diagonal.minCoeff( ) >= -tolerance ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error, covariance matrix of multivariate normal "
+                                            "distribution is not positive semi-definite." ) ) );
+    }
+
+    diagonal = diagonal.cwiseMax( 0.0 ).cwiseSqrt( );
+    covarianceFactor_ = ldltDecomposition.transpositionsP( ).transpose( )
+            * ( Eigen::MatrixXd( ldltDecomposition.matrixL( ) ) * diagonal.asDiagonal( ) );
+}
+
+//! Generate sample from random number stream.
+Eigen::VectorXd MultivariateNormalSampler::generateSample(
+        RandomNumberStream& randomNumberStream ) const
+{
+    Eigen::VectorXd standardNormalSample( mean_.rows( ) );
+    for ( int i = 0; i < standardNormalSample.rows( ); i++ )
+    {
+        standardNormalSample( i ) = randomNumberStream.generateStandardNormal( );
+    }
+
+    return mean_ + covarianceFactor_ * standardNormalSample;
+}
+
+//! Generate sample with given index.
+Eigen::VectorXd MultivariateNormalSampler::generateSample(
+        const boost::uint64_t seed, const boost::uint64_t sampleIndex ) const
+{
+    RandomNumberStream randomNumberStream( seed, sampleIndex );
+    return generateSample( randomNumberStream );
+}
+
+//! Generate samples.
+Eigen::MatrixXd MultivariateNormalSampler::generateSamples(
+        const boost::uint64_t seed, const boost::uint64_t firstSampleIndex,
+        const int numberOfSamples, const int numberOfThreads ) const
+{
+    Eigen::MatrixXd samples( mean_.rows( ), std::max( numberOfSamples, 0 ) );
+
+    // Divide samples over threads, and generate first range on calling thread. Since each sample
+    // is generated from its own random number stream, the division does not affect the result.
+    const int numberOfUsedThreads
+            = std::max( 1, std::min( numberOfThreads, static_cast< int >( samples.cols( ) ) ) );
+    const int samplesPerThread
+            = ( static_cast< int >( samples.cols( ) ) + numberOfUsedThreads - 1 )
+            / numberOfUsedThreads;
+
+    std::vector< std::thread > threads;
+    for ( int thread = 1; thread < numberOfUsedThreads; thread++ )
+    {
+        threads.push_back( std::thread(
+                               &MultivariateNormalSampler::generateSampleRange, this, seed,
+                               firstSampleIndex,
+                               std::min( thread * samplesPerThread, numberOfSamples ),
+                               std::min( ( thread + 1 ) * samplesPerThread, numberOfSamples ),
+                               std::ref( samples ) ) );
+    }
+
+    generateSampleRange( seed, firstSampleIndex, 0,
+                         std::min( samplesPerThread, static_cast< int >( samples.cols( ) ) ),
+                         samples );
+
+    for ( unsigned int i = 0; i < threads.size( ); i++ )
+    {
+        threads[ i ].join( );
+    }
+
+    return samples;
+}
+
+//! Transform standard normal samples.
+Eigen::MatrixXd MultivariateNormalSampler::transformStandardNormalSamples(
+        const Eigen::MatrixXd& standardNormalSamples ) const
+{
+    if ( standardNormalSamples.rows( ) != mean_.rows( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error, dimension of standard normal samples is "
+                                            "inconsistent with multivariate normal "
+                                            "distribution." ) ) );
+    }
+
+    Eigen::MatrixXd samples
+            = covarianceFactor_ * standardNormalSamples;
+    samples.colwise( ) += mean_;
+    return samples;
+}
+
+//! Generate range of samples.
+void MultivariateNormalSampler::generateSampleRange(
+        const boost::uint64_t seed, const boost::uint64_t firstSampleIndex,
+        const int startColumn, const int endColumn, Eigen::MatrixXd& samples ) const
+{
+    for ( int i = startColumn; i < endColumn; i++ )
+    {
+        samples.col( i ) = generateSample( seed, firstSampleIndex + i );
+    }
+}
+
+//! Generate Latin hypercube samples.
+Eigen::MatrixXd generateLatinHypercubeSamples( const int numberOfSamples,
+                                               const int numberOfDimensions,
+                                               const boost::uint64_t seed )
+{
+    if ( numberOfSamples < 1 || numberOfDimensions < 1 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error, Latin hypercube sampling requires at least "
+                                            "one sample and one dimension." ) ) );
+    }
+
+    Eigen::MatrixXd samples( numberOfDimensions, numberOfSamples );
+    std::vector< int > strata( numberOfSamples );
+    for ( int dimension = 0; dimension < numberOfDimensions; dimension++ )
+    {
+        RandomNumberStream randomNumberStream( seed, dimension );
+
+        // Randomly permute strata (Fisher-Yates shuffle).
+        for ( int i = 0; i < numberOfSamples; i++ )
+        {
+            strata[ i ] = i;
+        }
+        for ( int i = numberOfSamples - 1; i > 0; i-- )
+        {
+            const int j = std::min( static_cast< int >(
+                                        randomNumberStream.generateUniform( ) * ( i + 1 ) ), i );
+            std::swap( strata[ i ], strata[ j ] );
+        }
+
+        // Place each sample at random location within its stratum.
+        for ( int i = 0; i < numberOfSamples; i++ )
+        {
+            samples( dimension, i ) = ( static_cast< double >( strata[ i ] )
+                                        + randomNumberStream.generateUniform( ) )
+                    / static_cast< double >( numberOfSamples );
+        }
+    }
+
+    return samples;
+}
+
+//! Convert uniform samples to standard normal samples.
+Eigen::MatrixXd convertUniformToStandardNormalSamples( const Eigen::MatrixXd& uniformSamples )
+{
+    const boost::math::normal standardNormalDistribution;
+
+    Eigen::MatrixXd standardNormalSamples( uniformSamples.rows( ), uniformSamples.cols( ) );
+    for ( int j = 0; j < uniformSamples.cols( ); j++ )
+    {
+        for ( int i = 0; i < uniformSamples.rows( ); i++ )
+        {
+            if ( !( uniformSamples( i, j ) > 0.0 && uniformSamples( i, j ) < 1.0 ) )
+            {
+                boost::throw_exception(
+                            boost::enable_error_info(
+                                std::runtime_error( "Error, uniform samples must be in open unit "
+                                                    "interval to convert to normal samples." ) ) );
+            }
+            standardNormalSamples( i, j ) = boost::math::quantile( standardNormalDistribution,
+                                                                   uniformSamples( i, j ) );
+        }
+    }
+
+    return standardNormalSamples;
+}
+
+//! Maximum number of dimensions for which direction numbers are available.
+const int SobolSequenceGenerator::maximumNumberOfDimensions;
+
+//! Constructor.
+SobolSequenceGenerator::SobolSequenceGenerator( const int numberOfDimensions )
+    : numberOfDimensions_( numberOfDimensions )
+{
+    if ( numberOfDimensions < 1 || numberOfDimensions > maximumNumberOfDimensions )
+    {
+        std::stringstream errorMessage;
+        errorMessage << "Error, Sobol sequence is available for 1 to "
+                     << maximumNumberOfDimensions << " dimensions, but " << numberOfDimensions
+                     << " dimensions were requested." << std::endl;
+        boost::throw_exception( boost::enable_error_info( std::runtime_error(
+                                                              errorMessage.str( ) ) ) );
+    }
+
+    // Set degree and coefficients of primitive polynomials, and initial direction numbers, of
+    // dimensions 2 to 16 (Joe & Kuo, 2008).
+    const int polynomialDegrees[ ] = { 1, 2, 3, 3, 4, 4, 5, 5, 5, 5, 5, 5, 6, 6, 6 };
+    const unsigned int polynomialCoefficients[ ] = { 0, 1, 1, 2, 1, 4, 2, 4, 7, 11, 13, 14, 1,
+                                                     13, 16 };
+    const boost::uint32_t initialDirectionNumbers[ ][ 6 ] =
+    {
+        { 1 }, { 1, 3 }, { 1, 3, 1 }, { 1, 1, 1 }, { 1, 1, 3, 3 }, { 1, 3, 5, 13 },
+        { 1, 1, 5, 5, 17 }, { 1, 1, 5, 5, 5 }, { 1, 1, 7, 11, 19 }, { 1, 1, 5, 1, 1 },
+        { 1, 1, 1, 3, 11 }, { 1, 3, 5, 5, 31 }, { 1, 3, 3, 9, 7, 49 }, { 1, 1, 1, 15, 21, 21 },
+        { 1, 3, 1, 13, 27, 49 }
+    };
+
+    const int numberOfBits = 32;
+    directionNumbers_.resize( numberOfDimensions_,
+                              std::vector< boost::uint32_t >( numberOfBits ) );
+
+    // First dimension is the van der Corput sequence in base 2.
+    for ( int bit = 0; bit < numberOfBits; bit++ )
+    {
+        directionNumbers_[ 0 ][ bit ] = static_cast< boost::uint32_t >( 1 )
+                << ( numberOfBits - 1 - bit );
+    }
+
+    for ( int dimension = 1; dimension < numberOfDimensions_; dimension++ )
+    {
+        const int degree = polynomialDegrees[ dimension - 1 ];
+        const unsigned int coefficients = polynomialCoefficients[ dimension - 1 ];
+        std::vector< boost::uint32_t >& directionNumbers = directionNumbers_[ dimension ];
+
+        for ( int bit = 0; bit < degree; bit++ )
+        {
+            directionNumbers[ bit ] = initialDirectionNumbers[ dimension - 1 ][ bit ]
+                    << ( numberOfBits - 1 - bit );
+        }
+
+        // Compute remaining direction numbers from recurrence relation of primitive polynomial.
+        for ( int bit = degree; bit < numberOfBits; bit++ )
+        {
+            directionNumbers[ bit ] = directionNumbers[ bit - degree ]
+                    ^ ( directionNumbers[ bit - degree ] >> degree );
+            for ( int k = 1; k < degree; k++ )
+            {
+                if ( ( coefficients >> ( degree - 1 - k ) ) & 1 )
+                {
+                    directionNumbers[ bit ] ^= directionNumbers[ bit - k ];
+                }
+            }
+        }
+    }
+}
+
+//! Get point.
+Eigen::VectorXd SobolSequenceGenerator::getPoint( const boost::uint64_t pointIndex ) const
+{
+    if ( pointIndex > 0xFFFFFFFF )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error, index of Sobol point must be smaller than "
+                                            "2^32." ) ) );
+    }
+
+    // Combine direction numbers of bits of Gray code of index (Antonov & Saleev, 1979).
+    const boost::uint64_t grayCode = pointIndex ^ ( pointIndex >> 1 );
+
+    Eigen::VectorXd point( numberOfDimensions_ );
+    for ( int dimension = 0; dimension < numberOfDimensions_; dimension++ )
+    {
+        boost::uint32_t integerCoordinate = 0;
+        for ( int bit = 0; ( grayCode >> bit ) != 0; bit++ )
+        {
+            if ( ( grayCode >> bit ) & 1 )
+            {
+                integerCoordinate ^= directionNumbers_[ dimension ][ bit ];
+            }
+        }
+        point( dimension ) = static_cast< double >( integerCoordinate ) / 4294967296.0;
+    }
+
+    return point;
+}
+
+//! Get points.
+Eigen::MatrixXd SobolSequenceGenerator::getPoints( const boost::uint64_t firstPointIndex,
+                                                   const int numberOfPoints ) const
+{
+    Eigen::MatrixXd points( numberOfDimensions_, std::max( numberOfPoints, 0 ) );
+    for ( int i = 0; i < points.cols( ); i++ )
+    {
+        points.col( i ) = getPoint( firstPointIndex + i );
+    }
+    return points;
+}
+
+} // namespace statistics
+} // namespace tudat
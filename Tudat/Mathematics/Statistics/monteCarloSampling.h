@@ -0,0 +1,275 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Accept positive semi-definite covariance matrices.
+ *
+ *    References
+ *      McKay, M.D., Beckman, R.J., Conover, W.J. A Comparison of Three Methods for Selecting
+ *          Values of Input Variables in the Analysis of Output from a Computer Code.
+ *          Technometrics, 21(2), 239-245, 1979.
+ *      Joe, S., Kuo, F.Y. Constructing Sobol Sequences with Better Two-Dimensional Projections.
+ *          SIAM Journal on Scientific Computing, 30(5), 2635-2654, 2008.
+ *      Antonov, I.A., Saleev, V.M. An Economic Method of Computing LP-tau Sequences. USSR
+ *          Computational Mathematics and Mathematical Physics, 19(1), 252-256, 1979.
+ *
+ *    Notes
+ *      All samples are stored as the columns of a matrix. The random numbers of each sample are
+ *      drawn from a RandomNumberStream of which the stream index is the index of the sample, so
+ *      that the samples are bit-identical regardless of the number of threads with which they are
+ *      generated. The Sobol sequence is deterministic, and is currently limited to 16 dimensions.
+ *
+ */
+
+#ifndef TUDAT_MONTE_CARLO_SAMPLING_H
+#define TUDAT_MONTE_CARLO_SAMPLING_H
+
+#include <vector>
+
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+#include "Tudat/Mathematics/Statistics/randomNumberStreams.h"
+
+namespace tudat
+{
+namespace statistics
+{
+
+//! Multivariate normal sampler class.
+/*!
+ * Generates samples from a multivariate normal distribution with given mean and covariance
+ * matrix. A factor \f$ \mathbf{L} \f$ of the covariance matrix, such that
+ * \f$ \mathbf{P} = \mathbf{L}\mathbf{L}^{T} \f$, is computed once, at construction, after which
+ * each sample is computed as \f$ \bar{x} = \bar{\mu} + \mathbf{L}\bar{z} \f$, with \f$ \bar{z} \f$
+ * a vector of independent standard normal random numbers. The factor is the Cholesky factor for
+ * positive definite covariance matrices, and is computed from a pivoted LDLT decomposition for
+ * positive semi-definite (singular) covariance matrices.
+ */
+class MultivariateNormalSampler
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, computes factor of covariance matrix. An exception is thrown if the covariance
+     * matrix is not square, of a different size than the mean, or not positive semi-definite.
+     * \param mean Mean of distribution.
+     * \param covarianceMatrix Covariance matrix of distribution (symmetric, positive
+     *          semi-definite).
+     */
+    MultivariateNormalSampler( const Eigen::VectorXd& mean,
+                               const Eigen::MatrixXd& covarianceMatrix );
+
+    //! Generate sample from random number stream.
+    /*!
+     * Generates sample, using the next standard normal random numbers of the given stream.
+     * \param randomNumberStream Stream from which random numbers are drawn.
+     * \return Sample.
+     */
+    Eigen::VectorXd generateSample( RandomNumberStream& randomNumberStream ) const;
+
+    //! Generate sample with given index.
+    /*!
+     * Generates sample with given index, using the random number stream with the given seed, and
+     * the sample index as stream index.
+     * \param seed Seed of random numbers.
+     * \param sampleIndex Index of sample.
+     * \return Sample.
+     */
+    Eigen::VectorXd generateSample( const boost::uint64_t seed,
+                                    const boost::uint64_t sampleIndex ) const;
+
+    //! Generate samples.
+    /*!
+     * Generates a range of consecutive samples, of which sample i is identical to the result of
+     * generateSample( seed, firstSampleIndex + i ). The samples are divided over the given
+     * number of threads, which does not affect the result.
+     * \param seed Seed of random numbers.
+     * \param firstSampleIndex Index of first sample.
+     * \param numberOfSamples Number of samples.
+     * \param numberOfThreads Number of threads used to generate samples (default 1).
+     * \return Samples, stored as columns.
+     */
+    Eigen::MatrixXd generateSamples( const boost::uint64_t seed,
+                                     const boost::uint64_t firstSampleIndex,
+                                     const int numberOfSamples,
+                                     const int numberOfThreads = 1 ) const;
+
+    //! Transform standard normal samples.
+    /*!
+     * Transforms samples of independent standard normal random numbers to samples of the
+     * distribution, e.g. to use normal samples obtained from a Latin hypercube or Sobol sequence
+     * with convertUniformToStandardNormalSamples( ).
+     * \param standardNormalSamples Samples of independent standard normal random numbers, stored
+     *          as columns.
+     * \return Samples of distribution, stored as columns.
+     */
+    Eigen::MatrixXd transformStandardNormalSamples(
+            const Eigen::MatrixXd& standardNormalSamples ) const;
+
+    //! Get mean.
+    /*!
+     * Returns mean of distribution.
+     * \return Mean.
+     */
+    const Eigen::VectorXd& getMean( ) const { return mean_; }
+
+    //! Get factor of covariance matrix.
+    /*!
+     * Returns factor \f$ \mathbf{L} \f$ of covariance matrix, with
+     * \f$ \mathbf{P} = \mathbf{L}\mathbf{L}^{T} \f$. For a positive definite covariance matrix,
+     * this is the lower-triangular Cholesky factor.
+     * \return Factor of covariance matrix.
+     */
+    const Eigen::MatrixXd& getCovarianceFactor( ) const { return covarianceFactor_; }
+
+    //! Get dimension of distribution.
+    /*!
+     * Returns dimension of distribution.
+     * \return Dimension.
+     */
+    int getDimension( ) const { return static_cast< int >( mean_.rows( ) ); }
+
+protected:
+
+private:
+
+    //! Generate range of samples.
+    /*!
+     * Generates range of samples, and stores them in given matrix.
+     * \param seed Seed of random numbers.
+     * \param firstSampleIndex Index of first sample in matrix.
+     * \param startColumn First column that is generated.
+     * \param endColumn Column after last column that is generated.
+     * \param samples Matrix in which samples are stored.
+     */
+    void generateSampleRange( const boost::uint64_t seed, const boost::uint64_t firstSampleIndex,
+                              const int startColumn, const int endColumn,
+                              Eigen::MatrixXd& samples ) const;
+
+    //! Mean of distribution.
+    Eigen::VectorXd mean_;
+
+    //! Factor of covariance matrix.
+    Eigen::MatrixXd covarianceFactor_;
+};
+
+//! Typedef for shared-pointer to MultivariateNormalSampler.
+typedef boost::shared_ptr< MultivariateNormalSampler > MultivariateNormalSamplerPointer;
+
+//! Generate Latin hypercube samples.
+/*!
+ * Generates Latin hypercube samples on the unit hypercube (McKay et al., 1979): each dimension
+ * is divided in as many equal strata as there are samples, and each stratum contains exactly one
+ * sample, at a random location within the stratum. The strata of each dimension are randomly
+ * permuted, using the random number stream with the given seed and the index of the dimension
+ * as stream index.
+ * \param numberOfSamples Number of samples.
+ * \param numberOfDimensions Number of dimensions.
+ * \param seed Seed of random numbers.
+ * \return Samples in the open unit hypercube, stored as columns.
+ */
+Eigen::MatrixXd generateLatinHypercubeSamples( const int numberOfSamples,
+                                               const int numberOfDimensions,
+                                               const boost::uint64_t seed );
+
+//! Convert uniform samples to standard normal samples.
+/*!
+ * Converts samples in the open unit hypercube (e.g. Latin hypercube or Sobol samples) to samples
+ * of independent standard normal random numbers, using the inverse of the standard normal
+ * cumulative distribution function.
+ * \param uniformSamples Samples in the open unit hypercube, stored as columns.
+ * \return Standard normal samples, stored as columns.
+ */
+Eigen::MatrixXd convertUniformToStandardNormalSamples( const Eigen::MatrixXd& uniformSamples );
+
+//! Sobol sequence generator class.
+/*!
+ * Generator of the Sobol low-discrepancy sequence in the unit hypercube, using the direction
+ * numbers of Joe & Kuo (2008). Points are computed directly from their index (Antonov & Saleev,
+ * 1979), so that any range of points can be generated independently, e.g. on different threads.
+ * The first point (index 0) is the origin, which is commonly skipped.
+ */
+class SobolSequenceGenerator
+{
+public:
+
+    //! Maximum number of dimensions for which direction numbers are available.
+    static const int maximumNumberOfDimensions = 16;
+
+    //! Constructor.
+    /*!
+     * Constructor, computes direction numbers of all dimensions.
+     * \param numberOfDimensions Number of dimensions, at most maximumNumberOfDimensions.
+     */
+    SobolSequenceGenerator( const int numberOfDimensions );
+
+    //! Get point.
+    /*!
+     * Returns point of sequence with given index.
+     * \param pointIndex Index of point; must be smaller than 2^32.
+     * \return Point in half-open unit hypercube [0, 1).
+     */
+    Eigen::VectorXd getPoint( const boost::uint64_t pointIndex ) const;
+
+    //! Get points.
+    /*!
+     * Returns range of consecutive points of sequence.
+     * \param firstPointIndex Index of first point.
+     * \param numberOfPoints Number of points.
+     * \return Points, stored as columns.
+     */
+    Eigen::MatrixXd getPoints( const boost::uint64_t firstPointIndex,
+                               const int numberOfPoints ) const;
+
+    //! Get number of dimensions.
+    /*!
+     * Returns number of dimensions.
+     * \return Number of dimensions.
+     */
+    int getNumberOfDimensions( ) const { return numberOfDimensions_; }
+
+protected:
+
+private:
+
+    //! Number of dimensions.
+    int numberOfDimensions_;
+
+    //! Direction numbers of each dimension, scaled to 32 bits.
+    std::vector< std::vector< boost::uint32_t > > directionNumbers_;
+};
+
+//! Typedef for shared-pointer to SobolSequenceGenerator.
+typedef boost::shared_ptr< SobolSequenceGenerator > SobolSequenceGeneratorPointer;
+
+} // namespace statistics
+} // namespace tudat
+
+#endif // TUDAT_MONTE_CARLO_SAMPLING_H
@@ -0,0 +1,137 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Generate uniform numbers from 52 random bits.
+ *
+ *    References
+ *      Salmon, J.K., Moraes, M.A., Dror, R.O., Shaw, D.E. Parallel Random Numbers: As Easy as
+ *          1, 2, 3. Proceedings of the International Conference for High Performance Computing,
+ *          Networking, Storage and Analysis (SC11), 2011.
+ *
+ *    Notes
+ *
+ */
+
+#include <cmath>
+
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+
+#include "Tudat/Mathematics/Statistics/randomNumberStreams.h"
+
+namespace tudat
+{
+namespace statistics
+{
+
+//! Compute Philox4x32-10 block.
+PhiloxCounter computePhilox4x32Block( const PhiloxCounter& counter, const PhiloxKey& key )
+{
+    // Set multipliers and Weyl sequence increments of key (Salmon et al., 2011).
+    const boost::uint64_t firstMultiplier = 0xD2511F53;
+    const boost::uint64_t secondMultiplier = 0xCD9E8D57;
+    const boost::uint32_t firstKeyIncrement = 0x9E3779B9;
+    const boost::uint32_t secondKeyIncrement = 0xBB67AE85;
+
+    PhiloxCounter block = counter;
+    PhiloxKey roundKey = key;
+    for ( int round = 0; round < 10; round++ )
+    {
+        const boost::uint64_t firstProduct = firstMultiplier * block[ 0 ];
+        const boost::uint64_t secondProduct = secondMultiplier * block[ 2 ];
+
+        block[ 0 ] = static_cast< boost::uint32_t >( secondProduct >> 32 ) ^ block[ 1 ]
+                ^ roundKey[ 0 ];
+        block[ 1 ] = static_cast< boost::uint32_t >( secondProduct );
+        block[ 2 ] = static_cast< boost::uint32_t >( firstProduct >> 32 ) ^ block[ 3 ]
+                ^ roundKey[ 1 ];
+        block[ 3 ] = static_cast< boost::uint32_t >( firstProduct );
+
+        roundKey[ 0 ] += firstKeyIncrement;
+        roundKey[ 1 ] += secondKeyIncrement;
+    }
+
+    return block;
+}
+
+//! Constructor.
+RandomNumberStream::RandomNumberStream( const boost::uint64_t seed,
+                                        const boost::uint64_t streamIndex )
+    : seed_( seed ),
+      streamIndex_( streamIndex ),
+      blockIndex_( 0 ),
+      blockPosition_( 4 ),
+      isCachedStandardNormalAvailable_( false ),
+      cachedStandardNormal_( 0.0 )
+{
+    key_[ 0 ] = static_cast< boost::uint32_t >( seed );
+    key_[ 1 ] = static_cast< boost::uint32_t >( seed >> 32 );
+}
+
+//! Generate uniform random number.
+double RandomNumberStream::generateUniform( )
+{
+    // Combine two random integers, keep the upper 52 bits, and offset by half a unit of the last
+    // bit, such that neither 0 nor 1 is returned. The result, ( k + 0.5 ) / 2^52 with k < 2^52,
+    // is exactly representable.
+    const boost::uint64_t upperBits = operator( )( );
+    const boost::uint64_t randomBits = ( upperBits << 32 ) | operator( )( );
+    return ( static_cast< double >( randomBits >> 12 ) + 0.5 ) / 4503599627370496.0;
+}
+
+//! Generate standard normal random number.
+double RandomNumberStream::generateStandardNormal( )
+{
+    if ( isCachedStandardNormalAvailable_ )
+    {
+        isCachedStandardNormalAvailable_ = false;
+        return cachedStandardNormal_;
+    }
+
+    const double radius = std::sqrt( -2.0 * std::log( generateUniform( ) ) );
+    const double angle = 2.0 * mathematical_constants::PI * generateUniform( );
+
+    cachedStandardNormal_ = radius * std::sin( angle );
+    isCachedStandardNormalAvailable_ = true;
+    return radius * std::cos( angle );
+}
+
+//! Generate next block of random integers.
+void RandomNumberStream::generateNextBlock( )
+{
+    PhiloxCounter counter;
+    counter[ 0 ] = static_cast< boost::uint32_t >( blockIndex_ );
+    counter[ 1 ] = static_cast< boost::uint32_t >( blockIndex_ >> 32 );
+    counter[ 2 ] = static_cast< boost::uint32_t >( streamIndex_ );
+    counter[ 3 ] = static_cast< boost::uint32_t >( streamIndex_ >> 32 );
+
+    currentBlock_ = computePhilox4x32Block( counter, key_ );
+    blockIndex_++;
+    blockPosition_ = 0;
+}
+
+} // namespace statistics
+} // namespace tudat
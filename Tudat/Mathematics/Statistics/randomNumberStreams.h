@@ -0,0 +1,201 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *      261018                      Generate uniform numbers from 52 random bits.
+ *
+ *    References
+ *      Salmon, J.K., Moraes, M.A., Dror, R.O., Shaw, D.E. Parallel Random Numbers: As Easy as
+ *          1, 2, 3. Proceedings of the International Conference for High Performance Computing,
+ *          Networking, Storage and Analysis (SC11), 2011.
+ *      Box, G.E.P., Muller, M.E. A Note on the Generation of Random Normal Deviates. The Annals
+ *          of Mathematical Statistics, 29(2), 610-611, 1958.
+ *
+ *    Notes
+ *      The global random number generator in basicMathematicsFunctions.h is a single, stateful
+ *      generator, which cannot be shared between threads. The counter-based generator in this
+ *      file has no state other than its key (seed) and counter, so that an independent stream
+ *      can be created for each sample of a Monte Carlo analysis, from the seed and the index of
+ *      the sample only. The random numbers used for a given sample are then independent of the
+ *      thread on which, or the order in which, the samples are generated.
+ *
+ */
+
+#ifndef TUDAT_RANDOM_NUMBER_STREAMS_H
+#define TUDAT_RANDOM_NUMBER_STREAMS_H
+
+#include <boost/array.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace tudat
+{
+namespace statistics
+{
+
+//! Typedef for counter (and output block) of Philox4x32 generator.
+typedef boost::array< boost::uint32_t, 4 > PhiloxCounter;
+
+//! Typedef for key of Philox4x32 generator.
+typedef boost::array< boost::uint32_t, 2 > PhiloxKey;
+
+//! Compute Philox4x32-10 block.
+/*!
+ * Computes output block of the Philox4x32-10 counter-based random number generator (Salmon et
+ * al., 2011), which is a bijection of the 128-bit counter, parameterized by the 64-bit key.
+ * Consecutive counters yield statistically independent output blocks (the generator passes the
+ * BigCrush test suite), such that random numbers can be generated for any counter in O(1) time.
+ * \param counter Counter.
+ * \param key Key.
+ * \return Block of four 32-bit random numbers.
+ */
+PhiloxCounter computePhilox4x32Block( const PhiloxCounter& counter, const PhiloxKey& key );
+
+//! Random number stream class.
+/*!
+ * Stream of random numbers, generated by the Philox4x32-10 counter-based generator. The key of
+ * the generator is set by the seed, and the upper half of the counter by the index of the
+ * stream, such that each combination of seed and stream index yields an independent stream of
+ * 2^66 random numbers. In a Monte Carlo analysis, the index of the sample is used as stream
+ * index, so that the random numbers of each sample are reproducible, regardless of the number
+ * of threads used. The class satisfies the Boost/C++11 uniform random number generator
+ * interface, so that it can also be used with the Boost random distributions.
+ */
+class RandomNumberStream
+{
+public:
+
+    //! Typedef for type of random integers.
+    typedef boost::uint32_t result_type;
+
+    //! Constructor.
+    /*!
+     * Constructor, sets seed and index of stream.
+     * \param seed Seed of random number generator (default 0).
+     * \param streamIndex Index of stream, e.g. the index of a Monte Carlo sample (default 0).
+     */
+    RandomNumberStream( const boost::uint64_t seed = 0, const boost::uint64_t streamIndex = 0 );
+
+    //! Generate random integer.
+    /*!
+     * Generates uniformly distributed random 32-bit integer.
+     * \return Random integer.
+     */
+    result_type operator( )( )
+    {
+        if ( blockPosition_ == 4 )
+        {
+            generateNextBlock( );
+        }
+        return currentBlock_[ blockPosition_++ ];
+    }
+
+    //! Generate uniform random number.
+    /*!
+     * Generates uniformly distributed random number in the open interval (0, 1), with 52 random
+     * bits, as \f$ ( k + 0.5 ) / 2^{52} \f$, with \f$ k \f$ a random 52-bit integer.
+     * \return Uniform random number.
+     */
+    double generateUniform( );
+
+    //! Generate standard normal random number.
+    /*!
+     * Generates random number from standard normal distribution, using the Box-Muller transform
+     * (Box & Muller, 1958). Both numbers of each generated pair are used.
+     * \return Standard normal random number.
+     */
+    double generateStandardNormal( );
+
+    //! Get seed.
+    /*!
+     * Returns seed of random number generator.
+     * \return Seed.
+     */
+    boost::uint64_t getSeed( ) const { return seed_; }
+
+    //! Get stream index.
+    /*!
+     * Returns index of stream.
+     * \return Stream index.
+     */
+    boost::uint64_t getStreamIndex( ) const { return streamIndex_; }
+
+    //! Get minimum value of random integers.
+    /*!
+     * Returns minimum value of random integers generated by operator( ).
+     * \return Minimum value.
+     */
+    static result_type min( ) { return 0; }
+
+    //! Get maximum value of random integers.
+    /*!
+     * Returns maximum value of random integers generated by operator( ).
+     * \return Maximum value.
+     */
+    static result_type max( ) { return 0xFFFFFFFF; }
+
+protected:
+
+private:
+
+    //! Generate next block of random integers.
+    /*!
+     * Increments block counter and computes the corresponding block of random integers.
+     */
+    void generateNextBlock( );
+
+    //! Seed of random number generator.
+    boost::uint64_t seed_;
+
+    //! Index of stream.
+    boost::uint64_t streamIndex_;
+
+    //! Key of Philox generator, set by seed.
+    PhiloxKey key_;
+
+    //! Index of next block in stream.
+    boost::uint64_t blockIndex_;
+
+    //! Current block of random integers.
+    PhiloxCounter currentBlock_;
+
+    //! Position of next random integer in current block.
+    int blockPosition_;
+
+    //! Boolean denoting whether a cached standard normal random number is available.
+    bool isCachedStandardNormalAvailable_;
+
+    //! Cached standard normal random number (second number of Box-Muller pair).
+    double cachedStandardNormal_;
+};
+
+//! Typedef for shared-pointer to RandomNumberStream.
+typedef boost::shared_ptr< RandomNumberStream > RandomNumberStreamPointer;
+
+} // namespace statistics
+} // namespace tudat
+
+#endif // TUDAT_RANDOM_NUMBER_STREAMS_H
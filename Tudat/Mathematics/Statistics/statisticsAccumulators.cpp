@@ -0,0 +1,386 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *
+ *    References
+ *      Welford, B.P. Note on a Method for Calculating Corrected Sums of Squares and Products.
+ *          Technometrics, 4(3), 419-420, 1962.
+ *      Chan, T.F., Golub, G.H., LeVeque, R.J. Updating Formulae and a Pairwise Algorithm for
+ *          Computing Sample Variances. Technical Report STAN-CS-79-773, Stanford University,
+ *          1979.
+ *      Pebay, P. Formulas for Robust, One-Pass Parallel Computation of Covariances and
+ *          Arbitrary-Order Statistical Moments. Sandia Report SAND2008-6212, 2008.
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+#include <boost/exception/all.hpp>
+
+#include "Tudat/Mathematics/Statistics/statisticsAccumulators.h"
+
+namespace tudat
+{
+namespace statistics
+{
+
+//! Default constructor.
+ScalarStatisticsAccumulator::ScalarStatisticsAccumulator( )
+    : numberOfSamples_( 0 ),
+      mean_( 0.0 ),
+      sumOfSquaredDeviations_( 0.0 ),
+      sumOfCubedDeviations_( 0.0 ),
+      sumOfFourthPowerDeviations_( 0.0 ),
+      minimum_( std::numeric_limits< double >::infinity( ) ),
+      maximum_( -std::numeric_limits< double >::infinity( ) )
+{ }
+
+//! Constructor from accumulated state.
+ScalarStatisticsAccumulator::ScalarStatisticsAccumulator(
+        const unsigned int numberOfSamples, const double mean,
+        const double sumOfSquaredDeviations, const double sumOfCubedDeviations,
+        const double sumOfFourthPowerDeviations, const double minimum, const double maximum )
+    : numberOfSamples_( numberOfSamples ),
+      mean_( mean ),
+      sumOfSquaredDeviations_( sumOfSquaredDeviations ),
+      sumOfCubedDeviations_( sumOfCubedDeviations ),
+      sumOfFourthPowerDeviations_( sumOfFourthPowerDeviations ),
+      minimum_( minimum ),
+      maximum_( maximum )
+{ }
+
+//! Add sample.
+void ScalarStatisticsAccumulator::addSample( const double sample )
+{
+    const double previousNumberOfSamples = static_cast< double >( numberOfSamples_ );
+    numberOfSamples_++;
+    const double numberOfSamples = static_cast< double >( numberOfSamples_ );
+
+    // Update moments, highest order first, as these depend on the lower-order sums before the
+    // update (Pebay, 2008).
+    const double deviation = sample - mean_;
+    const double scaledDeviation = deviation / numberOfSamples;
+    const double squaredScaledDeviation = scaledDeviation * scaledDeviation;
+    const double secondOrderTerm = deviation * scaledDeviation * previousNumberOfSamples;
+
+    mean_ += scaledDeviation;
+    sumOfFourthPowerDeviations_ += secondOrderTerm * squaredScaledDeviation
+            * ( numberOfSamples * numberOfSamples - 3.0 * numberOfSamples + 3.0 )
+            + 6.0 * squaredScaledDeviation * sumOfSquaredDeviations_
+            - 4.0 * scaledDeviation * sumOfCubedDeviations_;
+    sumOfCubedDeviations_ += secondOrderTerm * scaledDeviation * ( numberOfSamples - 2.0 )
+            - 3.0 * scaledDeviation * sumOfSquaredDeviations_;
+    sumOfSquaredDeviations_ += secondOrderTerm;
+
+    minimum_ = std::min( minimum_, sample );
+    maximum_ = std::max( maximum_, sample );
+}
+
+//! Merge with other accumulator.
+void ScalarStatisticsAccumulator::merge( const ScalarStatisticsAccumulator& otherAccumulator )
+{
+    if ( otherAccumulator.numberOfSamples_ == 0 )
+    {
+        return;
+    }
+    else if ( numberOfSamples_ == 0 )
+    {
+        *this = otherAccumulator;
+        return;
+    }
+
+    const double firstNumberOfSamples = static_cast< double >( numberOfSamples_ );
+    const double secondNumberOfSamples = static_cast< double >( otherAccumulator.numberOfSamples_ );
+    const double numberOfSamples = firstNumberOfSamples + secondNumberOfSamples;
+
+    // Compute merged moments (Pebay, 2008), highest order first.
+    const double deviation = otherAccumulator.mean_ - mean_;
+    const double scaledDeviation = deviation / numberOfSamples;
+    const double squaredScaledDeviation = scaledDeviation * scaledDeviation;
+    const double productOfNumberOfSamples = firstNumberOfSamples * secondNumberOfSamples;
+
+    sumOfFourthPowerDeviations_ += otherAccumulator.sumOfFourthPowerDeviations_
+            + deviation * scaledDeviation * squaredScaledDeviation * productOfNumberOfSamples
+            * ( firstNumberOfSamples * firstNumberOfSamples - productOfNumberOfSamples
+                + secondNumberOfSamples * secondNumberOfSamples )
+            + 6.0 * squaredScaledDeviation
+            * ( firstNumberOfSamples * firstNumberOfSamples
+                * otherAccumulator.sumOfSquaredDeviations_
+                + secondNumberOfSamples * secondNumberOfSamples * sumOfSquaredDeviations_ )
+            + 4.0 * scaledDeviation
+            * ( firstNumberOfSamples * otherAccumulator.sumOfCubedDeviations_
+                - secondNumberOfSamples * sumOfCubedDeviations_ );
+    sumOfCubedDeviations_ += otherAccumulator.sumOfCubedDeviations_
+            + deviation * squaredScaledDeviation * productOfNumberOfSamples
+            * ( firstNumberOfSamples - secondNumberOfSamples )
+            + 3.0 * scaledDeviation
+            * ( firstNumberOfSamples * otherAccumulator.sumOfSquaredDeviations_
+                - secondNumberOfSamples * sumOfSquaredDeviations_ );
+    sumOfSquaredDeviations_ += otherAccumulator.sumOfSquaredDeviations_
+            + deviation * scaledDeviation * productOfNumberOfSamples;
+    mean_ += scaledDeviation * secondNumberOfSamples;
+
+    numberOfSamples_ += otherAccumulator.numberOfSamples_;
+    minimum_ = std::min( minimum_, otherAccumulator.minimum_ );
+    maximum_ = std::max( maximum_, otherAccumulator.maximum_ );
+}
+
+//! Get sample mean.
+double ScalarStatisticsAccumulator::getSampleMean( ) const
+{
+    checkNumberOfSamples( 1 );
+    return mean_;
+}
+
+//! Get sample variance.
+double ScalarStatisticsAccumulator::getSampleVariance( ) const
+{
+    checkNumberOfSamples( 2 );
+    return sumOfSquaredDeviations_ / ( static_cast< double >( numberOfSamples_ ) - 1.0 );
+}
+
+//! Get sample standard deviation.
+double ScalarStatisticsAccumulator::getSampleStandardDeviation( ) const
+{
+    return std::sqrt( getSampleVariance( ) );
+}
+
+//! Get skewness.
+double ScalarStatisticsAccumulator::getSkewness( ) const
+{
+    checkNumberOfSamples( 2 );
+    return std::sqrt( static_cast< double >( numberOfSamples_ ) ) * sumOfCubedDeviations_
+            / std::pow( sumOfSquaredDeviations_, 1.5 );
+}
+
+//! Get excess kurtosis.
+double ScalarStatisticsAccumulator::getExcessKurtosis( ) const
+{
+    checkNumberOfSamples( 2 );
+    return static_cast< double >( numberOfSamples_ ) * sumOfFourthPowerDeviations_
+            / ( sumOfSquaredDeviations_ * sumOfSquaredDeviations_ ) - 3.0;
+}
+
+//! Get minimum.
+double ScalarStatisticsAccumulator::getMinimum( ) const
+{
+    checkNumberOfSamples( 1 );
+    return minimum_;
+}
+
+//! Get maximum.
+double ScalarStatisticsAccumulator::getMaximum( ) const
+{
+    checkNumberOfSamples( 1 );
+    return maximum_;
+}
+
+//! Check if sufficient samples have been added.
+void ScalarStatisticsAccumulator::checkNumberOfSamples(
+        const unsigned int requiredNumberOfSamples ) const
+{
+    if ( numberOfSamples_ < requiredNumberOfSamples )
+    {
+        std::stringstream errorMessage;
+        errorMessage << "Error, statistics accumulator requires at least "
+                     << requiredNumberOfSamples << " samples, but has " << numberOfSamples_
+                     << "." << std::endl;
+        boost::throw_exception( boost::enable_error_info( std::runtime_error(
+                                                              errorMessage.str( ) ) ) );
+    }
+}
+
+//! Constructor.
+VectorStatisticsAccumulator::VectorStatisticsAccumulator( const int vectorSize )
+    : numberOfSamples_( 0 ),
+      mean_( Eigen::VectorXd::Zero( vectorSize ) ),
+      comomentMatrix_( Eigen::MatrixXd::Zero( vectorSize, vectorSize ) ),
+      minimum_( Eigen::VectorXd::Constant( vectorSize,
+                                           std::numeric_limits< double >::infinity( ) ) ),
+      maximum_( Eigen::VectorXd::Constant( vectorSize,
+                                           -std::numeric_limits< double >::infinity( ) ) ),
+      deviationBuffer_( vectorSize )
+{ }
+
+//! Constructor from accumulated state.
+VectorStatisticsAccumulator::VectorStatisticsAccumulator(
+        const unsigned int numberOfSamples, const Eigen::VectorXd& mean,
+        const Eigen::MatrixXd& comomentMatrix, const Eigen::VectorXd& minimum,
+        const Eigen::VectorXd& maximum )
+    : numberOfSamples_( numberOfSamples ),
+      mean_( mean ),
+      comomentMatrix_( comomentMatrix ),
+      minimum_( minimum ),
+      maximum_( maximum ),
+      deviationBuffer_( mean.rows( ) )
+{
+    if ( comomentMatrix_.rows( ) != mean_.rows( ) || comomentMatrix_.cols( ) != mean_.rows( ) ||
+         minimum_.rows( ) != mean_.rows( ) || maximum_.rows( ) != mean_.rows( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, inconsistent sizes of state of vector statistics "
+                            "accumulator." ) ) );
+    }
+}
+
+//! Add sample.
+void VectorStatisticsAccumulator::addSample( const Eigen::VectorXd& sample )
+{
+    if ( sample.rows( ) != mean_.rows( ) )
+    {
+        std::stringstream errorMessage;
+        errorMessage << "Error, vector statistics accumulator expected sample of size "
+                     << mean_.rows( ) << ", but received sample of size " << sample.rows( )
+                     << "." << std::endl;
+        boost::throw_exception( boost::enable_error_info( std::runtime_error(
+                                                              errorMessage.str( ) ) ) );
+    }
+
+    const double previousNumberOfSamples = static_cast< double >( numberOfSamples_ );
+    numberOfSamples_++;
+    const double numberOfSamples = static_cast< double >( numberOfSamples_ );
+
+    // Update mean and co-moment matrix (Welford, 1962). The deviation from the updated mean is
+    // ( N - 1 ) / N times the deviation from the previous mean.
+    deviationBuffer_ = sample - mean_;
+    mean_ += deviationBuffer_ / numberOfSamples;
+    comomentMatrix_.noalias( ) += ( previousNumberOfSamples / numberOfSamples )
+            * deviationBuffer_ * deviationBuffer_.transpose( );
+
+    minimum_ = minimum_.cwiseMin( sample );
+    maximum_ = maximum_.cwiseMax( sample );
+}
+
+//! Merge with other accumulator.
+void VectorStatisticsAccumulator::merge( const VectorStatisticsAccumulator& otherAccumulator )
+{
+    if ( otherAccumulator.mean_.rows( ) != mean_.rows( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, cannot merge vector statistics accumulators of different "
+                            "sizes." ) ) );
+    }
+
+    if ( otherAccumulator.numberOfSamples_ == 0 )
+    {
+        return;
+    }
+    else if ( numberOfSamples_ == 0 )
+    {
+        *this = otherAccumulator;
+        return;
+    }
+
+    const double firstNumberOfSamples = static_cast< double >( numberOfSamples_ );
+    const double secondNumberOfSamples = static_cast< double >( otherAccumulator.numberOfSamples_ );
+    const double numberOfSamples = firstNumberOfSamples + secondNumberOfSamples;
+
+    // Merge mean and co-moment matrix (Chan et al., 1979).
+    deviationBuffer_ = otherAccumulator.mean_ - mean_;
+    comomentMatrix_ += otherAccumulator.comomentMatrix_;
+    comomentMatrix_.noalias( ) += ( firstNumberOfSamples * secondNumberOfSamples / numberOfSamples )
+            * deviationBuffer_ * deviationBuffer_.transpose( );
+    mean_ += ( secondNumberOfSamples / numberOfSamples ) * deviationBuffer_;
+
+    numberOfSamples_ += otherAccumulator.numberOfSamples_;
+    minimum_ = minimum_.cwiseMin( otherAccumulator.minimum_ );
+    maximum_ = maximum_.cwiseMax( otherAccumulator.maximum_ );
+}
+
+//! Get sample mean.
+Eigen::VectorXd VectorStatisticsAccumulator::getSampleMean( ) const
+{
+    checkNumberOfSamples( 1 );
+    return mean_;
+}
+
+//! Get sample covariance matrix.
+Eigen::MatrixXd VectorStatisticsAccumulator::getSampleCovarianceMatrix( ) const
+{
+    checkNumberOfSamples( 2 );
+
+    // Symmetrize, to remove round-off differences between upper and lower triangle.
+    return ( comomentMatrix_ + comomentMatrix_.transpose( ) )
+            / ( 2.0 * ( static_cast< double >( numberOfSamples_ ) - 1.0 ) );
+}
+
+//! Get sample standard deviations.
+Eigen::VectorXd VectorStatisticsAccumulator::getSampleStandardDeviations( ) const
+{
+    return getSampleCovarianceMatrix( ).diagonal( ).cwiseSqrt( );
+}
+
+//! Get sample correlation matrix.
+Eigen::MatrixXd VectorStatisticsAccumulator::getSampleCorrelationMatrix( ) const
+{
+    const Eigen::VectorXd inverseStandardDeviations
+            = getSampleStandardDeviations( ).cwiseInverse( );
+    return inverseStandardDeviations.asDiagonal( ) * getSampleCovarianceMatrix( )
+            * inverseStandardDeviations.asDiagonal( );
+}
+
+//! Get minimum.
+Eigen::VectorXd VectorStatisticsAccumulator::getMinimum( ) const
+{
+    checkNumberOfSamples( 1 );
+    return minimum_;
+}
+
+//! Get maximum.
+Eigen::VectorXd VectorStatisticsAccumulator::getMaximum( ) const
+{
+    checkNumberOfSamples( 1 );
+    return maximum_;
+}
+
+//! Check if sufficient samples have been added.
+void VectorStatisticsAccumulator::checkNumberOfSamples(
+        const unsigned int requiredNumberOfSamples ) const
+{
+    if ( numberOfSamples_ < requiredNumberOfSamples )
+    {
+        std::stringstream errorMessage;
+        errorMessage << "Error, statistics accumulator requires at least "
+                     << requiredNumberOfSamples << " samples, but has " << numberOfSamples_
+                     << "." << std::endl;
+        boost::throw_exception( boost::enable_error_info( std::runtime_error(
+                                                              errorMessage.str( ) ) ) );
+    }
+}
+
+} // namespace statistics
+} // namespace tudat
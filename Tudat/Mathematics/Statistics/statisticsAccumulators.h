@@ -0,0 +1,423 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *
+ *    References
+ *      Welford, B.P. Note on a Method for Calculating Corrected Sums of Squares and Products.
+ *          Technometrics, 4(3), 419-420, 1962.
+ *      Chan, T.F., Golub, G.H., LeVeque, R.J. Updating Formulae and a Pairwise Algorithm for
+ *          Computing Sample Variances. Technical Report STAN-CS-79-773, Stanford University,
+ *          1979.
+ *      Pebay, P. Formulas for Robust, One-Pass Parallel Computation of Covariances and
+ *          Arbitrary-Order Statistical Moments. Sandia Report SAND2008-6212, 2008.
+ *
+ *    Notes
+ *      The accumulators store only a fixed number of sums, so that statistics of an arbitrary
+ *      number of samples (e.g., the results of a Monte Carlo analysis) can be computed in a single
+ *      pass without storing the samples. Floating-point addition is not associative, so the
+ *      result of merging accumulators depends (to round-off level) on the order in which they
+ *      are merged. Results that are independent of thread scheduling are obtained by letting each
+ *      thread (or process) fill its own accumulator, and merging them in a fixed order, for
+ *      instance with mergeStatisticsAccumulators( ).
+ *
+ */
+
+#ifndef TUDAT_STATISTICS_ACCUMULATORS_H
+#define TUDAT_STATISTICS_ACCUMULATORS_H
+
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+#include <Eigen/Core>
+
+namespace tudat
+{
+namespace statistics
+{
+
+//! Streaming accumulator for statistics of scalar samples.
+/*!
+ * Streaming accumulator for the statistics of scalar samples. Each sample updates the mean and
+ * the sums of the second, third and fourth powers of the deviations from the mean in O(1) time
+ * and memory, using the numerically stable recurrences of Welford (1962) and Pebay (2008).
+ * Accumulators filled with different subsets of the samples can be merged (Chan et al., 1979;
+ * Pebay, 2008), which allows the samples to be processed by different threads or processes.
+ */
+class ScalarStatisticsAccumulator
+{
+public:
+
+    //! Default constructor.
+    /*!
+     * Default constructor, creates accumulator without samples.
+     */
+    ScalarStatisticsAccumulator( );
+
+    //! Constructor from accumulated state.
+    /*!
+     * Constructor from accumulated state, as retrieved by the get functions of another
+     * accumulator (e.g., after transfer between processes).
+     * \param numberOfSamples Number of samples.
+     * \param mean Mean of samples.
+     * \param sumOfSquaredDeviations Sum of squared deviations from mean.
+     * \param sumOfCubedDeviations Sum of cubed deviations from mean.
+     * \param sumOfFourthPowerDeviations Sum of fourth powers of deviations from mean.
+     * \param minimum Minimum of samples.
+     * \param maximum Maximum of samples.
+     */
+    ScalarStatisticsAccumulator( const unsigned int numberOfSamples, const double mean,
+                                 const double sumOfSquaredDeviations,
+                                 const double sumOfCubedDeviations,
+                                 const double sumOfFourthPowerDeviations,
+                                 const double minimum, const double maximum );
+
+    //! Add sample.
+    /*!
+     * Adds a sample to the accumulator, updating all statistics in O(1) time.
+     * \param sample Sample value.
+     */
+    void addSample( const double sample );
+
+    //! Merge with other accumulator.
+    /*!
+     * Merges the statistics of another accumulator into this one, such that the result is that of
+     * the union of both sets of samples.
+     * \param otherAccumulator Accumulator to merge into this one.
+     */
+    void merge( const ScalarStatisticsAccumulator& otherAccumulator );
+
+    //! Get number of samples.
+    /*!
+     * Returns number of samples.
+     * \return Number of samples.
+     */
+    unsigned int getNumberOfSamples( ) const { return numberOfSamples_; }
+
+    //! Get sample mean.
+    /*!
+     * Returns sample mean; at least one sample is required.
+     * \return Sample mean.
+     */
+    double getSampleMean( ) const;
+
+    //! Get sample variance.
+    /*!
+     * Returns the unbiased estimate of the sample variance, as in computeSampleVariance( ); at
+     * least two samples are required.
+     * \return Sample variance.
+     */
+    double getSampleVariance( ) const;
+
+    //! Get sample standard deviation.
+    /*!
+     * Returns the square root of the unbiased estimate of the sample variance; at least two
+     * samples are required.
+     * \return Sample standard deviation.
+     */
+    double getSampleStandardDeviation( ) const;
+
+    //! Get skewness.
+    /*!
+     * Returns the (biased) sample skewness \f$ g_{1} = \sqrt{N} M_{3} / M_{2}^{3/2} \f$, where
+     * \f$ M_{k} \f$ is the sum of the k-th powers of the deviations from the mean; at least two
+     * samples are required.
+     * \return Sample skewness.
+     */
+    double getSkewness( ) const;
+
+    //! Get excess kurtosis.
+    /*!
+     * Returns the (biased) sample excess kurtosis \f$ g_{2} = N M_{4} / M_{2}^{2} - 3 \f$, where
+     * \f$ M_{k} \f$ is the sum of the k-th powers of the deviations from the mean; at least two
+     * samples are required.
+     * \return Sample excess kurtosis.
+     */
+    double getExcessKurtosis( ) const;
+
+    //! Get minimum.
+    /*!
+     * Returns minimum of samples; at least one sample is required.
+     * \return Minimum of samples.
+     */
+    double getMinimum( ) const;
+
+    //! Get maximum.
+    /*!
+     * Returns maximum of samples; at least one sample is required.
+     * \return Maximum of samples.
+     */
+    double getMaximum( ) const;
+
+    //! Get sum of squared deviations from mean.
+    /*!
+     * Returns sum of squared deviations from mean.
+     * \return Sum of squared deviations from mean.
+     */
+    double getSumOfSquaredDeviations( ) const { return sumOfSquaredDeviations_; }
+
+    //! Get sum of cubed deviations from mean.
+    /*!
+     * Returns sum of cubed deviations from mean.
+     * \return Sum of cubed deviations from mean.
+     */
+    double getSumOfCubedDeviations( ) const { return sumOfCubedDeviations_; }
+
+    //! Get sum of fourth powers of deviations from mean.
+    /*!
+     * Returns sum of fourth powers of deviations from mean.
+     * \return Sum of fourth powers of deviations from mean.
+     */
+    double getSumOfFourthPowerDeviations( ) const { return sumOfFourthPowerDeviations_; }
+
+protected:
+
+private:
+
+    //! Check if sufficient samples have been added.
+    /*!
+     * Checks if sufficient samples have been added to compute a statistic, and throws an
+     * exception otherwise.
+     * \param requiredNumberOfSamples Required number of samples.
+     */
+    void checkNumberOfSamples( const unsigned int requiredNumberOfSamples ) const;
+
+    //! Number of samples.
+    unsigned int numberOfSamples_;
+
+    //! Mean of samples.
+    double mean_;
+
+    //! Sum of squared deviations from mean.
+    double sumOfSquaredDeviations_;
+
+    //! Sum of cubed deviations from mean.
+    double sumOfCubedDeviations_;
+
+    //! Sum of fourth powers of deviations from mean.
+    double sumOfFourthPowerDeviations_;
+
+    //! Minimum of samples.
+    double minimum_;
+
+    //! Maximum of samples.
+    double maximum_;
+};
+
+//! Typedef for shared-pointer to ScalarStatisticsAccumulator.
+typedef boost::shared_ptr< ScalarStatisticsAccumulator > ScalarStatisticsAccumulatorPointer;
+
+//! Streaming accumulator for statistics of vector samples.
+/*!
+ * Streaming accumulator for the statistics of vector samples (e.g., the final states of a Monte
+ * Carlo analysis). Each sample updates the mean, the co-moment matrix (sum of outer products of
+ * the deviations from the mean) and the component-wise minimum and maximum in O(1) time (w.r.t.
+ * the number of samples), without allocating memory. Accumulators filled with different subsets
+ * of the samples can be merged (Chan et al., 1979).
+ */
+class VectorStatisticsAccumulator
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, creates accumulator without samples for vectors of given size.
+     * \param vectorSize Size of sample vectors.
+     */
+    VectorStatisticsAccumulator( const int vectorSize );
+
+    //! Constructor from accumulated state.
+    /*!
+     * Constructor from accumulated state, as retrieved by the get functions of another
+     * accumulator (e.g., after transfer between processes).
+     * \param numberOfSamples Number of samples.
+     * \param mean Mean of samples.
+     * \param comomentMatrix Sum of outer products of deviations from mean.
+     * \param minimum Component-wise minimum of samples.
+     * \param maximum Component-wise maximum of samples.
+     */
+    VectorStatisticsAccumulator( const unsigned int numberOfSamples, const Eigen::VectorXd& mean,
+                                 const Eigen::MatrixXd& comomentMatrix,
+                                 const Eigen::VectorXd& minimum,
+                                 const Eigen::VectorXd& maximum );
+
+    //! Add sample.
+    /*!
+     * Adds a sample to the accumulator, updating all statistics.
+     * \param sample Sample vector, of which the size must be equal to that given to the
+     *          constructor.
+     */
+    void addSample( const Eigen::VectorXd& sample );
+
+    //! Merge with other accumulator.
+    /*!
+     * Merges the statistics of another accumulator into this one, such that the result is that of
+     * the union of both sets of samples.
+     * \param otherAccumulator Accumulator to merge into this one.
+     */
+    void merge( const VectorStatisticsAccumulator& otherAccumulator );
+
+    //! Get size of sample vectors.
+    /*!
+     * Returns size of sample vectors.
+     * \return Size of sample vectors.
+     */
+    int getVectorSize( ) const { return mean_.rows( ); }
+
+    //! Get number of samples.
+    /*!
+     * Returns number of samples.
+     * \return Number of samples.
+     */
+    unsigned int getNumberOfSamples( ) const { return numberOfSamples_; }
+
+    //! Get sample mean.
+    /*!
+     * Returns sample mean; at least one sample is required.
+     * \return Sample mean.
+     */
+    Eigen::VectorXd getSampleMean( ) const;
+
+    //! Get sample covariance matrix.
+    /*!
+     * Returns the unbiased estimate of the sample covariance matrix; at least two samples are
+     * required.
+     * \return Sample covariance matrix.
+     */
+    Eigen::MatrixXd getSampleCovarianceMatrix( ) const;
+
+    //! Get sample standard deviations.
+    /*!
+     * Returns the square roots of the diagonal of the sample covariance matrix; at least two
+     * samples are required.
+     * \return Sample standard deviations of all components.
+     */
+    Eigen::VectorXd getSampleStandardDeviations( ) const;
+
+    //! Get sample correlation matrix.
+    /*!
+     * Returns sample correlation matrix; at least two samples are required.
+     * \return Sample correlation matrix.
+     */
+    Eigen::MatrixXd getSampleCorrelationMatrix( ) const;
+
+    //! Get minimum.
+    /*!
+     * Returns component-wise minimum of samples; at least one sample is required.
+     * \return Component-wise minimum of samples.
+     */
+    Eigen::VectorXd getMinimum( ) const;
+
+    //! Get maximum.
+    /*!
+     * Returns component-wise maximum of samples; at least one sample is required.
+     * \return Component-wise maximum of samples.
+     */
+    Eigen::VectorXd getMaximum( ) const;
+
+    //! Get co-moment matrix.
+    /*!
+     * Returns sum of outer products of deviations from mean.
+     * \return Co-moment matrix.
+     */
+    const Eigen::MatrixXd& getComomentMatrix( ) const { return comomentMatrix_; }
+
+protected:
+
+private:
+
+    //! Check if sufficient samples have been added.
+    /*!
+     * Checks if sufficient samples have been added to compute a statistic, and throws an
+     * exception otherwise.
+     * \param requiredNumberOfSamples Required number of samples.
+     */
+    void checkNumberOfSamples( const unsigned int requiredNumberOfSamples ) const;
+
+    //! Number of samples.
+    unsigned int numberOfSamples_;
+
+    //! Mean of samples.
+    Eigen::VectorXd mean_;
+
+    //! Sum of outer products of deviations from mean.
+    Eigen::MatrixXd comomentMatrix_;
+
+    //! Component-wise minimum of samples.
+    Eigen::VectorXd minimum_;
+
+    //! Component-wise maximum of samples.
+    Eigen::VectorXd maximum_;
+
+    //! Buffer for deviation of sample from mean before update.
+    Eigen::VectorXd deviationBuffer_;
+};
+
+//! Typedef for shared-pointer to VectorStatisticsAccumulator.
+typedef boost::shared_ptr< VectorStatisticsAccumulator > VectorStatisticsAccumulatorPointer;
+
+//! Merge statistics accumulators in fixed order.
+/*!
+ * Merges a list of statistics accumulators (e.g., one per thread) by pairwise merging of
+ * neighbouring entries, until a single accumulator remains. The order of the merge operations
+ * only depends on the number of accumulators, so that the result is reproducible, and the
+ * pairwise scheme limits the growth of round-off errors (Chan et al., 1979).
+ * \tparam AccumulatorType Type of accumulator, ScalarStatisticsAccumulator or
+ *          VectorStatisticsAccumulator.
+ * \param accumulators Accumulators to merge; must not be empty.
+ * \return Merged accumulator.
+ */
+template< typename AccumulatorType >
+AccumulatorType mergeStatisticsAccumulators( std::vector< AccumulatorType > accumulators )
+{
+    while ( accumulators.size( ) > 1 )
+    {
+        // Merge neighbouring pairs; an unpaired last entry is carried over to the next level.
+        const unsigned int numberOfMergedAccumulators = ( accumulators.size( ) + 1 ) / 2;
+        for ( unsigned int i = 0; i < numberOfMergedAccumulators; i++ )
+        {
+            if ( 2 * i + 1 < accumulators.size( ) )
+            {
+                accumulators[ 2 * i ].merge( accumulators[ 2 * i + 1 ] );
+            }
+
+            if ( i > 0 )
+            {
+                accumulators[ i ] = accumulators[ 2 * i ];
+            }
+        }
+        accumulators.erase( accumulators.begin( ) + numberOfMergedAccumulators,
+                            accumulators.end( ) );
+    }
+
+    return accumulators.at( 0 );
+}
+
+} // namespace statistics
+} // namespace tudat
+
+#endif // TUDAT_STATISTICS_ACCUMULATORS_H
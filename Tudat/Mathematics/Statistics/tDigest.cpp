@@ -0,0 +1,335 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *
+ *    References
+ *      Dunning, T., Ertl, O. Computing Extremely Accurate Quantiles Using t-Digests.
+ *          arXiv:1902.04023, 2019.
+ *
+ *    Notes
+ *
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include <boost/exception/all.hpp>
+
+#include "Tudat/InputOutput/binaryInputOutput.h"
+#include "Tudat/Mathematics/BasicMathematics/mathematicalConstants.h"
+#include "Tudat/Mathematics/Statistics/tDigest.h"
+
+namespace tudat
+{
+namespace statistics
+{
+
+//! Constructor.
+TDigest::TDigest( const double compression )
+    : compression_( compression ),
+      bufferSize_( static_cast< unsigned int >( 5.0 * compression ) ),
+      totalWeight_( 0.0 ),
+      minimum_( std::numeric_limits< double >::infinity( ) ),
+      maximum_( -std::numeric_limits< double >::infinity( ) )
+{
+    if ( !( compression_ >= 10.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error(
+                            "Error, compression parameter of t-digest must be at least 10." ) ) );
+    }
+}
+
+//! Constructor from binary stream.
+TDigest::TDigest( std::istream& stream )
+{
+    compression_ = input_output::readValueFromBinaryStream< double >( stream );
+    totalWeight_ = input_output::readValueFromBinaryStream< double >( stream );
+    minimum_ = input_output::readValueFromBinaryStream< double >( stream );
+    maximum_ = input_output::readValueFromBinaryStream< double >( stream );
+    centroidMeans_ = input_output::readVectorFromBinaryStream< double >( stream );
+    centroidWeights_ = input_output::readVectorFromBinaryStream< double >( stream );
+
+    if ( !( compression_ >= 10.0 ) || centroidMeans_.size( ) != centroidWeights_.size( ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error, t-digest read from stream is invalid." ) ) );
+    }
+    bufferSize_ = static_cast< unsigned int >( 5.0 * compression_ );
+}
+
+//! Add sample.
+void TDigest::addSample( const double sample, const double weight )
+{
+    if ( sample != sample )
+    {
+        return;
+    }
+
+    if ( !( weight > 0.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error, weight of t-digest sample must be "
+                                            "positive." ) ) );
+    }
+
+    unmergedMeans_.push_back( sample );
+    unmergedWeights_.push_back( weight );
+    totalWeight_ += weight;
+    minimum_ = std::min( minimum_, sample );
+    maximum_ = std::max( maximum_, sample );
+
+    if ( unmergedMeans_.size( ) >= bufferSize_ )
+    {
+        compress( );
+    }
+}
+
+//! Merge with other t-digest.
+void TDigest::merge( const TDigest& otherDigest )
+{
+    if ( otherDigest.totalWeight_ == 0.0 )
+    {
+        return;
+    }
+
+    // Copy centroids and unmerged samples of other t-digest first, in case it is this one.
+    std::vector< double > otherMeans = otherDigest.centroidMeans_;
+    otherMeans.insert( otherMeans.end( ), otherDigest.unmergedMeans_.begin( ),
+                       otherDigest.unmergedMeans_.end( ) );
+    std::vector< double > otherWeights = otherDigest.centroidWeights_;
+    otherWeights.insert( otherWeights.end( ), otherDigest.unmergedWeights_.begin( ),
+                         otherDigest.unmergedWeights_.end( ) );
+
+    unmergedMeans_.insert( unmergedMeans_.end( ), otherMeans.begin( ), otherMeans.end( ) );
+    unmergedWeights_.insert( unmergedWeights_.end( ), otherWeights.begin( ),
+                             otherWeights.end( ) );
+    totalWeight_ += otherDigest.totalWeight_;
+    minimum_ = std::min( minimum_, otherDigest.minimum_ );
+    maximum_ = std::max( maximum_, otherDigest.maximum_ );
+
+    compress( );
+}
+
+//! Get quantile.
+double TDigest::getQuantile( const double quantile )
+{
+    checkNonEmpty( );
+    if ( !( quantile >= 0.0 && quantile <= 1.0 ) )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error, quantile must be between 0 and 1." ) ) );
+    }
+
+    compress( );
+
+    // Interpolate linearly between (cumulative weight, value) knots, located at the minimum, the
+    // center of each centroid and the maximum.
+    const double targetWeight = quantile * totalWeight_;
+    double previousKnotWeight = 0.0;
+    double previousKnotValue = minimum_;
+    double weightSoFar = 0.0;
+    for ( unsigned int i = 0; i <= centroidMeans_.size( ); i++ )
+    {
+        double knotWeight = totalWeight_;
+        double knotValue = maximum_;
+        if ( i < centroidMeans_.size( ) )
+        {
+            knotWeight = weightSoFar + 0.5 * centroidWeights_[ i ];
+            knotValue = centroidMeans_[ i ];
+            weightSoFar += centroidWeights_[ i ];
+        }
+
+        if ( targetWeight <= knotWeight )
+        {
+            if ( knotWeight <= previousKnotWeight )
+            {
+                return knotValue;
+            }
+            return previousKnotValue + ( knotValue - previousKnotValue )
+                    * ( targetWeight - previousKnotWeight ) / ( knotWeight - previousKnotWeight );
+        }
+
+        previousKnotWeight = knotWeight;
+        previousKnotValue = knotValue;
+    }
+
+    return maximum_;
+}
+
+//! Get cumulative distribution function value.
+double TDigest::getCumulativeDistributionValue( const double value )
+{
+    checkNonEmpty( );
+    if ( value < minimum_ )
+    {
+        return 0.0;
+    }
+    else if ( value >= maximum_ )
+    {
+        return 1.0;
+    }
+
+    compress( );
+
+    // Invert interpolation of getQuantile( ).
+    double previousKnotWeight = 0.0;
+    double previousKnotValue = minimum_;
+    double weightSoFar = 0.0;
+    for ( unsigned int i = 0; i <= centroidMeans_.size( ); i++ )
+    {
+        double knotWeight = totalWeight_;
+        double knotValue = maximum_;
+        if ( i < centroidMeans_.size( ) )
+        {
+            knotWeight = weightSoFar + 0.5 * centroidWeights_[ i ];
+            knotValue = centroidMeans_[ i ];
+            weightSoFar += centroidWeights_[ i ];
+        }
+
+        if ( value < knotValue )
+        {
+            return ( previousKnotWeight + ( knotWeight - previousKnotWeight )
+                     * ( value - previousKnotValue ) / ( knotValue - previousKnotValue ) )
+                    / totalWeight_;
+        }
+
+        previousKnotWeight = knotWeight;
+        previousKnotValue = knotValue;
+    }
+
+    return 1.0;
+}
+
+//! Write to binary stream.
+void TDigest::writeToBinaryStream( std::ostream& stream )
+{
+    compress( );
+
+    input_output::writeValueToBinaryStream( stream, compression_ );
+    input_output::writeValueToBinaryStream( stream, totalWeight_ );
+    input_output::writeValueToBinaryStream( stream, minimum_ );
+    input_output::writeValueToBinaryStream( stream, maximum_ );
+    input_output::writeVectorToBinaryStream( stream, centroidMeans_ );
+    input_output::writeVectorToBinaryStream( stream, centroidWeights_ );
+}
+
+//! Get number of centroids.
+int TDigest::getNumberOfCentroids( )
+{
+    compress( );
+    return static_cast< int >( centroidMeans_.size( ) );
+}
+
+//! Merge unmerged samples with centroids.
+void TDigest::compress( )
+{
+    if ( unmergedMeans_.empty( ) )
+    {
+        return;
+    }
+
+    // Collect and sort centroids and unmerged samples.
+    std::vector< std::pair< double, double > > sortedCentroids;
+    sortedCentroids.reserve( centroidMeans_.size( ) + unmergedMeans_.size( ) );
+    for ( unsigned int i = 0; i < centroidMeans_.size( ); i++ )
+    {
+        sortedCentroids.push_back( std::make_pair( centroidMeans_[ i ], centroidWeights_[ i ] ) );
+    }
+    for ( unsigned int i = 0; i < unmergedMeans_.size( ); i++ )
+    {
+        sortedCentroids.push_back( std::make_pair( unmergedMeans_[ i ], unmergedWeights_[ i ] ) );
+    }
+    std::sort( sortedCentroids.begin( ), sortedCentroids.end( ) );
+
+    centroidMeans_.clear( );
+    centroidWeights_.clear( );
+    unmergedMeans_.clear( );
+    unmergedWeights_.clear( );
+
+    // Merge neighbouring centroids, as long as the merged centroid spans at most one unit of the
+    // scale function k( q ) = delta / ( 2 pi ) asin( 2q - 1 ).
+    const double scaleFunctionNormalization = compression_ / ( 2.0 * mathematical_constants::PI );
+    const double maximumScaleFunctionValue
+            = 0.5 * mathematical_constants::PI * scaleFunctionNormalization;
+
+    double weightSoFar = 0.0;
+    double currentMean = sortedCentroids[ 0 ].first;
+    double currentWeight = sortedCentroids[ 0 ].second;
+    double weightLimit = totalWeight_ * 0.5 * ( std::sin(
+                ( -maximumScaleFunctionValue + 1.0 ) / scaleFunctionNormalization ) + 1.0 );
+    for ( unsigned int i = 1; i < sortedCentroids.size( ); i++ )
+    {
+        const double proposedWeight = currentWeight + sortedCentroids[ i ].second;
+        if ( weightSoFar + proposedWeight <= weightLimit )
+        {
+            currentWeight = proposedWeight;
+            currentMean += ( sortedCentroids[ i ].first - currentMean )
+                    * sortedCentroids[ i ].second / currentWeight;
+        }
+        else
+        {
+            weightSoFar += currentWeight;
+            centroidMeans_.push_back( currentMean );
+            centroidWeights_.push_back( currentWeight );
+
+            // Determine weight limit of next centroid.
+            const double nextScaleFunctionValue = std::min(
+                        scaleFunctionNormalization
+                        * std::asin( std::min( 2.0 * weightSoFar / totalWeight_ - 1.0, 1.0 ) )
+                        + 1.0, maximumScaleFunctionValue );
+            weightLimit = totalWeight_ * 0.5 * (
+                        std::sin( nextScaleFunctionValue / scaleFunctionNormalization ) + 1.0 );
+
+            currentMean = sortedCentroids[ i ].first;
+            currentWeight = sortedCentroids[ i ].second;
+        }
+    }
+    centroidMeans_.push_back( currentMean );
+    centroidWeights_.push_back( currentWeight );
+}
+
+//! Check if t-digest contains samples.
+void TDigest::checkNonEmpty( ) const
+{
+    if ( totalWeight_ == 0.0 )
+    {
+        boost::throw_exception(
+                    boost::enable_error_info(
+                        std::runtime_error( "Error, t-digest does not contain samples." ) ) );
+    }
+}
+
+} // namespace statistics
+} // namespace tudat
@@ -0,0 +1,217 @@
+/*    Copyright (c) 2010-2015, Delft University of Technology
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without modification, are
+ *    permitted provided that the following conditions are met:
+ *      - Redistributions of source code must retain the above copyright notice, this list of
+ *        conditions and the following disclaimer.
+ *      - Redistributions in binary form must reproduce the above copyright notice, this list of
+ *        conditions and the following disclaimer in the documentation and/or other materials
+ *        provided with the distribution.
+ *      - Neither the name of the Delft University of Technology nor the names of its contributors
+ *        may be used to endorse or promote products derived from this software without specific
+ *        prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND ANY EXPRESS
+ *    OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF
+ *    MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE
+ *    COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *    EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE
+ *    GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED
+ *    AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ *    NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED
+ *    OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ *    Changelog
+ *      YYMMDD    Author            Comment
+ *      261018                      File created.
+ *
+ *    References
+ *      Dunning, T., Ertl, O. Computing Extremely Accurate Quantiles Using t-Digests.
+ *          arXiv:1902.04023, 2019.
+ *
+ *    Notes
+ *      A TDigest is not safe to fill concurrently from multiple threads. Instead, each thread
+ *      should fill its own TDigest, after which these are merged (in a fixed order, if
+ *      reproducible results are required).
+ *
+ */
+
+#ifndef TUDAT_T_DIGEST_H
+#define TUDAT_T_DIGEST_H
+
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
+
+namespace tudat
+{
+namespace statistics
+{
+
+//! t-digest quantile sketch class.
+/*!
+ * Bounded-memory, mergeable sketch of a one-dimensional distribution, from which quantiles and
+ * values of the cumulative distribution function can be estimated (Dunning & Ertl, 2019). The
+ * samples are summarized by a sorted list of centroids (mean and weight), of which the weight
+ * is limited by the k1 scale function
+ * \f[
+ *      k( q ) = \frac{ \delta }{ 2\pi } \arcsin( 2q - 1 )
+ * \f]
+ * such that each centroid spans at most one unit of k. Centroids near the tails (q close to 0
+ * or 1) are therefore small, which makes the estimates of extreme quantiles (e.g., the 99.7th
+ * percentile) accurate. The number of centroids is of the order of the compression parameter
+ * \f$ \delta \f$, independent of the number of samples. New samples are collected in a buffer,
+ * which is merged with the centroids when full, or when an estimate is requested.
+ */
+class TDigest
+{
+public:
+
+    //! Constructor.
+    /*!
+     * Constructor, creates empty t-digest.
+     * \param compression Compression parameter \f$ \delta \f$; the number of centroids is at
+     *          most approximately \f$ \delta / 2 \f$, and the accuracy increases with increasing
+     *          \f$ \delta \f$ (default 200).
+     */
+    TDigest( const double compression = 200.0 );
+
+    //! Constructor from binary stream.
+    /*!
+     * Constructor, reads t-digest from binary stream, as written by writeToBinaryStream( ).
+     * \param stream Stream from which t-digest is read (opened in binary mode).
+     */
+    TDigest( std::istream& stream );
+
+    //! Add sample.
+    /*!
+     * Adds a (weighted) sample to the t-digest.
+     * \param sample Sample value; not-a-number values are ignored.
+     * \param weight Weight of sample (default 1).
+     */
+    void addSample( const double sample, const double weight = 1.0 );
+
+    //! Merge with other t-digest.
+    /*!
+     * Merges the centroids (and unmerged samples) of another t-digest into this one.
+     * \param otherDigest T-digest to merge into this one.
+     */
+    void merge( const TDigest& otherDigest );
+
+    //! Get quantile.
+    /*!
+     * Estimates the value below which a given fraction of the (weighted) samples lies, by linear
+     * interpolation between the centroids, of which the mean is assumed to be located at the
+     * center of its weight. The estimate is exact for the minimum and maximum of the samples.
+     * \param quantile Quantile, between 0 and 1.
+     * \return Estimated value of quantile.
+     */
+    double getQuantile( const double quantile );
+
+    //! Get cumulative distribution function value.
+    /*!
+     * Estimates the fraction of the (weighted) samples that lies below a given value, using the
+     * inverse of the interpolation used in getQuantile( ).
+     * \param value Value at which cumulative distribution function is evaluated.
+     * \return Estimated fraction of samples below value.
+     */
+    double getCumulativeDistributionValue( const double value );
+
+    //! Write to binary stream.
+    /*!
+     * Writes the t-digest to a binary stream, from which it can be read by the corresponding
+     * constructor. Unmerged samples are merged first.
+     * \param stream Stream to which t-digest is written (opened in binary mode).
+     */
+    void writeToBinaryStream( std::ostream& stream );
+
+    //! Get total weight of samples.
+    /*!
+     * Returns total weight of samples (number of samples, if all weights are unity).
+     * \return Total weight of samples.
+     */
+    double getTotalWeight( ) const { return totalWeight_; }
+
+    //! Get minimum.
+    /*!
+     * Returns minimum of samples.
+     * \return Minimum of samples.
+     */
+    double getMinimum( ) const { return minimum_; }
+
+    //! Get maximum.
+    /*!
+     * Returns maximum of samples.
+     * \return Maximum of samples.
+     */
+    double getMaximum( ) const { return maximum_; }
+
+    //! Get number of centroids.
+    /*!
+     * Returns number of centroids, after merging unmerged samples.
+     * \return Number of centroids.
+     */
+    int getNumberOfCentroids( );
+
+    //! Get compression parameter.
+    /*!
+     * Returns compression parameter.
+     * \return Compression parameter.
+     */
+    double getCompression( ) const { return compression_; }
+
+protected:
+
+private:
+
+    //! Merge unmerged samples with centroids.
+    /*!
+     * Sorts unmerged samples and centroids, and merges them into new centroids, of which the
+     * weight is limited by the k1 scale function.
+     */
+    void compress( );
+
+    //! Check if t-digest contains samples.
+    /*!
+     * Checks if t-digest contains samples, and throws an exception otherwise.
+     */
+    void checkNonEmpty( ) const;
+
+    //! Compression parameter.
+    double compression_;
+
+    //! Maximum number of unmerged samples, after which these are merged.
+    unsigned int bufferSize_;
+
+    //! Means of centroids, in ascending order.
+    std::vector< double > centroidMeans_;
+
+    //! Weights of centroids.
+    std::vector< double > centroidWeights_;
+
+    //! Values of unmerged samples.
+    std::vector< double > unmergedMeans_;
+
+    //! Weights of unmerged samples.
+    std::vector< double > unmergedWeights_;
+
+    //! Total weight of (merged and unmerged) samples.
+    double totalWeight_;
+
+    //! Minimum of samples.
+    double minimum_;
+
+    //! Maximum of samples.
+    double maximum_;
+};
+
+//! Typedef for shared-pointer to TDigest.
+typedef boost::shared_ptr< TDigest > TDigestPointer;
+
+} // namespace statistics
+} // namespace tudat
+
+#endif // TUDAT_T_DIGEST_H